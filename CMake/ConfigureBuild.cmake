@@ -112,6 +112,7 @@ set(OGRE_SET_USE_BOOST 0)
 set(OGRE_SET_PROFILING 0)
 set(OGRE_SET_PROFILING_EXHAUSTIVE 0)
 set(OGRE_SET_USE_SIMD 0)
+set(OGRE_SET_USE_SIMD_AVX2 0)
 set(OGRE_SET_RESTRICT_ALIASING 0)
 set(OGRE_SET_IDSTRING_ALWAYS_READABLE 0)
 set(OGRE_SET_DISABLE_AMD_AGS 0)
@@ -203,6 +204,9 @@ endif()
 if (OGRE_SIMD_SSE2 OR OGRE_SIMD_NEON)
   set(OGRE_SET_USE_SIMD 1)
 endif()
+if (OGRE_SIMD_AVX2)
+  set(OGRE_SET_USE_SIMD_AVX2 1)
+endif()
 if (OGRE_RESTRICT_ALIASING)
   set(OGRE_SET_RESTRICT_ALIASING 1)
 endif()
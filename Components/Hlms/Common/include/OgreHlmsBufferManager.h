@@ -30,6 +30,8 @@ THE SOFTWARE.
 
 #include "OgrePrerequisites.h"
 #include "OgreHlms.h"
+#include "OgreConstBufferPool.h"
+#include "Threading/OgreLightweightMutex.h"
 #include "OgreHeaderPrefix.h"
 
 #if OGRE_PLATFORM == OGRE_PLATFORM_WIN32 || OGRE_PLATFORM == OGRE_PLATFORM_WINRT
@@ -61,21 +63,20 @@ namespace Ogre
     *  @{
     */
 
-    /** Managing constant and texture buffers for sending shader parameters
-        is a very similar process to most Hlms implementations using them.
-        This class offers the shared functionality for them, such as
-            1. Rebinding buffers when necessary, with the right offsets and sizes.
-            2. Requesting more memory.
-            3. Mapping it.
+    /** Const & texture buffers being filled by an HlmsBufferManager, and how far we've
+        written into them.
+    @remarks
+        HlmsBufferManager itself is the state used by the main thread (thus derived classes
+        keep accessing these members directly). When recording commands in parallel, each
+        extra thread gets its own state with its own pool of buffers (a per-thread
+        sub-allocator), so threads never write to the same memory nor need to synchronize
+        except when a new buffer must be created.
     */
-    class _OgreHlmsCommonExport HlmsBufferManager : public Hlms
+    struct _OgreHlmsCommonExport HlmsBufferFillState
     {
-    protected:
         typedef vector<ConstBufferPacked*>::type ConstBufferPackedVec;
         typedef vector<ReadOnlyBufferPacked*>::type ReadOnlyBufferPackedVec;
 
-        VaoManager              *mVaoManager;
-
         uint32                  mCurrentConstBuffer;    /// Resets every to zero every new frame.
         uint32                  mCurrentTexBuffer;      /// Resets every to zero every new frame.
         ConstBufferPackedVec    mConstBuffers;
@@ -114,20 +115,68 @@ namespace Ogre
         /// we've written them).
         size_t  mLastTexBufferCmdOffset;
 
+        /// Last bound material buffer, texture & sampler sets; to avoid redundant binds.
+        ConstBufferPool::BufferPool const   *mLastBoundPool;
+        DescriptorSetTexture const          *mLastDescTexture;
+        DescriptorSetSampler const          *mLastDescSampler;
+
+        /// Last bone palette written to the tex buffer, so that renderables using the same
+        /// SkeletonInstance and bones can point to it. Only valid while mStartMappedTexBuffer
+        /// equals mLastPaletteBindStart; mapping or unmapping the tex buffer clears it.
+        float                               *mLastPalette;
+        float                               *mLastPaletteBindStart;
+        SkeletonInstance const              *mLastPaletteSkeleton;
+        FastArray<unsigned short> const     *mLastPaletteIndexMap;
+
+        HlmsBufferFillState();
+    };
+
+    /** Managing constant and texture buffers for sending shader parameters
+        is a very similar process to most Hlms implementations using them.
+        This class offers the shared functionality for them, such as
+            1. Rebinding buffers when necessary, with the right offsets and sizes.
+            2. Requesting more memory.
+            3. Mapping it.
+    @par
+        It also implements the per-thread buffer management needed by
+        Hlms::fillBuffersForV2Mt. Derived classes that support it use getFillState( threadIdx )
+        and the overloads taking an HlmsBufferFillState.
+    */
+    class _OgreHlmsCommonExport HlmsBufferManager : public Hlms, protected HlmsBufferFillState
+    {
+    protected:
+        typedef vector<HlmsBufferFillState*>::type HlmsBufferFillStateVec;
+
+        VaoManager              *mVaoManager;
+
+        /// mFillStates[0] is this. The rest are only used when filling in parallel.
+        HlmsBufferFillStateVec  mFillStates;
+
+        /// Serializes creating & mapping buffers when filling in parallel.
+        LightweightMutex        mBufferMutex;
+
         /// The tex. buffer's size. Try raising this number if your API traces/profilers
         /// show we're constantly binding new textures. Should only be relevant if you
         /// have many skeletally animated meshes with lots of bones.
         size_t mTextureBufferDefaultSize;
 
+        HlmsBufferFillState& getFillState( size_t threadIdx )   { return *mFillStates[threadIdx]; }
+
         /// For compatibility reasons with D3D11 and GLES3, Const buffers are mapped.
         /// Once we're done with it (even if we didn't fully use it) we discard it
         /// and get a new one. We will at least have to get a new one on every pass.
         /// This is affordable since common Const buffer limits are of 64kb.
         /// At the next frame we restart mCurrentConstBuffer to 0.
-        void unmapConstBuffer(void);
+        void unmapConstBuffer( HlmsBufferFillState &fs );
+        void unmapConstBuffer(void)                                 { unmapConstBuffer( *this ); }
 
         /// Warning: Calling this function affects BOTH mCurrentConstBuffer and mCurrentTexBuffer
-        uint32* RESTRICT_ALIAS_RETURN mapNextConstBuffer( CommandBuffer *commandBuffer );
+        uint32* RESTRICT_ALIAS_RETURN mapNextConstBuffer( HlmsBufferFillState &fs,
+                                                          CommandBuffer *commandBuffer );
+        uint32* RESTRICT_ALIAS_RETURN mapNextConstBuffer( CommandBuffer *commandBuffer )
+        {
+            return mapNextConstBuffer( *this, commandBuffer );
+        }
 
         /// Texture buffers are treated differently than Const buffers. We first map it.
         /// Once we're done with it, we save our progress (in mTexLastOffset) and in the
@@ -143,9 +192,16 @@ namespace Ogre
         /// or may internally use a new buffer (wasting memory space).
         ///
         /// (*) D3D11.1 allows using MAP_NO_OVERWRITE for texture buffers.
-        void unmapTexBuffer( CommandBuffer *commandBuffer );
-        float* RESTRICT_ALIAS_RETURN mapNextTexBuffer( CommandBuffer *commandBuffer,
+        void unmapTexBuffer( HlmsBufferFillState &fs, CommandBuffer *commandBuffer );
+        void unmapTexBuffer( CommandBuffer *commandBuffer )     { unmapTexBuffer( *this, commandBuffer ); }
+        float* RESTRICT_ALIAS_RETURN mapNextTexBuffer( HlmsBufferFillState &fs,
+                                                       CommandBuffer *commandBuffer,
                                                        size_t minimumSizeBytes );
+        float* RESTRICT_ALIAS_RETURN mapNextTexBuffer( CommandBuffer *commandBuffer,
+                                                       size_t minimumSizeBytes )
+        {
+            return mapNextTexBuffer( *this, commandBuffer, minimumSizeBytes );
+        }
 
         /** Rebinds the texture buffer. Finishes the last bind command to the tbuffer.
         @param resetOffset
@@ -157,8 +213,17 @@ namespace Ogre
             If resetOffset is true and the remaining space in the currently mapped
             tbuffer is less than minimumSizeBytes, we will call mapNextTexBuffer
         */
+        void rebindTexBuffer( HlmsBufferFillState &fs, CommandBuffer *commandBuffer,
+                              bool resetOffset = false, size_t minimumSizeBytes = 1 );
         void rebindTexBuffer( CommandBuffer *commandBuffer, bool resetOffset = false,
-                              size_t minimumSizeBytes = 1 );
+                              size_t minimumSizeBytes = 1 )
+        {
+            rebindTexBuffer( *this, commandBuffer, resetOffset, minimumSizeBytes );
+        }
+
+        /// Creates buffers in advance (from the main thread) so that fs can write at least
+        /// the given amount of bytes without creating new ones.
+        void reserveFillBuffers( HlmsBufferFillState &fs, size_t constBytes, size_t texBytes );
 
         virtual void destroyAllBuffers(void);
 
@@ -173,6 +238,10 @@ namespace Ogre
                                            bool casterPass, bool dualParaboloid,
                                            SceneManager *sceneManager );
 
+        virtual void _beginParallelFillBuffers( size_t numThreads, size_t numRenderablesPerThread,
+                                                CommandBuffer *commandBuffer );
+        virtual void _endParallelFillBuffers( size_t threadIdx, CommandBuffer *commandBuffer );
+
         virtual void preCommandBufferExecution( CommandBuffer *commandBuffer );
         virtual void postCommandBufferExecution( CommandBuffer *commandBuffer );
 
@@ -40,10 +40,7 @@ THE SOFTWARE.
 
 namespace Ogre
 {
-    HlmsBufferManager::HlmsBufferManager( HlmsTypes type, const String &typeName, Archive *dataFolder,
-                                          ArchiveVec *libraryFolders ) :
-        Hlms( type, typeName, dataFolder, libraryFolders ),
-        mVaoManager( 0 ),
+    HlmsBufferFillState::HlmsBufferFillState() :
         mCurrentConstBuffer( 0 ),
         mCurrentTexBuffer( 0 ),
         mStartMappedConstBuffer( 0 ),
@@ -55,13 +52,41 @@ namespace Ogre
         mCurrentTexBufferSize( 0 ),
         mTexLastOffset( 0 ),
         mLastTexBufferCmdOffset( (size_t)~0 ),
+        mLastBoundPool( 0 ),
+        mLastDescTexture( 0 ),
+        mLastDescSampler( 0 ),
+        mLastPalette( 0 ),
+        mLastPaletteBindStart( 0 ),
+        mLastPaletteSkeleton( 0 ),
+        mLastPaletteIndexMap( 0 )
+    {
+    }
+    //-----------------------------------------------------------------------------------
+    //-----------------------------------------------------------------------------------
+    //-----------------------------------------------------------------------------------
+    HlmsBufferManager::HlmsBufferManager( HlmsTypes type, const String &typeName, Archive *dataFolder,
+                                          ArchiveVec *libraryFolders ) :
+        Hlms( type, typeName, dataFolder, libraryFolders ),
+        mVaoManager( 0 ),
         mTextureBufferDefaultSize( 4 * 1024 * 1024 )
     {
+        mFillStates.push_back( this );
     }
     //-----------------------------------------------------------------------------------
     HlmsBufferManager::~HlmsBufferManager()
     {
         destroyAllBuffers();
+
+        HlmsBufferFillStateVec::const_iterator itor = mFillStates.begin() + 1u;
+        HlmsBufferFillStateVec::const_iterator end  = mFillStates.end();
+
+        while( itor != end )
+        {
+            OGRE_DELETE_T( *itor, HlmsBufferFillState, MEMCATEGORY_RENDERSYS );
+            ++itor;
+        }
+
+        mFillStates.clear();
     }
     //-----------------------------------------------------------------------------------
     void HlmsBufferManager::_changeRenderSystem( RenderSystem *newRs )
@@ -96,256 +121,388 @@ namespace Ogre
         return retVal;
     }
     //-----------------------------------------------------------------------------------
-    void HlmsBufferManager::unmapConstBuffer(void)
+    void HlmsBufferManager::unmapConstBuffer( HlmsBufferFillState &fs )
     {
-        if( mStartMappedConstBuffer )
+        if( fs.mStartMappedConstBuffer )
         {
             //Unmap the current buffer
-            ConstBufferPacked *constBuffer = mConstBuffers[mCurrentConstBuffer];
-            constBuffer->unmap( UO_KEEP_PERSISTENT, 0,
-                                (mCurrentMappedConstBuffer - mStartMappedConstBuffer) * sizeof(uint32) );
+            ConstBufferPacked *constBuffer = fs.mConstBuffers[fs.mCurrentConstBuffer];
+            {
+                ScopedLock lock( mBufferMutex );
+                constBuffer->unmap( UO_KEEP_PERSISTENT, 0,
+                                    (fs.mCurrentMappedConstBuffer - fs.mStartMappedConstBuffer) *
+                                    sizeof(uint32) );
+            }
 
-            ++mCurrentConstBuffer;
+            ++fs.mCurrentConstBuffer;
 
-            mStartMappedConstBuffer     = 0;
-            mCurrentMappedConstBuffer   = 0;
-            mCurrentConstBufferSize     = 0;
+            fs.mStartMappedConstBuffer     = 0;
+            fs.mCurrentMappedConstBuffer   = 0;
+            fs.mCurrentConstBufferSize     = 0;
         }
     }
     //-----------------------------------------------------------------------------------
-    uint32* RESTRICT_ALIAS_RETURN HlmsBufferManager::mapNextConstBuffer( CommandBuffer *commandBuffer )
+    uint32* RESTRICT_ALIAS_RETURN HlmsBufferManager::mapNextConstBuffer( HlmsBufferFillState &fs,
+                                                                         CommandBuffer *commandBuffer )
     {
-        unmapConstBuffer();
+        unmapConstBuffer( fs );
+
+        ConstBufferPacked *constBuffer = 0;
 
-        if( mCurrentConstBuffer >= mConstBuffers.size() )
         {
-            size_t bufferSize = std::min<size_t>( 65536, mVaoManager->getConstBufferMaxSize() );
-            ConstBufferPacked *newBuffer = mVaoManager->createConstBuffer( bufferSize,
-                                                                           BT_DYNAMIC_PERSISTENT,
-                                                                           0, false );
-            mConstBuffers.push_back( newBuffer );
-        }
+            ScopedLock lock( mBufferMutex );
+
+            if( fs.mCurrentConstBuffer >= fs.mConstBuffers.size() )
+            {
+                size_t bufferSize = std::min<size_t>( 65536, mVaoManager->getConstBufferMaxSize() );
+                ConstBufferPacked *newBuffer = mVaoManager->createConstBuffer( bufferSize,
+                                                                               BT_DYNAMIC_PERSISTENT,
+                                                                               0, false );
+                fs.mConstBuffers.push_back( newBuffer );
+            }
 
-        ConstBufferPacked *constBuffer = mConstBuffers[mCurrentConstBuffer];
+            constBuffer = fs.mConstBuffers[fs.mCurrentConstBuffer];
 
-        mStartMappedConstBuffer     = reinterpret_cast<uint32*>(
+            fs.mStartMappedConstBuffer  = reinterpret_cast<uint32*>(
                                             constBuffer->map( 0, constBuffer->getNumElements() ) );
-        mCurrentMappedConstBuffer   = mStartMappedConstBuffer;
-        mCurrentConstBufferSize     = constBuffer->getNumElements() >> 2;
+        }
+
+        fs.mCurrentMappedConstBuffer    = fs.mStartMappedConstBuffer;
+        fs.mCurrentConstBufferSize      = constBuffer->getNumElements() >> 2;
 
         *commandBuffer->addCommand<CbShaderBuffer>() = CbShaderBuffer( VertexShader, 2,
                                                                        constBuffer, 0, 0 );
         *commandBuffer->addCommand<CbShaderBuffer>() = CbShaderBuffer( PixelShader, 2,
                                                                        constBuffer, 0, 0 );
 
-        return mStartMappedConstBuffer;
+        return fs.mStartMappedConstBuffer;
     }
     //-----------------------------------------------------------------------------------
-    void HlmsBufferManager::unmapTexBuffer( CommandBuffer *commandBuffer )
+    void HlmsBufferManager::unmapTexBuffer( HlmsBufferFillState &fs, CommandBuffer *commandBuffer )
     {
         //Save our progress
-        const size_t bytesWritten = (mCurrentMappedTexBuffer - mRealStartMappedTexBuffer) *
+        const size_t bytesWritten = (fs.mCurrentMappedTexBuffer - fs.mRealStartMappedTexBuffer) *
                                                                             sizeof(float);
-        mTexLastOffset += bytesWritten;
+        fs.mTexLastOffset += bytesWritten;
 
-        if( mRealStartMappedTexBuffer )
+        if( fs.mRealStartMappedTexBuffer )
         {
             //Unmap the current buffer
-            TexBufferPacked *texBuffer = mTexBuffers[mCurrentTexBuffer];
-            texBuffer->unmap( UO_KEEP_PERSISTENT, 0, bytesWritten );
+            TexBufferPacked *texBuffer = fs.mTexBuffers[fs.mCurrentTexBuffer];
+            {
+                ScopedLock lock( mBufferMutex );
+                texBuffer->unmap( UO_KEEP_PERSISTENT, 0, bytesWritten );
+            }
 
             CbShaderBuffer *shaderBufferCmd = reinterpret_cast<CbShaderBuffer*>(
-                        commandBuffer->getCommandFromOffset( mLastTexBufferCmdOffset ) );
+                        commandBuffer->getCommandFromOffset( fs.mLastTexBufferCmdOffset ) );
             if( shaderBufferCmd )
             {
                 assert( shaderBufferCmd->bufferPacked == texBuffer );
-                shaderBufferCmd->bindSizeBytes = mTexLastOffset - shaderBufferCmd->bindOffset;
-                mLastTexBufferCmdOffset = (size_t)~0;
+                shaderBufferCmd->bindSizeBytes = fs.mTexLastOffset - shaderBufferCmd->bindOffset;
+                fs.mLastTexBufferCmdOffset = (size_t)~0;
             }
         }
 
-        mRealStartMappedTexBuffer = 0;
-        mStartMappedTexBuffer   = 0;
-        mCurrentMappedTexBuffer = 0;
-        mCurrentTexBufferSize   = 0;
+        fs.mRealStartMappedTexBuffer = 0;
+        fs.mStartMappedTexBuffer    = 0;
+        fs.mCurrentMappedTexBuffer  = 0;
+        fs.mCurrentTexBufferSize    = 0;
+        fs.mLastPalette             = 0;
 
         //Ensure the proper alignment
-        mTexLastOffset = alignToNextMultiple( mTexLastOffset, mVaoManager->getTexBufferAlignment() );
+        fs.mTexLastOffset = alignToNextMultiple( fs.mTexLastOffset,
+                                                 mVaoManager->getTexBufferAlignment() );
     }
     //-----------------------------------------------------------------------------------
-    float* RESTRICT_ALIAS_RETURN HlmsBufferManager::mapNextTexBuffer( CommandBuffer *commandBuffer,
+    float* RESTRICT_ALIAS_RETURN HlmsBufferManager::mapNextTexBuffer( HlmsBufferFillState &fs,
+                                                                      CommandBuffer *commandBuffer,
                                                                       size_t minimumSizeBytes )
     {
-        unmapTexBuffer( commandBuffer );
+        unmapTexBuffer( fs, commandBuffer );
 
-        ReadOnlyBufferPacked *texBuffer = mTexBuffers[mCurrentTexBuffer];
+        ReadOnlyBufferPacked *texBuffer = fs.mTexBuffers[fs.mCurrentTexBuffer];
 
-        mTexLastOffset = alignToNextMultiple( mTexLastOffset, mVaoManager->getTexBufferAlignment() );
+        fs.mTexLastOffset = alignToNextMultiple( fs.mTexLastOffset,
+                                                 mVaoManager->getTexBufferAlignment() );
 
-        //We'll go out of bounds. This buffer is full. Get a new one and remap from 0.
-        if( mTexLastOffset + minimumSizeBytes >= texBuffer->getTotalSizeBytes() )
         {
-            mTexLastOffset = 0;
-            ++mCurrentTexBuffer;
+            ScopedLock lock( mBufferMutex );
 
-            if( mCurrentTexBuffer >= mTexBuffers.size() )
+            //We'll go out of bounds. This buffer is full. Get a new one and remap from 0.
+            if( fs.mTexLastOffset + minimumSizeBytes >= texBuffer->getTotalSizeBytes() )
             {
-                size_t bufferSize = std::min<size_t>( mTextureBufferDefaultSize,
-                                                      mVaoManager->getReadOnlyBufferMaxSize() );
-                ReadOnlyBufferPacked *newBuffer = mVaoManager->createReadOnlyBuffer(
-                    PFG_RGBA32_FLOAT, bufferSize, BT_DYNAMIC_PERSISTENT, 0, false );
-                mTexBuffers.push_back( newBuffer );
+                fs.mTexLastOffset = 0;
+                ++fs.mCurrentTexBuffer;
+
+                if( fs.mCurrentTexBuffer >= fs.mTexBuffers.size() )
+                {
+                    size_t bufferSize = std::min<size_t>( mTextureBufferDefaultSize,
+                                                          mVaoManager->getReadOnlyBufferMaxSize() );
+                    ReadOnlyBufferPacked *newBuffer = mVaoManager->createReadOnlyBuffer(
+                        PFG_RGBA32_FLOAT, bufferSize, BT_DYNAMIC_PERSISTENT, 0, false );
+                    fs.mTexBuffers.push_back( newBuffer );
+                }
+
+                texBuffer = fs.mTexBuffers[fs.mCurrentTexBuffer];
             }
 
-            texBuffer = mTexBuffers[mCurrentTexBuffer];
+            fs.mRealStartMappedTexBuffer = reinterpret_cast<float*>(
+                                            texBuffer->map( fs.mTexLastOffset,
+                                                            texBuffer->getNumElements() -
+                                                            fs.mTexLastOffset,
+                                                            false ) );
         }
 
-        mRealStartMappedTexBuffer   = reinterpret_cast<float*>(
-                                            texBuffer->map( mTexLastOffset,
-                                                            texBuffer->getNumElements() - mTexLastOffset,
-                                                            false ) );
-        mStartMappedTexBuffer   = mRealStartMappedTexBuffer;
-        mCurrentMappedTexBuffer = mRealStartMappedTexBuffer;
-        mCurrentTexBufferSize   = (texBuffer->getNumElements() - mTexLastOffset) >> 2;
+        fs.mStartMappedTexBuffer    = fs.mRealStartMappedTexBuffer;
+        fs.mCurrentMappedTexBuffer  = fs.mRealStartMappedTexBuffer;
+        fs.mLastPalette             = 0;
+        fs.mCurrentTexBufferSize    = (texBuffer->getNumElements() - fs.mTexLastOffset) >> 2;
 
         CbShaderBuffer *shaderBufferCmd = commandBuffer->addCommand<CbShaderBuffer>();
-        *shaderBufferCmd = CbShaderBuffer( VertexShader, 0, texBuffer, mTexLastOffset, 0 );
+        *shaderBufferCmd = CbShaderBuffer( VertexShader, 0, texBuffer, fs.mTexLastOffset, 0 );
 
-        mLastTexBufferCmdOffset = commandBuffer->getCommandOffset( shaderBufferCmd );
+        fs.mLastTexBufferCmdOffset = commandBuffer->getCommandOffset( shaderBufferCmd );
 
-        return mStartMappedTexBuffer;
+        return fs.mStartMappedTexBuffer;
     }
     //-----------------------------------------------------------------------------------
-    void HlmsBufferManager::rebindTexBuffer( CommandBuffer *commandBuffer, bool resetOffset,
-                                   size_t minimumSizeBytes )
+    void HlmsBufferManager::rebindTexBuffer( HlmsBufferFillState &fs, CommandBuffer *commandBuffer,
+                                             bool resetOffset, size_t minimumSizeBytes )
     {
         assert( minimumSizeBytes > 0 );
 
         //Set the binding size of the old binding command (if exists)
         CbShaderBuffer *shaderBufferCmd = reinterpret_cast<CbShaderBuffer*>(
-                    commandBuffer->getCommandFromOffset( mLastTexBufferCmdOffset ) );
+                    commandBuffer->getCommandFromOffset( fs.mLastTexBufferCmdOffset ) );
         if( shaderBufferCmd )
         {
-            assert( shaderBufferCmd->bufferPacked == mTexBuffers[mCurrentTexBuffer] );
-            shaderBufferCmd->bindSizeBytes = (mCurrentMappedTexBuffer - mStartMappedTexBuffer) *
+            assert( shaderBufferCmd->bufferPacked == fs.mTexBuffers[fs.mCurrentTexBuffer] );
+            shaderBufferCmd->bindSizeBytes = (fs.mCurrentMappedTexBuffer - fs.mStartMappedTexBuffer) *
                                                 sizeof(float);
         }
 
-        const size_t bufferSizeBytes = mCurrentTexBufferSize * sizeof(float);
-        size_t currentOffset = (mCurrentMappedTexBuffer - mStartMappedTexBuffer) * sizeof(float);
+        const size_t bufferSizeBytes = fs.mCurrentTexBufferSize * sizeof(float);
+        size_t currentOffset = (fs.mCurrentMappedTexBuffer - fs.mStartMappedTexBuffer) * sizeof(float);
         currentOffset = alignToNextMultiple( currentOffset, mVaoManager->getTexBufferAlignment() );
         currentOffset = std::min( bufferSizeBytes, currentOffset );
         const size_t remainingSize = bufferSizeBytes - currentOffset;
 
         if( resetOffset && remainingSize < minimumSizeBytes )
         {
-            mapNextTexBuffer( commandBuffer, minimumSizeBytes );
+            mapNextTexBuffer( fs, commandBuffer, minimumSizeBytes );
         }
         else
         {
-            size_t bindOffset = (mStartMappedTexBuffer - mRealStartMappedTexBuffer) * sizeof(float);
+            size_t bindOffset = (fs.mStartMappedTexBuffer - fs.mRealStartMappedTexBuffer) *
+                                sizeof(float);
             if( resetOffset )
             {
-                mStartMappedTexBuffer = reinterpret_cast<float*>(
-                            reinterpret_cast<unsigned char*>(mStartMappedTexBuffer) + currentOffset );
-                mCurrentMappedTexBuffer = mStartMappedTexBuffer;
-                mCurrentTexBufferSize -= currentOffset / sizeof(float);
-
-                bindOffset = (mCurrentMappedTexBuffer - mRealStartMappedTexBuffer) * sizeof(float);
+                fs.mStartMappedTexBuffer = reinterpret_cast<float*>(
+                            reinterpret_cast<unsigned char*>(fs.mStartMappedTexBuffer) +
+                            currentOffset );
+                fs.mCurrentMappedTexBuffer = fs.mStartMappedTexBuffer;
+                fs.mCurrentTexBufferSize -= currentOffset / sizeof(float);
+
+                bindOffset = (fs.mCurrentMappedTexBuffer - fs.mRealStartMappedTexBuffer) *
+                             sizeof(float);
             }
 
-            if( mTexLastOffset + bindOffset >= mTexBuffers[mCurrentTexBuffer]->getTotalSizeBytes() )
+            if( fs.mTexLastOffset + bindOffset >=
+                fs.mTexBuffers[fs.mCurrentTexBuffer]->getTotalSizeBytes() )
             {
-                mapNextTexBuffer( commandBuffer, minimumSizeBytes );
+                mapNextTexBuffer( fs, commandBuffer, minimumSizeBytes );
             }
             else
             {
                 //Add a new binding command.
                 shaderBufferCmd = commandBuffer->addCommand<CbShaderBuffer>();
-                *shaderBufferCmd = CbShaderBuffer( VertexShader, 0, mTexBuffers[mCurrentTexBuffer],
-                                                   mTexLastOffset + bindOffset, 0 );
-                mLastTexBufferCmdOffset = commandBuffer->getCommandOffset( shaderBufferCmd );
+                *shaderBufferCmd = CbShaderBuffer( VertexShader, 0,
+                                                   fs.mTexBuffers[fs.mCurrentTexBuffer],
+                                                   fs.mTexLastOffset + bindOffset, 0 );
+                fs.mLastTexBufferCmdOffset = commandBuffer->getCommandOffset( shaderBufferCmd );
             }
         }
     }
     //-----------------------------------------------------------------------------------
+    void HlmsBufferManager::reserveFillBuffers( HlmsBufferFillState &fs, size_t constBytes,
+                                                size_t texBytes )
+    {
+        //Const buffers are never reused within a pass once unmapped. The +1 accounts
+        //for the one currently mapped (if any).
+        const size_t constBufferSize = std::min<size_t>( 65536, mVaoManager->getConstBufferMaxSize() );
+        const size_t numConstBuffers = fs.mCurrentConstBuffer + 1u +
+                                       (constBytes + constBufferSize - 1u) / constBufferSize;
+        while( fs.mConstBuffers.size() < numConstBuffers )
+        {
+            fs.mConstBuffers.push_back( mVaoManager->createConstBuffer( constBufferSize,
+                                                                        BT_DYNAMIC_PERSISTENT,
+                                                                        0, false ) );
+        }
+
+        //Tex buffers continue where we left off.
+        size_t availableTexBytes = 0;
+        for( size_t i=fs.mCurrentTexBuffer; i<fs.mTexBuffers.size(); ++i )
+            availableTexBytes += fs.mTexBuffers[i]->getTotalSizeBytes();
+        if( fs.mCurrentTexBuffer < fs.mTexBuffers.size() )
+            availableTexBytes -= std::min( availableTexBytes, fs.mTexLastOffset );
+
+        const size_t texBufferSize = std::min<size_t>( mTextureBufferDefaultSize,
+                                                       mVaoManager->getReadOnlyBufferMaxSize() );
+        while( availableTexBytes < texBytes || fs.mTexBuffers.empty() )
+        {
+            fs.mTexBuffers.push_back( mVaoManager->createReadOnlyBuffer( PFG_RGBA32_FLOAT,
+                                                                         texBufferSize,
+                                                                         BT_DYNAMIC_PERSISTENT,
+                                                                         0, false ) );
+            availableTexBytes += texBufferSize;
+        }
+    }
+    //-----------------------------------------------------------------------------------
     void HlmsBufferManager::destroyAllBuffers(void)
     {
-        mCurrentConstBuffer = 0;
-        mCurrentTexBuffer   = 0;
-        mTexLastOffset      = 0;
+        HlmsBufferFillStateVec::const_iterator itState = mFillStates.begin();
+        HlmsBufferFillStateVec::const_iterator enState = mFillStates.end();
 
+        while( itState != enState )
         {
-            ReadOnlyBufferPackedVec::const_iterator itor = mTexBuffers.begin();
-            ReadOnlyBufferPackedVec::const_iterator end  = mTexBuffers.end();
+            HlmsBufferFillState &fs = **itState;
+
+            fs.mCurrentConstBuffer  = 0;
+            fs.mCurrentTexBuffer    = 0;
+            fs.mTexLastOffset       = 0;
 
-            while( itor != end )
             {
-                if( (*itor)->getMappingState() != MS_UNMAPPED )
-                    (*itor)->unmap( UO_UNMAP_ALL );
-                mVaoManager->destroyReadOnlyBuffer( *itor );
-                ++itor;
+                ReadOnlyBufferPackedVec::const_iterator itor = fs.mTexBuffers.begin();
+                ReadOnlyBufferPackedVec::const_iterator end  = fs.mTexBuffers.end();
+
+                while( itor != end )
+                {
+                    if( (*itor)->getMappingState() != MS_UNMAPPED )
+                        (*itor)->unmap( UO_UNMAP_ALL );
+                    mVaoManager->destroyReadOnlyBuffer( *itor );
+                    ++itor;
+                }
+
+                fs.mTexBuffers.clear();
+            }
+
+            {
+                ConstBufferPackedVec::const_iterator itor = fs.mConstBuffers.begin();
+                ConstBufferPackedVec::const_iterator end  = fs.mConstBuffers.end();
+
+                while( itor != end )
+                {
+                    if( (*itor)->getMappingState() != MS_UNMAPPED )
+                        (*itor)->unmap( UO_UNMAP_ALL );
+                    mVaoManager->destroyConstBuffer( *itor );
+                    ++itor;
+                }
+
+                fs.mConstBuffers.clear();
             }
 
-            mTexBuffers.clear();
+            ++itState;
         }
+    }
+    //-----------------------------------------------------------------------------------
+    void HlmsBufferManager::_beginParallelFillBuffers( size_t numThreads,
+                                                       size_t numRenderablesPerThread,
+                                                       CommandBuffer *commandBuffer )
+    {
+        //Thread 0 reuses our own state. Finish whatever the main thread was recording.
+        unmapConstBuffer( *this );
+        unmapTexBuffer( *this, commandBuffer );
 
+        while( mFillStates.size() < numThreads )
         {
-            ConstBufferPackedVec::const_iterator itor = mConstBuffers.begin();
-            ConstBufferPackedVec::const_iterator end  = mConstBuffers.end();
-
-            while( itor != end )
-            {
-                if( (*itor)->getMappingState() != MS_UNMAPPED )
-                    (*itor)->unmap( UO_UNMAP_ALL );
-                mVaoManager->destroyConstBuffer( *itor );
-                ++itor;
-            }
+            mFillStates.push_back( OGRE_NEW_T( HlmsBufferFillState, MEMCATEGORY_RENDERSYS ) );
+        }
 
-            mConstBuffers.clear();
+        //Creating buffers from worker threads is serialized and may not be supported by
+        //all APIs, so reserve in advance. This estimate covers non-animated renderables
+        //(16 bytes of const buffer; worst case 32 floats of tex buffer per renderable).
+        //Skeletal animation may still need more.
+        for( size_t i=0; i<numThreads; ++i )
+        {
+            reserveFillBuffers( *mFillStates[i], numRenderablesPerThread * 16u,
+                                numRenderablesPerThread * 32u * sizeof(float) );
         }
     }
     //-----------------------------------------------------------------------------------
+    void HlmsBufferManager::_endParallelFillBuffers( size_t threadIdx, CommandBuffer *commandBuffer )
+    {
+        HlmsBufferFillState &fs = *mFillStates[threadIdx];
+        unmapConstBuffer( fs );
+        unmapTexBuffer( fs, commandBuffer );
+    }
+    //-----------------------------------------------------------------------------------
     void HlmsBufferManager::preCommandBufferExecution( CommandBuffer *commandBuffer )
     {
         unmapConstBuffer();
         unmapTexBuffer( commandBuffer );
 
-        ReadOnlyBufferPackedVec::const_iterator itor = mTexBuffers.begin();
-        ReadOnlyBufferPackedVec::const_iterator end  = mTexBuffers.end();
+        HlmsBufferFillStateVec::const_iterator itState = mFillStates.begin();
+        HlmsBufferFillStateVec::const_iterator enState = mFillStates.end();
 
-        while( itor != end )
+        while( itState != enState )
         {
-            (*itor)->advanceFrame();
-            ++itor;
+            ReadOnlyBufferPackedVec::const_iterator itor = (*itState)->mTexBuffers.begin();
+            ReadOnlyBufferPackedVec::const_iterator end  = (*itState)->mTexBuffers.end();
+
+            while( itor != end )
+            {
+                (*itor)->advanceFrame();
+                ++itor;
+            }
+
+            ++itState;
         }
     }
     //-----------------------------------------------------------------------------------
     void HlmsBufferManager::postCommandBufferExecution( CommandBuffer *commandBuffer )
     {
-        ReadOnlyBufferPackedVec::const_iterator itor = mTexBuffers.begin();
-        ReadOnlyBufferPackedVec::const_iterator end  = mTexBuffers.end();
+        HlmsBufferFillStateVec::const_iterator itState = mFillStates.begin();
+        HlmsBufferFillStateVec::const_iterator enState = mFillStates.end();
 
-        while( itor != end )
+        while( itState != enState )
         {
-            (*itor)->regressFrame();
-            ++itor;
+            ReadOnlyBufferPackedVec::const_iterator itor = (*itState)->mTexBuffers.begin();
+            ReadOnlyBufferPackedVec::const_iterator end  = (*itState)->mTexBuffers.end();
+
+            while( itor != end )
+            {
+                (*itor)->regressFrame();
+                ++itor;
+            }
+
+            ++itState;
         }
     }
     //-----------------------------------------------------------------------------------
     void HlmsBufferManager::frameEnded(void)
     {
-        mCurrentConstBuffer = 0;
-        mCurrentTexBuffer   = 0;
-        mTexLastOffset      = 0;
+        HlmsBufferFillStateVec::const_iterator itState = mFillStates.begin();
+        HlmsBufferFillStateVec::const_iterator enState = mFillStates.end();
 
-        ReadOnlyBufferPackedVec::const_iterator itor = mTexBuffers.begin();
-        ReadOnlyBufferPackedVec::const_iterator end  = mTexBuffers.end();
-
-        while( itor != end )
+        while( itState != enState )
         {
-            (*itor)->advanceFrame();
-            ++itor;
+            HlmsBufferFillState &fs = **itState;
+
+            fs.mCurrentConstBuffer  = 0;
+            fs.mCurrentTexBuffer    = 0;
+            fs.mTexLastOffset       = 0;
+
+            ReadOnlyBufferPackedVec::const_iterator itor = fs.mTexBuffers.begin();
+            ReadOnlyBufferPackedVec::const_iterator end  = fs.mTexBuffers.end();
+
+            while( itor != end )
+            {
+                (*itor)->advanceFrame();
+                ++itor;
+            }
+
+            ++itState;
         }
     }
     //-----------------------------------------------------------------------------------
@@ -35,6 +35,7 @@ THE SOFTWARE.
 #include "OgreRawPtr.h"
 #include "OgreVector2.h"
 #include "Math/Array/OgreArrayRay.h"
+#include "OgreBvh.h"
 #include "OgreTextureBox.h"
 #include "OgreHeaderPrefix.h"
 
@@ -65,6 +66,8 @@ namespace Ogre
             size_t  numVertices;
             size_t  numIndices;
             bool    useIndices16bit;
+            /// BVH over the triangles (in mesh space)
+            TriangleBvh *bvh;
 
             float* getUvStart( uint8_t uvSet ) const;
         };
@@ -118,9 +121,25 @@ namespace Ogre
             bool operator () ( const SparseCluster &_l, const SparseCluster &_r ) const;
         };
 
+        /// A renderable of an object that can be hit by the rays.
+        struct RaycastInstance
+        {
+            MeshData const  *meshData;
+            MaterialData    material;
+            Matrix4         worldMatrix;
+            /// World space to mesh space
+            Matrix4         invWorldMatrix;
+            Aabb            worldAabb;
+            /// Whether worldMatrix flips the winding of the triangles (i.e. negative scale)
+            bool            flipsWinding;
+        };
+
+        struct InstanceRayTest;
+
         typedef vector<RayHit>::type RayHitVec;
         typedef vector<Vpl>::type VplVec;
         typedef set<SparseCluster, SparseCluster>::type SparseClusterSet;
+        typedef vector<RaycastInstance>::type RaycastInstanceVec;
 
         struct OrderRenderOperation
         {
@@ -223,9 +242,11 @@ namespace Ogre
         size_t          mTotalNumRays; /// Includes bounces. Autogenerated.
         VplVec          mVpls;
         RayHitVec       mRayHits;
-        RawSimdUniquePtr<ArrayRay, MEMCATEGORY_GENERAL> mArrayRays;
 
-        FastArray<size_t> mTmpRaysThatHitObject[ARRAY_PACKED_REALS];
+        RaycastInstanceVec  mRaycastInstances;
+        /// Top level BVH over mRaycastInstances. Each MeshData has its own BVH.
+        Bvh                 mInstancesBvh;
+
         SparseClusterSet  mTmpSparseClusters[3];
 
         typedef map<VertexArrayObject*, MeshData>::type MeshDataMapV2;
@@ -273,13 +294,17 @@ namespace Ogre
         const MeshData* downloadRenderOp( const v1::RenderOperation &renderOp );
         const Image2& downloadTexture( TextureGpu *texture );
 
-        void testLightVsAllObjects( uint8 lightType, Real lightRange,
-                                    ObjectData objData, size_t numNodes,
-                                    const AreaOfInterest &areaOfInterest,
-                                    size_t rayStart, size_t numRays );
-        void raycastLightRayVsMesh( Real lightRange, const MeshData meshData,
-                                    Matrix4 worldMatrix, const MaterialData &material,
-                                    const FastArray<size_t> &raysThatHitObj );
+        /// Fills mRaycastInstances with all the visible objects in [mFirstRq; mLastRq),
+        /// downloading their meshes if needed, and builds mInstancesBvh.
+        void collectRaycastInstances(void);
+        void collectRaycastInstances( ObjectData objData, size_t numNodes );
+
+        /// Casts mRayHits[rayStart] through mRayHits[rayStart+numRays-1] against
+        /// mRaycastInstances, ARRAY_PACKED_REALS rays at a time.
+        void raycastLightRays( uint8 lightType, Real lightRange,
+                               const AreaOfInterest &areaOfInterest,
+                               size_t rayStart, size_t numRays );
+        void fillRayHit( RayHit &rayHit, const RaycastInstance &instance, uint32 triangleIdx );
 
         Vpl convertToVpl( Vector3 lightColour, Vector3 pointOnTri, const RayHit &hit );
         /// Generates the VPLs from a particular lights, and clusters them.
@@ -163,7 +163,8 @@ namespace Ogre
         /// Whether the current active pass can use mPlanarReflections (i.e. we can't
         /// use the reflections if they were built for a different camera angle)
         bool                    mHasPlanarReflections;
-        uint8                   mLastBoundPlanarReflection;
+        /// One per thread filling buffers (@see HlmsBufferManager::getFillState)
+        FastArray<uint8>        mLastBoundPlanarReflection;
 #endif
         TextureGpu              *mAreaLightMasks;
         HlmsSamplerblock const  *mAreaLightMasksSamplerblock;
@@ -181,13 +182,9 @@ namespace Ogre
         TextureGpu              *mDecalsTextures[3];
         HlmsSamplerblock const  *mDecalsSamplerblock;
 
-        ConstBufferPool::BufferPool const *mLastBoundPool;
-
         float mConstantBiasScale;
 
         bool mHasSeparateSamplers;
-        DescriptorSetTexture const *mLastDescTexture;
-        DescriptorSetSampler const *mLastDescSampler;
         uint8 mReservedTexBufferSlots;  // Includes ReadOnly
         uint8 mReservedTexSlots;        // These get added to mReservedTexBufferSlots
 #if !OGRE_NO_FINE_LIGHT_MASK_GRANULARITY
@@ -243,7 +240,8 @@ namespace Ogre
         FORCEINLINE uint32 fillBuffersFor( const HlmsCache *cache,
                                            const QueuedRenderable &queuedRenderable,
                                            bool casterPass, uint32 lastCacheHash,
-                                           CommandBuffer *commandBuffer, bool isV1 );
+                                           CommandBuffer *commandBuffer, bool isV1,
+                                           size_t threadIdx );
 
     public:
         HlmsPbs( Archive *dataFolder, ArchiveVec *libraryFolders );
@@ -272,6 +270,14 @@ namespace Ogre
                                          bool casterPass, uint32 lastCacheHash,
                                          CommandBuffer *commandBuffer );
 
+        virtual bool supportsParallelFillBuffers(void) const        { return true; }
+        virtual void _beginParallelFillBuffers( size_t numThreads, size_t numRenderablesPerThread,
+                                                CommandBuffer *commandBuffer );
+        virtual uint32 fillBuffersForV2Mt( size_t threadIdx, const HlmsCache *cache,
+                                           const QueuedRenderable &queuedRenderable,
+                                           bool casterPass, uint32 lastCacheHash,
+                                           CommandBuffer *commandBuffer );
+
         virtual void postCommandBufferExecution( CommandBuffer *commandBuffer );
         virtual void frameEnded(void);
 
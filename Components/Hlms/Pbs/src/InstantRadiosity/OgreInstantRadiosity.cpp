@@ -632,8 +632,6 @@ namespace Ogre
         RandomNumberGenerator rng;
         mRayHits.resize( mTotalNumRays );
 
-        ArrayRay * RESTRICT_ALIAS arrayRays = mArrayRays.get();
-
         for( size_t i=0; i<mNumRays; ++i )
         {
             mRayHits[i].distance = std::numeric_limits<Real>::max();
@@ -666,10 +664,6 @@ namespace Ogre
                 mRayHits[i].ray.setOrigin( randomPos );
                 mRayHits[i].ray.setDirection( -lightRot.zAxis() );
             }
-
-            arrayRays->mOrigin.setAll( mRayHits[i].ray.getOrigin() );
-            arrayRays->mDirection.setAll( mRayHits[i].ray.getDirection() );
-            ++arrayRays;
         }
 
         //Initialize all other rays (some rays may not be initialized
@@ -682,24 +676,7 @@ namespace Ogre
 
         for( size_t k=0; k<mNumRayBounces + 1u; ++k )
         {
-            for( size_t i=0; i<NUM_SCENE_MEMORY_MANAGER_TYPES; ++i )
-            {
-                ObjectMemoryManager &memoryManager = mSceneManager->_getEntityMemoryManager(
-                            static_cast<SceneMemoryMgrTypes>(i) );
-
-                const size_t numRenderQueues = memoryManager.getNumRenderQueues();
-
-                size_t firstRq = std::min<size_t>( mFirstRq, numRenderQueues );
-                size_t lastRq  = std::min<size_t>( mLastRq,  numRenderQueues );
-
-                for( size_t j=firstRq; j<lastRq; ++j )
-                {
-                    ObjectData objData;
-                    const size_t totalObjs = memoryManager.getFirstObjectData( objData, j );
-                    testLightVsAllObjects( lightType, lightRange, objData, totalObjs,
-                                           areaOfInterest, rayStart, numRays );
-                }
-            }
+            raycastLightRays( lightType, lightRange, areaOfInterest, rayStart, numRays );
 
             const size_t oldRayStart    = rayStart;
             const size_t oldNumRays     = numRays;
@@ -725,8 +702,6 @@ namespace Ogre
 
         const Real bias = mBias;
 
-        ArrayRay * RESTRICT_ALIAS arrayRays = mArrayRays.get();
-
         while( rayIdx < raySrcLimit && raysRemaining > 0 )
         {
             while( rayIdx < raySrcLimit &&
@@ -745,8 +720,6 @@ namespace Ogre
                 mRayHits[i].accumDistance = hit.accumDistance + hit.distance;
                 mRayHits[i].ray.setOrigin( pointOnTri );
                 mRayHits[i].ray.setDirection( rng.randomizeDirAroundCone( hit.triNormal, Degree( 90.0f ) ) );
-                arrayRays[i].mOrigin.setAll( mRayHits[i].ray.getOrigin() );
-                arrayRays[i].mDirection.setAll( mRayHits[i].ray.getDirection() );
 
                 ++rayIdx;
                 --raysRemaining;
@@ -907,6 +880,11 @@ namespace Ogre
             }
         }
 
+        meshData.bvh = OGRE_NEW TriangleBvh();
+        meshData.bvh->build( meshData.vertexData, 3u, meshData.indexDataConst,
+                             meshData.indexDataConst ? meshData.numIndices : meshData.numVertices,
+                             meshData.useIndices16bit );
+
         mMeshDataMapV2[vao] = meshData;
 
         return &mMeshDataMapV2[vao];
@@ -1036,6 +1014,11 @@ namespace Ogre
                     renderOp.indexData->indexBuffer->getIndexSize() );
         }
 
+        meshData.bvh = OGRE_NEW TriangleBvh();
+        meshData.bvh->build( meshData.vertexData, 3u, meshData.indexDataConst,
+                             meshData.indexDataConst ? meshData.numIndices : meshData.numVertices,
+                             meshData.useIndices16bit );
+
         mMeshDataMapV1[renderOp] = meshData;
 
         return &mMeshDataMapV1[renderOp];
@@ -1054,157 +1037,209 @@ namespace Ogre
         return itor->second;
     }
     //-----------------------------------------------------------------------------------
-    void InstantRadiosity::testLightVsAllObjects( uint8 lightType, Real lightRange,
-                                                  ObjectData objData, size_t numNodes,
-                                                  const AreaOfInterest &scalarAreaOfInterest,
-                                                  size_t rayStart, size_t numRays )
+    /// Multiplies each ray of the packet by an affine matrix.
+    static inline ArrayVector3 transformArrayAffine( const Matrix4 &m, const ArrayVector3 &v,
+                                                     bool isPosition )
+    {
+        ArrayVector3 retVal;
+        for( size_t i=0; i<3u; ++i )
+        {
+            retVal.mChunkBase[i] = Mathlib::SetAll( m[i][0] ) * v.mChunkBase[0] +
+                                   Mathlib::SetAll( m[i][1] ) * v.mChunkBase[1] +
+                                   Mathlib::SetAll( m[i][2] ) * v.mChunkBase[2];
+            if( isPosition )
+                retVal.mChunkBase[i] = retVal.mChunkBase[i] + Mathlib::SetAll( m[i][3] );
+        }
+        return retVal;
+    }
+    //-----------------------------------------------------------------------------------
+    /// Leaf test for mInstancesBvh. Casts the packet against the instance's mesh BVH.
+    struct InstantRadiosity::InstanceRayTest
     {
-        Aabb biggestAoI = scalarAreaOfInterest.aabb;
-        biggestAoI.merge( Aabb( biggestAoI.mCenter, Vector3( scalarAreaOfInterest.sphereRadius ) ) );
+        RaycastInstanceVec const    *instances;
+        Bvh const                   *instancesBvh;
+        ArrayRay                    rays;
+        /// Null unless it's a directional light. See mAoI.
+        Aabb const                  *areaOfInterest;
 
-        const ArrayInt sceneFlags = Mathlib::SetAll( mVisibilityMask &
-                                                     VisibilityFlags::RESERVED_VISIBILITY_FLAGS );
-        ArrayAabb areaOfInterest( ArrayVector3::ZERO, ArrayVector3::ZERO );
-        areaOfInterest.setAll( biggestAoI );
+        uint32                      hitMask;
+        uint32                      closestInstance[ARRAY_PACKED_REALS];
+        uint32                      closestTriangle[ARRAY_PACKED_REALS];
 
-        for( size_t i=0; i<numNodes; i += ARRAY_PACKED_REALS )
+        void operator () ( uint32 slot, ArrayReal &inOutMaxDistance )
         {
-            ArrayInt * RESTRICT_ALIAS visibilityFlags = reinterpret_cast<ArrayInt*RESTRICT_ALIAS>
-                                                                        (objData.mVisibilityFlags);
+            const uint32 instanceIdx = instancesBvh->getPrimitiveIndex( slot );
+            const RaycastInstance &instance = (*instances)[instanceIdx];
 
-            //isObjectHitByRays = isVisble;
-            ArrayMaskI isObjectHitByRays = Mathlib::TestFlags4( *visibilityFlags,
-                                               Mathlib::SetAll( VisibilityFlags::LAYER_VISIBILITY ) );
-            //isObjectHitByRays = isVisble & (sceneFlags & visibilityFlags);
-            isObjectHitByRays = Mathlib::And( isObjectHitByRays,
-                                              Mathlib::TestFlags4( sceneFlags, *visibilityFlags ) );
+            if( areaOfInterest && !areaOfInterest->intersects( instance.worldAabb ) )
+                return;
 
-            if( lightType == Light::LT_DIRECTIONAL )
+            //The direction isn't normalized after the transform,
+            //so that distances are the same in both spaces.
+            ArrayRay localRays;
+            localRays.mOrigin    = transformArrayAffine( instance.invWorldMatrix, rays.mOrigin, true );
+            localRays.mDirection = transformArrayAffine( instance.invWorldMatrix,
+                                                         rays.mDirection, false );
+
+            uint32 triangleIdx[ARRAY_PACKED_REALS];
+            const uint32 instanceHitMask = instance.meshData->bvh->raycast(
+                        localRays, inOutMaxDistance, !instance.flipsWinding,
+                        instance.flipsWinding, triangleIdx );
+
+            for( size_t i=0; i<ARRAY_PACKED_REALS; ++i )
             {
-                //Check if obj is in area of interest for directional lights
-                ArrayMaskI hitMask = CastRealToInt( areaOfInterest.intersects( *objData.mWorldAabb ) );
-                isObjectHitByRays = Mathlib::And( isObjectHitByRays, hitMask );
+                if( IS_BIT_SET( i, instanceHitMask ) )
+                {
+                    closestInstance[i] = instanceIdx;
+                    closestTriangle[i] = triangleIdx[i];
+                }
             }
 
-            if( BooleanMask4::getScalarMask( isObjectHitByRays ) == 0 )
+            hitMask |= instanceHitMask;
+        }
+    };
+    //-----------------------------------------------------------------------------------
+    void InstantRadiosity::collectRaycastInstances(void)
+    {
+        mRaycastInstances.clear();
+
+        for( size_t i=0; i<NUM_SCENE_MEMORY_MANAGER_TYPES; ++i )
+        {
+            ObjectMemoryManager &memoryManager = mSceneManager->_getEntityMemoryManager(
+                        static_cast<SceneMemoryMgrTypes>(i) );
+
+            const size_t numRenderQueues = memoryManager.getNumRenderQueues();
+
+            size_t firstRq = std::min<size_t>( mFirstRq, numRenderQueues );
+            size_t lastRq  = std::min<size_t>( mLastRq,  numRenderQueues );
+
+            for( size_t j=firstRq; j<lastRq; ++j )
             {
-                //None of these objects are visible. Early out.
-                objData.advancePack();
-                continue;
+                ObjectData objData;
+                const size_t totalObjs = memoryManager.getFirstObjectData( objData, j );
+                collectRaycastInstances( objData, totalObjs );
             }
+        }
 
-            for( size_t k=0; k<ARRAY_PACKED_REALS; ++k )
-                mTmpRaysThatHitObject[k].clear();
+        vector<Aabb>::type instanceAabbs;
+        instanceAabbs.reserve( mRaycastInstances.size() );
 
-            //Make a list of rays that hit these objects (i.e. broadphase)
-            ArrayRay * RESTRICT_ALIAS arrayRays = mArrayRays.get() + rayStart;
-            for( size_t j=0; j<numRays; ++j )
-            {
-                ArrayMaskR rayHits = arrayRays->intersects( *objData.mWorldAabb );
-                uint32 scalarRayHits = BooleanMask4::getScalarMask( rayHits );
-                for( size_t k=0; k<ARRAY_PACKED_REALS; ++k )
-                {
-                    if( IS_BIT_SET( k, scalarRayHits ) )
-                        mTmpRaysThatHitObject[k].push_back( j + rayStart );
-                }
+        RaycastInstanceVec::const_iterator itor = mRaycastInstances.begin();
+        RaycastInstanceVec::const_iterator end  = mRaycastInstances.end();
 
-                ++arrayRays;
-            }
+        while( itor != end )
+        {
+            instanceAabbs.push_back( itor->worldAabb );
+            ++itor;
+        }
+
+        mInstancesBvh.build( instanceAabbs.empty() ? 0 : &instanceAabbs[0], instanceAabbs.size() );
+    }
+    //-----------------------------------------------------------------------------------
+    void InstantRadiosity::collectRaycastInstances( ObjectData objData, size_t numNodes )
+    {
+        const uint32 sceneFlags = mVisibilityMask & VisibilityFlags::RESERVED_VISIBILITY_FLAGS;
 
+        for( size_t i=0; i<numNodes; i += ARRAY_PACKED_REALS )
+        {
             for( size_t j=0; j<ARRAY_PACKED_REALS; ++j )
             {
-                //Convert isObjectHitByRays into something smaller we can work with.
-                uint32 scalarIsObjectHitByRays = BooleanMask4::getScalarMask( isObjectHitByRays );
+                const uint32 visibilityFlags = objData.mVisibilityFlags[j];
 
-                if( !mTmpRaysThatHitObject[j].empty() &&
-                    IS_BIT_SET( j, scalarIsObjectHitByRays ) )
+                if( !(visibilityFlags & VisibilityFlags::LAYER_VISIBILITY) ||
+                    !(visibilityFlags & sceneFlags) )
                 {
-                    MovableObject *movableObject = objData.mOwner[j];
+                    continue;
+                }
+
+                MovableObject *movableObject = objData.mOwner[j];
+
+                RaycastInstance instance;
+                instance.worldMatrix = movableObject->_getParentNodeFullTransform();
+                instance.invWorldMatrix = instance.worldMatrix.inverseAffine();
+                instance.worldAabb = objData.mWorldAabb->getAsAabb( j );
+                instance.flipsWinding = instance.worldMatrix.hasNegativeScale();
 
-                    const Matrix4 &worldMatrix = movableObject->_getParentNodeFullTransform();
-                    RenderableArray::const_iterator itor = movableObject->mRenderables.begin();
-                    RenderableArray::const_iterator end  = movableObject->mRenderables.end();
+                RenderableArray::const_iterator itor = movableObject->mRenderables.begin();
+                RenderableArray::const_iterator end  = movableObject->mRenderables.end();
 
-                    while( itor != end )
+                while( itor != end )
+                {
+                    HlmsDatablock *datablock = (*itor)->getDatablock();
+
+                    if( datablock->mType == HLMS_PBS )
                     {
                         const VertexArrayObjectArray &vaos = (*itor)->getVaos( VpNormal );
-                        MeshData const *meshData = 0;
                         if( !vaos.empty() )
                         {
                             //v2 object
                             VertexArrayObject *vao = vaos[0]; //TODO Allow picking a LOD.
-                            meshData = downloadVao( vao );
+                            instance.meshData = downloadVao( vao );
                         }
                         else
                         {
                             //v1 object
                             v1::RenderOperation renderOp;
                             (*itor)->getRenderOperation( renderOp, false );
-                            meshData = downloadRenderOp( renderOp );
+                            instance.meshData = downloadRenderOp( renderOp );
                         }
 
-                        HlmsDatablock *datablock = (*itor)->getDatablock();
-
-                        if( datablock->mType == HLMS_PBS )
+                        MaterialData &material = instance.material;
+                        memset( &material, 0, sizeof(material) );
+                        int imageIdx = 0;
+
+                        HlmsPbsDatablock *pbsDatablock = static_cast<HlmsPbsDatablock*>( datablock );
+                        //TODO: Should we account fresnel here? What about metalness?
+                        material.diffuse = pbsDatablock->getDiffuse();
+                        TextureGpu *diffuseTex = pbsDatablock->getTexture( PBSM_DIFFUSE );
+                        if( diffuseTex )
+                            diffuseTex->waitForMetadata();
+                        if( !diffuseTex ||
+                            PixelFormatGpuUtils::isCompressed( diffuseTex->getPixelFormat() ) )
                         {
-                            MaterialData material;
-                            memset( &material, 0, sizeof(material) );
-                            int imageIdx = 0;
-
-                            HlmsPbsDatablock *pbsDatablock = static_cast<HlmsPbsDatablock*>( datablock );
-                            //TODO: Should we account fresnel here? What about metalness?
-                            material.diffuse = pbsDatablock->getDiffuse();
-                            TextureGpu *diffuseTex = pbsDatablock->getTexture( PBSM_DIFFUSE );
-                            if( diffuseTex )
-                                diffuseTex->waitForMetadata();
-                            if( !diffuseTex ||
-                                PixelFormatGpuUtils::isCompressed( diffuseTex->getPixelFormat() ) )
-                            {
-                                const ColourValue &bgDiffuse = pbsDatablock->getBackgroundDiffuse();
-                                material.diffuse.x *= bgDiffuse.r;
-                                material.diffuse.y *= bgDiffuse.g;
-                                material.diffuse.z *= bgDiffuse.b;
-                            }
-                            else if( mUseTextures )
-                            {
-                                material.image[imageIdx] = &downloadTexture( diffuseTex );
-                                material.box[imageIdx]   = material.image[imageIdx]->getData(0);
-                                material.uvSet[imageIdx] =
-                                        pbsDatablock->getTextureUvSource( PBSM_DIFFUSE );
-                                material.needsUv = true;
-                                ++imageIdx;
-                            }
+                            const ColourValue &bgDiffuse = pbsDatablock->getBackgroundDiffuse();
+                            material.diffuse.x *= bgDiffuse.r;
+                            material.diffuse.y *= bgDiffuse.g;
+                            material.diffuse.z *= bgDiffuse.b;
+                        }
+                        else if( mUseTextures )
+                        {
+                            material.image[imageIdx] = &downloadTexture( diffuseTex );
+                            material.box[imageIdx]   = material.image[imageIdx]->getData(0);
+                            material.uvSet[imageIdx] =
+                                    pbsDatablock->getTextureUvSource( PBSM_DIFFUSE );
+                            material.needsUv = true;
+                            ++imageIdx;
+                        }
 
-                            if( mUseTextures )
+                        if( mUseTextures )
+                        {
+                            for( int k=0; k<4; ++k )
                             {
-                                for( int k=0; k<4; ++k )
+                                const PbsTextureTypes texType = static_cast<PbsTextureTypes>(
+                                                                            PBSM_DETAIL0 + k );
+                                TextureGpu *detailTex = pbsDatablock->getTexture( texType );
+                                if( detailTex )
+                                    detailTex->waitForMetadata();
+                                if( detailTex &&
+                                    !PixelFormatGpuUtils::isCompressed(
+                                        detailTex->getPixelFormat() ) )
                                 {
-                                    const PbsTextureTypes texType = static_cast<PbsTextureTypes>(
-                                                                                PBSM_DETAIL0 + k );
-                                    TextureGpu *detailTex = pbsDatablock->getTexture( texType );
-                                    if( detailTex )
-                                        detailTex->waitForMetadata();
-                                    if( detailTex &&
-                                        !PixelFormatGpuUtils::isCompressed(
-                                            detailTex->getPixelFormat() ) )
-                                    {
-                                        material.image[imageIdx] = &downloadTexture( detailTex );
-                                        material.box[imageIdx]   = material.image[imageIdx]->getData(0);
-                                        material.uvSet[imageIdx] =
-                                                pbsDatablock->getTextureUvSource( texType );
-                                        material.needsUv = true;
-                                        ++imageIdx;
-                                    }
+                                    material.image[imageIdx] = &downloadTexture( detailTex );
+                                    material.box[imageIdx]   = material.image[imageIdx]->getData(0);
+                                    material.uvSet[imageIdx] =
+                                            pbsDatablock->getTextureUvSource( texType );
+                                    material.needsUv = true;
+                                    ++imageIdx;
                                 }
                             }
-
-                            raycastLightRayVsMesh( lightRange, *meshData,
-                                                   worldMatrix, material,
-                                                   mTmpRaysThatHitObject[j] );
                         }
 
-                        ++itor;
+                        if( instance.meshData->bvh->getNumTriangles() )
+                            mRaycastInstances.push_back( instance );
                     }
+
+                    ++itor;
                 }
             }
 
@@ -1212,103 +1247,117 @@ namespace Ogre
         }
     }
     //-----------------------------------------------------------------------------------
-    void InstantRadiosity::raycastLightRayVsMesh( Real lightRange, const MeshData meshData,
-                                                  Matrix4 worldMatrix, const MaterialData &material,
-                                                  const FastArray<size_t> &raysThatHitObj )
+    void InstantRadiosity::raycastLightRays( uint8 lightType, Real lightRange,
+                                             const AreaOfInterest &areaOfInterest,
+                                             size_t rayStart, size_t numRays )
     {
-        const size_t numElements = meshData.indexData ? meshData.numIndices : meshData.numVertices;
+        Aabb biggestAoI = areaOfInterest.aabb;
+        biggestAoI.merge( Aabb( biggestAoI.mCenter, Vector3( areaOfInterest.sphereRadius ) ) );
 
-        const uint16 * RESTRICT_ALIAS indexData16 = reinterpret_cast<const uint16 * RESTRICT_ALIAS>(
-                    meshData.indexData );
-        const uint32 * RESTRICT_ALIAS indexData32 = reinterpret_cast<const uint32 * RESTRICT_ALIAS>(
-                    meshData.indexData );
+        InstanceRayTest rayTest;
+        rayTest.instances       = &mRaycastInstances;
+        rayTest.instancesBvh    = &mInstancesBvh;
+        rayTest.areaOfInterest  = lightType == Light::LT_DIRECTIONAL ? &biggestAoI : 0;
 
-        for( size_t i=0; i<numElements; i += 3 )
+        const size_t rayEnd = rayStart + numRays;
+
+        for( size_t i=rayStart; i<rayEnd; i += ARRAY_PACKED_REALS )
         {
-            Vector3 triVerts[3];
+            //Build a packet. Unused lanes get a negative distance to disable them.
+            ArrayReal maxDistance = ARRAY_REAL_ZERO;
+            for( size_t j=0; j<ARRAY_PACKED_REALS; ++j )
+            {
+                const size_t rayIdx = std::min( i + j, rayEnd - 1u );
+                const Ray &ray = mRayHits[rayIdx].ray;
+                rayTest.rays.mOrigin.setFromVector3( ray.getOrigin(), j );
+                rayTest.rays.mDirection.setFromVector3( ray.getDirection(), j );
+                Mathlib::Set( maxDistance, i + j < rayEnd ? lightRange : Real( -1.0f ), j );
+            }
 
-            uint32 vertexIdx[3];
+            rayTest.hitMask = 0;
+            mInstancesBvh.traverse( rayTest.rays, maxDistance, rayTest );
 
-            if( meshData.indexData )
+            if( rayTest.hitMask )
             {
-                if( meshData.useIndices16bit )
-                {
-                    vertexIdx[0] = indexData16[i+0];
-                    vertexIdx[1] = indexData16[i+1];
-                    vertexIdx[2] = indexData16[i+2];
-                }
-                else
+                OGRE_ALIGNED_DECL( Real, scalarDistance[ARRAY_PACKED_REALS], OGRE_SIMD_ALIGNMENT );
+                CastArrayToReal( scalarDistance, maxDistance );
+
+                for( size_t j=0; j<ARRAY_PACKED_REALS; ++j )
                 {
-                    vertexIdx[0] = indexData32[i+0];
-                    vertexIdx[1] = indexData32[i+1];
-                    vertexIdx[2] = indexData32[i+2];
+                    if( IS_BIT_SET( j, rayTest.hitMask ) )
+                    {
+                        RayHit &rayHit = mRayHits[i + j];
+                        rayHit.distance = scalarDistance[j];
+                        fillRayHit( rayHit, mRaycastInstances[rayTest.closestInstance[j]],
+                                    rayTest.closestTriangle[j] );
+                    }
                 }
             }
+        }
+    }
+    //-----------------------------------------------------------------------------------
+    void InstantRadiosity::fillRayHit( RayHit &rayHit, const RaycastInstance &instance,
+                                       uint32 triangleIdx )
+    {
+        const MeshData &meshData = *instance.meshData;
+
+        uint32 vertexIdx[3];
+
+        if( meshData.indexData )
+        {
+            const size_t i = triangleIdx * 3u;
+            if( meshData.useIndices16bit )
+            {
+                const uint16 * RESTRICT_ALIAS indexData16 =
+                        reinterpret_cast<const uint16 * RESTRICT_ALIAS>( meshData.indexData );
+                vertexIdx[0] = indexData16[i+0];
+                vertexIdx[1] = indexData16[i+1];
+                vertexIdx[2] = indexData16[i+2];
+            }
             else
             {
-                vertexIdx[0] = i+0;
-                vertexIdx[1] = i+1;
-                vertexIdx[2] = i+2;
+                const uint32 * RESTRICT_ALIAS indexData32 =
+                        reinterpret_cast<const uint32 * RESTRICT_ALIAS>( meshData.indexData );
+                vertexIdx[0] = indexData32[i+0];
+                vertexIdx[1] = indexData32[i+1];
+                vertexIdx[2] = indexData32[i+2];
             }
+        }
+        else
+        {
+            vertexIdx[0] = triangleIdx * 3u + 0u;
+            vertexIdx[1] = triangleIdx * 3u + 1u;
+            vertexIdx[2] = triangleIdx * 3u + 2u;
+        }
 
-            triVerts[0].x = meshData.vertexData[vertexIdx[0] * 3u + 0];
-            triVerts[0].y = meshData.vertexData[vertexIdx[0] * 3u + 1];
-            triVerts[0].z = meshData.vertexData[vertexIdx[0] * 3u + 2];
-            triVerts[1].x = meshData.vertexData[vertexIdx[1] * 3u + 0];
-            triVerts[1].y = meshData.vertexData[vertexIdx[1] * 3u + 1];
-            triVerts[1].z = meshData.vertexData[vertexIdx[1] * 3u + 2];
-            triVerts[2].x = meshData.vertexData[vertexIdx[2] * 3u + 0];
-            triVerts[2].y = meshData.vertexData[vertexIdx[2] * 3u + 1];
-            triVerts[2].z = meshData.vertexData[vertexIdx[2] * 3u + 2];
-
-            triVerts[0] = worldMatrix * triVerts[0];
-            triVerts[1] = worldMatrix * triVerts[1];
-            triVerts[2] = worldMatrix * triVerts[2];
-
-            Vector3 triNormal = Math::calculateBasicFaceNormalWithoutNormalize(
-                        triVerts[0], triVerts[1], triVerts[2] );
-            triNormal.normalise();
-
-            FastArray<size_t>::const_iterator itRayIdx = raysThatHitObj.begin();
-            FastArray<size_t>::const_iterator enRayIdx = raysThatHitObj.end();
-            while( itRayIdx != enRayIdx )
-            {
-                Ray ray = mRayHits[*itRayIdx].ray;
+        for( size_t i=0; i<3u; ++i )
+        {
+            Vector3 vertex;
+            vertex.x = meshData.vertexData[vertexIdx[i] * 3u + 0];
+            vertex.y = meshData.vertexData[vertexIdx[i] * 3u + 1];
+            vertex.z = meshData.vertexData[vertexIdx[i] * 3u + 2];
+            rayHit.triVerts[i] = instance.worldMatrix * vertex;
+        }
 
-                const std::pair<bool, Real> inters = Math::intersects(
-                            ray, triVerts[0], triVerts[1], triVerts[2], triNormal, true, false );
+        rayHit.triNormal = Math::calculateBasicFaceNormalWithoutNormalize(
+                    rayHit.triVerts[0], rayHit.triVerts[1], rayHit.triVerts[2] );
+        rayHit.triNormal.normalise();
 
-                if( inters.first )
-                {
-                    RayHit &rayHit = mRayHits[*itRayIdx];
-                    if( inters.second < rayHit.distance &&
-                        inters.second <= lightRange )
-                    {
-                        rayHit.distance = inters.second;
-                        rayHit.material = material;
-                        rayHit.triVerts[0] = triVerts[0];
-                        rayHit.triVerts[1] = triVerts[1];
-                        rayHit.triVerts[2] = triVerts[2];
-                        rayHit.triNormal = triNormal;
-
-                        for( int j=0; j<5 && material.image[j]; ++j )
-                        {
-                            const uint8 uvSet = material.uvSet[j];
-                            const float * RESTRICT_ALIAS uvPtr = meshData.getUvStart( uvSet );
-                            rayHit.triUVs[j][0].x = uvPtr[vertexIdx[0] * 2u + 0];
-                            rayHit.triUVs[j][0].y = uvPtr[vertexIdx[0] * 2u + 1];
+        const MaterialData &material = instance.material;
+        rayHit.material = material;
 
-                            rayHit.triUVs[j][1].x = uvPtr[vertexIdx[1] * 2u + 0];
-                            rayHit.triUVs[j][1].y = uvPtr[vertexIdx[1] * 2u + 1];
+        for( int j=0; j<5 && material.image[j]; ++j )
+        {
+            const uint8 uvSet = material.uvSet[j];
+            const float * RESTRICT_ALIAS uvPtr = meshData.getUvStart( uvSet );
+            rayHit.triUVs[j][0].x = uvPtr[vertexIdx[0] * 2u + 0];
+            rayHit.triUVs[j][0].y = uvPtr[vertexIdx[0] * 2u + 1];
 
-                            rayHit.triUVs[j][2].x = uvPtr[vertexIdx[2] * 2u + 0];
-                            rayHit.triUVs[j][2].y = uvPtr[vertexIdx[2] * 2u + 1];
-                        }
-                    }
-                }
+            rayHit.triUVs[j][1].x = uvPtr[vertexIdx[1] * 2u + 0];
+            rayHit.triUVs[j][1].y = uvPtr[vertexIdx[1] * 2u + 1];
 
-                ++itRayIdx;
-            }
+            rayHit.triUVs[j][2].x = uvPtr[vertexIdx[2] * 2u + 0];
+            rayHit.triUVs[j][2].y = uvPtr[vertexIdx[2] * 2u + 1];
         }
     }
     //-----------------------------------------------------------------------------------
@@ -1436,7 +1485,7 @@ namespace Ogre
                          "InstantRadiosity::build" );
         }
 
-        mArrayRays = RawSimdUniquePtr<ArrayRay, MEMCATEGORY_GENERAL>( mTotalNumRays );
+        collectRaycastInstances();
 
         const uint32 lightMask = mLightMask & VisibilityFlags::RESERVED_VISIBILITY_FLAGS;
 
@@ -1512,8 +1561,9 @@ namespace Ogre
 
         updateExistingVpls();
 
-        //Free memory
-        mArrayRays = RawSimdUniquePtr<ArrayRay, MEMCATEGORY_GENERAL>();
+        //Free memory. The mesh BVHs are kept along with the MeshData (see freeMemory)
+        mRaycastInstances.clear();
+        mInstancesBvh.clear();
 
         if( aoiAutogenerated )
             mAoI.clear();
@@ -1530,6 +1580,8 @@ namespace Ogre
                 MeshData &meshData = itor->second;
                 OGRE_FREE_SIMD( meshData.vertexData, MEMCATEGORY_GEOMETRY );
                 meshData.vertexData = 0;
+                OGRE_DELETE meshData.bvh;
+                meshData.bvh = 0;
                 if( meshData.indexData && !itor->first->getIndexBuffer()->getShadowCopy() )
                 {
                     OGRE_FREE_SIMD( meshData.indexData, MEMCATEGORY_GEOMETRY );
@@ -1549,6 +1601,8 @@ namespace Ogre
                 MeshData &meshData = itor->second;
                 OGRE_FREE_SIMD( meshData.vertexData, MEMCATEGORY_GEOMETRY );
                 meshData.vertexData = 0;
+                OGRE_DELETE meshData.bvh;
+                meshData.bvh = 0;
                 if( meshData.indexData )
                 {
                     OGRE_FREE_SIMD( meshData.indexData, MEMCATEGORY_GEOMETRY );
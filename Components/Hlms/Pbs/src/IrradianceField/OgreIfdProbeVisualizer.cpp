@@ -50,6 +50,7 @@ namespace Ogre
         mObjectData.mLocalAabb->setFromAabb( aabb, mObjectData.mIndex );
         mObjectData.mWorldAabb->setFromAabb( aabb, mObjectData.mIndex );
         mObjectData.mLocalRadius[mObjectData.mIndex] = aabb.getRadius();
+        _notifyLocalAabbDirty();
         mObjectData.mWorldRadius[mObjectData.mIndex] = aabb.getRadius();
 
         createBuffers();
@@ -152,6 +153,7 @@ namespace Ogre
         mObjectData.mLocalAabb->setFromAabb( aabb, mObjectData.mIndex );
         mObjectData.mWorldAabb->setFromAabb( aabb, mObjectData.mIndex );
         mObjectData.mLocalRadius[mObjectData.mIndex] = aabb.getRadius();
+        _notifyLocalAabbDirty();
         mObjectData.mWorldRadius[mObjectData.mIndex] = aabb.getRadius();
     }
     //-----------------------------------------------------------------------------------
@@ -283,7 +283,6 @@ namespace Ogre
         mPlanarReflections( 0 ),
         mPlanarReflectionsSamplerblock( 0 ),
         mHasPlanarReflections( false ),
-        mLastBoundPlanarReflection( 0u ),
 #endif
         mAreaLightMasks( 0 ),
         mAreaLightMasksSamplerblock( 0 ),
@@ -293,11 +292,8 @@ namespace Ogre
         mLtcMatrixTexture( 0 ),
         mDecalsDiffuseMergedEmissive( false ),
         mDecalsSamplerblock( 0 ),
-        mLastBoundPool( 0 ),
         mConstantBiasScale( 0.1f ),
         mHasSeparateSamplers( 0 ),
-        mLastDescTexture( 0 ),
-        mLastDescSampler( 0 ),
         mReservedTexBufferSlots( 1u ),  // Vertex shader consumes 1 slot with its tbuffer.
         mReservedTexSlots( 0u ),
 #if !OGRE_NO_FINE_LIGHT_MASK_GRANULARITY
@@ -318,6 +314,9 @@ namespace Ogre
         mAmbientLightMode( AmbientAuto )
     {
         memset( mDecalsTextures, 0, sizeof( mDecalsTextures ) );
+#ifdef OGRE_BUILD_COMPONENT_PLANAR_REFLECTIONS
+        mLastBoundPlanarReflection.resize( 1u, 0u );
+#endif
 
         //Override defaults
         mLightGatheringMode = LightGatherForwardPlus;
@@ -1605,7 +1604,7 @@ namespace Ogre
 
 #ifdef OGRE_BUILD_COMPONENT_PLANAR_REFLECTIONS
             mHasPlanarReflections = false;
-            mLastBoundPlanarReflection = 0u;
+            mLastBoundPlanarReflection[0] = 0u;
             if( mPlanarReflections &&
                 mPlanarReflections->cameraMatches( sceneManager->getCamerasInProgress().renderingCamera ) )
             {
@@ -2848,7 +2847,7 @@ namespace Ogre
                                       CommandBuffer *commandBuffer )
     {
         return fillBuffersFor( cache, queuedRenderable, casterPass,
-                               lastCacheHash, commandBuffer, true );
+                               lastCacheHash, commandBuffer, true, 0u );
     }
     //-----------------------------------------------------------------------------------
     uint32 HlmsPbs::fillBuffersForV2( const HlmsCache *cache,
@@ -2857,13 +2856,35 @@ namespace Ogre
                                       CommandBuffer *commandBuffer )
     {
         return fillBuffersFor( cache, queuedRenderable, casterPass,
-                               lastCacheHash, commandBuffer, false );
+                               lastCacheHash, commandBuffer, false, 0u );
+    }
+    //-----------------------------------------------------------------------------------
+    void HlmsPbs::_beginParallelFillBuffers( size_t numThreads, size_t numRenderablesPerThread,
+                                             CommandBuffer *commandBuffer )
+    {
+        HlmsBufferManager::_beginParallelFillBuffers( numThreads, numRenderablesPerThread,
+                                                      commandBuffer );
+#ifdef OGRE_BUILD_COMPONENT_PLANAR_REFLECTIONS
+        if( mLastBoundPlanarReflection.size() < numThreads )
+            mLastBoundPlanarReflection.resize( numThreads, 0u );
+#endif
+    }
+    //-----------------------------------------------------------------------------------
+    uint32 HlmsPbs::fillBuffersForV2Mt( size_t threadIdx, const HlmsCache *cache,
+                                        const QueuedRenderable &queuedRenderable,
+                                        bool casterPass, uint32 lastCacheHash,
+                                        CommandBuffer *commandBuffer )
+    {
+        return fillBuffersFor( cache, queuedRenderable, casterPass,
+                               lastCacheHash, commandBuffer, false, threadIdx );
     }
     //-----------------------------------------------------------------------------------
     uint32 HlmsPbs::fillBuffersFor( const HlmsCache *cache, const QueuedRenderable &queuedRenderable,
                                     bool casterPass, uint32 lastCacheHash,
-                                    CommandBuffer *commandBuffer, bool isV1 )
+                                    CommandBuffer *commandBuffer, bool isV1, size_t threadIdx )
     {
+        HlmsBufferFillState &fs = getFillState( threadIdx );
+
         assert( dynamic_cast<const HlmsPbsDatablock*>( queuedRenderable.renderable->getDatablock() ) );
         const HlmsPbsDatablock *datablock = static_cast<const HlmsPbsDatablock*>(
                                                 queuedRenderable.renderable->getDatablock() );
@@ -3050,32 +3071,32 @@ namespace Ogre
                 }
             }
 
-            mLastDescTexture = 0;
-            mLastDescSampler = 0;
-            mLastBoundPool = 0;
+            fs.mLastDescTexture = 0;
+            fs.mLastDescSampler = 0;
+            fs.mLastBoundPool = 0;
 
             //layout(binding = 2) uniform InstanceBuffer {} instance
-            if( mCurrentConstBuffer < mConstBuffers.size() &&
-                (size_t)((mCurrentMappedConstBuffer - mStartMappedConstBuffer) + 4) <=
-                    mCurrentConstBufferSize )
+            if( fs.mCurrentConstBuffer < fs.mConstBuffers.size() &&
+                (size_t)((fs.mCurrentMappedConstBuffer - fs.mStartMappedConstBuffer) + 4) <=
+                    fs.mCurrentConstBufferSize )
             {
                 *commandBuffer->addCommand<CbShaderBuffer>() =
-                        CbShaderBuffer( VertexShader, 2, mConstBuffers[mCurrentConstBuffer], 0, 0 );
+                        CbShaderBuffer( VertexShader, 2, fs.mConstBuffers[fs.mCurrentConstBuffer], 0, 0 );
                 *commandBuffer->addCommand<CbShaderBuffer>() =
-                        CbShaderBuffer( PixelShader, 2, mConstBuffers[mCurrentConstBuffer], 0, 0 );
+                        CbShaderBuffer( PixelShader, 2, fs.mConstBuffers[fs.mCurrentConstBuffer], 0, 0 );
             }
 
-            rebindTexBuffer( commandBuffer );
+            rebindTexBuffer( fs, commandBuffer );
 
 #ifdef OGRE_BUILD_COMPONENT_PLANAR_REFLECTIONS
-            mLastBoundPlanarReflection = 0u;
+            mLastBoundPlanarReflection[threadIdx] = 0u;
 #endif
             mListener->hlmsTypeChanged( casterPass, commandBuffer, datablock, texUnit );
         }
 
         //Don't bind the material buffer on caster passes (important to keep
         //MDI & auto-instancing running on shadow map passes)
-        if( mLastBoundPool != datablock->getAssignedPool() &&
+        if( fs.mLastBoundPool != datablock->getAssignedPool() &&
             (!casterPass || datablock->getAlphaTest() != CMPF_ALWAYS_PASS) )
         {
             //layout(binding = 1) uniform MaterialBuf {} materialArray
@@ -3095,11 +3116,11 @@ namespace Ogre
                                                                                3, probeConstBuf,
                                                                                0, 0 );
             }
-            mLastBoundPool = newPool;
+            fs.mLastBoundPool = newPool;
         }
 
-        uint32 * RESTRICT_ALIAS currentMappedConstBuffer    = mCurrentMappedConstBuffer;
-        float * RESTRICT_ALIAS currentMappedTexBuffer       = mCurrentMappedTexBuffer;
+        uint32 * RESTRICT_ALIAS currentMappedConstBuffer    = fs.mCurrentMappedConstBuffer;
+        float * RESTRICT_ALIAS currentMappedTexBuffer       = fs.mCurrentMappedTexBuffer;
 
         bool hasSkeletonAnimation = queuedRenderable.renderable->hasSkeletonAnimation();
         uint32 numPoses = queuedRenderable.renderable->getNumPoses();
@@ -3115,26 +3136,26 @@ namespace Ogre
         {
             //We need to correct currentMappedConstBuffer to point to the right texture buffer's
             //offset, which may not be in sync if the previous draw had skeletal and/or pose animation.
-            const size_t currentConstOffset = (currentMappedTexBuffer - mStartMappedTexBuffer) >>
+            const size_t currentConstOffset = (currentMappedTexBuffer - fs.mStartMappedTexBuffer) >>
                                                 (2 + !casterPass);
-            currentMappedConstBuffer =  currentConstOffset + mStartMappedConstBuffer;
-            bool exceedsConstBuffer = (size_t)((currentMappedConstBuffer - mStartMappedConstBuffer) + 4)
-                                        > mCurrentConstBufferSize;
+            currentMappedConstBuffer =  currentConstOffset + fs.mStartMappedConstBuffer;
+            bool exceedsConstBuffer = (size_t)((currentMappedConstBuffer - fs.mStartMappedConstBuffer) + 4)
+                                        > fs.mCurrentConstBufferSize;
 
             const size_t minimumTexBufferSize = 16 * (1 + !casterPass);
-            bool exceedsTexBuffer = (currentMappedTexBuffer - mStartMappedTexBuffer) +
-                                         minimumTexBufferSize >= mCurrentTexBufferSize;
+            bool exceedsTexBuffer = (currentMappedTexBuffer - fs.mStartMappedTexBuffer) +
+                                         minimumTexBufferSize >= fs.mCurrentTexBufferSize;
 
             if( exceedsConstBuffer || exceedsTexBuffer )
             {
-                currentMappedConstBuffer = mapNextConstBuffer( commandBuffer );
+                currentMappedConstBuffer = mapNextConstBuffer( fs, commandBuffer );
 
                 if( exceedsTexBuffer )
-                    mapNextTexBuffer( commandBuffer, minimumTexBufferSize * sizeof(float) );
+                    mapNextTexBuffer( fs, commandBuffer, minimumTexBufferSize * sizeof(float) );
                 else
-                    rebindTexBuffer( commandBuffer, true, minimumTexBufferSize * sizeof(float) );
+                    rebindTexBuffer( fs, commandBuffer, true, minimumTexBufferSize * sizeof(float) );
 
-                currentMappedTexBuffer = mCurrentMappedTexBuffer;
+                currentMappedTexBuffer = fs.mCurrentMappedTexBuffer;
             }
 
             //uint worldMaterialIdx[]
@@ -3175,8 +3196,8 @@ namespace Ogre
         }
         else
         {
-            bool exceedsConstBuffer = (size_t)((currentMappedConstBuffer - mStartMappedConstBuffer) + 4)
-                                        > mCurrentConstBufferSize;
+            bool exceedsConstBuffer = (size_t)((currentMappedConstBuffer - fs.mStartMappedConstBuffer) + 4)
+                                        > fs.mCurrentConstBufferSize;
 
             if( hasSkeletonAnimation )
             {
@@ -3187,23 +3208,23 @@ namespace Ogre
 
                     const size_t poseDataSize = numPoses > 0u ? (4u + poseWeightsNumFloats) : 0u;
                     const size_t minimumTexBufferSize = 12 * numWorldTransforms + poseDataSize;
-                    bool exceedsTexBuffer = (currentMappedTexBuffer - mStartMappedTexBuffer) +
-                            minimumTexBufferSize >= mCurrentTexBufferSize;
+                    bool exceedsTexBuffer = (currentMappedTexBuffer - fs.mStartMappedTexBuffer) +
+                            minimumTexBufferSize >= fs.mCurrentTexBufferSize;
 
                     if( exceedsConstBuffer || exceedsTexBuffer )
                     {
-                        currentMappedConstBuffer = mapNextConstBuffer( commandBuffer );
+                        currentMappedConstBuffer = mapNextConstBuffer( fs, commandBuffer );
 
                         if( exceedsTexBuffer )
-                            mapNextTexBuffer( commandBuffer, minimumTexBufferSize * sizeof(float) );
+                            mapNextTexBuffer( fs, commandBuffer, minimumTexBufferSize * sizeof(float) );
                         else
-                            rebindTexBuffer( commandBuffer, true, minimumTexBufferSize * sizeof(float) );
+                            rebindTexBuffer( fs, commandBuffer, true, minimumTexBufferSize * sizeof(float) );
 
-                        currentMappedTexBuffer = mCurrentMappedTexBuffer;
+                        currentMappedTexBuffer = fs.mCurrentMappedTexBuffer;
                     }
 
                     //uint worldMaterialIdx[]
-                    size_t distToWorldMatStart = mCurrentMappedTexBuffer - mStartMappedTexBuffer;
+                    size_t distToWorldMatStart = fs.mCurrentMappedTexBuffer - fs.mStartMappedTexBuffer;
                     distToWorldMatStart >>= 2;
                     *currentMappedConstBuffer = (distToWorldMatStart << 9 ) |
                             (datablock->getAssignedSlot() & 0x1FF);
@@ -3243,37 +3264,76 @@ namespace Ogre
 
                     const size_t poseDataSize = numPoses > 0u ? (4u + poseWeightsNumFloats) : 0u;
                     const size_t minimumTexBufferSize = 12 * indexMap->size() + poseDataSize;
-                    bool exceedsTexBuffer = (currentMappedTexBuffer - mStartMappedTexBuffer) +
-                                                minimumTexBufferSize >= mCurrentTexBufferSize;
+                    bool exceedsTexBuffer = (currentMappedTexBuffer - fs.mStartMappedTexBuffer) +
+                                                minimumTexBufferSize >= fs.mCurrentTexBufferSize;
 
                     if( exceedsConstBuffer || exceedsTexBuffer )
                     {
-                        currentMappedConstBuffer = mapNextConstBuffer( commandBuffer );
+                        currentMappedConstBuffer = mapNextConstBuffer( fs, commandBuffer );
 
                         if( exceedsTexBuffer )
-                            mapNextTexBuffer( commandBuffer, minimumTexBufferSize * sizeof(float) );
+                            mapNextTexBuffer( fs, commandBuffer, minimumTexBufferSize * sizeof(float) );
                         else
-                            rebindTexBuffer( commandBuffer, true, minimumTexBufferSize * sizeof(float) );
+                            rebindTexBuffer( fs, commandBuffer, true, minimumTexBufferSize * sizeof(float) );
 
-                        currentMappedTexBuffer = mCurrentMappedTexBuffer;
+                        currentMappedTexBuffer = fs.mCurrentMappedTexBuffer;
                     }
 
-                    //uint worldMaterialIdx[]
-                    size_t distToWorldMatStart = mCurrentMappedTexBuffer - mStartMappedTexBuffer;
-                    distToWorldMatStart >>= 2;
-                    *currentMappedConstBuffer = (distToWorldMatStart << 9 ) |
-                            (datablock->getAssignedSlot() & 0x1FF);
+                    //The submeshes of an Item (and Items sharing a SkeletonInstance) are often drawn
+                    //one after another with the same bones. Point to the palette we uploaded for
+                    //the previous one if it's still in the bound range. Pose data goes right after
+                    //the palette, so that can't be shared.
+                    const bool reusePalette = numPoses == 0u && fs.mLastPalette &&
+                                              fs.mLastPaletteBindStart == fs.mStartMappedTexBuffer &&
+                                              fs.mLastPaletteSkeleton == skeleton &&
+                                              ( fs.mLastPaletteIndexMap == indexMap ||
+                                                ( fs.mLastPaletteIndexMap->size() == indexMap->size() &&
+                                                  !memcmp( fs.mLastPaletteIndexMap->begin(),
+                                                           indexMap->begin(),
+                                                           indexMap->size() *
+                                                           sizeof(RenderableAnimated::IndexMap::value_type) ) ) );
+
+                    if( reusePalette )
+                    {
+                        //uint worldMaterialIdx[]
+                        size_t distToWorldMatStart = fs.mLastPalette - fs.mStartMappedTexBuffer;
+                        distToWorldMatStart >>= 2;
+                        *currentMappedConstBuffer = (distToWorldMatStart << 9 ) |
+                                (datablock->getAssignedSlot() & 0x1FF);
+
+                        //Non-skeletal renderables derive their const buffer offset from the
+                        //tex buffer's, thus we still have to advance it by one drawId's worth.
+                        const size_t drawIdSize = 16u + 16u * !casterPass;
+                        const size_t nextDrawId = ( (currentMappedConstBuffer -
+                                                     fs.mStartMappedConstBuffer) >> 2u ) + 1u;
+                        currentMappedTexBuffer = std::max<float*>( currentMappedTexBuffer,
+                                                           fs.mStartMappedTexBuffer +
+                                                           nextDrawId * drawIdSize );
+                    }
+                    else
+                    {
+                        //uint worldMaterialIdx[]
+                        size_t distToWorldMatStart = fs.mCurrentMappedTexBuffer - fs.mStartMappedTexBuffer;
+                        distToWorldMatStart >>= 2;
+                        *currentMappedConstBuffer = (distToWorldMatStart << 9 ) |
+                                (datablock->getAssignedSlot() & 0x1FF);
 
-                    RenderableAnimated::IndexMap::const_iterator itBone = indexMap->begin();
-                    RenderableAnimated::IndexMap::const_iterator enBone = indexMap->end();
+                        fs.mLastPalette             = currentMappedTexBuffer;
+                        fs.mLastPaletteBindStart    = fs.mStartMappedTexBuffer;
+                        fs.mLastPaletteSkeleton     = skeleton;
+                        fs.mLastPaletteIndexMap     = indexMap;
 
-                    while( itBone != enBone )
-                    {
-                        const SimpleMatrixAf4x3 &mat4x3 = skeleton->_getBoneFullTransform( *itBone );
-                        mat4x3.streamTo4x3( currentMappedTexBuffer );
-                        currentMappedTexBuffer += 12;
+                        RenderableAnimated::IndexMap::const_iterator itBone = indexMap->begin();
+                        RenderableAnimated::IndexMap::const_iterator enBone = indexMap->end();
 
-                        ++itBone;
+                        while( itBone != enBone )
+                        {
+                            const SimpleMatrixAf4x3 &mat4x3 = skeleton->_getBoneFullTransform( *itBone );
+                            mat4x3.streamTo4x3( currentMappedTexBuffer );
+                            currentMappedTexBuffer += 12;
+
+                            ++itBone;
+                        }
                     }
                 }
             }
@@ -3286,23 +3346,23 @@ namespace Ogre
                     // for pose data (base vertex, num vertices), enough vec4's to accomodate
                     // the weight of each pose, 3 vec4's for worldMat, and 4 vec4's for worldView.
                     const size_t minimumTexBufferSize = 4 + poseWeightsNumFloats + 3*4 + 4*4;
-                    bool exceedsTexBuffer = (currentMappedTexBuffer - mStartMappedTexBuffer) +
-                                                minimumTexBufferSize >= mCurrentTexBufferSize;
+                    bool exceedsTexBuffer = (currentMappedTexBuffer - fs.mStartMappedTexBuffer) +
+                                                minimumTexBufferSize >= fs.mCurrentTexBufferSize;
 
                     if( exceedsConstBuffer || exceedsTexBuffer )
                     {
-                        currentMappedConstBuffer = mapNextConstBuffer( commandBuffer );
+                        currentMappedConstBuffer = mapNextConstBuffer( fs, commandBuffer );
 
                         if( exceedsTexBuffer )
-                            mapNextTexBuffer( commandBuffer, minimumTexBufferSize * sizeof(float) );
+                            mapNextTexBuffer( fs, commandBuffer, minimumTexBufferSize * sizeof(float) );
                         else
-                            rebindTexBuffer( commandBuffer, true, minimumTexBufferSize * sizeof(float) );
+                            rebindTexBuffer( fs, commandBuffer, true, minimumTexBufferSize * sizeof(float) );
 
-                        currentMappedTexBuffer = mCurrentMappedTexBuffer;
+                        currentMappedTexBuffer = fs.mCurrentMappedTexBuffer;
                     }
 
                     //uint worldMaterialIdx[]
-                    size_t distToWorldMatStart = mCurrentMappedTexBuffer - mStartMappedTexBuffer;
+                    size_t distToWorldMatStart = fs.mCurrentMappedTexBuffer - fs.mStartMappedTexBuffer;
                     distToWorldMatStart >>= 2;
                     *currentMappedConstBuffer = (distToWorldMatStart << 9 ) |
                             (datablock->getAssignedSlot() & 0x1FF);
@@ -3377,10 +3437,10 @@ namespace Ogre
             //currentMappedTexBuffer to be 16/32-byte aligned.
             //Non-skeletally animated objects are far more common than skeletal ones,
             //so we do this here instead of doing it before rendering the non-skeletal ones.
-            size_t currentConstOffset = (size_t)(currentMappedTexBuffer - mStartMappedTexBuffer);
+            size_t currentConstOffset = (size_t)(currentMappedTexBuffer - fs.mStartMappedTexBuffer);
             currentConstOffset = alignToNextMultiple( currentConstOffset, 16 + 16 * !casterPass );
-            currentConstOffset = std::min( currentConstOffset, mCurrentTexBufferSize );
-            currentMappedTexBuffer = mStartMappedTexBuffer + currentConstOffset;
+            currentConstOffset = std::min( currentConstOffset, fs.mCurrentTexBufferSize );
+            currentMappedTexBuffer = fs.mStartMappedTexBuffer + currentConstOffset;
         }
 
         *reinterpret_cast<float * RESTRICT_ALIAS>( currentMappedConstBuffer + 1 ) =
@@ -3402,17 +3462,17 @@ namespace Ogre
 #ifdef OGRE_BUILD_COMPONENT_PLANAR_REFLECTIONS
             if( !casterPass && mHasPlanarReflections &&
                 (queuedRenderable.renderable->mCustomParameter & 0x80 /* UseActiveActor */) &&
-                mLastBoundPlanarReflection != queuedRenderable.renderable->mCustomParameter )
+                mLastBoundPlanarReflection[threadIdx] != queuedRenderable.renderable->mCustomParameter )
             {
                 const uint8 activeActorIdx = queuedRenderable.renderable->mCustomParameter & 0x7F;
                 TextureGpu *planarReflTex = mPlanarReflections->getTexture( activeActorIdx );
                 *commandBuffer->addCommand<CbTexture>() =
                         CbTexture( mTexUnitSlotStart - 1u, planarReflTex,
                                    mPlanarReflectionsSamplerblock );
-                mLastBoundPlanarReflection = queuedRenderable.renderable->mCustomParameter;
+                mLastBoundPlanarReflection[threadIdx] = queuedRenderable.renderable->mCustomParameter;
             }
 #endif
-            if( datablock->mTexturesDescSet != mLastDescTexture )
+            if( datablock->mTexturesDescSet != fs.mLastDescTexture )
             {
                 if( datablock->mTexturesDescSet )
                 {
@@ -3431,10 +3491,10 @@ namespace Ogre
                     //texUnit += datablock->mTexturesDescSet->mTextures.size();
                 }
 
-                mLastDescTexture = datablock->mTexturesDescSet;
+                fs.mLastDescTexture = datablock->mTexturesDescSet;
             }
 
-            if( datablock->mSamplersDescSet != mLastDescSampler && mHasSeparateSamplers )
+            if( datablock->mSamplersDescSet != fs.mLastDescSampler && mHasSeparateSamplers )
             {
                 if( datablock->mSamplersDescSet )
                 {
@@ -3442,15 +3502,15 @@ namespace Ogre
                     size_t texUnit = mTexUnitSlotStart;
                     *commandBuffer->addCommand<CbSamplers>() =
                             CbSamplers( texUnit, datablock->mSamplersDescSet );
-                    mLastDescSampler = datablock->mSamplersDescSet;
+                    fs.mLastDescSampler = datablock->mSamplersDescSet;
                 }
             }
         }
 
-        mCurrentMappedConstBuffer   = currentMappedConstBuffer;
-        mCurrentMappedTexBuffer     = currentMappedTexBuffer;
+        fs.mCurrentMappedConstBuffer   = currentMappedConstBuffer;
+        fs.mCurrentMappedTexBuffer     = currentMappedTexBuffer;
 
-        return ((mCurrentMappedConstBuffer - mStartMappedConstBuffer) >> 2) - 1;
+        return ((fs.mCurrentMappedConstBuffer - fs.mStartMappedConstBuffer) >> 2) - 1;
     }
     //-----------------------------------------------------------------------------------
     void HlmsPbs::destroyAllBuffers(void)
@@ -73,11 +73,7 @@ namespace Ogre
         ConstBufferPackedVec    mPassBuffers;
         uint32                  mCurrentPassBuffer;     /// Resets to zero every new frame.
 
-        ConstBufferPool::BufferPool const *mLastBoundPool;
-
         bool mHasSeparateSamplers;
-        DescriptorSetTexture const *mLastDescTexture;
-        DescriptorSetSampler const *mLastDescSampler;
 
         float mConstantBiasScale;
         bool mUsingInstancedStereo;
@@ -112,7 +108,8 @@ namespace Ogre
         FORCEINLINE uint32 fillBuffersFor( const HlmsCache *cache,
                                            const QueuedRenderable &queuedRenderable,
                                            bool casterPass, uint32 lastCacheHash,
-                                           CommandBuffer *commandBuffer, bool isV1 );
+                                           CommandBuffer *commandBuffer, bool isV1,
+                                           size_t threadIdx );
 
     public:
         HlmsUnlit( Archive *dataFolder, ArchiveVec *libraryFolders );
@@ -143,6 +140,12 @@ namespace Ogre
                                          bool casterPass, uint32 lastCacheHash,
                                          CommandBuffer *commandBuffer );
 
+        virtual bool supportsParallelFillBuffers(void) const        { return true; }
+        virtual uint32 fillBuffersForV2Mt( size_t threadIdx, const HlmsCache *cache,
+                                           const QueuedRenderable &queuedRenderable,
+                                           bool casterPass, uint32 lastCacheHash,
+                                           CommandBuffer *commandBuffer );
+
         virtual void frameEnded(void);
 
         void setShadowSettings( bool useExponentialShadowMaps );
@@ -77,10 +77,7 @@ namespace Ogre
         ConstBufferPool( HlmsUnlitDatablock::MaterialSizeInGpuAligned,
                          ExtraBufferParams( 64 * NUM_UNLIT_TEXTURE_TYPES ) ),
         mCurrentPassBuffer( 0 ),
-        mLastBoundPool( 0 ),
         mHasSeparateSamplers( 0 ),
-        mLastDescTexture( 0 ),
-        mLastDescSampler( 0 ),
         mConstantBiasScale( 0.1f ),
         mUsingInstancedStereo( false ),
         mUsingExponentialShadowMaps( false ),
@@ -103,9 +100,6 @@ namespace Ogre
         ConstBufferPool( HlmsUnlitDatablock::MaterialSizeInGpuAligned,
                          ExtraBufferParams( 64 * NUM_UNLIT_TEXTURE_TYPES ) ),
         mCurrentPassBuffer( 0 ),
-        mLastBoundPool( 0 ),
-        mLastDescTexture( 0 ),
-        mLastDescSampler( 0 ),
         mConstantBiasScale( 0.1f ),
         mUsingInstancedStereo( false ),
         mUsingExponentialShadowMaps( false ),
@@ -887,7 +881,7 @@ namespace Ogre
                                         CommandBuffer *commandBuffer )
     {
         return fillBuffersFor( cache, queuedRenderable, casterPass,
-                               lastCacheHash, commandBuffer, true );
+                               lastCacheHash, commandBuffer, true, 0u );
     }
     //-----------------------------------------------------------------------------------
     uint32 HlmsUnlit::fillBuffersForV2( const HlmsCache *cache,
@@ -896,13 +890,24 @@ namespace Ogre
                                         CommandBuffer *commandBuffer )
     {
         return fillBuffersFor( cache, queuedRenderable, casterPass,
-                               lastCacheHash, commandBuffer, false );
+                               lastCacheHash, commandBuffer, false, 0u );
+    }
+    //-----------------------------------------------------------------------------------
+    uint32 HlmsUnlit::fillBuffersForV2Mt( size_t threadIdx, const HlmsCache *cache,
+                                          const QueuedRenderable &queuedRenderable,
+                                          bool casterPass, uint32 lastCacheHash,
+                                          CommandBuffer *commandBuffer )
+    {
+        return fillBuffersFor( cache, queuedRenderable, casterPass,
+                               lastCacheHash, commandBuffer, false, threadIdx );
     }
     //-----------------------------------------------------------------------------------
     uint32 HlmsUnlit::fillBuffersFor( const HlmsCache *cache, const QueuedRenderable &queuedRenderable,
                                       bool casterPass, uint32 lastCacheHash,
-                                      CommandBuffer *commandBuffer, bool isV1 )
+                                      CommandBuffer *commandBuffer, bool isV1, size_t threadIdx )
     {
+        HlmsBufferFillState &fs = getFillState( threadIdx );
+
         assert( dynamic_cast<const HlmsUnlitDatablock*>( queuedRenderable.renderable->getDatablock() ) );
         const HlmsUnlitDatablock *datablock = static_cast<const HlmsUnlitDatablock*>(
                                                 queuedRenderable.renderable->getDatablock() );
@@ -910,9 +915,9 @@ namespace Ogre
         if( OGRE_EXTRACT_HLMS_TYPE_FROM_CACHE_HASH( lastCacheHash ) != mType )
         {
             //We changed HlmsType, rebind the shared textures.
-            mLastDescTexture = 0;
-            mLastDescSampler = 0;
-            mLastBoundPool = 0;
+            fs.mLastDescTexture = 0;
+            fs.mLastDescSampler = 0;
+            fs.mLastBoundPool = 0;
 
             //layout(binding = 0) uniform PassBuffer {} pass
             ConstBufferPacked *passBuffer = mPassBuffers[mCurrentPassBuffer-1];
@@ -926,24 +931,24 @@ namespace Ogre
                                                                            getTotalSizeBytes() );
 
             //layout(binding = 2) uniform InstanceBuffer {} instance
-            if( mCurrentConstBuffer < mConstBuffers.size() &&
-                (size_t)((mCurrentMappedConstBuffer - mStartMappedConstBuffer) + 4) <=
-                    mCurrentConstBufferSize )
+            if( fs.mCurrentConstBuffer < fs.mConstBuffers.size() &&
+                (size_t)((fs.mCurrentMappedConstBuffer - fs.mStartMappedConstBuffer) + 4) <=
+                    fs.mCurrentConstBufferSize )
             {
                 *commandBuffer->addCommand<CbShaderBuffer>() =
-                        CbShaderBuffer( VertexShader, 2, mConstBuffers[mCurrentConstBuffer], 0, 0 );
+                        CbShaderBuffer( VertexShader, 2, fs.mConstBuffers[fs.mCurrentConstBuffer], 0, 0 );
                 *commandBuffer->addCommand<CbShaderBuffer>() =
-                        CbShaderBuffer( PixelShader, 2, mConstBuffers[mCurrentConstBuffer], 0, 0 );
+                        CbShaderBuffer( PixelShader, 2, fs.mConstBuffers[fs.mCurrentConstBuffer], 0, 0 );
             }
 
-            rebindTexBuffer( commandBuffer );
+            rebindTexBuffer( fs, commandBuffer );
 
             mListener->hlmsTypeChanged( casterPass, commandBuffer, datablock, 0u );
         }
 
         //Don't bind the material buffer on caster passes (important to keep
         //MDI & auto-instancing running on shadow map passes)
-        if( mLastBoundPool != datablock->getAssignedPool() && !casterPass )
+        if( fs.mLastBoundPool != datablock->getAssignedPool() && !casterPass )
         {
             //layout(binding = 1) uniform MaterialBuf {} materialArray
             const ConstBufferPool::BufferPool *newPool = datablock->getAssignedPool();
@@ -964,31 +969,31 @@ namespace Ogre
                                                                                getTotalSizeBytes() );
             }
 
-            mLastBoundPool = newPool;
+            fs.mLastBoundPool = newPool;
         }
 
-        uint32 * RESTRICT_ALIAS currentMappedConstBuffer    = mCurrentMappedConstBuffer;
-        float * RESTRICT_ALIAS currentMappedTexBuffer       = mCurrentMappedTexBuffer;
+        uint32 * RESTRICT_ALIAS currentMappedConstBuffer    = fs.mCurrentMappedConstBuffer;
+        float * RESTRICT_ALIAS currentMappedTexBuffer       = fs.mCurrentMappedTexBuffer;
 
         const Matrix4 &worldMat = queuedRenderable.movableObject->_getParentNodeFullTransform();
 
-        bool exceedsConstBuffer = (size_t)((currentMappedConstBuffer - mStartMappedConstBuffer) + 4) >
-                                                                                mCurrentConstBufferSize;
+        bool exceedsConstBuffer = (size_t)((currentMappedConstBuffer - fs.mStartMappedConstBuffer) + 4) >
+                                                                                fs.mCurrentConstBufferSize;
 
         const size_t minimumTexBufferSize = 16;
-        bool exceedsTexBuffer = (currentMappedTexBuffer - mStartMappedTexBuffer) +
-                                     minimumTexBufferSize >= mCurrentTexBufferSize;
+        bool exceedsTexBuffer = (currentMappedTexBuffer - fs.mStartMappedTexBuffer) +
+                                     minimumTexBufferSize >= fs.mCurrentTexBufferSize;
 
         if( exceedsConstBuffer || exceedsTexBuffer )
         {
-            currentMappedConstBuffer = mapNextConstBuffer( commandBuffer );
+            currentMappedConstBuffer = mapNextConstBuffer( fs, commandBuffer );
 
             if( exceedsTexBuffer )
-                mapNextTexBuffer( commandBuffer, minimumTexBufferSize * sizeof(float) );
+                mapNextTexBuffer( fs, commandBuffer, minimumTexBufferSize * sizeof(float) );
             else
-                rebindTexBuffer( commandBuffer, true, minimumTexBufferSize * sizeof(float) );
+                rebindTexBuffer( fs, commandBuffer, true, minimumTexBufferSize * sizeof(float) );
 
-            currentMappedTexBuffer = mCurrentMappedTexBuffer;
+            currentMappedTexBuffer = fs.mCurrentMappedTexBuffer;
         }
 
         //---------------------------------------------------------------------------
@@ -1025,7 +1030,7 @@ namespace Ogre
 
         if( !casterPass )
         {
-            if( datablock->mTexturesDescSet != mLastDescTexture )
+            if( datablock->mTexturesDescSet != fs.mLastDescTexture )
             {
                 //Bind textures
                 size_t texUnit = mTexUnitSlotStart;
@@ -1045,10 +1050,10 @@ namespace Ogre
                     texUnit += datablock->mTexturesDescSet->mTextures.size();
                 }
 
-                mLastDescTexture = datablock->mTexturesDescSet;
+                fs.mLastDescTexture = datablock->mTexturesDescSet;
             }
 
-            if( datablock->mSamplersDescSet != mLastDescSampler && mHasSeparateSamplers )
+            if( datablock->mSamplersDescSet != fs.mLastDescSampler && mHasSeparateSamplers )
             {
                 if( datablock->mSamplersDescSet )
                 {
@@ -1056,15 +1061,15 @@ namespace Ogre
                     size_t texUnit = mSamplerUnitSlotStart;
                     *commandBuffer->addCommand<CbSamplers>() =
                             CbSamplers( texUnit, datablock->mSamplersDescSet );
-                    mLastDescSampler = datablock->mSamplersDescSet;
+                    fs.mLastDescSampler = datablock->mSamplersDescSet;
                 }
             }
         }
 
-        mCurrentMappedConstBuffer   = currentMappedConstBuffer;
-        mCurrentMappedTexBuffer     = currentMappedTexBuffer;
+        fs.mCurrentMappedConstBuffer   = currentMappedConstBuffer;
+        fs.mCurrentMappedTexBuffer     = currentMappedTexBuffer;
 
-        return ((mCurrentMappedConstBuffer - mStartMappedConstBuffer) >> 2) - 1;
+        return ((fs.mCurrentMappedConstBuffer - fs.mStartMappedConstBuffer) >> 2) - 1;
     }
     //-----------------------------------------------------------------------------------
     void HlmsUnlit::destroyAllBuffers(void)
@@ -39,10 +39,25 @@ namespace Ogre
     class _OgreLodExport LodCollapseCost
     {
     public:
+        LodCollapseCost() : mPrecomputedCosts(0) {}
         virtual ~LodCollapseCost() {}
-        /// This is called after the LodInputProvider has initialized LodData.
+        /** This is called after the LodInputProvider has initialized LodData.
+        @remarks
+            The costs of large meshes are computed in parallel using LodData::mNumWorkerThreads
+            threads, thus computeVertexCollapseCost & computeEdgeCollapseCost must be safe to
+            call concurrently for different vertices. Then initVertexCollapseCost is called
+            for every used vertex from the calling thread, and the heap is built in one pass.
+        */
         virtual void initCollapseCosts(LodData* data);
-        /// Called from initCollapseCosts for every edge.
+        /// Computes the costs of the vertices in range [begin; end) and stores them in outCosts[i].
+        /// Does not touch the heap. Called from initCollapseCosts, possibly from a worker thread.
+        void _computeVertexCollapseCosts(LodData* data, size_t begin, size_t end, Real* outCosts);
+        /** Computes the cost of a single vertex and pushes it to the heap.
+        @remarks
+            When called from initCollapseCosts, the cost was already computed (and collapseTo
+            set) by _computeVertexCollapseCosts, and the heap is being bulk loaded: overrides
+            must push using LodData::CollapseCostHeap::_pushUnordered, or call this version.
+        */
         virtual void initVertexCollapseCost(LodData* data, LodData::Vertex* vertex);
         /// Called when edge cost gets invalid.
         virtual void updateVertexCollapseCost(LodData* data, LodData::Vertex* vertex);
@@ -51,6 +66,10 @@ namespace Ogre
         /// Returns the collapse cost of the given edge.
         virtual Real computeEdgeCollapseCost(LodData* data, LodData::Vertex* src, LodData::Edge* dstEdge) = 0;
     protected:
+        /// Costs computed by _computeVertexCollapseCosts, indexed like LodData::mVertexList.
+        /// Only valid while initCollapseCosts is running.
+        const Real* mPrecomputedCosts;
+
         // Helper functions:
         bool isBorderVertex(const LodData::Vertex* vertex) const;
     };
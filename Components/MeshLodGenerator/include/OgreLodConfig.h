@@ -162,6 +162,11 @@ namespace Ogre
             Ogre::Real outsideWalkAngle;
             /// If the algorithm makes errors, you can fix it, by adding the edge to the profile.
             LodProfile profile;
+            /// Number of threads used to compute the initial collapse costs of the mesh.
+            /// Only meshes with several thousands of vertices are split. 0 means one per logical core.
+            /// Ignored by MeshLodGenerator::generateLodLevelsBatch, which decides on its own.
+            /// (0 by default)
+            size_t numWorkerThreads;
             Advanced();
         } advanced;
     };
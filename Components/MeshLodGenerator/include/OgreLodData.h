@@ -59,8 +59,8 @@ namespace Ogre
         struct Triangle;
         struct VertexHash;
         struct VertexEqual;
+        class CollapseCostHeap;
 
-        typedef multimap<Real, Vertex*>::type CollapseCostHeap;
         typedef VectorSet<Edge, 8> VEdges;
         typedef VectorSet<Triangle*, 7> VTriangles;
 
@@ -109,7 +109,7 @@ namespace Ogre
 
             Vertex* collapseTo;
             bool seam;
-            CollapseCostHeap::iterator costHeapPosition; /// Iterator pointing to the position in the mCollapseCostSet, which allows fast remove.
+            size_t costHeapPosition; /// Index of the vertex inside mCollapseCostHeap, which allows fast update & remove. CollapseCostHeap::NOT_IN_HEAP if not there.
 
             void addEdge(const Edge& edge);
             void removeEdge(const Edge& edge);
@@ -129,6 +129,76 @@ namespace Ogre
             bool isMalformed();
         };
 
+        /** Priority queue of vertices sorted by their collapse cost (smallest on top).
+        @remarks
+            Indexed 4-ary min-heap stored in a single contiguous array. The cost is stored next
+            to the vertex pointer so sifting never has to touch the vertices themselves, and
+            every vertex knows its own slot (Vertex::costHeapPosition), thus updating or removing
+            an arbitrary vertex is O(log n) without any searching nor node allocations.
+        @par
+            Vertices with equal cost are returned in no particular order.
+        */
+        class _OgreLodExport CollapseCostHeap
+        {
+        public:
+            static const size_t NOT_IN_HEAP = ~static_cast<size_t>( 0 );
+
+            struct Entry
+            {
+                Real    cost;
+                Vertex  *vertex;
+            };
+
+        protected:
+            typedef vector<Entry>::type EntryVec;
+            EntryVec mEntries;
+
+            inline void placeEntry( size_t idx, const Entry &entry )
+            {
+                mEntries[idx] = entry;
+                entry.vertex->costHeapPosition = idx;
+            }
+            void siftUp( size_t idx );
+            void siftDown( size_t idx );
+
+        public:
+            size_t size(void) const                     { return mEntries.size(); }
+            bool empty(void) const                      { return mEntries.empty(); }
+            void clear(void)                            { mEntries.clear(); }
+            void reserve( size_t numVertices )          { mEntries.reserve( numVertices ); }
+
+            /// Returns the vertex with the smallest cost. Heap must not be empty.
+            Vertex* top(void) const                     { return mEntries.front().vertex; }
+            /// Returns the smallest cost. Heap must not be empty.
+            Real topCost(void) const                    { return mEntries.front().cost; }
+            /// Returns the vertex at the given slot (not sorted). For iterating the heap.
+            Vertex* at( size_t idx ) const              { return mEntries[idx].vertex; }
+
+            bool contains( const Vertex *vertex ) const
+            {
+                return vertex->costHeapPosition < mEntries.size() &&
+                       mEntries[vertex->costHeapPosition].vertex == vertex;
+            }
+            /// Returns the cost of a vertex. The vertex must be in the heap.
+            Real getCost( const Vertex *vertex ) const
+            {
+                return mEntries[vertex->costHeapPosition].cost;
+            }
+
+            void push( Vertex *vertex, Real cost );
+            /// Changes the cost of a vertex that is already in the heap.
+            void update( Vertex *vertex, Real cost );
+            /// Removes the vertex from the heap. Its costHeapPosition becomes NOT_IN_HEAP.
+            void remove( Vertex *vertex );
+
+            /** Adds a vertex without restoring the heap order. Used to bulk load the heap
+                in O(n) instead of O(n log n). _buildHeap must be called afterwards and
+                before any other operation.
+            */
+            void _pushUnordered( Vertex *vertex, Real cost );
+            void _buildHeap(void);
+        };
+
         union IndexBufferPointer
         {
             unsigned short* pshort;
@@ -169,6 +239,8 @@ namespace Ogre
 #endif
         Real mMeshBoundingSphereRadius;
         bool mUseVertexNormals;
+        /// Number of threads used to compute the initial collapse costs. 0 = one per logical core.
+        size_t mNumWorkerThreads;
 
         template<typename T, typename A>
         static size_t getVectorIDFromPointer(const std::vector<T, A>& vec, const T* pointer)
@@ -182,7 +254,8 @@ namespace Ogre
             mUniqueVertexSet((UniqueVertexSet::size_type) 0,
                              (const UniqueVertexSet::hasher&) VertexHash(this)),
             mMeshBoundingSphereRadius(0.0f),
-            mUseVertexNormals(true)
+            mUseVertexNormals(true),
+            mNumWorkerThreads(1)
         {}
     };
 
@@ -37,6 +37,7 @@
 #include "OgreLodCollapser.h"
 #include "OgreSharedPtr.h"
 #include "OgreSingleton.h"
+#include "ogrestd/vector.h"
 
 namespace Ogre
 {
@@ -45,6 +46,7 @@ namespace Ogre
         public Singleton<MeshLodGenerator>
     {
     public:
+        typedef vector<LodConfig>::type LodConfigList;
 
         static MeshLodGenerator* getSingletonPtr();
         static MeshLodGenerator& getSingleton();
@@ -62,6 +64,23 @@ namespace Ogre
          */
         virtual void generateLodLevels(LodConfig& lodConfig, LodCollapseCostPtr cost = LodCollapseCostPtr(), LodDataPtr data = LodDataPtr(), LodInputProviderPtr input = LodInputProviderPtr(), LodOutputProviderPtr output = LodOutputProviderPtr(), LodCollapserPtr collapser = LodCollapserPtr());
 
+        /**
+         * @brief Generates the Lod levels of several meshes at once, using all cores.
+         *
+         * Meshes are distributed among the threads (largest first), and the collapse costs
+         * of each mesh are split between the threads left over when there are fewer meshes
+         * than threads. The in-memory buffer providers are always used; the results are
+         * injected into the meshes from the calling thread before returning.
+         * lodConfig.advanced.useBackgroundQueue and numWorkerThreads are ignored.
+         *
+         * For v2 meshes, generate the Lod levels on their v1 version and then use
+         * Mesh::importV1 as usual.
+         *
+         * @param lodConfigs Specification of the requested Lod levels. Each entry must refer to a different mesh.
+         * @param numThreads Number of threads to use. 0 means one per logical core.
+         */
+        void generateLodLevelsBatch(LodConfigList& lodConfigs, size_t numThreads = 0);
+
         /**
          * @brief Generates the Lod levels for a mesh without configuring it.
          *
@@ -80,6 +99,9 @@ namespace Ogre
         static void _configureMeshLodUsage(const LodConfig& lodConfig);
         void _resolveComponents(LodConfig& lodConfig, LodCollapseCostPtr& cost, LodDataPtr& data, LodInputProviderPtr& input, LodOutputProviderPtr& output, LodCollapserPtr& collapser);
         void _process(LodConfig& lodConfig, LodCollapseCost* cost, LodData* data, LodInputProvider* input, LodOutputProvider* output, LodCollapser* collapser);
+        /// Same as _process, but stops before injecting the Lod levels into the mesh.
+        /// Does not touch the mesh nor any hardware buffer when used with the buffer providers, thus it can be called from any thread.
+        void _processData(LodConfig& lodConfig, LodCollapseCost* cost, LodData* data, LodInputProvider* input, LodOutputProvider* output, LodCollapser* collapser);
 
         /// If you only use manual Lod levels, then you don't need to build LodData mesh representation.
         /// This function will generate manual Lod levels without overhead, but every Lod level needs to be a manual Lod level.
@@ -87,6 +109,8 @@ namespace Ogre
 
         void _initWorkQueue();
     protected:
+        void resolveComponents(LodConfig& lodConfig, LodCollapseCostPtr& cost, LodDataPtr& data, LodInputProviderPtr& input, LodOutputProviderPtr& output, LodCollapserPtr& collapser, bool useBuffers);
+        static bool hasGeneratedLodLevels(const LodConfig& lodConfig);
         void computeLods(LodConfig& lodConfig, LodData* data, LodCollapseCost* cost, LodOutputProvider* output, LodCollapser* collapser);
         void calcLodVertexCount(const LodLevel& lodLevel, size_t uniqueVertexCount, size_t& outVertexCountLimit, Real& outCollapseCostLimit);
 
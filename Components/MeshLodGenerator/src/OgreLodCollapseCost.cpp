@@ -29,21 +29,93 @@
 #include "OgreLodCollapseCost.h"
 
 #include "OgreLogManager.h"
+#include "OgrePlatformInformation.h"
+#include "Threading/OgreThreads.h"
 
 #include <sstream>
 
 namespace Ogre
 {
+    /// Below this amount of vertices per thread it's not worth spawning threads.
+    static const size_t c_minVerticesPerThread = 4096u;
+
+    struct LodCollapseCostThreadJob
+    {
+        LodCollapseCost *collapseCost;
+        LodData         *data;
+        Real            *outCosts;
+        size_t          begin;
+        size_t          end;
+    };
+
+    unsigned long initCollapseCostsThread( ThreadHandle *threadHandle );
+    THREAD_DECLARE( initCollapseCostsThread );
+    unsigned long initCollapseCostsThread( ThreadHandle *threadHandle )
+    {
+        LodCollapseCostThreadJob *job =
+                reinterpret_cast<LodCollapseCostThreadJob*>( threadHandle->getUserParam() );
+        job->collapseCost->_computeVertexCollapseCosts( job->data, job->begin, job->end,
+                                                        job->outCosts );
+        return 0;
+    }
+
     void LodCollapseCost::initCollapseCosts( LodData* data )
     {
         data->mCollapseCostHeap.clear();
-        LodData::VertexList::iterator it = data->mVertexList.begin();
-        LodData::VertexList::iterator itEnd = data->mVertexList.end();
-        for (; it != itEnd; it++)
+
+        const size_t numVertices = data->mVertexList.size();
+        if( !numVertices )
+            return;
+
+        vector<Real>::type collapseCosts( numVertices, LodData::UNINITIALIZED_COLLAPSE_COST );
+
+        size_t numThreads = data->mNumWorkerThreads;
+        if( !numThreads )
+            numThreads = PlatformInformation::getNumLogicalCores();
+        numThreads = std::min( numThreads, std::max<size_t>( numVertices / c_minVerticesPerThread, 1u ) );
+
+        if( numThreads > 1u )
         {
-            if (!it->edges.empty())
+            const size_t verticesPerThread = (numVertices + numThreads - 1u) / numThreads;
+
+            vector<LodCollapseCostThreadJob>::type jobs( numThreads );
+            for( size_t i=0; i<numThreads; ++i )
+            {
+                jobs[i].collapseCost = this;
+                jobs[i].data         = data;
+                jobs[i].outCosts     = &collapseCosts[0];
+                jobs[i].begin        = std::min( i * verticesPerThread, numVertices );
+                jobs[i].end          = std::min( (i + 1u) * verticesPerThread, numVertices );
+            }
+
+            ThreadHandleVec threadHandles;
+            threadHandles.reserve( numThreads - 1u );
+            for( size_t i=1; i<numThreads; ++i )
             {
-                initVertexCollapseCost(data, &*it);
+                threadHandles.push_back( Threads::CreateThread( THREAD_GET( initCollapseCostsThread ),
+                                                                i, &jobs[i] ) );
+            }
+
+            //The calling thread takes the first range.
+            _computeVertexCollapseCosts( data, jobs[0].begin, jobs[0].end, &collapseCosts[0] );
+
+            Threads::WaitForThreads( threadHandles );
+        }
+        else
+        {
+            _computeVertexCollapseCosts( data, 0, numVertices, &collapseCosts[0] );
+        }
+
+        //Subclasses may override initVertexCollapseCost, so it must still be called for
+        //every vertex. The default implementation just pushes the precomputed cost.
+        mPrecomputedCosts = &collapseCosts[0];
+        data->mCollapseCostHeap.reserve( numVertices );
+        for( size_t i=0; i<numVertices; ++i )
+        {
+            LodData::Vertex *vertex = &data->mVertexList[i];
+            if (!vertex->edges.empty())
+            {
+                initVertexCollapseCost( data, vertex );
             }
             else
             {
@@ -51,12 +123,31 @@ namespace Ogre
                 LogManager::getSingleton().stream()
                     << "In " << data->mMeshName
                     << " never used vertex found with ID: " << data->mCollapseCostHeap.size() << ". "
-                    << "Vertex position: (" << it->position.x << ", " << it->position.y << ", "
-                    << it->position.z << ") "
+                    << "Vertex position: (" << vertex->position.x << ", " << vertex->position.y << ", "
+                    << vertex->position.z << ") "
                     << "It will be excluded from Lod level calculations.";
 #endif
             }
         }
+        mPrecomputedCosts = 0;
+        data->mCollapseCostHeap._buildHeap();
+    }
+
+    void LodCollapseCost::_computeVertexCollapseCosts( LodData* data, size_t begin, size_t end, Real* outCosts )
+    {
+        for( size_t i=begin; i<end; ++i )
+        {
+            LodData::Vertex *vertex = &data->mVertexList[i];
+            if (!vertex->edges.empty())
+            {
+                Real collapseCost = LodData::UNINITIALIZED_COLLAPSE_COST;
+                LodData::Vertex* collapseTo = NULL;
+                computeVertexCollapseCost(data, vertex, collapseCost, collapseTo);
+
+                vertex->collapseTo = collapseTo;
+                outCosts[i] = collapseCost;
+            }
+        }
     }
 
     void LodCollapseCost::computeVertexCollapseCost( LodData* data, LodData::Vertex* vertex, Real& collapseCost, LodData::Vertex*& collapseTo )
@@ -76,12 +167,19 @@ namespace Ogre
     {
         OgreAssert(!vertex->edges.empty(), "");
 
+        if (mPrecomputedCosts)
+        {
+            const size_t vertexIdx = static_cast<size_t>(vertex - &data->mVertexList[0]);
+            data->mCollapseCostHeap._pushUnordered(vertex, mPrecomputedCosts[vertexIdx]);
+            return;
+        }
+
         Real collapseCost = LodData::UNINITIALIZED_COLLAPSE_COST;
         LodData::Vertex* collapseTo = NULL;
         computeVertexCollapseCost(data, vertex, collapseCost, collapseTo);
 
         vertex->collapseTo = collapseTo;
-        vertex->costHeapPosition = data->mCollapseCostHeap.insert(LodData::CollapseCostHeap::value_type(collapseCost, vertex));
+        data->mCollapseCostHeap.push(vertex, collapseCost);
     }
 
     void LodCollapseCost::updateVertexCollapseCost( LodData* data, LodData::Vertex* vertex )
@@ -90,20 +188,19 @@ namespace Ogre
         LodData::Vertex* collapseTo = NULL;
         computeVertexCollapseCost(data, vertex, collapseCost, collapseTo);
 
-        if (vertex->collapseTo != collapseTo || collapseCost != vertex->costHeapPosition->first)
+        OgreAssert(data->mCollapseCostHeap.contains(vertex), "");
+        if (vertex->collapseTo != collapseTo || collapseCost != data->mCollapseCostHeap.getCost(vertex))
         {
-            OgreAssert(vertex->costHeapPosition != data->mCollapseCostHeap.end(), "");
-            data->mCollapseCostHeap.erase(vertex->costHeapPosition);
             if (collapseCost != LodData::UNINITIALIZED_COLLAPSE_COST)
             {
                 vertex->collapseTo = collapseTo;
-                vertex->costHeapPosition = data->mCollapseCostHeap.insert(LodData::CollapseCostHeap::value_type(collapseCost, vertex));
+                data->mCollapseCostHeap.update(vertex, collapseCost);
             }
             else
             {
+                data->mCollapseCostHeap.remove(vertex);
 #if OGRE_DEBUG_MODE
                 vertex->collapseTo = NULL;
-                vertex->costHeapPosition = data->mCollapseCostHeap.end();
 #endif
             }
         }
@@ -37,10 +37,9 @@ namespace Ogre
     {
         while (data->mCollapseCostHeap.size() > static_cast<size_t>(vertexCountLimit))
         {
-            LodData::CollapseCostHeap::iterator nextVertex = data->mCollapseCostHeap.begin();
-            if (nextVertex->first < collapseCostLimit)
+            if (data->mCollapseCostHeap.topCost() < collapseCostLimit)
             {
-                mLastReducedVertex = nextVertex->second;
+                mLastReducedVertex = data->mCollapseCostHeap.top();
                 collapseVertex(data, cost, output, mLastReducedVertex);
             }
             else
@@ -56,12 +55,10 @@ namespace Ogre
         // Allows to find bugs in collapsing.
         //  size_t s1 = mUniqueVertexSet.size();
         //  size_t s2 = mCollapseCostHeap.size();
-        LodData::CollapseCostHeap::iterator it = data->mCollapseCostHeap.begin();
-        LodData::CollapseCostHeap::iterator itEnd = data->mCollapseCostHeap.end();
-        while (it != itEnd)
+        const size_t heapSize = data->mCollapseCostHeap.size();
+        for (size_t i = 0; i < heapSize; i++)
         {
-            assertValidVertex(data, it->second);
-            it++;
+            assertValidVertex(data, data->mCollapseCostHeap.at(i));
         }
     }
 
@@ -75,7 +72,7 @@ namespace Ogre
             LodData::Triangle* t = *it;
             for (int i = 0; i < 3; i++)
             {
-                OgreAssert(t->vertex[i]->costHeapPosition != data->mCollapseCostHeap.end(), "");
+                OgreAssert(data->mCollapseCostHeap.contains(t->vertex[i]), "");
                 t->vertex[i]->edges.findExists(LodData::Edge(t->vertex[i]->collapseTo));
                 for (int n = 0; n < 3; n++)
                 {
@@ -207,8 +204,8 @@ namespace Ogre
         assertValidVertex(data, dst);
         assertValidVertex(data, src);
 #endif
-        OgreAssert(src->costHeapPosition->first != LodData::NEVER_COLLAPSE_COST, "");
-        OgreAssert(src->costHeapPosition->first != LodData::UNINITIALIZED_COLLAPSE_COST, "");
+        OgreAssert(data->mCollapseCostHeap.getCost(src) != LodData::NEVER_COLLAPSE_COST, "");
+        OgreAssert(data->mCollapseCostHeap.getCost(src) != LodData::UNINITIALIZED_COLLAPSE_COST, "");
         OgreAssert(!src->edges.empty(), "");
         OgreAssert(!src->triangles.empty(), "");
         OgreAssert(src->edges.find(LodData::Edge(dst)) != src->edges.end(), "");
@@ -340,11 +337,10 @@ namespace Ogre
         assertOutdatedCollapseCost(data, cost, dst);
 #endif // ifndef OGRE_DEBUG_MODE
 #endif // ifndef MESHLOD_QUALITY
-        data->mCollapseCostHeap.erase(src->costHeapPosition); // Remove src from collapse costs.
+        data->mCollapseCostHeap.remove(src); // Remove src from collapse costs.
         src->edges.clear(); // Free memory
         src->triangles.clear(); // Free memory
 #if OGRE_DEBUG_MODE
-        src->costHeapPosition = data->mCollapseCostHeap.end();
         assertValidVertex(data, dst);
 #endif
     }
@@ -141,4 +141,114 @@ namespace Ogre
         return dst == other.dst;
     }
 
-}
\ No newline at end of file
+    void LodData::CollapseCostHeap::siftUp( size_t idx )
+    {
+        const Entry entry = mEntries[idx];
+        while( idx > 0 )
+        {
+            const size_t parentIdx = (idx - 1u) >> 2u;
+            if( !(entry.cost < mEntries[parentIdx].cost) )
+                break;
+            placeEntry( idx, mEntries[parentIdx] );
+            idx = parentIdx;
+        }
+        placeEntry( idx, entry );
+    }
+
+    void LodData::CollapseCostHeap::siftDown( size_t idx )
+    {
+        const Entry entry = mEntries[idx];
+        const size_t numEntries = mEntries.size();
+        while( true )
+        {
+            const size_t firstChild = (idx << 2u) + 1u;
+            if( firstChild >= numEntries )
+                break;
+
+            //Find the cheapest of the (up to) 4 children.
+            const size_t lastChild = std::min( firstChild + 4u, numEntries );
+            size_t bestChild = firstChild;
+            Real bestCost = mEntries[firstChild].cost;
+            for( size_t i=firstChild + 1u; i<lastChild; ++i )
+            {
+                if( mEntries[i].cost < bestCost )
+                {
+                    bestChild = i;
+                    bestCost = mEntries[i].cost;
+                }
+            }
+
+            if( !(bestCost < entry.cost) )
+                break;
+
+            placeEntry( idx, mEntries[bestChild] );
+            idx = bestChild;
+        }
+        placeEntry( idx, entry );
+    }
+
+    void LodData::CollapseCostHeap::push( Vertex *vertex, Real cost )
+    {
+        _pushUnordered( vertex, cost );
+        siftUp( mEntries.size() - 1u );
+    }
+
+    void LodData::CollapseCostHeap::update( Vertex *vertex, Real cost )
+    {
+        OgreAssert( contains( vertex ), "Vertex is not in the collapse cost heap" );
+        const size_t idx = vertex->costHeapPosition;
+        const Real oldCost = mEntries[idx].cost;
+        mEntries[idx].cost = cost;
+        if( cost < oldCost )
+            siftUp( idx );
+        else
+            siftDown( idx );
+    }
+
+    void LodData::CollapseCostHeap::remove( Vertex *vertex )
+    {
+        OgreAssert( contains( vertex ), "Vertex is not in the collapse cost heap" );
+        const size_t idx = vertex->costHeapPosition;
+        const Real oldCost = mEntries[idx].cost;
+        const Entry lastEntry = mEntries.back();
+        mEntries.pop_back();
+        vertex->costHeapPosition = NOT_IN_HEAP;
+
+        if( idx < mEntries.size() )
+        {
+            //Move the last entry into the hole and restore the heap order.
+            placeEntry( idx, lastEntry );
+            if( lastEntry.cost < oldCost )
+                siftUp( idx );
+            else
+                siftDown( idx );
+        }
+    }
+
+    void LodData::CollapseCostHeap::_pushUnordered( Vertex *vertex, Real cost )
+    {
+        Entry entry;
+        entry.cost = cost;
+        entry.vertex = vertex;
+        vertex->costHeapPosition = mEntries.size();
+        mEntries.push_back( entry );
+    }
+
+    void LodData::CollapseCostHeap::_buildHeap(void)
+    {
+        const size_t numEntries = mEntries.size();
+        if( numEntries < 2u )
+            return;
+
+        //Floyd's method: sift down every node with children, starting from the last one.
+        size_t idx = (numEntries - 2u) >> 2u;
+        while( true )
+        {
+            siftDown( idx );
+            if( idx == 0 )
+                break;
+            --idx;
+        }
+    }
+
+}
@@ -147,9 +147,7 @@ namespace Ogre
             }
             else
             {
-#if OGRE_DEBUG_MODE
-                v->costHeapPosition = data->mCollapseCostHeap.end();
-#endif
+                v->costHeapPosition = LodData::CollapseCostHeap::NOT_IN_HEAP;
                 v->seam = false;
                 if(data->mUseVertexNormals)
                 {
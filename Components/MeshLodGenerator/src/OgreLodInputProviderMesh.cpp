@@ -187,10 +187,7 @@ namespace Ogre
             }
             else
             {
-#if OGRE_DEBUG_MODE
-                // Needed for an assert, don't remove it.
-                v->costHeapPosition = data->mCollapseCostHeap.end();
-#endif
+                v->costHeapPosition = LodData::CollapseCostHeap::NOT_IN_HEAP;
                 v->seam = false;
             }
             lookup.push_back(v);
@@ -44,6 +44,10 @@
 #include "OgreLodCollapseCostOutside.h"
 #include "OgreLodData.h"
 #include "OgreLodCollapser.h"
+#include "OgreSubMesh.h"
+#include "OgrePlatformInformation.h"
+#include "Threading/OgreThreads.h"
+#include "Threading/OgreLightweightMutex.h"
 
 
 namespace Ogre
@@ -147,6 +151,17 @@ namespace Ogre
             LodInputProviderPtr& input,
             LodOutputProviderPtr& output,
             LodCollapserPtr& collapser)
+    {
+        resolveComponents(lodConfig, cost, data, input, output, collapser,
+                          lodConfig.advanced.useBackgroundQueue);
+    }
+    void MeshLodGenerator::resolveComponents(LodConfig& lodConfig,
+            LodCollapseCostPtr& cost,
+            LodDataPtr& data,
+            LodInputProviderPtr& input,
+            LodOutputProviderPtr& output,
+            LodCollapserPtr& collapser,
+            bool useBuffers)
     {
         if(cost.isNull())
         {
@@ -171,7 +186,7 @@ namespace Ogre
         {
             collapser = LodCollapserPtr(new LodCollapser());
         }
-        if(lodConfig.advanced.useBackgroundQueue)
+        if(useBuffers)
         {
             if(input.isNull())
             {
@@ -214,6 +229,23 @@ namespace Ogre
                                     LodInputProvider* input,
                                     LodOutputProvider* output,
                                     LodCollapser* collapser)
+    {
+        data->mNumWorkerThreads = lodConfig.advanced.numWorkerThreads;
+        _processData(lodConfig, cost, data, input, output, collapser);
+        if(!lodConfig.advanced.useBackgroundQueue)
+        {
+            // This will be processed in LodWorkQueueInjector if we use background queue.
+            output->inject();
+            _configureMeshLodUsage(lodConfig);
+            //lodConfig.mesh->buildEdgeList();
+        }
+    }
+    void MeshLodGenerator::_processData(LodConfig& lodConfig,
+                                        LodCollapseCost* cost,
+                                        LodData* data,
+                                        LodInputProvider* input,
+                                        LodOutputProvider* output,
+                                        LodCollapser* collapser)
     {
         input->initData(data);
         data->mUseVertexNormals = data->mUseVertexNormals && lodConfig.advanced.useVertexNormals;
@@ -221,13 +253,17 @@ namespace Ogre
         output->prepare(data);
         computeLods(lodConfig, data, cost, output, collapser);
         output->finalize(data);
-        if(!lodConfig.advanced.useBackgroundQueue)
+    }
+    bool MeshLodGenerator::hasGeneratedLodLevels(const LodConfig& lodConfig)
+    {
+        for(size_t i = 0; i < lodConfig.levels.size(); i++)
         {
-            // This will be processed in LodWorkQueueInjector if we use background queue.
-            output->inject();
-            _configureMeshLodUsage(lodConfig);
-            //lodConfig.mesh->buildEdgeList();
+            if(lodConfig.levels[i].manualMeshName.empty())
+            {
+                return true;
+            }
         }
+        return false;
     }
     void MeshLodGenerator::generateLodLevels(LodConfig& lodConfig,
             LodCollapseCostPtr cost,
@@ -237,15 +273,7 @@ namespace Ogre
             LodCollapserPtr collapser)
     {
         // If we don't have generated Lod levels, we can use _generateManualLodLevels.
-        bool hasGeneratedLevels = false;
-        for(size_t i = 0; i < lodConfig.levels.size(); i++)
-        {
-            if(lodConfig.levels[i].manualMeshName.empty())
-            {
-                hasGeneratedLevels = true;
-                break;
-            }
-        }
+        bool hasGeneratedLevels = hasGeneratedLodLevels(lodConfig);
         if(hasGeneratedLevels || (LodWorkQueueInjector::getSingletonPtr() && LodWorkQueueInjector::getSingletonPtr()->getInjectorListener()))
         {
             _resolveComponents(lodConfig, cost, data, input, output, collapser);
@@ -267,6 +295,131 @@ namespace Ogre
         lodConfig.mesh->prepareForShadowMapping( false );
     }
 
+    struct MeshLodBatchJob
+    {
+        LodConfig* lodConfig;
+        LodCollapseCostPtr cost;
+        LodDataPtr data;
+        LodInputProviderPtr input;
+        LodOutputProviderPtr output;
+        LodCollapserPtr collapser;
+        size_t indexCount; // Used to process the biggest meshes first.
+    };
+
+    struct MeshLodBatchJobCmp
+    {
+        bool operator () (const MeshLodBatchJob* a, const MeshLodBatchJob* b) const
+        {
+            return a->indexCount > b->indexCount;
+        }
+    };
+
+    struct MeshLodBatch
+    {
+        MeshLodGenerator* generator;
+        vector<MeshLodBatchJob*>::type sortedJobs;
+        size_t nextJob;
+        LightweightMutex mutex;
+    };
+
+    static void processMeshLodBatch(MeshLodBatch* batch)
+    {
+        while(true)
+        {
+            batch->mutex.lock();
+            const size_t jobIdx = batch->nextJob++;
+            batch->mutex.unlock();
+
+            if(jobIdx >= batch->sortedJobs.size())
+                break;
+
+            MeshLodBatchJob* job = batch->sortedJobs[jobIdx];
+            batch->generator->_processData(*job->lodConfig, job->cost.get(), job->data.get(),
+                                           job->input.get(), job->output.get(), job->collapser.get());
+        }
+    }
+
+    unsigned long meshLodBatchThread(ThreadHandle* threadHandle);
+    THREAD_DECLARE(meshLodBatchThread);
+    unsigned long meshLodBatchThread(ThreadHandle* threadHandle)
+    {
+        processMeshLodBatch(reinterpret_cast<MeshLodBatch*>(threadHandle->getUserParam()));
+        return 0;
+    }
+
+    void MeshLodGenerator::generateLodLevelsBatch(LodConfigList& lodConfigs, size_t numThreads)
+    {
+        if(!numThreads)
+        {
+            numThreads = PlatformInformation::getNumLogicalCores();
+        }
+
+        // Everything that touches the meshes (reading their buffers, manual levels) happens here.
+        vector<MeshLodBatchJob>::type jobs;
+        jobs.reserve(lodConfigs.size());
+        LodConfigList::iterator itor = lodConfigs.begin();
+        LodConfigList::iterator end = lodConfigs.end();
+        while(itor != end)
+        {
+            if(hasGeneratedLodLevels(*itor))
+            {
+                MeshLodBatchJob job;
+                job.lodConfig = &(*itor);
+                job.indexCount = 0;
+                const unsigned short numSubMeshes = itor->mesh->getNumSubMeshes();
+                for(unsigned short i = 0; i < numSubMeshes; i++)
+                {
+                    job.indexCount += itor->mesh->getSubMesh(i)->indexData[VpNormal]->indexCount;
+                }
+                resolveComponents(*itor, job.cost, job.data, job.input, job.output, job.collapser, true);
+                jobs.push_back(job);
+            }
+            else
+            {
+                _generateManualLodLevels(*itor);
+                itor->mesh->prepareForShadowMapping( false );
+            }
+            ++itor;
+        }
+
+        if(jobs.empty())
+            return;
+
+        MeshLodBatch batch;
+        batch.generator = this;
+        batch.nextJob = 0;
+        batch.sortedJobs.reserve(jobs.size());
+        for(size_t i = 0; i < jobs.size(); i++)
+        {
+            // When there are fewer meshes than threads, split each mesh between the spare ones.
+            jobs[i].data->mNumWorkerThreads = std::max<size_t>(numThreads / jobs.size(), 1u);
+            batch.sortedJobs.push_back(&jobs[i]);
+        }
+        std::sort(batch.sortedJobs.begin(), batch.sortedJobs.end(), MeshLodBatchJobCmp());
+
+        const size_t numBatchThreads = std::min(numThreads, jobs.size());
+        ThreadHandleVec threadHandles;
+        threadHandles.reserve(numBatchThreads - 1u);
+        for(size_t i = 1; i < numBatchThreads; i++)
+        {
+            threadHandles.push_back(Threads::CreateThread(THREAD_GET(meshLodBatchThread), i, &batch));
+        }
+        // The calling thread works too.
+        processMeshLodBatch(&batch);
+        Threads::WaitForThreads(threadHandles);
+
+        // Hardware buffers can only be created from the main thread.
+        vector<MeshLodBatchJob>::type::iterator itJob = jobs.begin();
+        vector<MeshLodBatchJob>::type::iterator enJob = jobs.end();
+        while(itJob != enJob)
+        {
+            itJob->output->inject();
+            _configureMeshLodUsage(*itJob->lodConfig);
+            itJob->lodConfig->mesh->prepareForShadowMapping( false );
+            ++itJob;
+        }
+    }
+
     void MeshLodGenerator::computeLods(LodConfig& lodConfig,
                                        LodData* data,
                                        LodCollapseCost* cost,
@@ -1896,6 +1896,21 @@ namespace Ogre
         int getHighestLodPrepared() const { return (mLodManager) ? mLodManager->getHighestLodPrepared() : -1; };
         int getHighestLodLoaded() const { return (mLodManager) ? mLodManager->getHighestLodLoaded() : -1; };
         int getTargetLodLevel() const { return (mLodManager) ? mLodManager->getTargetLodLevel() : -1; };
+        /// Whether LOD data is being streamed in the background right now.
+        bool isLodLoadInProgress() const { return mLodManager && mLodManager->isLoadInProgress(); }
+
+        /** Approximate GPU memory used by the vertex data when loaded down to the given LOD level
+            (i.e. the lowest LOD is always resident). Used to enforce the LOD streaming budget.
+            @see TerrainGroup::setLodStreamingLimits
+        */
+        size_t getLodDataMemoryUsage(int lodLevel) const;
+
+        /** Marks the whole geometry as dirty after LOD data has been streamed in.
+        @remarks
+            Unlike dirty(), the height data is not considered modified, thus neither the
+            derived data nor the neighbours need to be updated.
+        */
+        void _dirtyStreamedGeometry();
     };
 
 
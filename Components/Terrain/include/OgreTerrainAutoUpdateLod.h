@@ -61,6 +61,12 @@ namespace Ogre
         */
         virtual void autoUpdateLod(Terrain *terrain, bool synchronous, const Any &data) = 0;
         virtual uint32 getStrategyId() = 0;
+        /** Returns the LOD level autoUpdateLod would change the terrain to, without changing it.
+            Used by TerrainGroup to decide which terrains stream first when the streaming
+            is limited (@see TerrainGroup::setLodStreamingLimits).
+            @return -1 if unknown, in which case autoUpdateLod gets called directly.
+        */
+        virtual int getTargetLodLevel(Terrain *terrain, const Any &data) { return -1; }
     };
 
     // other Strategy's id start from 2
@@ -78,12 +84,15 @@ namespace Ogre
     public:
         virtual void autoUpdateLod(Terrain *terrain, bool synchronous, const Any &data);
         virtual uint32 getStrategyId() { return BY_DISTANCE; }
+        virtual int getTargetLodLevel(Terrain *terrain, const Any &data);
 
     protected:
         /** Modifies Terrain's LOD level according to it's distance from camera.
             @param holdDistance How far ahead of terrain's LOD level change this LOD level should be loaded.
         */
         void autoUpdateLodByDistance(Terrain *terrain, bool synchronous, const Real holdDistance);
+        /// Calculates the LOD level needed according to the distance from camera. -1 if unknown.
+        int calculateLodByDistance(Terrain *terrain, const Real holdDistance);
         /// Traverse Terrain's QuadTree and calculate what LOD level is needed.
         int traverseTreeByDistance(TerrainQuadTreeNode *node, const Camera *cam, Real cFactor, const Real holdDistance);
     };
@@ -510,8 +510,28 @@ namespace Ogre
         void setAutoUpdateLod(TerrainAutoUpdateLod* updater);
         /// Automatically checks if terrain's LOD level needs to be updated.
         void autoUpdateLod(long x, long y, bool synchronous, const Any &data);
+        /** Automatically checks if the LOD level of all terrains needs to be updated.
+        @remarks
+            When streaming limits are set (@see setLodStreamingLimits) and the TerrainAutoUpdateLod
+            supports TerrainAutoUpdateLod::getTargetLodLevel, terrains closer to the camera
+            stream in their LOD data first.
+        */
         void autoUpdateLodAll(bool synchronous, const Any &data);
 
+        /** Limits the LOD data streamed in by autoUpdateLodAll, so that entering new areas
+            doesn't flood the WorkQueue nor the GPU memory.
+        @param maxRequests
+            Maximum number of terrains streaming in LOD data at the same time. Terrains
+            closer to the camera go first, the rest wait for a later update. 0 for no limit.
+        @param memoryBudget
+            Maximum bytes of vertex data (see Terrain::getLodDataMemoryUsage) across the
+            group. Terrains farther away get a lower LOD than requested when it would be
+            exceeded; the lowest LOD is always loaded. 0 for no limit.
+        */
+        void setLodStreamingLimits(size_t maxRequests, size_t memoryBudget);
+        size_t getMaxLodStreamingRequests() const { return mMaxLodStreamingRequests; }
+        size_t getLodStreamingMemoryBudget() const { return mLodStreamingMemoryBudget; }
+
     protected:
         SceneManager *mSceneManager;
         Terrain::Alignment mAlignment;
@@ -526,6 +546,20 @@ namespace Ogre
         String mResourceGroup;
         TerrainAutoUpdateLod *mAutoUpdateLod;
         Terrain::DefaultGpuBufferAllocator mBufferAllocator;
+        size_t mMaxLodStreamingRequests;
+        size_t mLodStreamingMemoryBudget;
+
+        struct LodStreamingCandidate
+        {
+            Terrain* terrain;
+            int targetLod;
+            /// Squared distance to the camera
+            Real distance;
+            bool operator < (const LodStreamingCandidate& other) const { return distance < other.distance; }
+        };
+        typedef vector<LodStreamingCandidate>::type LodStreamingCandidateList;
+        /// Scratch list used by autoUpdateLodAll
+        LodStreamingCandidateList mLodStreamingCandidates;
         
         /// Get the position of a terrain instance
         Vector3 getTerrainSlotPosition(long x, long y);
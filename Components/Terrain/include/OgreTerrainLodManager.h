@@ -116,6 +116,8 @@ namespace Ogre
         int getHighestLodPrepared(){ return mHighestLodPrepared; }
         int getHighestLodLoaded(){ return mHighestLodLoaded; }
         int getTargetLodLevel(){ return mTargetLodLevel; }
+        /// Whether LOD data is being streamed in by the WorkQueue right now
+        bool isLoadInProgress() const { return mIncreaseLodLevelInProgress; }
 
         LodInfo& getLodInfo(uint lodLevel)
         {
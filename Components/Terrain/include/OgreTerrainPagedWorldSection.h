@@ -147,6 +147,8 @@ namespace Ogre
         void loadPage(PageID pageID, bool forceSynchronous = false);
         /// Overridden from PagedWorldSection
         void unloadPage(PageID pageID, bool forceSynchronous = false);
+        /// Overridden from PagedWorldSection. Pages closest to the camera are loaded first.
+        void notifyCamera(Camera* cam);
 
         /// WorkQueue::RequestHandler override
         WorkQueue::Response* handleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ);
@@ -180,12 +182,16 @@ namespace Ogre
         uint16 mWorkQueueChannel;
         unsigned long mNextLoadingTime;
         uint32 mLoadingIntervalMs;
+        Vector3 mLastCameraPos;
+        bool mHasCameraPos;
 
         /// Overridden from PagedWorldSection
         void loadSubtypeData(StreamSerialiser& ser);
         void saveSubtypeData(StreamSerialiser& ser);
 
         virtual void syncSettings();
+        /// Moves the queued page closest to the last camera to the front of mPagesInLoading
+        void prioritisePagesInLoading();
 
     };
 
@@ -1877,6 +1877,14 @@ namespace Ogre
 
     }
     //---------------------------------------------------------------------
+    void Terrain::_dirtyStreamedGeometry()
+    {
+        Rect rect;
+        rect.top = 0; rect.bottom = mSize;
+        rect.left = 0; rect.right = mSize;
+        mDirtyGeometryRect.merge(rect);
+    }
+    //---------------------------------------------------------------------
     void Terrain::_dirtyCompositeMapRect(const Rect& rect)
     {
         mCompositeMapDirtyRect.merge(rect);
@@ -2264,6 +2272,17 @@ namespace Ogre
         return size*size - prevSize*prevSize;
     }
     //---------------------------------------------------------------------
+    size_t Terrain::getLodDataMemoryUsage(int lodLevel) const
+    {
+        lodLevel = getPositiveLodLevel(lodLevel);
+
+        size_t numVertices = 0;
+        for (int level = lodLevel; level < (int)mNumLodLevels; ++level)
+            numVertices += getGeoDataSizeAtLod(level);
+
+        return numVertices * (getPositionBufVertexSize() + getDeltaBufVertexSize());
+    }
+    //---------------------------------------------------------------------
     bool Terrain::frameStarted(const FrameEvent& evt)
     {
         // Early-out
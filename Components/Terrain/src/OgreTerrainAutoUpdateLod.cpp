@@ -51,19 +51,34 @@ namespace Ogre
             autoUpdateLodByDistance(terrain, synchronous, any_cast<Real>(data));
     }
 
+    int TerrainAutoUpdateLodByDistance::getTargetLodLevel(Terrain *terrain, const Any &data)
+    {
+        if( !terrain )
+            return -1;
+        return calculateLodByDistance(terrain, any_cast<Real>(data));
+    }
+
     void TerrainAutoUpdateLodByDistance::autoUpdateLodByDistance(Terrain *terrain, bool synchronous, const Real holdDistance)
+    {
+        int maxLod = calculateLodByDistance(terrain, holdDistance);
+        if (maxLod >= 0)
+            terrain->load(maxLod,synchronous);
+    }
+
+    int TerrainAutoUpdateLodByDistance::calculateLodByDistance(Terrain *terrain, const Real holdDistance)
     {
         if (!terrain->isLoaded())
-            return;
+            return -1;
 
         // calculate error terms
-        const Camera* cam = terrain->getSceneManager()->getCameraInProgress()->getLodCamera();
+        const Camera* camInProgress = terrain->getSceneManager()->getCameraInProgress();
+        const Camera* cam = camInProgress ? camInProgress->getLodCamera() : 0;
         if(!cam)
-            return;
+            return -1;
 
         const Viewport* vp = cam->getLastViewport();
         if(!vp)
-            return;
+            return -1;
 
         // W. de Boer 2000 calculation
         // A = vp_near / abs(vp_top)
@@ -76,9 +91,7 @@ namespace Ogre
         // CFactor = A / T
         Real cFactor = A / T;
 
-        int maxLod = traverseTreeByDistance(terrain->getQuadTree(), cam, cFactor, holdDistance);
-        if (maxLod >= 0)
-            terrain->load(maxLod,synchronous);
+        return traverseTreeByDistance(terrain->getQuadTree(), cam, cFactor, holdDistance);
     }
 
     int TerrainAutoUpdateLodByDistance::traverseTreeByDistance(TerrainQuadTreeNode *node,
@@ -31,6 +31,8 @@ THE SOFTWARE.
 #include "OgreStreamSerialiser.h"
 #include "OgreLogManager.h"
 #include "OgreTerrainAutoUpdateLod.h"
+#include "OgreCamera.h"
+#include "OgreSceneManager.h"
 #include <iomanip>
 
 namespace Ogre
@@ -52,6 +54,8 @@ namespace Ogre
         , mFilenameExtension("dat")
         , mResourceGroup(ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME)
         , mAutoUpdateLod( TerrainAutoUpdateLodFactory::getAutoUpdateLod(NONE) )
+        , mMaxLodStreamingRequests(0)
+        , mLodStreamingMemoryBudget(0)
     {
         mDefaultImportData.terrainAlign = align;
         mDefaultImportData.terrainSize = terrainSize;
@@ -77,6 +81,8 @@ namespace Ogre
         , mFilenameExtension("dat")
         , mResourceGroup(ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME)
         , mAutoUpdateLod(0)
+        , mMaxLodStreamingRequests(0)
+        , mLodStreamingMemoryBudget(0)
     {
         mDefaultImportData.terrainAlign = mAlignment;
         mDefaultImportData.terrainSize = 0;
@@ -355,14 +361,93 @@ namespace Ogre
     //---------------------------------------------------------------------
     void TerrainGroup::autoUpdateLodAll(bool synchronous, const Any &data)
     {
-        if(mAutoUpdateLod)
+        if(!mAutoUpdateLod)
+            return;
+
+        if(!mMaxLodStreamingRequests && !mLodStreamingMemoryBudget)
         {
             for (TerrainSlotMap::iterator i = mTerrainSlots.begin(); i != mTerrainSlots.end(); ++i)
             {
                 TerrainSlot* slot = i->second;
                 mAutoUpdateLod->autoUpdateLod(slot->instance, synchronous, data);
             }
+            return;
         }
+
+        const Camera* camInProgress = mSceneManager->getCameraInProgress();
+        const Camera* cam = camInProgress ? camInProgress->getLodCamera() : 0;
+
+        mLodStreamingCandidates.clear();
+        size_t numRequestsInProgress = 0;
+        for (TerrainSlotMap::iterator i = mTerrainSlots.begin(); i != mTerrainSlots.end(); ++i)
+        {
+            Terrain* terrain = i->second->instance;
+            if (!terrain || !terrain->isLoaded())
+                continue;
+
+            if (terrain->isLodLoadInProgress())
+                ++numRequestsInProgress;
+
+            int targetLod = mAutoUpdateLod->getTargetLodLevel(terrain, data);
+            if (targetLod < 0)
+            {
+                // the strategy can't tell us in advance, let it do its thing
+                mAutoUpdateLod->autoUpdateLod(terrain, synchronous, data);
+                continue;
+            }
+
+            LodStreamingCandidate candidate;
+            candidate.terrain = terrain;
+            candidate.targetLod = targetLod;
+            candidate.distance = cam ? cam->getDerivedPosition().squaredDistance(terrain->getPosition()) : 0;
+            mLodStreamingCandidates.push_back(candidate);
+        }
+
+        // closest terrains get their detail first
+        std::sort(mLodStreamingCandidates.begin(), mLodStreamingCandidates.end());
+
+        size_t memoryUsed = 0;
+        for (LodStreamingCandidateList::const_iterator i = mLodStreamingCandidates.begin();
+             i != mLodStreamingCandidates.end(); ++i)
+        {
+            Terrain* terrain = i->terrain;
+            int lodLevel = i->targetLod;
+            const int lowestLod = terrain->getNumLodLevels() - 1;
+
+            // degrade instead of exceeding the budget. The lowest LOD is always resident
+            if (mLodStreamingMemoryBudget)
+            {
+                while (lodLevel < lowestLod &&
+                       memoryUsed + terrain->getLodDataMemoryUsage(lodLevel) > mLodStreamingMemoryBudget)
+                {
+                    ++lodLevel;
+                }
+                memoryUsed += terrain->getLodDataMemoryUsage(lodLevel);
+            }
+
+            int highestLodLoaded = terrain->getHighestLodLoaded();
+            if (highestLodLoaded < 0)
+                highestLodLoaded = terrain->getNumLodLevels();
+
+            const bool needsStreaming = lodLevel < highestLodLoaded && !terrain->isLodLoadInProgress();
+            if (needsStreaming && !synchronous && mMaxLodStreamingRequests &&
+                numRequestsInProgress >= mMaxLodStreamingRequests)
+            {
+                // try again on the next update, farther terrains can't stream either
+                continue;
+            }
+
+            // unloading is immediate, and if a request is running it only changes its target
+            terrain->load(lodLevel, synchronous);
+            if (needsStreaming && !synchronous)
+                ++numRequestsInProgress;
+        }
+    }
+    //---------------------------------------------------------------------
+    void TerrainGroup::setLodStreamingLimits(size_t maxRequests, size_t memoryBudget)
+    {
+        mMaxLodStreamingRequests = maxRequests;
+        mLodStreamingMemoryBudget = memoryBudget;
     }
     //---------------------------------------------------------------------
     void TerrainGroup::unloadTerrain(long x, long y)
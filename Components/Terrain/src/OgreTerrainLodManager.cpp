@@ -151,10 +151,12 @@ namespace Ogre
                 }
             }
 
-            // has streamed in new data, should update terrain
+            // has streamed in new data, should update terrain. Only the geometry: the data
+            // comes from the same file as the normal map, lightmap & composite map, which
+            // thus are still valid and don't need to be derived again
             if(lreq.currentPreparedLod>lreq.requestedLod)
             {
-                mTerrain->dirty();
+                mTerrain->_dirtyStreamedGeometry();
                 mTerrain->updateGeometryWithoutNotifyNeighbours();
             }
 
@@ -32,6 +32,7 @@ THE SOFTWARE.
 #include "OgrePageManager.h"
 #include "OgreRoot.h"
 #include "OgreTimer.h"
+#include "OgreCamera.h"
 
 namespace Ogre
 {
@@ -44,6 +45,8 @@ namespace Ogre
         , mTerrainDefiner(0)
         , mHasRunningTasks(false)
         , mLoadingIntervalMs(900)
+        , mLastCameraPos(Vector3::ZERO)
+        , mHasCameraPos(false)
     {
         // we always use a grid strategy
         setStrategy(parent->getManager()->getStrategy("Grid2D"));
@@ -275,6 +278,40 @@ namespace Ogre
         }
     }
     //---------------------------------------------------------------------
+    void TerrainPagedWorldSection::notifyCamera(Camera* cam)
+    {
+        mLastCameraPos = cam->getDerivedPosition();
+        mHasCameraPos = true;
+
+        PagedWorldSection::notifyCamera(cam);
+    }
+    //---------------------------------------------------------------------
+    void TerrainPagedWorldSection::prioritisePagesInLoading()
+    {
+        if (!mHasCameraPos || mPagesInLoading.size() < 2)
+            return;
+
+        std::list<PageID>::iterator closest = mPagesInLoading.end();
+        Real closestDistance = std::numeric_limits<Real>::max();
+        for (std::list<PageID>::iterator it = mPagesInLoading.begin(); it != mPagesInLoading.end(); ++it)
+        {
+            long x, y;
+            mTerrainGroup->unpackIndex(*it, &x, &y);
+            Vector3 pos;
+            mTerrainGroup->convertTerrainSlotToWorldPosition(x, y, &pos);
+
+            const Real distance = mLastCameraPos.squaredDistance(pos);
+            if (distance < closestDistance)
+            {
+                closestDistance = distance;
+                closest = it;
+            }
+        }
+
+        if (closest != mPagesInLoading.begin())
+            mPagesInLoading.splice(mPagesInLoading.begin(), mPagesInLoading, closest);
+    }
+    //---------------------------------------------------------------------
     WorkQueue::Response* TerrainPagedWorldSection::handleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ)
     {
         if(mPagesInLoading.empty())
@@ -323,6 +360,9 @@ namespace Ogre
             unsigned long currentTime = Root::getSingletonPtr()->getTimer()->getMilliseconds();
             mNextLoadingTime = currentTime + mLoadingIntervalMs;
 
+            // the camera may have moved since these were queued
+            prioritisePagesInLoading();
+
             // Continue loading other pages
             Root::getSingleton().getWorkQueue()->addRequest(
                     mWorkQueueChannel, WORKQUEUE_LOAD_TERRAIN_PAGE_REQUEST, 
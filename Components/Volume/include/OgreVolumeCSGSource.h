@@ -66,6 +66,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, Vector4 *outValues, size_t numPositions) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Vector3 *positions, Real *outValues, size_t numPositions) const;
     };
 
     /** A plane.
@@ -97,6 +105,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, Vector4 *outValues, size_t numPositions) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Vector3 *positions, Real *outValues, size_t numPositions) const;
     };
 
     /** A not rotated cube.
@@ -239,6 +255,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, Vector4 *outValues, size_t numPositions) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Vector3 *positions, Real *outValues, size_t numPositions) const;
     };
 
     /** Builds the union between two sources.
@@ -266,6 +290,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, Vector4 *outValues, size_t numPositions) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Vector3 *positions, Real *outValues, size_t numPositions) const;
     };
 
     /** Builds the difference between two sources.
@@ -294,6 +326,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, Vector4 *outValues, size_t numPositions) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Vector3 *positions, Real *outValues, size_t numPositions) const;
     };
 
     /** Source which does a unary operation to another one.
@@ -354,6 +394,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, Vector4 *outValues, size_t numPositions) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Vector3 *positions, Real *outValues, size_t numPositions) const;
     };
 
     /** Scales the given volume source.
@@ -381,6 +429,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, Vector4 *outValues, size_t numPositions) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Vector3 *positions, Real *outValues, size_t numPositions) const;
     };
 
     class _OgreVolumeExport CSGNoiseSource: public CSGUnarySource
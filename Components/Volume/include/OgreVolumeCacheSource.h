@@ -29,6 +29,7 @@ THE SOFTWARE.
 #define __Ogre_Volume_CacheSource_H__
 
 #include "OgreVector4.h"
+#include "Threading/OgreThreadHeaders.h"
 
 #include "OgreVolumeSource.h"
 #include "OgreVolumePrerequisites.h"
@@ -56,6 +57,9 @@ namespace Volume {
         typedef map<Vector3, Vector4>::type UMapPositionValue;
         mutable UMapPositionValue mCache;
 
+        /// Chunks are meshed by several WorkQueue threads at once, all of them filling the cache.
+        OGRE_MUTEX(mCacheMutex);
+
         /// The source to cache.
         const Source *mSrc;
         
@@ -67,17 +71,18 @@ namespace Volume {
         */
         inline Vector4 getFromCache(const Vector3 &position) const
         {
-            Vector4 result;
-            map<Vector3, Vector4>::iterator it = mCache.find(position);
-            if (it == mCache.end())
-            {
-                result = mSrc->getValueAndGradient(position);
-                mCache[position] = result;
-            }
-            else
             {
-                result = it->second;
+                OGRE_LOCK_MUTEX(mCacheMutex);
+                map<Vector3, Vector4>::iterator it = mCache.find(position);
+                if (it != mCache.end())
+                {
+                    return it->second;
+                }
             }
+            // Evaluate without holding the lock, another thread might store the same value meanwhile.
+            Vector4 result = mSrc->getValueAndGradient(position);
+            OGRE_LOCK_MUTEX(mCacheMutex);
+            mCache[position] = result;
             return result;
         }
 
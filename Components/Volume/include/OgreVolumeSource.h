@@ -72,6 +72,9 @@ namespace Volume {
 
         /// The amount of items being written as one chunk during serialization.
         static const size_t SERIALIZATION_CHUNK_SIZE;
+
+        /// The maximum amount of positions operations evaluate at once with their own stack buffers.
+        static const size_t BATCH_SIZE = 64;
         
         /** Destructor.
         */
@@ -93,6 +96,31 @@ namespace Volume {
         */
         virtual Real getValue(const Vector3 &position) const = 0;
 
+        /** Gets the density values and gradients of many positions at once. The default
+        implementation calls getValueAndGradient for each one; sources override it to
+        evaluate several positions with SIMD and to save the virtual call per position
+        when walking a CSG tree.
+        @param positions
+            The positions.
+        @param outValues
+            Receives, for each position, a vector with x, y, z containing the gradient and
+            w containing the density.
+        @param numPositions
+            The amount of positions.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, Vector4 *outValues, size_t numPositions) const;
+
+        /** Gets the density values of many positions at once.
+        @see getValuesAndGradients
+        @param positions
+            The positions.
+        @param outValues
+            Receives the density of each position.
+        @param numPositions
+            The amount of positions.
+        */
+        virtual void getValues(const Vector3 *positions, Real *outValues, size_t numPositions) const;
+
         /** Serializes a volume source to a discrete grid file with deflated
         compression. To achieve better compression, all density values are clamped
         within a maximum absolute value of (to - from).length() / 16.0. The values
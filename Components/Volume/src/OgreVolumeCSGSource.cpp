@@ -25,6 +25,7 @@ THE SOFTWARE.
 -----------------------------------------------------------------------------
 */
 #include "OgreVolumeCSGSource.h"
+#include "Math/Array/OgreArrayVector3.h"
 #include <algorithm>
 
 namespace Ogre {
@@ -69,6 +70,70 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGSphereSource::getValuesAndGradients(const Vector3 *positions, Vector4 *outValues, size_t numPositions) const
+    {
+        ArrayVector3 center;
+        center.setAll(mCenter);
+        OGRE_ALIGNED_DECL(Real, distances[ARRAY_PACKED_REALS], OGRE_SIMD_ALIGNMENT);
+
+        size_t i = 0;
+        for (; i + ARRAY_PACKED_REALS <= numPositions; i += ARRAY_PACKED_REALS)
+        {
+            ArrayVector3 pMinCenter;
+            for (size_t j = 0; j < ARRAY_PACKED_REALS; ++j)
+            {
+                pMinCenter.setFromVector3(positions[i + j], j);
+            }
+            pMinCenter -= center;
+            CastArrayToReal(distances, pMinCenter.length());
+            pMinCenter.normalise();
+
+            Vector3 gradient;
+            for (size_t j = 0; j < ARRAY_PACKED_REALS; ++j)
+            {
+                pMinCenter.getAsVector3(gradient, j);
+                outValues[i + j] = Vector4(gradient.x, gradient.y, gradient.z, mR - distances[j]);
+            }
+        }
+
+        for (; i < numPositions; ++i)
+        {
+            outValues[i] = getValueAndGradient(positions[i]);
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGSphereSource::getValues(const Vector3 *positions, Real *outValues, size_t numPositions) const
+    {
+        ArrayVector3 center;
+        center.setAll(mCenter);
+        OGRE_ALIGNED_DECL(Real, distances[ARRAY_PACKED_REALS], OGRE_SIMD_ALIGNMENT);
+
+        size_t i = 0;
+        for (; i + ARRAY_PACKED_REALS <= numPositions; i += ARRAY_PACKED_REALS)
+        {
+            ArrayVector3 pMinCenter;
+            for (size_t j = 0; j < ARRAY_PACKED_REALS; ++j)
+            {
+                pMinCenter.setFromVector3(positions[i + j], j);
+            }
+            pMinCenter -= center;
+            CastArrayToReal(distances, pMinCenter.length());
+            for (size_t j = 0; j < ARRAY_PACKED_REALS; ++j)
+            {
+                outValues[i + j] = mR - distances[j];
+            }
+        }
+
+        for (; i < numPositions; ++i)
+        {
+            outValues[i] = getValue(positions[i]);
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     CSGPlaneSource::CSGPlaneSource(const Real d, const Vector3 &normal) : mD(d), mNormal(normal.normalisedCopy())
     {
     }
@@ -96,6 +161,52 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGPlaneSource::getValuesAndGradients(const Vector3 *positions, Vector4 *outValues, size_t numPositions) const
+    {
+        // The gradient is constant, so only the densities are worth batching.
+        for (size_t start = 0; start < numPositions; start += BATCH_SIZE)
+        {
+            Real values[BATCH_SIZE];
+            const size_t count = std::min(numPositions - start, BATCH_SIZE);
+            getValues(positions + start, values, count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                outValues[start + i] = Vector4(mNormal.x, mNormal.y, mNormal.z, values[i]);
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGPlaneSource::getValues(const Vector3 *positions, Real *outValues, size_t numPositions) const
+    {
+        ArrayVector3 normal;
+        normal.setAll(mNormal);
+        OGRE_ALIGNED_DECL(Real, distances[ARRAY_PACKED_REALS], OGRE_SIMD_ALIGNMENT);
+
+        size_t i = 0;
+        for (; i + ARRAY_PACKED_REALS <= numPositions; i += ARRAY_PACKED_REALS)
+        {
+            ArrayVector3 position;
+            for (size_t j = 0; j < ARRAY_PACKED_REALS; ++j)
+            {
+                position.setFromVector3(positions[i + j], j);
+            }
+            CastArrayToReal(distances, normal.dotProduct(position));
+            for (size_t j = 0; j < ARRAY_PACKED_REALS; ++j)
+            {
+                outValues[i + j] = mD - distances[j];
+            }
+        }
+
+        for (; i < numPositions; ++i)
+        {
+            outValues[i] = getValue(positions[i]);
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     CSGCubeSource::CSGCubeSource(const Vector3 &min, const Vector3 &max)
     {
         mBox.setExtents(min, max);
@@ -205,6 +316,46 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGIntersectionSource::getValuesAndGradients(const Vector3 *positions, Vector4 *outValues, size_t numPositions) const
+    {
+        Vector4 valuesB[BATCH_SIZE];
+        for (size_t start = 0; start < numPositions; start += BATCH_SIZE)
+        {
+            const size_t count = std::min(numPositions - start, BATCH_SIZE);
+            mA->getValuesAndGradients(positions + start, outValues + start, count);
+            mB->getValuesAndGradients(positions + start, valuesB, count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (!(outValues[start + i].w < valuesB[i].w))
+                {
+                    outValues[start + i] = valuesB[i];
+                }
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGIntersectionSource::getValues(const Vector3 *positions, Real *outValues, size_t numPositions) const
+    {
+        Real valuesB[BATCH_SIZE];
+        for (size_t start = 0; start < numPositions; start += BATCH_SIZE)
+        {
+            const size_t count = std::min(numPositions - start, BATCH_SIZE);
+            mA->getValues(positions + start, outValues + start, count);
+            mB->getValues(positions + start, valuesB, count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (!(outValues[start + i] < valuesB[i]))
+                {
+                    outValues[start + i] = valuesB[i];
+                }
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     CSGUnionSource::CSGUnionSource(const Source *a, const Source *b) : CSGOperationSource(a, b)
     {
     }
@@ -243,6 +394,46 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGUnionSource::getValuesAndGradients(const Vector3 *positions, Vector4 *outValues, size_t numPositions) const
+    {
+        Vector4 valuesB[BATCH_SIZE];
+        for (size_t start = 0; start < numPositions; start += BATCH_SIZE)
+        {
+            const size_t count = std::min(numPositions - start, BATCH_SIZE);
+            mA->getValuesAndGradients(positions + start, outValues + start, count);
+            mB->getValuesAndGradients(positions + start, valuesB, count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (!(outValues[start + i].w > valuesB[i].w))
+                {
+                    outValues[start + i] = valuesB[i];
+                }
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGUnionSource::getValues(const Vector3 *positions, Real *outValues, size_t numPositions) const
+    {
+        Real valuesB[BATCH_SIZE];
+        for (size_t start = 0; start < numPositions; start += BATCH_SIZE)
+        {
+            const size_t count = std::min(numPositions - start, BATCH_SIZE);
+            mA->getValues(positions + start, outValues + start, count);
+            mB->getValues(positions + start, valuesB, count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (!(outValues[start + i] > valuesB[i]))
+                {
+                    outValues[start + i] = valuesB[i];
+                }
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     CSGDifferenceSource::CSGDifferenceSource(const Source *a, const Source *b) : CSGOperationSource(a, b)
     {
     }
@@ -281,6 +472,48 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGDifferenceSource::getValuesAndGradients(const Vector3 *positions, Vector4 *outValues, size_t numPositions) const
+    {
+        Vector4 valuesB[BATCH_SIZE];
+        for (size_t start = 0; start < numPositions; start += BATCH_SIZE)
+        {
+            const size_t count = std::min(numPositions - start, BATCH_SIZE);
+            mA->getValuesAndGradients(positions + start, outValues + start, count);
+            mB->getValuesAndGradients(positions + start, valuesB, count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                valuesB[i] = (Real)-1.0 * valuesB[i];
+                if (!(outValues[start + i].w < valuesB[i].w))
+                {
+                    outValues[start + i] = valuesB[i];
+                }
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGDifferenceSource::getValues(const Vector3 *positions, Real *outValues, size_t numPositions) const
+    {
+        Real valuesB[BATCH_SIZE];
+        for (size_t start = 0; start < numPositions; start += BATCH_SIZE)
+        {
+            const size_t count = std::min(numPositions - start, BATCH_SIZE);
+            mA->getValues(positions + start, outValues + start, count);
+            mB->getValues(positions + start, valuesB, count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                valuesB[i] = (Real)-1.0 * valuesB[i];
+                if (!(outValues[start + i] < valuesB[i]))
+                {
+                    outValues[start + i] = valuesB[i];
+                }
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     CSGUnarySource::CSGUnarySource(const Source *src) : mSrc(src)
     {
     }
@@ -333,6 +566,28 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGNegateSource::getValuesAndGradients(const Vector3 *positions, Vector4 *outValues, size_t numPositions) const
+    {
+        mSrc->getValuesAndGradients(positions, outValues, numPositions);
+        for (size_t i = 0; i < numPositions; ++i)
+        {
+            outValues[i] = (Real)-1.0 * outValues[i];
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGNegateSource::getValues(const Vector3 *positions, Real *outValues, size_t numPositions) const
+    {
+        mSrc->getValues(positions, outValues, numPositions);
+        for (size_t i = 0; i < numPositions; ++i)
+        {
+            outValues[i] = (Real)-1.0 * outValues[i];
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     CSGScaleSource::CSGScaleSource(const Source *src, const Real scale) : CSGUnarySource(src), mScale(scale)
     {
     }
@@ -353,6 +608,46 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGScaleSource::getValuesAndGradients(const Vector3 *positions, Vector4 *outValues, size_t numPositions) const
+    {
+        Vector3 scaledPositions[BATCH_SIZE];
+        for (size_t start = 0; start < numPositions; start += BATCH_SIZE)
+        {
+            const size_t count = std::min(numPositions - start, BATCH_SIZE);
+            for (size_t i = 0; i < count; ++i)
+            {
+                scaledPositions[i] = positions[start + i] / mScale;
+            }
+            mSrc->getValuesAndGradients(scaledPositions, outValues + start, count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                outValues[start + i] = outValues[start + i] * mScale;
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGScaleSource::getValues(const Vector3 *positions, Real *outValues, size_t numPositions) const
+    {
+        Vector3 scaledPositions[BATCH_SIZE];
+        for (size_t start = 0; start < numPositions; start += BATCH_SIZE)
+        {
+            const size_t count = std::min(numPositions - start, BATCH_SIZE);
+            for (size_t i = 0; i < count; ++i)
+            {
+                scaledPositions[i] = positions[start + i] / mScale;
+            }
+            mSrc->getValues(scaledPositions, outValues + start, count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                outValues[start + i] = outValues[start + i] * mScale;
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     void CSGNoiseSource::setData(void)
     {
         mGradientOff = fabs(mFrequencies[0]);
@@ -38,6 +38,8 @@ namespace Volume {
     const uint16 Source::VOLUME_CHUNK_VERSION = 1;
     const size_t Source::SERIALIZATION_CHUNK_SIZE = 1000;
 
+    const size_t Source::BATCH_SIZE;
+
     //-----------------------------------------------------------------------
 
     Vector3 Source::getIntersectionStart(const Ray &ray, Real maxDistance) const
@@ -61,6 +63,26 @@ namespace Volume {
 
     //-----------------------------------------------------------------------
 
+    void Source::getValuesAndGradients(const Vector3 *positions, Vector4 *outValues, size_t numPositions) const
+    {
+        for (size_t i = 0; i < numPositions; ++i)
+        {
+            outValues[i] = getValueAndGradient(positions[i]);
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    void Source::getValues(const Vector3 *positions, Real *outValues, size_t numPositions) const
+    {
+        for (size_t i = 0; i < numPositions; ++i)
+        {
+            outValues[i] = getValue(positions[i]);
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
     void Source::serialize(const Vector3 &from, const Vector3 &to, float voxelWidth, const String &file)
     {
         Real maxClampedAbsoluteDensity = (from - to).length() / (Real)16.0;
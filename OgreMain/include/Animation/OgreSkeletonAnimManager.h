@@ -46,6 +46,25 @@ namespace Ogre
     *  @{
     */
 
+    /** A level of detail for skeletal animations. See SkeletonAnimManager::setAnimationLod
+    */
+    struct AnimationLodLevel
+    {
+        /// Value from which this level applies, in the LodStrategy's units
+        /// (i.e. distance for DistanceLodStrategy, pixels for PixelCountLodStrategy).
+        Real    lodValue;
+        /// Animations are sampled once every updateInterval frames. Must be >= 1.
+        uint16  updateInterval;
+        /// Bones deeper than this level in the hierarchy don't get animated (they keep their
+        /// last pose). 0 animates only the root bones; 0xFFFF animates all of them.
+        uint16  maxBoneDepth;
+
+        AnimationLodLevel( Real _lodValue, uint16 _updateInterval, uint16 _maxBoneDepth=0xFFFF ) :
+            lodValue( _lodValue ), updateInterval( _updateInterval ), maxBoneDepth( _maxBoneDepth ) {}
+    };
+
+    typedef vector<AnimationLodLevel>::type AnimationLodLevelVec;
+
     struct BySkeletonDef
     {
         SkeletonDef const               *skeletonDef;
@@ -64,6 +83,24 @@ namespace Ogre
         */
         FastArray<size_t>               threadStarts;
 
+        struct SharedPoseKey
+        {
+            uint32              hash;
+            SkeletonInstance    *skeleton;
+
+            SharedPoseKey( uint32 _hash, SkeletonInstance *_skeleton ) :
+                hash( _hash ), skeleton( _skeleton ) {}
+
+            bool operator < ( const SharedPoseKey &other ) const
+            {
+                //Ties are broken by memory order, so the same instance leads every frame
+                return hash < other.hash || ( hash == other.hash && skeleton < other.skeleton );
+            }
+        };
+
+        /// Scratch buffer used by _updateSharedAnimations.
+        FastArray<SharedPoseKey>        sharedPoseKeys;
+
         BySkeletonDef( const SkeletonDef *skeletonDef, size_t threadCount );
 
         void initializeMemoryManager(void);
@@ -71,6 +108,29 @@ namespace Ogre
         void updateThreadStarts(void);
         void _updateBoneStartTransforms(void);
 
+        /// Returns the settings of the last level whose lodValue is reached (lodLevels
+        /// sorted as in SkeletonAnimManager::lodLevels). Full animation if none is.
+        static void _getAnimationLod( const AnimationLodLevelVec &lodLevels, Real lodValue,
+                                      uint16 &outUpdateInterval, uint16 &outMaxBoneDepth );
+
+        /// Whether the instance at the given index samples its animations this frame.
+        static bool _isAnimationFrame( uint16 updateInterval, uint32 frameCount,
+                                       size_t instanceIdx );
+
+        /** Decides which instances get their animations sampled this frame, and how many
+            bones, based on their LOD. @See SkeletonAnimManager::setAnimationLod
+        */
+        void _updateAnimationLod( const LodStrategy *lodStrategy, const AnimationLodLevelVec &lodLevels,
+                                  const Camera *lodCamera, uint32 frameCount );
+
+        /** Groups the instances with animation sharing enabled whose animation state is
+            identical, so that only one of each group samples its animations this frame.
+            Must be called after _updateAnimationLod. @See SkeletonInstance::setAnimationSharingEnabled
+        @return
+            Number of instances that will copy their pose from another one.
+        */
+        size_t _updateSharedAnimations(void);
+
         bool operator == ( IdString name ) const { return skeletonDefName == name; }
     };
 
@@ -95,6 +155,11 @@ namespace Ogre
     @par
         Just like other managers (@see mNodeMemoryManager), SceneManager implementations may
         want to provide more than one SkeletonAnimManager (i.e. one per octant)
+    @par
+        Instances can be animated at a lower rate and with fewer bones when they're far away
+        or small on screen (@see setAnimationLod). Only the sampling of the animations is
+        throttled; the derived transforms of all bones are still updated every frame so
+        skinned objects follow their nodes.
     @remarks
         The same BoneMemoryManager can't be used for multiple definitions because otherwise
         many SIMD opportunities are lost due to the heterogeneity of the data (a Skeleton
@@ -106,6 +171,41 @@ namespace Ogre
         typedef list<BySkeletonDef>::type BySkeletonDefList;
         BySkeletonDefList bySkeletonDefs;
 
+        /// Null when animation LOD is disabled.
+        LodStrategy const       *lodStrategy;
+        /// Sorted from highest to lowest detail. lodValue is already in the strategy's
+        /// internal units (see LodStrategy::transformUserValue).
+        AnimationLodLevelVec    lodLevels;
+        /// Incremented on every call to _updateAnimationLod; staggers the updates.
+        uint32                  frameCount;
+
+        SkeletonAnimManager();
+
+        /** Enables animation LOD: every frame, the LOD value of each SkeletonInstance
+            is computed with the given strategy and the camera set with
+            SceneManager::setAnimationLodCamera, and the last level whose lodValue
+            is reached decides how often (and how many bones) it gets animated.
+            Instances with the same update interval are spread evenly across frames.
+        @remarks
+            Instances without a LOD object (see SkeletonInstance::_setLodObject) or with
+            LOD disabled (see SkeletonInstance::setAnimationLodEnabled) are always fully
+            animated, as are all instances while there is no LOD camera (or it
+            hasn't rendered to any viewport yet).
+        @param lodStrategy
+            Null to disable animation LOD.
+        @param levels
+            Levels of detail, in any order. lodValue is converted with
+            LodStrategy::transformUserValue and compared against LodStrategy::getValue.
+            Objects that don't reach the value of any level are fully animated every frame.
+        */
+        void setAnimationLod( const LodStrategy *lodStrategy, const AnimationLodLevelVec &levels );
+
+        /// Calls BySkeletonDef::_updateAnimationLod on all definitions. Not thread safe.
+        void _updateAnimationLod( const Camera *lodCamera );
+
+        /// Calls BySkeletonDef::_updateSharedAnimations on all definitions. Not thread safe.
+        size_t _updateSharedAnimations(void);
+
         /// Creates an instance of a skeleton based on the given definition.
         SkeletonInstance* createSkeletonInstance( const SkeletonDef *skeletonDef,
                                                     size_t numWorkerThreads );
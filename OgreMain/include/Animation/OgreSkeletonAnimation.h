@@ -261,7 +261,11 @@ namespace Ogre
         void setEnabled( bool bEnable );
         bool getEnabled(void) const                                 { return mEnabled; }
 
-        void _applyAnimation( const TransformArray &boneTransforms );
+        /** Samples all tracks and applies them to the given bones.
+        @param maxBoneDepth
+            Tracks animating bones deeper than this level in the hierarchy are skipped.
+        */
+        void _applyAnimation( const TransformArray &boneTransforms, uint16 maxBoneDepth = 0xFFFF );
 
         void _swapBoneWeightsUniquePtr( RawSimdUniquePtr<ArrayReal, MEMCATEGORY_ANIMATION>
                                         &inOutBoneWeights );
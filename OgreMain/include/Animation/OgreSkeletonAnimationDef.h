@@ -97,7 +97,22 @@ namespace Ogre
         Real getNumFrames( void ) const { return mNumFrames; }
         Real getOriginalFrameRate( void ) const { return mOriginalFrameRate; }
 
-        void build( const v1::Skeleton *skeleton, const v1::Animation *animation, Real frameRate );
+        /** Builds the animation from a v1 Animation.
+        @param compression
+            When not null, all tracks are compressed (@see compress) once built.
+        */
+        void build( const v1::Skeleton *skeleton, const v1::Animation *animation, Real frameRate,
+                    const SkeletonTrackCompression *compression = 0 );
+
+        /** Compresses all tracks using the given error bounds (@see SkeletonTrack::_compress)
+            and frees the memory used by the uncompressed keyframes.
+        @remarks
+            Must be called before any SkeletonAnimation is created from this definition.
+        */
+        void compress( const SkeletonTrackCompression &settings );
+
+        /// Returns the number of bytes used by the keyframes of all tracks.
+        size_t getKeyFrameMemoryUsage(void) const;
 
         /// Dumps all the tracks in CSV format to the output string argument.
         /// Mostly for debugging purposes. (also easy example to show how to
@@ -138,8 +138,12 @@ namespace Ogre
             time values end up rounded.
         @remarks
             If the framerate information has been lost, set it to 1.
+        @param compression
+            When not null, the keyframes of all animations are compressed with the given
+            error bounds. See SkeletonAnimationDef::compress.
         */
-        SkeletonDef( const v1::Skeleton *originalSkeleton, Real frameRate );
+        SkeletonDef( const v1::Skeleton *originalSkeleton, Real frameRate,
+                     const SkeletonTrackCompression *compression = 0 );
 
         const String& getNameStr(void) const                            { return mName; }
 
@@ -107,14 +107,83 @@ namespace Ogre
 
         uint16 mRefCount;
 
+        /// Object whose LOD value drives the animation LOD. @See SkeletonAnimManager::setAnimationLod
+        MovableObject const     *mLodObject;
+        bool                    mAnimationLodEnabled;
+        /// Whether the animations get sampled in the next call to update
+        bool                    mAnimateThisFrame;
+        /// Bones deeper than this don't get animated
+        uint16                  mLodMaxBoneDepth;
+
+        /// Whether we may reuse the pose sampled by another instance. @See setAnimationSharingEnabled
+        bool                    mAnimationSharingEnabled;
+        /// Instance whose sampled pose we copy this frame. Null when we sample our own.
+        SkeletonInstance const  *mSharedPoseSource;
+
+        /// Resets the bones of the first numDepthLevels levels to the binding pose.
+        void resetToPose( size_t numDepthLevels );
+
     public:
         SkeletonInstance( const SkeletonDef *skeletonDef, BoneMemoryManager *boneMemoryManager );
         ~SkeletonInstance();
 
         const SkeletonDef* getDefinition(void) const                { return mDefinition; }
 
+        /** Samples all active animations. Does nothing on the frames the animation
+            LOD decided to skip (@see SkeletonAnimManager::setAnimationLod), nor when
+            the pose is shared with another instance (@see setAnimationSharingEnabled).
+        */
         void update(void);
 
+        /** When false, this instance is always fully animated regardless of the animation
+            LOD settings (i.e. for the main character). Default is true.
+        */
+        void setAnimationLodEnabled( bool bEnabled )                { mAnimationLodEnabled = bEnabled; }
+        bool getAnimationLodEnabled(void) const                     { return mAnimationLodEnabled; }
+
+        /// Sets the object whose LOD value drives our animation LOD. Can be null.
+        /// Items set themselves when they create their instance.
+        void _setLodObject( const MovableObject *lodObject )        { mLodObject = lodObject; }
+        const MovableObject* _getLodObject(void) const              { return mLodObject; }
+
+        /// Internal use. Called by BySkeletonDef::_updateAnimationLod.
+        void _setAnimationLod( bool animateThisFrame, uint16 maxBoneDepth )
+        {
+            mAnimateThisFrame   = animateThisFrame;
+            mLodMaxBoneDepth    = maxBoneDepth;
+        }
+        /// Returns whether the animations will be sampled in the next update.
+        bool _getAnimateThisFrame(void) const                       { return mAnimateThisFrame; }
+        uint16 _getLodMaxBoneDepth(void) const                      { return mLodMaxBoneDepth; }
+
+        /** When true, instances of the same SkeletonDef whose active animations are in the
+            same state (same animations, frames and weights) sample them only once: one of
+            them is evaluated and the rest copy its pose. Default is false.
+        @remarks
+            Only the animation state is compared. Don't enable it on instances with manual bones
+            or with custom per-bone weights (@see SkeletonAnimation::setBoneWeight) unless all
+            instances sharing a state use the same ones.
+        @par
+            The derived transforms (and thus the bone matrices) are still computed per instance,
+            since each instance follows its own node.
+        */
+        void setAnimationSharingEnabled( bool bEnabled )            { mAnimationSharingEnabled = bEnabled; }
+        bool getAnimationSharingEnabled(void) const                 { return mAnimationSharingEnabled; }
+
+        /// Hash of the state compared by _hasSameAnimationState.
+        uint32 _getAnimationStateHash(void) const;
+        /// Returns true if sampling our animations produces the same pose as sampling other's.
+        bool _hasSameAnimationState( const SkeletonInstance *other ) const;
+
+        /// Internal use. Called by BySkeletonDef::_updateSharedAnimations.
+        void _setSharedPoseSource( const SkeletonInstance *source ) { mSharedPoseSource = source; }
+        const SkeletonInstance* _getSharedPoseSource(void) const    { return mSharedPoseSource; }
+
+        /** Copies the pose sampled by our shared pose source this frame, if we have one.
+            Must be called after the source's update.
+        */
+        void _copySharedPose(void);
+
         /// Resets the transform of all bones to the binding pose. Manual bones are not reset
         void resetToPose(void);
 
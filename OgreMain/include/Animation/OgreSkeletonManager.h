@@ -32,6 +32,7 @@ THE SOFTWARE.
 
 #include "OgreResourceManager.h"
 #include "OgreSingleton.h"
+#include "OgreSkeletonTrack.h"
 
 namespace Ogre {
 
@@ -52,6 +53,9 @@ namespace Ogre {
         typedef map<IdString, SkeletonDefPtr>::type SkeletonDefMap;
         SkeletonDefMap mSkeletonDefs;
 
+        SkeletonTrackCompression    mKeyFrameCompression;
+        bool                        mCompressKeyFrames;
+
     public:
         /// Constructor
         SkeletonManager();
@@ -66,6 +70,19 @@ namespace Ogre {
         SkeletonDefPtr getSkeletonDef( const String &name,
                         const String& groupName = ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME );
 
+        /** Sets whether the keyframes of the skeletons created from now on get compressed,
+            and with which error bounds. Disabled by default.
+            See SkeletonTrack::_compress.
+        @param compression
+            Null to disable compression.
+        */
+        void setKeyFrameCompression( const SkeletonTrackCompression *compression );
+        /// Returns null if compression is disabled.
+        const SkeletonTrackCompression* getKeyFrameCompression(void) const
+        {
+            return mCompressKeyFrames ? &mKeyFrameCompression : 0;
+        }
+
         /** Adds an external pointer for us to track. Throws
             if a skeleton with the same name already exists
         */
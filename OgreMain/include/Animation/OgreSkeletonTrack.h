@@ -32,6 +32,7 @@ THE SOFTWARE.
 #include "OgrePrerequisites.h"
 #include "Math/Array/OgreArrayQuaternion.h"
 #include "Math/Array/OgreKfTransform.h"
+#include "OgreRawPtr.h"
 
 #include "ogrestd/vector.h"
 
@@ -52,6 +53,29 @@ namespace Ogre
 
     typedef FastArray<BoneTransform> TransformArray;
 
+    /** Error bounds used by SkeletonTrack::_compress. The defaults are well below what's
+        noticeable on a human sized character modeled in meters.
+    */
+    struct SkeletonTrackCompression
+    {
+        /// Maximum distance between the compressed and the original position of a bone.
+        Real    positionTolerance;
+        /// Maximum angle between the compressed and the original orientation of a bone.
+        Radian  orientationTolerance;
+        /// Maximum difference between each component of the compressed and original scale.
+        Real    scaleTolerance;
+        /// When true, orientations are stored as 16-bit integers instead of Reals.
+        bool    quantiseOrientations;
+
+        SkeletonTrackCompression() :
+            positionTolerance( 1e-4f ),
+            orientationTolerance( Degree( 0.05f ) ),
+            scaleTolerance( 1e-4f ),
+            quantiseOrientations( true )
+        {
+        }
+    };
+
     class _OgreExport SkeletonTrack : public AnimationAlloc
     {
     protected:
@@ -80,7 +104,35 @@ namespace Ogre
 
         KfTransformArrayMemoryManager *mLocalMemoryManager;
 
+        /** Keyframe data when the track is compressed; empty otherwise (@see _compress).
+            Starts with a KfTransform holding the value of the channels that never change,
+            followed by mCompressedStride ArrayReals per keyframe with the animated channels
+            (position, orientation, scale; in that order). Quantised orientations are
+            stored as int16 in the same SoA layout as ArrayQuaternion.
+        */
+        RawSimdUniquePtr<ArrayReal, MEMCATEGORY_ANIMATION> mCompressedData;
+        uint32              mCompressedStride;
+        /// Combination of CompressedChannels. Only valid when compressed.
+        uint8               mAnimatedChannels;
+        bool                mQuantisedOrientations;
+
+        /// Dequantises ARRAY_PACKED_REALS orientations stored by _compress.
+        static inline void dequantise( const ArrayReal * RESTRICT_ALIAS src,
+                                       ArrayQuaternion &outOrientation );
+
     public:
+        enum CompressedChannels
+        {
+            ChannelPosition     = 1u << 0u,
+            ChannelOrientation  = 1u << 1u,
+            ChannelScale        = 1u << 2u
+        };
+
+        /// Number of ArrayReals used by ARRAY_PACKED_REALS quantised orientations.
+        static const size_t QuantisedOrientationSize =
+                ( 4u * ARRAY_PACKED_REALS * sizeof(int16) + sizeof(ArrayReal) - 1u ) /
+                sizeof(ArrayReal);
+
         SkeletonTrack( uint32 boneBlockIdx, KfTransformArrayMemoryManager *kfTransformMemoryManager );
         ~SkeletonTrack();
 
@@ -95,6 +147,14 @@ namespace Ogre
         void _setMaxUsedSlot( uint32 slot )
                                         { mUsedSlots = std::max( slot+1, mUsedSlots ); }
 
+        bool isCompressed(void) const                           { return mCompressedData.get() != 0; }
+        /// Returns a combination of CompressedChannels with the channels that change over time.
+        /// Only valid when the track is compressed.
+        uint8 getAnimatedChannels(void) const                   { return mAnimatedChannels; }
+
+        /// Returns the number of bytes used by the keyframes, excluding the KeyFrameRigs.
+        size_t getKeyFrameMemoryUsage(void) const;
+
         const KeyFrameRigVec& getKeyFrames(void) const          { return mKeyFrameRigs; }
         KeyFrameRigVec& _getKeyFrames(void)                     { return mKeyFrameRigs; }
 
@@ -128,6 +188,33 @@ namespace Ogre
             mUsedSlots <= (ARRAY_PACKED_REALS >> 1). Otherwise it does nothing.
         */
         void _bakeUnusedSlots(void);
+
+        /** Retrieves the transform of one of the slots of a keyframe. Works whether
+            the track is compressed or not.
+        @param keyFrameIdx
+            Index to getKeyFrames
+        @param slot
+            Must be in range [0; ARRAY_PACKED_REALS)
+        */
+        void getKeyFrameTransform( size_t keyFrameIdx, size_t slot, Vector3 &outPos,
+                                   Quaternion &outRot, Vector3 &outScale ) const;
+
+        /** Compresses the keyframes, within the given error bounds:
+                1. Channels (position, orientation, scale) that don't change over the whole
+                   track for any of the slots are stored only once.
+                2. Keyframes that can be reproduced by interpolating their neighbours are
+                   removed (greedy curve fitting, checked against the original keyframes).
+                3. Orientations are optionally quantised to 16-bit integers.
+            Compressed tracks are sampled with the same SIMD code, decoding the two
+            surrounding keyframes on the fly.
+        @remarks
+            Must be called after all keyframes have been set and _bakeUnusedSlots has been
+            called, and before any SkeletonAnimation starts using the track, since it
+            invalidates all iterators to getKeyFrames.
+            KeyFrameRig::mBoneTransform is null afterwards; the owner of the
+            KfTransformArrayMemoryManager may release its memory.
+        */
+        void _compress( const SkeletonTrackCompression &settings );
     };
 
     typedef vector<SkeletonTrack>::type SkeletonTrackVec;
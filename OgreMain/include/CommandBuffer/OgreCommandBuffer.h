@@ -108,6 +108,14 @@ namespace Ogre
         /// Executes all the commands in the command buffer. Clears the cmd buffer afterwards
         void execute(void);
 
+        /** Moves all the commands from 'other' to the end of this command buffer.
+            'other' is left empty. Used to stitch together command buffers that
+            were recorded in parallel.
+        @remarks
+            Offsets returned by other->getCommandOffset are no longer valid afterwards.
+        */
+        void append( CommandBuffer *other );
+
         /// Creates/Records a command already casted to the typename.
         /// May invalidate returned pointers from previous calls.
         template <typename T>
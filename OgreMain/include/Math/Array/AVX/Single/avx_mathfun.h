@@ -0,0 +1,279 @@
+/* AVX2 implementation of sin, cos and sincos
+
+   8-wide port of the SSE2 path of sse_mathfun.h (see
+   Math/Array/SSE2/Single/sse_mathfun.h). Only the functions
+   used by MathlibAVX have been ported.
+
+   Based on the corresponding algorithms of the cephes math library
+*/
+
+/* Copyright (C) 2007  Julien Pommier
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+
+  (this is the zlib license)
+*/
+
+#if __OGRE_HAVE_AVX2
+
+#include <immintrin.h>
+
+#ifdef _MSC_VER /* visual c++ */
+# define ALIGN32_BEG __declspec(align(32))
+# define ALIGN32_END
+#else /* gcc or icc */
+# define ALIGN32_BEG
+# define ALIGN32_END __attribute__((aligned(32)))
+#endif
+
+typedef __m256  v8sf; // vector of 8 float (avx)
+typedef __m256i v8si; // vector of 8 int   (avx2)
+
+#define _PS256_CONST(Name, Val)                                            \
+  static const ALIGN32_BEG float _ps256_##Name[8] ALIGN32_END = { Val, Val, Val, Val, Val, Val, Val, Val }
+#define _PI32_CONST256(Name, Val)                                          \
+  static const ALIGN32_BEG int _pi32_256_##Name[8] ALIGN32_END = { Val, Val, Val, Val, Val, Val, Val, Val }
+#define _PS256_CONST_TYPE(Name, Type, Val)                                 \
+  static const ALIGN32_BEG Type _ps256_##Name[8] ALIGN32_END = { Val, Val, Val, Val, Val, Val, Val, Val }
+
+_PS256_CONST(1  , 1.0f);
+_PS256_CONST(0p5, 0.5f);
+
+_PS256_CONST_TYPE(sign_mask, int, static_cast<int>(0x80000000));
+_PS256_CONST_TYPE(inv_sign_mask, int, ~0x80000000);
+
+_PI32_CONST256(1, 1);
+_PI32_CONST256(inv1, ~1);
+_PI32_CONST256(2, 2);
+_PI32_CONST256(4, 4);
+
+_PS256_CONST(minus_cephes_DP1, -0.78515625);
+_PS256_CONST(minus_cephes_DP2, -2.4187564849853515625e-4);
+_PS256_CONST(minus_cephes_DP3, -3.77489497744594108e-8);
+_PS256_CONST(sincof_p0, -1.9515295891E-4);
+_PS256_CONST(sincof_p1,  8.3321608736E-3);
+_PS256_CONST(sincof_p2, -1.6666654611E-1);
+_PS256_CONST(coscof_p0,  2.443315711809948E-005);
+_PS256_CONST(coscof_p1, -1.388731625493765E-003);
+_PS256_CONST(coscof_p2,  4.166664568298827E-002);
+_PS256_CONST(cephes_FOPI, 1.27323954473516); // 4 / M_PI
+
+/* evaluation of 8 sines at once. See sin_ps in sse_mathfun.h
+   for the details; the algorithm is exactly the same, but the
+   polynomials are evaluated with fused multiply-add.
+*/
+inline v8sf sin256_ps(v8sf x) { // any x
+  v8sf sign_bit, y;
+  v8si emm0, emm2;
+
+  sign_bit = x;
+  /* take the absolute value */
+  x = _mm256_and_ps(x, *(const v8sf*)_ps256_inv_sign_mask);
+  /* extract the sign bit (upper one) */
+  sign_bit = _mm256_and_ps(sign_bit, *(const v8sf*)_ps256_sign_mask);
+
+  /* scale by 4/Pi */
+  y = _mm256_mul_ps(x, *(const v8sf*)_ps256_cephes_FOPI);
+
+  /* store the integer part of y in emm2 */
+  emm2 = _mm256_cvttps_epi32(y);
+  /* j=(j+1) & (~1) (see the cephes sources) */
+  emm2 = _mm256_add_epi32(emm2, *(const v8si*)_pi32_256_1);
+  emm2 = _mm256_and_si256(emm2, *(const v8si*)_pi32_256_inv1);
+  y = _mm256_cvtepi32_ps(emm2);
+
+  /* get the swap sign flag */
+  emm0 = _mm256_and_si256(emm2, *(const v8si*)_pi32_256_4);
+  emm0 = _mm256_slli_epi32(emm0, 29);
+  /* get the polynom selection mask
+     there is one polynom for 0 <= x <= Pi/4
+     and another one for Pi/4<x<=Pi/2
+
+     Both branches will be computed.
+  */
+  emm2 = _mm256_and_si256(emm2, *(const v8si*)_pi32_256_2);
+  emm2 = _mm256_cmpeq_epi32(emm2, _mm256_setzero_si256());
+
+  v8sf swap_sign_bit = _mm256_castsi256_ps(emm0);
+  v8sf poly_mask = _mm256_castsi256_ps(emm2);
+  sign_bit = _mm256_xor_ps(sign_bit, swap_sign_bit);
+
+  /* The magic pass: "Extended precision modular arithmetic"
+     x = ((x - y * DP1) - y * DP2) - y * DP3; */
+  x = _mm256_fmadd_ps(y, *(const v8sf*)_ps256_minus_cephes_DP1, x);
+  x = _mm256_fmadd_ps(y, *(const v8sf*)_ps256_minus_cephes_DP2, x);
+  x = _mm256_fmadd_ps(y, *(const v8sf*)_ps256_minus_cephes_DP3, x);
+
+  /* Evaluate the first polynom  (0 <= x <= Pi/4) */
+  v8sf z = _mm256_mul_ps(x,x);
+
+  y = _mm256_fmadd_ps(*(const v8sf*)_ps256_coscof_p0, z, *(const v8sf*)_ps256_coscof_p1);
+  y = _mm256_fmadd_ps(y, z, *(const v8sf*)_ps256_coscof_p2);
+  y = _mm256_mul_ps(y, z);
+  y = _mm256_mul_ps(y, z);
+  y = _mm256_fnmadd_ps(z, *(const v8sf*)_ps256_0p5, y);
+  y = _mm256_add_ps(y, *(const v8sf*)_ps256_1);
+
+  /* Evaluate the second polynom  (Pi/4 <= x <= 0) */
+  v8sf y2 = _mm256_fmadd_ps(*(const v8sf*)_ps256_sincof_p0, z, *(const v8sf*)_ps256_sincof_p1);
+  y2 = _mm256_fmadd_ps(y2, z, *(const v8sf*)_ps256_sincof_p2);
+  y2 = _mm256_mul_ps(y2, z);
+  y2 = _mm256_fmadd_ps(y2, x, x);
+
+  /* select the correct result from the two polynoms */
+  y = _mm256_blendv_ps(y, y2, poly_mask);
+  /* update the sign */
+  y = _mm256_xor_ps(y, sign_bit);
+
+  return y;
+}
+
+/* almost the same as sin256_ps */
+inline v8sf cos256_ps(v8sf x) { // any x
+  v8sf y;
+  v8si emm0, emm2;
+
+  /* take the absolute value */
+  x = _mm256_and_ps(x, *(const v8sf*)_ps256_inv_sign_mask);
+
+  /* scale by 4/Pi */
+  y = _mm256_mul_ps(x, *(const v8sf*)_ps256_cephes_FOPI);
+
+  /* store the integer part of y in emm2 */
+  emm2 = _mm256_cvttps_epi32(y);
+  /* j=(j+1) & (~1) (see the cephes sources) */
+  emm2 = _mm256_add_epi32(emm2, *(const v8si*)_pi32_256_1);
+  emm2 = _mm256_and_si256(emm2, *(const v8si*)_pi32_256_inv1);
+  y = _mm256_cvtepi32_ps(emm2);
+
+  emm2 = _mm256_sub_epi32(emm2, *(const v8si*)_pi32_256_2);
+
+  /* get the swap sign flag */
+  emm0 = _mm256_andnot_si256(emm2, *(const v8si*)_pi32_256_4);
+  emm0 = _mm256_slli_epi32(emm0, 29);
+  /* get the polynom selection mask */
+  emm2 = _mm256_and_si256(emm2, *(const v8si*)_pi32_256_2);
+  emm2 = _mm256_cmpeq_epi32(emm2, _mm256_setzero_si256());
+
+  v8sf sign_bit = _mm256_castsi256_ps(emm0);
+  v8sf poly_mask = _mm256_castsi256_ps(emm2);
+
+  /* The magic pass: "Extended precision modular arithmetic"
+     x = ((x - y * DP1) - y * DP2) - y * DP3; */
+  x = _mm256_fmadd_ps(y, *(const v8sf*)_ps256_minus_cephes_DP1, x);
+  x = _mm256_fmadd_ps(y, *(const v8sf*)_ps256_minus_cephes_DP2, x);
+  x = _mm256_fmadd_ps(y, *(const v8sf*)_ps256_minus_cephes_DP3, x);
+
+  /* Evaluate the first polynom  (0 <= x <= Pi/4) */
+  v8sf z = _mm256_mul_ps(x,x);
+
+  y = _mm256_fmadd_ps(*(const v8sf*)_ps256_coscof_p0, z, *(const v8sf*)_ps256_coscof_p1);
+  y = _mm256_fmadd_ps(y, z, *(const v8sf*)_ps256_coscof_p2);
+  y = _mm256_mul_ps(y, z);
+  y = _mm256_mul_ps(y, z);
+  y = _mm256_fnmadd_ps(z, *(const v8sf*)_ps256_0p5, y);
+  y = _mm256_add_ps(y, *(const v8sf*)_ps256_1);
+
+  /* Evaluate the second polynom  (Pi/4 <= x <= 0) */
+  v8sf y2 = _mm256_fmadd_ps(*(const v8sf*)_ps256_sincof_p0, z, *(const v8sf*)_ps256_sincof_p1);
+  y2 = _mm256_fmadd_ps(y2, z, *(const v8sf*)_ps256_sincof_p2);
+  y2 = _mm256_mul_ps(y2, z);
+  y2 = _mm256_fmadd_ps(y2, x, x);
+
+  /* select the correct result from the two polynoms */
+  y = _mm256_blendv_ps(y, y2, poly_mask);
+  /* update the sign */
+  y = _mm256_xor_ps(y, sign_bit);
+
+  return y;
+}
+
+/* since sin256_ps and cos256_ps are almost identical, sincos256_ps could replace both of them..
+   it is almost as fast, and gives you a free cosine with your sine */
+inline void sincos256_ps(v8sf x, v8sf *s, v8sf *c) {
+  v8sf sign_bit_sin, y;
+  v8si emm0, emm2, emm4;
+
+  sign_bit_sin = x;
+  /* take the absolute value */
+  x = _mm256_and_ps(x, *(const v8sf*)_ps256_inv_sign_mask);
+  /* extract the sign bit (upper one) */
+  sign_bit_sin = _mm256_and_ps(sign_bit_sin, *(const v8sf*)_ps256_sign_mask);
+
+  /* scale by 4/Pi */
+  y = _mm256_mul_ps(x, *(const v8sf*)_ps256_cephes_FOPI);
+
+  /* store the integer part of y in emm2 */
+  emm2 = _mm256_cvttps_epi32(y);
+
+  /* j=(j+1) & (~1) (see the cephes sources) */
+  emm2 = _mm256_add_epi32(emm2, *(const v8si*)_pi32_256_1);
+  emm2 = _mm256_and_si256(emm2, *(const v8si*)_pi32_256_inv1);
+  y = _mm256_cvtepi32_ps(emm2);
+
+  emm4 = emm2;
+
+  /* get the swap sign flag for the sine */
+  emm0 = _mm256_and_si256(emm2, *(const v8si*)_pi32_256_4);
+  emm0 = _mm256_slli_epi32(emm0, 29);
+  v8sf swap_sign_bit_sin = _mm256_castsi256_ps(emm0);
+
+  /* get the polynom selection mask for the sine*/
+  emm2 = _mm256_and_si256(emm2, *(const v8si*)_pi32_256_2);
+  emm2 = _mm256_cmpeq_epi32(emm2, _mm256_setzero_si256());
+  v8sf poly_mask = _mm256_castsi256_ps(emm2);
+
+  /* The magic pass: "Extended precision modular arithmetic"
+     x = ((x - y * DP1) - y * DP2) - y * DP3; */
+  x = _mm256_fmadd_ps(y, *(const v8sf*)_ps256_minus_cephes_DP1, x);
+  x = _mm256_fmadd_ps(y, *(const v8sf*)_ps256_minus_cephes_DP2, x);
+  x = _mm256_fmadd_ps(y, *(const v8sf*)_ps256_minus_cephes_DP3, x);
+
+  /* get the sign flag for the cosine */
+  emm4 = _mm256_sub_epi32(emm4, *(const v8si*)_pi32_256_2);
+  emm4 = _mm256_andnot_si256(emm4, *(const v8si*)_pi32_256_4);
+  emm4 = _mm256_slli_epi32(emm4, 29);
+  v8sf sign_bit_cos = _mm256_castsi256_ps(emm4);
+
+  sign_bit_sin = _mm256_xor_ps(sign_bit_sin, swap_sign_bit_sin);
+
+  /* Evaluate the first polynom  (0 <= x <= Pi/4) */
+  v8sf z = _mm256_mul_ps(x,x);
+
+  y = _mm256_fmadd_ps(*(const v8sf*)_ps256_coscof_p0, z, *(const v8sf*)_ps256_coscof_p1);
+  y = _mm256_fmadd_ps(y, z, *(const v8sf*)_ps256_coscof_p2);
+  y = _mm256_mul_ps(y, z);
+  y = _mm256_mul_ps(y, z);
+  y = _mm256_fnmadd_ps(z, *(const v8sf*)_ps256_0p5, y);
+  y = _mm256_add_ps(y, *(const v8sf*)_ps256_1);
+
+  /* Evaluate the second polynom  (Pi/4 <= x <= 0) */
+  v8sf y2 = _mm256_fmadd_ps(*(const v8sf*)_ps256_sincof_p0, z, *(const v8sf*)_ps256_sincof_p1);
+  y2 = _mm256_fmadd_ps(y2, z, *(const v8sf*)_ps256_sincof_p2);
+  y2 = _mm256_mul_ps(y2, z);
+  y2 = _mm256_fmadd_ps(y2, x, x);
+
+  /* select the correct result from the two polynoms */
+  v8sf ysin = _mm256_blendv_ps(y, y2, poly_mask);
+  v8sf ycos = _mm256_blendv_ps(y2, y, poly_mask);
+
+  /* update the sign */
+  *s = _mm256_xor_ps(ysin, sign_bit_sin);
+  *c = _mm256_xor_ps(ycos, sign_bit_cos);
+}
+
+#endif
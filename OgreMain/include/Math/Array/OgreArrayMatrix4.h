@@ -34,6 +34,8 @@ THE SOFTWARE.
 #if OGRE_CPU == OGRE_CPU_X86 && OGRE_USE_SIMD == 1
     #if OGRE_DOUBLE_PRECISION == 1
         #include "SSE2/Double/OgreArrayMatrix4.h"
+    #elif OGRE_USE_SIMD_AVX2 == 1
+        #include "AVX/Single/OgreArrayMatrix4.h"
     #else
         #include "SSE2/Single/OgreArrayMatrix4.h"
     #endif
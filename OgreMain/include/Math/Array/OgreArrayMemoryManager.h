@@ -313,6 +313,7 @@ namespace Ogre
             WorldMat,
             InheritOrientation,
             InheritScale,
+            DirtyFlags,
             NumMemoryTypes
         };
 
@@ -353,6 +354,9 @@ namespace Ogre
             Number of Nodes in this depth level
         */
         size_t getFirstNode( Transform &outTransform );
+
+        /// Resets Transform::mDirtyFlags of all nodes to 0.
+        void clearDirtyFlags(void);
     };
 
 
@@ -388,6 +392,7 @@ namespace Ogre
             VisibilityFlags,
             QueryFlags,
             LightMask,
+            DirtyFlags,
             NumMemoryTypes
         };
 
@@ -34,13 +34,19 @@ THE SOFTWARE.
 #if OGRE_CPU == OGRE_CPU_X86 && OGRE_USE_SIMD == 1
     #if OGRE_DOUBLE_PRECISION == 1
         #include "SSE2/Double/OgreMathlibSSE2.h"
+    #elif OGRE_USE_SIMD_AVX2 == 1
+        #include "AVX/Single/OgreMathlibAVX.h"
     #else
         #include "SSE2/Single/OgreMathlibSSE2.h"
     #endif
 
 namespace Ogre
 {
+#if OGRE_USE_SIMD_AVX2 == 1 && OGRE_DOUBLE_PRECISION == 0
+    typedef MathlibAVX Mathlib;
+#else
     typedef MathlibSSE2 Mathlib;
+#endif
 }
 #elif OGRE_CPU == OGRE_CPU_ARM && OGRE_USE_SIMD == 1
     #if OGRE_DOUBLE_PRECISION == 1
@@ -194,6 +194,11 @@ namespace Ogre
         /// @copydoc ArrayMemoryManager::shrinkToFit
         void shrinkToFit(void);
 
+        /** Resets the dirty flags of all nodes (see Transform::mDirtyFlags).
+            Called by SceneManager once both the transforms and the bounds are up to date.
+        */
+        void _clearDirtyFlags(void);
+
         /** Retrieves the number of depth levels that have been created.
         @remarks
             The return value is equal or below mMemoryManagers.size(), you should cache
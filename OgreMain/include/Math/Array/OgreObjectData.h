@@ -100,6 +100,12 @@ namespace Ogre
         */
         uint32      * RESTRICT_ALIAS    mLightMask;
 
+        /** Ours is mDirtyFlags[mIndex]. Non-zero when the local bounds changed (or we
+            were attached to a different node) and mWorldAabb must be recomputed even if
+            the parent node didn't move. @see MovableObject::_notifyLocalAabbDirty
+        */
+        uint8       * RESTRICT_ALIAS    mDirtyFlags;
+
         ObjectData() :
             mIndex( 0 ),
             mParents( 0 ),
@@ -109,7 +115,8 @@ namespace Ogre
             mDistanceToCamera( 0 ),
             mVisibilityFlags( 0 ),
             mQueryFlags( 0 ),
-            mLightMask( 0 )
+            mLightMask( 0 ),
+            mDirtyFlags( 0 )
         {
             mUpperDistance[0] = 0;
             mUpperDistance[1] = 0;
@@ -136,6 +143,7 @@ namespace Ogre
             mVisibilityFlags[mIndex]    = inCopy.mVisibilityFlags[inCopy.mIndex];
             mQueryFlags[mIndex]         = inCopy.mQueryFlags[inCopy.mIndex];
             mLightMask[mIndex]          = inCopy.mLightMask[inCopy.mIndex];
+            mDirtyFlags[mIndex]         = 1u;
         }
 
         /** Advances all pointers to the next pack, i.e. if we're processing 4
@@ -155,6 +163,7 @@ namespace Ogre
             mVisibilityFlags    += ARRAY_PACKED_REALS;
             mQueryFlags         += ARRAY_PACKED_REALS;
             mLightMask          += ARRAY_PACKED_REALS;
+            mDirtyFlags         += ARRAY_PACKED_REALS;
         }
 
         void advancePack( size_t numAdvance )
@@ -171,6 +180,7 @@ namespace Ogre
             mVisibilityFlags    += ARRAY_PACKED_REALS * numAdvance;
             mQueryFlags         += ARRAY_PACKED_REALS * numAdvance;
             mLightMask          += ARRAY_PACKED_REALS * numAdvance;
+            mDirtyFlags         += ARRAY_PACKED_REALS * numAdvance;
         }
 
         /** Advances all pointers needed by MovableObject::updateAllBounds to the next pack,
@@ -186,6 +196,7 @@ namespace Ogre
             ++mWorldAabb;
             mLocalRadius        += ARRAY_PACKED_REALS;
             mWorldRadius        += ARRAY_PACKED_REALS;
+            mDirtyFlags         += ARRAY_PACKED_REALS;
         }
 
         /** Advances all pointers needed by MovableObject::cullFrustum to the next pack,
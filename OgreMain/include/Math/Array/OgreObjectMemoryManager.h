@@ -32,6 +32,7 @@ THE SOFTWARE.
 #include "Math/Array/OgreArrayMemoryManager.h"
 
 #include "Math/Array/OgreTransform.h"
+#include "OgreCullingHierarchy.h"
 
 namespace Ogre
 {
@@ -56,9 +57,15 @@ namespace Ogre
     class _OgreExport ObjectMemoryManager : ArrayMemoryManager::RebaseListener
     {
         typedef vector<ObjectDataArrayMemoryManager>::type ArrayMemoryManagerVec;
+        typedef vector<CullingHierarchy>::type CullingHierarchyVec;
+
         /// ArrayMemoryManagers grouped by hierarchy depth
         ArrayMemoryManagerVec                   mMemoryManagers;
 
+        /// One per render queue, parallel to mMemoryManagers.
+        /// @see SceneManager::setCullingHierarchyEnabled
+        CullingHierarchyVec                     mCullingHierarchies;
+
         /// Tracks total number of objects in all render queues.
         size_t                                  mTotalObjects;
 
@@ -172,6 +179,18 @@ namespace Ogre
         /// Returns the pointer to the dummy node (useful when detaching)
         SceneNode* _getDummyNode() const                    { return mDummyNode; }
 
+        /// Returns the owner of the unused slots
+        MovableObject* _getDummyObject() const;
+
+        /// Returns the culling hierarchy of the given render queue. It is only kept up
+        /// to date when SceneManager::setCullingHierarchyEnabled is on.
+        CullingHierarchy& _getCullingHierarchy( size_t renderQueue )
+                                                            { return mCullingHierarchies[renderQueue]; }
+
+        /// Returns true if the culling hierarchy of any render queue with objects needs to be
+        /// built again, i.e. because objects were created, moved or defragmented.
+        bool _isCullingHierarchyDirty() const;
+
         /** Retrieves a ObjectData pointing to the first MovableObject in the given render queue
         @param outObjectData
             [out] ObjectData with filled pointers to the first MovableObject in this depth
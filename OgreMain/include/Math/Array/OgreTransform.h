@@ -36,6 +36,16 @@ namespace Ogre
     /** Represents the transform of a single object, arranged in SoA (Structure of Arrays) */
     struct Transform
     {
+        enum DirtyFlags
+        {
+            /// Position, orientation, scale or the inherit flags changed since the last
+            /// update. Set by the Node setters.
+            DirtyLocal      = 1u << 0u,
+            /// The derived transform was recomputed in this update, thus children and
+            /// attached objects must be updated too. Set by Node::updateAllTransforms.
+            DirtyDerived    = 1u << 1u
+        };
+
         /// Which of the packed values is ours. Value in range [0; 4) for SSE2
         unsigned char   mIndex;
 
@@ -74,6 +84,12 @@ namespace Ogre
         /// Ours is mInheritScale[mIndex]
         bool    * RESTRICT_ALIAS mInheritScale;
 
+        /** Combination of DirtyFlags. Ours is mDirtyFlags[mIndex]
+            Lets Node::updateAllTransforms and MovableObject::updateDirtyBounds
+            skip the blocks where nothing changed.
+        */
+        uint8   * RESTRICT_ALIAS mDirtyFlags;
+
         Transform() :
             mIndex( 0 ),
             mParents( 0 ),
@@ -86,7 +102,8 @@ namespace Ogre
             mDerivedScale( 0 ),
             mDerivedTransform( 0 ),
             mInheritOrientation( 0 ),
-            mInheritScale( 0 )
+            mInheritScale( 0 ),
+            mDirtyFlags( 0 )
         {
         }
 
@@ -138,6 +155,9 @@ namespace Ogre
 
             mInheritOrientation[mIndex] = inCopy.mInheritOrientation[inCopy.mIndex];
             mInheritScale[mIndex]       = inCopy.mInheritScale[inCopy.mIndex];
+
+            //We've probably been copied because our parent or depth changed
+            mDirtyFlags[mIndex]         = inCopy.mDirtyFlags[inCopy.mIndex] | DirtyLocal;
         }
 
         /** Rebases all the pointers from our SoA structs so that they point to a new location
@@ -174,6 +194,8 @@ namespace Ogre
                                     newBasePtrs[NodeArrayMemoryManager::InheritOrientation] + diff );
             mInheritScale       = reinterpret_cast<bool*>(
                                     newBasePtrs[NodeArrayMemoryManager::InheritScale] + diff );
+            mDirtyFlags         = reinterpret_cast<uint8*>(
+                                    newBasePtrs[NodeArrayMemoryManager::DirtyFlags] + diff );
         }
 
         /** Advances all pointers to the next pack, i.e. if we're processing 4 elements at a time, move to
@@ -192,6 +214,7 @@ namespace Ogre
             mDerivedTransform   += ARRAY_PACKED_REALS;
             mInheritOrientation += ARRAY_PACKED_REALS;
             mInheritScale       += ARRAY_PACKED_REALS;
+            mDirtyFlags         += ARRAY_PACKED_REALS;
         }
 
         void advancePack( size_t numAdvance )
@@ -207,6 +230,7 @@ namespace Ogre
             mDerivedTransform   += ARRAY_PACKED_REALS * numAdvance;
             mInheritOrientation += ARRAY_PACKED_REALS * numAdvance;
             mInheritScale       += ARRAY_PACKED_REALS * numAdvance;
+            mDirtyFlags         += ARRAY_PACKED_REALS * numAdvance;
         }
     };
 }
@@ -144,6 +144,20 @@ namespace Ogre {
         */
         virtual DataStreamPtr open(const String& filename, bool readOnly = true) = 0;
 
+        /** Open a read-only stream on a given file whose whole contents are directly
+            addressable in memory (i.e. the returned stream is always a MemoryDataStream).
+        @remarks
+            Useful for loaders that want to hand pointers into the file straight to
+            the GPU without intermediate copies.
+            Archives that can memory map their files (e.g. FileSystemArchive) do so; which
+            means pages are only read from disk when touched. The default implementation
+            reads the whole file into memory.
+        @param filename The fully qualified name of the file
+        @return A shared pointer to a MemoryDataStream. If the file is not present,
+            returns a null shared pointer.
+        */
+        virtual DataStreamPtr openMapped(const String& filename);
+
         /** Create a new file (or overwrite one already there). 
         @note If the archive is read-only then this method will fail.
         @param filename The fully qualified name of the file
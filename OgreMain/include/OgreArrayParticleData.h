@@ -0,0 +1,124 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef _OgreArrayParticleData_H_
+#define _OgreArrayParticleData_H_
+
+#include "OgrePrerequisites.h"
+#include "Math/Array/OgreArrayVector3.h"
+#include "ogrestd/list.h"
+#include "ogrestd/vector.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre
+{
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup Effects
+    *  @{
+    */
+
+    /** Structure of arrays copy of the active particles of a ParticleSystem.
+    @remarks
+        Particles are packed in blocks of ARRAY_PACKED_REALS so that ParticleAffectors can
+        process several of them per instruction. See ParticleAffector::_affectArrayParticles.
+        Block i holds the particles [i * ARRAY_PACKED_REALS; (i + 1) * ARRAY_PACKED_REALS)
+    @par
+        The ParticleSystem gathers it from its Particle objects before running the affectors
+        and scatters it back afterwards. The unused lanes of the last block contain copies of
+        the last particle, and can be freely modified since they're never written back.
+    @par
+        mWidth & mHeight contain the particle's own dimensions, or the system's default
+        ones if it doesn't have any. Affectors modifying them must set mDimensionsChanged,
+        in which case all particles get their own dimensions when scattered. Likewise,
+        affectors modifying mRotation must set mRotationChanged.
+    */
+    class _OgreExport ArrayParticleData : public FXAlloc
+    {
+    public:
+        typedef list<Particle*>::type ParticleList;
+
+        ArrayVector3    *mPosition;
+        ArrayVector3    *mDirection;
+        ArrayReal       *mColourR;
+        ArrayReal       *mColourG;
+        ArrayReal       *mColourB;
+        ArrayReal       *mColourA;
+        ArrayReal       *mTimeToLive;
+        ArrayReal       *mTotalTimeToLive;
+        /// In radians
+        ArrayReal       *mRotation;
+        /// In radians/sec
+        ArrayReal       *mRotationSpeed;
+        ArrayReal       *mWidth;
+        ArrayReal       *mHeight;
+
+        bool            mDimensionsChanged;
+        bool            mRotationChanged;
+
+    protected:
+        typedef vector<Particle*>::type ParticleVec;
+
+        size_t          mNumParticles;
+        size_t          mCapacity;
+        void            *mMemory;
+        /// Particle each lane was gathered from
+        ParticleVec     mParticles;
+
+        void reserve( size_t numBlocks );
+        void copyLane( size_t srcIdx, size_t dstIdx );
+
+    public:
+        ArrayParticleData();
+        ~ArrayParticleData();
+
+        size_t getNumParticles(void) const      { return mNumParticles; }
+        /// Number of blocks of ARRAY_PACKED_REALS particles to iterate.
+        size_t getNumBlocks(void) const
+        {
+            return (mNumParticles + ARRAY_PACKED_REALS - 1u) / ARRAY_PACKED_REALS;
+        }
+        /// Returns the Particle the given lane was gathered from.
+        Particle* getParticle( size_t idx ) const { return mParticles[idx]; }
+
+        /// Copies the given particles into the arrays.
+        void gather( const ParticleList &particles, Real defaultWidth, Real defaultHeight );
+        /// Writes the arrays back into the Particle objects they were gathered from.
+        void scatter(void);
+
+        /// Moves all particles along their direction: position += direction * timeElapsed
+        void applyMotion( Real timeElapsed );
+    };
+
+    /** @} */
+    /** @} */
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif
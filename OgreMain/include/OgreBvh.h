@@ -0,0 +1,253 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef _OgreBvh_H_
+#define _OgreBvh_H_
+
+#include "OgrePrerequisites.h"
+#include "OgreRay.h"
+#include "Math/Array/OgreArrayRay.h"
+#include "Math/Array/OgreBooleanMask.h"
+#include "Math/Simple/OgreAabb.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre
+{
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup Math
+    *  @{
+    */
+
+    /** Bounding volume hierarchy over arbitrary primitives, for ray casting.
+    @remarks
+        Built top-down with a binned surface area heuristic. Nodes are stored in a flat
+        array; the two children of an inner node are always consecutive. Leaves reference
+        a consecutive range of "slots", and getPrimitiveIndex converts a slot back to the
+        index of the primitive that was passed to build.
+    @par
+        Traversal can be done one ray at a time, or with ARRAY_PACKED_REALS rays at a time
+        (packet traversal) using ArrayRay. Packets work best when rays are coherent (i.e.
+        share origin or direction), but are always correct.
+    @par
+        The leaf test is a functor provided by the caller, so the same structure can be used
+        for triangles (see TriangleBvh) or for object instances (i.e. a top level BVH).
+        It must implement:
+        @code
+            void operator () ( uint32 slot, Real &inOutMaxDistance );      //Ray version
+            void operator () ( uint32 slot, ArrayReal &inOutMaxDistance ); //ArrayRay version
+        @endcode
+        and lower inOutMaxDistance when it finds a closer hit.
+    */
+    class _OgreExport Bvh : public UtilityAlloc
+    {
+    public:
+        /** The bounds are slightly bigger than the primitives they contain. Axis aligned
+            rays get a clamped inverse direction (see MinDirection), so one lying exactly
+            on a face of a tight box would be told it leaves the box at t = 0.
+        */
+        struct Node
+        {
+            Vector3 vMin;
+            /// Index of the first child if this is an inner node (the second child is
+            /// firstIdx + 1). Index of the first slot if this is a leaf.
+            uint32  firstIdx;
+            Vector3 vMax;
+            /// 0 for inner nodes.
+            uint32  numPrimitives;
+        };
+        typedef vector<Node>::type NodeVec;
+
+        /// Trees are never deeper than this.
+        static const size_t MaxDepth = 64u;
+        /// Ray direction components closer to 0 than this are clamped to it during traversal.
+        static const Real MinDirection;
+
+    protected:
+        NodeVec             mNodes;
+        /// Slot -> primitive index
+        FastArray<uint32>   mPrimitiveIndices;
+
+        /**
+        @param primMin
+            Array with the minimum corner of each primitive's bounds.
+        @param primMax
+            Array with the maximum corner of each primitive's bounds.
+        */
+        void buildFromBounds( const Vector3 *primMin, const Vector3 *primMax,
+                              size_t numPrimitives, uint32 maxPrimitivesPerLeaf );
+
+        static inline bool intersects( const Node &node, const Vector3 &origin,
+                                       const Vector3 &invDir, Real maxDistance, Real &outTNear );
+        static inline ArrayMaskR intersects( const Node &node, const ArrayVector3 &origin,
+                                             const ArrayVector3 &invDir, ArrayReal maxDistance,
+                                             ArrayReal &outTNear );
+        /// 1 / dir, without infinities (see MinDirection).
+        static inline Vector3 getSafeInvDirection( const Vector3 &dir );
+        static inline ArrayVector3 getSafeInvDirection( const ArrayVector3 &dir );
+        /// Smallest tNear among the lanes set in mask
+        static inline Real getClosestLane( ArrayReal tNear, ArrayMaskR mask );
+
+    public:
+        Bvh();
+        virtual ~Bvh();
+
+        /** Builds the hierarchy. Previous contents are discarded.
+        @param primitiveAabbs
+            Bounds of each primitive.
+        @param numPrimitives
+            Number of elements in primitiveAabbs.
+        @param maxPrimitivesPerLeaf
+            Leaves are always split when they hold more primitives than this, unless their
+            centroids are all the same. Smaller leaves are split only if the SAH says so.
+        */
+        void build( const Aabb *primitiveAabbs, size_t numPrimitives,
+                    uint32 maxPrimitivesPerLeaf = 4u );
+
+        void clear(void);
+
+        bool isEmpty(void) const                            { return mNodes.empty(); }
+        const NodeVec& getNodes(void) const                 { return mNodes; }
+        uint32 getPrimitiveIndex( uint32 slot ) const       { return mPrimitiveIndices[slot]; }
+        /// Bounds of the whole hierarchy. Undefined if empty.
+        Aabb getAabb(void) const;
+
+        /** Finds all leaves hit by the ray closer than inOutMaxDistance, and
+            calls leafTest on each of their slots. Closest nodes are visited first.
+        */
+        template <typename T>
+        void traverse( const Ray &ray, Real &inOutMaxDistance, T &leafTest ) const;
+
+        /** Packet version. Lanes with a negative inOutMaxDistance are inactive.
+            The directions don't need to be normalized.
+        */
+        template <typename T>
+        void traverse( const ArrayRay &rays, ArrayReal &inOutMaxDistance, T &leafTest ) const;
+    };
+
+    /** BVH over a triangle mesh, usually in mesh space.
+    @remarks
+        The triangle data is copied and reordered so that the triangles referenced by
+        each leaf are contiguous in memory, thus the source mesh can be freed afterwards.
+    @par
+        positiveSide & negativeSide behave as in Math::intersects: the positive side
+        is the one the counter clockwise winding faces.
+    */
+    class _OgreExport TriangleBvh : public Bvh
+    {
+    public:
+        struct Hit
+        {
+            Real    distance;
+            /// Index of the triangle as passed to build (i.e. index in the index buffer / 3).
+            uint32  triangleIdx;
+            /// Barycentric coordinates of the hit point, relative to vertices 1 and 2.
+            Real    u;
+            Real    v;
+        };
+
+    protected:
+        /// Per slot: vertex 0, edge 0 -> 1, edge 0 -> 2
+        vector<Vector3>::type   mTriangles;
+
+    public:
+        virtual ~TriangleBvh();
+
+        /** Builds the BVH from a triangle list.
+        @param vertexData
+            Positions (3 floats each).
+        @param vertexStride
+            Distance between two consecutive positions, in floats. Must be >= 3.
+        @param indexData
+            Index buffer. Can be null, in which case every three consecutive
+            vertices form a triangle.
+        @param numIndices
+            Number of indices. Or number of vertices if indexData is null.
+        @param indices16bit
+            Whether indexData is 16 bit or 32 bit.
+        @param maxTrianglesPerLeaf
+            See Bvh::build
+        */
+        void build( const float *vertexData, size_t vertexStride,
+                    const void *indexData, size_t numIndices, bool indices16bit,
+                    uint32 maxTrianglesPerLeaf = 4u );
+
+        /** Builds the BVH from the positions of a VAO (using its index buffer if it has one).
+        @remarks
+            Buffers without a shadow copy will be downloaded from the GPU, which stalls.
+        @return
+            False if the VAO is not a triangle list, or has no positions. The BVH is left
+            empty in that case.
+        */
+        bool build( VertexArrayObject *vao, uint32 maxTrianglesPerLeaf = 4u );
+
+        size_t getNumTriangles(void) const          { return mPrimitiveIndices.size(); }
+
+        /** Returns the vertices of the triangle stored in the given slot. Slots are in BVH
+            order, not in the order passed to build; the winding is preserved.
+        @param slot
+            Must be in range [0; getNumTriangles())
+        */
+        void getTriangle( size_t slot, Vector3 &outV0, Vector3 &outV1, Vector3 &outV2 ) const
+        {
+            outV0 = mTriangles[slot * 3u + 0u];
+            outV1 = outV0 + mTriangles[slot * 3u + 1u];
+            outV2 = outV0 + mTriangles[slot * 3u + 2u];
+        }
+
+        /** Finds the closest triangle hit by the ray, that is closer than maxDistance.
+        @return
+            True if a triangle was hit, in which case outHit is filled.
+        */
+        bool raycast( const Ray &ray, Real maxDistance, bool positiveSide, bool negativeSide,
+                      Hit &outHit ) const;
+
+        /** Packet version. Lanes with a negative inOutDistance are ignored.
+        @param inOutDistance
+            In: maximum distance per ray. Out: distance to the closest hit for the rays
+            that hit something closer; unmodified for the rest.
+        @param outTriangleIdx
+            Triangle index for each ray that got a closer hit. Lanes without hits are
+            left untouched.
+        @return
+            A bitmask with the lanes that got a closer hit.
+        */
+        uint32 raycast( const ArrayRay &rays, ArrayReal &inOutDistance,
+                        bool positiveSide, bool negativeSide,
+                        uint32 outTriangleIdx[ARRAY_PACKED_REALS] ) const;
+    };
+
+    /** @} */
+    /** @} */
+}
+
+#include "OgreBvh.inl"
+
+#include "OgreHeaderSuffix.h"
+
+#endif
@@ -0,0 +1,265 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+namespace Ogre
+{
+    inline bool Bvh::intersects( const Node &node, const Vector3 &origin, const Vector3 &invDir,
+                                 Real maxDistance, Real &outTNear )
+    {
+        Real tNear = 0;
+        Real tFar  = maxDistance;
+
+        for( size_t i=0; i<3u; ++i )
+        {
+            Real t0 = (node.vMin[i] - origin[i]) * invDir[i];
+            Real t1 = (node.vMax[i] - origin[i]) * invDir[i];
+            if( t0 > t1 )
+                std::swap( t0, t1 );
+            tNear = t0 > tNear ? t0 : tNear;
+            tFar  = t1 < tFar ? t1 : tFar;
+        }
+
+        outTNear = tNear;
+        return tNear <= tFar;
+    }
+    //-----------------------------------------------------------------------------------
+    inline ArrayMaskR Bvh::intersects( const Node &node, const ArrayVector3 &origin,
+                                       const ArrayVector3 &invDir, ArrayReal maxDistance,
+                                       ArrayReal &outTNear )
+    {
+        ArrayVector3 vMin, vMax;
+        vMin.setAll( node.vMin );
+        vMax.setAll( node.vMax );
+
+        ArrayVector3 intersectAtMinPlane = (vMin - origin) * invDir;
+        ArrayVector3 intersectAtMaxPlane = (vMax - origin) * invDir;
+
+        ArrayVector3 minIntersect = intersectAtMinPlane;
+        minIntersect.makeFloor( intersectAtMaxPlane );
+        ArrayVector3 maxIntersect = intersectAtMinPlane;
+        maxIntersect.makeCeil( intersectAtMaxPlane );
+
+        //tNear = max( minIntersect.x, minIntersect.y, minIntersect.z, 0 )
+        //tFar  = min( maxIntersect.x, maxIntersect.y, maxIntersect.z, maxDistance )
+        ArrayReal tNear = Mathlib::Max( Mathlib::Max( minIntersect.mChunkBase[0],
+                                                      minIntersect.mChunkBase[1] ),
+                                        Mathlib::Max( minIntersect.mChunkBase[2],
+                                                      ARRAY_REAL_ZERO ) );
+        ArrayReal tFar  = Mathlib::Min( Mathlib::Min( maxIntersect.mChunkBase[0],
+                                                      maxIntersect.mChunkBase[1] ),
+                                        Mathlib::Min( maxIntersect.mChunkBase[2],
+                                                      maxDistance ) );
+        outTNear = tNear;
+        return Mathlib::CompareLessEqual( tNear, tFar );
+    }
+    //-----------------------------------------------------------------------------------
+    inline Vector3 Bvh::getSafeInvDirection( const Vector3 &dir )
+    {
+        Vector3 retVal;
+        for( size_t i=0; i<3u; ++i )
+        {
+            //Axis aligned rays would get an infinite inverse, and 0 * inf = NaN
+            Real d = dir[i];
+            if( Math::Abs( d ) < MinDirection )
+                d = d >= 0 ? MinDirection : -MinDirection;
+            retVal[i] = 1.0f / d;
+        }
+        return retVal;
+    }
+    //-----------------------------------------------------------------------------------
+    inline ArrayVector3 Bvh::getSafeInvDirection( const ArrayVector3 &dir )
+    {
+        const ArrayReal minDirection = Mathlib::SetAll( MinDirection );
+        const ArrayReal negMinDirection = Mathlib::SetAll( -MinDirection );
+
+        ArrayVector3 safeDir;
+        for( size_t i=0; i<3u; ++i )
+        {
+            const ArrayReal d = dir.mChunkBase[i];
+            const ArrayReal signedMin = Mathlib::CmovRobust(
+                        minDirection, negMinDirection,
+                        Mathlib::CompareGreaterEqual( d, ARRAY_REAL_ZERO ) );
+            safeDir.mChunkBase[i] = Mathlib::CmovRobust(
+                        signedMin, d, Mathlib::CompareLess( Mathlib::Abs4( d ), minDirection ) );
+        }
+
+        return Mathlib::ONE / safeDir;
+    }
+    //-----------------------------------------------------------------------------------
+    inline Real Bvh::getClosestLane( ArrayReal tNear, ArrayMaskR mask )
+    {
+        OGRE_ALIGNED_DECL( Real, scalarTNear[ARRAY_PACKED_REALS], OGRE_SIMD_ALIGNMENT );
+        //Bitwise select; tNear may be huge and Cmov4's arithmetic select breaks with inf
+        CastArrayToReal( scalarTNear, Mathlib::CmovRobust( tNear, Mathlib::MAX_POS, mask ) );
+
+        Real retVal = scalarTNear[0];
+        for( size_t i=1; i<ARRAY_PACKED_REALS; ++i )
+            retVal = std::min( retVal, scalarTNear[i] );
+        return retVal;
+    }
+    //-----------------------------------------------------------------------------------
+    template <typename T>
+    void Bvh::traverse( const Ray &ray, Real &inOutMaxDistance, T &leafTest ) const
+    {
+        if( mNodes.empty() )
+            return;
+
+        const Vector3 origin = ray.getOrigin();
+        const Vector3 invDir = getSafeInvDirection( ray.getDirection() );
+
+        uint32 stack[MaxDepth];
+        Real stackTNear[MaxDepth];
+        size_t stackSize = 0;
+
+        const Node * RESTRICT_ALIAS nodes = &mNodes[0];
+
+        Real tNear;
+        if( !intersects( nodes[0], origin, invDir, inOutMaxDistance, tNear ) )
+            return;
+
+        uint32 nodeIdx = 0;
+        bool keepGoing = true;
+
+        while( keepGoing )
+        {
+            const Node &node = nodes[nodeIdx];
+            bool pop = true;
+
+            if( node.numPrimitives )
+            {
+                const uint32 slotEnd = node.firstIdx + node.numPrimitives;
+                for( uint32 slot=node.firstIdx; slot<slotEnd; ++slot )
+                    leafTest( slot, inOutMaxDistance );
+            }
+            else
+            {
+                Real tNear0, tNear1;
+                const bool hit0 = intersects( nodes[node.firstIdx], origin, invDir,
+                                              inOutMaxDistance, tNear0 );
+                const bool hit1 = intersects( nodes[node.firstIdx + 1u], origin, invDir,
+                                              inOutMaxDistance, tNear1 );
+                if( hit0 && hit1 )
+                {
+                    //Visit the closest first, leave the other for later
+                    const uint32 closest = tNear0 <= tNear1 ? 0u : 1u;
+                    stack[stackSize]        = node.firstIdx + (closest ^ 1u);
+                    stackTNear[stackSize]   = closest ? tNear0 : tNear1;
+                    ++stackSize;
+                    nodeIdx = node.firstIdx + closest;
+                    pop = false;
+                }
+                else if( hit0 || hit1 )
+                {
+                    nodeIdx = node.firstIdx + (hit0 ? 0u : 1u);
+                    pop = false;
+                }
+            }
+
+            if( pop )
+            {
+                //Skip the nodes that are now farther than the closest hit
+                while( stackSize && stackTNear[stackSize - 1u] > inOutMaxDistance )
+                    --stackSize;
+
+                if( stackSize )
+                    nodeIdx = stack[--stackSize];
+                else
+                    keepGoing = false;
+            }
+        }
+    }
+    //-----------------------------------------------------------------------------------
+    template <typename T>
+    void Bvh::traverse( const ArrayRay &rays, ArrayReal &inOutMaxDistance, T &leafTest ) const
+    {
+        if( mNodes.empty() )
+            return;
+
+        const ArrayVector3 invDir = getSafeInvDirection( rays.mDirection );
+
+        uint32 stack[MaxDepth];
+        size_t stackSize = 0;
+
+        const Node * RESTRICT_ALIAS nodes = &mNodes[0];
+
+        ArrayReal tNear;
+        if( !BooleanMask4::getScalarMask( intersects( nodes[0], rays.mOrigin, invDir,
+                                                      inOutMaxDistance, tNear ) ) )
+        {
+            return;
+        }
+
+        uint32 nodeIdx = 0;
+        bool keepGoing = true;
+
+        while( keepGoing )
+        {
+            const Node &node = nodes[nodeIdx];
+            bool pop = true;
+
+            if( node.numPrimitives )
+            {
+                const uint32 slotEnd = node.firstIdx + node.numPrimitives;
+                for( uint32 slot=node.firstIdx; slot<slotEnd; ++slot )
+                    leafTest( slot, inOutMaxDistance );
+            }
+            else
+            {
+                ArrayReal tNear0, tNear1;
+                const ArrayMaskR mask0 = intersects( nodes[node.firstIdx], rays.mOrigin, invDir,
+                                                     inOutMaxDistance, tNear0 );
+                const ArrayMaskR mask1 = intersects( nodes[node.firstIdx + 1u], rays.mOrigin,
+                                                     invDir, inOutMaxDistance, tNear1 );
+                const bool hit0 = BooleanMask4::getScalarMask( mask0 ) != 0;
+                const bool hit1 = BooleanMask4::getScalarMask( mask1 ) != 0;
+
+                if( hit0 && hit1 )
+                {
+                    const uint32 closest = getClosestLane( tNear0, mask0 ) <=
+                                           getClosestLane( tNear1, mask1 ) ? 0u : 1u;
+                    stack[stackSize++] = node.firstIdx + (closest ^ 1u);
+                    nodeIdx = node.firstIdx + closest;
+                    pop = false;
+                }
+                else if( hit0 || hit1 )
+                {
+                    nodeIdx = node.firstIdx + (hit0 ? 0u : 1u);
+                    pop = false;
+                }
+            }
+
+            if( pop )
+            {
+                if( stackSize )
+                    nodeIdx = stack[--stackSize];
+                else
+                    keepGoing = false;
+            }
+        }
+    }
+}
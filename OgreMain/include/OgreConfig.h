@@ -68,6 +68,14 @@ THE SOFTWARE.
 #define OGRE_DOUBLE_PRECISION 0
 #endif
 
+/** If set to 1 (and OGRE_USE_SIMD is 1), ArrayMath on x86 uses AVX2 + FMA with 8 packed
+    floats instead of SSE2 with 4. The resulting binaries won't run on CPUs without AVX2.
+    Ignored when OGRE_DOUBLE_PRECISION is 1.
+*/
+#ifndef OGRE_USE_SIMD_AVX2
+#define OGRE_USE_SIMD_AVX2 0
+#endif
+
 /** Define number of texture coordinate sets allowed per vertex.
 */
 #define OGRE_MAX_TEXTURE_COORD_SETS 8
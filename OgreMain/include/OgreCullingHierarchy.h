@@ -0,0 +1,176 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef _OgreCullingHierarchy_H_
+#define _OgreCullingHierarchy_H_
+
+#include "OgrePrerequisites.h"
+#include "OgreVector3.h"
+#include "OgreFastArray.h"
+#include "Math/Array/OgreObjectData.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre
+{
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup Scene
+    *  @{
+    */
+
+    /** Bounds hierarchy over the SIMD blocks of a single render queue of an ObjectMemoryManager.
+    @remarks
+        Level 0 holds the bounds of each block of ARRAY_PACKED_REALS objects, as they're laid
+        out in memory. Each node in level N + 1 holds the merged bounds of BranchingFactor
+        consecutive nodes from level N. The structure is implicit: there is no sorting and
+        objects never change place because of it, so it can be rebuilt from
+        ObjectData::mWorldAabb every frame at a fraction of the cost of updating the bounds,
+        and the culling output keeps the exact same order as a linear cull.
+    @par
+        Whole subtrees are rejected when they are outside the frustums, thus the cost of
+        culling is proportional to the number of visible blocks, provided the memory layout
+        is spatially coherent (e.g. objects of the same area are created together, which is
+        typical of static geometry). A scene with no coherence still culls correctly, it just
+        doesn't get faster.
+    @par
+        Levels 0 and 1 are built by SceneManager::updateBoundsSlice along with the world
+        bounds; each slice owns whole groups of BranchingFactor blocks.
+        The remaining levels are built afterwards by _updateUpperLevels.
+    */
+    class _OgreExport CullingHierarchy
+    {
+    public:
+        enum
+        {
+            /// Number of children per node. Bounds slices are multiples of this many blocks.
+            BranchingFactor = 16
+        };
+
+        struct Node
+        {
+            Vector3 vMin;
+            Vector3 vMax;
+        };
+        typedef vector<Node>::type NodeVec;
+        typedef vector<NodeVec>::type NodeVecVec;
+
+        /// Consecutive range of blocks that passed the test.
+        struct BlockRange
+        {
+            size_t firstBlock;
+            size_t numBlocks;
+        };
+        typedef FastArray<BlockRange> BlockRangeArray;
+
+    protected:
+        /// mLevels[0] has one node per block. The last level has at most BranchingFactor nodes.
+        NodeVecVec  mLevels;
+        size_t      mNumBlocks;
+        /// False until all levels have been built for the current mNumBlocks.
+        bool        mBuilt;
+
+        enum Visibility
+        {
+            Outside,
+            Partial,
+            Inside
+        };
+
+        static Visibility testNode( const Node &node,
+                                    const Frustum * const *frustums, size_t numFrustums,
+                                    const Frustum * const *cubemapFrustums,
+                                    size_t numCubemapFrustums );
+
+        void collectVisibleBlocks( size_t level, size_t nodeIdx, size_t firstBlock, size_t endBlock,
+                                   const Frustum * const *frustums, size_t numFrustums,
+                                   const Frustum * const *cubemapFrustums,
+                                   size_t numCubemapFrustums,
+                                   BlockRangeArray &outRanges ) const;
+
+        static void addRange( size_t firstBlock, size_t numBlocks, BlockRangeArray &outRanges );
+
+    public:
+        CullingHierarchy();
+
+        /// Prepares the hierarchy to be built for numObjs objects. Must be called before
+        /// _updateBlocks; the hierarchy can't be used until _updateUpperLevels is called.
+        void _resize( size_t numObjs );
+
+        /// Discards the current contents (i.e. because the objects were moved in memory)
+        void _invalidate(void)                      { mBuilt = false; }
+
+        /** Computes the bounds of the given blocks, and the level 1 nodes that cover them.
+        @param objData
+            ObjectData pointing to firstBlock, with up to date world bounds.
+        @param firstBlock
+            Must be a multiple of BranchingFactor.
+        @param numBlocks
+            Must be a multiple of BranchingFactor, unless it reaches the last block.
+        @param dummyObject
+            Owner of the unused slots, which are left out of the bounds.
+        */
+        void _updateBlocks( ObjectData objData, size_t firstBlock, size_t numBlocks,
+                            const MovableObject *dummyObject );
+
+        /// Computes level 2 and above from level 1. After this call, the hierarchy can be used.
+        void _updateUpperLevels(void);
+
+        bool isBuilt(void) const                    { return mBuilt; }
+        size_t getNumBlocks(void) const             { return mNumBlocks; }
+
+        /** Returns the ranges of blocks that may be visible from any of the given frustums or
+            cubemap cameras; the rest are guaranteed not to be. Ranges are returned in order.
+        @remarks
+            Thread safe. Blocks past getNumBlocks (i.e. objects created since the hierarchy
+            was built) are always returned as visible.
+        @param firstBlock
+            First block to consider.
+        @param numBlocks
+            Number of blocks to consider, starting from firstBlock.
+        @param frustums
+            Array of frustums. A block is visible if it's partially inside any of them.
+        @param cubemapFrustums
+            Array of Cameras rendering cubemaps. Like in MovableObject::cullLights, they're
+            treated as a box around the camera of half size getFarClipDistance() * 0.5.
+        @param outRanges [out]
+            Ranges are appended to it.
+        */
+        void collectVisibleBlocks( size_t firstBlock, size_t numBlocks,
+                                   const Frustum * const *frustums, size_t numFrustums,
+                                   const Frustum * const *cubemapFrustums,
+                                   size_t numCubemapFrustums,
+                                   BlockRangeArray &outRanges ) const;
+    };
+
+    /** @} */
+    /** @} */
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif
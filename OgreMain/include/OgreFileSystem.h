@@ -98,6 +98,9 @@ namespace Ogre {
         /// @copydoc Archive::open
         DataStreamPtr open(const String& filename, bool readOnly = true);
 
+        /// @copydoc Archive::openMapped
+        DataStreamPtr openMapped(const String& filename);
+
         /// @copydoc Archive::create
         DataStreamPtr create(const String& filename);
 
@@ -31,6 +31,8 @@ THE SOFTWARE.
 #include "OgreStringVector.h"
 #include "OgreHlmsCommon.h"
 #include "OgreHlmsPso.h"
+#include "Threading/OgreLightweightMutex.h"
+#include "Threading/OgreUniformScalableTask.h"
 #if !OGRE_NO_JSON
     #include "OgreHlmsJson.h"
 #endif
@@ -39,6 +41,7 @@ THE SOFTWARE.
 namespace Ogre
 {
     class CompositorShadowNode;
+    class HlmsDiskCache;
     struct QueuedRenderable;
     typedef vector<Archive*>::type ArchiveVec;
 
@@ -171,6 +174,43 @@ namespace Ogre
         typedef vector<char>::type TextureNameStrings;
         typedef vector<TextureRegs>::type TextureRegsVec;
 
+        /// Shader code waiting to be generated. See setAsyncShaderCompilation.
+        struct PendingShaderCode
+        {
+            ShaderCodeCache codeCache;
+            String          source[NumShaderTypes];
+            bool            compile[NumShaderTypes];
+            bool            syntaxError[NumShaderTypes];
+            /// Properties each stage was parsed with. Only used with the incremental disk cache.
+            HlmsPropertyVec stageProperties[NumShaderTypes];
+            /// The stage was found in the incremental disk cache, and its templates didn't change.
+            bool            stageUpToDate[NumShaderTypes];
+            /// Every stage was found in the incremental disk cache. No need to parse.
+            bool            fromDiskCache;
+
+            PendingShaderCode( const ShaderCodeCache &_codeCache ) :
+                codeCache( _codeCache ), fromDiskCache( false )
+            {
+                for( size_t i=0; i<NumShaderTypes; ++i )
+                {
+                    compile[i] = false;
+                    syntaxError[i] = false;
+                    stageUpToDate[i] = false;
+                }
+            }
+        };
+
+        class ShaderGenerationTask : public UniformScalableTask
+        {
+        public:
+            Hlms *mHlms;
+
+            ShaderGenerationTask( Hlms *hlms ) : mHlms( hlms ) {}
+
+            virtual void execute( size_t threadId, size_t numThreads );
+        };
+
+        typedef vector<PendingShaderCode*>::type PendingShaderCodeVec;
         typedef vector<PassCache>::type PassCacheVec;
         typedef vector<RenderableCache>::type RenderableCacheVec;
         typedef vector<ShaderCodeCache>::type ShaderCodeCacheVec;
@@ -235,6 +275,18 @@ namespace Ogre
         IdString        mTypeName;
         String          mTypeNameStr;
 
+        HlmsDiskCache           *mIncrementalDiskCache;
+
+        bool                    mAsyncShaderCompilation;
+        size_t                  mMaxAsyncShadersPerFrame;
+        PendingShaderCodeVec    mPendingShaderCode;
+        /// Number of entries from mPendingShaderCode being processed by _compilePendingShaders.
+        size_t                  mNumShadersToGenerate;
+        /// Next entry a worker thread will generate. Protected by mShaderGenerationMutex.
+        size_t                  mNextShaderToGenerate;
+        LightweightMutex        mShaderGenerationMutex;
+        ShaderGenerationTask    mShaderGenerationTask;
+
         /** Inserts common properties about the current Renderable,
             such as hlms_skeleton hlms_uv_count, etc
         */
@@ -288,11 +340,26 @@ namespace Ogre
 
         typedef std::vector<Expression> ExpressionVec;
 
-        inline int interpretAsNumberThenAsProperty( const String &argValue ) const;
+        inline int interpretAsNumberThenAsProperty( const String &argValue,
+                                                    const HlmsPropertyVec &properties ) const;
 
         static void copy( String &outBuffer, const SubStringRef &inSubString, size_t length );
         static void repeat( String &outBuffer, const SubStringRef &inSubString, size_t length,
                             size_t passNum, const String &counterVar );
+
+        /// Parser overloads working on the given properties & pieces instead of
+        /// mSetProperties & mPieces. Safe to call from multiple threads as long as
+        /// each thread uses its own containers.
+        bool parseMath( const String &inBuffer, String &outBuffer, HlmsPropertyVec &properties );
+        bool parseForEach( const String &inBuffer, String &outBuffer,
+                           const HlmsPropertyVec &properties ) const;
+        bool parseProperties( String &inBuffer, String &outBuffer,
+                              const HlmsPropertyVec &properties ) const;
+        bool parseUndefPieces( String &inBuffer, String &outBuffer, PiecesMap &pieces );
+        bool collectPieces( const String &inBuffer, String &outBuffer, PiecesMap &pieces );
+        bool insertPieces( String &inBuffer, String &outBuffer, const PiecesMap &pieces ) const;
+        bool parseCounter( const String &inBuffer, String &outBuffer, HlmsPropertyVec &properties );
+
         bool parseMath( const String &inBuffer, String &outBuffer );
         bool parseForEach( const String &inBuffer, String &outBuffer ) const;
         bool parseProperties( String &inBuffer, String &outBuffer ) const;
@@ -315,8 +382,10 @@ namespace Ogre
         /// \@else instead (can only happen if allowsElse=true).
         static bool findBlockEnd( SubStringRef &outSubString, bool &syntaxError, bool allowsElse=false );
 
-        bool evaluateExpression( SubStringRef &outSubString, bool &outSyntaxError ) const;
-        int32 evaluateExpressionRecursive( ExpressionVec &expression, bool &outSyntaxError ) const;
+        bool evaluateExpression( SubStringRef &outSubString, bool &outSyntaxError,
+                                 const HlmsPropertyVec &properties ) const;
+        int32 evaluateExpressionRecursive( ExpressionVec &expression, bool &outSyntaxError,
+                                           const HlmsPropertyVec &properties ) const;
         static size_t evaluateExpressionEnd( const SubStringRef &outSubString );
 
         static void evaluateParamArgs( SubStringRef &outSubString, StringVector &outArgs,
@@ -346,12 +415,56 @@ namespace Ogre
         const HlmsCache* getShaderCache( uint32 hash ) const;
         virtual void clearShaderCache(void);
 
+        void processPieces( Archive *archive, const StringVector &pieceFiles,
+                            HlmsPropertyVec &properties, PiecesMap &pieces );
         void processPieces( Archive *archive, const StringVector &pieceFiles );
         void hashPieceFiles( Archive *archive, const StringVector &pieceFiles,
                              FastArray<uint8> &fileContents ) const;
+        void hashTemplateFiles( ShaderType shaderType, FastArray<uint8> &fileContents ) const;
 
+        void dumpProperties( std::ofstream &outFile, const HlmsPropertyVec &properties,
+                             const PiecesMap &pieces );
         void dumpProperties( std::ofstream &outFile );
 
+        /** Runs the template parser over the shader template of the given stage.
+            Only reads Hlms' state, so it can be called from multiple threads as long
+            as each thread uses its own properties & pieces.
+        @param properties [in/out]
+            Merged properties. Templates may modify them.
+        @param pieces [in/out]
+            Pieces of this stage. Templates may add or remove pieces.
+        @param outSource [out]
+            The generated shader source.
+        @param debugFilenameOutput
+            When not empty, the properties and the generated source are dumped to this file.
+        @param outSyntaxError [out]
+            True if there were syntax errors. Logging them is up to the caller.
+        @return
+            True if the stage must be compiled. False if there is no template for this
+            stage or the template disabled it.
+        */
+        bool generateShaderStage( ShaderType shaderType, HlmsPropertyVec &properties,
+                                  PiecesMap &pieces, String &outSource,
+                                  const String &debugFilenameOutput, bool &outSyntaxError );
+
+        /// Merges the renderable's & pass' properties into mSetProperties and lets
+        /// the listener & derived classes modify them, before generating the shaders.
+        void mergeShaderCacheProperties( uint32 renderableHash, const HlmsCache &passCache,
+                                         const QueuedRenderable &queuedRenderable );
+
+        /** Checks whether the shader code needed by the renderable is in mShaderCodeCache.
+            If not, queues it for generation (unless it already is) and returns false.
+        @remarks
+            The listener's propertiesMergedPreGenerationStep will be called again when
+            the renderable's HlmsCache is finally created.
+        */
+        bool requestShaderCode( uint32 renderableHash, const HlmsCache &passCache,
+                                const QueuedRenderable &queuedRenderable );
+
+        /// Called from each worker thread by _compilePendingShaders.
+        void generatePendingShaderCode(void);
+        void destroyPendingShaders(void);
+
         /** Modifies the PSO's macroblock if there are reasons to do that, and creates
             a strong reference to the macroblock that the PSO will own.
         @param pso [in/out]
@@ -462,6 +575,17 @@ namespace Ogre
         IdString getShaderSyntax(void) const                { return mShaderSyntax; }
 
         void getTemplateChecksum( uint64 outHash[2] ) const;
+        /// Same as getTemplateChecksum, but only covers the template & piece files of one stage.
+        void getTemplateChecksum( ShaderType shaderType, uint64 outHash[2] ) const;
+
+        /** Makes the Hlms look for shader code in the given disk cache before parsing the
+            templates, and append to it the shader code it generates.
+            Use HlmsDiskCache::openIncremental instead of calling this directly.
+        @param diskCache
+            Can be null to detach it.
+        */
+        void _setIncrementalDiskCache( HlmsDiskCache *diskCache );
+        HlmsDiskCache* getIncrementalDiskCache(void) const  { return mIncrementalDiskCache; }
 
         /** Sets the quality of the Hlms. This function is most relevant for mobile and
             almost or completely ignored by Desktop.
@@ -714,11 +838,18 @@ namespace Ogre
             should cast shadows)
         @param casterPass
             True if this pass is the shadow mapping caster pass, false otherwise
+        @param allowPending
+            When true and async shader compilation is enabled (see setAsyncShaderCompilation),
+            shaders that haven't been generated yet are queued for generation instead of
+            being created right away, and null is returned.
         @return
-            Structure containing all necessary shaders
+            Structure containing all necessary shaders.
+            Null if allowPending is true and the shaders aren't ready yet; the caller
+            should skip the renderable.
         */
         const HlmsCache* getMaterial( HlmsCache const *lastReturnedValue, const HlmsCache &passCache,
-                                      const QueuedRenderable &queuedRenderable, bool casterPass );
+                                      const QueuedRenderable &queuedRenderable, bool casterPass,
+                                      bool allowPending=false );
 
         /** Fills the constant buffers. Gets executed right before drawing the mesh.
         @param cache
@@ -748,6 +879,49 @@ namespace Ogre
                                          bool casterPass, uint32 lastCacheHash,
                                          CommandBuffer *commandBuffer ) = 0;
 
+        /** Whether fillBuffersForV2Mt is implemented and can be called concurrently from
+            multiple threads. See RenderQueue::setParallelRecordingThreshold.
+        @remarks
+            Implementations deriving from an Hlms that returns true, but overriding
+            fillBuffersForV2, must override this function too.
+        */
+        virtual bool supportsParallelFillBuffers(void) const        { return false; }
+
+        /** Called from the main thread before fillBuffersForV2Mt gets called from
+            numThreads threads. Each thread must get its own buffers & state.
+        @param numThreads
+            Number of threads that will record. threadIdx will be in range [0; numThreads)
+        @param numRenderablesPerThread
+            Approximate number of renderables each thread will process. Use it as a hint
+            to reserve memory in advance.
+        @param commandBuffer
+            The command buffer the main thread has been recording to. Anything still
+            pending from fillBuffersForV2 must be finished in it.
+        */
+        virtual void _beginParallelFillBuffers( size_t numThreads, size_t numRenderablesPerThread,
+                                                CommandBuffer *commandBuffer ) {}
+
+        /** Same as fillBuffersForV2, but may be called concurrently from multiple threads.
+            Calls with the same threadIdx are never concurrent and are always made in order;
+            each threadIdx records into its own commandBuffer.
+            Only called if supportsParallelFillBuffers returns true.
+        @remarks
+            The HlmsCache must already exist (getMaterial is always called from the main
+            thread) thus no shader may be compiled here. HlmsListener callbacks will also
+            be called from worker threads.
+        */
+        virtual uint32 fillBuffersForV2Mt( size_t threadIdx, const HlmsCache *cache,
+                                           const QueuedRenderable &queuedRenderable,
+                                           bool casterPass, uint32 lastCacheHash,
+                                           CommandBuffer *commandBuffer );
+
+        /** Called from the thread that recorded threadIdx, once it has finished its range.
+            Everything written by that thread must be ready for execution afterwards
+            (i.e. pending commands in commandBuffer completed). The commandBuffer will
+            then be appended to the main one.
+        */
+        virtual void _endParallelFillBuffers( size_t threadIdx, CommandBuffer *commandBuffer ) {}
+
         /// This gets called right before executing the command buffer.
         virtual void preCommandBufferExecution( CommandBuffer *commandBuffer ) {}
         /// This gets called after executing the command buffer.
@@ -776,6 +950,42 @@ namespace Ogre
         void setDebugOutputPath( bool enableDebugOutput, bool outputProperties,
                                  const String &path = BLANKSTRING );
 
+        /** When enabled, shaders needed by render queues that weren't generated yet are
+            queued instead of being generated & compiled on the spot, which causes hitches.
+            Renderables whose shaders are not ready are skipped (not drawn) until they are.
+        @remarks
+            At the end of every frame, the templates of the queued shaders are parsed in
+            parallel by SceneManager's worker threads. The resulting source is then compiled
+            into GPU programs in the main thread, as not every RenderSystem supports
+            doing that from other threads. The PSO is created the next time the renderable
+            is rendered.
+        @par
+            Only renderables in FAST and V1_FAST render queues can be skipped. Everything
+            else (i.e. renderSingleObject) still waits for the shaders to be compiled.
+        @par
+            Parsing from worker threads requires the template & piece files to be
+            readable from multiple threads at the same time (i.e. FileSystem archives,
+            not Zip ones).
+        @param bEnable
+            True to enable. Default is false.
+        @param maxShadersPerFrame
+            Maximum number of shaders to compile per frame. Use it to spread the
+            compilation cost over several frames. 0 means no limit.
+        */
+        void setAsyncShaderCompilation( bool bEnable, size_t maxShadersPerFrame=0 );
+        bool getAsyncShaderCompilation(void) const      { return mAsyncShaderCompilation; }
+
+        /// Returns the number of shaders queued for generation. See setAsyncShaderCompilation.
+        size_t getNumPendingShaders(void) const         { return mPendingShaderCode.size(); }
+
+        /** Generates and compiles the shaders queued by getMaterial.
+            See setAsyncShaderCompilation.
+        @param sceneManager
+            Its worker threads are used to parse the templates.
+            Can be null, in which case everything happens in the calling thread.
+        */
+        void _compilePendingShaders( SceneManager *sceneManager );
+
         /** Sets a listener to extend an existing Hlms implementation's with custom code,
             without having to rewrite it or modify the source code directly.
         @remarks
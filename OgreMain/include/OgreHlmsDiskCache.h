@@ -127,6 +127,32 @@ namespace Ogre
                                     some stalls at runtime, due to the driver translating the Microcode
                                     to the internal ISA.
     @endcode
+
+    @par
+        Incremental mode
+
+        saveTo & loadFrom serialize the whole cache at once, and if the templates changed, all
+        of the preprocessed shaders are thrown away.
+        openIncremental instead attaches the cache to an Hlms and keeps an append-only file open:
+        @code
+            Header      magic, version, OGRE_DEBUG_STR_SIZE, Hlms type, shader profile
+            Record 0    payload size, key, payload
+            Record 1    payload size, key, payload
+            ...
+        @endcode
+        Only the keys are read when opening (records are skipped over), the payload is loaded
+        the first time the Hlms asks for that shader variant. Every newly generated variant
+        is appended to the end of the file, without rewriting it.
+
+        Each payload stores, for each shader stage, the checksum of its template & piece files
+        at the time it was generated, the properties it was parsed with (templates can set
+        properties the following stages see) and its preprocessed source. Thus if a piece file
+        of the pixel shader changes, only the pixel shader is parsed again (plus any following
+        stage whose input properties end up being different); the rest of the stages are still
+        taken from the cache. The updated entry is then appended again.
+
+        The incremental mode only caches the preprocessed shaders (layer 1). PSOs are still
+        created on demand.
     */
     class _OgreExport HlmsDiskCache : public HlmsAlloc
     {
@@ -165,12 +191,34 @@ namespace Ogre
             PsoVec          pso;
         };
 
+        /// Key -> offset of the record's payload in the incremental file
+        typedef map<uint64, size_t>::type IncrementalIndexMap;
+
         bool        mTemplatesOutOfDate;
         Cache       mCache;
         HlmsManager *mHlmsManager;
         String      mShaderProfile;
         uint16      mDebugStrSize;
 
+        Hlms                *mIncrementalHlms;
+        String              mIncrementalFilename;
+        DataStreamPtr       mIncrementalFile;
+        /// Size of the valid portion of the incremental file (i.e. where to append).
+        size_t              mIncrementalFileSize;
+        IncrementalIndexMap mIncrementalIndex;
+        /// Checksum of the template & piece files for each stage, as they currently are.
+        uint64              mStageChecksums[NumShaderTypes][2];
+
+        static uint64 calculateIncrementalKey( const Hlms::RenderableCache &mergedCache );
+
+        /// Opens the incremental file. If truncate is true, its contents are discarded.
+        void openIncrementalFile( bool truncate );
+        void writeIncrementalHeader(void);
+        /// Returns false if the header can't be used by the current Hlms / build.
+        bool readIncrementalHeader(void);
+        /// Indexes all the records. Returns the offset where the valid records end.
+        size_t indexIncrementalRecords(void);
+
         void save( DataStreamPtr &dataStream, const IdString &hashedString );
         void save( DataStreamPtr &dataStream, const String &string );
         void save( DataStreamPtr &dataStream, const HlmsPropertyVec &properties );
@@ -192,6 +240,63 @@ namespace Ogre
 
         void saveTo( DataStreamPtr &dataStream );
         void loadFrom( DataStreamPtr &dataStream );
+
+        /** Attaches this cache to the given Hlms in incremental mode (see class description).
+            From now on, the Hlms will look for the preprocessed shaders in the file before
+            parsing the templates, and append to the file the ones that weren't there.
+        @remarks
+            The file is created if it doesn't exist. If it was created for a different Hlms
+            type, shader profile or OGRE_DEBUG_STR_SIZE it gets discarded.
+            The HlmsDiskCache must outlive the Hlms or be closed via closeIncremental.
+            Don't use saveTo/loadFrom/applyTo while in incremental mode.
+        @param hlms
+            Hlms to attach to. Can't be HLMS_COMPUTE or HLMS_LOW_LEVEL.
+        @param filename
+            Full path to the file in the filesystem.
+        */
+        void openIncremental( Hlms *hlms, const String &filename );
+
+        /// Detaches from the Hlms and closes the file. Does nothing if not in incremental mode.
+        void closeIncremental(void);
+
+        bool isIncremental(void) const                      { return mIncrementalHlms != 0; }
+        size_t getNumIncrementalEntries(void) const         { return mIncrementalIndex.size(); }
+
+        /** Looks for the preprocessed shaders generated from the given properties & pieces.
+        @remarks
+            A stage can only be taken from the cache if outUpToDate is true for it and the
+            properties it is about to be parsed with are the same as outStageProperties.
+            If they are, the properties for the next stage are outStageProperties[i+1].
+        @param mergedCache
+            The properties & pieces used to generate the shaders.
+        @param outSource [out]
+            The preprocessed source for each stage. Empty if the stage is not used.
+            Untouched if not found.
+        @param outStageProperties [out]
+            The properties each stage was parsed with. Untouched if not found.
+        @param outUpToDate [out]
+            Whether the templates of each stage are still the same as when the entry was
+            generated. All false if not found.
+        @return
+            True if found and at least one stage is up to date.
+        */
+        bool _findShaderCode( const Hlms::RenderableCache &mergedCache,
+                              String outSource[NumShaderTypes],
+                              HlmsPropertyVec outStageProperties[NumShaderTypes],
+                              bool outUpToDate[NumShaderTypes] );
+
+        /** Appends a new entry to the file.
+        @param source
+            Sources of unused stages must be empty.
+        @param stageProperties
+            The properties each stage was parsed with.
+        */
+        void _addShaderCode( const Hlms::RenderableCache &mergedCache,
+                             const String source[NumShaderTypes],
+                             const HlmsPropertyVec stageProperties[NumShaderTypes] );
+
+        /// Called by the Hlms when its templates have been reloaded. Does nothing if not in incremental mode.
+        void _notifyTemplatesChanged(void);
     };
 
     /** @} */
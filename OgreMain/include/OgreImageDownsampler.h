@@ -54,7 +54,7 @@ namespace Ogre
                                        const int8 kernelStartX, const int8 kernelEndX,
                                        const int8 kernelStartY, const int8 kernelEndY );
 
-    ImageDownsampler2D downscale2x_XXXA8888;
+    _OgreExport ImageDownsampler2D downscale2x_XXXA8888;
     ImageDownsampler2D downscale2x_XXX888;
     ImageDownsampler2D downscale2x_XX88;
     ImageDownsampler2D downscale2x_X8;
@@ -142,10 +142,10 @@ namespace Ogre
     //-----------------------------------------------------------------------------------
 
 
-    ImageDownsampler2D downscale2x_Float32_XXXA;
+    _OgreExport ImageDownsampler2D downscale2x_Float32_XXXA;
     ImageDownsampler2D downscale2x_Float32_XXX;
     ImageDownsampler2D downscale2x_Float32_XX;
-    ImageDownsampler2D downscale2x_Float32_X;
+    _OgreExport ImageDownsampler2D downscale2x_Float32_X;
     ImageDownsampler2D downscale2x_Float32_A;
     ImageDownsampler2D downscale2x_Float32_XA;
 
@@ -176,7 +176,7 @@ namespace Ogre
     //-----------------------------------------------------------------------------------
 
 
-    ImageDownsampler2D downscale2x_sRGB_XXXA8888;
+    _OgreExport ImageDownsampler2D downscale2x_sRGB_XXXA8888;
     ImageDownsampler2D downscale2x_sRGB_AXXX8888;
     ImageDownsampler2D downscale2x_sRGB_XXX888;
     ImageDownsampler2D downscale2x_sRGB_XX88;
@@ -211,6 +211,21 @@ namespace Ogre
     ImageBlur2D separableBlur_sRGB_XA88;
     ImageBlur2D separableBlur_sRGB_AX88;
 
+    //-----------------------------------------------------------------------------------
+    //SIMD versions
+    //-----------------------------------------------------------------------------------
+
+    /* These produce the exact same results as their scalar counterparts. When the kernel
+       is the 2x2 box filter (i.e. FILTER_LINEAR & FILTER_BILINEAR) they process 4 pixels
+       at a time using SSE2 or NEON; otherwise (or when Ogre is built without SIMD) they
+       call the scalar version.
+       These and their scalar counterparts are exported so the unit tests can compare them.
+    */
+    _OgreExport ImageDownsampler2D downscale2x_XXXA8888_SIMD;
+    _OgreExport ImageDownsampler2D downscale2x_sRGB_XXXA8888_SIMD;
+    _OgreExport ImageDownsampler2D downscale2x_Float32_XXXA_SIMD;
+    _OgreExport ImageDownsampler2D downscale2x_Float32_X_SIMD;
+
     struct FilterKernel
     {
         uint8   kernel[5][5];
@@ -226,7 +241,7 @@ namespace Ogre
         int8    kernelEnd;
     };
 
-    extern const FilterKernel c_filterKernels[3];
+    extern _OgreExport const FilterKernel c_filterKernels[3];
     extern const FilterSeparableKernel c_filterSeparableKernels[1];
 
     /** @} */
@@ -100,7 +100,12 @@ namespace Ogre
             if( !count )
                 return 0;
 
-            size_t _alignment = Alignment ? Alignment : 16; //Should be OGRE_SIMD_ALIGNMENT, but compiler error
+            //Should be OGRE_SIMD_ALIGNMENT, but compiler error
+#if OGRE_USE_SIMD_AVX2
+            size_t _alignment = Alignment ? Alignment : 32;
+#else
+            size_t _alignment = Alignment ? Alignment : 16;
+#endif
             uint8 *tmp = (uint8*)TrackAllocPolicy::allocateBytes( count + _alignment
 #if OGRE_MEMORY_TRACKER
             , file, line, func
@@ -98,6 +98,10 @@ namespace Ogre {
             uint32                  numIndices;
             void                    *indexData;
             OperationType operationType;
+            /// When true, vertexBuffers / indexData point to the memory of the stream
+            /// being imported and must not be freed.
+            bool                    vertexDataInStream;
+            bool                    indexDataInStream;
 
             SubMeshLod();
         };
@@ -182,6 +186,15 @@ namespace Ogre {
         virtual void createSubMeshVao( SubMesh *sm, SubMeshLodVec &submeshLods,
                                        uint8 numVaoPasses );
 
+        /// Frees the vertex & index data we allocated (i.e. not pointing to the stream).
+        void freeSubMeshLodData( SubMeshLodVec &submeshLods );
+
+        /** Returns a pointer to the current position of the stream being imported, and
+            skips numBytes. Only valid if mMemoryStream is not null.
+            Throws if the stream doesn't have that many bytes left.
+        */
+        uint8* borrowFromStream( DataStreamPtr &stream, size_t numBytes );
+
         /// Flip an entire vertex buffer to/from little endian
         /// working on the data pointer passed in pData
         void flipLittleEndian( void* pData, VertexBufferPacked *vertexBuffer );
@@ -199,6 +212,13 @@ namespace Ogre {
 
         ushort exportedLodCount; // Needed to limit exported Edge data, when exporting
         VaoManager *mVaoManager;
+
+        /// Set while importing from a stream that is fully in memory (e.g. memory mapped)
+        /// and doesn't need endian conversion. Vertex & index data is then sent to the
+        /// GPU straight from it, instead of being copied into temporary buffers first.
+        MemoryDataStream *mMemoryStream;
+        bool mVertexDataFromStream;
+        bool mIndexDataFromStream;
     };
 
     class _OgrePrivate MeshSerializerImpl_v2_1_R1 : public MeshSerializerImpl
@@ -248,6 +248,13 @@ namespace Ogre {
         */
         static void updateAllBounds( const size_t numNodes, ObjectData t );
 
+        /** Same as updateAllBounds, but skips the blocks of ARRAY_PACKED_REALS objects in which
+            no object is flagged dirty (see _notifyLocalAabbDirty) and no parent node
+            recomputed its derived transform (see Transform::DirtyDerived).
+            Clears the dirty flag of the objects it processes.
+        */
+        static void updateDirtyBounds( const size_t numNodes, ObjectData t );
+
         static inline ArrayReal calculateCameraDistance( uint32 _cameraSortMode, ArrayVector3 cameraPos,
                                                          ArrayVector3 cameraDir,
                                                          ArrayAabb *RESTRICT_ALIAS worldAabb,
@@ -429,6 +436,15 @@ namespace Ogre {
          */
         void setLocalAabb(const Aabb box);
 
+        /** Flags our world bounds for recalculation in the next update, even if our parent
+            node didn't move.
+        @remarks
+            setLocalAabb already does this. Derived classes writing to mObjectData.mLocalAabb
+            or mObjectData.mLocalRadius directly must call it, otherwise their world bounds
+            will be stale when SceneManager::setIncrementalBoundsUpdate is enabled.
+        */
+        void _notifyLocalAabbDirty(void)        { mObjectData.mDirtyFlags[mObjectData.mIndex] = 1u; }
+
         /** Gets the axis aligned box in world space.
         @remarks
             Assumes the caches are already updated. Will trigger an assert
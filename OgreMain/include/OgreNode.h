@@ -160,6 +160,12 @@ namespace Ogre {
         /** Internal method for creating a new child node - must be overridden per subclass. */
         virtual Node* createChildImpl( SceneMemoryMgrTypes sceneType ) = 0;
 
+        /// Flags our local transform as changed, so updateAllTransforms doesn't skip us.
+        void setLocalTransformDirty(void)
+        {
+            mTransform.mDirtyFlags[mTransform.mIndex] |= Transform::DirtyLocal;
+        }
+
 #if OGRE_DEBUG_MODE >= OGRE_DEBUG_MEDIUM
         mutable bool mCachedTransformOutOfDate;
 #endif
@@ -696,6 +702,11 @@ namespace Ogre {
         /** @See SceneManager::updateAllTransforms()
         @remarks
             We don't pass by reference on purpose (avoid implicit aliasing)
+        @par
+            Blocks of ARRAY_PACKED_REALS nodes in which no node is flagged DirtyLocal and no
+            parent is flagged DirtyDerived (see Transform::mDirtyFlags) are skipped. Nodes
+            that get recomputed are flagged DirtyDerived so that their children and attached
+            objects follow. The flags are cleared by NodeMemoryManager::_clearDirtyFlags.
         */
         static void updateAllTransforms( const size_t numNodes, Transform t );
 
@@ -0,0 +1,213 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef _OgreOcclusionCuller_H_
+#define _OgreOcclusionCuller_H_
+
+#include "OgrePrerequisites.h"
+#include "OgreMatrix4.h"
+#include "OgreMovableObject.h"
+#include "Math/Simple/OgreAabb.h"
+#include "Threading/OgreTaskGraph.h"
+#include "Threading/OgreUniformScalableTask.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre
+{
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup Scene
+    *  @{
+    */
+
+    /** CPU occlusion culling against a software rasterized depth buffer.
+    @remarks
+        Occluders are low poly proxies (i.e. the boxes of large buildings) that must be fully
+        contained in the objects they stand for. Every time a camera is culled, they're
+        rasterized into a small depth buffer (see setResolution) by the SceneManager worker
+        threads, and the objects that pass the frustum test are then tested against the
+        hierarchical-Z of that buffer: an object is dropped when its nearest point is
+        farther than the farthest occluder depth of every tile its Aabb covers.
+    @par
+        The depth buffer stores 1/w, which is linear in screen space. Rows are rasterized
+        ARRAY_PACKED_REALS pixels at a time, and each slice of work owns one row of tiles,
+        so no synchronization is needed. Triangles crossing the camera's plane are skipped
+        rather than clipped; that only makes the culling less aggressive, never wrong.
+    @par
+        Only needs a camera and the derived transforms of the occluders' nodes, thus it
+        works the same with any RenderSystem, including the NULL one.
+        See SceneManager::getOcclusionCuller.
+    */
+    class _OgreExport OcclusionCuller : public SceneCtlAllocatedObject
+    {
+    public:
+        /// Size in pixels of the tiles of the hierarchical-Z.
+        static const uint32 TileSize = 8u;
+
+        struct Occluder
+        {
+            /// Node the occluder is attached to. Can be null, in which case the
+            /// positions are in world space.
+            Node                    *node;
+            vector<Vector3>::type   positions;
+            /// Triangle list.
+            vector<uint32>::type    indices;
+            /// Index of its first triangle in mScreenTriangles. For internal use.
+            size_t                  firstTriangle;
+        };
+
+    protected:
+        /// Triangle setup, in pixels.
+        struct ScreenTriangle
+        {
+            /// Edge functions: e(x, y) = edgeA * x + edgeB * y + edgeC. The pixel
+            /// is inside when the three of them are >= 0
+            Real    edgeA[3];
+            Real    edgeB[3];
+            Real    edgeC[3];
+            /// 1 / w = invWA * x + invWB * y + invWC
+            Real    invWA;
+            Real    invWB;
+            Real    invWC;
+            /// Bounds in pixels. [minX; maxX) and [minY; maxY). Empty when rejected.
+            int32   minX;
+            int32   maxX;
+            int32   minY;
+            int32   maxY;
+        };
+        typedef vector<ScreenTriangle>::type ScreenTriangleVec;
+
+        class TransformTask : public UniformScalableTask
+        {
+        public:
+            OcclusionCuller *culler;
+            virtual void execute( size_t threadId, size_t numThreads );
+        };
+        class RasterTask : public UniformScalableTask
+        {
+        public:
+            OcclusionCuller *culler;
+            virtual void execute( size_t threadId, size_t numThreads );
+        };
+
+        typedef vector<Occluder*>::type OccluderVec;
+        OccluderVec         mOccluders;
+
+        bool                mEnabled;
+
+        uint32              mWidth;
+        uint32              mHeight;
+        uint32              mWidthInTiles;
+        uint32              mHeightInTiles;
+        /// 1 / w of the closest occluder per pixel (0 if none). Row major.
+        Real                *mDepthBuffer;
+        /// Smallest value of mDepthBuffer (i.e. farthest depth) per tile.
+        Real                *mHiZ;
+        /// False until rasterizeOccluders is called.
+        bool                mHiZValid;
+
+        Matrix4             mViewProjMatrix;
+        ScreenTriangleVec   mScreenTriangles;
+
+        TransformTask       mTransformTask;
+        RasterTask          mRasterTask;
+        TaskGraph           mTaskGraph;
+
+        void freeBuffers(void);
+
+        /// Transforms the triangles of a range of occluders into mScreenTriangles.
+        void transformOccluders( size_t sliceIdx, size_t numSlices );
+        void setupTriangle( const Vector4 &clip0, const Vector4 &clip1, const Vector4 &clip2,
+                            ScreenTriangle &outTriangle ) const;
+        /// Rasterizes all triangles into a row of tiles and builds its hierarchical-Z.
+        void rasterizeTileRow( size_t tileRow );
+
+    public:
+        OcclusionCuller();
+        ~OcclusionCuller();
+
+        /** Adds an occluder from raw geometry. The data is copied.
+        @param node
+            Node whose derived transform is applied to the positions. Can be null.
+            Must outlive the occluder.
+        @param indices
+            Triangle list. Vertices are interpreted as a triangle list if null.
+        */
+        Occluder* addOccluder( Node *node, const Vector3 *positions, size_t numVertices,
+                               const uint32 *indices, size_t numIndices );
+
+        /** Adds an occluder using the triangles of all submeshes of a (low poly) v2 mesh.
+        @remarks
+            Uses SubMesh::getTriangleBvh, see its remarks about GPU downloads.
+        */
+        Occluder* addOccluder( Node *node, Mesh *mesh );
+
+        void destroyOccluder( Occluder *occluder );
+        void destroyAllOccluders(void);
+
+        size_t getNumOccluders(void) const                  { return mOccluders.size(); }
+
+        /** Sets the resolution of the depth buffer. Rounded up to multiples of TileSize.
+            Default is 256x128; occluders are supposed to be large, a small buffer is enough.
+        */
+        void setResolution( uint32 width, uint32 height );
+        uint32 getWidth(void) const                         { return mWidth; }
+        uint32 getHeight(void) const                        { return mHeight; }
+
+        /// Disabled by default. SceneManager only uses it when enabled and there are occluders.
+        void setEnabled( bool bEnabled )                    { mEnabled = bEnabled; }
+        bool getEnabled(void) const                         { return mEnabled; }
+        bool isActive(void) const                           { return mEnabled && !mOccluders.empty(); }
+
+        /** Rasterizes all occluders as seen from the given camera.
+        @param sceneManager
+            Its worker threads are used. If null, everything runs in the calling thread.
+        */
+        void rasterizeOccluders( const Camera *camera, SceneManager *sceneManager );
+        /// Same, with an explicit view projection matrix (OpenGL convention, w = -z).
+        void rasterizeOccluders( const Matrix4 &viewProjMatrix, SceneManager *sceneManager );
+
+        /** Returns true if the box is guaranteed to be hidden behind the occluders rasterized
+            in the last call to rasterizeOccluders. Thread safe.
+        */
+        bool isOccluded( const Aabb &worldAabb ) const;
+
+        /** Removes the occluded objects from inOutObjects, keeping the order of the rest.
+        @param firstIdx
+            Objects before this index are not tested.
+        */
+        void cullOccluded( MovableObject::MovableObjectArray &inOutObjects, size_t firstIdx ) const;
+    };
+
+    /** @} */
+    /** @} */
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif
@@ -5,6 +5,7 @@
 #include "OgrePrerequisites.h"
 #include "OgreProfilerCommon.h"
 #include "OgreIdString.h"
+#include "ogrestd/vector.h"
 #include "Threading/OgreLightweightMutex.h"
 #include "Threading/OgreThreads.h"
 
@@ -23,6 +24,11 @@ namespace Ogre
         You can use setPaused to halt such growth temporarily, which is
         specially useful if whatever you want to profile is localized to
         particular execution moment.
+    @par
+        Optionally it can also record a timeline of events (see setTracing) which can
+        be exported with exportChromeTrace and opened with chrome://tracing or
+        https://ui.perfetto.dev to see what each thread was doing, and when.
+        Unlike the CSV files, this shows stalls and load imbalance between threads.
     */
     class _OgreExport OfflineProfiler
     {
@@ -37,6 +43,25 @@ namespace Ogre
             FastArray<ProfileSample*>   children;
         };
 
+        enum TraceEventType
+        {
+            TraceEventBegin,
+            TraceEventEnd,
+            TraceEventCounter,
+            TraceEventFrameMark
+        };
+
+        struct TraceEvent
+        {
+            uint64      usTimestamp;
+            /// Value of the counter, or frame number. Unused by Begin & End
+            double      value;
+            uint8       type;
+            uint8       nameStr[OGRE_OFFLINE_PROFILER_NAME_STR_LENGTH];
+        };
+
+        typedef vector<TraceEvent>::type TraceEventVec;
+
         class PerThreadData
         {
             bool                mPaused;
@@ -52,11 +77,30 @@ namespace Ogre
             size_t              mCurrMemoryPoolOffset;
             size_t              mBytesPerPool;
 
+            /// Ring buffer of trace events. Only the owner thread writes to it, and
+            /// it does so without locking. See pushTraceEvent & getTraceEvents
+            TraceEvent          *mTraceEvents;
+            size_t              mTraceCapacity;
+            size_t              mTraceCapacityRequest;
+            bool                mTraceOnly;
+            bool                mTraceOnlyRequest;
+            bool                mTraceClearRequest;
+            /// Total number of events written since the last clear. The slot for
+            /// the next event is mTraceWriteCount % mTraceCapacity
+            size_t volatile     mTraceWriteCount;
+            /// mTimer + mTraceTimeOffset = time in OfflineProfiler::mTraceTimer's base,
+            /// which is common to all threads
+            uint64              mTraceTimeOffset;
+            uint64              mFrameCount;
+            char                mThreadName[OGRE_OFFLINE_PROFILER_NAME_STR_LENGTH];
+
             /** Protects:
                     * mCurrentSample
                     * mMemoryPool
                     * mCurrMemoryPoolOffset
                     * mTotalAccumTime
+                    * mTraceEvents & mTraceCapacity (but not their contents!)
+                    * mThreadName
             */
             LightweightMutex    mMutex;
 
@@ -72,15 +116,32 @@ namespace Ogre
 
             void reset(void);
 
+            void applyTraceRequests(void);
+            void pushTraceEvent( TraceEventType type,
+                                 const char *name, double value );
+
         public:
-            PerThreadData( bool startPaused, size_t bytesPerPool );
+            PerThreadData( bool startPaused, size_t bytesPerPool, size_t traceCapacity,
+                           bool traceOnly, uint64 traceTimeOffset );
             ~PerThreadData();
 
             void setPauseRequest( bool bPause );
             void requestReset(void);
+            void setTraceRequest( size_t traceCapacity, bool traceOnly );
+            void requestTraceClear(void);
+
+            void setThreadName( const char *name );
 
             void profileBegin( const char *name, ProfileSampleFlags::ProfileSampleFlags flags );
             void profileEnd(void);
+            void profileFrameMark(void);
+            void profileCounter( const char *name, double value );
+
+            /** Copies the events still in the ring buffer, oldest first. Can be called from
+                any thread while the owner keeps recording; events that were being overwritten
+                while copying are discarded.
+            */
+            void getTraceEvents( TraceEventVec &outEvents, String &outThreadName );
 
             void dumpProfileResultsStr( String &outCsvStringPerFrame, String &outCsvStringAccum );
             void dumpProfileResults( const String &fullPathPerFrame, const String &fullPathAccum );
@@ -96,10 +157,19 @@ namespace Ogre
 
         size_t              mBytesPerPool;
 
+        size_t              mTraceCapacity;
+        bool                mTraceOnly;
+        /// Common time base for all threads' trace events. Protected by mMutex
+        Timer               *mTraceTimer;
+
         String              mOnShutdownPerFramePath;
         String              mOnShutdownAccumPath;
+        String              mOnShutdownTracePath;
 
         PerThreadData* allocatePerThreadData(void);
+        PerThreadData* getPerThreadData(void);
+
+        static void appendJsonString( String &outJson, const char *str );
 
     public:
         OfflineProfiler();
@@ -135,6 +205,48 @@ namespace Ogre
         void profileBegin( const char *name, ProfileSampleFlags::ProfileSampleFlags flags );
         void profileEnd(void);
 
+        /** Enables recording a timeline of events in addition to (or instead of) the CSV samples.
+            Each thread records into its own fixed-size ring buffer without locking, thus
+            once full, the oldest events get overwritten.
+        @remarks
+            Like setPaused, threads honour this request the next time they record a sample,
+            and only when they're not in the middle of a sample. Changing the capacity
+            discards the events that were recorded.
+        @param maxEventsPerThread
+            Capacity of each thread's ring buffer. 0 to disable tracing (default).
+            Every sample uses two events (begin & end).
+        @param bTraceOnly
+            When true, the CSV samples are not collected. This is much cheaper, as
+            it avoids locking and the sample tree.
+        */
+        void setTracing( size_t maxEventsPerThread, bool bTraceOnly );
+        size_t getTracingCapacity(void) const                   { return mTraceCapacity; }
+
+        /// Discards all trace events recorded so far. Like reset(), worker threads honour
+        /// this request the next time they record an event.
+        void clearTraces(void);
+
+        /// Gives the calling thread a name, which will be shown in the exported trace.
+        void setThreadName( const char *name );
+
+        /// Records an instant event marking the end of a frame. Should be called
+        /// from the main thread.
+        void profileFrameMark(void);
+
+        /// Records the value of a counter (e.g. draw calls) at this point in time.
+        /// It's shown in the exported trace as a graph.
+        void profileCounter( const char *name, double value );
+
+        /** Writes all trace events into a JSON file in the Chrome Trace Event format.
+            See setTracing.
+        @remarks
+            It is safe to call while other threads keep recording, but events being
+            overwritten by them at that moment will be missing from the file.
+        @param fullPath
+            Full path to the file to write, including extension (usually .json).
+        */
+        void exportChromeTrace( const String &fullPath );
+
         /** Dumps CSV data into two CSV files
         @param fullPathPerFrame
             Full path to csv without extension to generate where to dump the per-frame CSV data.
@@ -163,6 +275,13 @@ namespace Ogre
         @see    OfflineProfiler::dumpProfileResults
         */
         void setDumpPathsOnShutdown( const String &fullPathPerFrame, const String &fullPathAccum );
+
+        /** Ogre will call exportChromeTrace for you on shutdown if you set this path
+        @param fullPath
+            Full path to the JSON file. Empty string to skip it.
+        @see    OfflineProfiler::exportChromeTrace
+        */
+        void setTracePathOnShutdown( const String &fullPath );
     };
 }
 
@@ -0,0 +1,273 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __PackArchive_H__
+#define __PackArchive_H__
+
+#include "OgrePrerequisites.h"
+
+#include "OgreArchive.h"
+#include "OgreArchiveFactory.h"
+#include "Threading/OgreThreadHeaders.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre {
+
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup Resources
+    *  @{
+    */
+
+    struct PackFileMapping;
+    typedef SharedPtr<PackFileMapping> PackFileMappingPtr;
+
+    /** Specialisation of the Archive class to read files from an Ogre pack file.
+    @remarks
+        A pack file is a single file with all the entries laid out back to back
+        (each one aligned to the boundary it was written with), followed by a table
+        of contents with a hash table of the names, and a Header at the very end (so
+        packs can be written in one pass). Thus looking up a file is O(1) and listing
+        never has to scan anything; use PackArchiveWriter to create them.
+    @par
+        The pack is memory mapped when the platform allows it. Uncompressed entries
+        are then returned as MemoryDataStreams pointing straight into the mapping
+        (no copies, and pages are only read from disk when touched). Compressed
+        entries (LZ4 block format) are decompressed into a buffer of their own.
+        Returned streams keep the mapping alive, so they can outlive the archive.
+    @par
+        Like ZipArchive, names are matched case insensitively, and the archive is
+        read only. Once loaded, open & exists don't lock.
+    */
+    class _OgreExport PackArchive : public Archive
+    {
+    public:
+        enum Compression
+        {
+            CompressionNone,
+            CompressionLz4
+        };
+
+        /// 'OPAK' (little endian)
+        static const uint32 Magic   = 0x4B41504F;
+        static const uint32 Version = 1u;
+        /// Seed for hashing the (lowercase) names.
+        static const uint32 HashSeed= 0x9E3779B9;
+
+        struct Header
+        {
+            uint32  magic;
+            uint32  version;
+            uint32  numEntries;
+            /// Always a power of 2.
+            uint32  numBuckets;
+            /// The table of contents starts with numEntries Entry structs, followed by
+            /// numBuckets uint32 (entry index + 1, or 0 for empty buckets; linear
+            /// probing), followed by the names.
+            uint64  tocOffset;
+            uint64  tocSize;
+        };
+
+        struct Entry
+        {
+            uint64  offset;
+            /// Size in the pack. Same as uncompressedSize unless compressed.
+            uint64  size;
+            uint64  uncompressedSize;
+            int64   modifiedTime;
+            uint32  nameHash;
+            /// Relative to the start of the names.
+            uint32  nameOffset;
+            uint32  nameLength;
+            /// See Compression
+            uint32  compression;
+        };
+
+    protected:
+        /// Null if the platform can't map files, or the pack failed to be mapped.
+        PackFileMappingPtr  mMapping;
+        /// Table of contents, when mMapping is null.
+        vector<uint8>::type mTocData;
+
+        const Entry         *mEntries;
+        const uint32        *mBuckets;
+        const char          *mNames;
+        uint32              mNumEntries;
+        uint32              mNumBuckets;
+
+        /// Files and directories (compressedSize = -1), as in ZipArchive.
+        FileInfoList        mFileList;
+
+        OGRE_AUTO_MUTEX;
+
+        /// Returns the index of the entry, or -1 if not found.
+        size_t findEntry( const String &filename ) const;
+
+        DataStreamPtr readEntry( const Entry &entry, const String &filename ) const;
+
+    public:
+        PackArchive( const String& name, const String& archType );
+        ~PackArchive();
+
+        /// @copydoc Archive::isCaseSensitive
+        bool isCaseSensitive(void) const { return false; }
+
+        /// @copydoc Archive::load
+        void load();
+        /// @copydoc Archive::unload
+        void unload();
+
+        /// @copydoc Archive::open
+        DataStreamPtr open(const String& filename, bool readOnly = true);
+
+        /// @copydoc Archive::openMapped
+        DataStreamPtr openMapped(const String& filename);
+
+        /// @copydoc Archive::create
+        DataStreamPtr create(const String& filename);
+
+        /// @copydoc Archive::remove
+        void remove(const String& filename);
+
+        /// @copydoc Archive::list
+        StringVectorPtr list(bool recursive = true, bool dirs = false);
+
+        /// @copydoc Archive::listFileInfo
+        FileInfoListPtr listFileInfo(bool recursive = true, bool dirs = false);
+
+        /// @copydoc Archive::find
+        StringVectorPtr find(const String& pattern, bool recursive = true,
+            bool dirs = false);
+
+        /// @copydoc Archive::findFileInfo
+        FileInfoListPtr findFileInfo(const String& pattern, bool recursive = true,
+            bool dirs = false);
+
+        /// @copydoc Archive::exists
+        bool exists(const String& filename);
+
+        /// @copydoc Archive::getModifiedTime
+        time_t getModifiedTime(const String& filename);
+
+        /// Whether the pack could be memory mapped. If not, entries are read with regular file IO.
+        bool isMapped(void) const                       { return !mMapping.isNull(); }
+
+        /// Hash of the name as stored in the table of contents.
+        static uint32 hashName( const String &filename );
+
+        /** Compresses using the LZ4 block format.
+        @param dstCapacity
+            Use getMaxCompressedSize to never run out of space.
+        @return
+            Compressed size, or 0 if dst is too small.
+        */
+        static size_t compressLz4( const uint8 *src, size_t srcSize, uint8 *dst, size_t dstCapacity );
+        static size_t getMaxCompressedSize( size_t srcSize )    { return srcSize + srcSize / 255u + 16u; }
+
+        /** Decompresses LZ4 block format data.
+        @return
+            False if the data is malformed or doesn't decompress to exactly dstSize bytes.
+        */
+        static bool decompressLz4( const uint8 *src, size_t srcSize, uint8 *dst, size_t dstSize );
+    };
+
+    /** Creates pack files for PackArchive.
+    @remarks
+        Add the files, then call write. The data of each file is read during write.
+    */
+    class _OgreExport PackArchiveWriter : public ArchiveAlloc
+    {
+    protected:
+        struct PendingFile
+        {
+            String          name;
+            /// When null, the file is opened from archive during write.
+            DataStreamPtr   data;
+            Archive         *archive;
+            bool            compress;
+            uint32          alignment;
+            time_t          modifiedTime;
+        };
+        typedef vector<PendingFile>::type PendingFileVec;
+
+        PendingFileVec  mFiles;
+
+        static void writePadding( DataStreamPtr &stream, uint64 &inOutOffset, uint32 alignment );
+
+    public:
+        /** Adds a file to the pack.
+        @param name
+            Fully qualified name, using '/' as separator.
+        @param compress
+            True to compress it with LZ4. Files that don't get smaller are stored uncompressed.
+            Leave it off for data that should be mapped zero-copy (e.g. textures that are
+            already compressed).
+        @param alignment
+            Alignment in bytes of the file's data within the pack. Must be a power of 2.
+        */
+        void addFile( const String &name, const DataStreamPtr &data, bool compress = false,
+                      uint32 alignment = 16u, time_t modifiedTime = 0 );
+
+        /// Adds all the files of an archive (e.g. to convert a zip into a pack).
+        void addArchive( Archive *archive, bool compress = false, uint32 alignment = 16u );
+
+        size_t getNumFiles(void) const                  { return mFiles.size(); }
+
+        /** Writes the pack. Throws if two files have the same name (case insensitive).
+        @param stream
+            Must be writeable.
+        */
+        void write( DataStreamPtr &stream );
+    };
+
+    /** Specialisation of ArchiveFactory for pack files. */
+    class _OgreExport PackArchiveFactory : public ArchiveFactory
+    {
+    public:
+        virtual ~PackArchiveFactory() {}
+        /// @copydoc FactoryObj::getType
+        const String& getType(void) const;
+        /// @copydoc FactoryObj::createInstance
+        Archive *createInstance( const String& name, bool readOnly )
+        {
+            if(!readOnly)
+                return NULL;
+            return OGRE_NEW PackArchive(name, "Pack");
+        }
+        /// @copydoc FactoryObj::destroyInstance
+        void destroyInstance( Archive* ptr) { OGRE_DELETE ptr; }
+    };
+
+    /** @} */
+    /** @} */
+
+} // namespace Ogre
+
+#include "OgreHeaderSuffix.h"
+
+#endif
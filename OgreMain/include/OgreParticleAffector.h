@@ -110,6 +110,28 @@ namespace Ogre {
         */
         virtual void _affectParticles(ParticleSystem* pSystem, Real timeElapsed) = 0;
 
+        /** Returns true if this affector implements _affectArrayParticles.
+        @remarks
+            When at least one affector of a system does, the ParticleSystem copies its particles
+            into an ArrayParticleData once per update instead of walking the Particle objects in
+            every affector. Affectors returning false keep working through _affectParticles.
+        */
+        virtual bool _supportsArrayParticles(void) const { return false; }
+
+        /** Same as _affectParticles, but operating on ARRAY_PACKED_REALS particles at a time.
+        @remarks
+            Only called if _supportsArrayParticles returns true.
+        @param
+            particles SoA copy of the active particles of the system.
+        @param
+            timeElapsed The number of seconds which have elapsed since the last call.
+        */
+        virtual void _affectArrayParticles(ArrayParticleData& particles, Real timeElapsed)
+                {
+                    (void)particles;
+                    (void)timeElapsed;
+                }
+
         /** Returns the name of the type of affector. 
         @remarks
             This property is useful for determining the type of affector procedurally so another
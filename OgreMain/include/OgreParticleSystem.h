@@ -31,11 +31,13 @@ THE SOFTWARE.
 #include "OgrePrerequisites.h"
 
 #include "OgreVector3.h"
+#include "OgreMatrix4.h"
 #include "OgreParticleIterator.h"
 #include "OgreStringInterface.h"
 #include "OgreMovableObject.h"
 #include "OgreRadixSort.h"
 #include "OgreResourceGroupManager.h"
+#include "OgreArrayParticleData.h"
 #include "OgreHeaderPrefix.h"
 
 
@@ -346,6 +348,36 @@ namespace Ogre {
         */
         void _update(Real timeElapsed);
 
+        /** Called by the time controller every frame.
+        @remarks
+            Updates the system right away, unless SceneManager::setParallelParticleSystemUpdates
+            is enabled. In that case everything that isn't thread safe (configuring the renderer,
+            fetching the parent's transform) is done here, and the rest of the update is queued
+            so that the SceneManager runs it from its worker threads. @see _updatePending
+        */
+        void _scheduleUpdate(Real timeElapsed);
+
+        /** Runs the update queued by _scheduleUpdate. Called from SceneManager's worker threads.
+        @remarks
+            The emitters & affectors of this system must be safe to run concurrently with the
+            ones from other systems. In particular they must draw random numbers from
+            _getUnitRandom & co. instead of Math::UnitRandom, which isn't thread safe.
+            The stock emitters & ParticleFX affectors do.
+        */
+        void _updatePending(void);
+
+        /** Returns a random number in [0; 1) from this system's own generator.
+        @remarks
+            For use by emitters & affectors. Unlike Math::UnitRandom, it is safe to call
+            while other systems are being updated. The generator is seeded from
+            Math::UnitRandom when the system is created.
+        */
+        Real _getUnitRandom(void);
+        /// Random number in [low; high) from this system's generator. @see _getUnitRandom
+        Real _getRangeRandom( Real low, Real high )     { return low + (high - low) * _getUnitRandom(); }
+        /// Random number in [-1; 1) from this system's generator. @see _getUnitRandom
+        Real _getSymmetricRandom(void)                  { return 2.0f * _getUnitRandom() - 1.0f; }
+
         /** Returns an iterator for stepping through all particles in this system.
         @remarks
             This method is designed to be used by people providing new ParticleAffector subclasses,
@@ -665,6 +697,14 @@ namespace Ogre {
         bool mEmittedEmitterPoolInitialised;
         /// Used to control if the particle system should emit particles or not.
         bool mIsEmitting;
+        /// Is an update queued by _scheduleUpdate waiting to be run?
+        bool mUpdatePending;
+        /// Time elapsed of the queued update, already scaled by mSpeedFactor.
+        Real mPendingTimeElapsed;
+        /// Full transform of the parent node, cached by _prepareUpdate.
+        Matrix4 mParentFullTransform;
+        /// State of the xorshift generator behind _getUnitRandom.
+        uint32 mRandomState;
 
         typedef list<Particle*>::type ActiveParticleList;
         typedef list<Particle*>::type FreeParticleList;
@@ -760,6 +800,16 @@ namespace Ogre {
         /// The renderer used to render this particle system
         ParticleSystemRenderer* mRenderer;
 
+        /** SoA copy of mActiveParticles, used when some affectors support it.
+            @see ParticleAffector::_affectArrayParticles
+        */
+        ArrayParticleData mArrayParticles;
+
+        /// Requested emission count per emitter, kept to avoid allocating every update.
+        vector<unsigned>::type mRequestedEmissions;
+        /// Requested emission count per active emitted emitter.
+        vector<unsigned>::type mRequestedEmittedEmissions;
+
         /// Do we cull each particle individually?
         bool mCullIndividual;
 
@@ -796,6 +846,27 @@ namespace Ogre {
         /** Applies the effects of affectors. */
         void _triggerAffectors(Real timeElapsed);
 
+        /** Same as _triggerAffectors followed by _applyMotion, but running the affectors
+            that support it on mArrayParticles.
+        */
+        void _triggerArrayAffectorsAndApplyMotion(Real timeElapsed);
+
+        /// Returns true if any of the affectors implements _affectArrayParticles.
+        bool hasArrayAffectors(void) const;
+
+        /** Checks whether the system needs updating and does the setup that must happen in
+            the main thread. Scales timeElapsed by the speed factor.
+        @return
+            False if the system must not be updated.
+        */
+        bool _prepareUpdate(Real &timeElapsed);
+
+        /** Expires, affects, moves & emits particles. _prepareUpdate must have been called. */
+        void _updateSimulation(Real timeElapsed);
+
+        /** Same as _updateBounds, using mParentFullTransform. */
+        void _updateBoundsImpl(void);
+
         /** Sort the particles in the system **/
         void _sortParticles(Camera* cam);
 
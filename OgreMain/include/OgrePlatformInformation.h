@@ -50,7 +50,11 @@ namespace Ogre {
 /** Find perfect alignment (should supports SIMD alignment if SIMD available)
 */
 #if OGRE_CPU == OGRE_CPU_X86
-#   define OGRE_SIMD_ALIGNMENT  16
+#   if OGRE_USE_SIMD == 1 && OGRE_USE_SIMD_AVX2 == 1 && OGRE_DOUBLE_PRECISION == 0
+#       define OGRE_SIMD_ALIGNMENT  32
+#   else
+#       define OGRE_SIMD_ALIGNMENT  16
+#   endif
 #else
 #   define OGRE_SIMD_ALIGNMENT  16
 #endif
@@ -64,6 +68,9 @@ namespace Ogre {
 #if OGRE_USE_SIMD == 1
     #if   OGRE_DOUBLE_PRECISION == 0 && OGRE_CPU == OGRE_CPU_X86 && OGRE_PLATFORM != OGRE_PLATFORM_NACL
     #   define __OGRE_HAVE_SSE  1
+    #   if OGRE_USE_SIMD_AVX2 == 1
+    #       define __OGRE_HAVE_AVX2  1
+    #   endif
     #endif
 
     /* Define whether or not Ogre compiled with NEON support.
@@ -78,6 +85,10 @@ namespace Ogre {
 #   define __OGRE_HAVE_SSE  0
 #endif
 
+#ifndef __OGRE_HAVE_AVX2
+#   define __OGRE_HAVE_AVX2  0
+#endif
+
 #if OGRE_USE_SIMD == 0 || !defined(__OGRE_HAVE_NEON)
 #   define __OGRE_HAVE_NEON  0
 #endif
@@ -127,6 +138,9 @@ namespace Ogre {
             CPU_FEATURE_FPU         = 1 << 9,
             CPU_FEATURE_PRO         = 1 << 10,
             CPU_FEATURE_HTT         = 1 << 11,
+            CPU_FEATURE_AVX         = 1 << 15,
+            CPU_FEATURE_AVX2        = 1 << 16,
+            CPU_FEATURE_FMA         = 1 << 17,
 #elif OGRE_CPU == OGRE_CPU_ARM
             CPU_FEATURE_VFP         = 1 << 12,
             CPU_FEATURE_NEON        = 1 << 13,
@@ -160,6 +160,7 @@ namespace Ogre {
     class ArrayQuaternion;
     class ArrayVector3;
     class ArrayMemoryManager;
+    class ArrayParticleData;
     class Archive;
     class ArchiveFactory;
     class ArchiveManager;
@@ -170,6 +171,7 @@ namespace Ogre {
     class AxisAlignedBoxSceneQuery;
     class Barrier;
     class Bone;
+    class Bvh;
     class BoneMemoryManager;
     struct BoneTransform;
     class BufferInterface;
@@ -271,6 +273,7 @@ namespace Ogre {
     class NodeMemoryManager;
     struct ObjectData;
     class ObjectMemoryManager;
+    class OcclusionCuller;
     class Particle;
     class ParticleAffector;
     class ParticleAffectorFactory;
@@ -347,6 +350,7 @@ namespace Ogre {
     struct TexturePool;
     struct Transform;
     class Timer;
+    class TriangleBvh;
     class UavBufferPacked;
     class UserObjectBindings;
     class VaoManager;
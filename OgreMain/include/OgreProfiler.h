@@ -82,6 +82,9 @@ Ogre-dependent is in the visualization/logging routines and the use of the Timer
 #   define OgreProfileGpuBeginDynamic( a )
 #   define OgreProfileGpuBeginDynamicHashed( a, hash )
 #   define OgreProfileGpuEnd( a )
+#   define OgreProfileThreadName( a )
+#   define OgreProfileFrameMark()
+#   define OgreProfileCounter( a, value )
 #elif OGRE_PROFILING == OGRE_PROFILING_REMOTERY
 namespace Ogre
 {
@@ -127,6 +130,9 @@ namespace Ogre
 #   define OgreProfileGpuBeginDynamicHashed( a, hash )                              \
     Ogre::Profiler::getSingleton().beginGPUSample( a, hash )
 #   define OgreProfileGpuEnd( a ) Ogre::Profiler::getSingleton().endGPUSample(a)
+#   define OgreProfileThreadName( a ) rmt_SetCurrentThreadName( a )
+#   define OgreProfileFrameMark()
+#   define OgreProfileCounter( a, value )
 //#   define OgreProfileGpu( g ) Ogre::Profiler::getSingleton().endGPUEvent(g)
 
 namespace Ogre
@@ -168,6 +174,12 @@ namespace Ogre
 #   define OgreProfileGpuBeginDynamic( a )
 #   define OgreProfileGpuBeginDynamicHashed( a, hash )
 #   define OgreProfileGpuEnd( a )
+#   define OgreProfileThreadName( a )                                               \
+    Ogre::Profiler::getSingleton().getOfflineProfiler().setThreadName( (a) )
+#   define OgreProfileFrameMark()                                                   \
+    Ogre::Profiler::getSingleton().getOfflineProfiler().profileFrameMark()
+#   define OgreProfileCounter( a, value )                                           \
+    Ogre::Profiler::getSingleton().getOfflineProfiler().profileCounter( (a), (double)(value) )
 #else
 #   define OgreProfilerUseStableMarkers true
 #   define OgreProfileExhaustive( a )
@@ -188,6 +200,9 @@ namespace Ogre
 #   define OgreProfileGpuBeginDynamic( a )
 #   define OgreProfileGpuBeginDynamicHashed( a, hash )
 #   define OgreProfileGpuEnd( a )
+#   define OgreProfileThreadName( a )
+#   define OgreProfileFrameMark()
+#   define OgreProfileCounter( a, value )
 #endif
 
 #if OGRE_PROFILING && !OGRE_PROFILING_EXHAUSTIVE
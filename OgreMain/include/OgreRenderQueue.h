@@ -33,6 +33,8 @@ THE SOFTWARE.
 #include "OgreHlmsCommon.h"
 #include "OgreHeaderPrefix.h"
 #include "OgreIteratorWrappers.h"
+#include "Threading/OgreTaskGraph.h"
+#include "Threading/OgreUniformScalableTask.h"
 
 namespace Ogre {
 
@@ -143,9 +145,76 @@ namespace Ogre {
             QueuedRenderableArray   mQueuedRenderables;
             RqSortMode              mSortMode;
             bool                    mSorted;
+            bool                    mReuseSort;
             Modes                   mMode;
 
-            RenderQueueGroup() : mSortMode( NormalSort ), mSorted( false ), mMode( FAST ) {}
+            /// Input & output of the last sort. Only used when mReuseSort is true.
+            QueuedRenderableArray   mLastUnsorted;
+            QueuedRenderableArray   mLastSorted;
+
+            RenderQueueGroup() :
+                mSortMode( NormalSort ), mSorted( false ), mReuseSort( false ), mMode( FAST ) {}
+        };
+
+        /** Each phase of the parallel sort is a task of mSortTaskGraph:
+                1. Gather: each slice copies one ThreadRenderQueue into mQueuedRenderables.
+                2. LocalSort: each slice radix sorts an equally sized chunk.
+                3. Merge: log2(numSlices) rounds where pairs of sorted runs are merged.
+                   All slices cooperate in each merge by splitting the output in equal
+                   parts (merge path).
+        */
+        class ParallelSortTask : public UniformScalableTask
+        {
+        public:
+            enum Phase
+            {
+                Gather,
+                LocalSort,
+                Merge
+            };
+
+            RenderQueue *mRenderQueue;
+            Phase       mPhase;
+            size_t      mMergeRound;
+
+            ParallelSortTask( RenderQueue *renderQueue, Phase phase, size_t mergeRound ) :
+                mRenderQueue( renderQueue ), mPhase( phase ), mMergeRound( mergeRound ) {}
+
+            virtual void execute( size_t threadId, size_t numThreads );
+        };
+
+        typedef vector<ParallelSortTask>::type ParallelSortTaskVec;
+
+        /// Output of recording a range of renderables into a CommandBuffer.
+        struct RecordState
+        {
+            CommandBuffer   *commandBuffer;
+            unsigned char   *indirectDraw;
+            uint32          lastVaoName;
+            size_t          drawCount;
+            size_t          instanceCount;
+            size_t          faceCount;
+            size_t          vertexCount;
+            size_t          psoSwitchCount;
+
+            RecordState() :
+                commandBuffer( 0 ), indirectDraw( 0 ), lastVaoName( 0 ),
+                drawCount( 0 ), instanceCount( 0 ), faceCount( 0 ), vertexCount( 0 ),
+                psoSwitchCount( 0 ) {}
+        };
+
+        typedef FastArray<RecordState> RecordStateArray;
+
+        /// Each slice records an equally sized, contiguous range of the RQ into its own
+        /// CommandBuffer. See setParallelRecordingThreshold.
+        class ParallelRecordTask : public UniformScalableTask
+        {
+        public:
+            RenderQueue *mRenderQueue;
+
+            ParallelRecordTask( RenderQueue *renderQueue ) : mRenderQueue( renderQueue ) {}
+
+            virtual void execute( size_t threadId, size_t numThreads );
         };
 
         typedef vector<IndirectBufferPacked*>::type IndirectBufferPackedVec;
@@ -171,6 +240,32 @@ namespace Ogre {
 
         uint32 mRenderingStarted;
 
+        size_t                  mParallelSortThreshold;
+        /// Ping-pong buffer for the parallel sort. Its contents are swapped with the
+        /// mQueuedRenderables of the group being sorted, so the memory migrates between groups.
+        QueuedRenderableArray   mSortScratch;
+        /// Where each ThreadRenderQueue starts in mQueuedRenderables, for the Gather phase.
+        FastArray<size_t>       mSortGatherOffsets;
+        RenderQueueGroup        *mSortingGroup;
+        QueuedRenderable        *mSortBuffers[2];
+        size_t                  mSortNumRenderables;
+        bool                    mSortNeedsGather;
+        size_t                  mSortNumMergeRounds;
+        ParallelSortTaskVec     mParallelSortTasks;
+        TaskGraph               mSortTaskGraph;
+
+        size_t                  mParallelRecordingThreshold;
+        /// HlmsCache of each renderable, resolved in the main thread before recording.
+        FastArray<HlmsCache const*> mRecordHlmsCaches;
+        vector<CommandBuffer*>::type mRecordCommandBuffers;
+        RecordStateArray        mRecordStates;
+        RenderQueueGroup const  *mRecordingGroup;
+        bool                    mRecordCasterPass;
+        HlmsCache               *mRecordPassCache;
+        IndirectBufferPacked    *mRecordIndirectBuffer;
+        unsigned char           *mRecordStartIndirectDraw;
+        ParallelRecordTask      mParallelRecordTask;
+
         /** Returns a new (or an existing) indirect buffer that can hold the requested number of draws.
         @param numDraws
             Number of draws the indirect buffer is expected to hold. It must be an upper limit.
@@ -196,6 +291,41 @@ namespace Ogre {
         void renderGL3V1( RenderSystem *rs, bool casterPass, bool dualParaboloid, HlmsCache passCache[],
                           const RenderQueueGroup &renderQueueGroup );
 
+        /// Same as renderGL3, but the commands are recorded by SceneManager's worker threads.
+        /// Falls back to renderGL3 if any of the Hlms in the group can't fill buffers in parallel.
+        unsigned char *renderGL3Parallel( RenderSystem *rs, bool casterPass, bool dualParaboloid,
+                                          HlmsCache passCache[],
+                                          const RenderQueueGroup &renderQueueGroup,
+                                          IndirectBufferPacked *indirectBuffer,
+                                          unsigned char *indirectDraw,
+                                          unsigned char *startIndirectDraw );
+
+        /** Records the renderables in range [begin; end) into state.commandBuffer.
+        @param threadIdx
+            Index of the Hlms fill state to use. Must be 0 when hlmsCaches is null.
+        @param hlmsCaches
+            When null, materials are retrieved from the Hlms (main thread only).
+            Otherwise an array with the HlmsCache of each renderable in the range,
+            and Hlms::fillBuffersForV2Mt is used.
+        */
+        void recordGL3( RecordState &state, size_t threadIdx, bool casterPass, HlmsCache passCache[],
+                        const QueuedRenderable *begin, const QueuedRenderable *end,
+                        HlmsCache const * const *hlmsCaches, IndirectBufferPacked *indirectBuffer,
+                        unsigned char *startIndirectDraw );
+        void parallelRecord( size_t sliceIdx, size_t numSlices );
+
+        /// Merges the per thread queues of the group into mQueuedRenderables and sorts them.
+        void sortRenderQueue( RenderQueueGroup &renderQueueGroup );
+
+        /// Runs mSortTaskGraph over the given group. Sorting is stable.
+        void parallelSort( RenderQueueGroup &renderQueueGroup, size_t numRenderables,
+                           bool alreadyGathered );
+        void buildSortTaskGraph( size_t numSlices );
+
+        void parallelSortGather( size_t sliceIdx );
+        void parallelSortLocal( size_t sliceIdx, size_t numSlices );
+        void parallelSortMerge( size_t sliceIdx, size_t numSlices, size_t mergeRound );
+
     public:
         RenderQueue( HlmsManager *hlmsManager, SceneManager *sceneManager, VaoManager *vaoManager );
         ~RenderQueue();
@@ -265,6 +395,16 @@ namespace Ogre {
         void render( RenderSystem *rs, uint8 firstRq, uint8 lastRq,
                      bool casterPass, bool dualParaboloid );
 
+        /** Merges the queues filled by each thread and sorts them (according to the
+            sort mode of each RQ) in range [firstRq; lastRq).
+        @remarks
+            render() already does this for the RQs that haven't been sorted yet; calling
+            it explicitly is only useful to measure the sorting cost on its own.
+            Must be called from the main thread, since it may use SceneManager's
+            worker threads.
+        */
+        void sortRenderQueues( uint8 firstRq, uint8 lastRq );
+
         /// Don't call this too often. Only renders v1 objects at the moment.
         void renderSingleObject( Renderable* pRend, const MovableObject *pMovableObject,
                                  RenderSystem *rs, bool casterPass, bool dualParaboloid );
@@ -292,6 +432,57 @@ namespace Ogre {
         */
         void setSortRenderQueue( uint8 rqId, RqSortMode sortMode );
         RqSortMode getSortRenderQueue( uint8 rqId ) const;
+
+        /** When enabled, if the contents of the RQ are exactly the same as the last time
+            it was sorted (same renderables with the same hashes in the same order; i.e.
+            neither the camera nor the visible set changed) the previous sorted result
+            is reused instead of sorting again.
+        @remarks
+            Comparing is much cheaper than sorting, but it requires keeping two extra copies
+            of the RQ and copying them whenever the contents change. Therefore it's only
+            worth it for mostly static scenes with a mostly static camera.
+            The RenderQueue is shared by all passes (including shadow map passes), and only
+            the last sort is remembered. Thus RQs that are rendered by more than one camera
+            per frame won't benefit from this.
+        @param rqId
+            ID of the render queue
+        @param bReuse
+            True to enable. Default is false.
+        */
+        void setReuseSortWhenUnchanged( uint8 rqId, bool bReuse );
+        bool getReuseSortWhenUnchanged( uint8 rqId ) const;
+
+        /** RQs with at least this many renderables are merged and sorted in parallel using
+            SceneManager's worker threads (radix sort on each thread, then parallel merge).
+            Smaller RQs are sorted in the main thread, as waking up the workers isn't free.
+        @param numRenderables
+            Minimum number of renderables. Default is 8192.
+            Use std::numeric_limits<size_t>::max() to always sort in the main thread.
+        */
+        void setParallelSortThreshold( size_t numRenderables );
+        size_t getParallelSortThreshold(void) const         { return mParallelSortThreshold; }
+
+        /** FAST RQs with at least this many renderables are recorded in parallel using
+            SceneManager's worker threads: each thread fills its own Hlms const & texture
+            buffers and writes its own CommandBuffer, which are then stitched in order.
+        @remarks
+            Shaders & PSOs are still retrieved from the Hlms in the main thread before
+            recording starts, as they may need to be compiled.
+            Only Hlms implementations where Hlms::supportsParallelFillBuffers returns true
+            are recorded in parallel. If a RQ contains any other Hlms, it is recorded in the
+            main thread.
+        @par
+            Hlms listeners are called from the worker threads, and so must be thread safe.
+        @par
+            Worker threads may need to create new const/texture buffers if the ones reserved
+            at the beginning run out. Creating buffers from a secondary thread is not supported
+            by every RenderSystem; thus this is disabled by default.
+        @param numRenderables
+            Minimum number of renderables.
+            Default is std::numeric_limits<size_t>::max() (always record in the main thread).
+        */
+        void setParallelRecordingThreshold( size_t numRenderables );
+        size_t getParallelRecordingThreshold(void) const    { return mParallelRecordingThreshold; }
     };
 
     #define OGRE_RQ_MAKE_MASK( x ) ( (1 << (x)) - 1 )
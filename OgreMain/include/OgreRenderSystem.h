@@ -127,6 +127,7 @@ namespace Ogre
             size_t mVertexCount;
             size_t mDrawCount;
             size_t mInstanceCount;
+            size_t mPsoSwitchCount;
             Metrics();
         };
 
@@ -974,6 +975,16 @@ namespace Ogre
 
         const Metrics& getMetrics() const;
 
+        /// Resets the metrics returned by getFrameMetrics. Root calls this at the end of
+        /// every frame.
+        void _resetFrameMetrics();
+
+        /** Same as getMetrics, but accumulated over the whole frame (i.e. all passes) instead
+            of being reset on every pass. Always collected, regardless of
+            setMetricsRecordingEnabled. Only includes what gets reported via _addMetrics.
+        */
+        const Metrics& getFrameMetrics() const;
+
         /** Generates a packed data version of the passed in ColourValue suitable for
         use as with this RenderSystem.
         @remarks
@@ -1476,6 +1487,7 @@ namespace Ogre
         bool mWBuffer;
 
         Metrics mMetrics;
+        Metrics mFrameMetrics;
 
         /// Saved manual colour blends
         ColourValue mManualBlendColours[OGRE_MAX_TEXTURE_LAYERS][2];
@@ -118,8 +118,32 @@ namespace Ogre {
             RT_LOAD_GROUP = 4,
             RT_LOAD_RESOURCE = 5,
             RT_UNLOAD_GROUP = 6,
-            RT_UNLOAD_RESOURCE = 7
+            RT_UNLOAD_RESOURCE = 7,
+            RT_PREPARE_GROUP_RESOURCE = 8
         };
+
+        /// State of a loadResourceGroupParallel operation. Owned by the main thread.
+        struct ParallelGroupLoad
+        {
+            BackgroundProcessTicket ticket;
+            String groupName;
+            /// Resources of the group, in loading order.
+            vector<ResourcePtr>::type resources;
+            /// Whether resources[i] finished preparing (successfully or not).
+            vector<bool>::type prepared;
+            /// Index in resources of the next one to be loaded in the main thread.
+            size_t nextToLoad;
+            size_t numRequestsPending;
+            /// Non-zero once aborted. Read by the workers to skip preparing; it's only a hint,
+            /// the main thread is the one that stops loading. Only access it via atomicLoad
+            /// & atomicStore (see OgreAtomicHelpers.h)
+            long aborted;
+            Listener* listener;
+            BackgroundProcessResult result;
+        };
+        typedef map<BackgroundProcessTicket, ParallelGroupLoad*>::type ParallelGroupLoadMap;
+        ParallelGroupLoadMap mParallelGroupLoads;
+
         /** Encapsulates a queued request for the background queue */
         struct ResourceRequest
         {
@@ -133,6 +157,9 @@ namespace Ogre {
             NameValuePairList* loadParams;
             Listener* listener;
             BackgroundProcessResult result;
+            /// For RT_PREPARE_GROUP_RESOURCE: the operation and the index of the resource in it.
+            ParallelGroupLoad* groupLoad;
+            size_t groupResourceIdx;
 
             _OgreExport friend std::ostream& operator<<(std::ostream& o, const ResourceRequest& r)
             { (void)r; return o; }
@@ -157,6 +184,9 @@ namespace Ogre {
 
         BackgroundProcessTicket addRequest(ResourceRequest& req);
 
+        /// Main thread part of a RT_PREPARE_GROUP_RESOURCE: loads, in order, what's been prepared.
+        void handleGroupResourceResponse(const WorkQueue::Response* res);
+
     public:
         ResourceBackgroundQueue();
         virtual ~ResourceBackgroundQueue();
@@ -214,6 +244,35 @@ namespace Ogre {
         virtual BackgroundProcessTicket loadResourceGroup(const String& name, 
             Listener* listener = 0);
 
+        /** Loads a resource group using all the WorkQueue worker threads.
+        @remarks
+            loadResourceGroup runs ResourceGroupManager::loadResourceGroup in a single
+            worker. Instead, this queues one request per resource, so the workers prepare
+            them (i.e. read from disk and parse) in parallel, while load() gets called
+            from the main thread as the responses are processed.
+        @par
+            Resources are loaded in the group's loading order (see
+            ResourceManager::getLoadingOrder), thus the resources they depend on
+            (i.e. skeletons and materials used by meshes) are always loaded before them.
+            ResourceGroupListener events are fired from the main thread as usual, so
+            existing progress bars keep working; @see getProgress too.
+        @par
+            The group must be initialised. Without thread support, this is the same
+            as loadResourceGroup.
+        @param name The name of the resource group to load
+        @param listener Optional callback interface, called from the main thread
+            once every resource was loaded or the operation was aborted.
+        @return Ticket identifying the whole operation. Can be passed to
+            isProcessComplete, getProgress and abortRequest. 0 if done already.
+        */
+        virtual BackgroundProcessTicket loadResourceGroupParallel(const String& name,
+            Listener* listener = 0);
+
+        /** Returns the fraction of resources already loaded by a loadResourceGroupParallel
+            operation, in range [0; 1]. Returns 1 for unknown or completed tickets.
+        */
+        Real getProgress(BackgroundProcessTicket ticket) const;
+
 
         /** Unload a single resource in the background. 
         @see ResourceManager::unload
@@ -304,6 +363,10 @@ namespace Ogre {
         virtual bool isProcessComplete(BackgroundProcessTicket ticket);
 
         /** Aborts background process.
+        @remarks
+            For loadResourceGroupParallel operations, resources already loaded stay loaded,
+            the rest of the group is left unloaded and the listener is called once the
+            requests in flight return.
         */
         void abortRequest( BackgroundProcessTicket ticket );
 
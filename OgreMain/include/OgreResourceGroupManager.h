@@ -583,6 +583,28 @@ namespace Ogre {
         void loadResourceGroup(const String& name, bool loadMainResources = true, 
             bool loadWorldGeom = true);
 
+        /** Starts loading a group in several steps, for loaders that interleave the loading
+            with other work (see ResourceBackgroundQueue::loadResourceGroupParallel).
+        @remarks
+            Fires the group load started event. Resources must then be loaded with
+            _loadResourceGroupResource, in order, and the operation ended with
+            _endLoadResourceGroup.
+        @param outResources
+            Receives the resources of the group, in loading order (see
+            ResourceManager::getLoadingOrder).
+        */
+        void _beginLoadResourceGroup(const String& name, vector<ResourcePtr>::type &outResources);
+
+        /// Loads one of the resources returned by _beginLoadResourceGroup, firing its events.
+        void _loadResourceGroupResource(const ResourcePtr &resource);
+
+        /** Ends a load started with _beginLoadResourceGroup and fires the group load ended event.
+        @param completed
+            Whether all resources were loaded. If so, the world geometry is loaded and
+            the group is flagged as loaded.
+        */
+        void _endLoadResourceGroup(const String& name, bool completed);
+
         /** Unloads a resource group.
         @remarks
             This method unloads all the resources that have been declared as
@@ -48,6 +48,8 @@ Torus Knot Software Ltd.
 #include "Animation/OgreSkeletonAnimManager.h"
 #include "Compositor/Pass/OgreCompositorPass.h"
 #include "Threading/OgreThreads.h"
+#include "Threading/OgreTaskGraph.h"
+#include "Threading/OgreUniformScalableTask.h"
 #include "OgreHeaderPrefix.h"
 
 namespace Ogre {
@@ -111,10 +113,14 @@ namespace Ogre {
         Camera const                    *camera;
         /// Camera whose frustum we're to cull against. Must be const (read only for all threads).
         Camera const                    *lodCamera;
+        /// When not null, objects that pass the frustum test are also tested against the
+        /// occluders it rasterized for 'camera'. Must be const (read only for all threads).
+        OcclusionCuller const           *occlusionCuller;
 
         CullFrustumRequest() :
             firstRq( 0 ), lastRq( 0 ), casterPass( false ), addToRenderQueue( true ),
-            cullingLights( false ), objectMemManager( 0 ), camera( 0 ), lodCamera( 0 )
+            cullingLights( false ), objectMemManager( 0 ), camera( 0 ), lodCamera( 0 ),
+            occlusionCuller( 0 )
         {
         }
         CullFrustumRequest( uint8 _firstRq, uint8 _lastRq, bool _casterPass,
@@ -123,7 +129,8 @@ namespace Ogre {
                             const Camera *_camera, const Camera *_lodCamera ) :
             firstRq( _firstRq ), lastRq( _lastRq ), casterPass( _casterPass ),
             addToRenderQueue( _addToRenderQueue ), cullingLights( _cullingLights ),
-            objectMemManager( _objectMemManager ), camera( _camera ), lodCamera( _lodCamera )
+            objectMemManager( _objectMemManager ), camera( _camera ), lodCamera( _lodCamera ),
+            occlusionCuller( 0 )
         {
         }
     };
@@ -405,6 +412,12 @@ namespace Ogre {
         */
         bool                    mStaticEntitiesDirty;
 
+        /// @see setIncrementalBoundsUpdate
+        bool                    mIncrementalBoundsUpdate;
+
+        /// @see setCullingHierarchyEnabled
+        bool                    mCullingHierarchyEnabled;
+
         PrePassMode             mPrePassMode;
         TextureGpuVec   mPrePassTextures;
         TextureGpu      *mPrePassDepthTexture;
@@ -522,6 +535,11 @@ namespace Ogre {
         /// For VR optimization
         RadialDensityMask *mRadialDensityMask;
 
+        OcclusionCuller *mOcclusionCuller;
+
+        /// Camera used to evaluate the animation LOD. @See setAnimationLodCamera
+        Camera const    *mAnimationLodCamera;
+
         // Fog
         FogMode mFogMode;
         ColourValue mFogColour;
@@ -796,6 +814,8 @@ namespace Ogre {
         {
             CULL_FRUSTUM,
             UPDATE_ALL_ANIMATIONS,
+            PREPARE_ALL_ANIMATIONS,
+            UPDATE_ALL_ANIMATION_TRANSFORMS,
             UPDATE_ALL_TRANSFORMS,
             UPDATE_ALL_BONE_TO_TAG_TRANSFORMS,
             UPDATE_ALL_TAG_ON_TAG_TRANSFORMS,
@@ -803,23 +823,71 @@ namespace Ogre {
             UPDATE_ALL_LODS,
             BUILD_LIGHT_LIST01,
             BUILD_LIGHT_LIST02,
+            UPDATE_ALL_PARTICLE_SYSTEMS,
             USER_UNIFORM_SCALABLE_TASK,
             STOP_THREADS,
             NUM_REQUESTS
         };
 
+        /// Executes mRequestType as a task of mRequestTaskGraph, one slice per worker thread.
+        class RequestTask : public UniformScalableTask
+        {
+            SceneManager *mSceneManager;
+        public:
+            RequestTask( SceneManager *sceneManager ) : mSceneManager( sceneManager ) {}
+            virtual void execute( size_t threadId, size_t numThreads );
+        };
+
+        /** One node of mSceneGraphTaskGraph. Processes a single depth level of a
+            NodeMemoryManager, or the bounds of a single ObjectMemoryManager.
+            @See updateAllTransformsAndBounds
+        */
+        struct SceneGraphTask : public UniformScalableTask
+        {
+            SceneManager        *sceneManager;
+            RequestType         requestType;
+            /// First node of the depth level (transform requests)
+            Transform           t;
+            size_t              numNodes;
+            /// Memory manager to process (bounds requests)
+            ObjectMemoryManager *objectMemoryManager;
+
+            SceneGraphTask() :
+                sceneManager( 0 ), requestType( NUM_REQUESTS ),
+                numNodes( 0 ), objectMemoryManager( 0 ) {}
+
+            virtual void execute( size_t sliceIdx, size_t numSlices );
+        };
+
+        typedef vector<SceneGraphTask>::type SceneGraphTaskVec;
+
         size_t  mNumWorkerThreads;
         bool    mForceMainThread;
 
+        RequestTask         mRequestTask;
+        /// Graph with a single task (mRequestTask). Used by fireWorkerThreadsAndWait
+        TaskGraph           mRequestTaskGraph;
+        /// Graph with the transform, animation, tag point & bounds phases
+        TaskGraph           mSceneGraphTaskGraph;
+        SceneGraphTaskVec   mSceneGraphTasks;
+        /// Graph the worker threads will execute when fired.
+        TaskGraph           *mCurrentTaskGraph;
+
         CullFrustumRequest              mCurrentCullFrustumRequest;
         UpdateLodRequest                mUpdateLodRequest;
-        UpdateTransformRequest          mUpdateTransformRequest;
-        ObjectMemoryManagerVec const    *mUpdateBoundsRequest;
         UniformScalableTask *mUserTask;
         RequestType         mRequestType;
         Barrier             *mWorkerThreadsBarrier;
         ThreadHandleVec     mWorkerThreads;
 
+        typedef vector<ParticleSystem*>::type ParticleSystemVec;
+        /// Particle systems waiting to be updated by the worker threads.
+        /// @see setParallelParticleSystemUpdates
+        ParticleSystemVec   mPendingParticleSystems;
+        size_t              mNextPendingParticleSystem;
+        LightweightMutex    mPendingParticleSystemsMutex;
+        bool                mParallelParticleSystemUpdates;
+
         /** Contains MovableObjects to be visited and rendered.
         @rermarks
             Declared here to avoid allocating and deallocating every frame. Declared as array of
@@ -836,6 +904,11 @@ namespace Ogre {
         */
         VisibleObjectsPerThreadArray mTmpVisibleObjects;
 
+        typedef vector<CullingHierarchy::BlockRangeArray>::type BlockRangeArrayPerThread;
+        /// Blocks that passed the CullingHierarchy test, one array per thread.
+        /// Declared here to avoid allocating every frame. @see setCullingHierarchyEnabled
+        BlockRangeArrayPerThread    mVisibleBlocksPerThread;
+
         /// Suppress render state changes?
         bool mSuppressRenderStateChanges;
 
@@ -888,14 +961,36 @@ namespace Ogre {
         typedef vector<EntityMaterialLodChangedEvent>::type EntityMaterialLodChangedEventList;
         EntityMaterialLodChangedEventList mEntityMaterialLodChangedEvents;
 
-        /** Updates the Animations from the given request inside a thread. @See updateAllAnimations
+        /** Samples the Animations from the given request inside a thread. @See updateAllAnimations
         @param threadIdx
             Thread index so we know at which point we should start at.
             Must be unique for each worker thread
         */
         void updateAllAnimationsThread( size_t threadIdx );
+
+        /** Copies the shared poses and updates the bones' derived transforms inside a thread.
+            Must run after updateAllAnimationsThread finished in all threads, since the
+            instance a pose is copied from may belong to a different thread.
+        @param threadIdx
+            Thread index. Must be unique for each worker thread
+        */
+        void updateAllAnimationTransformsThread( size_t threadIdx );
+
+        /** Updates the particle systems queued by ParticleSystem::_scheduleUpdate inside a thread.
+            Systems are handed out one at a time since their cost varies wildly.
+        @param threadIdx
+            Thread index. Must be unique for each worker thread
+        */
+        void updateAllParticleSystemsThread( size_t threadIdx );
         void updateAnimationTransforms( BySkeletonDef &bySkeletonDef, size_t threadIdx );
 
+        /** Evaluates the animation LOD of all SkeletonInstances and groups those that can share
+            their pose, before their animations are updated. Runs in a single thread since
+            LodStrategy::getValue may update the LOD camera.
+            @See setAnimationLod and SkeletonInstance::setAnimationSharingEnabled
+        */
+        void prepareAllAnimations(void);
+
         /** Updates the Nodes from the given request inside a thread. @See updateAllTransforms
         @param request
             Fully setup request. @See UpdateTransformRequest.
@@ -913,12 +1008,51 @@ namespace Ogre {
         void updateAllTransformsTagOnTagThread( const UpdateTransformRequest &request,
                                                 size_t threadIdx );
 
-        /** Updates the world aabbs from the given request inside a thread. @See updateAllTransforms
-        @param threadIdx
-            Thread index so we know at which point we should start at.
-            Must be unique for each worker thread
+        /** Updates the world aabbs of a portion of a single memory manager. @See updateAllBounds
+        @param sliceIdx
+            Which portion to update. Must be in range [0; numSlices)
+        @param numSlices
+            In how many portions the memory manager is being split.
         */
-        void updateAllBoundsThread( const ObjectMemoryManagerVec &objectMemManager, size_t threadIdx );
+        void updateBoundsSlice( ObjectMemoryManager *memoryManager, size_t sliceIdx, size_t numSlices );
+
+        /// Builds the upper levels of the CullingHierarchy of each render queue, once
+        /// updateBoundsSlice has run on all the slices of the given memory managers.
+        void updateCullingHierarchies( const ObjectMemoryManagerVec &objectMemManager );
+
+        /// Resets the dirty flags of the nodes in mNodeMemoryManagerUpdateList once
+        /// both their transforms and their objects' bounds have been updated.
+        void clearNodeDirtyFlags(void);
+
+        /// Returns in how many slices a task should be split to process numElements elements,
+        /// so that idle workers have something to steal but slices aren't too small.
+        size_t calculateNumSlices( size_t numElements ) const;
+
+        /** Adds to mSceneGraphTaskGraph one task per depth level of the given memory manager,
+            each depending on the previous level.
+        @param firstDepth
+            First depth level to update
+        @param dependsOn
+            Task the first level depends on. Can be TaskGraph::INVALID_TASK_ID
+        @return
+            Id of the last level's task, or dependsOn if there were no nodes to update.
+        */
+        TaskGraph::TaskId addTransformTasks( NodeMemoryManager *nodeMemoryManager, size_t firstDepth,
+                                             RequestType requestType, TaskGraph::TaskId dependsOn );
+
+        /// Adds to mSceneGraphTaskGraph the task to update the bounds of the given memory manager.
+        TaskGraph::TaskId addBoundsTask( ObjectMemoryManager *objectMemoryManager );
+
+        /// Adds to mSceneGraphTaskGraph the tasks to update all TagPoints.
+        /// @See addTransformTasks
+        TaskGraph::TaskId addTagPointTasks( TaskGraph::TaskId dependsOn );
+
+        /// Returns an upper bound of the tasks needed to update the whole scene graph
+        size_t getMaxSceneGraphTasks(void) const;
+
+        /// Clears mSceneGraphTaskGraph, ensuring there is enough room for numTasks
+        /// (we can't reallocate mSceneGraphTasks while building the graph)
+        void resetSceneGraphTasks( size_t numTasks );
 
         /**
         @param threadIdx
@@ -1178,6 +1312,31 @@ namespace Ogre {
         void setRadialDensityMask( bool bEnabled, const float radius[3] );
         RadialDensityMask* getRadialDensityMask(void) const     { return mRadialDensityMask; }
 
+        /** Returns the CPU occlusion culler. When it's enabled and has occluders, the
+            occluders are rasterized for every camera culled for a regular (non shadow) pass,
+            and the objects hidden behind them are not added to the RenderQueue.
+            See OcclusionCuller.
+        @remarks
+            Occluders must be destroyed before their nodes. clearScene destroys all of them.
+        */
+        OcclusionCuller* getOcclusionCuller(void) const         { return mOcclusionCuller; }
+
+        /** Sets the levels of detail of skeletal animations, so that characters far away or
+            small on screen are animated less often and with fewer bones.
+            See SkeletonAnimManager::setAnimationLod. The LOD is only evaluated while a
+            camera is set with setAnimationLodCamera.
+        @param lodStrategy
+            Null to disable (default).
+        */
+        void setAnimationLod( const LodStrategy *lodStrategy, const AnimationLodLevelVec &levels );
+
+        /** Sets the camera used to evaluate the animation LOD (its LOD camera is used,
+            see Camera::setLodCamera). Usually the main camera. Null to fully animate
+            everything. Cleared automatically when the camera is destroyed.
+        */
+        void setAnimationLodCamera( const Camera *camera )      { mAnimationLodCamera = camera; }
+        const Camera* getAnimationLodCamera(void) const         { return mAnimationLodCamera; }
+
         /** Gets the SceneNode at the root of the scene hierarchy.
             @remarks
                 The entire scene is held as a hierarchy of nodes, which
@@ -1866,10 +2025,18 @@ namespace Ogre {
         /** Updates all skeletal animations in the scene. This is typically called once
             per frame during render, but the user might want to manually call this function.
         @remarks
+            Animations are sampled first and the bones' derived transforms are updated in
+            a second pass, so that instances sharing a pose can copy it in between.
+        @par
             mSkeletonAnimManagerCulledList must be set. @See updateAllTransforms remarks
         */
         void updateAllAnimations();
 
+        /** Updates the particle systems queued during updateAllControllers in the worker
+            threads. Does nothing if there aren't any. @see setParallelParticleSystemUpdates
+        */
+        void updateAllParticleSystems();
+
         /** Updates the derived transforms of all nodes in the scene. This is typically called once
             per frame during render, but the user may want to manually call this function.
         @remarks
@@ -1899,6 +2066,20 @@ namespace Ogre {
         */
         void updateAllBounds( const ObjectMemoryManagerVec &objectMemManager );
 
+        /** Does the same as calling updateAllTransforms, updateAllAnimations, updateAllTagPoints
+            and updateAllBounds (for both entities and lights) in a row; but as a single TaskGraph
+            instead of one sync point per phase and depth level.
+        @remarks
+            Each phase only waits for what it actually depends on. e.g. Static nodes don't wait
+            for dynamic nodes, and the aabbs of static objects don't wait for skeletal animations.
+        @par
+            If there are SceneNodes with listeners, the phases are executed one after the other,
+            since listeners must be called from the main thread right after updating transforms.
+        @par
+            Same remarks as updateAllTransforms.
+        */
+        void updateAllTransformsAndBounds(void);
+
         /** Updates the Lod values of all objects relative to the given camera.
         */
         void updateAllLods( const Camera *lodCamera, Real lodBias, uint8 firstRq, uint8 lastRq );
@@ -2744,6 +2925,62 @@ namespace Ogre {
         */
         void executeUserScalableTask( UniformScalableTask *task, bool bBlock );
 
+        /** When enabled, ParticleSystems are simulated in the worker threads right after the
+            controllers are updated, instead of one after another in the main thread.
+        @remarks
+            All emitters & affectors in use (including custom ones) must be safe to run
+            concurrently with those of other particle systems, e.g. they must use
+            ParticleSystem::_getUnitRandom instead of Math::UnitRandom. The stock ones do.
+            Disabled by default.
+        */
+        void setParallelParticleSystemUpdates( bool bParallel );
+        bool getParallelParticleSystemUpdates(void) const   { return mParallelParticleSystemUpdates; }
+
+        /// Called by ParticleSystem::_scheduleUpdate. @see setParallelParticleSystemUpdates
+        void _queueParticleSystemUpdate( ParticleSystem *particleSystem );
+        /// Called by ~ParticleSystem if it's still waiting to be updated.
+        void _dequeueParticleSystemUpdate( ParticleSystem *particleSystem );
+
+        /** When enabled, the world bounds of dynamic MovableObjects are only recomputed when
+            their parent node moved, or their local bounds changed (see
+            MovableObject::_notifyLocalAabbDirty) instead of every frame.
+        @remarks
+            Node transforms are always updated incrementally; this only affects bounds.
+            Custom MovableObjects that write to ObjectData::mLocalAabb directly (instead of
+            using setLocalAabb) must call _notifyLocalAabbDirty afterwards, which is why
+            it's disabled by default. Static objects are unaffected; they're only updated
+            when notified through notifyStaticAabbDirty anyway.
+        */
+        void setIncrementalBoundsUpdate( bool bIncremental )    { mIncrementalBoundsUpdate = bIncremental; }
+        bool getIncrementalBoundsUpdate(void) const             { return mIncrementalBoundsUpdate; }
+
+        /** When enabled, the world bounds of each render queue are also gathered into a
+            CullingHierarchy while they're updated, and cullFrustum, cullLights and the light
+            list build (which also covers shadow map culling) skip whole groups of objects
+            that are outside the frustum instead of testing every object.
+        @remarks
+            The hierarchy follows the order in which objects are laid out in memory, so it
+            pays off when objects that are close to each other were created together (i.e.
+            large static scenes loaded area by area). Results are identical to the linear
+            cull either way.
+        @par
+            Disabled by default. Enabling it marks static objects as dirty, so that their
+            hierarchy gets built in the next update.
+        */
+        void setCullingHierarchyEnabled( bool bEnabled );
+        bool getCullingHierarchyEnabled(void) const             { return mCullingHierarchyEnabled; }
+
+        /** Executes a TaskGraph in the worker threads spawned by SceneManager.
+            Blocks until all tasks in the graph are done.
+        @remarks
+            Same restrictions as executeUserScalableTask apply: don't call this function
+            from another thread other than Ogre's main one, nor while there is a pending
+            user scalable task.
+        @param taskGraph
+            Graph to execute. It's left untouched after execution so it can be reused.
+        */
+        void executeTaskGraph( TaskGraph *taskGraph );
+
         /** Blocks until the the task from processUserScalableTask finishes.
         @remarks
             Do NOT call this function if you passed bBlock = true to processUserScalableTask
@@ -2781,6 +3018,15 @@ namespace Ogre {
         virtual void execute(RaySceneQueryListener* listener);
         bool execute( ObjectData objData, size_t numNodes, RaySceneQueryListener* listener );
 
+    protected:
+        /** Tests the ray against the triangles of movableObject, if it's an Item.
+        @param inOutDistance
+            In: the distance to the bounding box. Out: the distance to the closest triangle.
+        @return
+            False if the ray misses all triangles.
+        */
+        bool raycastTriangles( MovableObject *movableObject, Real &inOutDistance );
+
     private:
         using RaySceneQuery::execute;  // Shut up compiler warnings
     };
@@ -373,6 +373,7 @@ namespace Ogre {
     protected:
         Ray mRay;
         bool mSortByDistance;
+        bool mPrecise;
         ushort mMaxResults;
         RaySceneQueryResult mResult;
 
@@ -407,6 +408,17 @@ namespace Ogre {
         /** Gets the maximum number of results returned from the query (only relevant if 
         results are being sorted) */
         virtual ushort getMaxResults(void) const;
+        /** Sets whether the ray should be tested against the triangles of the objects whose
+            bounding volumes it hits.
+        @remarks
+            When true, objects are only returned if the ray hits one of their triangles,
+            and the distance is the distance to the closest triangle.
+            Only Items are tested this way (using SubMesh::getTriangleBvh, in their bind
+            pose). Other objects keep being returned based on their bounding volumes.
+            Default is false.
+        */
+        virtual void setPrecise( bool precise );
+        virtual bool getPrecise(void) const;
         /** Executes the query, returning the results back in one list.
         @remarks
             This method executes the scene query as configured, gathers the results
@@ -421,6 +421,47 @@ namespace Ogre
 
         // A pointer to the specific compiler instance used
         OGRE_THREAD_POINTER(ScriptCompiler, mScriptCompiler);
+
+    public:
+        /// 128-bit hash of the contents of a script
+        struct ParsedScriptHash
+        {
+            uint64 hashVal[2];
+
+            bool operator < ( const ParsedScriptHash &_r ) const
+            {
+                if( hashVal[0] < _r.hashVal[0] ) return true;
+                if( hashVal[0] > _r.hashVal[0] ) return false;
+
+                if( hashVal[1] < _r.hashVal[1] ) return true;
+
+                return false;
+            }
+        };
+
+        /// Bumped every time the binary layout of the parsed script cache changes
+        static const uint32 PARSED_SCRIPT_CACHE_VERSION;
+
+    private:
+        struct ParsedScript
+        {
+            /// The ConcreteNodeList in binary form, see serialiseNodes
+            MemoryDataStreamPtr data;
+            /// Whether it was used or added since the cache was loaded. Only these get saved.
+            bool used;
+        };
+        typedef map<ParsedScriptHash, ParsedScript>::type ParsedScriptMap;
+
+        // Parsed form of the scripts, indexed by the hash of their contents
+        ParsedScriptMap mParsedScriptCache;
+        bool mParsedScriptCacheEnabled;
+        bool mParsedScriptCacheDirty;
+        OGRE_MUTEX(mParsedScriptCacheMutex);
+
+        static ParsedScriptHash computeParsedScriptHash( const String &str );
+        static void serialiseNodes( const ConcreteNodeList &nodes, vector<uint8>::type &outData );
+        static bool deserialiseNodes( const uint8 *&data, const uint8 *dataEnd, const String &source,
+                                      ConcreteNode *parent, ConcreteNodeList &outNodes );
     public:
         ScriptCompilerManager();
         virtual ~ScriptCompilerManager();
@@ -461,6 +502,39 @@ namespace Ogre
         /// @copydoc ScriptLoader::getLoadingOrder
         Real getLoadingOrder(void) const;
 
+        /** Lexes and parses a script, or takes the result from the parsed script cache when
+            a script with the exact same contents was already parsed. Used by ScriptCompiler.
+        */
+        ConcreteNodeListPtr _parse( const String &str, const String &source );
+
+        /** Enables storing the parsed form of every compiled script (and imported file)
+            in the parsed script cache, so they can be saved with saveParsedScriptCache.
+        @remarks
+            Scripts are looked up by the hash of their contents, so when a file changes
+            it simply won't be found and gets parsed again; there's no need to invalidate
+            anything by hand. Loaded caches are used even when this is disabled.
+            Disabled by default.
+        */
+        void setParsedScriptCacheEnabled( bool enabled );
+        bool getParsedScriptCacheEnabled(void) const          { return mParsedScriptCacheEnabled; }
+
+        /// Returns true if scripts were added to the cache since it was loaded or saved.
+        bool isParsedScriptCacheDirty(void) const             { return mParsedScriptCacheDirty; }
+
+        /** Saves the parsed script cache. Only the scripts parsed or found in the cache
+            since it was loaded are saved, thus entries of files that changed or are no
+            longer used are dropped.
+        */
+        void saveParsedScriptCache( DataStreamPtr stream );
+
+        /** Loads a cache saved with saveParsedScriptCache, replacing the current one.
+            The stream is read in one go. Caches saved by a different version of the
+            binary layout are ignored.
+        */
+        void loadParsedScriptCache( DataStreamPtr stream );
+
+        void clearParsedScriptCache(void);
+
         /** Override standard Singleton retrieval.
         @remarks
         Why do we do this? Well, it's because the Singleton
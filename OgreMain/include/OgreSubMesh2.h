@@ -115,6 +115,10 @@ namespace Ogre {
         std::map<Ogre::String, size_t> mPoseIndexMap;
         TexBufferPacked *mPoseTexBuffer;
 
+        TriangleBvh *mTriangleBvh;
+        /// Set when getTriangleBvh failed, so it isn't retried until destroyTriangleBvh.
+        bool mTriangleBvhBuildFailed;
+
     public:
         SubMesh();
         ~SubMesh();
@@ -201,7 +205,26 @@ namespace Ogre {
         void dearrangeToInefficient(void);
 
         void _prepareForShadowMapping( bool forceSameBuffers );
-        
+
+        /** Returns a BVH over the triangles of mVao[VpNormal][0] (i.e. the first LOD), in mesh
+            space. It's built the first time this function gets called. Used by precise
+            RaySceneQueries, see RaySceneQuery::setPrecise.
+        @remarks
+            Building it downloads the vertex & index buffers from the GPU unless they have a
+            shadow copy, which stalls. Call this function while loading to avoid that later.
+            Poses and skeletal animation are not taken into account.
+            The BVH is freed whenever this SubMesh replaces its VAOs (importFromV1,
+            arrangeEfficient, etc).
+        @return
+            Null if there's no VAO or it isn't a triangle list. Failures are remembered
+            until destroyTriangleBvh is called.
+        */
+        const TriangleBvh* getTriangleBvh(void);
+        /** Frees the BVH created by getTriangleBvh (and forgets whether building it failed).
+            Call it if you modify the vertex data.
+        */
+        void destroyTriangleBvh(void);
+
         uint16 getNumPoses() { return mNumPoses; }
         
         bool getPoseHalfPrecision() { return mPoseHalfPrecision; }
@@ -92,6 +92,18 @@ namespace TextureFilter
                                    bool toSysRam );
         static void destroyFilters( FilterBaseArray &inOutFilters );
 
+        /** Runs, ahead of time, the filters that can safely be applied to the image before
+            processLoadRequest. Called by the decode worker threads, right after the image
+            was loaded from file, so that expensive work is done in parallel.
+        @remarks
+            Currently only SW mipmap generation qualifies, and only if no filter that
+            changes the pixel format would run before it. Once the image contains mipmaps,
+            GenerateSwMipmaps::_executeStreaming won't generate them again.
+        @param texture
+            Metadata of this texture may not be set yet. Only its settings are read.
+        */
+        static void _executeAhead( uint32 filters, Image2 &image, const TextureGpu *texture );
+
         /// Simulates as if the given filters were applied, producing
         /// the resulting number mipmaps & PixelFormat
         ///
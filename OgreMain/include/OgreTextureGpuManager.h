@@ -53,6 +53,7 @@ namespace Ogre
     */
 
     typedef vector<TextureGpu*>::type TextureGpuVec;
+    class Exception;
     class ObjCmdBuffer;
     class ResourceLoadingListener;
     class TextureGpuManagerListener;
@@ -311,6 +312,20 @@ namespace Ogre
 
         typedef vector<LoadRequest>::type LoadRequestVec;
 
+        /// A LoadRequest whose image was loaded from file ahead of time by the decode
+        /// worker threads. See setNumDecodeWorkerThreads
+        struct DecodedImage
+        {
+            /// Null if the LoadRequest provided its own image, or if decoding failed.
+            Image2      *image;
+            /// Not null if decoding failed.
+            Exception   *exception;
+
+            DecodedImage() : image( 0 ), exception( 0 ) {}
+        };
+
+        typedef vector<DecodedImage>::type DecodedImageVec;
+
         struct UsageStats
         {
             uint32 width;
@@ -444,6 +459,12 @@ namespace Ogre
             ///
             /// @see    TextureGpuManager::PartialImage
             PartialImageMap     partialImages;
+
+            /// Entry i contains the decoded image of the worker's ThreadData::loadRequests[i]
+            /// Can be smaller than loadRequests (requests not decoded yet).
+            ///
+            /// Used by worker thread. No protection needed (except in abortAllRequests).
+            DecodedImageVec     decodedImages;
         };
 
         enum TasksType
@@ -499,6 +520,16 @@ namespace Ogre
         ThreadData          mThreadData[2];
         StreamingData       mStreamingData;
 
+        /// See setNumDecodeWorkerThreads. The worker thread also participates.
+        ThreadHandleVec     mDecodeWorkerThreads;
+        Barrier             *mDecodeWorkerBarrier;
+        bool                mExitDecodeWorkerThreads;
+        /// Requests being decoded. Only valid while the decode workers are running.
+        LoadRequestVec const *mDecodeLoadRequests;
+        size_t              mNextDecodeJob;
+        size_t              mDecodeJobsEnd;
+        LightweightMutex    mDecodeJobsMutex;
+
         TexturePoolList     mTexturePool;
         ResourceEntryMap    mEntries;
         /// Protects mEntries
@@ -666,15 +697,43 @@ namespace Ogre
         void _releaseSlotFromTexture( TextureGpu *texture );
 
         unsigned long _updateStreamingWorkerThread( ThreadHandle *threadHandle );
+        unsigned long _updateDecodeWorkerThread( ThreadHandle *threadHandle );
     protected:
+        /// Opens the file referenced by the LoadRequest and loads it into outImage.
+        /// Throws on failure.
+        static void loadImage( const LoadRequest &loadRequest, Image2 &outImage );
+
+        /// Logs the exception, tells the main thread about it and loads a fallback image.
+        void handleLoadImageException( ObjCmdBuffer *commandBuffer, const LoadRequest &loadRequest,
+                                       const Exception &e, Image2 &outImage );
+
+        /// Loads the image from file (and runs the filters that can be run ahead of time).
+        /// Called from decode worker threads.
+        void decodeLoadRequest( const LoadRequest &loadRequest, DecodedImage &outDecodedImage );
+
+        /// Grabs LoadRequests from mDecodeLoadRequests until there's none left.
+        void decodeWorkerThreadImpl(void);
+
+        /// Decodes in parallel workerData.loadRequests[i] for all i in range
+        /// [mStreamingData.decodedImages.size(); numToDecode)
+        /// Must be called from worker thread.
+        void decodeLoadRequests( const ThreadData &workerData, size_t numToDecode );
+
+        /// Frees the first numEntries of mStreamingData.decodedImages and removes them.
+        void releaseDecodedImages( size_t numEntries );
+
+        void startDecodeWorkerThreads( size_t numThreads );
+        void stopDecodeWorkerThreads(void);
+
         /// This function processes a load request coming from main thread. It basically
         /// gets called once per Image to load. Usually that means once per texture,
         /// but in the case of Cubemaps being made up from multiple separate images,
         /// it may be called once per face.
         /// Must be called from worker thread.
         /// workerData is needed to pass it on to processQueuedImage
+        /// decodedImage is the image already loaded by decode worker threads. Can be null.
         void processLoadRequest( ObjCmdBuffer *commandBuffer, ThreadData &workerData,
-                                 const LoadRequest &loadRequest );
+                                 const LoadRequest &loadRequest, DecodedImage *decodedImage );
     public:
         void _updateStreaming(void);
 
@@ -1051,6 +1110,28 @@ namespace Ogre
         */
         void setWorkerThreadMaxPerStagingTextureRequestBytes( size_t maxPerStagingTextureRequestBytes );
 
+        /** By default, a single worker thread loads images from file (decoding PNG, JPG, etc
+            via the codecs), generates their SW mipmaps, and uploads them to StagingTextures.
+
+            This function spawns additional threads that load the images from file and
+            generate their SW mipmaps in parallel, ahead of the worker thread. The worker
+            thread still performs the uploads, one request at a time in the same order.
+        @remarks
+            Each iteration, the worker thread decodes ahead as many requests as threads
+            there are (including itself), or mEntriesToProcessPerIteration if bigger;
+            and then processes all of them. No images are decoded ahead once the preload
+            budget (see setWorkerThreadMaxPreloadBytes) has been exhausted.
+
+            ResourceLoadingListener::grouplessResourceLoading & grouplessResourceOpened
+            will be called from multiple threads at the same time.
+
+            Must be called from main thread.
+        @param numThreads
+            Number of additional threads. 0 to disable (default).
+        */
+        void setNumDecodeWorkerThreads( size_t numThreads );
+        size_t getNumDecodeWorkerThreads(void) const    { return mDecodeWorkerThreads.size(); }
+
         /** The main thread tries to acquire a lock from the background thread,
             do something very quick, and release it.
 
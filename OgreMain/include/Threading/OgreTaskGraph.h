@@ -0,0 +1,166 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#ifndef _OgreTaskGraph_H_
+#define _OgreTaskGraph_H_
+
+#include "OgrePrerequisites.h"
+#include "Threading/OgreLightweightMutex.h"
+#include "ogrestd/deque.h"
+#include "ogrestd/vector.h"
+
+namespace Ogre
+{
+    class UniformScalableTask;
+
+    /** A TaskGraph is a set of UniformScalableTasks with dependency edges between them,
+        executed by a pool of worker threads (usually SceneManager's).
+    @remarks
+        Each task is split into a number of slices. All slices of a task may run in parallel,
+        and a task can only start once all slices of every task it depends on have finished.
+        Independent tasks run concurrently, which means there is no implicit sync point
+        between phases: e.g. the world aabbs of static objects can be updated while dynamic
+        nodes are still being transformed.
+    @par
+        Every worker thread owns a queue of slices ready to run. Workers pop from the back
+        of their own queue (which is most likely hot in the cache since it was pushed by
+        the same thread) and when empty, they steal from the front of the other workers'
+        queues. Slices of a task that become ready are pushed to the queue of the thread
+        that completed the last dependency.
+    @par
+        UniformScalableTask::execute receives the slice index and the number of slices
+        instead of a thread index. Two slices with the same index never run at the same
+        time, thus slice indices can still be used to index per-thread scratch data as long
+        as the number of slices is not bigger than the scratch data.
+    @par
+        The graph must be acyclic. Tasks and edges are kept after execution; so the same
+        graph can be executed again (i.e. every frame) without rebuilding it.
+        Use clear() to start over.
+    */
+    class _OgreExport TaskGraph
+    {
+    public:
+        typedef uint32 TaskId;
+        static const TaskId INVALID_TASK_ID = 0xFFFFFFFF;
+
+    protected:
+        struct Task
+        {
+            UniformScalableTask *task;
+            uint32              numSlices;
+            /// Slices not yet finished in the current execution.
+            uint32              numPendingSlices;
+            /// Dependencies not yet finished in the current execution.
+            uint32              numPendingDependencies;
+            /// Total number of tasks this one depends on.
+            uint32              numDependencies;
+            FastArray<TaskId>   successors;
+        };
+
+        struct Job
+        {
+            TaskId  taskId;
+            uint32  sliceIdx;
+            Job() : taskId( 0 ), sliceIdx( 0 ) {}
+            Job( TaskId _taskId, uint32 _sliceIdx ) : taskId( _taskId ), sliceIdx( _sliceIdx ) {}
+        };
+
+        typedef deque<Job>::type JobDeque;
+
+        struct WorkerQueue
+        {
+            LightweightMutex    mutex;
+            JobDeque            jobs;
+        };
+
+        typedef vector<Task>::type          TaskVec;
+        typedef vector<WorkerQueue*>::type  WorkerQueueVec;
+
+        TaskVec             mTasks;
+        WorkerQueueVec      mWorkerQueues;
+
+        /// Protects the counters in mTasks during execution.
+        LightweightMutex    mGraphMutex;
+        /// Tasks not yet finished in the current execution. Idle workers poll it without
+        /// holding mGraphMutex, thus it must only be accessed via the atomic helpers in
+        /// OgreTaskGraph.cpp
+        long                mNumPendingTasks;
+
+        void pushJobs( size_t workerIdx, TaskId taskId );
+        bool popJob( size_t workerIdx, Job &outJob );
+        bool stealJob( size_t workerIdx, Job &outJob );
+        void runJob( size_t workerIdx, const Job &job );
+
+    public:
+        TaskGraph();
+        ~TaskGraph();
+
+        /** Adds a task to the graph.
+        @param task
+            Task to execute. Pointer must be valid at least until the graph is cleared.
+        @param numSlices
+            Number of times task->execute will be called, each with a different slice index.
+            The task is responsible of splitting its work using the slice index.
+            Must be > 0.
+        @return
+            Id of the task, to be used with addDependency.
+        */
+        TaskId addTask( UniformScalableTask *task, size_t numSlices );
+
+        /** Tells that 'task' can't start until 'dependsOn' has completely finished.
+        @remarks
+            Adding the same edge twice is harmless, but wasteful.
+            If dependsOn is INVALID_TASK_ID, nothing happens. This is useful when
+            building graphs where some of the phases may be missing.
+        */
+        void addDependency( TaskId task, TaskId dependsOn );
+
+        /// Removes all tasks and edges.
+        void clear(void);
+
+        size_t getNumTasks(void) const          { return mTasks.size(); }
+
+        /** Resets the counters of all tasks and distributes the tasks without dependencies
+            among the queues of each worker. Must be called from the main thread before
+            waking up the workers.
+        @param numWorkers
+            Number of worker threads that will call _executeWorker.
+        */
+        void _prepareExecution( size_t numWorkers );
+
+        /** Called from each worker thread. Executes (and steals) slices until the whole
+            graph has been processed.
+        @param workerIdx
+            Index of the worker. Must be in range [0; numWorkers) as passed to
+            _prepareExecution, and unique for each thread.
+        */
+        void _executeWorker( size_t workerIdx );
+    };
+}
+
+#endif
@@ -47,11 +47,17 @@ namespace Ogre
     public:
         /** Overload this function to perform whatever you want. It will be
             called from all worker threads at the same time.
+        @remarks
+            Tasks are executed through a TaskGraph. Therefore threadId is actually the
+            index of the slice of work to perform; and a worker that finishes early
+            may execute more than one slice (i.e. don't use a barrier inside execute to
+            wait for the other threads). Two calls with the same threadId never run
+            concurrently, so it is still safe to use it to index per-thread data.
         @param threadId
-            The index of the thread it is being called from. An index is
+            The index of the slice being executed. An index is
             guaranteed to be in range [0; numThreads)
         @param numThreads
-            Number of total threads
+            Number of total slices
         */
         virtual void execute( size_t threadId, size_t numThreads ) = 0;
     };
@@ -33,6 +33,9 @@ THE SOFTWARE.
 #include "Animation/OgreSkeletonAnimManager.h"
 #include "Animation/OgreSkeletonDef.h"
 #include "Animation/OgreSkeletonInstance.h"
+#include "OgreCamera.h"
+#include "OgreLodStrategy.h"
+#include "OgreMovableObject.h"
 
 namespace Ogre
 {
@@ -85,7 +88,185 @@ namespace Ogre
             ++itor;
         }
     }
+    //-----------------------------------------------------------------------
+    void BySkeletonDef::_getAnimationLod( const AnimationLodLevelVec &lodLevels, Real lodValue,
+                                          uint16 &outUpdateInterval, uint16 &outMaxBoneDepth )
+    {
+        outUpdateInterval   = 1u;
+        outMaxBoneDepth     = 0xFFFF;
+
+        //lodLevels is sorted in ascending order (i.e. less detail as we go)
+        AnimationLodLevelVec::const_iterator itor = lodLevels.begin();
+        AnimationLodLevelVec::const_iterator end  = lodLevels.end();
+        while( itor != end && itor->lodValue <= lodValue )
+        {
+            outUpdateInterval   = itor->updateInterval;
+            outMaxBoneDepth     = itor->maxBoneDepth;
+            ++itor;
+        }
+    }
+    //-----------------------------------------------------------------------
+    bool BySkeletonDef::_isAnimationFrame( uint16 updateInterval, uint32 frameCount,
+                                           size_t instanceIdx )
+    {
+        //Using the index as offset spreads instances with the same interval
+        //evenly across frames. The index only changes when instances are
+        //created or destroyed, which at worst delays an update once.
+        return updateInterval <= 1u || (frameCount + instanceIdx) % updateInterval == 0u;
+    }
+    //-----------------------------------------------------------------------
+    void BySkeletonDef::_updateAnimationLod( const LodStrategy *lodStrategy,
+                                             const AnimationLodLevelVec &lodLevels,
+                                             const Camera *lodCamera, uint32 frameCount )
+    {
+        const size_t numSkeletons = skeletons.size();
+        for( size_t i=0; i<numSkeletons; ++i )
+        {
+            SkeletonInstance *skeleton = skeletons[i];
+            const MovableObject *lodObject = skeleton->_getLodObject();
+
+            uint16 updateInterval   = 1u;
+            uint16 maxBoneDepth     = 0xFFFF;
+
+            if( lodStrategy && lodCamera && lodObject && skeleton->getAnimationLodEnabled() &&
+                lodObject->getParentNode() )
+            {
+                const Real lodValue = lodStrategy->getValue( lodObject, lodCamera );
+                _getAnimationLod( lodLevels, lodValue, updateInterval, maxBoneDepth );
+            }
+
+            skeleton->_setAnimationLod( _isAnimationFrame( updateInterval, frameCount, i ),
+                                        maxBoneDepth );
+        }
+    }
+    //-----------------------------------------------------------------------
+    size_t BySkeletonDef::_updateSharedAnimations(void)
+    {
+        sharedPoseKeys.clear();
+
+        FastArray<SkeletonInstance*>::const_iterator itor = skeletons.begin();
+        FastArray<SkeletonInstance*>::const_iterator end  = skeletons.end();
+
+        while( itor != end )
+        {
+            SkeletonInstance *skeleton = *itor;
+            skeleton->_setSharedPoseSource( 0 );
+
+            if( skeleton->getAnimationSharingEnabled() && skeleton->_getAnimateThisFrame() &&
+                !skeleton->getActiveAnimations().empty() )
+            {
+                sharedPoseKeys.push_back( SharedPoseKey( skeleton->_getAnimationStateHash(),
+                                                         skeleton ) );
+            }
+
+            ++itor;
+        }
+
+        std::sort( sharedPoseKeys.begin(), sharedPoseKeys.end() );
+
+        //Every instance copies from the first one in its run of equal hashes that has
+        //the same state. Collisions are rare, so usually the first one of the run matches.
+        size_t numShared = 0;
+        size_t runStart = 0;
+        const size_t numKeys = sharedPoseKeys.size();
+        for( size_t i=1; i<numKeys; ++i )
+        {
+            if( sharedPoseKeys[i].hash != sharedPoseKeys[runStart].hash )
+            {
+                runStart = i;
+                continue;
+            }
+
+            SkeletonInstance *skeleton = sharedPoseKeys[i].skeleton;
+            for( size_t j=runStart; j<i; ++j )
+            {
+                const SkeletonInstance *leader = sharedPoseKeys[j].skeleton;
+                if( !leader->_getSharedPoseSource() && skeleton->_hasSameAnimationState( leader ) )
+                {
+                    skeleton->_setSharedPoseSource( leader );
+                    ++numShared;
+                    break;
+                }
+            }
+        }
+
+        return numShared;
+    }
+
+    //-----------------------------------------------------------------------
+    SkeletonAnimManager::SkeletonAnimManager() :
+        lodStrategy( 0 ),
+        frameCount( 0 )
+    {
+    }
+    //-----------------------------------------------------------------------
+    void SkeletonAnimManager::setAnimationLod( const LodStrategy *_lodStrategy,
+                                               const AnimationLodLevelVec &levels )
+    {
+        lodStrategy = _lodStrategy;
+        lodLevels.clear();
+
+        if( lodStrategy )
+        {
+            lodLevels.reserve( levels.size() );
+            AnimationLodLevelVec::const_iterator itor = levels.begin();
+            AnimationLodLevelVec::const_iterator end  = levels.end();
+            while( itor != end )
+            {
+                assert( itor->updateInterval >= 1u && "updateInterval must be at least 1" );
+
+                AnimationLodLevel lodLevel( *itor );
+                lodLevel.lodValue = lodStrategy->transformUserValue( itor->lodValue );
+                lodLevel.updateInterval = std::max<uint16>( lodLevel.updateInterval, 1u );
+
+                AnimationLodLevelVec::iterator it = lodLevels.begin();
+                while( it != lodLevels.end() && it->lodValue <= lodLevel.lodValue )
+                    ++it;
+                lodLevels.insert( it, lodLevel );
+                ++itor;
+            }
+        }
+        else
+        {
+            //Restore full animation on the instances we won't be visiting anymore
+            _updateAnimationLod( 0 );
+        }
+    }
+    //-----------------------------------------------------------------------
+    void SkeletonAnimManager::_updateAnimationLod( const Camera *lodCamera )
+    {
+        //The strategies may need the viewport the LOD camera last rendered to (e.g. pixel
+        //count), which doesn't exist before its first pass. Fully animate until then.
+        if( lodCamera && !lodCamera->getLodCamera()->getLastViewport() )
+            lodCamera = 0;
+
+        BySkeletonDefList::iterator itor = bySkeletonDefs.begin();
+        BySkeletonDefList::iterator end  = bySkeletonDefs.end();
+
+        while( itor != end )
+        {
+            itor->_updateAnimationLod( lodStrategy, lodLevels, lodCamera, frameCount );
+            ++itor;
+        }
+
+        ++frameCount;
+    }
+    //-----------------------------------------------------------------------
+    size_t SkeletonAnimManager::_updateSharedAnimations(void)
+    {
+        size_t numShared = 0;
+
+        BySkeletonDefList::iterator itor = bySkeletonDefs.begin();
+        BySkeletonDefList::iterator end  = bySkeletonDefs.end();
+
+        while( itor != end )
+        {
+            numShared += itor->_updateSharedAnimations();
+            ++itor;
+        }
 
+        return numShared;
+    }
     //-----------------------------------------------------------------------
     SkeletonInstance* SkeletonAnimManager::createSkeletonInstance( const SkeletonDef *skeletonDef,
                                                                     size_t numWorkerThreads )
@@ -307,7 +307,8 @@ namespace Ogre
         }
     }
     //-----------------------------------------------------------------------------------
-    void SkeletonAnimation::_applyAnimation( const TransformArray &boneTransforms )
+    void SkeletonAnimation::_applyAnimation( const TransformArray &boneTransforms,
+                                             uint16 maxBoneDepth )
     {
         SkeletonTrackVec::const_iterator itor = mDefinition->mTracks.begin();
         SkeletonTrackVec::const_iterator end  = mDefinition->mTracks.end();
@@ -317,7 +318,11 @@ namespace Ogre
         ArrayReal simdWeight = Mathlib::SetAll( mWeight );
         ArrayReal * RESTRICT_ALIAS boneWeights = mBoneWeights.get();
 
-        while( itor != end )
+        //Tracks are sorted by depth level (it's in the high bits of the block index)
+        const uint32 lastBlockIdx = ( (uint32)std::min<uint16>( maxBoneDepth, 0xFF ) << 24u ) |
+                                    0x00FFFFFF;
+
+        while( itor != end && itor->getBoneBlockIdx() <= lastBlockIdx )
         {
             itor->applyKeyFrameRigAt( *itLastKnownKeyFrame, mCurrentFrame, simdWeight,
                                         boneWeights, boneTransforms );
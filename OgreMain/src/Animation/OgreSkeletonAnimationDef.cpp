@@ -65,7 +65,7 @@ namespace Ogre
     }
     //-----------------------------------------------------------------------------------
     void SkeletonAnimationDef::build( const v1::Skeleton *skeleton, const v1::Animation *animation,
-                                      Real frameRate )
+                                      Real frameRate, const SkeletonTrackCompression *compression )
     {
         mOriginalFrameRate = frameRate;
         mNumFrames = animation->getLength() * frameRate;
@@ -219,6 +219,46 @@ namespace Ogre
 
             ++itTrack;
         }
+
+        if( compression )
+            compress( *compression );
+    }
+    //-----------------------------------------------------------------------------------
+    void SkeletonAnimationDef::compress( const SkeletonTrackCompression &settings )
+    {
+        SkeletonTrackVec::iterator itor = mTracks.begin();
+        SkeletonTrackVec::iterator end  = mTracks.end();
+
+        while( itor != end )
+        {
+            if( !itor->isCompressed() )
+                itor->_compress( settings );
+            ++itor;
+        }
+
+        //No track references the uncompressed keyframes anymore
+        if( mKfTransformMemoryManager )
+        {
+            mKfTransformMemoryManager->destroy();
+            delete mKfTransformMemoryManager;
+            mKfTransformMemoryManager = 0;
+        }
+    }
+    //-----------------------------------------------------------------------------------
+    size_t SkeletonAnimationDef::getKeyFrameMemoryUsage(void) const
+    {
+        size_t retVal = 0;
+
+        SkeletonTrackVec::const_iterator itor = mTracks.begin();
+        SkeletonTrackVec::const_iterator end  = mTracks.end();
+
+        while( itor != end )
+        {
+            retVal += itor->getKeyFrameMemoryUsage();
+            ++itor;
+        }
+
+        return retVal;
     }
     //-----------------------------------------------------------------------------------
     void SkeletonAnimationDef::getInterpolatedUnnormalizedKeyFrame( v1::OldNodeAnimationTrack *oldTrack,
@@ -412,22 +452,14 @@ namespace Ogre
                     outText += boneDef.name;
                     outText += ",";
 
-                    KeyFrameRigVec::const_iterator itKeyFrames = keyFrames.begin();
-                    KeyFrameRigVec::const_iterator enKeyFrames = keyFrames.end();
-
-                    while( itKeyFrames != enKeyFrames )
+                    for( size_t j=0; j<keyFrames.size(); ++j )
                     {
-                        outText += StringConverter::toString( itKeyFrames->mFrame );
+                        outText += StringConverter::toString( keyFrames[j].mFrame );
                         outText += ",";
 
-                        const KfTransform * RESTRICT_ALIAS boneTransform = itKeyFrames->mBoneTransform;
-
                         Vector3 vPos, vScale;
                         Quaternion qRot;
-
-                        boneTransform->mPosition.getAsVector3( vPos, i );
-                        boneTransform->mOrientation.getAsQuaternion( qRot, i );
-                        boneTransform->mScale.getAsVector3( vScale, i );
+                        track.getKeyFrameTransform( j, i, vPos, qRot, vScale );
 
                         outText += StringConverter::toString( vPos.x ) + ",";
                         outText += StringConverter::toString( vPos.y ) + ",";
@@ -439,7 +471,6 @@ namespace Ogre
                         outText += StringConverter::toString( vScale.x ) + ",";
                         outText += StringConverter::toString( vScale.y ) + ",";
                         outText += StringConverter::toString( vScale.z ) + ",";
-                        ++itKeyFrames;
                     }
 
                     outText += "\n";
@@ -41,7 +41,8 @@ THE SOFTWARE.
 
 namespace Ogre
 {
-    SkeletonDef::SkeletonDef( const v1::Skeleton *originalSkeleton, Real frameRate ) :
+    SkeletonDef::SkeletonDef( const v1::Skeleton *originalSkeleton, Real frameRate,
+                              const SkeletonTrackCompression *compression ) :
         mNumUnusedSlots( 0 ),
         mName( originalSkeleton->getName() )
     {
@@ -127,7 +128,8 @@ namespace Ogre
         {
             mAnimationDefs[i]._setSkeletonDef( this );
             mAnimationDefs[i].setName( originalSkeleton->getAnimation( i )->getName() );
-            mAnimationDefs[i].build( originalSkeleton, originalSkeleton->getAnimation( i ), frameRate );
+            mAnimationDefs[i].build( originalSkeleton, originalSkeleton->getAnimation( i ), frameRate,
+                                     compression );
         }
 
         //Create the bones (just like we would for SkeletonInstance)so we can
@@ -45,7 +45,13 @@ namespace Ogre
                                         BoneMemoryManager *boneMemoryManager ) :
             mDefinition( skeletonDef ),
             mParentNode( 0 ),
-            mRefCount( 1 )
+            mRefCount( 1 ),
+            mLodObject( 0 ),
+            mAnimationLodEnabled( true ),
+            mAnimateThisFrame( true ),
+            mLodMaxBoneDepth( 0xFFFF ),
+            mAnimationSharingEnabled( false ),
+            mSharedPoseSource( 0 )
     {
         mBones.resize( mDefinition->getBones().size(), Bone() );
 
@@ -234,20 +240,102 @@ namespace Ogre
     //-----------------------------------------------------------------------------------
     void SkeletonInstance::update(void)
     {
+        //Skipped frames keep the last pose. The derived transforms are still updated
+        //by SceneManager::updateAnimationTransforms, thus we follow our node anyway.
+        //Shared poses get copied later, in _copySharedPose.
+        if( !mAnimateThisFrame || mSharedPoseSource )
+            return;
+
         if( !mActiveAnimations.empty() )
-            resetToPose();
+            resetToPose( std::min<size_t>( mLodMaxBoneDepth + 1u, mBoneStartTransforms.size() ) );
 
         ActiveAnimationsVec::iterator itor = mActiveAnimations.begin();
         ActiveAnimationsVec::iterator end  = mActiveAnimations.end();
 
         while( itor != end )
         {
-            (*itor)->_applyAnimation( mBoneStartTransforms );
+            (*itor)->_applyAnimation( mBoneStartTransforms, mLodMaxBoneDepth );
             ++itor;
         }
     }
     //-----------------------------------------------------------------------------------
+    uint32 SkeletonInstance::_getAnimationStateHash(void) const
+    {
+        uint32 retVal = HashCombine( 0, mLodMaxBoneDepth );
+
+        ActiveAnimationsVec::const_iterator itor = mActiveAnimations.begin();
+        ActiveAnimationsVec::const_iterator end  = mActiveAnimations.end();
+
+        while( itor != end )
+        {
+            const SkeletonAnimation *animation = *itor;
+            retVal = HashCombine( retVal, animation->getDefinition() );
+            retVal = HashCombine( retVal, animation->getCurrentFrame() );
+            retVal = HashCombine( retVal, animation->mWeight );
+            ++itor;
+        }
+
+        return retVal;
+    }
+    //-----------------------------------------------------------------------------------
+    bool SkeletonInstance::_hasSameAnimationState( const SkeletonInstance *other ) const
+    {
+        if( mDefinition != other->mDefinition ||
+            mLodMaxBoneDepth != other->mLodMaxBoneDepth ||
+            mActiveAnimations.size() != other->mActiveAnimations.size() )
+        {
+            return false;
+        }
+
+        //The order matters; blending isn't commutative
+        ActiveAnimationsVec::const_iterator itor = mActiveAnimations.begin();
+        ActiveAnimationsVec::const_iterator end  = mActiveAnimations.end();
+        ActiveAnimationsVec::const_iterator itOther = other->mActiveAnimations.begin();
+
+        while( itor != end )
+        {
+            if( (*itor)->getDefinition() != (*itOther)->getDefinition() ||
+                (*itor)->getCurrentFrame() != (*itOther)->getCurrentFrame() ||
+                (*itor)->mWeight != (*itOther)->mWeight )
+            {
+                return false;
+            }
+            ++itor;
+            ++itOther;
+        }
+
+        return true;
+    }
+    //-----------------------------------------------------------------------------------
+    void SkeletonInstance::_copySharedPose(void)
+    {
+        if( !mSharedPoseSource || !mAnimateThisFrame )
+            return;
+
+        assert( mSharedPoseSource->mDefinition == mDefinition );
+
+        //Bones from different instances sit in different SIMD lanes,
+        //so they need to be copied one by one.
+        const size_t numBones = mBones.size();
+        for( size_t i=0; i<numBones; ++i )
+        {
+            Bone &bone = mBones[i];
+            if( bone.getDepthLevel() <= mLodMaxBoneDepth )
+            {
+                const Bone &srcBone = mSharedPoseSource->mBones[i];
+                bone.setPosition( srcBone.getPosition() );
+                bone.setOrientation( srcBone.getOrientation() );
+                bone.setScale( srcBone.getScale() );
+            }
+        }
+    }
+    //-----------------------------------------------------------------------------------
     void SkeletonInstance::resetToPose(void)
+    {
+        resetToPose( mBoneStartTransforms.size() );
+    }
+    //-----------------------------------------------------------------------------------
+    void SkeletonInstance::resetToPose( size_t numDepthLevels )
     {
         KfTransform const * RESTRICT_ALIAS bindPose = mDefinition->getBindPose();
         ArrayReal const * RESTRICT_ALIAS manualBones = mManualBones.get();
@@ -256,7 +344,7 @@ namespace Ogre
                                                 mDefinition->getDepthLevelInfo().begin();
 
         TransformArray::iterator itor = mBoneStartTransforms.begin();
-        TransformArray::iterator end  = mBoneStartTransforms.end();
+        TransformArray::iterator end  = mBoneStartTransforms.begin() + numDepthLevels;
 
         while( itor != end )
         {
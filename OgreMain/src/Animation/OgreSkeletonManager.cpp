@@ -45,7 +45,8 @@ namespace Ogre
         assert( msSingleton );  return ( *msSingleton );  
     }
     //-----------------------------------------------------------------------
-    SkeletonManager::SkeletonManager()
+    SkeletonManager::SkeletonManager() :
+        mCompressKeyFrames( false )
     {
     }
     //-----------------------------------------------------------------------
@@ -61,7 +62,8 @@ namespace Ogre
         if( itor == mSkeletonDefs.end() )
         {
             oldSkeletonBase->load();
-            retVal = SkeletonDefPtr( new SkeletonDef( oldSkeletonBase, 1.0f ) );
+            retVal = SkeletonDefPtr( new SkeletonDef( oldSkeletonBase, 1.0f,
+                                                      getKeyFrameCompression() ) );
             mSkeletonDefs[idName] = retVal;
         }
         else
@@ -94,7 +96,8 @@ namespace Ogre
             oldSkeleton->load();
             if( oldSkeleton->isLoaded() )
             {
-                retVal = SkeletonDefPtr( new SkeletonDef( oldSkeleton.get(), 1.0f ) );
+                retVal = SkeletonDefPtr( new SkeletonDef( oldSkeleton.get(), 1.0f,
+                                                          getKeyFrameCompression() ) );
                 if( wasUnloaded )
                     oldSkeleton->unload();
                 if( wasNonExistent )
@@ -111,6 +114,13 @@ namespace Ogre
         return retVal;
     }
     //-----------------------------------------------------------------------
+    void SkeletonManager::setKeyFrameCompression( const SkeletonTrackCompression *compression )
+    {
+        mCompressKeyFrames = compression != 0;
+        if( compression )
+            mKeyFrameCompression = *compression;
+    }
+    //-----------------------------------------------------------------------
     void SkeletonManager::add( SkeletonDefPtr skeletonDef )
     {
         IdString idName( skeletonDef->getNameStr() );
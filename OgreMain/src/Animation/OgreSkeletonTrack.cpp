@@ -38,13 +38,27 @@ THE SOFTWARE.
 
 namespace Ogre
 {
+    /// Number of ArrayReals used by the constant channels at the start of mCompressedData
+    static const size_t c_compressedHeaderSize = sizeof( KfTransform ) / sizeof( ArrayReal );
+    static const Real c_quantisationScale = 32767.0f;
+    static const Real c_invQuantisationScale = 1.0f / 32767.0f;
+
+    static inline int16 quantiseComponent( Real value )
+    {
+        return static_cast<int16>( Math::Floor( Math::Clamp( value, Real( -1.0f ), Real( 1.0f ) ) *
+                                                c_quantisationScale + 0.5f ) );
+    }
+    //-----------------------------------------------------------------------------------
     SkeletonTrack::SkeletonTrack( uint32 boneBlockIdx,
                                     KfTransformArrayMemoryManager *kfTransformMemoryManager ) :
         mKeyFrameRigs( 0 ),
         mNumFrames( 0 ),
         mBoneBlockIdx( boneBlockIdx ),
         mUsedSlots( 0 ),
-        mLocalMemoryManager( kfTransformMemoryManager )
+        mLocalMemoryManager( kfTransformMemoryManager ),
+        mCompressedStride( 0 ),
+        mAnimatedChannels( 0 ),
+        mQuantisedOrientations( false )
     {
     }
     //-----------------------------------------------------------------------------------
@@ -59,6 +73,7 @@ namespace Ogre
     //-----------------------------------------------------------------------------------
     void SkeletonTrack::addKeyFrame( Real timestamp, Real frameRate )
     {
+        assert( !isCompressed() && "Can't add keyframes to a compressed track" );
         assert( mKeyFrameRigs.empty() || timestamp > mKeyFrameRigs.back().mFrame );
 
         mKeyFrameRigs.push_back( KeyFrameRig() );
@@ -77,6 +92,8 @@ namespace Ogre
     void SkeletonTrack::setKeyFrameTransform( Real frame, uint32 slot, const Vector3 &vPos,
                                                 const Quaternion &qRot, const Vector3 vScale )
     {
+        assert( !isCompressed() && "Can't modify the keyframes of a compressed track" );
+
         KeyFrameRigVec::iterator itor = mKeyFrameRigs.begin();
         KeyFrameRigVec::iterator end  = mKeyFrameRigs.end();
 
@@ -96,6 +113,17 @@ namespace Ogre
         mUsedSlots = std::max( slot+1, mUsedSlots );
     }
     //-----------------------------------------------------------------------------------
+    size_t SkeletonTrack::getKeyFrameMemoryUsage(void) const
+    {
+        if( mCompressedData.get() )
+        {
+            return ( c_compressedHeaderSize + mKeyFrameRigs.size() * mCompressedStride ) *
+                    sizeof( ArrayReal );
+        }
+
+        return mKeyFrameRigs.size() * sizeof( KfTransform );
+    }
+    //-----------------------------------------------------------------------------------
     inline void SkeletonTrack::getKeyFrameRigAt( KeyFrameRigVec::const_iterator &inOutPrevFrame,
                                                     KeyFrameRigVec::const_iterator &outNextFrame,
                                                     Real frame ) const
@@ -137,17 +165,79 @@ namespace Ogre
         ArrayVector3 * RESTRICT_ALIAS finalScale    = boneTransforms[level].mScale + offset;
         ArrayQuaternion * RESTRICT_ALIAS finalRot   = boneTransforms[level].mOrientation + offset;
 
-        KfTransform * RESTRICT_ALIAS prevTransf = prevFrame->mBoneTransform;
-        KfTransform * RESTRICT_ALIAS nextTransf = nextFrame->mBoneTransform;
-
         ArrayVector3 interpPos, interpScale;
         ArrayQuaternion interpRot;
-        //Interpolate keyframes' rotation not using shortestPath to respect the original animation
-        interpPos   = Math::lerp( prevTransf->mPosition, nextTransf->mPosition, fTimeW );
-        interpRot   = ArrayQuaternion::nlerpShortest( fTimeW,
-                                                      prevTransf->mOrientation,
-                                                      nextTransf->mOrientation );
-        interpScale = Math::lerp( prevTransf->mScale, nextTransf->mScale, fTimeW );
+
+        if( !mCompressedData.get() )
+        {
+            KfTransform * RESTRICT_ALIAS prevTransf = prevFrame->mBoneTransform;
+            KfTransform * RESTRICT_ALIAS nextTransf = nextFrame->mBoneTransform;
+
+            //Interpolate keyframes' rotation not using shortestPath to respect the original animation
+            interpPos   = Math::lerp( prevTransf->mPosition, nextTransf->mPosition, fTimeW );
+            interpRot   = ArrayQuaternion::nlerpShortest( fTimeW,
+                                                          prevTransf->mOrientation,
+                                                          nextTransf->mOrientation );
+            interpScale = Math::lerp( prevTransf->mScale, nextTransf->mScale, fTimeW );
+        }
+        else
+        {
+            const KfTransform * RESTRICT_ALIAS constants =
+                    reinterpret_cast<const KfTransform*>( mCompressedData.get() );
+            const ArrayReal * RESTRICT_ALIAS prevData = mCompressedData.get() +
+                    c_compressedHeaderSize + (prevFrame - mKeyFrameRigs.begin()) * mCompressedStride;
+            const ArrayReal * RESTRICT_ALIAS nextData = mCompressedData.get() +
+                    c_compressedHeaderSize + (nextFrame - mKeyFrameRigs.begin()) * mCompressedStride;
+
+            //Channels that don't change over time don't need interpolation
+            if( mAnimatedChannels & ChannelPosition )
+            {
+                interpPos = Math::lerp( *reinterpret_cast<const ArrayVector3*>( prevData ),
+                                        *reinterpret_cast<const ArrayVector3*>( nextData ), fTimeW );
+                prevData += 3u;
+                nextData += 3u;
+            }
+            else
+            {
+                interpPos = constants->mPosition;
+            }
+
+            if( mAnimatedChannels & ChannelOrientation )
+            {
+                if( mQuantisedOrientations )
+                {
+                    ArrayQuaternion prevRot, nextRot;
+                    dequantise( prevData, prevRot );
+                    dequantise( nextData, nextRot );
+                    interpRot = ArrayQuaternion::nlerpShortest( fTimeW, prevRot, nextRot );
+                    prevData += QuantisedOrientationSize;
+                    nextData += QuantisedOrientationSize;
+                }
+                else
+                {
+                    interpRot = ArrayQuaternion::nlerpShortest(
+                                    fTimeW, *reinterpret_cast<const ArrayQuaternion*>( prevData ),
+                                    *reinterpret_cast<const ArrayQuaternion*>( nextData ) );
+                    prevData += 4u;
+                    nextData += 4u;
+                }
+            }
+            else
+            {
+                interpRot = constants->mOrientation;
+            }
+
+            if( mAnimatedChannels & ChannelScale )
+            {
+                interpScale = Math::lerp( *reinterpret_cast<const ArrayVector3*>( prevData ),
+                                          *reinterpret_cast<const ArrayVector3*>( nextData ),
+                                          fTimeW );
+            }
+            else
+            {
+                interpScale = constants->mScale;
+            }
+        }
 
         //Combine our internal flag (that prevents blending
         //unanimated bones) with user's custom weights
@@ -191,4 +281,275 @@ namespace Ogre
             }
         }
     }
+    //-----------------------------------------------------------------------------------
+    inline void SkeletonTrack::dequantise( const ArrayReal * RESTRICT_ALIAS src,
+                                           ArrayQuaternion &outOrientation )
+    {
+        //Both share the WWWW XXXX YYYY ZZZZ layout. A plain loop
+        //lets the compiler convert all the lanes using SIMD.
+        const int16 * RESTRICT_ALIAS quantised = reinterpret_cast<const int16*>( src );
+        Real * RESTRICT_ALIAS dst = reinterpret_cast<Real*>( &outOrientation );
+
+        for( size_t i=0; i<4u * ARRAY_PACKED_REALS; ++i )
+            dst[i] = static_cast<Real>( quantised[i] ) * c_invQuantisationScale;
+    }
+    //-----------------------------------------------------------------------------------
+    void SkeletonTrack::getKeyFrameTransform( size_t keyFrameIdx, size_t slot, Vector3 &outPos,
+                                              Quaternion &outRot, Vector3 &outScale ) const
+    {
+        assert( keyFrameIdx < mKeyFrameRigs.size() && slot < ARRAY_PACKED_REALS );
+
+        if( !mCompressedData.get() )
+        {
+            const KfTransform * RESTRICT_ALIAS boneTransform = mKeyFrameRigs[keyFrameIdx].mBoneTransform;
+            boneTransform->mPosition.getAsVector3( outPos, slot );
+            boneTransform->mOrientation.getAsQuaternion( outRot, slot );
+            boneTransform->mScale.getAsVector3( outScale, slot );
+            return;
+        }
+
+        const KfTransform * RESTRICT_ALIAS constants =
+                reinterpret_cast<const KfTransform*>( mCompressedData.get() );
+        const ArrayReal * RESTRICT_ALIAS keyFrameData = mCompressedData.get() +
+                c_compressedHeaderSize + keyFrameIdx * mCompressedStride;
+
+        if( mAnimatedChannels & ChannelPosition )
+        {
+            reinterpret_cast<const ArrayVector3*>( keyFrameData )->getAsVector3( outPos, slot );
+            keyFrameData += 3u;
+        }
+        else
+        {
+            constants->mPosition.getAsVector3( outPos, slot );
+        }
+
+        if( mAnimatedChannels & ChannelOrientation )
+        {
+            if( mQuantisedOrientations )
+            {
+                ArrayQuaternion orientation;
+                dequantise( keyFrameData, orientation );
+                orientation.getAsQuaternion( outRot, slot );
+                keyFrameData += QuantisedOrientationSize;
+            }
+            else
+            {
+                reinterpret_cast<const ArrayQuaternion*>( keyFrameData )->getAsQuaternion( outRot,
+                                                                                           slot );
+                keyFrameData += 4u;
+            }
+        }
+        else
+        {
+            constants->mOrientation.getAsQuaternion( outRot, slot );
+        }
+
+        if( mAnimatedChannels & ChannelScale )
+            reinterpret_cast<const ArrayVector3*>( keyFrameData )->getAsVector3( outScale, slot );
+        else
+            constants->mScale.getAsVector3( outScale, slot );
+    }
+    //-----------------------------------------------------------------------------------
+    void SkeletonTrack::_compress( const SkeletonTrackCompression &settings )
+    {
+        assert( !isCompressed() && "Track is already compressed!" );
+
+        const size_t numKeyFrames = mKeyFrameRigs.size();
+        if( !numKeyFrames )
+            return;
+
+        //Unpack everything. This happens at import time, and even long
+        //animations don't have that many keyframes per track.
+        const size_t numValues = numKeyFrames * ARRAY_PACKED_REALS;
+        vector<Vector3>::type positions( numValues );
+        vector<Quaternion>::type orientations( numValues );
+        vector<Vector3>::type scales( numValues );
+        //Orientations as they'll be seen after decoding (i.e. with quantisation error)
+        vector<Quaternion>::type decodedOrientations( numValues );
+
+        for( size_t i=0; i<numKeyFrames; ++i )
+        {
+            for( size_t j=0; j<ARRAY_PACKED_REALS; ++j )
+            {
+                const size_t idx = i * ARRAY_PACKED_REALS + j;
+                getKeyFrameTransform( i, j, positions[idx], orientations[idx], scales[idx] );
+                //The original keyframes aren't normalised (see
+                //SkeletonAnimationDef::getInterpolatedUnnormalizedKeyFrame)
+                orientations[idx].normalise();
+
+                Quaternion &decoded = decodedOrientations[idx];
+                decoded = orientations[idx];
+                if( settings.quantiseOrientations )
+                {
+                    decoded.w = quantiseComponent( decoded.w ) * c_invQuantisationScale;
+                    decoded.x = quantiseComponent( decoded.x ) * c_invQuantisationScale;
+                    decoded.y = quantiseComponent( decoded.y ) * c_invQuantisationScale;
+                    decoded.z = quantiseComponent( decoded.z ) * c_invQuantisationScale;
+                    decoded.normalise();
+                }
+            }
+        }
+
+        //Two unit quaternions are within an angle 'a' when |dot| >= cos( a / 2 )
+        const Real minCosHalfAngle = Math::Cos( settings.orientationTolerance * 0.5f );
+
+        //1st pass: find out which channels change over time, in any of the slots
+        uint8 animatedChannels = 0;
+        for( size_t i=ARRAY_PACKED_REALS; i<numValues; ++i )
+        {
+            const size_t firstIdx = i % ARRAY_PACKED_REALS;
+            if( positions[i].distance( positions[firstIdx] ) > settings.positionTolerance )
+                animatedChannels |= ChannelPosition;
+            if( Math::Abs( orientations[i].Dot( orientations[firstIdx] ) ) < minCosHalfAngle )
+                animatedChannels |= ChannelOrientation;
+            if( !scales[i].positionEquals( scales[firstIdx], settings.scaleTolerance ) )
+                animatedChannels |= ChannelScale;
+        }
+
+        //2nd pass: greedy curve fitting. Extend each segment for as long as
+        //interpolating its ends reproduces all the keyframes in between.
+        vector<size_t>::type keptKeyFrames;
+        keptKeyFrames.push_back( 0 );
+        if( animatedChannels && numKeyFrames > 1u )
+        {
+            size_t segmentStart = 0;
+            for( size_t segmentEnd=2u; segmentEnd<numKeyFrames; ++segmentEnd )
+            {
+                const Real startFrame = mKeyFrameRigs[segmentStart].mFrame;
+                const Real invLength = 1.0f / (mKeyFrameRigs[segmentEnd].mFrame - startFrame);
+
+                bool fits = true;
+                for( size_t i=segmentStart + 1u; i<segmentEnd && fits; ++i )
+                {
+                    const Real fTimeW = (mKeyFrameRigs[i].mFrame - startFrame) * invLength;
+
+                    for( size_t j=0; j<ARRAY_PACKED_REALS && fits; ++j )
+                    {
+                        const size_t idx0 = segmentStart * ARRAY_PACKED_REALS + j;
+                        const size_t idx1 = segmentEnd * ARRAY_PACKED_REALS + j;
+                        const size_t idx  = i * ARRAY_PACKED_REALS + j;
+
+                        if( animatedChannels & ChannelPosition )
+                        {
+                            const Vector3 vPos = Math::lerp( positions[idx0], positions[idx1], fTimeW );
+                            fits &= vPos.distance( positions[idx] ) <= settings.positionTolerance;
+                        }
+                        if( animatedChannels & ChannelOrientation )
+                        {
+                            const Quaternion qRot = Quaternion::nlerp( fTimeW, decodedOrientations[idx0],
+                                                                       decodedOrientations[idx1], true );
+                            fits &= Math::Abs( qRot.Dot( orientations[idx] ) ) >= minCosHalfAngle;
+                        }
+                        if( animatedChannels & ChannelScale )
+                        {
+                            const Vector3 vScale = Math::lerp( scales[idx0], scales[idx1], fTimeW );
+                            fits &= vScale.positionEquals( scales[idx], settings.scaleTolerance );
+                        }
+                    }
+                }
+
+                if( !fits )
+                {
+                    segmentStart = segmentEnd - 1u;
+                    keptKeyFrames.push_back( segmentStart );
+                }
+            }
+
+            keptKeyFrames.push_back( numKeyFrames - 1u );
+        }
+
+        //3rd pass: write the compressed data
+        const bool quantiseOrientations = settings.quantiseOrientations &&
+                                          (animatedChannels & ChannelOrientation);
+        uint32 stride = 0;
+        if( animatedChannels & ChannelPosition )
+            stride += 3u;
+        if( animatedChannels & ChannelOrientation )
+            stride += quantiseOrientations ? QuantisedOrientationSize : 4u;
+        if( animatedChannels & ChannelScale )
+            stride += 3u;
+
+        RawSimdUniquePtr<ArrayReal, MEMCATEGORY_ANIMATION> compressedData(
+                    c_compressedHeaderSize + keptKeyFrames.size() * stride );
+
+        KfTransform * RESTRICT_ALIAS constants = reinterpret_cast<KfTransform*>( compressedData.get() );
+        for( size_t j=0; j<ARRAY_PACKED_REALS; ++j )
+        {
+            constants->mPosition.setFromVector3( positions[j], j );
+            constants->mOrientation.setFromQuaternion( orientations[j], j );
+            constants->mScale.setFromVector3( scales[j], j );
+        }
+
+        KeyFrameRigVec keyFrameRigs;
+        keyFrameRigs.reserve( keptKeyFrames.size() );
+
+        ArrayReal * RESTRICT_ALIAS dstData = compressedData.get() + c_compressedHeaderSize;
+
+        vector<size_t>::type::const_iterator itor = keptKeyFrames.begin();
+        vector<size_t>::type::const_iterator end  = keptKeyFrames.end();
+
+        while( itor != end )
+        {
+            const size_t baseIdx = *itor * ARRAY_PACKED_REALS;
+
+            if( animatedChannels & ChannelPosition )
+            {
+                ArrayVector3 *dstPos = reinterpret_cast<ArrayVector3*>( dstData );
+                for( size_t j=0; j<ARRAY_PACKED_REALS; ++j )
+                    dstPos->setFromVector3( positions[baseIdx + j], j );
+                dstData += 3u;
+            }
+
+            if( animatedChannels & ChannelOrientation )
+            {
+                if( quantiseOrientations )
+                {
+                    int16 *dstRot = reinterpret_cast<int16*>( dstData );
+                    for( size_t j=0; j<ARRAY_PACKED_REALS; ++j )
+                    {
+                        const Quaternion &qRot = orientations[baseIdx + j];
+                        dstRot[j + ARRAY_PACKED_REALS * 0u] = quantiseComponent( qRot.w );
+                        dstRot[j + ARRAY_PACKED_REALS * 1u] = quantiseComponent( qRot.x );
+                        dstRot[j + ARRAY_PACKED_REALS * 2u] = quantiseComponent( qRot.y );
+                        dstRot[j + ARRAY_PACKED_REALS * 3u] = quantiseComponent( qRot.z );
+                    }
+                    dstData += QuantisedOrientationSize;
+                }
+                else
+                {
+                    ArrayQuaternion *dstRot = reinterpret_cast<ArrayQuaternion*>( dstData );
+                    for( size_t j=0; j<ARRAY_PACKED_REALS; ++j )
+                        dstRot->setFromQuaternion( orientations[baseIdx + j], j );
+                    dstData += 4u;
+                }
+            }
+
+            if( animatedChannels & ChannelScale )
+            {
+                ArrayVector3 *dstScale = reinterpret_cast<ArrayVector3*>( dstData );
+                for( size_t j=0; j<ARRAY_PACKED_REALS; ++j )
+                    dstScale->setFromVector3( scales[baseIdx + j], j );
+                dstData += 3u;
+            }
+
+            KeyFrameRig keyFrame = mKeyFrameRigs[*itor];
+            keyFrame.mInvNextFrameDistance = 1.0f;
+            keyFrame.mBoneTransform = 0;
+            if( !keyFrameRigs.empty() )
+            {
+                KeyFrameRig &prevKeyFrame = keyFrameRigs.back();
+                prevKeyFrame.mInvNextFrameDistance = 1.0f / (keyFrame.mFrame - prevKeyFrame.mFrame);
+            }
+            keyFrameRigs.push_back( keyFrame );
+
+            ++itor;
+        }
+
+        mKeyFrameRigs.swap( keyFrameRigs );
+        mCompressedData.swap( compressedData );
+        mCompressedStride       = stride;
+        mAnimatedChannels       = animatedChannels;
+        mQuantisedOrientations  = quantiseOrientations;
+        mLocalMemoryManager     = 0;
+    }
 }
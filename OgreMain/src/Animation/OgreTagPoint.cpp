@@ -171,6 +171,10 @@ namespace Ogre {
             }
 #endif
 
+            //Bones animate every frame, thus we always change.
+            for( size_t j=0; j<ARRAY_PACKED_REALS; ++j )
+                t.mDirtyFlags[j] |= Transform::DirtyDerived;
+
             t.advancePack();
         }
     }
@@ -220,6 +224,9 @@ namespace Ogre {
             }
 #endif
 
+            for( size_t j=0; j<ARRAY_PACKED_REALS; ++j )
+                t.mDirtyFlags[j] |= Transform::DirtyDerived;
+
             t.advancePack();
         }
     }
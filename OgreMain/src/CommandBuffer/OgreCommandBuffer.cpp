@@ -114,6 +114,12 @@ namespace Ogre
         mCommandBuffer.clear();
     }
     //-----------------------------------------------------------------------------------
+    void CommandBuffer::append( CommandBuffer *other )
+    {
+        mCommandBuffer.appendPOD( other->mCommandBuffer.begin(), other->mCommandBuffer.end() );
+        other->mCommandBuffer.clear();
+    }
+    //-----------------------------------------------------------------------------------
     CbBase* CommandBuffer::getLastCommand(void)
     {
         return reinterpret_cast<CbBase*>( mCommandBuffer.end() - COMMAND_FIXED_SIZE );
@@ -0,0 +1,118 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include <OgreStableHeaders.h>
+
+#include "OgrePlatformInformation.h"
+
+#if __OGRE_HAVE_AVX2
+#define __Mathlib_H__ //Neded to directly include OgreMathlibAVX
+
+#include "Math/Array/OgreArrayConfig.h"
+#include "Math/Array/AVX/Single/OgreMathlibAVX.h"
+#include "Math/Array/AVX/Single/avx_mathfun.h"
+#include "Math/Array/OgreBooleanMask.h"
+
+namespace Ogre
+{
+    const ArrayReal MathlibAVX::HALF       = _mm256_set1_ps( 0.5f );
+    const ArrayReal MathlibAVX::ONE        = _mm256_set1_ps( 1.0f );
+    const ArrayReal MathlibAVX::THREE      = _mm256_set1_ps( 3.0f );
+    const ArrayReal MathlibAVX::NEG_ONE    = _mm256_set1_ps( -1.0f );
+    const ArrayReal MathlibAVX::fEpsilon   = _mm256_set1_ps( 1e-6f );
+    const ArrayReal MathlibAVX::fSqEpsilon = _mm256_set1_ps( 1e-12f );
+    const ArrayReal MathlibAVX::OneMinusEpsilon= _mm256_set1_ps( 1.0f - 1e-6f );
+    const ArrayReal MathlibAVX::FLOAT_MIN  = _mm256_set1_ps( std::numeric_limits<Real>::min() );
+    const ArrayReal MathlibAVX::SIGN_MASK  = _mm256_set1_ps( -0.0f );
+    const ArrayReal MathlibAVX::INFINITEA  = _mm256_set1_ps( std::numeric_limits<Real>::infinity() );
+    const ArrayReal MathlibAVX::MAX_NEG    = _mm256_set1_ps( -std::numeric_limits<Real>::max() );
+    const ArrayReal MathlibAVX::MAX_POS    = _mm256_set1_ps( std::numeric_limits<Real>::max() );
+    const __m128 MathlibAVX::LAST_AFFINE_COLUMN = _mm_setr_ps( 0, 0, 0, 1 );
+
+    static const Real _PI = Real( 4.0 * std::atan( 1.0 ) );
+    //We can't use Math::fDeg2Rad & Math::fRad2Deg directly because
+    //it's not guaranteed to have been initialized first
+    const ArrayReal MathlibAVX::PI         = _mm256_set1_ps( _PI );
+    const ArrayReal MathlibAVX::TWO_PI     = _mm256_set1_ps( 2.0f * _PI );
+    const ArrayReal MathlibAVX::fDeg2Rad   = _mm256_set1_ps( _PI / 180.0f );
+    const ArrayReal MathlibAVX::fRad2Deg   = _mm256_set1_ps( 180.0f / _PI );
+
+    const ArrayReal MathlibAVX::ONE_DIV_2PI= _mm256_set1_ps( 1.0f / (2.0f * _PI) );
+
+    //-----------------------------------------------------------------------------------
+    ArrayReal MathlibAVX::Sin4( ArrayReal x )
+    {
+        // Map arbitrary angle x to the range [-pi; +pi] without using division.
+        // Code taken from MSDN's HLSL trick. AVX2 targets always have FMA.
+        ArrayReal integralPart;
+        x = _mm256_madd_ps( x, ONE_DIV_2PI, HALF );
+        x = Modf4( x, integralPart );
+        x = _mm256_fmsub_ps( x, TWO_PI, PI );
+
+        return sin256_ps( x );
+    }
+    //-----------------------------------------------------------------------------------
+    ArrayReal MathlibAVX::Cos4( ArrayReal x )
+    {
+        // Map arbitrary angle x to the range [-pi; +pi] without using division.
+        // Code taken from MSDN's HLSL trick. AVX2 targets always have FMA.
+        ArrayReal integralPart;
+        x = _mm256_madd_ps( x, ONE_DIV_2PI, HALF );
+        x = Modf4( x, integralPart );
+        x = _mm256_fmsub_ps( x, TWO_PI, PI );
+
+        return cos256_ps( x );
+    }
+    //-----------------------------------------------------------------------------------
+    void MathlibAVX::SinCos4( ArrayReal x, ArrayReal &outSin, ArrayReal &outCos )
+    {
+        // TODO: Improve accuracy by mapping to the range [-pi/4, pi/4] and swap
+        // between cos & sin depending on which quadrant it fell:
+        // Quadrant | sin     |  cos
+        // n = 0 ->  sin( x ),  cos( x )
+        // n = 1 ->  cos( x ), -sin( x )
+        // n = 2 -> -sin( x ), -cos( x )
+        // n = 3 -> -sin( x ),  sin( x )
+        // See ARGUMENT REDUCTION FOR HUGE ARGUMENTS:
+        // Good to the Last Bit
+        // K. C. Ng and themembers of the FP group of SunPro
+        // http://www.derekroconnor.net/Software/Ng--ArgReduction.pdf
+
+        // -- Perhaps we can leave this to GSoC students? --
+
+        // Map arbitrary angle x to the range [-pi; +pi] without using division.
+        // Code taken from MSDN's HLSL trick. AVX2 targets always have FMA.
+        ArrayReal integralPart;
+        x = _mm256_madd_ps( x, ONE_DIV_2PI, HALF );
+        x = Modf4( x, integralPart );
+        x = _mm256_fmsub_ps( x, TWO_PI, PI );
+
+        sincos256_ps( x, &outSin, &outCos );
+    }
+}
+#endif
@@ -57,6 +57,9 @@ namespace Ogre
         mDummyTransformPtrs.mDerivedTransform   = reinterpret_cast<Matrix4*>( OGRE_MALLOC_SIMD(
                                                 sizeof( Matrix4 ) * ARRAY_PACKED_REALS,
                                                 MEMCATEGORY_SCENE_OBJECTS ) );
+        mDummyTransformPtrs.mDirtyFlags         = reinterpret_cast<uint8*>( OGRE_MALLOC_SIMD(
+                                                sizeof( uint8 ) * ARRAY_PACKED_REALS,
+                                                MEMCATEGORY_SCENE_OBJECTS ) );
 
         /*mDummyTransformPtrs.mDerivedTransform = reinterpret_cast<ArrayMatrix4*>( OGRE_MALLOC_SIMD(
                                                 sizeof( ArrayMatrix4 ), MEMCATEGORY_SCENE_OBJECTS ) );
@@ -69,7 +72,10 @@ namespace Ogre
         *mDummyTransformPtrs.mDerivedOrientation    = ArrayQuaternion::IDENTITY;
         *mDummyTransformPtrs.mDerivedScale          = ArrayVector3::UNIT_SCALE;
         for( int i=0; i<ARRAY_PACKED_REALS; ++i )
+        {
             mDummyTransformPtrs.mDerivedTransform[i] = Matrix4::IDENTITY;
+            mDummyTransformPtrs.mDirtyFlags[i] = 0;
+        }
 
         mDummyNode = new SceneNode( mDummyTransformPtrs );
     }
@@ -99,6 +105,7 @@ namespace Ogre
         OGRE_FREE_SIMD( mDummyTransformPtrs.mDerivedScale, MEMCATEGORY_SCENE_OBJECTS );
 
         OGRE_FREE_SIMD( mDummyTransformPtrs.mDerivedTransform, MEMCATEGORY_SCENE_OBJECTS );
+        OGRE_FREE_SIMD( mDummyTransformPtrs.mDirtyFlags, MEMCATEGORY_SCENE_OBJECTS );
         /*OGRE_FREE_SIMD( mDummyTransformPtrs.mInheritOrientation, MEMCATEGORY_SCENE_OBJECTS );
         OGRE_FREE_SIMD( mDummyTransformPtrs.mInheritScale, MEMCATEGORY_SCENE_OBJECTS );*/
         mDummyTransformPtrs = Transform();
@@ -196,6 +203,18 @@ namespace Ogre
         }
     }
     //-----------------------------------------------------------------------------------
+    void NodeMemoryManager::_clearDirtyFlags(void)
+    {
+        ArrayMemoryManagerVec::iterator itor = mMemoryManagers.begin();
+        ArrayMemoryManagerVec::iterator end  = mMemoryManagers.end();
+
+        while( itor != end )
+        {
+            itor->clearDirtyFlags();
+            ++itor;
+        }
+    }
+    //-----------------------------------------------------------------------------------
     void NodeMemoryManager::migrateTo( Transform &inOutTransform, size_t depth,
                                         NodeMemoryManager *dstNodeMemoryManager )
     {
@@ -51,6 +51,7 @@ namespace Ogre
         1 * sizeof( Ogre::uint32 ),     //ArrayMemoryManager::VisibilityFlags
         1 * sizeof( Ogre::uint32 ),     //ArrayMemoryManager::QueryFlags
         1 * sizeof( Ogre::uint32 ),     //ArrayMemoryManager::LightMask
+        1 * sizeof( Ogre::uint8 ),      //ArrayMemoryManager::DirtyFlags
     };
     const CleanupRoutines ObjectDataArrayMemoryManager::ObjCleanupRoutines[NumMemoryTypes] =
     {
@@ -66,6 +67,7 @@ namespace Ogre
         cleanerFlat,                    //ArrayMemoryManager::VisibilityFlags
         cleanerFlat,                    //ArrayMemoryManager::QueryFlags
         cleanerFlat,                    //ArrayMemoryManager::LightMask
+        cleanerFlat,                    //ArrayMemoryManager::DirtyFlags
     };
     //-----------------------------------------------------------------------------------
     ObjectDataArrayMemoryManager::ObjectDataArrayMemoryManager( uint16 depthLevel, size_t hintMaxNodes,
@@ -125,6 +127,8 @@ namespace Ogre
                                                 nextSlotBase * mElementsMemSizes[QueryFlags] );
         outData.mLightMask          = reinterpret_cast<uint32*>( mMemoryPools[LightMask] +
                                                 nextSlotBase * mElementsMemSizes[LightMask] );
+        outData.mDirtyFlags         = reinterpret_cast<uint8*>( mMemoryPools[DirtyFlags] +
+                                                nextSlotBase * mElementsMemSizes[DirtyFlags] );
 
         //Set default values
         outData.mParents[nextSlotIdx]   = mDummyNode;
@@ -139,6 +143,7 @@ namespace Ogre
         outData.mVisibilityFlags[nextSlotIdx]       = MovableObject::getDefaultVisibilityFlags();
         outData.mQueryFlags[nextSlotIdx]            = MovableObject::getDefaultQueryFlags();
         outData.mLightMask[nextSlotIdx]             = MovableObject::getDefaultLightMask();
+        outData.mDirtyFlags[nextSlotIdx]            = 1u;
     }
     //-----------------------------------------------------------------------------------
     void ObjectDataArrayMemoryManager::destroyNode( ObjectData &inOutData )
@@ -150,6 +155,7 @@ namespace Ogre
         inOutData.mVisibilityFlags[inOutData.mIndex]    = 0;
         inOutData.mQueryFlags[inOutData.mIndex]         = 0;
         inOutData.mLightMask[inOutData.mIndex]          = 0;
+        inOutData.mDirtyFlags[inOutData.mIndex]         = 0;
         destroySlot( reinterpret_cast<char*>(inOutData.mParents), inOutData.mIndex );
         //Zero out all pointers
         inOutData = ObjectData();
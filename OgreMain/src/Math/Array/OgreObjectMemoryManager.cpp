@@ -60,6 +60,9 @@ namespace Ogre
         mDummyTransformPtrs.mDerivedTransform   = reinterpret_cast<Matrix4*>( OGRE_MALLOC_SIMD(
                                                 sizeof( Matrix4 ) * ARRAY_PACKED_REALS,
                                                 MEMCATEGORY_SCENE_OBJECTS ) );
+        mDummyTransformPtrs.mDirtyFlags         = reinterpret_cast<uint8*>( OGRE_MALLOC_SIMD(
+                                                sizeof( uint8 ) * ARRAY_PACKED_REALS,
+                                                MEMCATEGORY_SCENE_OBJECTS ) );
         /*mDummyTransformPtrs.mInheritOrientation= OGRE_MALLOC_SIMD( sizeof( bool ) * ARRAY_PACKED_REALS,
                                                                     MEMCATEGORY_SCENE_OBJECTS );
         mDummyTransformPtrs.mInheritScale       = OGRE_MALLOC_SIMD( sizeof( bool ) * ARRAY_PACKED_REALS,
@@ -69,7 +72,10 @@ namespace Ogre
         *mDummyTransformPtrs.mDerivedOrientation    = ArrayQuaternion::IDENTITY;
         *mDummyTransformPtrs.mDerivedScale          = ArrayVector3::UNIT_SCALE;
         for( size_t i=0; i<ARRAY_PACKED_REALS; ++i )
+        {
             mDummyTransformPtrs.mDerivedTransform[i] = Matrix4::IDENTITY;
+            mDummyTransformPtrs.mDirtyFlags[i] = 0;
+        }
 
         mDummyNode = new SceneNode( mDummyTransformPtrs );
         mDummyObject = new NullEntity();
@@ -103,6 +109,7 @@ namespace Ogre
         OGRE_FREE_SIMD( mDummyTransformPtrs.mDerivedScale, MEMCATEGORY_SCENE_OBJECTS );
 
         OGRE_FREE_SIMD( mDummyTransformPtrs.mDerivedTransform, MEMCATEGORY_SCENE_OBJECTS );
+        OGRE_FREE_SIMD( mDummyTransformPtrs.mDirtyFlags, MEMCATEGORY_SCENE_OBJECTS );
         /*OGRE_FREE_SIMD( mDummyTransformPtrs.mInheritOrientation, MEMCATEGORY_SCENE_OBJECTS );
         OGRE_FREE_SIMD( mDummyTransformPtrs.mInheritScale, MEMCATEGORY_SCENE_OBJECTS );*/
         mDummyTransformPtrs = Transform();
@@ -124,6 +131,7 @@ namespace Ogre
                                             mDummyNode, mDummyObject, 100,
                                             ArrayMemoryManager::MAX_MEMORY_SLOTS, this ) );
             mMemoryManagers.back().initialize();
+            mCullingHierarchies.push_back( CullingHierarchy() );
         }
     }
     //-----------------------------------------------------------------------------------
@@ -133,6 +141,8 @@ namespace Ogre
 
         ObjectDataArrayMemoryManager& mgr = mMemoryManagers[renderQueue];
         mgr.createNewNode( outObjectData );
+        //The slot may have been reused, and its block bounds don't include the new object
+        mCullingHierarchies[renderQueue]._invalidate();
 
         ++mTotalObjects;
     }
@@ -144,6 +154,7 @@ namespace Ogre
 
         ObjectData tmp;
         mMemoryManagers[newRenderQueue].createNewNode( tmp );
+        mCullingHierarchies[newRenderQueue]._invalidate();
 
         tmp.copy( inOutObjectData );
 
@@ -228,6 +239,25 @@ namespace Ogre
         return retVal;
     }
     //-----------------------------------------------------------------------------------
+    MovableObject* ObjectMemoryManager::_getDummyObject() const
+    {
+        return mDummyObject;
+    }
+    //-----------------------------------------------------------------------------------
+    bool ObjectMemoryManager::_isCullingHierarchyDirty() const
+    {
+        bool retVal = false;
+
+        const size_t numRenderQueues = mMemoryManagers.size();
+        for( size_t i=0; i<numRenderQueues && !retVal; ++i )
+        {
+            retVal = !mCullingHierarchies[i].isBuilt() &&
+                     mMemoryManagers[i].getNumUsedSlotsIncludingFragmented() != 0;
+        }
+
+        return retVal;
+    }
+    //-----------------------------------------------------------------------------------
     size_t ObjectMemoryManager::getFirstObjectData( ObjectData &outObjectData, size_t renderQueue )
     {
         return mMemoryManagers[renderQueue].getFirstNode( outObjectData );
@@ -280,6 +310,9 @@ namespace Ogre
                                               size_t const *elementsMemSizes,
                                               size_t startInstance, size_t diffInstances )
     {
+        //Objects have been moved to different blocks
+        mCullingHierarchies[level]._invalidate();
+
         ObjectData objectData;
         const size_t numObjs = this->getFirstObjectData( objectData, level );
 
@@ -30,6 +30,7 @@ THE SOFTWARE.
 
 #include "OgreArchive.h"
 #include "OgreException.h"
+#include "OgreDataStream.h"
 
 namespace Ogre {
     //---------------------------------------------------------------------
@@ -47,4 +48,15 @@ namespace Ogre {
                     "Archive::remove");
     }
     //---------------------------------------------------------------------
+    DataStreamPtr Archive::openMapped(const String& filename)
+    {
+        DataStreamPtr stream = open(filename, true);
+
+        // Some archives (e.g. zip) already decompress into memory
+        if (stream.isNull() || dynamic_cast<MemoryDataStream*>(stream.get()))
+            return stream;
+
+        return DataStreamPtr(OGRE_NEW MemoryDataStream(filename, stream, true, true));
+    }
+    //---------------------------------------------------------------------
 }
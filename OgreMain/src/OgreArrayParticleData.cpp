@@ -0,0 +1,228 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+
+#include "OgreArrayParticleData.h"
+#include "OgreParticle.h"
+#include "Math/Array/OgreMathlib.h"
+
+namespace Ogre
+{
+    /// Number of ArrayReal arrays after the two ArrayVector3 ones (colour, ttl, rotation, size).
+    static const size_t c_numArrayRealStreams = 10u;
+    //-----------------------------------------------------------------------
+    ArrayParticleData::ArrayParticleData() :
+        mPosition( 0 ),
+        mDirection( 0 ),
+        mColourR( 0 ),
+        mColourG( 0 ),
+        mColourB( 0 ),
+        mColourA( 0 ),
+        mTimeToLive( 0 ),
+        mTotalTimeToLive( 0 ),
+        mRotation( 0 ),
+        mRotationSpeed( 0 ),
+        mWidth( 0 ),
+        mHeight( 0 ),
+        mDimensionsChanged( false ),
+        mRotationChanged( false ),
+        mNumParticles( 0 ),
+        mCapacity( 0 ),
+        mMemory( 0 )
+    {
+    }
+    //-----------------------------------------------------------------------
+    ArrayParticleData::~ArrayParticleData()
+    {
+        if( mMemory )
+        {
+            OGRE_FREE_SIMD( mMemory, MEMCATEGORY_GENERAL );
+            mMemory = 0;
+        }
+    }
+    //-----------------------------------------------------------------------
+    void ArrayParticleData::reserve( size_t numBlocks )
+    {
+        if( numBlocks <= mCapacity )
+            return;
+
+        //Grow geometrically; the data is regathered every update so there's nothing to copy.
+        numBlocks = std::max( numBlocks, mCapacity + (mCapacity >> 1u) );
+
+        if( mMemory )
+            OGRE_FREE_SIMD( mMemory, MEMCATEGORY_GENERAL );
+
+        const size_t bytesNeeded = numBlocks * (2u * sizeof( ArrayVector3 ) +
+                                                c_numArrayRealStreams * sizeof( ArrayReal ));
+        mMemory = OGRE_MALLOC_SIMD( bytesNeeded, MEMCATEGORY_GENERAL );
+        mCapacity = numBlocks;
+
+        mPosition   = reinterpret_cast<ArrayVector3*>( mMemory );
+        mDirection  = mPosition + numBlocks;
+
+        ArrayReal *streams = reinterpret_cast<ArrayReal*>( mDirection + numBlocks );
+        mColourR            = streams;
+        mColourG            = streams + numBlocks * 1u;
+        mColourB            = streams + numBlocks * 2u;
+        mColourA            = streams + numBlocks * 3u;
+        mTimeToLive         = streams + numBlocks * 4u;
+        mTotalTimeToLive    = streams + numBlocks * 5u;
+        mRotation           = streams + numBlocks * 6u;
+        mRotationSpeed      = streams + numBlocks * 7u;
+        mWidth              = streams + numBlocks * 8u;
+        mHeight             = streams + numBlocks * 9u;
+    }
+    //-----------------------------------------------------------------------
+    void ArrayParticleData::copyLane( size_t srcIdx, size_t dstIdx )
+    {
+        const size_t srcBlock   = srcIdx / ARRAY_PACKED_REALS;
+        const size_t srcLane    = srcIdx % ARRAY_PACKED_REALS;
+        const size_t dstBlock   = dstIdx / ARRAY_PACKED_REALS;
+        const size_t dstLane    = dstIdx % ARRAY_PACKED_REALS;
+
+        mPosition[dstBlock].setFromVector3( mPosition[srcBlock].getAsVector3( srcLane ), dstLane );
+        mDirection[dstBlock].setFromVector3( mDirection[srcBlock].getAsVector3( srcLane ), dstLane );
+
+        Real * RESTRICT_ALIAS streams = reinterpret_cast<Real*>( mColourR );
+        const size_t streamStride = mCapacity * ARRAY_PACKED_REALS;
+        for( size_t i=0; i<c_numArrayRealStreams; ++i )
+            streams[i * streamStride + dstIdx] = streams[i * streamStride + srcIdx];
+
+        mParticles[dstIdx] = 0;
+    }
+    //-----------------------------------------------------------------------
+    void ArrayParticleData::gather( const ParticleList &particles, Real defaultWidth,
+                                    Real defaultHeight )
+    {
+        mNumParticles = particles.size();
+        mDimensionsChanged = false;
+        mRotationChanged = false;
+
+        const size_t numBlocks = getNumBlocks();
+        reserve( numBlocks );
+        mParticles.resize( numBlocks * ARRAY_PACKED_REALS );
+
+        Real * RESTRICT_ALIAS colourR       = reinterpret_cast<Real*>( mColourR );
+        Real * RESTRICT_ALIAS colourG       = reinterpret_cast<Real*>( mColourG );
+        Real * RESTRICT_ALIAS colourB       = reinterpret_cast<Real*>( mColourB );
+        Real * RESTRICT_ALIAS colourA       = reinterpret_cast<Real*>( mColourA );
+        Real * RESTRICT_ALIAS timeToLive    = reinterpret_cast<Real*>( mTimeToLive );
+        Real * RESTRICT_ALIAS totalTimeToLive=reinterpret_cast<Real*>( mTotalTimeToLive );
+        Real * RESTRICT_ALIAS rotation      = reinterpret_cast<Real*>( mRotation );
+        Real * RESTRICT_ALIAS rotationSpeed = reinterpret_cast<Real*>( mRotationSpeed );
+        Real * RESTRICT_ALIAS width         = reinterpret_cast<Real*>( mWidth );
+        Real * RESTRICT_ALIAS height        = reinterpret_cast<Real*>( mHeight );
+
+        size_t i = 0;
+        ParticleList::const_iterator itor = particles.begin();
+        ParticleList::const_iterator end  = particles.end();
+
+        while( itor != end )
+        {
+            const Particle *p = *itor;
+
+            mPosition[i / ARRAY_PACKED_REALS].setFromVector3( p->mPosition, i % ARRAY_PACKED_REALS );
+            mDirection[i / ARRAY_PACKED_REALS].setFromVector3( p->mDirection, i % ARRAY_PACKED_REALS );
+            colourR[i]          = p->mColour.r;
+            colourG[i]          = p->mColour.g;
+            colourB[i]          = p->mColour.b;
+            colourA[i]          = p->mColour.a;
+            timeToLive[i]       = p->mTimeToLive;
+            totalTimeToLive[i]  = p->mTotalTimeToLive;
+            rotation[i]         = p->mRotation.valueRadians();
+            rotationSpeed[i]    = p->mRotationSpeed.valueRadians();
+            width[i]            = p->mOwnDimensions ? p->mWidth : defaultWidth;
+            height[i]           = p->mOwnDimensions ? p->mHeight : defaultHeight;
+            mParticles[i]       = *itor;
+
+            ++i;
+            ++itor;
+        }
+
+        //Pad the last block with copies of the last particle, so that
+        //the unused lanes contain sane values (i.e. no NaNs nor denormals)
+        if( mNumParticles )
+        {
+            for( ; i<numBlocks * ARRAY_PACKED_REALS; ++i )
+                copyLane( mNumParticles - 1u, i );
+        }
+    }
+    //-----------------------------------------------------------------------
+    void ArrayParticleData::scatter(void)
+    {
+        const Real * RESTRICT_ALIAS colourR         = reinterpret_cast<const Real*>( mColourR );
+        const Real * RESTRICT_ALIAS colourG         = reinterpret_cast<const Real*>( mColourG );
+        const Real * RESTRICT_ALIAS colourB         = reinterpret_cast<const Real*>( mColourB );
+        const Real * RESTRICT_ALIAS colourA         = reinterpret_cast<const Real*>( mColourA );
+        const Real * RESTRICT_ALIAS timeToLive      = reinterpret_cast<const Real*>( mTimeToLive );
+        const Real * RESTRICT_ALIAS totalTimeToLive = reinterpret_cast<const Real*>( mTotalTimeToLive );
+        const Real * RESTRICT_ALIAS rotation        = reinterpret_cast<const Real*>( mRotation );
+        const Real * RESTRICT_ALIAS rotationSpeed   = reinterpret_cast<const Real*>( mRotationSpeed );
+        const Real * RESTRICT_ALIAS width           = reinterpret_cast<const Real*>( mWidth );
+        const Real * RESTRICT_ALIAS height          = reinterpret_cast<const Real*>( mHeight );
+
+        for( size_t i=0; i<mNumParticles; ++i )
+        {
+            Particle *p = mParticles[i];
+
+            mPosition[i / ARRAY_PACKED_REALS].getAsVector3( p->mPosition, i % ARRAY_PACKED_REALS );
+            mDirection[i / ARRAY_PACKED_REALS].getAsVector3( p->mDirection, i % ARRAY_PACKED_REALS );
+            p->mColour.r        = colourR[i];
+            p->mColour.g        = colourG[i];
+            p->mColour.b        = colourB[i];
+            p->mColour.a        = colourA[i];
+            p->mTimeToLive      = timeToLive[i];
+            p->mTotalTimeToLive = totalTimeToLive[i];
+            p->mRotation        = Radian( rotation[i] );
+            p->mRotationSpeed   = Radian( rotationSpeed[i] );
+        }
+
+        if( mDimensionsChanged )
+        {
+            for( size_t i=0; i<mNumParticles; ++i )
+            {
+                Particle *p = mParticles[i];
+                p->mOwnDimensions   = true;
+                p->mWidth           = width[i];
+                p->mHeight          = height[i];
+            }
+        }
+    }
+    //-----------------------------------------------------------------------
+    void ArrayParticleData::applyMotion( Real timeElapsed )
+    {
+        const ArrayReal dt = Mathlib::SetAll( timeElapsed );
+
+        ArrayVector3 * RESTRICT_ALIAS position          = mPosition;
+        const ArrayVector3 * RESTRICT_ALIAS direction   = mDirection;
+
+        const size_t numBlocks = getNumBlocks();
+        for( size_t i=0; i<numBlocks; ++i )
+            position[i] += direction[i] * dt;
+    }
+}
@@ -145,6 +145,7 @@ namespace v1 {
         aabb.merge(newMax);
         mObjectData.mLocalAabb->setFromAabb( aabb, mObjectData.mIndex );
         mObjectData.mLocalRadius[mObjectData.mIndex] = aabb.getRadius();
+        _notifyLocalAabbDirty();
 
         return newBill;
     }
@@ -519,6 +520,7 @@ namespace v1 {
     {
         mObjectData.mLocalAabb->setFromAabb( aabb, mObjectData.mIndex );
         mObjectData.mLocalRadius[mObjectData.mIndex] = radius;
+        _notifyLocalAabbDirty();
     }
     //-----------------------------------------------------------------------
     void BillboardSet::_updateBounds(void)
@@ -528,6 +530,7 @@ namespace v1 {
             // No billboards, null bbox
             mObjectData.mLocalAabb->setFromAabb( Aabb::BOX_NULL, mObjectData.mIndex );
             mObjectData.mLocalRadius[mObjectData.mIndex] = 0.0f;
+            _notifyLocalAabbDirty();
         }
         else
         {
@@ -561,6 +564,7 @@ namespace v1 {
 
             mObjectData.mLocalAabb->setFromAabb( Aabb::newFromExtents( min, max ), mObjectData.mIndex );
             mObjectData.mLocalRadius[mObjectData.mIndex] = Math::Sqrt(maxSqLen);
+            _notifyLocalAabbDirty();
 
         }
     }
@@ -0,0 +1,670 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+
+#include "OgreBvh.h"
+#include "OgreBitwise.h"
+#include "Vao/OgreVertexArrayObject.h"
+#include "Vao/OgreIndexBufferPacked.h"
+#include "Vao/OgreAsyncTicket.h"
+#include "Math/Array/OgreMathlib.h"
+
+namespace Ogre
+{
+    static const size_t c_numSahBins = 16u;
+    /// Past this depth we always split at the median, which guarantees the tree can't
+    /// get deeper than Bvh::MaxDepth (32 more halvings are enough for 2^32 primitives).
+    static const size_t c_forceMedianSplitDepth = Bvh::MaxDepth - 33u;
+    /// Nodes are grown by this much (relative to their coordinates) so that rays lying
+    /// exactly on a face still enter them. See Bvh::Node.
+    static const Real c_boundsPadding = 1e-6f;
+
+    struct BvhBuildTask
+    {
+        uint32 nodeIdx;
+        uint32 start;
+        uint32 count;
+        uint32 depth;
+    };
+    struct BvhSahBin
+    {
+        Vector3 vMin;
+        Vector3 vMax;
+        uint32  count;
+    };
+    struct BvhCentroidIsLeftOfBin
+    {
+        Vector3 const *centroids;
+        size_t  axis;
+        Real    centroidMin;
+        Real    binScale;
+        uint32  splitBin;
+
+        bool operator () ( uint32 primIdx ) const
+        {
+            const uint32 binIdx = std::min<uint32>( static_cast<uint32>(
+                    (centroids[primIdx][axis] - centroidMin) * binScale ), c_numSahBins - 1u );
+            return binIdx < splitBin;
+        }
+    };
+    struct BvhCentroidLess
+    {
+        Vector3 const *centroids;
+        size_t  axis;
+
+        bool operator () ( uint32 a, uint32 b ) const
+        {
+            return centroids[a][axis] < centroids[b][axis];
+        }
+    };
+
+    static inline Real bvhHalfSurfaceArea( const Vector3 &vMin, const Vector3 &vMax )
+    {
+        const Vector3 size = vMax - vMin;
+        return size.x * size.y + size.y * size.z + size.z * size.x;
+    }
+    static inline Vector3 bvhBoundsPadding( const Vector3 &vMin, const Vector3 &vMax )
+    {
+        Vector3 retVal;
+        for( size_t i=0; i<3u; ++i )
+        {
+            const Real magnitude = std::max( Math::Abs( vMin[i] ), Math::Abs( vMax[i] ) );
+            retVal[i] = std::max( magnitude, Real( 1.0f ) ) * c_boundsPadding;
+        }
+        return retVal;
+    }
+    //-----------------------------------------------------------------------------------
+    const Real Bvh::MinDirection = 1e-20f;
+    //-----------------------------------------------------------------------------------
+    Bvh::Bvh()
+    {
+    }
+    //-----------------------------------------------------------------------------------
+    Bvh::~Bvh()
+    {
+    }
+    //-----------------------------------------------------------------------------------
+    void Bvh::clear(void)
+    {
+        mNodes.clear();
+        mPrimitiveIndices.clear();
+    }
+    //-----------------------------------------------------------------------------------
+    Aabb Bvh::getAabb(void) const
+    {
+        return Aabb::newFromExtents( mNodes[0].vMin, mNodes[0].vMax );
+    }
+    //-----------------------------------------------------------------------------------
+    void Bvh::build( const Aabb *primitiveAabbs, size_t numPrimitives,
+                     uint32 maxPrimitivesPerLeaf )
+    {
+        vector<Vector3>::type primMin( numPrimitives );
+        vector<Vector3>::type primMax( numPrimitives );
+
+        for( size_t i=0; i<numPrimitives; ++i )
+        {
+            primMin[i] = primitiveAabbs[i].getMinimum();
+            primMax[i] = primitiveAabbs[i].getMaximum();
+        }
+
+        buildFromBounds( primMin.empty() ? 0 : &primMin[0], primMax.empty() ? 0 : &primMax[0],
+                         numPrimitives, maxPrimitivesPerLeaf );
+    }
+    //-----------------------------------------------------------------------------------
+    void Bvh::buildFromBounds( const Vector3 *primMin, const Vector3 *primMax,
+                               size_t numPrimitives, uint32 maxPrimitivesPerLeaf )
+    {
+        clear();
+
+        if( !numPrimitives )
+            return;
+
+        assert( numPrimitives < std::numeric_limits<uint32>::max() );
+        maxPrimitivesPerLeaf = std::max( maxPrimitivesPerLeaf, 1u );
+
+        vector<Vector3>::type centroids( numPrimitives );
+        mPrimitiveIndices.resize( numPrimitives );
+        for( size_t i=0; i<numPrimitives; ++i )
+        {
+            centroids[i] = (primMin[i] + primMax[i]) * 0.5f;
+            mPrimitiveIndices[i] = static_cast<uint32>( i );
+        }
+
+        mNodes.reserve( numPrimitives * 2u - 1u );
+        mNodes.push_back( Node() );
+
+        vector<BvhBuildTask>::type tasks;
+        tasks.reserve( MaxDepth );
+        {
+            BvhBuildTask rootTask;
+            rootTask.nodeIdx    = 0;
+            rootTask.start      = 0;
+            rootTask.count      = static_cast<uint32>( numPrimitives );
+            rootTask.depth      = 0;
+            tasks.push_back( rootTask );
+        }
+
+        uint32 * RESTRICT_ALIAS primIndices = mPrimitiveIndices.begin();
+
+        while( !tasks.empty() )
+        {
+            const BvhBuildTask task = tasks.back();
+            tasks.pop_back();
+
+            const uint32 slotEnd = task.start + task.count;
+
+            Vector3 vMin( Vector3( std::numeric_limits<Real>::max() ) );
+            Vector3 vMax( Vector3( -std::numeric_limits<Real>::max() ) );
+            Vector3 centroidMin( vMin );
+            Vector3 centroidMax( vMax );
+
+            for( uint32 slot=task.start; slot<slotEnd; ++slot )
+            {
+                const uint32 primIdx = primIndices[slot];
+                vMin.makeFloor( primMin[primIdx] );
+                vMax.makeCeil( primMax[primIdx] );
+                centroidMin.makeFloor( centroids[primIdx] );
+                centroidMax.makeCeil( centroids[primIdx] );
+            }
+
+            const Vector3 padding = bvhBoundsPadding( vMin, vMax );
+            mNodes[task.nodeIdx].vMin = vMin - padding;
+            mNodes[task.nodeIdx].vMax = vMax + padding;
+
+            const Vector3 centroidExtent = centroidMax - centroidMin;
+
+            uint32 splitSlot = task.start;
+
+            if( task.count > 1u && centroidExtent != Vector3::ZERO )
+            {
+                size_t bestAxis = 0;
+                uint32 bestSplitBin = 0;
+                Real bestCost = std::numeric_limits<Real>::max();
+
+                if( task.depth < c_forceMedianSplitDepth )
+                {
+                    //Binned SAH. Evaluate the c_numSahBins - 1 split planes of each axis.
+                    for( size_t axis=0; axis<3u; ++axis )
+                    {
+                        if( centroidExtent[axis] <= Real( 0 ) )
+                            continue;
+
+                        BvhSahBin bins[c_numSahBins];
+                        for( size_t i=0; i<c_numSahBins; ++i )
+                        {
+                            bins[i].vMin    = Vector3( std::numeric_limits<Real>::max() );
+                            bins[i].vMax    = Vector3( -std::numeric_limits<Real>::max() );
+                            bins[i].count   = 0;
+                        }
+
+                        const Real binScale = c_numSahBins / centroidExtent[axis];
+                        for( uint32 slot=task.start; slot<slotEnd; ++slot )
+                        {
+                            const uint32 primIdx = primIndices[slot];
+                            const uint32 binIdx = std::min<uint32>( static_cast<uint32>(
+                                    (centroids[primIdx][axis] - centroidMin[axis]) * binScale ),
+                                                                    c_numSahBins - 1u );
+                            bins[binIdx].vMin.makeFloor( primMin[primIdx] );
+                            bins[binIdx].vMax.makeCeil( primMax[primIdx] );
+                            ++bins[binIdx].count;
+                        }
+
+                        //Sweep from the right to get the cost of the right side of each plane
+                        Real rightCost[c_numSahBins];
+                        {
+                            Vector3 accumMin( bins[c_numSahBins - 1u].vMin );
+                            Vector3 accumMax( bins[c_numSahBins - 1u].vMax );
+                            uint32 accumCount = bins[c_numSahBins - 1u].count;
+                            for( size_t i=c_numSahBins - 1u; i>0; --i )
+                            {
+                                accumMin.makeFloor( bins[i].vMin );
+                                accumMax.makeCeil( bins[i].vMax );
+                                accumCount += i == c_numSahBins - 1u ? 0u : bins[i].count;
+                                rightCost[i] = accumCount ?
+                                            accumCount * bvhHalfSurfaceArea( accumMin, accumMax ) :
+                                            Real( 0 );
+                            }
+                        }
+
+                        Vector3 accumMin( bins[0].vMin );
+                        Vector3 accumMax( bins[0].vMax );
+                        uint32 accumCount = 0;
+                        for( size_t i=1; i<c_numSahBins; ++i )
+                        {
+                            accumMin.makeFloor( bins[i - 1u].vMin );
+                            accumMax.makeCeil( bins[i - 1u].vMax );
+                            accumCount += bins[i - 1u].count;
+                            const Real leftCost = accumCount ?
+                                        accumCount * bvhHalfSurfaceArea( accumMin, accumMax ) :
+                                        Real( 0 );
+                            const Real cost = leftCost + rightCost[i];
+                            if( cost < bestCost )
+                            {
+                                bestCost = cost;
+                                bestAxis = axis;
+                                bestSplitBin = static_cast<uint32>( i );
+                            }
+                        }
+                    }
+
+                    //Splitting costs one extra node traversal (which we consider as expensive
+                    //as one primitive test) plus the tests of both children weighted by the
+                    //probability of being hit. Not splitting costs testing all primitives.
+                    const Real nodeArea = bvhHalfSurfaceArea( vMin, vMax );
+                    const bool shouldSplit = task.count > maxPrimitivesPerLeaf ||
+                                             nodeArea <= Real( 0 ) ||
+                                             nodeArea + bestCost < nodeArea * task.count;
+
+                    if( shouldSplit )
+                    {
+                        BvhCentroidIsLeftOfBin isLeft;
+                        isLeft.centroids    = &centroids[0];
+                        isLeft.axis         = bestAxis;
+                        isLeft.centroidMin  = centroidMin[bestAxis];
+                        isLeft.binScale     = c_numSahBins / centroidExtent[bestAxis];
+                        isLeft.splitBin     = bestSplitBin;
+                        splitSlot = static_cast<uint32>(
+                                        std::partition( primIndices + task.start,
+                                                        primIndices + slotEnd, isLeft ) -
+                                        primIndices );
+                    }
+                }
+
+                if( task.depth >= c_forceMedianSplitDepth ||
+                    (splitSlot != task.start && splitSlot == slotEnd) )
+                {
+                    //Object median split along the largest axis. We also get here if
+                    //the SAH partition wasn't able to separate anything.
+                    bestAxis = 0;
+                    if( centroidExtent[1] > centroidExtent[bestAxis] )
+                        bestAxis = 1;
+                    if( centroidExtent[2] > centroidExtent[bestAxis] )
+                        bestAxis = 2;
+
+                    BvhCentroidLess centroidLess;
+                    centroidLess.centroids  = &centroids[0];
+                    centroidLess.axis       = bestAxis;
+                    splitSlot = task.start + task.count / 2u;
+                    std::nth_element( primIndices + task.start, primIndices + splitSlot,
+                                      primIndices + slotEnd, centroidLess );
+                }
+            }
+
+            if( splitSlot == task.start || splitSlot == slotEnd )
+            {
+                mNodes[task.nodeIdx].firstIdx       = task.start;
+                mNodes[task.nodeIdx].numPrimitives  = task.count;
+            }
+            else
+            {
+                const uint32 firstChild = static_cast<uint32>( mNodes.size() );
+                mNodes[task.nodeIdx].firstIdx       = firstChild;
+                mNodes[task.nodeIdx].numPrimitives  = 0;
+                mNodes.push_back( Node() );
+                mNodes.push_back( Node() );
+
+                BvhBuildTask childTask;
+                childTask.depth = task.depth + 1u;
+
+                //Push the right one first so that the left one gets processed first
+                childTask.nodeIdx   = firstChild + 1u;
+                childTask.start     = splitSlot;
+                childTask.count     = slotEnd - splitSlot;
+                tasks.push_back( childTask );
+
+                childTask.nodeIdx   = firstChild;
+                childTask.start     = task.start;
+                childTask.count     = splitSlot - task.start;
+                tasks.push_back( childTask );
+            }
+        }
+    }
+    //-----------------------------------------------------------------------------------
+    //-----------------------------------------------------------------------------------
+    //-----------------------------------------------------------------------------------
+    struct TriangleBvhRayTest
+    {
+        Vector3 const * RESTRICT_ALIAS triangles;
+        Vector3 origin;
+        Vector3 direction;
+        bool    positiveSide;
+        bool    negativeSide;
+        uint32  closestSlot;
+        Real    u;
+        Real    v;
+
+        void operator () ( uint32 slot, Real &inOutMaxDistance )
+        {
+            //Möller-Trumbore
+            const Vector3 &v0       = triangles[slot * 3u + 0u];
+            const Vector3 &edge1    = triangles[slot * 3u + 1u];
+            const Vector3 &edge2    = triangles[slot * 3u + 2u];
+
+            const Vector3 pVec = direction.crossProduct( edge2 );
+            const Real det = edge1.dotProduct( pVec );
+
+            //det > 0 means the ray comes from the positive side
+            if( det > std::numeric_limits<Real>::epsilon() )
+            {
+                if( !positiveSide )
+                    return;
+            }
+            else if( det < -std::numeric_limits<Real>::epsilon() )
+            {
+                if( !negativeSide )
+                    return;
+            }
+            else
+            {
+                return;
+            }
+
+            const Real invDet = 1.0f / det;
+            const Vector3 tVec = origin - v0;
+            const Real baryU = tVec.dotProduct( pVec ) * invDet;
+            if( baryU < 0 || baryU > 1.0f )
+                return;
+
+            const Vector3 qVec = tVec.crossProduct( edge1 );
+            const Real baryV = direction.dotProduct( qVec ) * invDet;
+            if( baryV < 0 || baryU + baryV > 1.0f )
+                return;
+
+            const Real t = edge2.dotProduct( qVec ) * invDet;
+            if( t >= 0 && t < inOutMaxDistance )
+            {
+                inOutMaxDistance = t;
+                closestSlot = slot;
+                u = baryU;
+                v = baryV;
+            }
+        }
+    };
+
+    struct TriangleBvhArrayRayTest
+    {
+        Vector3 const * RESTRICT_ALIAS triangles;
+        ArrayVector3    origin;
+        ArrayVector3    direction;
+        /// Rays hit when det > positiveDetThreshold or det < negativeDetThreshold.
+        /// That's how the side culling is done (see TriangleBvhRayTest).
+        ArrayReal       positiveDetThreshold;
+        ArrayReal       negativeDetThreshold;
+        uint32          hitMask;
+        uint32          closestSlot[ARRAY_PACKED_REALS];
+
+        void operator () ( uint32 slot, ArrayReal &inOutMaxDistance )
+        {
+            ArrayVector3 v0, edge1, edge2;
+            v0.setAll( triangles[slot * 3u + 0u] );
+            edge1.setAll( triangles[slot * 3u + 1u] );
+            edge2.setAll( triangles[slot * 3u + 2u] );
+
+            const ArrayVector3 pVec = direction.crossProduct( edge2 );
+            const ArrayReal det = edge1.dotProduct( pVec );
+
+            ArrayMaskR mask = Mathlib::Or( Mathlib::CompareGreater( det, positiveDetThreshold ),
+                                           Mathlib::CompareLess( det, negativeDetThreshold ) );
+
+            //Avoid the division when all lanes failed (i.e. culled or parallel)
+            if( !BooleanMask4::getScalarMask( mask ) )
+                return;
+
+            const ArrayReal invDet = Mathlib::ONE / det;
+            const ArrayVector3 tVec = origin - v0;
+            const ArrayReal baryU = tVec.dotProduct( pVec ) * invDet;
+            const ArrayVector3 qVec = tVec.crossProduct( edge1 );
+            const ArrayReal baryV = direction.dotProduct( qVec ) * invDet;
+            const ArrayReal t = edge2.dotProduct( qVec ) * invDet;
+
+            //mask &= u >= 0 && v >= 0 && u + v <= 1 && t >= 0 && t < inOutMaxDistance
+            mask = Mathlib::And( mask, Mathlib::CompareGreaterEqual( baryU, ARRAY_REAL_ZERO ) );
+            mask = Mathlib::And( mask, Mathlib::CompareGreaterEqual( baryV, ARRAY_REAL_ZERO ) );
+            mask = Mathlib::And( mask, Mathlib::CompareLessEqual( baryU + baryV, Mathlib::ONE ) );
+            mask = Mathlib::And( mask, Mathlib::CompareGreaterEqual( t, ARRAY_REAL_ZERO ) );
+            mask = Mathlib::And( mask, Mathlib::CompareLess( t, inOutMaxDistance ) );
+
+            const uint32 scalarMask = BooleanMask4::getScalarMask( mask );
+            if( scalarMask )
+            {
+                //Bitwise select: inOutMaxDistance can be FLT_MAX (or inf), which
+                //Cmov4's arithmetic select can't handle
+                inOutMaxDistance = Mathlib::CmovRobust( t, inOutMaxDistance, mask );
+                for( size_t i=0; i<ARRAY_PACKED_REALS; ++i )
+                {
+                    if( IS_BIT_SET( i, scalarMask ) )
+                        closestSlot[i] = slot;
+                }
+                hitMask |= scalarMask;
+            }
+        }
+    };
+    //-----------------------------------------------------------------------------------
+    TriangleBvh::~TriangleBvh()
+    {
+    }
+    //-----------------------------------------------------------------------------------
+    void TriangleBvh::build( const float *vertexData, size_t vertexStride,
+                             const void *indexData, size_t numIndices, bool indices16bit,
+                             uint32 maxTrianglesPerLeaf )
+    {
+        assert( vertexStride >= 3u );
+
+        const size_t numTriangles = numIndices / 3u;
+
+        const uint16 * RESTRICT_ALIAS indexData16 =
+                reinterpret_cast<const uint16 * RESTRICT_ALIAS>( indexData );
+        const uint32 * RESTRICT_ALIAS indexData32 =
+                reinterpret_cast<const uint32 * RESTRICT_ALIAS>( indexData );
+
+        //Gather all vertices as triangle soup
+        vector<Vector3>::type triangles( numTriangles * 3u );
+        for( size_t i=0; i<numTriangles * 3u; ++i )
+        {
+            size_t vertexIdx = i;
+            if( indexData )
+                vertexIdx = indices16bit ? indexData16[i] : indexData32[i];
+
+            const float *position = vertexData + vertexIdx * vertexStride;
+            triangles[i] = Vector3( position[0], position[1], position[2] );
+        }
+
+        vector<Vector3>::type triMin( numTriangles );
+        vector<Vector3>::type triMax( numTriangles );
+        for( size_t i=0; i<numTriangles; ++i )
+        {
+            triMin[i] = triangles[i * 3u];
+            triMin[i].makeFloor( triangles[i * 3u + 1u] );
+            triMin[i].makeFloor( triangles[i * 3u + 2u] );
+            triMax[i] = triangles[i * 3u];
+            triMax[i].makeCeil( triangles[i * 3u + 1u] );
+            triMax[i].makeCeil( triangles[i * 3u + 2u] );
+        }
+
+        buildFromBounds( triMin.empty() ? 0 : &triMin[0], triMax.empty() ? 0 : &triMax[0],
+                         numTriangles, maxTrianglesPerLeaf );
+
+        //Store the triangles in leaf order, in the format Möller-Trumbore wants.
+        mTriangles.resize( numTriangles * 3u );
+        for( size_t slot=0; slot<numTriangles; ++slot )
+        {
+            const size_t triIdx = mPrimitiveIndices[slot];
+            const Vector3 &v0 = triangles[triIdx * 3u + 0u];
+            mTriangles[slot * 3u + 0u] = v0;
+            mTriangles[slot * 3u + 1u] = triangles[triIdx * 3u + 1u] - v0;
+            mTriangles[slot * 3u + 2u] = triangles[triIdx * 3u + 2u] - v0;
+        }
+    }
+    //-----------------------------------------------------------------------------------
+    bool TriangleBvh::build( VertexArrayObject *vao, uint32 maxTrianglesPerLeaf )
+    {
+        clear();
+        mTriangles.clear();
+
+        size_t bufferIdx, offset;
+        if( vao->getOperationType() != OT_TRIANGLE_LIST ||
+            !vao->findBySemantic( VES_POSITION, bufferIdx, offset ) )
+        {
+            return false;
+        }
+
+        IndexBufferPacked *indexBuffer = vao->getIndexBuffer();
+
+        VertexArrayObject::ReadRequestsArray readRequests;
+        readRequests.push_back( VertexArrayObject::ReadRequests( VES_POSITION ) );
+
+        //When not indexed, only the vertices in the primitive range are needed.
+        if( indexBuffer )
+            vao->readRequests( readRequests, 0, 0, true );
+        else
+            vao->readRequests( readRequests, vao->getPrimitiveStart(), vao->getPrimitiveCount(), true );
+
+        AsyncTicketPtr indexTicket;
+        if( indexBuffer && !indexBuffer->getShadowCopy() )
+        {
+            indexTicket = indexBuffer->readRequest( vao->getPrimitiveStart(),
+                                                    vao->getPrimitiveCount() );
+        }
+
+        const size_t numVertices = indexBuffer ? readRequests[0].vertexBuffer->getNumElements() :
+                                                 vao->getPrimitiveCount();
+        const bool isHalf = v1::VertexElement::getBaseType( readRequests[0].type ) == VET_HALF2;
+
+        float *positions = reinterpret_cast<float*>(
+                    OGRE_MALLOC_SIMD( numVertices * 3u * sizeof(float), MEMCATEGORY_GEOMETRY ) );
+
+        vao->mapAsyncTickets( readRequests );
+        for( size_t i=0; i<numVertices; ++i )
+        {
+            if( isHalf )
+            {
+                uint16 const * RESTRICT_ALIAS bufferF16 =
+                        reinterpret_cast<uint16 const * RESTRICT_ALIAS>( readRequests[0].data );
+                positions[i * 3u + 0u] = Bitwise::halfToFloat( bufferF16[0] );
+                positions[i * 3u + 1u] = Bitwise::halfToFloat( bufferF16[1] );
+                positions[i * 3u + 2u] = Bitwise::halfToFloat( bufferF16[2] );
+            }
+            else
+            {
+                float const * RESTRICT_ALIAS bufferF32 =
+                        reinterpret_cast<float const * RESTRICT_ALIAS>( readRequests[0].data );
+                positions[i * 3u + 0u] = bufferF32[0];
+                positions[i * 3u + 1u] = bufferF32[1];
+                positions[i * 3u + 2u] = bufferF32[2];
+            }
+            readRequests[0].data += readRequests[0].vertexBuffer->getBytesPerElement();
+        }
+        vao->unmapAsyncTickets( readRequests );
+
+        if( indexBuffer )
+        {
+            const bool indices16bit = indexBuffer->getIndexType() == IndexBufferPacked::IT_16BIT;
+            if( indexTicket.isNull() )
+            {
+                const uint8 *indexData = reinterpret_cast<const uint8*>(
+                                             indexBuffer->getShadowCopy() ) +
+                                         vao->getPrimitiveStart() *
+                                         indexBuffer->getBytesPerElement();
+                build( positions, 3u, indexData, vao->getPrimitiveCount(), indices16bit,
+                       maxTrianglesPerLeaf );
+            }
+            else
+            {
+                const void *indexData = indexTicket->map();
+                build( positions, 3u, indexData, vao->getPrimitiveCount(), indices16bit,
+                       maxTrianglesPerLeaf );
+                indexTicket->unmap();
+            }
+        }
+        else
+        {
+            build( positions, 3u, 0, numVertices, false, maxTrianglesPerLeaf );
+        }
+
+        OGRE_FREE_SIMD( positions, MEMCATEGORY_GEOMETRY );
+
+        return true;
+    }
+    //-----------------------------------------------------------------------------------
+    bool TriangleBvh::raycast( const Ray &ray, Real maxDistance,
+                               bool positiveSide, bool negativeSide, Hit &outHit ) const
+    {
+        if( mTriangles.empty() )
+            return false;
+
+        TriangleBvhRayTest rayTest;
+        rayTest.triangles       = &mTriangles[0];
+        rayTest.origin          = ray.getOrigin();
+        rayTest.direction       = ray.getDirection();
+        rayTest.positiveSide    = positiveSide;
+        rayTest.negativeSide    = negativeSide;
+        rayTest.closestSlot     = std::numeric_limits<uint32>::max();
+        rayTest.u               = 0;
+        rayTest.v               = 0;
+
+        Real distance = maxDistance;
+        traverse( ray, distance, rayTest );
+
+        if( rayTest.closestSlot == std::numeric_limits<uint32>::max() )
+            return false;
+
+        outHit.distance     = distance;
+        outHit.triangleIdx  = mPrimitiveIndices[rayTest.closestSlot];
+        outHit.u            = rayTest.u;
+        outHit.v            = rayTest.v;
+        return true;
+    }
+    //-----------------------------------------------------------------------------------
+    uint32 TriangleBvh::raycast( const ArrayRay &rays, ArrayReal &inOutDistance,
+                                 bool positiveSide, bool negativeSide,
+                                 uint32 outTriangleIdx[ARRAY_PACKED_REALS] ) const
+    {
+        if( mTriangles.empty() || (!positiveSide && !negativeSide) )
+            return 0;
+
+        TriangleBvhArrayRayTest rayTest;
+        rayTest.triangles   = &mTriangles[0];
+        rayTest.origin      = rays.mOrigin;
+        rayTest.direction   = rays.mDirection;
+        rayTest.hitMask     = 0;
+        rayTest.positiveDetThreshold = positiveSide ?
+                    Mathlib::SetAll( std::numeric_limits<Real>::epsilon() ) : Mathlib::MAX_POS;
+        rayTest.negativeDetThreshold = negativeSide ?
+                    Mathlib::SetAll( -std::numeric_limits<Real>::epsilon() ) : Mathlib::MAX_NEG;
+
+        traverse( rays, inOutDistance, rayTest );
+
+        for( size_t i=0; i<ARRAY_PACKED_REALS; ++i )
+        {
+            if( IS_BIT_SET( i, rayTest.hitMask ) )
+                outTriangleIdx[i] = mPrimitiveIndices[rayTest.closestSlot[i]];
+        }
+
+        return rayTest.hitMask;
+    }
+}
@@ -0,0 +1,307 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "OgreStableHeaders.h"
+
+#include "OgreCullingHierarchy.h"
+#include "OgreCamera.h"
+#include "Math/Array/OgreArrayAabb.h"
+
+namespace Ogre
+{
+    static inline void mergeNode( CullingHierarchy::Node &inOutNode,
+                                  const CullingHierarchy::Node &other )
+    {
+        inOutNode.vMin.makeFloor( other.vMin );
+        inOutNode.vMax.makeCeil( other.vMax );
+    }
+    //-----------------------------------------------------------------------------------
+    static inline CullingHierarchy::Node getEmptyNode(void)
+    {
+        CullingHierarchy::Node retVal;
+        retVal.vMin = Vector3( std::numeric_limits<Real>::max() );
+        retVal.vMax = Vector3( -std::numeric_limits<Real>::max() );
+        return retVal;
+    }
+    //-----------------------------------------------------------------------------------
+    //-----------------------------------------------------------------------------------
+    //-----------------------------------------------------------------------------------
+    CullingHierarchy::CullingHierarchy() :
+        mNumBlocks( 0 ),
+        mBuilt( false )
+    {
+    }
+    //-----------------------------------------------------------------------------------
+    void CullingHierarchy::_resize( size_t numObjs )
+    {
+        mBuilt = false;
+        mNumBlocks = ( numObjs + ARRAY_PACKED_REALS - 1u ) / ARRAY_PACKED_REALS;
+
+        size_t numLevels = 0;
+        size_t numNodes = mNumBlocks;
+        do
+        {
+            if( mLevels.size() <= numLevels )
+                mLevels.push_back( NodeVec() );
+            mLevels[numLevels].resize( numNodes );
+            ++numLevels;
+            numNodes = ( numNodes + BranchingFactor - 1u ) / BranchingFactor;
+        }
+        while( mLevels[numLevels - 1u].size() > BranchingFactor );
+
+        mLevels.resize( numLevels );
+    }
+    //-----------------------------------------------------------------------------------
+    void CullingHierarchy::_updateBlocks( ObjectData objData, size_t firstBlock, size_t numBlocks,
+                                          const MovableObject *dummyObject )
+    {
+        assert( firstBlock % BranchingFactor == 0 );
+        assert( firstBlock + numBlocks <= mNumBlocks );
+        assert( ( numBlocks % BranchingFactor == 0 || firstBlock + numBlocks == mNumBlocks ) &&
+                "Slices must own whole groups of blocks" );
+
+        //Infinite bounds (i.e. directional lights, or objects that were never updated) are
+        //clamped, so that the plane tests never see inf - inf
+        const Vector3 maxValue( std::numeric_limits<Real>::max() );
+        const Vector3 minValue( -std::numeric_limits<Real>::max() );
+
+        Node * RESTRICT_ALIAS blocks = mLevels[0].empty() ? 0 : &mLevels[0][firstBlock];
+
+        for( size_t i=0; i<numBlocks; ++i )
+        {
+            const ArrayVector3 arrayMin = objData.mWorldAabb->getMinimum();
+            const ArrayVector3 arrayMax = objData.mWorldAabb->getMaximum();
+
+            Node node = getEmptyNode();
+            for( size_t j=0; j<ARRAY_PACKED_REALS; ++j )
+            {
+                //Unused slots still have the bounds of the last object that lived there
+                if( objData.mOwner[j] != dummyObject )
+                {
+                    Vector3 vMin, vMax;
+                    arrayMin.getAsVector3( vMin, j );
+                    arrayMax.getAsVector3( vMax, j );
+                    node.vMin.makeFloor( vMin );
+                    node.vMax.makeCeil( vMax );
+                }
+            }
+
+            node.vMin.makeCeil( minValue );
+            node.vMax.makeFloor( maxValue );
+            blocks[i] = node;
+
+            objData.advancePack();
+        }
+
+        if( mLevels.size() > 1u )
+        {
+            const size_t endBlock   = firstBlock + numBlocks;
+            const size_t firstGroup = firstBlock / BranchingFactor;
+            const size_t endGroup   = ( endBlock + BranchingFactor - 1u ) / BranchingFactor;
+
+            for( size_t i=firstGroup; i<endGroup; ++i )
+            {
+                Node group = getEmptyNode();
+                const size_t lastChild = std::min<size_t>( (i + 1u) * BranchingFactor, endBlock );
+                for( size_t j=i * BranchingFactor; j<lastChild; ++j )
+                    mergeNode( group, mLevels[0][j] );
+                mLevels[1][i] = group;
+            }
+        }
+    }
+    //-----------------------------------------------------------------------------------
+    void CullingHierarchy::_updateUpperLevels(void)
+    {
+        const size_t numLevels = mLevels.size();
+        for( size_t level=2u; level<numLevels; ++level )
+        {
+            const NodeVec &children = mLevels[level - 1u];
+            NodeVec &parents = mLevels[level];
+
+            const size_t numParents = parents.size();
+            for( size_t i=0; i<numParents; ++i )
+            {
+                Node node = getEmptyNode();
+                const size_t lastChild = std::min<size_t>( (i + 1u) * BranchingFactor,
+                                                           children.size() );
+                for( size_t j=i * BranchingFactor; j<lastChild; ++j )
+                    mergeNode( node, children[j] );
+                parents[i] = node;
+            }
+        }
+
+        mBuilt = true;
+    }
+    //-----------------------------------------------------------------------------------
+    CullingHierarchy::Visibility CullingHierarchy::testNode(
+            const Node &node, const Frustum * const *frustums, size_t numFrustums,
+            const Frustum * const *cubemapFrustums, size_t numCubemapFrustums )
+    {
+        //Empty nodes (only unused slots)
+        if( node.vMin.x > node.vMax.x )
+            return Outside;
+
+        Visibility retVal = Outside;
+
+        //Same test as MovableObject::cullFrustum (the "positive vertex" of the box must be
+        //in front of all planes), plus the "negative vertex" to tell if the node is fully inside
+        for( size_t i=0; i<numFrustums && retVal != Inside; ++i )
+        {
+            const Plane *planes = frustums[i]->_getCachedFrustumPlanes();
+
+            bool isVisible  = true;
+            bool isInside   = true;
+            for( size_t j=0; j<6u && isVisible; ++j )
+            {
+                const Vector3 &normal = planes[j].normal;
+                const Vector3 positive( normal.x >= 0 ? node.vMax.x : node.vMin.x,
+                                        normal.y >= 0 ? node.vMax.y : node.vMin.y,
+                                        normal.z >= 0 ? node.vMax.z : node.vMin.z );
+                const Vector3 negative( normal.x >= 0 ? node.vMin.x : node.vMax.x,
+                                        normal.y >= 0 ? node.vMin.y : node.vMax.y,
+                                        normal.z >= 0 ? node.vMin.z : node.vMax.z );
+                isVisible = normal.dotProduct( positive ) > -planes[j].d;
+                isInside &= normal.dotProduct( negative ) > -planes[j].d;
+            }
+
+            if( isVisible )
+                retVal = isInside ? Inside : Partial;
+        }
+
+        for( size_t i=0; i<numCubemapFrustums && retVal == Outside; ++i )
+        {
+            assert( dynamic_cast<const Camera*>( cubemapFrustums[i] ) );
+            const Camera *camera = static_cast<const Camera*>( cubemapFrustums[i] );
+            const Vector3 &center = camera->_getCachedDerivedPosition();
+            const Vector3 halfSize( camera->getFarClipDistance() * 0.5f );
+
+            const Vector3 boxMin = center - halfSize;
+            const Vector3 boxMax = center + halfSize;
+            if( node.vMin.x <= boxMax.x && node.vMax.x >= boxMin.x &&
+                node.vMin.y <= boxMax.y && node.vMax.y >= boxMin.y &&
+                node.vMin.z <= boxMax.z && node.vMax.z >= boxMin.z )
+            {
+                retVal = Partial;
+            }
+        }
+
+        return retVal;
+    }
+    //-----------------------------------------------------------------------------------
+    void CullingHierarchy::addRange( size_t firstBlock, size_t numBlocks,
+                                     BlockRangeArray &outRanges )
+    {
+        if( !outRanges.empty() &&
+            outRanges.back().firstBlock + outRanges.back().numBlocks == firstBlock )
+        {
+            outRanges.back().numBlocks += numBlocks;
+        }
+        else
+        {
+            BlockRange range;
+            range.firstBlock = firstBlock;
+            range.numBlocks  = numBlocks;
+            outRanges.push_back( range );
+        }
+    }
+    //-----------------------------------------------------------------------------------
+    void CullingHierarchy::collectVisibleBlocks( size_t level, size_t nodeIdx,
+                                                 size_t firstBlock, size_t endBlock,
+                                                 const Frustum * const *frustums,
+                                                 size_t numFrustums,
+                                                 const Frustum * const *cubemapFrustums,
+                                                 size_t numCubemapFrustums,
+                                                 BlockRangeArray &outRanges ) const
+    {
+        size_t blocksPerNode = 1u;
+        for( size_t i=0; i<level; ++i )
+            blocksPerNode *= BranchingFactor;
+
+        const size_t nodeFirstBlock = std::max( nodeIdx * blocksPerNode, firstBlock );
+        const size_t nodeEndBlock   = std::min( (nodeIdx + 1u) * blocksPerNode, endBlock );
+
+        const Visibility visibility = testNode( mLevels[level][nodeIdx], frustums, numFrustums,
+                                                cubemapFrustums, numCubemapFrustums );
+
+        if( visibility == Inside || (visibility == Partial && level == 0) )
+        {
+            addRange( nodeFirstBlock, nodeEndBlock - nodeFirstBlock, outRanges );
+        }
+        else if( visibility == Partial )
+        {
+            const size_t childBlocks = blocksPerNode / BranchingFactor;
+            const size_t firstChild  = nodeFirstBlock / childBlocks;
+            const size_t endChild    = ( nodeEndBlock + childBlocks - 1u ) / childBlocks;
+
+            for( size_t i=firstChild; i<endChild; ++i )
+            {
+                collectVisibleBlocks( level - 1u, i, firstBlock, endBlock,
+                                      frustums, numFrustums, cubemapFrustums,
+                                      numCubemapFrustums, outRanges );
+            }
+        }
+    }
+    //-----------------------------------------------------------------------------------
+    void CullingHierarchy::collectVisibleBlocks( size_t firstBlock, size_t numBlocks,
+                                                 const Frustum * const *frustums,
+                                                 size_t numFrustums,
+                                                 const Frustum * const *cubemapFrustums,
+                                                 size_t numCubemapFrustums,
+                                                 BlockRangeArray &outRanges ) const
+    {
+        assert( mBuilt );
+
+        const size_t endBlock = firstBlock + numBlocks;
+        const size_t endBuiltBlock = std::min( endBlock, mNumBlocks );
+
+        if( firstBlock < endBuiltBlock )
+        {
+            const size_t topLevel = mLevels.size() - 1u;
+            size_t blocksPerNode = 1u;
+            for( size_t i=0; i<topLevel; ++i )
+                blocksPerNode *= BranchingFactor;
+
+            const size_t firstNode  = firstBlock / blocksPerNode;
+            const size_t endNode    = ( endBuiltBlock + blocksPerNode - 1u ) / blocksPerNode;
+
+            for( size_t i=firstNode; i<endNode; ++i )
+            {
+                collectVisibleBlocks( topLevel, i, firstBlock, endBuiltBlock,
+                                      frustums, numFrustums, cubemapFrustums,
+                                      numCubemapFrustums, outRanges );
+            }
+        }
+
+        //Objects created after the hierarchy was built
+        if( endBuiltBlock < endBlock )
+        {
+            const size_t first = std::max( firstBlock, endBuiltBlock );
+            addRange( first, endBlock - first, outRanges );
+        }
+    }
+}
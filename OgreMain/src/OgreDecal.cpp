@@ -58,6 +58,7 @@ namespace Ogre
         mObjectData.mWorldAabb->setFromAabb( aabb, mObjectData.mIndex );
         const float radius = aabb.getRadius();
         mObjectData.mLocalRadius[mObjectData.mIndex] = radius;
+        _notifyLocalAabbDirty();
         mObjectData.mWorldRadius[mObjectData.mIndex] = radius;
 
         //Disable shadow casting by default. Otherwise it's a waste or resources
@@ -28,6 +28,10 @@ THE SOFTWARE.
 #include "OgreStableHeaders.h"
 #include "OgreSceneManager.h"
 #include "OgreRoot.h"
+#include "OgreItem.h"
+#include "OgreSubItem.h"
+#include "OgreSubMesh2.h"
+#include "OgreBvh.h"
 
 #include "Math/Array/OgreMathlib.h"
 #include "Math/Array/OgreArraySphere.h"
@@ -339,7 +343,8 @@ namespace Ogre {
                 //Decompose the result for analyzing each MovableObject's
                 //There's no need to check objData.mOwner[j] is null because
                 //we set mVisibilityFlags to 0 on slot removals
-                if( IS_BIT_SET( j, scalarMask ) )
+                if( IS_BIT_SET( j, scalarMask ) &&
+                    (!mPrecise || raycastTriangles( objData.mOwner[j], scalarDistance[j] )) )
                 {
                     if( !listener->queryResult( objData.mOwner[j], scalarDistance[j] ) )
                         return false;
@@ -364,6 +369,46 @@ namespace Ogre {
         return true;
     }
     //---------------------------------------------------------------------
+    bool DefaultRaySceneQuery::raycastTriangles( MovableObject *movableObject, Real &inOutDistance )
+    {
+        if( movableObject->getMovableType() != ItemFactory::FACTORY_TYPE_NAME )
+            return true;
+
+        Item *item = static_cast<Item*>( movableObject );
+
+        //Bring the ray to mesh space. We don't normalize the direction
+        //so that the distances are the same in both spaces.
+        const Matrix4 invWorldMatrix = item->_getParentNodeFullTransform().inverseAffine();
+        const Ray localRay( invWorldMatrix.transformAffine( mRay.getOrigin() ),
+                            invWorldMatrix.transformDirectionAffine( mRay.getDirection() ) );
+
+        bool anyTested = false;
+        bool anyHit = false;
+        Real closest = std::numeric_limits<Real>::max();
+
+        const size_t numSubItems = item->getNumSubItems();
+        for( size_t i=0; i<numSubItems; ++i )
+        {
+            const TriangleBvh *bvh = item->getSubItem( i )->getSubMesh()->getTriangleBvh();
+            if( bvh )
+            {
+                TriangleBvh::Hit hit;
+                if( bvh->raycast( localRay, closest, true, true, hit ) )
+                {
+                    closest = hit.distance;
+                    anyHit = true;
+                }
+                anyTested = true;
+            }
+        }
+
+        if( anyHit )
+            inOutDistance = closest;
+
+        //If no SubMesh could be tested, keep the Aabb result
+        return anyHit || !anyTested;
+    }
+    //---------------------------------------------------------------------
     DefaultSphereSceneQuery::
     DefaultSphereSceneQuery(SceneManager* creator) : SphereSceneQuery(creator)
     {
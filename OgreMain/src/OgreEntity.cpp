@@ -227,6 +227,7 @@ namespace v1 {
         mObjectData.mLocalAabb->setFromAabb( aabb, mObjectData.mIndex );
         mObjectData.mWorldAabb->setFromAabb( aabb, mObjectData.mIndex );
         mObjectData.mLocalRadius[mObjectData.mIndex] = aabb.getRadius();
+        _notifyLocalAabbDirty();
         mObjectData.mWorldRadius[mObjectData.mIndex] = aabb.getRadius();
         if( mParentNode )
         {
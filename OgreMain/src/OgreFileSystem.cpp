@@ -46,6 +46,17 @@ THE SOFTWARE.
 #   include <sys/param.h>
 #endif
 
+#if OGRE_PLATFORM == OGRE_PLATFORM_LINUX || \
+    OGRE_PLATFORM == OGRE_PLATFORM_APPLE || \
+    OGRE_PLATFORM == OGRE_PLATFORM_APPLE_IOS || \
+    OGRE_PLATFORM == OGRE_PLATFORM_ANDROID || \
+    OGRE_PLATFORM == OGRE_PLATFORM_FREEBSD
+#   include <sys/mman.h>
+#   include <fcntl.h>
+#   include <unistd.h>
+#   define OGRE_FILESYSTEM_MMAP_POSIX 1
+#endif
+
 #if OGRE_PLATFORM == OGRE_PLATFORM_WIN32 || OGRE_PLATFORM == OGRE_PLATFORM_WINRT
 #  define WIN32_LEAN_AND_MEAN
 #  if !defined(NOMINMAX) && defined(_MSC_VER)
@@ -59,6 +70,42 @@ THE SOFTWARE.
 
 namespace Ogre {
 
+#if defined( OGRE_FILESYSTEM_MMAP_POSIX ) || OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+    /// Read-only MemoryDataStream backed by a memory mapped file. Unmaps the file on close.
+    class MappedFileDataStream : public MemoryDataStream
+    {
+        void *mMappedData;
+        size_t mMappedSize;
+
+    public:
+        MappedFileDataStream(const String& name, void* mappedData, size_t size) :
+            MemoryDataStream(name, mappedData, size, false, true),
+            mMappedData(mappedData),
+            mMappedSize(size)
+        {
+        }
+
+        ~MappedFileDataStream()
+        {
+            close();
+        }
+
+        virtual void close(void)
+        {
+            MemoryDataStream::close();
+            if (mMappedData)
+            {
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+                UnmapViewOfFile(mMappedData);
+#else
+                munmap(mMappedData, mMappedSize);
+#endif
+                mMappedData = 0;
+            }
+        }
+    };
+#endif
+
     bool FileSystemArchive::msIgnoreHidden = true;
 
     //-----------------------------------------------------------------------
@@ -369,6 +416,63 @@ namespace Ogre {
         return DataStreamPtr(stream);
     }
     //---------------------------------------------------------------------
+    DataStreamPtr FileSystemArchive::openMapped(const String& filename)
+    {
+#if defined( OGRE_FILESYSTEM_MMAP_POSIX ) || OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+        String full_path = concatenate_path(mName, filename);
+
+        void *mappedData = 0;
+        size_t fileSize = 0;
+
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+#ifdef _OGRE_FILESYSTEM_ARCHIVE_UNICODE
+        HANDLE hFile = CreateFileW(to_wpath(full_path).c_str(), GENERIC_READ, FILE_SHARE_READ, 0,
+                                   OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+#else
+        HANDLE hFile = CreateFileA(full_path.c_str(), GENERIC_READ, FILE_SHARE_READ, 0,
+                                   OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+#endif
+        if (hFile != INVALID_HANDLE_VALUE)
+        {
+            LARGE_INTEGER size;
+            if (GetFileSizeEx(hFile, &size) && size.QuadPart > 0)
+            {
+                HANDLE hMapping = CreateFileMappingA(hFile, 0, PAGE_READONLY, 0, 0, 0);
+                if (hMapping)
+                {
+                    mappedData = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+                    fileSize = static_cast<size_t>(size.QuadPart);
+                    // The view keeps the mapping alive
+                    CloseHandle(hMapping);
+                }
+            }
+            CloseHandle(hFile);
+        }
+#elif defined( OGRE_FILESYSTEM_MMAP_POSIX )
+        int fd = ::open(full_path.c_str(), O_RDONLY);
+        if (fd >= 0)
+        {
+            struct stat tagStat;
+            if (fstat(fd, &tagStat) == 0 && tagStat.st_size > 0)
+            {
+                fileSize = static_cast<size_t>(tagStat.st_size);
+                mappedData = mmap(0, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (mappedData == MAP_FAILED)
+                    mappedData = 0;
+            }
+            // The mapping keeps the file alive
+            ::close(fd);
+        }
+#endif
+
+        if (mappedData)
+            return DataStreamPtr(OGRE_NEW MappedFileDataStream(filename, mappedData, fileSize));
+#endif
+
+        // Empty file, or the platform / file can't be mapped
+        return Archive::openMapped(filename);
+    }
+    //---------------------------------------------------------------------
     DataStreamPtr FileSystemArchive::create(const String& filename)
     {
         if (isReadOnly())
@@ -55,6 +55,7 @@ THE SOFTWARE.
 #include "OgreRenderQueue.h"
 
 #include "OgreHlmsListener.h"
+#include "OgreHlmsDiskCache.h"
 #include "OgreBitset.h"
 
 #include "OgreProfiler.h"
@@ -291,7 +292,13 @@ namespace Ogre
         mDefaultDatablock( 0 ),
         mType( type ),
         mTypeName( typeName ),
-        mTypeNameStr( typeName )
+        mTypeNameStr( typeName ),
+        mIncrementalDiskCache( 0 ),
+        mAsyncShaderCompilation( false ),
+        mMaxAsyncShadersPerFrame( 0u ),
+        mNumShadersToGenerate( 0u ),
+        mNextShaderToGenerate( 0u ),
+        mShaderGenerationTask( this )
     {
         memset( mShaderTargets, 0, sizeof(mShaderTargets) );
 
@@ -321,6 +328,9 @@ namespace Ogre
     //-----------------------------------------------------------------------------------
     Hlms::~Hlms()
     {
+        if( mIncrementalDiskCache )
+            mIncrementalDiskCache->closeIncremental();
+
         clearShaderCache();
 
         _destroyAllDatablocks();
@@ -366,34 +376,47 @@ namespace Ogre
         }
     }
     //-----------------------------------------------------------------------------------
+    void Hlms::hashTemplateFiles( ShaderType shaderType, FastArray<uint8> &fileContents ) const
+    {
+        const String filename = ShaderFiles[shaderType] + mShaderFileExt;
+        if( mDataFolder->exists( filename ) )
+        {
+            //Library piece files first
+            LibraryVec::const_iterator itor = mLibrary.begin();
+            LibraryVec::const_iterator end  = mLibrary.end();
+
+            while( itor != end )
+            {
+                hashPieceFiles( itor->dataFolder, itor->pieceFiles[shaderType], fileContents );
+                ++itor;
+            }
+
+            //Main piece files
+            hashPieceFiles( mDataFolder, mPieceFiles[shaderType], fileContents );
+
+            //The shader file
+            DataStreamPtr inFile = mDataFolder->open( filename );
+            hashFileConcatenate( inFile, fileContents );
+        }
+    }
+    //-----------------------------------------------------------------------------------
     void Hlms::getTemplateChecksum( uint64 outHash[2] ) const
     {
         FastArray<uint8> fileContents;
         fileContents.resize( sizeof(uint64) * 2u, 0 );
 
         for( size_t i=0; i<NumShaderTypes; ++i )
-        {
-            const String filename = ShaderFiles[i] + mShaderFileExt;
-            if( mDataFolder->exists( filename ) )
-            {
-                //Library piece files first
-                LibraryVec::const_iterator itor = mLibrary.begin();
-                LibraryVec::const_iterator end  = mLibrary.end();
+            hashTemplateFiles( static_cast<ShaderType>( i ), fileContents );
 
-                while( itor != end )
-                {
-                    hashPieceFiles( itor->dataFolder, itor->pieceFiles[i], fileContents );
-                    ++itor;
-                }
+        memcpy( outHash, fileContents.begin(), sizeof(uint64) * 2u );
+    }
+    //-----------------------------------------------------------------------------------
+    void Hlms::getTemplateChecksum( ShaderType shaderType, uint64 outHash[2] ) const
+    {
+        FastArray<uint8> fileContents;
+        fileContents.resize( sizeof(uint64) * 2u, 0 );
 
-                //Main piece files
-                hashPieceFiles( mDataFolder, mPieceFiles[i], fileContents );
-
-                //The shader file
-                DataStreamPtr inFile = mDataFolder->open( filename );
-                hashFileConcatenate( inFile, fileContents );
-            }
-        }
+        hashTemplateFiles( shaderType, fileContents );
 
         memcpy( outHash, fileContents.begin(), sizeof(uint64) * 2u );
     }
@@ -697,7 +720,8 @@ namespace Ogre
         return isElse;
     }
     //-----------------------------------------------------------------------------------
-    bool Hlms::evaluateExpression( SubStringRef &outSubString, bool &outSyntaxError ) const
+    bool Hlms::evaluateExpression( SubStringRef &outSubString, bool &outSyntaxError,
+                                   const HlmsPropertyVec &properties ) const
     {
         size_t expEnd = evaluateExpressionEnd( outSubString );
 
@@ -803,7 +827,7 @@ namespace Ogre
             syntaxError = true;
 
         if( !syntaxError )
-            retVal = evaluateExpressionRecursive( outExpressions, syntaxError ) != 0;
+            retVal = evaluateExpressionRecursive( outExpressions, syntaxError, properties ) != 0;
 
         if( syntaxError )
             printf( "Syntax Error at line %lu\n", calculateLineCount( subString ) );
@@ -813,7 +837,8 @@ namespace Ogre
         return retVal;
     }
     //-----------------------------------------------------------------------------------
-    int32 Hlms::evaluateExpressionRecursive( ExpressionVec &expression, bool &outSyntaxError ) const
+    int32 Hlms::evaluateExpressionRecursive( ExpressionVec &expression, bool &outSyntaxError,
+                                             const HlmsPropertyVec &properties ) const
     {
         bool syntaxError = outSyntaxError;
         bool lastExpWasOperator = true;
@@ -913,13 +938,13 @@ namespace Ogre
                 if( exp.value.c_str() == endPtr )
                 {
                     //This isn't a number. Let's try if it's a variable
-                    exp.result = getProperty( exp.value );
+                    exp.result = getProperty( properties, exp.value );
                 }
                 lastExpWasOperator = false;
             }
             else
             {
-                exp.result = evaluateExpressionRecursive( exp.children, syntaxError );
+                exp.result = evaluateExpressionRecursive( exp.children, syntaxError, properties );
                 lastExpWasOperator = false;
             }
 
@@ -1132,19 +1157,20 @@ namespace Ogre
             Operation( "pmax", sizeof( "@pmax" ), &maxOp )
         };
     //-----------------------------------------------------------------------------------
-    inline int Hlms::interpretAsNumberThenAsProperty( const String &argValue ) const
+    inline int Hlms::interpretAsNumberThenAsProperty( const String &argValue,
+                                                      const HlmsPropertyVec &properties ) const
     {
         int opValue = StringConverter::parseInt( argValue, -std::numeric_limits<int>::max() );
         if( opValue == -std::numeric_limits<int>::max() )
         {
             //Not a number, interpret as property
-            opValue = getProperty( argValue );
+            opValue = getProperty( properties, argValue );
         }
 
         return opValue;
     }
     //-----------------------------------------------------------------------------------
-    bool Hlms::parseMath( const String &inBuffer, String &outBuffer )
+    bool Hlms::parseMath( const String &inBuffer, String &outBuffer, HlmsPropertyVec &properties )
     {
         outBuffer.clear();
         outBuffer.reserve( inBuffer.size() );
@@ -1189,11 +1215,12 @@ namespace Ogre
             {
                 const IdString dstProperty = argValues[0];
                 const size_t idx = argValues.size() == 3 ? 1 : 0;
-                const int op1Value = interpretAsNumberThenAsProperty( argValues[idx] );
-                const int op2Value = interpretAsNumberThenAsProperty( argValues[idx + 1] );
+                const int op1Value = interpretAsNumberThenAsProperty( argValues[idx], properties );
+                const int op2Value = interpretAsNumberThenAsProperty( argValues[idx + 1],
+                                                                      properties );
 
                 int result = c_operations[keyword].opFunc( op1Value, op2Value );
-                setProperty( dstProperty, result );
+                setProperty( properties, dstProperty, result );
             }
             else
             {
@@ -1236,7 +1263,8 @@ namespace Ogre
         return syntaxError;
     }
     //-----------------------------------------------------------------------------------
-    bool Hlms::parseForEach( const String &inBuffer, String &outBuffer ) const
+    bool Hlms::parseForEach( const String &inBuffer, String &outBuffer,
+                             const HlmsPropertyVec &properties ) const
     {
         outBuffer.clear();
         outBuffer.reserve( inBuffer.size() );
@@ -1265,8 +1293,8 @@ namespace Ogre
                 if( argValues[0].c_str() == endPtr )
                 {
                     //This isn't a number. Let's try if it's a variable
-                    //count = getProperty( argValues[0], -1 );
-					count = getProperty( argValues[0], 0 );
+                    //count = getProperty( properties, argValues[0], -1 );
+					count = getProperty( properties, argValues[0], 0 );
                 }
 
                 /*if( count < 0 )
@@ -1289,7 +1317,7 @@ namespace Ogre
                     if( argValues[2].c_str() == endPtr )
                     {
                         //This isn't a number. Let's try if it's a variable
-                        start = getProperty( argValues[2], -1 );
+                        start = getProperty( properties, argValues[2], -1 );
                     }
 
                     if( start < 0 )
@@ -1317,7 +1345,8 @@ namespace Ogre
         return syntaxError;
     }
     //-----------------------------------------------------------------------------------
-    bool Hlms::parseProperties( String &inBuffer, String &outBuffer ) const
+    bool Hlms::parseProperties( String &inBuffer, String &outBuffer,
+                                const HlmsPropertyVec &properties ) const
     {
         outBuffer.clear();
         outBuffer.reserve( inBuffer.size() );
@@ -1333,7 +1362,7 @@ namespace Ogre
             copy( outBuffer, subString, pos );
 
             subString.setStart( subString.getStart() + pos + sizeof( "@property" ) );
-            bool result = evaluateExpression( subString, syntaxError );
+            bool result = evaluateExpression( subString, syntaxError, properties );
 
             SubStringRef blockSubString = subString;
             bool isElse = findBlockEnd( blockSubString, syntaxError, true );
@@ -1369,7 +1398,7 @@ namespace Ogre
         return syntaxError;
     }
     //-----------------------------------------------------------------------------------
-    bool Hlms::parseUndefPieces( String &inBuffer, String &outBuffer )
+    bool Hlms::parseUndefPieces( String &inBuffer, String &outBuffer, PiecesMap &pieces )
     {
         outBuffer.clear();
         outBuffer.reserve( inBuffer.size() );
@@ -1393,9 +1422,9 @@ namespace Ogre
             if( !syntaxError )
             {
                 const IdString pieceName( argValues[0] );
-                PiecesMap::iterator it = mPieces.find( pieceName );
-                if( it != mPieces.end() )
-                    mPieces.erase( it );
+                PiecesMap::iterator it = pieces.find( pieceName );
+                if( it != pieces.end() )
+                    pieces.erase( it );
             }
             else
             {
@@ -1411,7 +1440,7 @@ namespace Ogre
         return syntaxError;
     }
     //-----------------------------------------------------------------------------------
-    bool Hlms::collectPieces( const String &inBuffer, String &outBuffer )
+    bool Hlms::collectPieces( const String &inBuffer, String &outBuffer, PiecesMap &pieces )
     {
         outBuffer.clear();
         outBuffer.reserve( inBuffer.size() );
@@ -1435,8 +1464,8 @@ namespace Ogre
             if( !syntaxError )
             {
                 const IdString pieceName( argValues[0] );
-                PiecesMap::const_iterator it = mPieces.find( pieceName );
-                if( it != mPieces.end() )
+                PiecesMap::const_iterator it = pieces.find( pieceName );
+                if( it != pieces.end() )
                 {
                     syntaxError = true;
                     printf( "Error at line %lu: @piece '%s' already defined",
@@ -1449,7 +1478,7 @@ namespace Ogre
 
                     String tmpBuffer;
                     copy( tmpBuffer, blockSubString, blockSubString.getSize() );
-                    mPieces[pieceName] = tmpBuffer;
+                    pieces[pieceName] = tmpBuffer;
 
                     subString.setStart( blockSubString.getEnd() + sizeof( "@end" ) );
                 }
@@ -1468,7 +1497,8 @@ namespace Ogre
         return syntaxError;
     }
     //-----------------------------------------------------------------------------------
-    bool Hlms::insertPieces( String &inBuffer, String &outBuffer ) const
+    bool Hlms::insertPieces( String &inBuffer, String &outBuffer,
+                             const PiecesMap &pieces ) const
     {
         outBuffer.clear();
         outBuffer.reserve( inBuffer.size() );
@@ -1492,8 +1522,8 @@ namespace Ogre
             if( !syntaxError )
             {
                 const IdString pieceName( argValues[0] );
-                PiecesMap::const_iterator it = mPieces.find( pieceName );
-                if( it != mPieces.end() )
+                PiecesMap::const_iterator it = pieces.find( pieceName );
+                if( it != pieces.end() )
                     outBuffer += it->second;
             }
             else
@@ -1524,7 +1554,7 @@ namespace Ogre
             Operation( "max", sizeof( "@max" ), &maxOp )
         };
     //-----------------------------------------------------------------------------------
-    bool Hlms::parseCounter( const String &inBuffer, String &outBuffer )
+    bool Hlms::parseCounter( const String &inBuffer, String &outBuffer, HlmsPropertyVec &properties )
     {
         outBuffer.clear();
         outBuffer.reserve( inBuffer.size() );
@@ -1574,7 +1604,7 @@ namespace Ogre
                 {
                     const IdString dstProperty = argValues[0];
                     const IdString srcProperty = dstProperty;
-                    int op1Value = getProperty( srcProperty );
+                    int op1Value = getProperty( properties, srcProperty );
 
                     //@value & @counter write, the others are invisible
                     char tmp[16];
@@ -1584,18 +1614,20 @@ namespace Ogre
                     if( keyword == 0 )
                     {
                         ++op1Value;
-                        setProperty( dstProperty, op1Value );
+                        setProperty( properties, dstProperty, op1Value );
                     }
                 }
                 else
                 {
                     const IdString dstProperty = argValues[0];
                     const size_t idx = argValues.size() == 3 ? 1 : 0;
-                    const int op1Value = interpretAsNumberThenAsProperty( argValues[idx] );
-                    const int op2Value = interpretAsNumberThenAsProperty( argValues[idx + 1] );
+                    const int op1Value = interpretAsNumberThenAsProperty( argValues[idx],
+                                                                          properties );
+                    const int op2Value = interpretAsNumberThenAsProperty( argValues[idx + 1],
+                                                                          properties );
 
                     int result = c_counterOperations[keyword].opFunc( op1Value, op2Value );
-                    setProperty( dstProperty, result );
+                    setProperty( properties, dstProperty, result );
                 }
             }
             else
@@ -1639,6 +1671,41 @@ namespace Ogre
         return syntaxError;
     }
     //-----------------------------------------------------------------------------------
+    bool Hlms::parseMath( const String &inBuffer, String &outBuffer )
+    {
+        return parseMath( inBuffer, outBuffer, mSetProperties );
+    }
+    //-----------------------------------------------------------------------------------
+    bool Hlms::parseForEach( const String &inBuffer, String &outBuffer ) const
+    {
+        return parseForEach( inBuffer, outBuffer, mSetProperties );
+    }
+    //-----------------------------------------------------------------------------------
+    bool Hlms::parseProperties( String &inBuffer, String &outBuffer ) const
+    {
+        return parseProperties( inBuffer, outBuffer, mSetProperties );
+    }
+    //-----------------------------------------------------------------------------------
+    bool Hlms::parseUndefPieces( String &inBuffer, String &outBuffer )
+    {
+        return parseUndefPieces( inBuffer, outBuffer, mPieces );
+    }
+    //-----------------------------------------------------------------------------------
+    bool Hlms::collectPieces( const String &inBuffer, String &outBuffer )
+    {
+        return collectPieces( inBuffer, outBuffer, mPieces );
+    }
+    //-----------------------------------------------------------------------------------
+    bool Hlms::insertPieces( String &inBuffer, String &outBuffer ) const
+    {
+        return insertPieces( inBuffer, outBuffer, mPieces );
+    }
+    //-----------------------------------------------------------------------------------
+    bool Hlms::parseCounter( const String &inBuffer, String &outBuffer )
+    {
+        return parseCounter( inBuffer, outBuffer, mSetProperties );
+    }
+    //-----------------------------------------------------------------------------------
     bool Hlms::parse( const String &inBuffer, String &outBuffer ) const
     {
         outBuffer.clear();
@@ -1749,6 +1816,9 @@ namespace Ogre
 
         mDataFolder = newDataFolder;
         enumeratePieceFiles();
+
+        if( mIncrementalDiskCache )
+            mIncrementalDiskCache->_notifyTemplatesChanged();
     }
     //-----------------------------------------------------------------------------------
     ArchiveVec Hlms::getPiecesLibraryAsArchiveVec(void) const
@@ -1941,9 +2011,12 @@ namespace Ogre
         shaderCache.clear();
 
         mShaderCodeCache.clear();
+
+        destroyPendingShaders();
     }
     //-----------------------------------------------------------------------------------
-    void Hlms::processPieces( Archive *archive, const StringVector &pieceFiles )
+    void Hlms::processPieces( Archive *archive, const StringVector &pieceFiles,
+                              HlmsPropertyVec &properties, PiecesMap &pieces )
     {
         StringVector::const_iterator itor = pieceFiles.begin();
         StringVector::const_iterator end  = pieceFiles.end();
@@ -1964,22 +2037,28 @@ namespace Ogre
                 inString.resize(inFile->size());
                 inFile->read(&inString[0], inFile->size());
 
-                this->parseMath(inString, outString);
+                this->parseMath( inString, outString, properties );
                 while( outString.find( "@foreach" ) != String::npos )
                 {
-                    this->parseForEach(outString, inString);
+                    this->parseForEach( outString, inString, properties );
                     inString.swap( outString );
                 }
-                this->parseProperties(outString, inString);
-                this->parseUndefPieces(inString, outString);
-                this->collectPieces(outString, inString);
-                this->parseCounter(inString, outString);
+                this->parseProperties( outString, inString, properties );
+                this->parseUndefPieces( inString, outString, pieces );
+                this->collectPieces( outString, inString, pieces );
+                this->parseCounter( inString, outString, properties );
             }
             ++itor;
         }
     }
     //-----------------------------------------------------------------------------------
-    void Hlms::dumpProperties( std::ofstream &outFile )
+    void Hlms::processPieces( Archive *archive, const StringVector &pieceFiles )
+    {
+        processPieces( archive, pieceFiles, mSetProperties, mPieces );
+    }
+    //-----------------------------------------------------------------------------------
+    void Hlms::dumpProperties( std::ofstream &outFile, const HlmsPropertyVec &properties,
+                               const PiecesMap &pieces )
     {
         outFile.write( "#if 0", sizeof( "#if 0" ) - 1u );
 
@@ -1988,8 +2067,8 @@ namespace Ogre
         LwString value( LwString::FromEmptyPointer( tmpBuffer, sizeof(tmpBuffer) ) );
 
         {
-            HlmsPropertyVec::const_iterator itor = mSetProperties.begin();
-            HlmsPropertyVec::const_iterator end  = mSetProperties.end();
+            HlmsPropertyVec::const_iterator itor = properties.begin();
+            HlmsPropertyVec::const_iterator end  = properties.end();
 
             while( itor != end )
             {
@@ -2009,8 +2088,8 @@ namespace Ogre
                        sizeof( "\n\tDONE DUMPING PROPERTIES" ) - 1u );
 
         {
-            PiecesMap::const_iterator itor = mPieces.begin();
-            PiecesMap::const_iterator end  = mPieces.end();
+            PiecesMap::const_iterator itor = pieces.begin();
+            PiecesMap::const_iterator end  = pieces.end();
 
             while( itor != end )
             {
@@ -2027,6 +2106,11 @@ namespace Ogre
                        sizeof( "\n\tDONE DUMPING PIECES\n#endif\n" ) - 1u );
     }
     //-----------------------------------------------------------------------------------
+    void Hlms::dumpProperties( std::ofstream &outFile )
+    {
+        dumpProperties( outFile, mSetProperties, mPieces );
+    }
+    //-----------------------------------------------------------------------------------
     void Hlms::applyStrongMacroblockRules( HlmsPso &pso )
     {
         if( !pso.macroblock->mDepthCheck )
@@ -2157,6 +2241,114 @@ namespace Ogre
         mShaderCodeCache.push_back( codeCache );
     }
     //-----------------------------------------------------------------------------------
+    bool Hlms::generateShaderStage( ShaderType shaderType, HlmsPropertyVec &properties,
+                                    PiecesMap &pieces, String &outSource,
+                                    const String &debugFilenameOutput, bool &outSyntaxError )
+    {
+        outSyntaxError = false;
+
+        const String filename = ShaderFiles[shaderType] + mShaderFileExt;
+        if( !mDataFolder->exists( filename ) )
+            return false;
+
+        if( mShaderProfile == "glsl" || mShaderProfile == "glslvk" ) //TODO: String comparision
+        {
+            setProperty( properties, HlmsBaseProp::GL3Plus,
+                         mRenderSystem->getNativeShadingLanguageVersion() );
+        }
+        else if( mShaderProfile == "glsles" ) //TODO: String comparision
+        {
+            setProperty( properties, HlmsBaseProp::GLES,
+                         mRenderSystem->getNativeShadingLanguageVersion() );
+        }
+
+        setProperty( properties, HlmsBaseProp::Syntax,  mShaderSyntax.mHash );
+        setProperty( properties, HlmsBaseProp::Hlsl,    HlmsBaseProp::Hlsl.mHash );
+        setProperty( properties, HlmsBaseProp::Glsl,    HlmsBaseProp::Glsl.mHash );
+        setProperty( properties, HlmsBaseProp::Glsles,  HlmsBaseProp::Glsles.mHash );
+        setProperty( properties, HlmsBaseProp::Glslvk,  HlmsBaseProp::Glslvk.mHash );
+        setProperty( properties, HlmsBaseProp::Hlslvk,  HlmsBaseProp::Hlslvk.mHash );
+        setProperty( properties, HlmsBaseProp::Metal,   HlmsBaseProp::Metal.mHash );
+
+#if OGRE_PLATFORM == OGRE_PLATFORM_APPLE_IOS
+        setProperty( properties, HlmsBaseProp::iOS, 1 );
+#endif
+#if OGRE_PLATFORM == OGRE_PLATFORM_APPLE
+        setProperty( properties, HlmsBaseProp::macOS, 1 );
+#endif
+        setProperty( properties, HlmsBaseProp::HighQuality, mHighQuality );
+
+        if( mFastShaderBuildHack )
+            setProperty( properties, HlmsBaseProp::FastShaderBuildHack, 1 );
+
+        std::ofstream debugDumpFile;
+        if( !debugFilenameOutput.empty() )
+        {
+            debugDumpFile.open( Ogre::fileSystemPathFromString(debugFilenameOutput).c_str(), std::ios::out | std::ios::binary );
+
+            //We need to dump the properties before processing the files, as these
+            //may be overwritten or polluted by the files, thus hiding why we
+            //got this permutation.
+            if( mDebugOutputProperties )
+                dumpProperties( debugDumpFile, properties, pieces );
+        }
+
+        //Library piece files first
+        LibraryVec::const_iterator itor = mLibrary.begin();
+        LibraryVec::const_iterator end  = mLibrary.end();
+
+        while( itor != end )
+        {
+            processPieces( itor->dataFolder, itor->pieceFiles[shaderType], properties, pieces );
+            ++itor;
+        }
+
+        //Main piece files
+        processPieces( mDataFolder, mPieceFiles[shaderType], properties, pieces );
+
+        //Generate the shader file.
+        DataStreamPtr inFile = mDataFolder->open( filename );
+
+        String inString;
+        String outString;
+
+        inString.resize( inFile->size() );
+        inFile->read( &inString[0], inFile->size() );
+
+        bool syntaxError = false;
+
+        syntaxError |= this->parseMath( inString, outString, properties );
+        while( !syntaxError && outString.find( "@foreach" ) != String::npos )
+        {
+            syntaxError |= this->parseForEach( outString, inString, properties );
+            inString.swap( outString );
+        }
+        syntaxError |= this->parseProperties( outString, inString, properties );
+        syntaxError |= this->parseUndefPieces( inString, outString, pieces );
+        while( !syntaxError  && (outString.find( "@piece" ) != String::npos ||
+                                 outString.find( "@insertpiece" ) != String::npos) )
+        {
+            syntaxError |= this->collectPieces( outString, inString, pieces );
+            syntaxError |= this->insertPieces( inString, outString, pieces );
+        }
+        syntaxError |= this->parseCounter( outString, inString, properties );
+
+        outSource.swap( inString );
+        outSyntaxError = syntaxError;
+
+        //Now dump the processed file.
+        if( !debugFilenameOutput.empty() )
+            debugDumpFile.write( &outSource[0], outSource.size() );
+
+        //Don't create and compile if template requested not to
+        const bool bCompile = getProperty( properties, HlmsBaseProp::DisableStage ) == 0;
+
+        //Reset the disable flag.
+        setProperty( properties, HlmsBaseProp::DisableStage, 0 );
+
+        return bCompile;
+    }
+    //-----------------------------------------------------------------------------------
     void Hlms::compileShaderCode( ShaderCodeCache &codeCache )
     {
         OgreProfileExhaustive( "Hlms::compileShaderCode" );
@@ -2164,6 +2356,21 @@ namespace Ogre
         //Give the shaders friendly base-10 names
         const uint32 finalHash = mType * 100000000u + static_cast<uint32>( mShaderCodeCache.size() );
 
+        String sources[NumShaderTypes];
+        HlmsPropertyVec stageProperties[NumShaderTypes];
+        bool stageUpToDate[NumShaderTypes];
+        for( size_t i=0; i<NumShaderTypes; ++i )
+            stageUpToDate[i] = false;
+
+        if( mIncrementalDiskCache )
+        {
+            mIncrementalDiskCache->_findShaderCode( codeCache.mergedCache, sources,
+                                                    stageProperties, stageUpToDate );
+        }
+
+        bool anySyntaxError = false;
+        bool anyStageParsed = false;
+
         mSetProperties = codeCache.mergedCache.setProperties;
 
         //Generate the shaders
@@ -2172,130 +2379,254 @@ namespace Ogre
             //Collect pieces
             mPieces = codeCache.mergedCache.pieces[i];
 
-            const String filename = ShaderFiles[i] + mShaderFileExt;
-            if( mDataFolder->exists( filename ) )
+            String debugFilenameOutput;
+            if( mDebugOutput )
             {
-                if( mShaderProfile == "glsl" || mShaderProfile == "glslvk" ) //TODO: String comparision
-                {
-                    setProperty( HlmsBaseProp::GL3Plus,
-                                 mRenderSystem->getNativeShadingLanguageVersion() );
-                }
-                else if( mShaderProfile == "glsles" ) //TODO: String comparision
+                debugFilenameOutput = mOutputPath + "./" +
+                                      StringConverter::toString( finalHash ) +
+                                      ShaderFiles[i] + mShaderFileExt;
+            }
+
+            bool bCompile;
+            bool syntaxError = false;
+            if( stageUpToDate[i] && mSetProperties == stageProperties[i] )
+            {
+                //Already parsed in a previous run, with the same templates & properties
+                bCompile = !sources[i].empty();
+                if( i + 1u < NumShaderTypes )
+                    mSetProperties = stageProperties[i + 1u];
+                if( bCompile && mDebugOutput )
                 {
-                    setProperty( HlmsBaseProp::GLES,
-                                 mRenderSystem->getNativeShadingLanguageVersion() );
+                    std::ofstream debugDumpFile;
+                    debugDumpFile.open( Ogre::fileSystemPathFromString(
+                                            debugFilenameOutput ).c_str(),
+                                        std::ios::out | std::ios::binary );
+                    debugDumpFile.write( &sources[i][0], sources[i].size() );
                 }
+            }
+            else
+            {
+                anyStageParsed = true;
+                if( mIncrementalDiskCache )
+                    stageProperties[i] = mSetProperties;
+                bCompile = generateShaderStage( static_cast<ShaderType>( i ), mSetProperties,
+                                                mPieces, sources[i], debugFilenameOutput,
+                                                syntaxError );
+            }
 
-                setProperty( HlmsBaseProp::Syntax,  mShaderSyntax.mHash );
-                setProperty( HlmsBaseProp::Hlsl,    HlmsBaseProp::Hlsl.mHash );
-                setProperty( HlmsBaseProp::Glsl,    HlmsBaseProp::Glsl.mHash );
-                setProperty( HlmsBaseProp::Glsles,  HlmsBaseProp::Glsles.mHash );
-                setProperty( HlmsBaseProp::Glslvk,  HlmsBaseProp::Glslvk.mHash );
-                setProperty( HlmsBaseProp::Hlslvk,  HlmsBaseProp::Hlslvk.mHash );
-                setProperty( HlmsBaseProp::Metal,   HlmsBaseProp::Metal.mHash );
+            if( syntaxError )
+            {
+                anySyntaxError = true;
+                LogManager::getSingleton().logMessage(
+                            "There were HLMS syntax errors while parsing "
+                            + StringConverter::toString( finalHash ) +
+                            ShaderFiles[i] );
+            }
 
-#if OGRE_PLATFORM == OGRE_PLATFORM_APPLE_IOS
-                setProperty( HlmsBaseProp::iOS, 1 );
-#endif
-#if OGRE_PLATFORM == OGRE_PLATFORM_APPLE
-                setProperty( HlmsBaseProp::macOS, 1 );
-#endif
-                setProperty( HlmsBaseProp::HighQuality, mHighQuality );
+            if( bCompile )
+            {
+                codeCache.shaders[i] = compileShaderCode( sources[i], debugFilenameOutput,
+                                                          finalHash, static_cast<ShaderType>( i ) );
+            }
+            else
+            {
+                sources[i].clear();
+            }
+        }
 
-                if( mFastShaderBuildHack )
-                    setProperty( HlmsBaseProp::FastShaderBuildHack, 1 );
+        if( mIncrementalDiskCache && anyStageParsed && !anySyntaxError )
+        {
+            mIncrementalDiskCache->_addShaderCode( codeCache.mergedCache, sources,
+                                                   stageProperties );
+        }
 
-                String debugFilenameOutput;
-                std::ofstream debugDumpFile;
-                if( mDebugOutput )
-                {
-                    debugFilenameOutput = mOutputPath + "./" +
-                                          StringConverter::toString( finalHash ) +
-                                          ShaderFiles[i] + mShaderFileExt;
-                    debugDumpFile.open( Ogre::fileSystemPathFromString(debugFilenameOutput).c_str(), std::ios::out | std::ios::binary );
+        mShaderCodeCache.push_back( codeCache );
+    }
+    //-----------------------------------------------------------------------------------
+    void Hlms::generatePendingShaderCode(void)
+    {
+        HlmsPropertyVec properties;
+        PiecesMap pieces;
 
-                    //We need to dump the properties before processing the files, as these
-                    //may be overwritten or polluted by the files, thus hiding why we
-                    //got this permutation.
-                    if( mDebugOutputProperties )
-                        dumpProperties( debugDumpFile );
-                }
+        while( true )
+        {
+            size_t jobIdx;
+            {
+                ScopedLock lock( mShaderGenerationMutex );
+                if( mNextShaderToGenerate >= mNumShadersToGenerate )
+                    break;
+                jobIdx = mNextShaderToGenerate++;
+            }
 
-                //Library piece files first
-                LibraryVec::const_iterator itor = mLibrary.begin();
-                LibraryVec::const_iterator end  = mLibrary.end();
+            PendingShaderCode *job = mPendingShaderCode[jobIdx];
+            if( job->fromDiskCache )
+                continue;
 
-                while( itor != end )
+            properties = job->codeCache.mergedCache.setProperties;
+            for( size_t i=0; i<NumShaderTypes; ++i )
+            {
+                if( job->stageUpToDate[i] && properties == job->stageProperties[i] )
                 {
-                    processPieces( itor->dataFolder, itor->pieceFiles[i] );
-                    ++itor;
+                    //Already parsed in a previous run, with the same templates & properties
+                    job->compile[i] = !job->source[i].empty();
+                    if( i + 1u < NumShaderTypes )
+                        properties = job->stageProperties[i + 1u];
                 }
+                else
+                {
+                    if( mIncrementalDiskCache )
+                        job->stageProperties[i] = properties;
+                    pieces = job->codeCache.mergedCache.pieces[i];
+                    job->compile[i] = generateShaderStage( static_cast<ShaderType>( i ),
+                                                           properties, pieces, job->source[i],
+                                                           BLANKSTRING, job->syntaxError[i] );
+                }
+            }
+        }
+    }
+    //-----------------------------------------------------------------------------------
+    void Hlms::ShaderGenerationTask::execute( size_t threadId, size_t numThreads )
+    {
+        mHlms->generatePendingShaderCode();
+    }
+    //-----------------------------------------------------------------------------------
+    void Hlms::_compilePendingShaders( SceneManager *sceneManager )
+    {
+        if( mPendingShaderCode.empty() )
+            return;
 
-                //Main piece files
-                processPieces( mDataFolder, mPieceFiles[i] );
+        OgreProfileExhaustive( "Hlms::_compilePendingShaders" );
 
-                //Generate the shader file.
-                DataStreamPtr inFile = mDataFolder->open( filename );
+        mNumShadersToGenerate = mPendingShaderCode.size();
+        if( mMaxAsyncShadersPerFrame )
+            mNumShadersToGenerate = std::min( mNumShadersToGenerate, mMaxAsyncShadersPerFrame );
+        mNextShaderToGenerate = 0;
 
-                String inString;
-                String outString;
+        if( mIncrementalDiskCache )
+        {
+            //The disk cache can only be accessed from the main thread
+            for( size_t i=0; i<mNumShadersToGenerate; ++i )
+            {
+                PendingShaderCode *job = mPendingShaderCode[i];
+                job->fromDiskCache = mIncrementalDiskCache->_findShaderCode(
+                                         job->codeCache.mergedCache, job->source,
+                                         job->stageProperties, job->stageUpToDate );
+                //Stages whose templates changed get parsed again in generatePendingShaderCode
+                for( size_t j=0; j<NumShaderTypes; ++j )
+                    job->fromDiskCache &= job->stageUpToDate[j];
+                for( size_t j=0; j<NumShaderTypes; ++j )
+                    job->compile[j] = job->fromDiskCache && !job->source[j].empty();
+            }
+        }
 
-                inString.resize( inFile->size() );
-                inFile->read( &inString[0], inFile->size() );
+        //Parse the templates in parallel
+        if( sceneManager && sceneManager->getNumWorkerThreads() > 1u && mNumShadersToGenerate > 1u )
+            sceneManager->executeUserScalableTask( &mShaderGenerationTask, true );
+        else
+            generatePendingShaderCode();
 
-                bool syntaxError = false;
+        //Creating the GPU programs must happen in the main thread
+        for( size_t i=0; i<mNumShadersToGenerate; ++i )
+        {
+            PendingShaderCode *job = mPendingShaderCode[i];
 
-                syntaxError |= this->parseMath( inString, outString );
-                while( !syntaxError && outString.find( "@foreach" ) != String::npos )
-                {
-                    syntaxError |= this->parseForEach( outString, inString );
-                    inString.swap( outString );
-                }
-                syntaxError |= this->parseProperties( outString, inString );
-                syntaxError |= this->parseUndefPieces( inString, outString );
-                while( !syntaxError  && (outString.find( "@piece" ) != String::npos ||
-                                         outString.find( "@insertpiece" ) != String::npos) )
-                {
-                    syntaxError |= this->collectPieces( outString, inString );
-                    syntaxError |= this->insertPieces( inString, outString );
-                }
-                syntaxError |= this->parseCounter( outString, inString );
+            //It may have been compiled synchronously while it was waiting.
+            ShaderCodeCacheVec::const_iterator itCodeCache = std::find( mShaderCodeCache.begin(),
+                                                                        mShaderCodeCache.end(),
+                                                                        job->codeCache );
+            if( itCodeCache == mShaderCodeCache.end() )
+            {
+                const uint32 finalHash = mType * 100000000u +
+                                         static_cast<uint32>( mShaderCodeCache.size() );
 
-                outString.swap( inString );
+                //compileShaderCode reads some of the merged properties
+                mSetProperties.swap( job->codeCache.mergedCache.setProperties );
 
-                if( syntaxError )
+                for( size_t j=0; j<NumShaderTypes; ++j )
                 {
-                    LogManager::getSingleton().logMessage(
-                                "There were HLMS syntax errors while parsing "
-                                + StringConverter::toString( finalHash ) +
-                                ShaderFiles[i] );
+                    if( job->syntaxError[j] )
+                    {
+                        LogManager::getSingleton().logMessage(
+                                    "There were HLMS syntax errors while parsing "
+                                    + StringConverter::toString( finalHash ) +
+                                    ShaderFiles[j] );
+                    }
+
+                    if( !job->compile[j] )
+                        continue;
+
+                    String debugFilenameOutput;
+                    if( mDebugOutput )
+                    {
+                        debugFilenameOutput = mOutputPath + "./" +
+                                              StringConverter::toString( finalHash ) +
+                                              ShaderFiles[j] + mShaderFileExt;
+                        std::ofstream debugDumpFile;
+                        debugDumpFile.open( Ogre::fileSystemPathFromString(
+                                                debugFilenameOutput ).c_str(),
+                                            std::ios::out | std::ios::binary );
+                        if( mDebugOutputProperties )
+                        {
+                            dumpProperties( debugDumpFile, mSetProperties,
+                                            job->codeCache.mergedCache.pieces[j] );
+                        }
+                        debugDumpFile.write( &job->source[j][0], job->source[j].size() );
+                    }
+
+                    job->codeCache.shaders[j] = compileShaderCode( job->source[j],
+                                                                   debugFilenameOutput, finalHash,
+                                                                   static_cast<ShaderType>( j ) );
                 }
 
-                //Now dump the processed file.
-                if( mDebugOutput )
-                    debugDumpFile.write( &outString[0], outString.size() );
+                mSetProperties.swap( job->codeCache.mergedCache.setProperties );
 
-                //Don't create and compile if template requested not to
-                if( !getProperty( HlmsBaseProp::DisableStage ) )
+                if( mIncrementalDiskCache && !job->fromDiskCache )
                 {
-                    codeCache.shaders[i] = compileShaderCode( outString, debugFilenameOutput,
-                                                              finalHash, static_cast<ShaderType>( i ) );
+                    bool anySyntaxError = false;
+                    for( size_t j=0; j<NumShaderTypes; ++j )
+                    {
+                        anySyntaxError |= job->syntaxError[j];
+                        if( !job->compile[j] )
+                            job->source[j].clear();
+                    }
+
+                    if( !anySyntaxError )
+                    {
+                        mIncrementalDiskCache->_addShaderCode( job->codeCache.mergedCache,
+                                                               job->source,
+                                                               job->stageProperties );
+                    }
                 }
 
-                //Reset the disable flag.
-                setProperty( HlmsBaseProp::DisableStage, 0 );
+                mShaderCodeCache.push_back( job->codeCache );
             }
+
+            OGRE_DELETE_T( job, PendingShaderCode, MEMCATEGORY_RENDERSYS );
         }
 
-        mShaderCodeCache.push_back( codeCache );
+        mPendingShaderCode.erase( mPendingShaderCode.begin(),
+                                  mPendingShaderCode.begin() + mNumShadersToGenerate );
+        mNumShadersToGenerate = 0;
+        mNextShaderToGenerate = 0;
     }
     //-----------------------------------------------------------------------------------
-    const HlmsCache* Hlms::createShaderCacheEntry( uint32 renderableHash, const HlmsCache &passCache,
-                                                   uint32 finalHash,
-                                                   const QueuedRenderable &queuedRenderable )
+    void Hlms::destroyPendingShaders(void)
     {
-        OgreProfileExhaustive( "Hlms::createShaderCacheEntry" );
+        PendingShaderCodeVec::const_iterator itor = mPendingShaderCode.begin();
+        PendingShaderCodeVec::const_iterator end  = mPendingShaderCode.end();
 
+        while( itor != end )
+        {
+            OGRE_DELETE_T( *itor, PendingShaderCode, MEMCATEGORY_RENDERSYS );
+            ++itor;
+        }
+
+        mPendingShaderCode.clear();
+    }
+    //-----------------------------------------------------------------------------------
+    void Hlms::mergeShaderCacheProperties( uint32 renderableHash, const HlmsCache &passCache,
+                                           const QueuedRenderable &queuedRenderable )
+    {
         //Set the properties by merging the cache from the pass, with the cache from renderable
         mSetProperties.clear();
         //If retVal is null, we did something wrong earlier
@@ -2336,11 +2667,53 @@ namespace Ogre
                                                       renderableCache.pieces,
                                                       mSetProperties, queuedRenderable );
 
-        //Retrieve the shader code from the code cache
-        ShaderCodeCache codeCache( renderableCache.pieces );
         unsetProperty( HlmsPsoProp::Macroblock );
         unsetProperty( HlmsPsoProp::Blendblock );
         unsetProperty( HlmsPsoProp::InputLayoutId );
+    }
+    //-----------------------------------------------------------------------------------
+    bool Hlms::requestShaderCode( uint32 renderableHash, const HlmsCache &passCache,
+                                  const QueuedRenderable &queuedRenderable )
+    {
+        mergeShaderCacheProperties( renderableHash, passCache, queuedRenderable );
+
+        ShaderCodeCache codeCache( getRenderableCache( renderableHash ).pieces );
+        codeCache.mergedCache.setProperties.swap( mSetProperties );
+
+        const bool isReady = std::find( mShaderCodeCache.begin(), mShaderCodeCache.end(),
+                                        codeCache ) != mShaderCodeCache.end();
+        if( !isReady )
+        {
+            PendingShaderCodeVec::const_iterator itor = mPendingShaderCode.begin();
+            PendingShaderCodeVec::const_iterator end  = mPendingShaderCode.end();
+
+            while( itor != end && !((*itor)->codeCache == codeCache) )
+                ++itor;
+
+            if( itor == end )
+            {
+                PendingShaderCode *job = OGRE_NEW_T( PendingShaderCode,
+                                                     MEMCATEGORY_RENDERSYS )( codeCache );
+                mPendingShaderCode.push_back( job );
+            }
+        }
+
+        codeCache.mergedCache.setProperties.swap( mSetProperties );
+
+        return isReady;
+    }
+    //-----------------------------------------------------------------------------------
+    const HlmsCache* Hlms::createShaderCacheEntry( uint32 renderableHash, const HlmsCache &passCache,
+                                                   uint32 finalHash,
+                                                   const QueuedRenderable &queuedRenderable )
+    {
+        OgreProfileExhaustive( "Hlms::createShaderCacheEntry" );
+
+        mergeShaderCacheProperties( renderableHash, passCache, queuedRenderable );
+
+        //Retrieve the shader code from the code cache
+        const RenderableCache &renderableCache = getRenderableCache( renderableHash );
+        ShaderCodeCache codeCache( renderableCache.pieces );
         codeCache.mergedCache.setProperties.swap( mSetProperties );
         {
             ShaderCodeCacheVec::iterator itCodeCache = std::find( mShaderCodeCache.begin(),
@@ -3243,7 +3616,7 @@ namespace Ogre
     const HlmsCache* Hlms::getMaterial( HlmsCache const *lastReturnedValue,
                                         const HlmsCache &passCache,
                                         const QueuedRenderable &queuedRenderable,
-                                        bool casterPass )
+                                        bool casterPass, bool allowPending )
     {
         uint32 finalHash;
         uint32 hash[2];
@@ -3267,6 +3640,13 @@ namespace Ogre
 
             if( !lastReturnedValue )
             {
+                if( allowPending && mAsyncShaderCompilation &&
+                    !requestShaderCode( hash[0], passCache, queuedRenderable ) )
+                {
+                    //Shader is being generated. Caller must skip this renderable.
+                    return 0;
+                }
+
                 lastReturnedValue = createShaderCacheEntry( hash[0], passCache, finalHash,
                                                             queuedRenderable );
             }
@@ -3275,6 +3655,28 @@ namespace Ogre
         return lastReturnedValue;
     }
     //-----------------------------------------------------------------------------------
+    uint32 Hlms::fillBuffersForV2Mt( size_t threadIdx, const HlmsCache *cache,
+                                     const QueuedRenderable &queuedRenderable,
+                                     bool casterPass, uint32 lastCacheHash,
+                                     CommandBuffer *commandBuffer )
+    {
+        OGRE_EXCEPT( Exception::ERR_NOT_IMPLEMENTED,
+                     "This Hlms does not support filling buffers from multiple threads. "
+                     "Check supportsParallelFillBuffers first.",
+                     "Hlms::fillBuffersForV2Mt" );
+    }
+    //-----------------------------------------------------------------------------------
+    void Hlms::_setIncrementalDiskCache( HlmsDiskCache *diskCache )
+    {
+        mIncrementalDiskCache = diskCache;
+    }
+    //-----------------------------------------------------------------------------------
+    void Hlms::setAsyncShaderCompilation( bool bEnable, size_t maxShadersPerFrame )
+    {
+        mAsyncShaderCompilation = bEnable;
+        mMaxAsyncShadersPerFrame = maxShadersPerFrame;
+    }
+    //-----------------------------------------------------------------------------------
     void Hlms::setDebugOutputPath( bool enableDebugOutput, bool outputProperties, const String &path )
     {
         mDebugOutput            = enableDebugOutput;
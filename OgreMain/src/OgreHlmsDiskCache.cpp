@@ -34,22 +34,42 @@ THE SOFTWARE.
 #include "OgreStringConverter.h"
 #include "OgreProfiler.h"
 
+#include "Hash/MurmurHash3.h"
+
+#include <fstream>
+
 #if OGRE_PLATFORM == OGRE_PLATFORM_APPLE_IOS
     #include "iOS/macUtils.h"
 #endif
 
+#if OGRE_ARCH_TYPE == OGRE_ARCHITECTURE_32
+    #define OGRE_HASH128_FUNC MurmurHash3_x86_128
+#else
+    #define OGRE_HASH128_FUNC MurmurHash3_x64_128
+#endif
+
 namespace Ogre
 {
     static const uint16 c_hlmsDiskCacheVersion = 1u;
 
+    static const uint32 c_hlmsIncrementalMagic = 0x49534C48u; //'HLSI'
+    static const uint16 c_hlmsIncrementalVersion = 2u;
+    /// uint32 payloadSize + uint64 key
+    static const size_t c_hlmsIncrementalRecordHeaderSize = sizeof(uint32) + sizeof(uint64);
+
     HlmsDiskCache::HlmsDiskCache( HlmsManager *hlmsManager ) :
         mTemplatesOutOfDate( false ),
-        mHlmsManager( hlmsManager )
+        mHlmsManager( hlmsManager ),
+        mDebugStrSize( 0 ),
+        mIncrementalHlms( 0 ),
+        mIncrementalFileSize( 0 )
     {
+        memset( mStageChecksums, 0, sizeof( mStageChecksums ) );
     }
     //-----------------------------------------------------------------------------------
     HlmsDiskCache::~HlmsDiskCache()
     {
+        closeIncremental();
         clearCache();
     }
     //-----------------------------------------------------------------------------------
@@ -605,4 +625,321 @@ namespace Ogre
             }
         }
     }
+    //-----------------------------------------------------------------------------------
+    //-----------------------------------------------------------------------------------
+    //-----------------------------------------------------------------------------------
+    uint64 HlmsDiskCache::calculateIncrementalKey( const Hlms::RenderableCache &mergedCache )
+    {
+        //IdString::mHash is all we need from the keys. Debug strings don't participate
+        //so that Debug & Release builds produce the same keys.
+        FastArray<uint8> data;
+        data.reserve( mergedCache.setProperties.size() * (sizeof(uint32) + sizeof(int32)) );
+
+        HlmsPropertyVec::const_iterator itor = mergedCache.setProperties.begin();
+        HlmsPropertyVec::const_iterator end  = mergedCache.setProperties.end();
+
+        while( itor != end )
+        {
+            const uint8 *keyHash = reinterpret_cast<const uint8*>( &itor->keyName.mHash );
+            const uint8 *value = reinterpret_cast<const uint8*>( &itor->value );
+            data.appendPOD( keyHash, keyHash + sizeof( itor->keyName.mHash ) );
+            data.appendPOD( value, value + sizeof( itor->value ) );
+            ++itor;
+        }
+
+        for( size_t i=0; i<NumShaderTypes; ++i )
+        {
+            //Separate the stages so that the same piece in different stages hashes differently
+            data.push_back( static_cast<uint8>( i ) );
+
+            PiecesMap::const_iterator itPiece = mergedCache.pieces[i].begin();
+            PiecesMap::const_iterator enPiece = mergedCache.pieces[i].end();
+
+            while( itPiece != enPiece )
+            {
+                const uint8 *keyHash = reinterpret_cast<const uint8*>( &itPiece->first.mHash );
+                const uint8 *value = reinterpret_cast<const uint8*>( itPiece->second.c_str() );
+                data.appendPOD( keyHash, keyHash + sizeof( itPiece->first.mHash ) );
+                data.appendPOD( value, value + itPiece->second.size() + 1u );
+                ++itPiece;
+            }
+        }
+
+        uint64 hashResult[2];
+        OGRE_HASH128_FUNC( data.begin(), static_cast<int>( data.size() ), IdString::Seed,
+                           hashResult );
+        return hashResult[0] ^ hashResult[1];
+    }
+    //-----------------------------------------------------------------------------------
+    void HlmsDiskCache::openIncrementalFile( bool truncate )
+    {
+        std::ios::openmode mode = std::ios::in | std::ios::out | std::ios::binary;
+        if( truncate )
+            mode |= std::ios::trunc;
+
+        std::fstream *fileStream = OGRE_NEW_T( std::fstream, MEMCATEGORY_GENERAL )();
+        fileStream->open( mIncrementalFilename.c_str(), mode );
+
+        if( !fileStream->is_open() && !truncate )
+        {
+            //in|out fails if the file doesn't exist. Create it.
+            fileStream->clear();
+            fileStream->open( mIncrementalFilename.c_str(), mode | std::ios::trunc );
+        }
+
+        if( !fileStream->is_open() )
+        {
+            OGRE_DELETE_T( fileStream, basic_fstream, MEMCATEGORY_GENERAL );
+            OGRE_EXCEPT( Exception::ERR_CANNOT_WRITE_TO_FILE,
+                         "Cannot open '" + mIncrementalFilename + "' for read/write",
+                         "HlmsDiskCache::openIncrementalFile" );
+        }
+
+        mIncrementalFile = DataStreamPtr( OGRE_NEW FileStreamDataStream( mIncrementalFilename,
+                                                                         fileStream, true ) );
+    }
+    //-----------------------------------------------------------------------------------
+    void HlmsDiskCache::writeIncrementalHeader(void)
+    {
+        mIncrementalFile->seek( 0 );
+        write<uint32>( mIncrementalFile, c_hlmsIncrementalMagic );
+        write<uint16>( mIncrementalFile, c_hlmsIncrementalVersion );
+#if OGRE_DEBUG_STR_SIZE > 0
+        write<uint16>( mIncrementalFile, OGRE_DEBUG_STR_SIZE );
+#else
+        write<uint16>( mIncrementalFile, 0 );
+#endif
+        write( mIncrementalFile, mCache.type );
+        save( mIncrementalFile, mShaderProfile );
+
+        mIncrementalFileSize = mIncrementalFile->tell();
+    }
+    //-----------------------------------------------------------------------------------
+    bool HlmsDiskCache::readIncrementalHeader(void)
+    {
+        //magic + version + debugStrSize + type + profile string length
+        const size_t minHeaderSize = sizeof(uint32) + sizeof(uint16) * 2u + sizeof(uint8) +
+                                     sizeof(uint32);
+        if( mIncrementalFile->size() < minHeaderSize )
+            return false;
+
+        mIncrementalFile->seek( 0 );
+        if( read<uint32>( mIncrementalFile ) != c_hlmsIncrementalMagic ||
+            read<uint16>( mIncrementalFile ) != c_hlmsIncrementalVersion )
+        {
+            LogManager::getSingleton().logMessage(
+                        "HlmsDiskCache: " + mIncrementalFilename + " has an unknown format or "
+                        "version. Discarding it." );
+            return false;
+        }
+
+        mDebugStrSize = read<uint16>( mIncrementalFile );
+#if OGRE_DEBUG_STR_SIZE > 0
+        if( OGRE_DEBUG_STR_SIZE != mDebugStrSize )
+        {
+            LogManager::getSingleton().logMessage(
+                        "HlmsDiskCache: " + mIncrementalFilename + " was built with a "
+                        "OGRE_DEBUG_STR_SIZE (IdString) of " +
+                        StringConverter::toString( mDebugStrSize ) + ". Discarding it." );
+            return false;
+        }
+#endif
+
+        const uint8 type = read<uint8>( mIncrementalFile );
+        const uint32 profileLength = read<uint32>( mIncrementalFile );
+        if( type != mCache.type || profileLength != mShaderProfile.size() )
+            return false;
+
+        String shaderProfile;
+        shaderProfile.resize( profileLength );
+        if( profileLength > 0u )
+            mIncrementalFile->read( &shaderProfile[0], profileLength );
+        if( shaderProfile != mShaderProfile )
+            return false;
+
+        mIncrementalFileSize = mIncrementalFile->tell();
+        return true;
+    }
+    //-----------------------------------------------------------------------------------
+    size_t HlmsDiskCache::indexIncrementalRecords(void)
+    {
+        const size_t fileSize = mIncrementalFile->size();
+        size_t offset = mIncrementalFileSize;
+
+        while( offset + c_hlmsIncrementalRecordHeaderSize <= fileSize )
+        {
+            mIncrementalFile->seek( offset );
+            const uint32 payloadSize = read<uint32>( mIncrementalFile );
+            const uint64 key = read<uint64>( mIncrementalFile );
+
+            const size_t payloadOffset = offset + c_hlmsIncrementalRecordHeaderSize;
+            if( payloadSize == 0u || payloadOffset + payloadSize > fileSize )
+                break; //Truncated record (i.e. we crashed while writing it)
+
+            //A later record with the same key supersedes the earlier one
+            //(i.e. it was regenerated because the templates changed)
+            mIncrementalIndex[key] = payloadOffset;
+            offset = payloadOffset + payloadSize;
+        }
+
+        return offset;
+    }
+    //-----------------------------------------------------------------------------------
+    void HlmsDiskCache::openIncremental( Hlms *hlms, const String &filename )
+    {
+        OGRE_ASSERT_LOW( hlms->getType() != HLMS_LOW_LEVEL && hlms->getType() != HLMS_COMPUTE );
+
+        closeIncremental();
+        clearCache();
+
+        mIncrementalHlms = hlms;
+        mIncrementalFilename = filename;
+        mCache.type = static_cast<uint8>( hlms->getType() );
+        mShaderProfile = hlms->getShaderProfile();
+        _notifyTemplatesChanged();
+
+        openIncrementalFile( false );
+
+        if( !readIncrementalHeader() )
+        {
+            openIncrementalFile( true );
+            writeIncrementalHeader();
+        }
+        else
+        {
+            const size_t validSize = indexIncrementalRecords();
+            if( validSize != mIncrementalFile->size() )
+            {
+                //Drop the trailing garbage, otherwise new records appended after
+                //the valid ones would leave part of it at the end of the file.
+                LogManager::getSingleton().logMessage(
+                            "HlmsDiskCache: " + mIncrementalFilename + " has a truncated record. "
+                            "Discarding it." );
+                FastArray<uint8> validData;
+                validData.resize( validSize );
+                mIncrementalFile->seek( 0 );
+                mIncrementalFile->read( validData.begin(), validSize );
+                openIncrementalFile( true );
+                mIncrementalFile->write( validData.begin(), validSize );
+            }
+            mIncrementalFileSize = validSize;
+        }
+
+        LogManager::getSingleton().logMessage(
+                    "HlmsDiskCache: Opened " + mIncrementalFilename + " with " +
+                    StringConverter::toString( mIncrementalIndex.size() ) + " entries" );
+
+        hlms->_setIncrementalDiskCache( this );
+    }
+    //-----------------------------------------------------------------------------------
+    void HlmsDiskCache::closeIncremental(void)
+    {
+        if( mIncrementalHlms )
+        {
+            mIncrementalHlms->_setIncrementalDiskCache( 0 );
+            mIncrementalHlms = 0;
+        }
+
+        if( mIncrementalFile )
+        {
+            mIncrementalFile->close();
+            mIncrementalFile.reset();
+        }
+
+        mIncrementalIndex.clear();
+        mIncrementalFileSize = 0;
+    }
+    //-----------------------------------------------------------------------------------
+    bool HlmsDiskCache::_findShaderCode( const Hlms::RenderableCache &mergedCache,
+                                         String outSource[NumShaderTypes],
+                                         HlmsPropertyVec outStageProperties[NumShaderTypes],
+                                         bool outUpToDate[NumShaderTypes] )
+    {
+        OgreProfileExhaustive( "HlmsDiskCache::_findShaderCode" );
+
+        for( size_t i=0; i<NumShaderTypes; ++i )
+            outUpToDate[i] = false;
+
+        const uint64 key = calculateIncrementalKey( mergedCache );
+        IncrementalIndexMap::const_iterator itor = mIncrementalIndex.find( key );
+        if( itor == mIncrementalIndex.end() )
+            return false;
+
+        mIncrementalFile->seek( itor->second );
+
+        uint64 stageChecksums[NumShaderTypes][2];
+        read( mIncrementalFile, stageChecksums );
+
+        bool anyUpToDate = false;
+        bool upToDate[NumShaderTypes];
+        for( size_t i=0; i<NumShaderTypes; ++i )
+        {
+            upToDate[i] = stageChecksums[i][0] == mStageChecksums[i][0] &&
+                          stageChecksums[i][1] == mStageChecksums[i][1];
+            anyUpToDate |= upToDate[i];
+        }
+
+        if( !anyUpToDate )
+            return false; //Every stage was generated with old templates
+
+        //Guard against key collisions
+        Hlms::RenderableCache storedCache( HlmsPropertyVec(), 0 );
+        load( mIncrementalFile, storedCache );
+        if( !(storedCache == mergedCache) )
+            return false;
+
+        for( size_t i=0; i<NumShaderTypes; ++i )
+        {
+            load( mIncrementalFile, outStageProperties[i] );
+            load( mIncrementalFile, outSource[i] );
+            outUpToDate[i] = upToDate[i];
+        }
+
+        return true;
+    }
+    //-----------------------------------------------------------------------------------
+    void HlmsDiskCache::_addShaderCode( const Hlms::RenderableCache &mergedCache,
+                                        const String source[NumShaderTypes],
+                                        const HlmsPropertyVec stageProperties[NumShaderTypes] )
+    {
+        OgreProfileExhaustive( "HlmsDiskCache::_addShaderCode" );
+
+        const uint64 key = calculateIncrementalKey( mergedCache );
+
+        mIncrementalFile->seek( mIncrementalFileSize );
+        write<uint32>( mIncrementalFile, 0u ); //Patched below
+        write( mIncrementalFile, key );
+
+        write( mIncrementalFile, mStageChecksums );
+        save( mIncrementalFile, mergedCache );
+        for( size_t i=0; i<NumShaderTypes; ++i )
+        {
+            save( mIncrementalFile, stageProperties[i] );
+            save( mIncrementalFile, source[i] );
+        }
+
+        const size_t payloadOffset = mIncrementalFileSize + c_hlmsIncrementalRecordHeaderSize;
+        const size_t endOffset = mIncrementalFile->tell();
+
+        //Write the size last, so that a record interrupted halfway is detected as truncated
+        mIncrementalFile->seek( mIncrementalFileSize );
+        write<uint32>( mIncrementalFile, static_cast<uint32>( endOffset - payloadOffset ) );
+
+        mIncrementalIndex[key] = payloadOffset;
+        mIncrementalFileSize = endOffset;
+    }
+    //-----------------------------------------------------------------------------------
+    void HlmsDiskCache::_notifyTemplatesChanged(void)
+    {
+        if( !mIncrementalHlms )
+            return;
+
+        for( size_t i=0; i<NumShaderTypes; ++i )
+        {
+            mIncrementalHlms->getTemplateChecksum( static_cast<ShaderType>( i ),
+                                                   mStageChecksums[i] );
+        }
+    }
 }
+
+#undef OGRE_HASH128_FUNC
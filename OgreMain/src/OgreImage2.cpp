@@ -975,13 +975,13 @@ namespace Ogre {
         case PFG_BGRA8_UNORM_SRGB:
             if( !gammaCorrected )
             {
-                downsampler2DFunc   = downscale2x_XXXA8888;
+                downsampler2DFunc   = downscale2x_XXXA8888_SIMD;
                 downsamplerCubeFunc = downscale2x_XXXA8888_cube;
                 separableBlur2DFunc = separableBlur_XXXA8888;
             }
             else
             {
-                downsampler2DFunc   = downscale2x_sRGB_XXXA8888;
+                downsampler2DFunc   = downscale2x_sRGB_XXXA8888_SIMD;
                 downsamplerCubeFunc = downscale2x_sRGB_XXXA8888_cube;
                 separableBlur2DFunc = separableBlur_sRGB_XXXA8888;
             }
@@ -1003,7 +1003,7 @@ namespace Ogre {
             separableBlur2DFunc = separableBlur_Signed_XXXA8888;
             break;
         case PFG_RGBA32_FLOAT:
-            downsampler2DFunc   = downscale2x_Float32_XXXA;
+            downsampler2DFunc   = downscale2x_Float32_XXXA_SIMD;
             downsamplerCubeFunc = downscale2x_Float32_XXXA_cube;
             separableBlur2DFunc = separableBlur_Float32_XXXA;
             break;
@@ -1018,7 +1018,7 @@ namespace Ogre {
             separableBlur2DFunc = separableBlur_Float32_XX;
             break;
         case PFG_R32_FLOAT:
-            downsampler2DFunc   = downscale2x_Float32_X;
+            downsampler2DFunc   = downscale2x_Float32_X_SIMD;
             downsamplerCubeFunc = downscale2x_Float32_X_cube;
             separableBlur2DFunc = separableBlur_Float32_X;
             break;
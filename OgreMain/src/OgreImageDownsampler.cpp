@@ -182,6 +182,7 @@ namespace Ogre
 #define OGRE_UINT8 uint8
 #define OGRE_UINT32 uint32
 #define OGRE_ROUND_HALF 0.5f
+#define OGRE_ROUND_UP( divisor ) ( divisor - 1u )
 
 #define OGRE_DOWNSAMPLE_R 0
 #define OGRE_DOWNSAMPLE_G 1
@@ -297,9 +298,11 @@ namespace Ogre
 #undef OGRE_UINT8
 #undef OGRE_UINT32
 #undef OGRE_ROUND_HALF
+#undef OGRE_ROUND_UP
 #define OGRE_UINT8 float
 #define OGRE_UINT32 float
 #define OGRE_ROUND_HALF 0.0f
+#define OGRE_ROUND_UP( divisor ) 0.0f
 
 #define OGRE_DOWNSAMPLE_R 0
 #define OGRE_DOWNSAMPLE_G 1
@@ -362,9 +365,11 @@ namespace Ogre
 #undef OGRE_UINT8
 #undef OGRE_UINT32
 #undef OGRE_ROUND_HALF
+#undef OGRE_ROUND_UP
 #define OGRE_UINT8 uint8
 #define OGRE_UINT32 uint32
 #define OGRE_ROUND_HALF 0.5f
+#define OGRE_ROUND_UP( divisor ) ( divisor - 1u )
 
 #define OGRE_DOWNSAMPLE_R 0
 #define OGRE_DOWNSAMPLE_G 1
@@ -119,7 +119,7 @@ namespace Ogre
 #endif
 #ifdef OGRE_DOWNSAMPLE_A
                 dstPtr[OGRE_DOWNSAMPLE_A] =
-                    static_cast<OGRE_UINT8>( ( accumA + divisor - 1u ) / divisor );
+                    static_cast<OGRE_UINT8>( ( accumA + OGRE_ROUND_UP( divisor ) ) / divisor );
 #endif
 
                 dstPtr += OGRE_TOTAL_SIZE;
@@ -253,7 +253,7 @@ namespace Ogre
 #endif
 #ifdef OGRE_DOWNSAMPLE_A
                 dstPtr[OGRE_DOWNSAMPLE_A] =
-                    static_cast<OGRE_UINT8>( ( accumA + divisor - 1u ) / divisor );
+                    static_cast<OGRE_UINT8>( ( accumA + OGRE_ROUND_UP( divisor ) ) / divisor );
 #endif
 
                 dstPtr += OGRE_TOTAL_SIZE;
@@ -337,7 +337,7 @@ namespace Ogre
 #endif
 #ifdef OGRE_DOWNSAMPLE_A
                 dstPtr[OGRE_DOWNSAMPLE_A] =
-                    static_cast<OGRE_UINT8>( ( accumA + divisor - 1u ) / divisor );
+                    static_cast<OGRE_UINT8>( ( accumA + OGRE_ROUND_UP( divisor ) ) / divisor );
 #endif
 
                 dstPtr += OGRE_TOTAL_SIZE;
@@ -415,7 +415,7 @@ namespace Ogre
 #endif
 #ifdef OGRE_DOWNSAMPLE_A
                 dstPtr[OGRE_DOWNSAMPLE_A] =
-                    static_cast<OGRE_UINT8>( ( accumA + divisor - 1u ) / divisor );
+                    static_cast<OGRE_UINT8>( ( accumA + OGRE_ROUND_UP( divisor ) ) / divisor );
 #endif
 
                 dstPtr += OGRE_TOTAL_SIZE;
@@ -499,7 +499,7 @@ namespace Ogre
 #endif
 #ifdef OGRE_DOWNSAMPLE_A
                 dstPtr[OGRE_DOWNSAMPLE_A] =
-                    static_cast<OGRE_UINT8>( ( accumA + divisor - 1u ) / divisor );
+                    static_cast<OGRE_UINT8>( ( accumA + OGRE_ROUND_UP( divisor ) ) / divisor );
 #endif
 
                 dstPtr += OGRE_TOTAL_SIZE;
@@ -574,7 +574,7 @@ namespace Ogre
 #endif
 #ifdef OGRE_DOWNSAMPLE_A
                 dstPtr[OGRE_DOWNSAMPLE_A] =
-                    static_cast<OGRE_UINT8>( ( accumA + divisor - 1u ) / divisor );
+                    static_cast<OGRE_UINT8>( ( accumA + OGRE_ROUND_UP( divisor ) ) / divisor );
 #endif
 
                 dstPtr += OGRE_TOTAL_SIZE;
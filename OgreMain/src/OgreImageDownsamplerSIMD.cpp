@@ -0,0 +1,439 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "OgreStableHeaders.h"
+
+#include "OgreImageDownsampler.h"
+#include "Math/Array/OgreArrayConfig.h"
+
+#if __OGRE_HAVE_NEON && (defined( __aarch64__ ) || defined( _M_ARM64 ))
+    #define OGRE_DOWNSAMPLE_NEON_SQRT 1
+#endif
+
+namespace Ogre
+{
+#if __OGRE_HAVE_SSE || __OGRE_HAVE_NEON
+    /** Returns true if the kernel is the 2x2 box filter (c_filterKernels[1]), which is
+        the only one with SIMD versions. Every other kernel goes through the scalar path.
+    */
+    static bool isBoxKernel( const uint8 kernel[5][5],
+                             const int8 kernelStartX, const int8 kernelEndX,
+                             const int8 kernelStartY, const int8 kernelEndY )
+    {
+        return kernelStartX == 0 && kernelEndX == 1 && kernelStartY == 0 && kernelEndY == 1 &&
+               kernel[2][2] == 1u && kernel[2][3] == 1u &&
+               kernel[3][2] == 1u && kernel[3][3] == 1u;
+    }
+
+    /** Downsamples using the box filter, c_downscaleBlockSize destination pixels at a time
+        using BlockFunc::execute.
+    @remarks
+        The scalar versions sample less pixels at the last row & column of the destination
+        image. Those are left to scalarFunc so that the results are bit-exact with the scalar
+        version. This is possible because the scalar versions clamp the kernel based on the
+        distance to the right & bottom edges, which doesn't change when calling them with
+        a dstPtr offsetted to the right, or with the last row alone.
+    */
+    template <size_t TotalSize, typename T, typename BlockFunc>
+    static void downscale2xBoxSimd( ImageDownsampler2D *scalarFunc, uint8 *dstPtr,
+                                    uint8 const *srcPtr, int32 dstWidth, int32 dstHeight,
+                                    int32 dstBytesPerRow, int32 srcWidth, int32 srcBytesPerRow,
+                                    const uint8 kernel[5][5],
+                                    const int8 kernelStartX, const int8 kernelEndX,
+                                    const int8 kernelStartY, const int8 kernelEndY )
+    {
+        const int32 c_downscaleBlockSize = 4;
+        const int32 simdWidth = ( ( dstWidth - 1 ) / c_downscaleBlockSize ) * c_downscaleBlockSize;
+
+        if( dstHeight < 2 || simdWidth <= 0 ||
+            !isBoxKernel( kernel, kernelStartX, kernelEndX, kernelStartY, kernelEndY ) )
+        {
+            ( *scalarFunc )( dstPtr, srcPtr, dstWidth, dstHeight, dstBytesPerRow, srcWidth,
+                             srcBytesPerRow, kernel, kernelStartX, kernelEndX, kernelStartY,
+                             kernelEndY );
+            return;
+        }
+
+        for( int32 y = 0; y < dstHeight - 1; ++y )
+        {
+            T *dst = reinterpret_cast<T *>( dstPtr + y * dstBytesPerRow );
+            T const *src0 = reinterpret_cast<T const *>( srcPtr + y * 2 * srcBytesPerRow );
+            T const *src1 = reinterpret_cast<T const *>( srcPtr + ( y * 2 + 1 ) * srcBytesPerRow );
+
+            for( int32 x = 0; x < simdWidth; x += c_downscaleBlockSize )
+            {
+                BlockFunc::execute( dst, src0, src1 );
+                dst += c_downscaleBlockSize * TotalSize;
+                src0 += c_downscaleBlockSize * TotalSize * 2u;
+                src1 += c_downscaleBlockSize * TotalSize * 2u;
+            }
+        }
+
+        // Right-most columns (all rows)
+        ( *scalarFunc )( dstPtr + simdWidth * TotalSize * sizeof( T ),
+                         srcPtr + simdWidth * TotalSize * sizeof( T ) * 2u, dstWidth - simdWidth,
+                         dstHeight, dstBytesPerRow, srcWidth, srcBytesPerRow, kernel, kernelStartX,
+                         kernelEndX, kernelStartY, kernelEndY );
+        // Last row (the right-most pixels are redone, but they're just a few)
+        ( *scalarFunc )( dstPtr + ( dstHeight - 1 ) * dstBytesPerRow,
+                         srcPtr + ( dstHeight - 1 ) * 2 * srcBytesPerRow, dstWidth, 1,
+                         dstBytesPerRow, srcWidth, srcBytesPerRow, kernel, kernelStartX, kernelEndX,
+                         kernelStartY, kernelEndY );
+    }
+#endif
+
+#if __OGRE_HAVE_SSE
+    //-----------------------------------------------------------------------------------
+    //  SSE2 blocks. Each one writes 4 destination pixels, reading 8 from each source row.
+    //-----------------------------------------------------------------------------------
+    struct DownscaleBlock_XXXA8888
+    {
+        static inline void execute( uint8 *dst, uint8 const *src0, uint8 const *src1 )
+        {
+            const __m128i zero = _mm_setzero_si128();
+            // Round to nearest for colour, round up for alpha (same as the scalar version)
+            const __m128i rounding = _mm_set_epi16( 3, 2, 2, 2, 3, 2, 2, 2 );
+
+            const __m128i r0a = _mm_loadu_si128( reinterpret_cast<const __m128i *>( src0 ) );
+            const __m128i r0b = _mm_loadu_si128( reinterpret_cast<const __m128i *>( src0 + 16 ) );
+            const __m128i r1a = _mm_loadu_si128( reinterpret_cast<const __m128i *>( src1 ) );
+            const __m128i r1b = _mm_loadu_si128( reinterpret_cast<const __m128i *>( src1 + 16 ) );
+
+            // Vertical sums, 2 source pixels per register
+            const __m128i v01 = _mm_add_epi16( _mm_unpacklo_epi8( r0a, zero ),
+                                               _mm_unpacklo_epi8( r1a, zero ) );
+            const __m128i v23 = _mm_add_epi16( _mm_unpackhi_epi8( r0a, zero ),
+                                               _mm_unpackhi_epi8( r1a, zero ) );
+            const __m128i v45 = _mm_add_epi16( _mm_unpacklo_epi8( r0b, zero ),
+                                               _mm_unpacklo_epi8( r1b, zero ) );
+            const __m128i v67 = _mm_add_epi16( _mm_unpackhi_epi8( r0b, zero ),
+                                               _mm_unpackhi_epi8( r1b, zero ) );
+
+            // Horizontal sums, 2 destination pixels per register
+            __m128i d01 = _mm_add_epi16( _mm_unpacklo_epi64( v01, v23 ),
+                                         _mm_unpackhi_epi64( v01, v23 ) );
+            __m128i d23 = _mm_add_epi16( _mm_unpacklo_epi64( v45, v67 ),
+                                         _mm_unpackhi_epi64( v45, v67 ) );
+
+            d01 = _mm_srli_epi16( _mm_add_epi16( d01, rounding ), 2 );
+            d23 = _mm_srli_epi16( _mm_add_epi16( d23, rounding ), 2 );
+
+            _mm_storeu_si128( reinterpret_cast<__m128i *>( dst ), _mm_packus_epi16( d01, d23 ) );
+        }
+    };
+    //-----------------------------------------------------------------------------------
+    /// Returns x * x for RGB and x for A, as floats, of 4 RGBA8 pixels
+    static inline void gammaToLinear_XXXA8888( __m128 outPixels[4], const __m128i rgba8 )
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128 alphaOne = _mm_castsi128_ps( _mm_set_epi32( 0x3F800000, 0, 0, 0 ) );
+        const __m128 rgbMask = _mm_castsi128_ps( _mm_set_epi32( 0, -1, -1, -1 ) );
+
+        const __m128i lo = _mm_unpacklo_epi8( rgba8, zero );
+        const __m128i hi = _mm_unpackhi_epi8( rgba8, zero );
+
+        __m128 px[4];
+        px[0] = _mm_cvtepi32_ps( _mm_unpacklo_epi16( lo, zero ) );
+        px[1] = _mm_cvtepi32_ps( _mm_unpackhi_epi16( lo, zero ) );
+        px[2] = _mm_cvtepi32_ps( _mm_unpacklo_epi16( hi, zero ) );
+        px[3] = _mm_cvtepi32_ps( _mm_unpackhi_epi16( hi, zero ) );
+
+        for( size_t i = 0; i < 4u; ++i )
+            outPixels[i] = _mm_mul_ps( px[i], _mm_or_ps( _mm_and_ps( px[i], rgbMask ), alphaOne ) );
+    }
+    //-----------------------------------------------------------------------------------
+    struct DownscaleBlock_sRGB_XXXA8888
+    {
+        static inline void execute( uint8 *dst, uint8 const *src0,
+        uint8 const *src1 )
+        {
+            const __m128 rgbMask = _mm_castsi128_ps( _mm_set_epi32( 0, -1, -1, -1 ) );
+            const __m128 quarter = _mm_set1_ps( 0.25f );
+            const __m128 colourRounding = _mm_set1_ps( 0.5f );
+            const __m128 alphaRounding = _mm_set1_ps( 3.0f );
+
+            const __m128i *src0Vec = reinterpret_cast<const __m128i *>( src0 );
+            const __m128i *src1Vec = reinterpret_cast<const __m128i *>( src1 );
+
+            __m128 r0[8], r1[8];
+            gammaToLinear_XXXA8888( r0 + 0, _mm_loadu_si128( src0Vec + 0 ) );
+            gammaToLinear_XXXA8888( r0 + 4, _mm_loadu_si128( src0Vec + 1 ) );
+            gammaToLinear_XXXA8888( r1 + 0, _mm_loadu_si128( src1Vec + 0 ) );
+            gammaToLinear_XXXA8888( r1 + 4, _mm_loadu_si128( src1Vec + 1 ) );
+
+            __m128i result[4];
+            for( size_t i = 0; i < 4u; ++i )
+            {
+                // All values are integers < 2^24, thus the sums are exact regardless of order
+                const __m128 accum = _mm_add_ps( _mm_add_ps( r0[i * 2u], r0[i * 2u + 1u] ),
+                                                 _mm_add_ps( r1[i * 2u], r1[i * 2u + 1u] ) );
+                const __m128 colour =
+                    _mm_add_ps( _mm_sqrt_ps( _mm_mul_ps( accum, quarter ) ), colourRounding );
+                const __m128 alpha = _mm_mul_ps( _mm_add_ps( accum, alphaRounding ), quarter );
+                result[i] = _mm_cvttps_epi32(
+                    _mm_or_ps( _mm_and_ps( rgbMask, colour ), _mm_andnot_ps( rgbMask, alpha ) ) );
+            }
+
+            const __m128i d01 = _mm_packs_epi32( result[0], result[1] );
+            const __m128i d23 = _mm_packs_epi32( result[2], result[3] );
+            _mm_storeu_si128( reinterpret_cast<__m128i *>( dst ), _mm_packus_epi16( d01, d23 ) );
+        }
+    };
+    //-----------------------------------------------------------------------------------
+    struct DownscaleBlock_Float32_XXXA
+    {
+        static inline void execute( float *dst, float const *src0,
+        float const *src1 )
+        {
+            const __m128 quarter = _mm_set1_ps( 0.25f );
+            for( size_t i = 0; i < 4u; ++i )
+            {
+                // Same summation order as the scalar version
+                __m128 accum = _mm_add_ps( _mm_loadu_ps( src0 ), _mm_loadu_ps( src0 + 4 ) );
+                accum = _mm_add_ps( accum, _mm_loadu_ps( src1 ) );
+                accum = _mm_add_ps( accum, _mm_loadu_ps( src1 + 4 ) );
+                _mm_storeu_ps( dst, _mm_mul_ps( accum, quarter ) );
+                dst += 4u;
+                src0 += 8u;
+                src1 += 8u;
+            }
+        }
+    };
+    //-----------------------------------------------------------------------------------
+    struct DownscaleBlock_Float32_X
+    {
+        static inline void execute( float *dst, float const *src0, float const *src1 )
+        {
+            const __m128 r0a = _mm_loadu_ps( src0 );
+            const __m128 r0b = _mm_loadu_ps( src0 + 4 );
+            const __m128 r1a = _mm_loadu_ps( src1 );
+            const __m128 r1b = _mm_loadu_ps( src1 + 4 );
+
+            __m128 accum = _mm_add_ps( _mm_shuffle_ps( r0a, r0b, _MM_SHUFFLE( 2, 0, 2, 0 ) ),
+                                       _mm_shuffle_ps( r0a, r0b, _MM_SHUFFLE( 3, 1, 3, 1 ) ) );
+            accum = _mm_add_ps( accum, _mm_shuffle_ps( r1a, r1b, _MM_SHUFFLE( 2, 0, 2, 0 ) ) );
+            accum = _mm_add_ps( accum, _mm_shuffle_ps( r1a, r1b, _MM_SHUFFLE( 3, 1, 3, 1 ) ) );
+            _mm_storeu_ps( dst, _mm_mul_ps( accum, _mm_set1_ps( 0.25f ) ) );
+        }
+    };
+#elif __OGRE_HAVE_NEON
+    //-----------------------------------------------------------------------------------
+    //  NEON blocks. Each one writes 4 destination pixels, reading 8 from each source row.
+    //-----------------------------------------------------------------------------------
+    static inline uint16x4_t sumPixelPair_XXXA8888( const uint16x8_t v )
+    {
+        return vadd_u16( vget_low_u16( v ), vget_high_u16( v ) );
+    }
+    //-----------------------------------------------------------------------------------
+    struct DownscaleBlock_XXXA8888
+    {
+        static inline void execute( uint8 *dst, uint8 const *src0, uint8 const *src1 )
+        {
+            const uint16_t c_rounding[8] = { 2, 2, 2, 3, 2, 2, 2, 3 };
+            const uint16x8_t rounding = vld1q_u16( c_rounding );
+
+            const uint8x16_t r0a = vld1q_u8( src0 );
+            const uint8x16_t r0b = vld1q_u8( src0 + 16 );
+            const uint8x16_t r1a = vld1q_u8( src1 );
+            const uint8x16_t r1b = vld1q_u8( src1 + 16 );
+
+            // Vertical sums, 2 source pixels per register
+            const uint16x8_t v01 = vaddl_u8( vget_low_u8( r0a ), vget_low_u8( r1a ) );
+            const uint16x8_t v23 = vaddl_u8( vget_high_u8( r0a ), vget_high_u8( r1a ) );
+            const uint16x8_t v45 = vaddl_u8( vget_low_u8( r0b ), vget_low_u8( r1b ) );
+            const uint16x8_t v67 = vaddl_u8( vget_high_u8( r0b ), vget_high_u8( r1b ) );
+
+            // Horizontal sums, 2 destination pixels per register
+            uint16x8_t d01 =
+                vcombine_u16( sumPixelPair_XXXA8888( v01 ), sumPixelPair_XXXA8888( v23 ) );
+            uint16x8_t d23 =
+                vcombine_u16( sumPixelPair_XXXA8888( v45 ), sumPixelPair_XXXA8888( v67 ) );
+
+            d01 = vshrq_n_u16( vaddq_u16( d01, rounding ), 2 );
+            d23 = vshrq_n_u16( vaddq_u16( d23, rounding ), 2 );
+
+            vst1q_u8( dst, vcombine_u8( vmovn_u16( d01 ), vmovn_u16( d23 ) ) );
+        }
+    };
+#if OGRE_DOWNSAMPLE_NEON_SQRT
+    //-----------------------------------------------------------------------------------
+    static inline void gammaToLinear_XXXA8888( float32x4_t outPixels[4], const uint8x16_t rgba8 )
+    {
+        const float c_alphaOne[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+        const uint32_t c_rgbMask[4] = { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0 };
+        const uint32x4_t alphaOne = vreinterpretq_u32_f32( vld1q_f32( c_alphaOne ) );
+        const uint32x4_t rgbMask = vld1q_u32( c_rgbMask );
+
+        const uint16x8_t lo = vmovl_u8( vget_low_u8( rgba8 ) );
+        const uint16x8_t hi = vmovl_u8( vget_high_u8( rgba8 ) );
+
+        float32x4_t px[4];
+        px[0] = vcvtq_f32_u32( vmovl_u16( vget_low_u16( lo ) ) );
+        px[1] = vcvtq_f32_u32( vmovl_u16( vget_high_u16( lo ) ) );
+        px[2] = vcvtq_f32_u32( vmovl_u16( vget_low_u16( hi ) ) );
+        px[3] = vcvtq_f32_u32( vmovl_u16( vget_high_u16( hi ) ) );
+
+        for( size_t i = 0; i < 4u; ++i )
+        {
+            const uint32x4_t factor =
+                vorrq_u32( vandq_u32( vreinterpretq_u32_f32( px[i] ), rgbMask ), alphaOne );
+            outPixels[i] = vmulq_f32( px[i], vreinterpretq_f32_u32( factor ) );
+        }
+    }
+    //-----------------------------------------------------------------------------------
+    struct DownscaleBlock_sRGB_XXXA8888
+    {
+        static inline void execute( uint8 *dst, uint8 const *src0,
+        uint8 const *src1 )
+        {
+            const uint32_t c_rgbMask[4] = { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0 };
+            const uint32x4_t rgbMask = vld1q_u32( c_rgbMask );
+            const float32x4_t quarter = vdupq_n_f32( 0.25f );
+            const float32x4_t colourRounding = vdupq_n_f32( 0.5f );
+            const float32x4_t alphaRounding = vdupq_n_f32( 3.0f );
+
+            float32x4_t r0[8], r1[8];
+            gammaToLinear_XXXA8888( r0 + 0, vld1q_u8( src0 ) );
+            gammaToLinear_XXXA8888( r0 + 4, vld1q_u8( src0 + 16 ) );
+            gammaToLinear_XXXA8888( r1 + 0, vld1q_u8( src1 ) );
+            gammaToLinear_XXXA8888( r1 + 4, vld1q_u8( src1 + 16 ) );
+
+            uint16x4_t result[4];
+            for( size_t i = 0; i < 4u; ++i )
+            {
+                // All values are integers < 2^24, thus the sums are exact regardless of order
+                const float32x4_t accum = vaddq_f32( vaddq_f32( r0[i * 2u], r0[i * 2u + 1u] ),
+                                                     vaddq_f32( r1[i * 2u], r1[i * 2u + 1u] ) );
+                const float32x4_t colour =
+                    vaddq_f32( vsqrtq_f32( vmulq_f32( accum, quarter ) ), colourRounding );
+                const float32x4_t alpha = vmulq_f32( vaddq_f32( accum, alphaRounding ), quarter );
+                result[i] = vmovn_u32( vcvtq_u32_f32( vbslq_f32( rgbMask, colour, alpha ) ) );
+            }
+
+            const uint16x8_t d01 = vcombine_u16( result[0], result[1] );
+            const uint16x8_t d23 = vcombine_u16( result[2], result[3] );
+            vst1q_u8( dst, vcombine_u8( vmovn_u16( d01 ), vmovn_u16( d23 ) ) );
+        }
+    };
+#endif
+    //-----------------------------------------------------------------------------------
+    struct DownscaleBlock_Float32_XXXA
+    {
+        static inline void execute( float *dst, float const *src0,
+        float const *src1 )
+        {
+            const float32x4_t quarter = vdupq_n_f32( 0.25f );
+            for( size_t i = 0; i < 4u; ++i )
+            {
+                // Same summation order as the scalar version
+                float32x4_t accum = vaddq_f32( vld1q_f32( src0 ), vld1q_f32( src0 + 4 ) );
+                accum = vaddq_f32( accum, vld1q_f32( src1 ) );
+                accum = vaddq_f32( accum, vld1q_f32( src1 + 4 ) );
+                vst1q_f32( dst, vmulq_f32( accum, quarter ) );
+                dst += 4u;
+                src0 += 8u;
+                src1 += 8u;
+            }
+        }
+    };
+    //-----------------------------------------------------------------------------------
+    struct DownscaleBlock_Float32_X
+    {
+        static inline void execute( float *dst, float const *src0, float const *src1 )
+        {
+            // vld2q deinterleaves even & odd pixels
+            const float32x4x2_t r0 = vld2q_f32( src0 );
+            const float32x4x2_t r1 = vld2q_f32( src1 );
+
+            float32x4_t accum = vaddq_f32( r0.val[0], r0.val[1] );
+            accum = vaddq_f32( accum, r1.val[0] );
+            accum = vaddq_f32( accum, r1.val[1] );
+            vst1q_f32( dst, vmulq_f32( accum, vdupq_n_f32( 0.25f ) ) );
+        }
+    };
+#endif
+
+#if __OGRE_HAVE_SSE || __OGRE_HAVE_NEON
+    #define OGRE_DOWNSAMPLE_SIMD_CALL( scalarFunc, totalSize, type, blockFunc ) \
+        downscale2xBoxSimd<totalSize, type, blockFunc>( \
+            scalarFunc, dstPtr, srcPtr, dstWidth, dstHeight, dstBytesPerRow, srcWidth, \
+            srcBytesPerRow, kernel, kernelStartX, kernelEndX, kernelStartY, kernelEndY )
+#else
+    #define OGRE_DOWNSAMPLE_SIMD_CALL( scalarFunc, totalSize, type, blockFunc ) \
+        scalarFunc( dstPtr, srcPtr, dstWidth, dstHeight, dstBytesPerRow, srcWidth, \
+                    srcBytesPerRow, kernel, kernelStartX, kernelEndX, kernelStartY, kernelEndY )
+#endif
+
+    //-----------------------------------------------------------------------------------
+    void downscale2x_XXXA8888_SIMD( uint8 *dstPtr, uint8 const *srcPtr, int32 dstWidth,
+                                    int32 dstHeight, int32 dstBytesPerRow, int32 srcWidth,
+                                    int32 srcBytesPerRow, const uint8 kernel[5][5],
+                                    const int8 kernelStartX, const int8 kernelEndX,
+                                    const int8 kernelStartY, const int8 kernelEndY )
+    {
+        OGRE_DOWNSAMPLE_SIMD_CALL( downscale2x_XXXA8888, 4u, uint8, DownscaleBlock_XXXA8888 );
+    }
+    //-----------------------------------------------------------------------------------
+    void downscale2x_sRGB_XXXA8888_SIMD( uint8 *dstPtr, uint8 const *srcPtr, int32 dstWidth,
+                                         int32 dstHeight, int32 dstBytesPerRow, int32 srcWidth,
+                                         int32 srcBytesPerRow, const uint8 kernel[5][5],
+                                         const int8 kernelStartX, const int8 kernelEndX,
+                                         const int8 kernelStartY, const int8 kernelEndY )
+    {
+#if __OGRE_HAVE_SSE || OGRE_DOWNSAMPLE_NEON_SQRT
+        OGRE_DOWNSAMPLE_SIMD_CALL( downscale2x_sRGB_XXXA8888, 4u, uint8,
+                                   DownscaleBlock_sRGB_XXXA8888 );
+#else
+        // 32-bit ARM has no exact vector square root
+        downscale2x_sRGB_XXXA8888( dstPtr, srcPtr, dstWidth, dstHeight, dstBytesPerRow, srcWidth,
+                                   srcBytesPerRow, kernel, kernelStartX, kernelEndX,
+                                   kernelStartY, kernelEndY );
+#endif
+    }
+    //-----------------------------------------------------------------------------------
+    void downscale2x_Float32_XXXA_SIMD( uint8 *dstPtr, uint8 const *srcPtr, int32 dstWidth,
+                                        int32 dstHeight, int32 dstBytesPerRow, int32 srcWidth,
+                                        int32 srcBytesPerRow, const uint8 kernel[5][5],
+                                        const int8 kernelStartX, const int8 kernelEndX,
+                                        const int8 kernelStartY, const int8 kernelEndY )
+    {
+        OGRE_DOWNSAMPLE_SIMD_CALL( downscale2x_Float32_XXXA, 4u, float,
+                                   DownscaleBlock_Float32_XXXA );
+    }
+    //-----------------------------------------------------------------------------------
+    void downscale2x_Float32_X_SIMD( uint8 *dstPtr, uint8 const *srcPtr, int32 dstWidth,
+                                     int32 dstHeight, int32 dstBytesPerRow, int32 srcWidth,
+                                     int32 srcBytesPerRow, const uint8 kernel[5][5],
+                                     const int8 kernelStartX, const int8 kernelEndX,
+                                     const int8 kernelStartY, const int8 kernelEndY )
+    {
+        OGRE_DOWNSAMPLE_SIMD_CALL( downscale2x_Float32_X, 1u, float, DownscaleBlock_Float32_X );
+    }
+}
+
+#undef OGRE_DOWNSAMPLE_SIMD_CALL
@@ -30,6 +30,8 @@ THE SOFTWARE.
 
 #include <algorithm>
 
+#include "Math/Array/OgreArrayConfig.h"
+
 // this file is inlined into OgreImage.cpp!
 // do not include anywhere else.
 namespace Ogre {
@@ -311,6 +313,53 @@ struct LinearResampler_Float32
 
 
 
+#if __OGRE_HAVE_SSE
+// bilinear filtering of a 4-channel byte pixel, same result as the scalar loop in
+// LinearResampler_Byte. The 8/24-bit weights don't fit 16-bit multiplies, so each
+// one is split in two 12-bit halves: accum = (sum(p * (w >> 12)) << 12) + sum(p * (w & 0xFFF))
+static inline __m128i packWeightPairs_SSE2( uint32 w1, uint32 w2 )
+{
+    return _mm_set1_epi32( static_cast<int>( (w2 << 16u) | w1 ) );
+}
+
+static inline void linearResampleByte4_SSE2( uchar *pdst, const uchar *p11, const uchar *p12,
+                                             const uchar *p21, const uchar *p22,
+                                             uint32 w11, uint32 w12, uint32 w21, uint32 w22 )
+{
+    const __m128i zero = _mm_setzero_si128();
+
+    int32 v11, v12, v21, v22;
+    memcpy( &v11, p11, sizeof( int32 ) );
+    memcpy( &v12, p12, sizeof( int32 ) );
+    memcpy( &v21, p21, sizeof( int32 ) );
+    memcpy( &v22, p22, sizeof( int32 ) );
+
+    // r11 r12 g11 g12 b11 b12 a11 a12 as 16-bit
+    const __m128i top = _mm_unpacklo_epi8(
+        _mm_unpacklo_epi8( _mm_cvtsi32_si128( v11 ), _mm_cvtsi32_si128( v12 ) ), zero );
+    const __m128i bottom = _mm_unpacklo_epi8(
+        _mm_unpacklo_epi8( _mm_cvtsi32_si128( v21 ), _mm_cvtsi32_si128( v22 ) ), zero );
+
+    const __m128i wTopHi = packWeightPairs_SSE2( w11 >> 12u, w12 >> 12u );
+    const __m128i wTopLo = packWeightPairs_SSE2( w11 & 0xFFFu, w12 & 0xFFFu );
+    const __m128i wBotHi = packWeightPairs_SSE2( w21 >> 12u, w22 >> 12u );
+    const __m128i wBotLo = packWeightPairs_SSE2( w21 & 0xFFFu, w22 & 0xFFFu );
+
+    const __m128i hi = _mm_add_epi32( _mm_madd_epi16( top, wTopHi ),
+                                      _mm_madd_epi16( bottom, wBotHi ) );
+    const __m128i lo = _mm_add_epi32( _mm_madd_epi16( top, wTopLo ),
+                                      _mm_madd_epi16( bottom, wBotLo ) );
+
+    __m128i accum = _mm_add_epi32( _mm_slli_epi32( hi, 12 ), lo );
+    accum = _mm_srli_epi32( _mm_add_epi32( accum, _mm_set1_epi32( 0x800000 ) ), 24 );
+    accum = _mm_packs_epi32( accum, accum );
+    accum = _mm_packus_epi16( accum, accum );
+
+    const int32 result = _mm_cvtsi128_si32( accum );
+    memcpy( pdst, &result, sizeof( int32 ) );
+}
+#endif
+
 // byte linear resampler, does not do any format conversions.
 // only handles pixel formats that use 1 byte per color channel.
 // 2D only; punts 3D pixelboxes to default LinearResampler (slow).
@@ -362,6 +411,21 @@ struct LinearResampler_Byte
                 uint32 sx2 = std::min(sx1+1, src.width-1);
 
                 unsigned int sxfsyf = sxf*syf;
+#if __OGRE_HAVE_SSE
+                if (channels == 4u) {
+                    linearResampleByte4_SSE2( pdst,
+                                              srcdata + syoff1 + sx1 * channels,
+                                              srcdata + syoff1 + sx2 * channels,
+                                              srcdata + syoff2 + sx1 * channels,
+                                              srcdata + syoff2 + sx2 * channels,
+                                              0x1000000-(sxf<<12)-(syf<<12)+sxfsyf,
+                                              (sxf<<12)-sxfsyf,
+                                              (syf<<12)-sxfsyf,
+                                              sxfsyf );
+                    pdst += channels;
+                    continue;
+                }
+#endif
                 for (unsigned int k = 0; k < channels; k++) {
                     unsigned int accum =
                         srcdata[syoff1+sx1*channels+k]*(0x1000000-(sxf<<12)-(syf<<12)+sxfsyf) +
@@ -99,6 +99,7 @@ namespace Ogre {
         {
             const SkeletonDef *skeletonDef = mMesh->getSkeleton().get();
             mSkeletonInstance = mManager->createSkeletonInstance( skeletonDef );
+            mSkeletonInstance->_setLodObject( this );
         }
 
         mLodMesh = mMesh->_getLodValueArray();
@@ -123,6 +124,7 @@ namespace Ogre {
         mObjectData.mLocalAabb->setFromAabb( aabb, mObjectData.mIndex );
         mObjectData.mWorldAabb->setFromAabb( aabb, mObjectData.mIndex );
         mObjectData.mLocalRadius[mObjectData.mIndex] = aabb.getRadius();
+        _notifyLocalAabbDirty();
         mObjectData.mWorldRadius[mObjectData.mIndex] = aabb.getRadius();
         if( mParentNode )
         {
@@ -146,6 +148,8 @@ namespace Ogre {
         assert( mManager || !mSkeletonInstance );
         if( mSkeletonInstance )
         {
+            if( mSkeletonInstance->_getLodObject() == this )
+                mSkeletonInstance->_setLodObject( 0 );
             mSkeletonInstance->_decrementRefCount();
             if( mSkeletonInstance->_getRefCount() == 0u )
                 mManager->destroySkeletonInstance( mSkeletonInstance );
@@ -307,6 +311,8 @@ namespace Ogre {
 
         if( mSkeletonInstance )
         {
+            if( mSkeletonInstance->_getLodObject() == this )
+                mSkeletonInstance->_setLodObject( 0 );
             mSkeletonInstance->_decrementRefCount();
             if( mSkeletonInstance->_getRefCount() == 0u )
                 mManager->destroySkeletonInstance( mSkeletonInstance );
@@ -323,12 +329,15 @@ namespace Ogre {
             assert( mSkeletonInstance->_getRefCount() > 1u &&
                     "This skeleton is Item is not sharing its skeleton!" );
 
+            if( mSkeletonInstance->_getLodObject() == this )
+                mSkeletonInstance->_setLodObject( 0 );
             mSkeletonInstance->_decrementRefCount();
             if( mSkeletonInstance->_getRefCount() == 0u )
                 mManager->destroySkeletonInstance( mSkeletonInstance );
 
             const SkeletonDef *skeletonDef = mMesh->getSkeleton().get();
             mSkeletonInstance = mManager->createSkeletonInstance( skeletonDef );
+            mSkeletonInstance->_setLodObject( this );
         }
     }
     //-----------------------------------------------------------------------
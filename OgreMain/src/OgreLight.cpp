@@ -93,6 +93,7 @@ namespace Ogre {
         case LT_DIRECTIONAL:
             mObjectData.mLocalAabb->setFromAabb( Aabb::BOX_INFINITE, mObjectData.mIndex );
             mObjectData.mLocalRadius[mObjectData.mIndex] = std::numeric_limits<Real>::infinity();
+            _notifyLocalAabbDirty();
             if( mAffectParentNode )
                 mParentNode->setScale( Vector3::UNIT_SCALE );
             break;
@@ -256,6 +257,8 @@ namespace Ogre {
                                                      mObjectData.mIndex );
             }
         }
+
+        _notifyLocalAabbDirty();
     }
     //-----------------------------------------------------------------------
     void Light::updateLightBounds(void)
@@ -315,6 +318,8 @@ namespace Ogre {
                 mParentNode->setScale( Vector3( mRange ) );
             }
         }
+
+        _notifyLocalAabbDirty();
     }
     //-----------------------------------------------------------------------
     void Light::setPowerScale(Real power)
@@ -76,6 +76,7 @@ namespace v1 {
         }
         mSectionList.clear();
         mObjectData.mLocalRadius[mObjectData.mIndex] = 0.0f;
+        _notifyLocalAabbDirty();
 
         mObjectData.mLocalAabb->setFromAabb( Aabb::BOX_NULL, mObjectData.mIndex );
 
@@ -281,6 +282,7 @@ namespace v1 {
         mObjectData.mLocalRadius[mObjectData.mIndex] = std::max(
                                                             mObjectData.mLocalRadius[mObjectData.mIndex],
                                                             mTempVertex.position.length());
+        _notifyLocalAabbDirty();
 
         // reset current texture coord
         mTexCoordIndex = 0;
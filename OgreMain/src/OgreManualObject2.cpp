@@ -78,6 +78,7 @@ namespace Ogre {
         mSectionList.clear();
 
         mObjectData.mLocalRadius[mObjectData.mIndex] = 0.0f;
+        _notifyLocalAabbDirty();
         mObjectData.mLocalAabb->setFromAabb( Aabb::BOX_NULL, mObjectData.mIndex );
 
         mRenderables.clear();
@@ -729,6 +730,7 @@ namespace Ogre {
         aabb.merge(mCurrentSection->mAabb);
         mObjectData.mLocalAabb->setFromAabb(aabb, mObjectData.mIndex);
         mObjectData.mLocalRadius[mObjectData.mIndex] = aabb.getRadius();
+        _notifyLocalAabbDirty();
 
         mCurrentSection = 0;
 
@@ -872,6 +874,7 @@ namespace Ogre {
 
         mObjectData.mLocalAabb->setFromAabb(aabb, mObjectData.mIndex);
         mObjectData.mLocalRadius[mObjectData.mIndex] = aabb.getRadius();
+        _notifyLocalAabbDirty();
     }
     //-----------------------------------------------------------------------------
     size_t ManualObject::currentIndexCount()
@@ -153,12 +153,24 @@ namespace Ogre {
         if (getCreator()->getVerbose())
             LogManager::getSingleton().logMessage("Mesh: Loading "+mName+".");
 
-        mFreshFromDisk =
-            ResourceGroupManager::getSingleton().openResource(
-                mName, mGroup, true, this);
- 
-        // fully prebuffer into host RAM
-        mFreshFromDisk = DataStreamPtr(OGRE_NEW MemoryDataStream(mName,mFreshFromDisk));
+        ResourceGroupManager &resourceGroupManager = ResourceGroupManager::getSingleton();
+
+        if( !resourceGroupManager.getLoadingListener() )
+        {
+            // Map the file (or fully prebuffer into host RAM if the archive can't map it)
+            // so that MeshSerializer can send vertex & index data to the GPU straight from it
+            Archive *archive = resourceGroupManager._getArchiveToResource( mName, mGroup );
+            mFreshFromDisk = archive->openMapped( mName );
+        }
+        else
+        {
+            // The listener may want to provide its own stream
+            mFreshFromDisk = resourceGroupManager.openResource( mName, mGroup, true, this );
+
+            // fully prebuffer into host RAM
+            if( !dynamic_cast<MemoryDataStream*>( mFreshFromDisk.get() ) )
+                mFreshFromDisk = DataStreamPtr(OGRE_NEW MemoryDataStream(mName,mFreshFromDisk));
+        }
     }
     //-----------------------------------------------------------------------
     void Mesh::unprepareImpl()
@@ -59,7 +59,10 @@ namespace Ogre {
     const long MSTREAM_OVERHEAD_SIZE = sizeof(uint16) + sizeof(uint32);
     //---------------------------------------------------------------------
     MeshSerializerImpl::MeshSerializerImpl( VaoManager *vaoManager ) :
-        mVaoManager( vaoManager )
+        mVaoManager( vaoManager ),
+        mMemoryStream( 0 ),
+        mVertexDataFromStream( false ),
+        mIndexDataFromStream( false )
     {
         // Version number
         mVersion = "[MeshSerializer_v2.1 R2]";
@@ -127,6 +130,15 @@ namespace Ogre {
 #endif
         // Check header
         readFileHeader(stream);
+
+        // If the buffers are shadowed, VaoManager takes ownership of the pointers
+        // we pass, so we can only avoid the copies when they aren't.
+        mMemoryStream = 0;
+        if( !mFlipEndian )
+            mMemoryStream = dynamic_cast<MemoryDataStream*>( stream.get() );
+        mVertexDataFromStream = mMemoryStream && !pMesh->isVertexBufferShadowed();
+        mIndexDataFromStream = mMemoryStream && !pMesh->isIndexBufferShadowed();
+
         pushInnerChunk(stream);
         uint16 streamID;
         while(!stream->eof())
@@ -141,6 +153,8 @@ namespace Ogre {
         }
         popInnerChunk(stream);
 
+        mMemoryStream = 0;
+
         if( !pMesh->hasValidShadowMappingVaos() )
             pMesh->prepareForShadowMapping( false );
     }
@@ -842,27 +856,7 @@ namespace Ogre {
         }
         catch( Exception& )
         {
-            SubMeshLodVec::iterator itor = totalSubmeshLods.begin();
-            SubMeshLodVec::iterator end  = totalSubmeshLods.end();
-
-            while( itor != end )
-            {
-                Uint8Vec::iterator it = itor->vertexBuffers.begin();
-                Uint8Vec::iterator en = itor->vertexBuffers.end();
-
-                while( it != en )
-                    OGRE_FREE_SIMD( *it++, MEMCATEGORY_GEOMETRY );
-
-                itor->vertexBuffers.clear();
-
-                if( itor->indexData )
-                {
-                    OGRE_FREE_SIMD( itor->indexData, MEMCATEGORY_GEOMETRY );
-                    itor->indexData = 0;
-                }
-
-                ++itor;
-            }
+            freeSubMeshLodData( totalSubmeshLods );
 
             //TODO: Delete created mVaos. Don't erase the data from those vaos?
 
@@ -897,7 +891,8 @@ namespace Ogre {
 
                     if( !sm->mParent->isVertexBufferShadowed() )
                     {
-                        OGRE_FREE_SIMD( submeshLods[i].vertexBuffers[0], MEMCATEGORY_GEOMETRY );
+                        if( !subMeshLod.vertexDataInStream )
+                            OGRE_FREE_SIMD( submeshLods[i].vertexBuffers[0], MEMCATEGORY_GEOMETRY );
                         submeshLods[i].vertexBuffers.erase( submeshLods[i].vertexBuffers.begin() );
                     }
 
@@ -941,7 +936,8 @@ namespace Ogre {
 
                 if( !sm->mParent->isIndexBufferShadowed() )
                 {
-                    OGRE_FREE_SIMD( subMeshLod.indexData, MEMCATEGORY_GEOMETRY );
+                    if( !subMeshLod.indexDataInStream )
+                        OGRE_FREE_SIMD( subMeshLod.indexData, MEMCATEGORY_GEOMETRY );
                     submeshLods[ i ].indexData = 0;
                 }
             }
@@ -953,6 +949,49 @@ namespace Ogre {
         }
     }
     //---------------------------------------------------------------------
+    void MeshSerializerImpl::freeSubMeshLodData( SubMeshLodVec &submeshLods )
+    {
+        SubMeshLodVec::iterator itor = submeshLods.begin();
+        SubMeshLodVec::iterator end  = submeshLods.end();
+
+        while( itor != end )
+        {
+            if( !itor->vertexDataInStream )
+            {
+                Uint8Vec::iterator it = itor->vertexBuffers.begin();
+                Uint8Vec::iterator en = itor->vertexBuffers.end();
+
+                while( it != en )
+                    OGRE_FREE_SIMD( *it++, MEMCATEGORY_GEOMETRY );
+            }
+
+            itor->vertexBuffers.clear();
+
+            if( itor->indexData && !itor->indexDataInStream )
+                OGRE_FREE_SIMD( itor->indexData, MEMCATEGORY_GEOMETRY );
+            itor->indexData = 0;
+
+            ++itor;
+        }
+    }
+    //---------------------------------------------------------------------
+    uint8* MeshSerializerImpl::borrowFromStream( DataStreamPtr &stream, size_t numBytes )
+    {
+        assert( mMemoryStream == stream.get() );
+
+        if( numBytes > stream->size() - stream->tell() )
+        {
+            OGRE_EXCEPT( Exception::ERR_INVALIDPARAMS,
+                         "Unexpected end of stream. The mesh " + stream->getName() +
+                         " is truncated or corrupt.",
+                         "MeshSerializerImpl::borrowFromStream" );
+        }
+
+        uint8 *retVal = mMemoryStream->getCurrentPtr();
+        stream->skip( static_cast<long>( numBytes ) );
+        return retVal;
+    }
+    //---------------------------------------------------------------------
     void MeshSerializerImpl::readSubMeshLod( DataStreamPtr& stream, Mesh *pMesh,
                                              SubMeshLod *subLod, uint8 currentLod )
     {
@@ -1028,7 +1067,13 @@ namespace Ogre {
         {
             readBools( stream, &subLod->index32Bit, 1 );
 
-            if( subLod->index32Bit )
+            if( mIndexDataFromStream )
+            {
+                const size_t bytesPerIndex = subLod->index32Bit ? sizeof(uint32) : sizeof(uint16);
+                subLod->indexData = borrowFromStream( stream, bytesPerIndex * subLod->numIndices );
+                subLod->indexDataInStream = true;
+            }
+            else if( subLod->index32Bit )
             {
                 subLod->indexData = OGRE_MALLOC_SIMD( sizeof(uint32) * subLod->numIndices,
                                                       MEMCATEGORY_GEOMETRY );
@@ -1135,6 +1180,15 @@ namespace Ogre {
                         "MeshSerializerImpl::readVertexBuffer");
         }
 
+        if( mVertexDataFromStream )
+        {
+            //Already in the final layout, no need to copy it (nor to flip it, we checked before)
+            subLod->vertexBuffers[source] = borrowFromStream( stream,
+                                                              bytesPerVertex * subLod->numVertices );
+            subLod->vertexDataInStream = true;
+            return;
+        }
+
         uint8 *vertexData = reinterpret_cast<uint8*>( OGRE_MALLOC_SIMD(
                                 sizeof(uint8) * bytesPerVertex * subLod->numVertices,
                                 MEMCATEGORY_GEOMETRY ) );
@@ -2229,7 +2283,10 @@ namespace Ogre {
         lodSource( 0 ),
         index32Bit( false ),
         numIndices( 0 ),
-        indexData( 0 )
+        indexData( 0 ),
+        operationType( OT_TRIANGLE_LIST ),
+        vertexDataInStream( false ),
+        indexDataInStream( false )
     {
     }
 
@@ -2292,27 +2349,7 @@ namespace Ogre {
         }
         catch( Exception& )
         {
-            SubMeshLodVec::iterator itor = totalSubmeshLods.begin();
-            SubMeshLodVec::iterator end  = totalSubmeshLods.end();
-
-            while( itor != end )
-            {
-                Uint8Vec::iterator it = itor->vertexBuffers.begin();
-                Uint8Vec::iterator en = itor->vertexBuffers.end();
-
-                while( it != en )
-                    OGRE_FREE_SIMD( *it++, MEMCATEGORY_GEOMETRY );
-
-                itor->vertexBuffers.clear();
-
-                if( itor->indexData )
-                {
-                    OGRE_FREE_SIMD( itor->indexData, MEMCATEGORY_GEOMETRY );
-                    itor->indexData = 0;
-                }
-
-                ++itor;
-            }
+            freeSubMeshLodData( totalSubmeshLods );
 
             //TODO: Delete created mVaos. Don't erase the data from those vaos?
 
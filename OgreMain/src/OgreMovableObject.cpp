@@ -133,6 +133,7 @@ namespace Ogre {
                 mObjectData.mParents[mObjectData.mIndex] = parent;
             else
                 mObjectData.mParents[mObjectData.mIndex] = mObjectMemoryManager->_getDummyNode();
+            _notifyLocalAabbDirty();
 
             setVisible( parent != 0 );
 
@@ -292,6 +293,7 @@ namespace Ogre {
     {
         mObjectData.mLocalAabb->setFromAabb( box, mObjectData.mIndex );
         mObjectData.mLocalRadius[mObjectData.mIndex] = box.getRadius();
+        _notifyLocalAabbDirty();
     }
     //-----------------------------------------------------------------------
     Aabb MovableObject::getLocalAabb() const
@@ -412,6 +414,62 @@ namespace Ogre {
             objData.mWorldAabb->transformAffine( parentMat );
             *worldRadius = (*localRadius) * parentScale.getMaxComponent();
 
+#if OGRE_DEBUG_MODE
+            for( size_t j=0; j<ARRAY_PACKED_REALS; ++j )
+            {
+                if( objData.mOwner[j] )
+                    objData.mOwner[j]->mCachedAabbOutOfDate = false;
+            }
+#endif
+
+            objData.advanceBoundsPack();
+        }
+    }
+    //-----------------------------------------------------------------------
+    void MovableObject::updateDirtyBounds( const size_t numNodes, ObjectData objData )
+    {
+        SimpleMatrix4 mats[ARRAY_PACKED_REALS];
+        for( size_t i=0; i<numNodes; i += ARRAY_PACKED_REALS )
+        {
+            uint8 anyDirty = 0;
+            for( size_t j=0; j<ARRAY_PACKED_REALS; ++j )
+            {
+                const Transform &parentTransform = objData.mParents[j]->_getTransform();
+                anyDirty |= objData.mDirtyFlags[j] |
+                            ( parentTransform.mDirtyFlags[parentTransform.mIndex] &
+                              Transform::DirtyDerived );
+            }
+
+            if( !anyDirty )
+            {
+                objData.advanceBoundsPack();
+                continue;
+            }
+
+            ArrayMatrix4 parentMat;
+            ArrayVector3 parentScale;
+
+            for( size_t j=0; j<ARRAY_PACKED_REALS; ++j )
+            {
+                Vector3 scale;
+                const Transform &parentTransform = objData.mParents[j]->_getTransform();
+                parentTransform.mDerivedScale->getAsVector3( scale, parentTransform.mIndex );
+                mats[j].load( parentTransform.mDerivedTransform[parentTransform.mIndex] );
+                parentScale.setFromVector3( scale, j );
+                objData.mDirtyFlags[j] = 0;
+            }
+
+            parentMat.loadFromAoS( mats );
+
+            ArrayReal * RESTRICT_ALIAS worldRadius = reinterpret_cast<ArrayReal*RESTRICT_ALIAS>
+                                                                        (objData.mWorldRadius);
+            ArrayReal * RESTRICT_ALIAS localRadius = reinterpret_cast<ArrayReal*RESTRICT_ALIAS>
+                                                                        (objData.mLocalRadius);
+
+            *objData.mWorldAabb = *objData.mLocalAabb;
+            objData.mWorldAabb->transformAffine( parentMat );
+            *worldRadius = (*localRadius) * parentScale.getMaxComponent();
+
 #if OGRE_DEBUG_MODE
             for( size_t j=0; j<ARRAY_PACKED_REALS; ++j )
             {
@@ -413,6 +413,23 @@ namespace Ogre {
         ArrayMatrix4 derivedTransform;
         for( size_t i=0; i<numNodes; i += ARRAY_PACKED_REALS )
         {
+            //Skip the whole block if neither these nodes nor their parents changed.
+            uint8 dirtyLanes[ARRAY_PACKED_REALS];
+            uint8 anyDirty = 0;
+            for( size_t j=0; j<ARRAY_PACKED_REALS; ++j )
+            {
+                const Transform &parentTransform = t.mParents[j]->mTransform;
+                const uint8 parentFlags = parentTransform.mDirtyFlags[parentTransform.mIndex];
+                dirtyLanes[j] = t.mDirtyFlags[j] | ( parentFlags & Transform::DirtyDerived );
+                anyDirty |= dirtyLanes[j];
+            }
+
+            if( !anyDirty )
+            {
+                t.advancePack();
+                continue;
+            }
+
 #if OGRE_NODE_INHERIT_TRANSFORM
             // determine our transform, without parent part
             ArrayMatrix4 trSoA;
@@ -504,6 +521,14 @@ namespace Ogre {
             }
 #endif
 
+            //Clean nodes sharing the block were recomputed too, but their results didn't
+            //change. Don't flag them, so their own children can still be skipped.
+            for( size_t j=0; j<ARRAY_PACKED_REALS; ++j )
+            {
+                if( dirtyLanes[j] )
+                    t.mDirtyFlags[j] |= Transform::DirtyDerived;
+            }
+
             t.advancePack();
         }
     }
@@ -587,6 +612,7 @@ namespace Ogre {
         assert(!q.isNaN() && "Invalid orientation supplied as parameter");
         q.normalise();
         mTransform.mOrientation->setFromQuaternion( q, mTransform.mIndex );
+        setLocalTransformDirty();
         CACHED_TRANSFORM_OUT_OF_DATE();
     }
     //-----------------------------------------------------------------------
@@ -598,6 +624,7 @@ namespace Ogre {
     void Node::resetOrientation(void)
     {
         mTransform.mOrientation->setFromQuaternion( Quaternion::IDENTITY, mTransform.mIndex );
+        setLocalTransformDirty();
     }
 
     //-----------------------------------------------------------------------
@@ -605,6 +632,7 @@ namespace Ogre {
     {
         assert(!pos.isNaN() && "Invalid vector supplied as parameter");
         mTransform.mPosition->setFromVector3( pos, mTransform.mIndex );
+        setLocalTransformDirty();
         CACHED_TRANSFORM_OUT_OF_DATE();
     }
     //-----------------------------------------------------------------------
@@ -667,6 +695,7 @@ namespace Ogre {
         }
 
         mTransform.mPosition->setFromVector3( position, mTransform.mIndex );
+        setLocalTransformDirty();
         CACHED_TRANSFORM_OUT_OF_DATE();
     }
     //-----------------------------------------------------------------------
@@ -738,6 +767,7 @@ namespace Ogre {
         orientation.normalise();
 
         mTransform.mOrientation->setFromQuaternion( orientation, mTransform.mIndex );
+        setLocalTransformDirty();
         CACHED_TRANSFORM_OUT_OF_DATE();
     }
 
@@ -877,6 +907,7 @@ namespace Ogre {
     {
         assert(!inScale.isNaN() && "Invalid vector supplied as parameter");
         mTransform.mScale->setFromVector3( inScale, mTransform.mIndex );
+        setLocalTransformDirty();
         CACHED_TRANSFORM_OUT_OF_DATE();
     }
     //-----------------------------------------------------------------------
@@ -893,6 +924,7 @@ namespace Ogre {
     void Node::setInheritOrientation(bool inherit)
     {
         mTransform.mInheritOrientation[mTransform.mIndex] = inherit;
+        setLocalTransformDirty();
         CACHED_TRANSFORM_OUT_OF_DATE();
     }
     //-----------------------------------------------------------------------
@@ -904,6 +936,7 @@ namespace Ogre {
     void Node::setInheritScale(bool inherit)
     {
         mTransform.mInheritScale[mTransform.mIndex] = inherit;
+        setLocalTransformDirty();
         CACHED_TRANSFORM_OUT_OF_DATE();
     }
     //-----------------------------------------------------------------------
@@ -916,6 +949,7 @@ namespace Ogre {
     {
         mTransform.mScale->setFromVector3( mTransform.mScale->getAsVector3( mTransform.mIndex ) *
                                             inScale, mTransform.mIndex );
+        setLocalTransformDirty();
         CACHED_TRANSFORM_OUT_OF_DATE();
     }
     //-----------------------------------------------------------------------
@@ -0,0 +1,553 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "OgreStableHeaders.h"
+
+#include "OgreOcclusionCuller.h"
+#include "OgreCamera.h"
+#include "OgreNode.h"
+#include "OgreSceneManager.h"
+#include "OgreMesh2.h"
+#include "OgreSubMesh2.h"
+#include "OgreBvh.h"
+#include "OgreException.h"
+#include "Math/Array/OgreArrayVector3.h"
+#include "Math/Array/OgreBooleanMask.h"
+
+namespace Ogre
+{
+    /// Vertices with a smaller w are considered to be behind the camera.
+    static const Real c_minW = 1e-5f;
+    /// Maximum number of slices used to transform the occluders.
+    static const size_t c_maxTransformSlices = 64u;
+
+    const uint32 OcclusionCuller::TileSize;
+    //-----------------------------------------------------------------------------------
+    static inline Real edgeFunction( Real ax, Real ay, Real bx, Real by, Real cx, Real cy )
+    {
+        return (ay - by) * cx + (bx - ax) * cy + (ax * by - ay * bx);
+    }
+    //-----------------------------------------------------------------------------------
+    //-----------------------------------------------------------------------------------
+    //-----------------------------------------------------------------------------------
+    void OcclusionCuller::TransformTask::execute( size_t threadId, size_t numThreads )
+    {
+        culler->transformOccluders( threadId, numThreads );
+    }
+    //-----------------------------------------------------------------------------------
+    void OcclusionCuller::RasterTask::execute( size_t threadId, size_t numThreads )
+    {
+        culler->rasterizeTileRow( threadId );
+    }
+    //-----------------------------------------------------------------------------------
+    //-----------------------------------------------------------------------------------
+    //-----------------------------------------------------------------------------------
+    OcclusionCuller::OcclusionCuller() :
+        mEnabled( false ),
+        mWidth( 0 ),
+        mHeight( 0 ),
+        mWidthInTiles( 0 ),
+        mHeightInTiles( 0 ),
+        mDepthBuffer( 0 ),
+        mHiZ( 0 ),
+        mHiZValid( false ),
+        mViewProjMatrix( Matrix4::IDENTITY )
+    {
+        mTransformTask.culler   = this;
+        mRasterTask.culler      = this;
+        setResolution( 256u, 128u );
+    }
+    //-----------------------------------------------------------------------------------
+    OcclusionCuller::~OcclusionCuller()
+    {
+        destroyAllOccluders();
+        freeBuffers();
+    }
+    //-----------------------------------------------------------------------------------
+    void OcclusionCuller::freeBuffers(void)
+    {
+        if( mDepthBuffer )
+        {
+            OGRE_FREE_SIMD( mDepthBuffer, MEMCATEGORY_SCENE_CONTROL );
+            mDepthBuffer = 0;
+        }
+        if( mHiZ )
+        {
+            OGRE_FREE_SIMD( mHiZ, MEMCATEGORY_SCENE_CONTROL );
+            mHiZ = 0;
+        }
+    }
+    //-----------------------------------------------------------------------------------
+    OcclusionCuller::Occluder* OcclusionCuller::addOccluder( Node *node, const Vector3 *positions,
+                                                              size_t numVertices,
+                                                              const uint32 *indices,
+                                                              size_t numIndices )
+    {
+        Occluder *occluder = OGRE_NEW_T( Occluder, MEMCATEGORY_SCENE_CONTROL );
+        occluder->node          = node;
+        occluder->firstTriangle = 0;
+        occluder->positions.assign( positions, positions + numVertices );
+
+        if( indices )
+        {
+            occluder->indices.reserve( numIndices - numIndices % 3u );
+            for( size_t i=0; i<numIndices - numIndices % 3u; ++i )
+            {
+                if( indices[i] >= numVertices )
+                {
+                    OGRE_DELETE_T( occluder, Occluder, MEMCATEGORY_SCENE_CONTROL );
+                    OGRE_EXCEPT( Exception::ERR_INVALIDPARAMS,
+                                 "Index out of bounds in occluder geometry",
+                                 "OcclusionCuller::addOccluder" );
+                }
+                occluder->indices.push_back( indices[i] );
+            }
+        }
+        else
+        {
+            occluder->indices.reserve( numVertices - numVertices % 3u );
+            for( size_t i=0; i<numVertices - numVertices % 3u; ++i )
+                occluder->indices.push_back( static_cast<uint32>( i ) );
+        }
+
+        mOccluders.push_back( occluder );
+        return occluder;
+    }
+    //-----------------------------------------------------------------------------------
+    OcclusionCuller::Occluder* OcclusionCuller::addOccluder( Node *node, Mesh *mesh )
+    {
+        vector<Vector3>::type positions;
+
+        const unsigned short numSubMeshes = mesh->getNumSubMeshes();
+        for( unsigned short i=0; i<numSubMeshes; ++i )
+        {
+            const TriangleBvh *bvh = mesh->getSubMesh( i )->getTriangleBvh();
+            if( bvh )
+            {
+                const size_t numTriangles = bvh->getNumTriangles();
+                for( size_t j=0; j<numTriangles; ++j )
+                {
+                    Vector3 v0, v1, v2;
+                    bvh->getTriangle( j, v0, v1, v2 );
+                    positions.push_back( v0 );
+                    positions.push_back( v1 );
+                    positions.push_back( v2 );
+                }
+            }
+        }
+
+        return addOccluder( node, positions.empty() ? 0 : &positions[0], positions.size(), 0, 0 );
+    }
+    //-----------------------------------------------------------------------------------
+    void OcclusionCuller::destroyOccluder( Occluder *occluder )
+    {
+        OccluderVec::iterator itor = std::find( mOccluders.begin(), mOccluders.end(), occluder );
+
+        if( itor == mOccluders.end() )
+        {
+            OGRE_EXCEPT( Exception::ERR_ITEM_NOT_FOUND,
+                         "Occluder not created by this OcclusionCuller",
+                         "OcclusionCuller::destroyOccluder" );
+        }
+
+        efficientVectorRemove( mOccluders, itor );
+        OGRE_DELETE_T( occluder, Occluder, MEMCATEGORY_SCENE_CONTROL );
+        mHiZValid = false;
+    }
+    //-----------------------------------------------------------------------------------
+    void OcclusionCuller::destroyAllOccluders(void)
+    {
+        OccluderVec::const_iterator itor = mOccluders.begin();
+        OccluderVec::const_iterator end  = mOccluders.end();
+
+        while( itor != end )
+        {
+            OGRE_DELETE_T( *itor, Occluder, MEMCATEGORY_SCENE_CONTROL );
+            ++itor;
+        }
+
+        mOccluders.clear();
+        mHiZValid = false;
+    }
+    //-----------------------------------------------------------------------------------
+    void OcclusionCuller::setResolution( uint32 width, uint32 height )
+    {
+        width   = std::max<uint32>( static_cast<uint32>( alignToNextMultiple( width, TileSize ) ),
+                                    TileSize );
+        height  = std::max<uint32>( static_cast<uint32>( alignToNextMultiple( height, TileSize ) ),
+                                    TileSize );
+
+        if( width == mWidth && height == mHeight )
+            return;
+
+        freeBuffers();
+
+        mWidth          = width;
+        mHeight         = height;
+        mWidthInTiles   = width / TileSize;
+        mHeightInTiles  = height / TileSize;
+
+        mDepthBuffer = reinterpret_cast<Real*>( OGRE_MALLOC_SIMD( mWidth * mHeight * sizeof(Real),
+                                                                  MEMCATEGORY_SCENE_CONTROL ) );
+        mHiZ = reinterpret_cast<Real*>( OGRE_MALLOC_SIMD( mWidthInTiles * mHeightInTiles *
+                                                          sizeof(Real),
+                                                          MEMCATEGORY_SCENE_CONTROL ) );
+        mHiZValid = false;
+    }
+    //-----------------------------------------------------------------------------------
+    void OcclusionCuller::setupTriangle( const Vector4 &clip0, const Vector4 &clip1,
+                                         const Vector4 &clip2, ScreenTriangle &outTriangle ) const
+    {
+        outTriangle.minX = 0;
+        outTriangle.maxX = 0;
+        outTriangle.minY = 0;
+        outTriangle.maxY = 0;
+
+        if( clip0.w <= c_minW || clip1.w <= c_minW || clip2.w <= c_minW )
+            return; //Crosses the camera's plane. We don't clip.
+
+        const Real width  = static_cast<Real>( mWidth );
+        const Real height = static_cast<Real>( mHeight );
+
+        Real invW[3] = { 1.0f / clip0.w, 1.0f / clip1.w, 1.0f / clip2.w };
+        Real x[3] =
+        {
+            (clip0.x * invW[0] * 0.5f + 0.5f) * width,
+            (clip1.x * invW[1] * 0.5f + 0.5f) * width,
+            (clip2.x * invW[2] * 0.5f + 0.5f) * width
+        };
+        Real y[3] =
+        {
+            (0.5f - clip0.y * invW[0] * 0.5f) * height,
+            (0.5f - clip1.y * invW[1] * 0.5f) * height,
+            (0.5f - clip2.y * invW[2] * 0.5f) * height
+        };
+
+        Real area = edgeFunction( x[0], y[0], x[1], y[1], x[2], y[2] );
+        if( !(Math::Abs( area ) > std::numeric_limits<Real>::epsilon()) )
+            return; //Degenerate (or NaN)
+
+        if( area < 0 )
+        {
+            //Occluders are double sided. Make the winding consistent.
+            std::swap( x[1], x[2] );
+            std::swap( y[1], y[2] );
+            std::swap( invW[1], invW[2] );
+            area = -area;
+        }
+
+        const Real minX = std::min( std::min( x[0], x[1] ), x[2] );
+        const Real maxX = std::max( std::max( x[0], x[1] ), x[2] );
+        const Real minY = std::min( std::min( y[0], y[1] ), y[2] );
+        const Real maxY = std::max( std::max( y[0], y[1] ), y[2] );
+
+        if( maxX <= 0 || maxY <= 0 || minX >= width || minY >= height )
+            return; //Off-screen
+
+        const Real invArea = 1.0f / area;
+        outTriangle.invWA = 0;
+        outTriangle.invWB = 0;
+        outTriangle.invWC = 0;
+        for( size_t i=0; i<3u; ++i )
+        {
+            //Edge i is the one opposite to vertex i, thus edge i / area is its barycentric.
+            const size_t a = (i + 1u) % 3u;
+            const size_t b = (i + 2u) % 3u;
+            outTriangle.edgeA[i] = y[a] - y[b];
+            outTriangle.edgeB[i] = x[b] - x[a];
+            outTriangle.edgeC[i] = x[a] * y[b] - y[a] * x[b];
+
+            const Real weight = invW[i] * invArea;
+            outTriangle.invWA += outTriangle.edgeA[i] * weight;
+            outTriangle.invWB += outTriangle.edgeB[i] * weight;
+            outTriangle.invWC += outTriangle.edgeC[i] * weight;
+        }
+
+        outTriangle.minX = std::max( static_cast<int32>( Math::Floor( minX ) ), 0 );
+        outTriangle.maxX = std::min( static_cast<int32>( Math::Ceil( maxX ) ),
+                                     static_cast<int32>( mWidth ) );
+        outTriangle.minY = std::max( static_cast<int32>( Math::Floor( minY ) ), 0 );
+        outTriangle.maxY = std::min( static_cast<int32>( Math::Ceil( maxY ) ),
+                                     static_cast<int32>( mHeight ) );
+    }
+    //-----------------------------------------------------------------------------------
+    void OcclusionCuller::transformOccluders( size_t sliceIdx, size_t numSlices )
+    {
+        const size_t numOccluders = mOccluders.size();
+        const size_t firstOccluder  = (numOccluders * sliceIdx) / numSlices;
+        const size_t endOccluder    = (numOccluders * (sliceIdx + 1u)) / numSlices;
+
+        vector<Vector4>::type clipPositions;
+
+        for( size_t i=firstOccluder; i<endOccluder; ++i )
+        {
+            const Occluder *occluder = mOccluders[i];
+
+            Matrix4 worldViewProj = mViewProjMatrix;
+            if( occluder->node )
+                worldViewProj = mViewProjMatrix * occluder->node->_getFullTransform();
+
+            clipPositions.resize( occluder->positions.size() );
+            for( size_t j=0; j<occluder->positions.size(); ++j )
+                clipPositions[j] = worldViewProj * Vector4( occluder->positions[j] );
+
+            ScreenTriangle *triangles = &mScreenTriangles[occluder->firstTriangle];
+            const size_t numTriangles = occluder->indices.size() / 3u;
+            for( size_t j=0; j<numTriangles; ++j )
+            {
+                setupTriangle( clipPositions[occluder->indices[j * 3u + 0u]],
+                               clipPositions[occluder->indices[j * 3u + 1u]],
+                               clipPositions[occluder->indices[j * 3u + 2u]],
+                               triangles[j] );
+            }
+        }
+    }
+    //-----------------------------------------------------------------------------------
+    void OcclusionCuller::rasterizeTileRow( size_t tileRow )
+    {
+        const int32 firstRow = static_cast<int32>( tileRow * TileSize );
+        const int32 endRow   = firstRow + static_cast<int32>( TileSize );
+
+        Real * RESTRICT_ALIAS rowsStart = mDepthBuffer + firstRow * mWidth;
+        memset( rowsStart, 0, TileSize * mWidth * sizeof(Real) );
+
+        //Pixel centres of each lane, relative to the first pixel of the pack.
+        ArrayReal laneCentres;
+        for( size_t i=0; i<ARRAY_PACKED_REALS; ++i )
+            Mathlib::Set( laneCentres, static_cast<Real>( i ) + 0.5f, i );
+        const ArrayVector3 packStep( Mathlib::SetAll( static_cast<Real>( ARRAY_PACKED_REALS ) ),
+                                     ARRAY_REAL_ZERO, ARRAY_REAL_ZERO );
+
+        ScreenTriangleVec::const_iterator itor = mScreenTriangles.begin();
+        ScreenTriangleVec::const_iterator end  = mScreenTriangles.end();
+
+        while( itor != end )
+        {
+            const ScreenTriangle &tri = *itor;
+
+            const int32 minY = std::max( tri.minY, firstRow );
+            const int32 maxY = std::min( tri.maxY, endRow );
+
+            if( tri.minX < tri.maxX && minY < maxY )
+            {
+                //Evaluate the planes as dot( (A, B, C), (x, y, 1) )
+                const ArrayVector3 edges[3] =
+                {
+                    ArrayVector3( Mathlib::SetAll( tri.edgeA[0] ), Mathlib::SetAll( tri.edgeB[0] ),
+                                  Mathlib::SetAll( tri.edgeC[0] ) ),
+                    ArrayVector3( Mathlib::SetAll( tri.edgeA[1] ), Mathlib::SetAll( tri.edgeB[1] ),
+                                  Mathlib::SetAll( tri.edgeC[1] ) ),
+                    ArrayVector3( Mathlib::SetAll( tri.edgeA[2] ), Mathlib::SetAll( tri.edgeB[2] ),
+                                  Mathlib::SetAll( tri.edgeC[2] ) )
+                };
+                const ArrayVector3 invWPlane( Mathlib::SetAll( tri.invWA ),
+                                              Mathlib::SetAll( tri.invWB ),
+                                              Mathlib::SetAll( tri.invWC ) );
+
+                const int32 startX = tri.minX - (tri.minX % ARRAY_PACKED_REALS);
+
+                for( int32 y=minY; y<maxY; ++y )
+                {
+                    ArrayVector3 pixel( laneCentres,
+                                        Mathlib::SetAll( static_cast<Real>( y ) + 0.5f ),
+                                        Mathlib::ONE );
+                    pixel += ArrayVector3( Mathlib::SetAll( static_cast<Real>( startX ) ),
+                                           ARRAY_REAL_ZERO, ARRAY_REAL_ZERO );
+
+                    ArrayReal * RESTRICT_ALIAS depth =
+                            reinterpret_cast<ArrayReal*>( mDepthBuffer + y * mWidth + startX );
+
+                    for( int32 x=startX; x<tri.maxX; x += ARRAY_PACKED_REALS )
+                    {
+                        ArrayMaskR inside = Mathlib::CompareGreaterEqual(
+                                                edges[0].dotProduct( pixel ), ARRAY_REAL_ZERO );
+                        inside = Mathlib::And( inside, Mathlib::CompareGreaterEqual(
+                                                   edges[1].dotProduct( pixel ), ARRAY_REAL_ZERO ) );
+                        inside = Mathlib::And( inside, Mathlib::CompareGreaterEqual(
+                                                   edges[2].dotProduct( pixel ), ARRAY_REAL_ZERO ) );
+
+                        const ArrayReal invW = invWPlane.dotProduct( pixel );
+                        *depth = Mathlib::Cmov4( Mathlib::Max( *depth, invW ), *depth, inside );
+
+                        ++depth;
+                        pixel += packStep;
+                    }
+                }
+            }
+
+            ++itor;
+        }
+
+        //Build the hierarchical-Z of this row: the farthest depth of each tile.
+        Real * RESTRICT_ALIAS hiZ = mHiZ + tileRow * mWidthInTiles;
+        for( size_t tileX=0; tileX<mWidthInTiles; ++tileX )
+        {
+            const Real *tileStart = rowsStart + tileX * TileSize;
+            ArrayReal farthest = Mathlib::SetAll( std::numeric_limits<Real>::max() );
+
+            for( size_t y=0; y<TileSize; ++y )
+            {
+                const ArrayReal *depth = reinterpret_cast<const ArrayReal*>( tileStart + y * mWidth );
+                for( size_t x=0; x<TileSize; x += ARRAY_PACKED_REALS )
+                    farthest = Mathlib::Min( farthest, *depth++ );
+            }
+
+            const Real *lanes = reinterpret_cast<const Real*>( &farthest );
+            Real tileFarthest = lanes[0];
+            for( size_t i=1; i<ARRAY_PACKED_REALS; ++i )
+                tileFarthest = std::min( tileFarthest, lanes[i] );
+
+            hiZ[tileX] = tileFarthest;
+        }
+    }
+    //-----------------------------------------------------------------------------------
+    void OcclusionCuller::rasterizeOccluders( const Camera *camera, SceneManager *sceneManager )
+    {
+        rasterizeOccluders( camera->getProjectionMatrix() * camera->getViewMatrix(), sceneManager );
+    }
+    //-----------------------------------------------------------------------------------
+    void OcclusionCuller::rasterizeOccluders( const Matrix4 &viewProjMatrix,
+                                              SceneManager *sceneManager )
+    {
+        mViewProjMatrix = viewProjMatrix;
+
+        size_t numTriangles = 0;
+        OccluderVec::const_iterator itor = mOccluders.begin();
+        OccluderVec::const_iterator end  = mOccluders.end();
+        while( itor != end )
+        {
+            (*itor)->firstTriangle = numTriangles;
+            numTriangles += (*itor)->indices.size() / 3u;
+            ++itor;
+        }
+        mScreenTriangles.resize( numTriangles );
+
+        const size_t numTransformSlices = std::max<size_t>(
+                    std::min( mOccluders.size(), c_maxTransformSlices ), 1u );
+
+        if( sceneManager )
+        {
+            mTaskGraph.clear();
+            TaskGraph::TaskId transformTaskId = mTaskGraph.addTask( &mTransformTask,
+                                                                    numTransformSlices );
+            TaskGraph::TaskId rasterTaskId = mTaskGraph.addTask( &mRasterTask, mHeightInTiles );
+            mTaskGraph.addDependency( rasterTaskId, transformTaskId );
+            sceneManager->executeTaskGraph( &mTaskGraph );
+        }
+        else
+        {
+            for( size_t i=0; i<numTransformSlices; ++i )
+                transformOccluders( i, numTransformSlices );
+            for( size_t i=0; i<mHeightInTiles; ++i )
+                rasterizeTileRow( i );
+        }
+
+        mHiZValid = true;
+    }
+    //-----------------------------------------------------------------------------------
+    bool OcclusionCuller::isOccluded( const Aabb &worldAabb ) const
+    {
+        if( !mHiZValid )
+            return false;
+
+        const Vector3 &halfSize = worldAabb.mHalfSize;
+        const Real maxReal = std::numeric_limits<Real>::max();
+        if( !(halfSize.x < maxReal && halfSize.y < maxReal && halfSize.z < maxReal) )
+            return false; //Infinite (or NaN)
+
+        const Real width  = static_cast<Real>( mWidth );
+        const Real height = static_cast<Real>( mHeight );
+
+        Real minX = maxReal, minY = maxReal;
+        Real maxX = -maxReal, maxY = -maxReal;
+        Real nearestInvW = 0;
+
+        for( size_t i=0; i<8u; ++i )
+        {
+            const Vector3 corner( worldAabb.mCenter.x + (i & 1u ? halfSize.x : -halfSize.x),
+                                  worldAabb.mCenter.y + (i & 2u ? halfSize.y : -halfSize.y),
+                                  worldAabb.mCenter.z + (i & 4u ? halfSize.z : -halfSize.z) );
+            const Vector4 clip = mViewProjMatrix * Vector4( corner );
+
+            if( clip.w <= c_minW )
+                return false; //Behind or too close to the camera
+
+            const Real invW = 1.0f / clip.w;
+            const Real x = (clip.x * invW * 0.5f + 0.5f) * width;
+            const Real y = (0.5f - clip.y * invW * 0.5f) * height;
+
+            minX = std::min( minX, x );
+            maxX = std::max( maxX, x );
+            minY = std::min( minY, y );
+            maxY = std::max( maxY, y );
+            nearestInvW = std::max( nearestInvW, invW );
+        }
+
+        if( maxX <= 0 || maxY <= 0 || minX >= width || minY >= height )
+            return false; //Off-screen. Leave that to frustum culling.
+
+        const size_t tileMinX = static_cast<size_t>( std::max( minX, Real( 0 ) ) ) / TileSize;
+        const size_t tileMinY = static_cast<size_t>( std::max( minY, Real( 0 ) ) ) / TileSize;
+        const size_t tileMaxX = std::min( static_cast<size_t>( maxX ) / TileSize,
+                                          static_cast<size_t>( mWidthInTiles - 1u ) );
+        const size_t tileMaxY = std::min( static_cast<size_t>( maxY ) / TileSize,
+                                          static_cast<size_t>( mHeightInTiles - 1u ) );
+
+        for( size_t y=tileMinY; y<=tileMaxY; ++y )
+        {
+            const Real *hiZ = mHiZ + y * mWidthInTiles;
+            for( size_t x=tileMinX; x<=tileMaxX; ++x )
+            {
+                if( hiZ[x] <= nearestInvW )
+                    return false;
+            }
+        }
+
+        return true;
+    }
+    //-----------------------------------------------------------------------------------
+    void OcclusionCuller::cullOccluded( MovableObject::MovableObjectArray &inOutObjects,
+                                        size_t firstIdx ) const
+    {
+        if( !mHiZValid )
+            return;
+
+        MovableObject::MovableObjectArray::iterator itor = inOutObjects.begin() + firstIdx;
+        MovableObject::MovableObjectArray::iterator end  = inOutObjects.end();
+        MovableObject::MovableObjectArray::iterator dst  = itor;
+
+        while( itor != end )
+        {
+            if( !isOccluded( (*itor)->getWorldAabb() ) )
+                *dst++ = *itor;
+            ++itor;
+        }
+
+        inOutObjects.resize( static_cast<size_t>( dst - inOutObjects.begin() ) );
+    }
+}
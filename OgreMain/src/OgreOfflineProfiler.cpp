@@ -10,12 +10,24 @@
 
 #include <fstream>
 
+#if OGRE_COMPILER == OGRE_COMPILER_MSVC
+    #include <intrin.h>
+    //x86 & x64 don't reorder stores with other stores nor loads with other loads,
+    //we just need to prevent the compiler from doing so.
+    #define OGRE_OFFLINE_PROFILER_FENCE() _ReadWriteBarrier()
+#else
+    #define OGRE_OFFLINE_PROFILER_FENCE() __sync_synchronize()
+#endif
+
 namespace Ogre
 {
     OfflineProfiler::OfflineProfiler() :
         mPaused( false ),
         mTlsHandle( OGRE_TLS_INVALID_HANDLE ),
-        mBytesPerPool( sizeof( ProfileSample ) * 10000 )
+        mBytesPerPool( sizeof( ProfileSample ) * 10000 ),
+        mTraceCapacity( 0 ),
+        mTraceOnly( false ),
+        mTraceTimer( OGRE_NEW Ogre::Timer() )
     {
         Threads::CreateTls( &mTlsHandle );
     }
@@ -28,6 +40,9 @@ namespace Ogre
             dumpProfileResults( mOnShutdownPerFramePath, mOnShutdownAccumPath );
         }
 
+        if( !mThreadData.empty() && !mOnShutdownTracePath.empty() )
+            exportChromeTrace( mOnShutdownTracePath );
+
         mMutex.lock();
         PerThreadDataArray::const_iterator itor = mThreadData.begin();
         PerThreadDataArray::const_iterator end  = mThreadData.end();
@@ -39,9 +54,14 @@ namespace Ogre
 
         Threads::DestroyTls( mTlsHandle );
         mTlsHandle = OGRE_TLS_INVALID_HANDLE;
+
+        OGRE_DELETE mTraceTimer;
+        mTraceTimer = 0;
     }
     //-----------------------------------------------------------------------------------
-    OfflineProfiler::PerThreadData::PerThreadData( bool startPaused, size_t bytesPerPool ) :
+    OfflineProfiler::PerThreadData::PerThreadData( bool startPaused, size_t bytesPerPool,
+                                                   size_t traceCapacity, bool traceOnly,
+                                                   uint64 traceTimeOffset ) :
         mPaused( startPaused ),
         mPauseRequest( startPaused ),
         mResetRequest( false ),
@@ -50,8 +70,19 @@ namespace Ogre
         mTimer( OGRE_NEW Ogre::Timer() ),
         mTotalAccumTime( 0 ),
         mCurrMemoryPoolOffset( 0 ),
-        mBytesPerPool( bytesPerPool )
+        mBytesPerPool( bytesPerPool ),
+        mTraceEvents( 0 ),
+        mTraceCapacity( 0 ),
+        mTraceCapacityRequest( traceCapacity ),
+        mTraceOnly( traceOnly ),
+        mTraceOnlyRequest( traceOnly ),
+        mTraceClearRequest( false ),
+        mTraceWriteCount( 0 ),
+        mTraceTimeOffset( traceTimeOffset ),
+        mFrameCount( 0 )
     {
+        mThreadName[0] = '\0';
+
         createNewPool();
         mCurrentSample = allocateSample( 0 );
         mRoot = mCurrentSample;
@@ -67,6 +98,12 @@ namespace Ogre
         destroyAllPools();
         delete mTimer;
         mTimer = 0;
+
+        if( mTraceEvents )
+        {
+            OGRE_FREE( mTraceEvents, MEMCATEGORY_GENERAL );
+            mTraceEvents = 0;
+        }
     }
     //-----------------------------------------------------------------------------------
     void OfflineProfiler::PerThreadData::destroySampleAndChildren( ProfileSample *sample )
@@ -150,6 +187,85 @@ namespace Ogre
         mResetRequest = false;
     }
     //-----------------------------------------------------------------------------------
+    void OfflineProfiler::PerThreadData::setTraceRequest( size_t traceCapacity, bool traceOnly )
+    {
+        mTraceCapacityRequest = traceCapacity;
+        mTraceOnlyRequest = traceOnly;
+    }
+    //-----------------------------------------------------------------------------------
+    void OfflineProfiler::PerThreadData::requestTraceClear(void)
+    {
+        mTraceClearRequest = true;
+    }
+    //-----------------------------------------------------------------------------------
+    void OfflineProfiler::PerThreadData::setThreadName( const char *name )
+    {
+        mMutex.lock();
+        strncpy( mThreadName, name, OGRE_OFFLINE_PROFILER_NAME_STR_LENGTH - 1u );
+        mThreadName[OGRE_OFFLINE_PROFILER_NAME_STR_LENGTH-1u] = '\0';
+        mMutex.unlock();
+    }
+    //-----------------------------------------------------------------------------------
+    void OfflineProfiler::PerThreadData::applyTraceRequests(void)
+    {
+        //Reallocating and clearing are rare, so we lock to keep getTraceEvents simple
+        if( mTraceCapacity != mTraceCapacityRequest )
+        {
+            mMutex.lock();
+            if( mTraceEvents )
+            {
+                OGRE_FREE( mTraceEvents, MEMCATEGORY_GENERAL );
+                mTraceEvents = 0;
+            }
+
+            mTraceCapacity = mTraceCapacityRequest;
+            if( mTraceCapacity )
+            {
+                mTraceEvents = reinterpret_cast<TraceEvent*>(
+                                   OGRE_MALLOC( sizeof( TraceEvent ) * mTraceCapacity,
+                                                MEMCATEGORY_GENERAL ) );
+            }
+            mTraceWriteCount = 0;
+            mMutex.unlock();
+        }
+
+        if( mTraceClearRequest )
+        {
+            mMutex.lock();
+            mTraceWriteCount = 0;
+            mTraceClearRequest = false;
+            mMutex.unlock();
+        }
+
+        //Can't switch modes in the middle of a sample, or profileEnd won't match its profileBegin
+        if( mTraceOnly != mTraceOnlyRequest && mCurrentSample == mRoot )
+            mTraceOnly = mTraceOnlyRequest;
+    }
+    //-----------------------------------------------------------------------------------
+    void OfflineProfiler::PerThreadData::pushTraceEvent( TraceEventType type,
+                                                         const char *name, double value )
+    {
+        const size_t writeCount = mTraceWriteCount;
+
+        TraceEvent &traceEvent = mTraceEvents[writeCount % mTraceCapacity];
+        traceEvent.usTimestamp  = mTimer->getMicroseconds() + mTraceTimeOffset;
+        traceEvent.value        = value;
+        traceEvent.type         = static_cast<uint8>( type );
+        if( name )
+        {
+            strncpy( (char*)traceEvent.nameStr, name, OGRE_OFFLINE_PROFILER_NAME_STR_LENGTH - 1u );
+            traceEvent.nameStr[OGRE_OFFLINE_PROFILER_NAME_STR_LENGTH-1u] = '\0';
+        }
+        else
+        {
+            traceEvent.nameStr[0] = '\0';
+        }
+
+        //Publish the event only after it's been fully written. See getTraceEvents
+        OGRE_OFFLINE_PROFILER_FENCE();
+        mTraceWriteCount = writeCount + 1u;
+    }
+    //-----------------------------------------------------------------------------------
     void OfflineProfiler::PerThreadData::profileBegin( const char *name,
                                                        ProfileSampleFlags::ProfileSampleFlags flags )
     {
@@ -159,9 +275,17 @@ namespace Ogre
         if( mResetRequest )
             reset();
 
+        applyTraceRequests();
+
         if( mPaused )
             return;
 
+        if( mTraceCapacity )
+            pushTraceEvent( TraceEventBegin, name, 0 );
+
+        if( mTraceOnly )
+            return;
+
         mMutex.lock();
         IdString nameHash( name );
 
@@ -194,6 +318,12 @@ namespace Ogre
         if( mPaused )
             return;
 
+        if( mTraceCapacity )
+            pushTraceEvent( TraceEventEnd, 0, 0 );
+
+        if( mTraceOnly )
+            return;
+
         //Measure before the lock! Other threads will not be using our mTimer anyway
         const uint64 usEnd = mTimer->getMicroseconds();
 
@@ -210,11 +340,70 @@ namespace Ogre
         mMutex.unlock();
     }
     //-----------------------------------------------------------------------------------
-    OfflineProfiler::PerThreadData* OfflineProfiler::allocatePerThreadData(void)
+    void OfflineProfiler::PerThreadData::profileFrameMark(void)
+    {
+        applyTraceRequests();
+
+        if( !mPaused && mTraceCapacity )
+            pushTraceEvent( TraceEventFrameMark, "Frame", static_cast<double>( mFrameCount ) );
+
+        ++mFrameCount;
+    }
+    //-----------------------------------------------------------------------------------
+    void OfflineProfiler::PerThreadData::profileCounter( const char *name, double value )
     {
-        PerThreadData *perThreadData = new PerThreadData( mPaused, mBytesPerPool );
+        applyTraceRequests();
+
+        if( !mPaused && mTraceCapacity )
+            pushTraceEvent( TraceEventCounter, name, value );
+    }
+    //-----------------------------------------------------------------------------------
+    void OfflineProfiler::PerThreadData::getTraceEvents( TraceEventVec &outEvents,
+                                                         String &outThreadName )
+    {
+        //The lock prevents mTraceEvents from being reallocated or cleared, but the
+        //owner thread may still be pushing (and overwriting) events while we copy
+        mMutex.lock();
+        outThreadName = mThreadName;
+
+        if( mTraceCapacity )
+        {
+            const size_t writeCountBefore = mTraceWriteCount;
+            OGRE_OFFLINE_PROFILER_FENCE();
+
+            const size_t firstIdx = writeCountBefore > mTraceCapacity ?
+                                        writeCountBefore - mTraceCapacity : 0u;
+            const size_t prevSize = outEvents.size();
+            outEvents.reserve( prevSize + writeCountBefore - firstIdx );
+            for( size_t i=firstIdx; i<writeCountBefore; ++i )
+                outEvents.push_back( mTraceEvents[i % mTraceCapacity] );
+
+            OGRE_OFFLINE_PROFILER_FENCE();
+            const size_t writeCountAfter = mTraceWriteCount;
+
+            //The owner thread may be writing into the slot of event writeCountAfter,
+            //which was holding event (writeCountAfter - mTraceCapacity). Every event
+            //older than that one may have been overwritten while we were copying.
+            const size_t firstValidIdx = writeCountAfter + 1u > mTraceCapacity ?
+                                             writeCountAfter + 1u - mTraceCapacity : 0u;
+            if( firstValidIdx > firstIdx )
+            {
+                const size_t numInvalid = std::min( firstValidIdx - firstIdx,
+                                                    writeCountBefore - firstIdx );
+                outEvents.erase( outEvents.begin() + prevSize,
+                                 outEvents.begin() + prevSize + numInvalid );
+            }
+        }
 
+        mMutex.unlock();
+    }
+    //-----------------------------------------------------------------------------------
+    OfflineProfiler::PerThreadData* OfflineProfiler::allocatePerThreadData(void)
+    {
         mMutex.lock();
+        PerThreadData *perThreadData = new PerThreadData( mPaused, mBytesPerPool,
+                                                          mTraceCapacity, mTraceOnly,
+                                                          mTraceTimer->getMicroseconds() );
         mThreadData.push_back( perThreadData );
         mMutex.unlock();
 
@@ -223,6 +412,16 @@ namespace Ogre
         return perThreadData;
     }
     //-----------------------------------------------------------------------------------
+    OfflineProfiler::PerThreadData* OfflineProfiler::getPerThreadData(void)
+    {
+        PerThreadData *perThreadData = reinterpret_cast<PerThreadData*>( Threads::GetTls( mTlsHandle ) );
+
+        if( !perThreadData )
+            perThreadData = allocatePerThreadData();
+
+        return perThreadData;
+    }
+    //-----------------------------------------------------------------------------------
     void OfflineProfiler::
     PerThreadData::dumpSample( ProfileSample *sample, LwString &tmpStr, String &outCsvString,
                                StdMap<IdString, ProfileSample> &accumStats, uint32 stackDepth )
@@ -377,11 +576,7 @@ namespace Ogre
     //-----------------------------------------------------------------------------------
     void OfflineProfiler::profileBegin( const char *name, ProfileSampleFlags::ProfileSampleFlags flags )
     {
-        PerThreadData *perThreadData = reinterpret_cast<PerThreadData*>( Threads::GetTls( mTlsHandle ) );
-
-        if( !perThreadData )
-            perThreadData = allocatePerThreadData();
-
+        PerThreadData *perThreadData = getPerThreadData();
         perThreadData->profileBegin( name, flags );
     }
     //-----------------------------------------------------------------------------------
@@ -394,6 +589,183 @@ namespace Ogre
         perThreadData->profileEnd();
     }
     //-----------------------------------------------------------------------------------
+    void OfflineProfiler::setTracing( size_t maxEventsPerThread, bool bTraceOnly )
+    {
+        mMutex.lock();
+
+        mTraceCapacity = maxEventsPerThread;
+        mTraceOnly = bTraceOnly;
+
+        PerThreadDataArray::const_iterator itor = mThreadData.begin();
+        PerThreadDataArray::const_iterator end  = mThreadData.end();
+
+        while( itor != end )
+        {
+            (*itor)->setTraceRequest( maxEventsPerThread, bTraceOnly );
+            ++itor;
+        }
+
+        mMutex.unlock();
+    }
+    //-----------------------------------------------------------------------------------
+    void OfflineProfiler::clearTraces(void)
+    {
+        mMutex.lock();
+
+        PerThreadDataArray::const_iterator itor = mThreadData.begin();
+        PerThreadDataArray::const_iterator end  = mThreadData.end();
+
+        while( itor != end )
+        {
+            (*itor)->requestTraceClear();
+            ++itor;
+        }
+
+        mMutex.unlock();
+    }
+    //-----------------------------------------------------------------------------------
+    void OfflineProfiler::setThreadName( const char *name )
+    {
+        PerThreadData *perThreadData = getPerThreadData();
+        perThreadData->setThreadName( name );
+    }
+    //-----------------------------------------------------------------------------------
+    void OfflineProfiler::profileFrameMark(void)
+    {
+        PerThreadData *perThreadData = getPerThreadData();
+        perThreadData->profileFrameMark();
+    }
+    //-----------------------------------------------------------------------------------
+    void OfflineProfiler::profileCounter( const char *name, double value )
+    {
+        PerThreadData *perThreadData = getPerThreadData();
+        perThreadData->profileCounter( name, value );
+    }
+    //-----------------------------------------------------------------------------------
+    void OfflineProfiler::appendJsonString( String &outJson, const char *str )
+    {
+        outJson.push_back( '"' );
+        while( *str )
+        {
+            const char c = *str++;
+            if( c == '"' || c == '\\' )
+            {
+                outJson.push_back( '\\' );
+                outJson.push_back( c );
+            }
+            else if( static_cast<unsigned char>( c ) < 0x20u )
+            {
+                outJson.push_back( ' ' );
+            }
+            else
+            {
+                outJson.push_back( c );
+            }
+        }
+        outJson.push_back( '"' );
+    }
+    //-----------------------------------------------------------------------------------
+    void OfflineProfiler::exportChromeTrace( const String &fullPath )
+    {
+        String jsonString;
+        jsonString += "{\"traceEvents\":[";
+
+        char tmpBuffer[128];
+        LwString tmpStr( LwString::FromEmptyPointer( tmpBuffer, sizeof( tmpBuffer ) ) );
+
+        bool firstEvent = true;
+        TraceEventVec traceEvents;
+        String threadName;
+
+        mMutex.lock();
+
+        for( size_t i=0; i<mThreadData.size(); ++i )
+        {
+            traceEvents.clear();
+            mThreadData[i]->getTraceEvents( traceEvents, threadName );
+
+            const uint32 tid = static_cast<uint32>( i );
+
+            if( !threadName.empty() )
+            {
+                tmpStr.clear();
+                tmpStr.a( firstEvent ? "\n" : ",\n",
+                          "{\"ph\":\"M\",\"pid\":0,\"tid\":", tid,
+                          ",\"name\":\"thread_name\",\"args\":{\"name\":" );
+                jsonString += tmpStr.c_str();
+                appendJsonString( jsonString, threadName.c_str() );
+                jsonString += "}}";
+                firstEvent = false;
+            }
+
+            //The oldest events may have been lost to the ring buffer, so
+            //skip End events which don't have a matching Begin
+            size_t stackDepth = 0;
+
+            TraceEventVec::const_iterator itor = traceEvents.begin();
+            TraceEventVec::const_iterator end  = traceEvents.end();
+
+            while( itor != end )
+            {
+                const TraceEvent &traceEvent = *itor;
+
+                tmpStr.clear();
+                tmpStr.a( firstEvent ? "\n" : ",\n" );
+                tmpStr.a( "{\"pid\":0,\"tid\":", tid, ",\"ts\":", traceEvent.usTimestamp );
+
+                switch( traceEvent.type )
+                {
+                case TraceEventBegin:
+                    ++stackDepth;
+                    tmpStr.a( ",\"ph\":\"B\",\"name\":" );
+                    jsonString += tmpStr.c_str();
+                    appendJsonString( jsonString, (const char*)traceEvent.nameStr );
+                    jsonString += "}";
+                    firstEvent = false;
+                    break;
+                case TraceEventEnd:
+                    if( stackDepth > 0u )
+                    {
+                        --stackDepth;
+                        tmpStr.a( ",\"ph\":\"E\"}" );
+                        jsonString += tmpStr.c_str();
+                        firstEvent = false;
+                    }
+                    break;
+                case TraceEventCounter:
+                    tmpStr.a( ",\"ph\":\"C\",\"name\":" );
+                    jsonString += tmpStr.c_str();
+                    appendJsonString( jsonString, (const char*)traceEvent.nameStr );
+                    tmpStr.clear();
+                    tmpStr.a( ",\"args\":{\"value\":", traceEvent.value, "}}" );
+                    jsonString += tmpStr.c_str();
+                    firstEvent = false;
+                    break;
+                case TraceEventFrameMark:
+                    tmpStr.a( ",\"ph\":\"i\",\"s\":\"g\",\"name\":" );
+                    jsonString += tmpStr.c_str();
+                    appendJsonString( jsonString, (const char*)traceEvent.nameStr );
+                    tmpStr.clear();
+                    tmpStr.a( ",\"args\":{\"frame\":",
+                              static_cast<uint64>( traceEvent.value ), "}}" );
+                    jsonString += tmpStr.c_str();
+                    firstEvent = false;
+                    break;
+                }
+
+                ++itor;
+            }
+        }
+
+        mMutex.unlock();
+
+        jsonString += "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+        std::ofstream outFile( fullPath.c_str(), std::ios::binary | std::ios::out );
+        outFile.write( jsonString.c_str(), jsonString.size() );
+        outFile.close();
+    }
+    //-----------------------------------------------------------------------------------
     void OfflineProfiler::dumpProfileResults( const String &fullPathPerFrame,
                                               const String &fullPathAccum )
     {
@@ -437,4 +809,15 @@ namespace Ogre
                                                    fullPathPerFrame + " and " + fullPathAccum );
         }
     }
+    //-----------------------------------------------------------------------------------
+    void OfflineProfiler::setTracePathOnShutdown( const String &fullPath )
+    {
+        mOnShutdownTracePath = fullPath;
+
+        if( !fullPath.empty() )
+        {
+            LogManager::getSingleton().logMessage( "[INFO] Will export profiling trace on shutdown to " +
+                                                   fullPath );
+        }
+    }
 }
@@ -0,0 +1,974 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+
+#include "OgrePackArchive.h"
+#include "OgreLogManager.h"
+#include "OgreException.h"
+#include "OgreString.h"
+#include "OgreStringVector.h"
+#include "OgreStringConverter.h"
+
+#include "Hash/MurmurHash3.h"
+#include "ogrestd/set.h"
+
+#include <fstream>
+
+#include <sys/stat.h>
+
+#if OGRE_PLATFORM == OGRE_PLATFORM_LINUX || \
+    OGRE_PLATFORM == OGRE_PLATFORM_APPLE || \
+    OGRE_PLATFORM == OGRE_PLATFORM_APPLE_IOS || \
+    OGRE_PLATFORM == OGRE_PLATFORM_ANDROID || \
+    OGRE_PLATFORM == OGRE_PLATFORM_FREEBSD
+#   include <sys/mman.h>
+#   include <fcntl.h>
+#   include <unistd.h>
+#   define OGRE_PACK_MMAP_POSIX 1
+#endif
+
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+#  define WIN32_LEAN_AND_MEAN
+#  if !defined(NOMINMAX) && defined(_MSC_VER)
+#   define NOMINMAX // required to stop windows.h messing up std::min
+#  endif
+#  include <windows.h>
+#endif
+
+namespace Ogre {
+
+    /// The whole pack file, memory mapped. Unmapped when the last reference goes away.
+    struct PackFileMapping : public ArchiveAlloc
+    {
+        void    *data;
+        size_t  size;
+
+        PackFileMapping() : data( 0 ), size( 0 ) {}
+        ~PackFileMapping()
+        {
+            if( data )
+            {
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+                UnmapViewOfFile( data );
+#elif defined( OGRE_PACK_MMAP_POSIX )
+                munmap( data, size );
+#endif
+                data = 0;
+            }
+        }
+
+        /// Returns null if the file couldn't be mapped.
+        static PackFileMapping* map( const String &filename )
+        {
+            void *mappedData = 0;
+            size_t fileSize = 0;
+
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+            HANDLE hFile = CreateFileA( filename.c_str(), GENERIC_READ, FILE_SHARE_READ, 0,
+                                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0 );
+            if( hFile != INVALID_HANDLE_VALUE )
+            {
+                LARGE_INTEGER size;
+                if( GetFileSizeEx( hFile, &size ) && size.QuadPart > 0 )
+                {
+                    HANDLE hMapping = CreateFileMappingA( hFile, 0, PAGE_READONLY, 0, 0, 0 );
+                    if( hMapping )
+                    {
+                        mappedData = MapViewOfFile( hMapping, FILE_MAP_READ, 0, 0, 0 );
+                        fileSize = static_cast<size_t>( size.QuadPart );
+                        // The view keeps the mapping alive
+                        CloseHandle( hMapping );
+                    }
+                }
+                CloseHandle( hFile );
+            }
+#elif defined( OGRE_PACK_MMAP_POSIX )
+            int fd = ::open( filename.c_str(), O_RDONLY );
+            if( fd >= 0 )
+            {
+                struct stat tagStat;
+                if( fstat( fd, &tagStat ) == 0 && tagStat.st_size > 0 )
+                {
+                    fileSize = static_cast<size_t>( tagStat.st_size );
+                    mappedData = mmap( 0, fileSize, PROT_READ, MAP_PRIVATE, fd, 0 );
+                    if( mappedData == MAP_FAILED )
+                        mappedData = 0;
+                }
+                // The mapping keeps the file alive
+                ::close( fd );
+            }
+#endif
+
+            if( !mappedData )
+                return 0;
+
+            PackFileMapping *retVal = OGRE_NEW PackFileMapping();
+            retVal->data = mappedData;
+            retVal->size = fileSize;
+            return retVal;
+        }
+    };
+
+    /// Read-only view of an uncompressed entry, straight from the mapping.
+    class PackMappedDataStream : public MemoryDataStream
+    {
+        PackFileMappingPtr mMapping;
+
+    public:
+        PackMappedDataStream( const String &name, const uint8 *data, size_t size,
+                              const PackFileMappingPtr &mapping ) :
+            MemoryDataStream( name, const_cast<uint8*>( data ), size, false, true ),
+            mMapping( mapping )
+        {
+        }
+
+        virtual void close(void)
+        {
+            MemoryDataStream::close();
+            mMapping.setNull();
+        }
+    };
+
+    //-----------------------------------------------------------------------
+    static inline uint32 readUint32( const uint8 *src )
+    {
+        uint32 retVal;
+        memcpy( &retVal, src, sizeof(uint32) );
+        return retVal;
+    }
+    //-----------------------------------------------------------------------
+    static bool equalsCaseless( const char *a, const char *b, size_t length )
+    {
+        for( size_t i=0; i<length; ++i )
+        {
+            if( tolower( static_cast<unsigned char>( a[i] ) ) !=
+                tolower( static_cast<unsigned char>( b[i] ) ) )
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    //-----------------------------------------------------------------------
+    //-----------------------------------------------------------------------
+    //-----------------------------------------------------------------------
+    PackArchive::PackArchive( const String& name, const String& archType ) :
+        Archive( name, archType ),
+        mEntries( 0 ),
+        mBuckets( 0 ),
+        mNames( 0 ),
+        mNumEntries( 0 ),
+        mNumBuckets( 0 )
+    {
+    }
+    //-----------------------------------------------------------------------
+    PackArchive::~PackArchive()
+    {
+        unload();
+    }
+    //-----------------------------------------------------------------------
+    void PackArchive::load()
+    {
+        OGRE_LOCK_AUTO_MUTEX;
+
+        if( mEntries )
+            return;
+
+        const uint8 *fileData = 0;
+        uint64 fileSize = 0;
+        Header header;
+        memset( &header, 0, sizeof(Header) );
+        const uint8 *tocData = 0;
+
+        mMapping = PackFileMappingPtr( PackFileMapping::map( mName ) );
+
+        if( !mMapping.isNull() )
+        {
+            fileData = reinterpret_cast<const uint8*>( mMapping->data );
+            fileSize = mMapping->size;
+            if( fileSize >= sizeof(Header) )
+                memcpy( &header, fileData + fileSize - sizeof(Header), sizeof(Header) );
+        }
+        else
+        {
+            std::ifstream file( mName.c_str(), std::ios::in | std::ios::binary );
+            if( !file.is_open() )
+            {
+                OGRE_EXCEPT( Exception::ERR_FILE_NOT_FOUND,
+                             "Cannot open pack file: " + mName,
+                             "PackArchive::load" );
+            }
+
+            file.seekg( 0, std::ios::end );
+            fileSize = static_cast<uint64>( file.tellg() );
+            if( fileSize >= sizeof(Header) )
+            {
+                file.seekg( static_cast<std::streamoff>( fileSize - sizeof(Header) ) );
+                file.read( reinterpret_cast<char*>( &header ), sizeof(Header) );
+
+                if( file.good() && header.magic == Magic && header.version == Version &&
+                    header.tocOffset <= fileSize && header.tocSize <= fileSize - header.tocOffset )
+                {
+                    mTocData.resize( static_cast<size_t>( header.tocSize ) );
+                    file.seekg( static_cast<std::streamoff>( header.tocOffset ) );
+                    if( !mTocData.empty() )
+                        file.read( reinterpret_cast<char*>( &mTocData[0] ), mTocData.size() );
+                    if( !file.good() )
+                        mTocData.clear();
+                    tocData = mTocData.empty() ? 0 : &mTocData[0];
+                }
+            }
+        }
+
+        if( fileSize < sizeof(Header) || header.magic != Magic || header.version != Version ||
+            header.tocOffset > fileSize - sizeof(Header) ||
+            header.tocSize > fileSize - sizeof(Header) - header.tocOffset ||
+            (header.tocOffset % 8u) != 0 ||
+            header.numBuckets == 0 || (header.numBuckets & (header.numBuckets - 1u)) != 0 ||
+            header.numBuckets <= header.numEntries ||
+            header.tocSize < header.numEntries * (uint64)sizeof(Entry) +
+                             header.numBuckets * (uint64)sizeof(uint32) ||
+            (mMapping.isNull() && !tocData) )
+        {
+            mMapping.setNull();
+            mTocData.clear();
+            OGRE_EXCEPT( Exception::ERR_INVALIDPARAMS,
+                         mName + " is not a valid pack file (or was written by a different version)",
+                         "PackArchive::load" );
+        }
+
+        if( !mMapping.isNull() )
+            tocData = fileData + header.tocOffset;
+
+        const size_t namesOffset = header.numEntries * sizeof(Entry) +
+                                   header.numBuckets * sizeof(uint32);
+        const uint64 namesSize = header.tocSize - namesOffset;
+
+        mEntries    = reinterpret_cast<const Entry*>( tocData );
+        mBuckets    = reinterpret_cast<const uint32*>( tocData + header.numEntries * sizeof(Entry) );
+        mNames      = reinterpret_cast<const char*>( tocData + namesOffset );
+        mNumEntries = header.numEntries;
+        mNumBuckets = header.numBuckets;
+
+        mFileList.reserve( mNumEntries );
+
+        set<String>::type directories;
+
+        for( uint32 i=0; i<mNumEntries; ++i )
+        {
+            const Entry &entry = mEntries[i];
+
+            if( entry.offset > header.tocOffset || entry.size > header.tocOffset - entry.offset ||
+                (uint64)entry.nameOffset + entry.nameLength > namesSize ||
+                entry.compression > CompressionLz4 ||
+                (entry.compression == CompressionNone && entry.size != entry.uncompressedSize) )
+            {
+                mEntries = 0;
+                mBuckets = 0;
+                mNames = 0;
+                mNumEntries = 0;
+                mNumBuckets = 0;
+                mFileList.clear();
+                mMapping.setNull();
+                mTocData.clear();
+                OGRE_EXCEPT( Exception::ERR_INVALIDPARAMS,
+                             mName + " is corrupt: entry #" + StringConverter::toString( i ) +
+                             " is out of bounds",
+                             "PackArchive::load" );
+            }
+
+            FileInfo info;
+            info.archive = this;
+            info.filename.assign( mNames + entry.nameOffset, entry.nameLength );
+            StringUtil::splitFilename( info.filename, info.basename, info.path );
+            info.compressedSize     = static_cast<size_t>( entry.size );
+            info.uncompressedSize   = static_cast<size_t>( entry.uncompressedSize );
+            mFileList.push_back( info );
+
+            // Register every parent folder, so they can be listed too
+            String path = info.path;
+            while( !path.empty() && directories.insert( path ).second )
+            {
+                path.erase( path.size() - 1u );
+                const size_t lastSlash = path.find_last_of( '/' );
+                path.erase( lastSlash == String::npos ? 0 : lastSlash + 1u );
+            }
+        }
+
+        set<String>::type::const_iterator itor = directories.begin();
+        set<String>::type::const_iterator end  = directories.end();
+        while( itor != end )
+        {
+            FileInfo info;
+            info.archive = this;
+            info.filename = itor->substr( 0, itor->size() - 1u );
+            StringUtil::splitFilename( info.filename, info.basename, info.path );
+            // Same as ZipArchive: folders get a compressed size of -1
+            info.compressedSize     = size_t( -1 );
+            info.uncompressedSize   = 0;
+            mFileList.push_back( info );
+            ++itor;
+        }
+    }
+    //-----------------------------------------------------------------------
+    void PackArchive::unload()
+    {
+        OGRE_LOCK_AUTO_MUTEX;
+        mEntries = 0;
+        mBuckets = 0;
+        mNames = 0;
+        mNumEntries = 0;
+        mNumBuckets = 0;
+        mFileList.clear();
+        // Streams still open keep their own reference to the mapping
+        mMapping.setNull();
+        mTocData.clear();
+    }
+    //-----------------------------------------------------------------------
+    uint32 PackArchive::hashName( const String &filename )
+    {
+        String lowercaseName = filename;
+        StringUtil::toLowerCase( lowercaseName );
+        uint32 retVal;
+        MurmurHash3_x86_32( lowercaseName.c_str(), static_cast<int>( lowercaseName.size() ),
+                            HashSeed, &retVal );
+        return retVal;
+    }
+    //-----------------------------------------------------------------------
+    size_t PackArchive::findEntry( const String &filename ) const
+    {
+        if( !mNumEntries )
+            return (size_t)-1;
+
+        const uint32 hash = hashName( filename );
+        const uint32 mask = mNumBuckets - 1u;
+
+        uint32 bucketIdx = hash & mask;
+        for( uint32 i=0; i<mNumBuckets; ++i )
+        {
+            const uint32 entryIdx = mBuckets[bucketIdx];
+            if( !entryIdx || entryIdx > mNumEntries )
+                return (size_t)-1;
+
+            const Entry &entry = mEntries[entryIdx - 1u];
+            if( entry.nameHash == hash && entry.nameLength == filename.size() &&
+                equalsCaseless( mNames + entry.nameOffset, filename.c_str(), filename.size() ) )
+            {
+                return entryIdx - 1u;
+            }
+
+            bucketIdx = (bucketIdx + 1u) & mask;
+        }
+
+        return (size_t)-1;
+    }
+    //-----------------------------------------------------------------------
+    DataStreamPtr PackArchive::readEntry( const Entry &entry, const String &filename ) const
+    {
+        const size_t storedSize = static_cast<size_t>( entry.size );
+        const size_t uncompressedSize = static_cast<size_t>( entry.uncompressedSize );
+
+        const uint8 *storedData = 0;
+        vector<uint8>::type tmpBuffer;
+
+        if( !mMapping.isNull() )
+        {
+            storedData = reinterpret_cast<const uint8*>( mMapping->data ) + entry.offset;
+
+            // Zero-copy
+            if( entry.compression == CompressionNone )
+            {
+                return DataStreamPtr( OGRE_NEW PackMappedDataStream( filename, storedData,
+                                                                     storedSize, mMapping ) );
+            }
+        }
+        else
+        {
+            std::ifstream file( mName.c_str(), std::ios::in | std::ios::binary );
+            file.seekg( static_cast<std::streamoff>( entry.offset ) );
+
+            if( entry.compression == CompressionNone )
+            {
+                MemoryDataStream *stream = OGRE_NEW MemoryDataStream( filename, storedSize,
+                                                                      true, true );
+                if( storedSize )
+                    file.read( reinterpret_cast<char*>( stream->getPtr() ), storedSize );
+                if( !file.good() )
+                {
+                    OGRE_DELETE stream;
+                    OGRE_EXCEPT( Exception::ERR_INTERNAL_ERROR,
+                                 "Could not read " + filename + " from " + mName,
+                                 "PackArchive::readEntry" );
+                }
+                return DataStreamPtr( stream );
+            }
+
+            tmpBuffer.resize( storedSize );
+            if( storedSize )
+                file.read( reinterpret_cast<char*>( &tmpBuffer[0] ), storedSize );
+            if( !file.good() )
+            {
+                OGRE_EXCEPT( Exception::ERR_INTERNAL_ERROR,
+                             "Could not read " + filename + " from " + mName,
+                             "PackArchive::readEntry" );
+            }
+            storedData = tmpBuffer.empty() ? 0 : &tmpBuffer[0];
+        }
+
+        MemoryDataStream *stream = OGRE_NEW MemoryDataStream( filename, uncompressedSize, true, true );
+        if( !decompressLz4( storedData, storedSize, stream->getPtr(), uncompressedSize ) )
+        {
+            OGRE_DELETE stream;
+            OGRE_EXCEPT( Exception::ERR_INTERNAL_ERROR,
+                         "Compressed data of " + filename + " in " + mName + " is corrupt",
+                         "PackArchive::readEntry" );
+        }
+
+        return DataStreamPtr( stream );
+    }
+    //-----------------------------------------------------------------------
+    DataStreamPtr PackArchive::open(const String& filename, bool readOnly)
+    {
+        const size_t entryIdx = findEntry( filename );
+        if( entryIdx == (size_t)-1 )
+        {
+            LogManager::getSingleton().logMessage(
+                mName + " - Unable to open file " + filename + ", file not found", LML_CRITICAL );
+            return DataStreamPtr();
+        }
+
+        return readEntry( mEntries[entryIdx], filename );
+    }
+    //-----------------------------------------------------------------------
+    DataStreamPtr PackArchive::openMapped(const String& filename)
+    {
+        // open already returns MemoryDataStreams, mapped when possible
+        return open( filename, true );
+    }
+    //-----------------------------------------------------------------------
+    DataStreamPtr PackArchive::create(const String& filename)
+    {
+        OGRE_EXCEPT( Exception::ERR_NOT_IMPLEMENTED,
+                     "Modification of pack archives is not supported. Use PackArchiveWriter",
+                     "PackArchive::create" );
+    }
+    //-----------------------------------------------------------------------
+    void PackArchive::remove(const String& filename)
+    {
+        OGRE_EXCEPT( Exception::ERR_NOT_IMPLEMENTED,
+                     "Modification of pack archives is not supported. Use PackArchiveWriter",
+                     "PackArchive::remove" );
+    }
+    //-----------------------------------------------------------------------
+    StringVectorPtr PackArchive::list(bool recursive, bool dirs)
+    {
+        OGRE_LOCK_AUTO_MUTEX;
+        StringVectorPtr ret = StringVectorPtr(OGRE_NEW_T(StringVector, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
+
+        FileInfoList::const_iterator i, iend;
+        iend = mFileList.end();
+        for (i = mFileList.begin(); i != iend; ++i)
+            if ((dirs == (i->compressedSize == size_t (-1))) &&
+                (recursive || i->path.empty()))
+                ret->push_back(i->filename);
+
+        return ret;
+    }
+    //-----------------------------------------------------------------------
+    FileInfoListPtr PackArchive::listFileInfo(bool recursive, bool dirs)
+    {
+        OGRE_LOCK_AUTO_MUTEX;
+        FileInfoList* fil = OGRE_NEW_T(FileInfoList, MEMCATEGORY_GENERAL)();
+        FileInfoList::const_iterator i, iend;
+        iend = mFileList.end();
+        for (i = mFileList.begin(); i != iend; ++i)
+            if ((dirs == (i->compressedSize == size_t (-1))) &&
+                (recursive || i->path.empty()))
+                fil->push_back(*i);
+
+        return FileInfoListPtr(fil, SPFM_DELETE_T);
+    }
+    //-----------------------------------------------------------------------
+    StringVectorPtr PackArchive::find(const String& pattern, bool recursive, bool dirs)
+    {
+        OGRE_LOCK_AUTO_MUTEX;
+        StringVectorPtr ret = StringVectorPtr(OGRE_NEW_T(StringVector, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
+        // If pattern contains a directory name, do a full match
+        bool full_match = (pattern.find ('/') != String::npos) ||
+                          (pattern.find ('\\') != String::npos);
+        bool wildCard = pattern.find("*") != String::npos;
+
+        // No wildcards: it's a name lookup
+        if( full_match && !wildCard && !dirs )
+        {
+            const size_t entryIdx = findEntry( pattern );
+            if( entryIdx != (size_t)-1 )
+                ret->push_back( mFileList[entryIdx].filename );
+            return ret;
+        }
+
+        FileInfoList::const_iterator i, iend;
+        iend = mFileList.end();
+        for (i = mFileList.begin(); i != iend; ++i)
+            if ((dirs == (i->compressedSize == size_t (-1))) &&
+                (recursive || full_match || wildCard))
+                // Check basename matches pattern (pack is case insensitive)
+                if (StringUtil::match(full_match ? i->filename : i->basename, pattern, false))
+                    ret->push_back(i->filename);
+
+        return ret;
+    }
+    //-----------------------------------------------------------------------
+    FileInfoListPtr PackArchive::findFileInfo(const String& pattern,
+        bool recursive, bool dirs)
+    {
+        OGRE_LOCK_AUTO_MUTEX;
+        FileInfoListPtr ret = FileInfoListPtr(OGRE_NEW_T(FileInfoList, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
+        // If pattern contains a directory name, do a full match
+        bool full_match = (pattern.find ('/') != String::npos) ||
+                          (pattern.find ('\\') != String::npos);
+        bool wildCard = pattern.find("*") != String::npos;
+
+        // No wildcards: it's a name lookup
+        if( full_match && !wildCard && !dirs )
+        {
+            const size_t entryIdx = findEntry( pattern );
+            if( entryIdx != (size_t)-1 )
+                ret->push_back( mFileList[entryIdx] );
+            return ret;
+        }
+
+        FileInfoList::const_iterator i, iend;
+        iend = mFileList.end();
+        for (i = mFileList.begin(); i != iend; ++i)
+            if ((dirs == (i->compressedSize == size_t (-1))) &&
+                (recursive || full_match || wildCard))
+                // Check name matches pattern (pack is case insensitive)
+                if (StringUtil::match(full_match ? i->filename : i->basename, pattern, false))
+                    ret->push_back(*i);
+
+        return ret;
+    }
+    //-----------------------------------------------------------------------
+    bool PackArchive::exists(const String& filename)
+    {
+        return findEntry( filename ) != (size_t)-1;
+    }
+    //---------------------------------------------------------------------
+    time_t PackArchive::getModifiedTime(const String& filename)
+    {
+        const size_t entryIdx = findEntry( filename );
+        if( entryIdx != (size_t)-1 && mEntries[entryIdx].modifiedTime != 0 )
+            return static_cast<time_t>( mEntries[entryIdx].modifiedTime );
+
+        // Not recorded, use the mod time of the pack itself
+        struct stat tagStat;
+        bool ret = (stat(mName.c_str(), &tagStat) == 0);
+
+        if (ret)
+        {
+            return tagStat.st_mtime;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    //-----------------------------------------------------------------------
+    size_t PackArchive::compressLz4( const uint8 *src, size_t srcSize, uint8 *dst, size_t dstCapacity )
+    {
+        // Greedy LZ4 block compressor. Favours speed over ratio; the format
+        // rules are: the last 5 bytes are always literals, and the last match
+        // must start at least 12 bytes before the end.
+        const size_t MinMatch       = 4u;
+        const size_t LastLiterals   = 5u;
+        const size_t MfLimit        = 12u;
+        const size_t HashLog        = 12u;
+
+        int32 hashTable[1u << HashLog];
+        for( size_t i=0; i<(1u << HashLog); ++i )
+            hashTable[i] = -1;
+
+        uint8 *op = dst;
+        uint8 * const opEnd = dst + dstCapacity;
+
+        size_t ip = 0;
+        size_t anchor = 0;
+
+        if( srcSize > MfLimit )
+        {
+            const size_t ipLimit    = srcSize - MfLimit;
+            const size_t matchLimit = srcSize - LastLiterals;
+
+            while( ip < ipLimit )
+            {
+                const uint32 sequence = readUint32( src + ip );
+                const uint32 hash = (sequence * 2654435761u) >> (32u - HashLog);
+                const int32 ref = hashTable[hash];
+                hashTable[hash] = static_cast<int32>( ip );
+
+                if( ref < 0 || ip - static_cast<size_t>( ref ) > 65535u ||
+                    readUint32( src + ref ) != sequence )
+                {
+                    ++ip;
+                    continue;
+                }
+
+                size_t matchLength = MinMatch;
+                while( ip + matchLength < matchLimit && src[ref + matchLength] == src[ip + matchLength] )
+                    ++matchLength;
+
+                const size_t literalLength = ip - anchor;
+                const size_t offset = ip - static_cast<size_t>( ref );
+
+                if( static_cast<size_t>( opEnd - op ) < 1u + literalLength / 255u + 1u +
+                                                         literalLength + 2u +
+                                                         matchLength / 255u + 1u )
+                {
+                    return 0;
+                }
+
+                uint8 *token = op++;
+                *token = static_cast<uint8>( std::min<size_t>( literalLength, 15u ) << 4u );
+                if( literalLength >= 15u )
+                {
+                    size_t remaining = literalLength - 15u;
+                    for( ; remaining >= 255u; remaining -= 255u )
+                        *op++ = 255u;
+                    *op++ = static_cast<uint8>( remaining );
+                }
+                memcpy( op, src + anchor, literalLength );
+                op += literalLength;
+
+                *op++ = static_cast<uint8>( offset & 0xFF );
+                *op++ = static_cast<uint8>( offset >> 8u );
+
+                const size_t extraMatchLength = matchLength - MinMatch;
+                *token |= static_cast<uint8>( std::min<size_t>( extraMatchLength, 15u ) );
+                if( extraMatchLength >= 15u )
+                {
+                    size_t remaining = extraMatchLength - 15u;
+                    for( ; remaining >= 255u; remaining -= 255u )
+                        *op++ = 255u;
+                    *op++ = static_cast<uint8>( remaining );
+                }
+
+                ip += matchLength;
+                anchor = ip;
+            }
+        }
+
+        // Last literals
+        const size_t literalLength = srcSize - anchor;
+        if( static_cast<size_t>( opEnd - op ) < 1u + literalLength / 255u + 1u + literalLength )
+            return 0;
+
+        *op++ = static_cast<uint8>( std::min<size_t>( literalLength, 15u ) << 4u );
+        if( literalLength >= 15u )
+        {
+            size_t remaining = literalLength - 15u;
+            for( ; remaining >= 255u; remaining -= 255u )
+                *op++ = 255u;
+            *op++ = static_cast<uint8>( remaining );
+        }
+        if( literalLength )
+            memcpy( op, src + anchor, literalLength );
+        op += literalLength;
+
+        return static_cast<size_t>( op - dst );
+    }
+    //-----------------------------------------------------------------------
+    bool PackArchive::decompressLz4( const uint8 *src, size_t srcSize, uint8 *dst, size_t dstSize )
+    {
+        const uint8 *ip = src;
+        const uint8 * const ipEnd = src + srcSize;
+        uint8 *op = dst;
+        uint8 * const opEnd = dst + dstSize;
+
+        while( ip < ipEnd )
+        {
+            const uint8 token = *ip++;
+
+            size_t literalLength = token >> 4u;
+            if( literalLength == 15u )
+            {
+                uint8 b;
+                do
+                {
+                    if( ip >= ipEnd )
+                        return false;
+                    b = *ip++;
+                    literalLength += b;
+                } while( b == 255u );
+            }
+
+            if( literalLength > static_cast<size_t>( ipEnd - ip ) ||
+                literalLength > static_cast<size_t>( opEnd - op ) )
+            {
+                return false;
+            }
+            memcpy( op, ip, literalLength );
+            ip += literalLength;
+            op += literalLength;
+
+            // The last sequence has no match
+            if( ip == ipEnd )
+                break;
+
+            if( ipEnd - ip < 2 )
+                return false;
+            const size_t offset = ip[0] | (ip[1] << 8u);
+            ip += 2;
+            if( offset == 0 || offset > static_cast<size_t>( op - dst ) )
+                return false;
+
+            size_t matchLength = token & 0x0Fu;
+            if( matchLength == 15u )
+            {
+                uint8 b;
+                do
+                {
+                    if( ip >= ipEnd )
+                        return false;
+                    b = *ip++;
+                    matchLength += b;
+                } while( b == 255u );
+            }
+            matchLength += 4u;
+
+            if( matchLength > static_cast<size_t>( opEnd - op ) )
+                return false;
+
+            // Matches can overlap with the bytes being written (i.e. runs)
+            const uint8 *match = op - offset;
+            if( offset >= matchLength )
+            {
+                memcpy( op, match, matchLength );
+                op += matchLength;
+            }
+            else
+            {
+                for( size_t i=0; i<matchLength; ++i )
+                    *op++ = *match++;
+            }
+        }
+
+        return op == opEnd;
+    }
+    //-----------------------------------------------------------------------
+    //-----------------------------------------------------------------------
+    //-----------------------------------------------------------------------
+    void PackArchiveWriter::addFile( const String &name, const DataStreamPtr &data, bool compress,
+                                     uint32 alignment, time_t modifiedTime )
+    {
+        if( alignment == 0 || (alignment & (alignment - 1u)) != 0 )
+        {
+            OGRE_EXCEPT( Exception::ERR_INVALIDPARAMS,
+                         "Alignment of " + name + " must be a power of 2",
+                         "PackArchiveWriter::addFile" );
+        }
+
+        PendingFile pendingFile;
+        pendingFile.name        = name;
+        pendingFile.data        = data;
+        pendingFile.archive     = 0;
+        pendingFile.compress    = compress;
+        pendingFile.alignment   = alignment;
+        pendingFile.modifiedTime= modifiedTime;
+        mFiles.push_back( pendingFile );
+    }
+    //-----------------------------------------------------------------------
+    void PackArchiveWriter::addArchive( Archive *archive, bool compress, uint32 alignment )
+    {
+        if( alignment == 0 || (alignment & (alignment - 1u)) != 0 )
+        {
+            OGRE_EXCEPT( Exception::ERR_INVALIDPARAMS,
+                         "Alignment must be a power of 2",
+                         "PackArchiveWriter::addArchive" );
+        }
+
+        // Don't open the files yet; archives with lots of them would run out of handles
+        FileInfoListPtr files = archive->listFileInfo( true, false );
+        FileInfoList::const_iterator itor = files->begin();
+        FileInfoList::const_iterator end  = files->end();
+        while( itor != end )
+        {
+            PendingFile pendingFile;
+            pendingFile.name        = itor->filename;
+            pendingFile.archive     = archive;
+            pendingFile.compress    = compress;
+            pendingFile.alignment   = alignment;
+            pendingFile.modifiedTime= archive->getModifiedTime( itor->filename );
+            mFiles.push_back( pendingFile );
+            ++itor;
+        }
+    }
+    //-----------------------------------------------------------------------
+    void PackArchiveWriter::writePadding( DataStreamPtr &stream, uint64 &inOutOffset, uint32 alignment )
+    {
+        static const uint8 zeroes[256] = { 0 };
+
+        uint64 padding = (alignment - (inOutOffset & (alignment - 1u))) & (alignment - 1u);
+        inOutOffset += padding;
+        while( padding )
+        {
+            const size_t bytesToWrite = static_cast<size_t>( std::min<uint64>( padding, sizeof(zeroes) ) );
+            stream->write( zeroes, bytesToWrite );
+            padding -= bytesToWrite;
+        }
+    }
+    //-----------------------------------------------------------------------
+    void PackArchiveWriter::write( DataStreamPtr &stream )
+    {
+        if( !stream->isWriteable() )
+        {
+            OGRE_EXCEPT( Exception::ERR_CANNOT_WRITE_TO_FILE,
+                         "Unable to write to stream " + stream->getName(),
+                         "PackArchiveWriter::write" );
+        }
+
+        const uint32 numEntries = static_cast<uint32>( mFiles.size() );
+
+        uint32 numBuckets = 1u;
+        while( numBuckets <= numEntries * 2u )
+            numBuckets <<= 1u;
+
+        vector<PackArchive::Entry>::type entries;
+        vector<uint32>::type buckets( numBuckets, 0u );
+        String names;
+        entries.reserve( numEntries );
+
+        vector<uint8>::type compressed;
+
+        uint64 offset = 0;
+
+        for( uint32 i=0; i<numEntries; ++i )
+        {
+            const PendingFile &pendingFile = mFiles[i];
+
+            PackArchive::Entry entry;
+            entry.nameHash      = PackArchive::hashName( pendingFile.name );
+            entry.nameOffset    = static_cast<uint32>( names.size() );
+            entry.nameLength    = static_cast<uint32>( pendingFile.name.size() );
+            entry.modifiedTime  = static_cast<int64>( pendingFile.modifiedTime );
+            entry.compression   = PackArchive::CompressionNone;
+
+            // Insert in the hash table first, to catch duplicates before writing anything else
+            uint32 bucketIdx = entry.nameHash & (numBuckets - 1u);
+            while( buckets[bucketIdx] )
+            {
+                const PackArchive::Entry &other = entries[buckets[bucketIdx] - 1u];
+                if( other.nameHash == entry.nameHash &&
+                    other.nameLength == entry.nameLength &&
+                    equalsCaseless( names.c_str() + other.nameOffset, pendingFile.name.c_str(),
+                                    entry.nameLength ) )
+                {
+                    OGRE_EXCEPT( Exception::ERR_DUPLICATE_ITEM,
+                                 "File " + pendingFile.name + " was added twice",
+                                 "PackArchiveWriter::write" );
+                }
+                bucketIdx = (bucketIdx + 1u) & (numBuckets - 1u);
+            }
+            buckets[bucketIdx] = i + 1u;
+            names += pendingFile.name;
+
+            DataStreamPtr srcStream = pendingFile.data;
+            if( srcStream.isNull() && pendingFile.archive )
+                srcStream = pendingFile.archive->open( pendingFile.name );
+            if( srcStream.isNull() )
+            {
+                OGRE_EXCEPT( Exception::ERR_FILE_NOT_FOUND,
+                             "Could not open " + pendingFile.name,
+                             "PackArchiveWriter::write" );
+            }
+
+            MemoryDataStream srcData( srcStream, true, true );
+            srcStream->close();
+
+            const uint8 *dataToWrite = srcData.getPtr();
+            size_t sizeToWrite = srcData.size();
+
+            if( pendingFile.compress && srcData.size() > 0 )
+            {
+                compressed.resize( PackArchive::getMaxCompressedSize( srcData.size() ) );
+                const size_t compressedSize = PackArchive::compressLz4( srcData.getPtr(), srcData.size(),
+                                                                        &compressed[0], compressed.size() );
+                // Keep it only if it's worth it
+                if( compressedSize > 0 && compressedSize < srcData.size() )
+                {
+                    entry.compression = PackArchive::CompressionLz4;
+                    dataToWrite = &compressed[0];
+                    sizeToWrite = compressedSize;
+                }
+            }
+
+            writePadding( stream, offset, pendingFile.alignment );
+
+            entry.offset            = offset;
+            entry.size              = sizeToWrite;
+            entry.uncompressedSize  = srcData.size();
+
+            if( sizeToWrite )
+                stream->write( dataToWrite, sizeToWrite );
+            offset += sizeToWrite;
+
+            entries.push_back( entry );
+        }
+
+        // Table of contents
+        writePadding( stream, offset, 8u );
+
+        PackArchive::Header header;
+        header.magic        = PackArchive::Magic;
+        header.version      = PackArchive::Version;
+        header.numEntries   = numEntries;
+        header.numBuckets   = numBuckets;
+        header.tocOffset    = offset;
+        header.tocSize      = numEntries * sizeof(PackArchive::Entry) +
+                              numBuckets * sizeof(uint32) + names.size();
+
+        if( !entries.empty() )
+            stream->write( &entries[0], numEntries * sizeof(PackArchive::Entry) );
+        stream->write( &buckets[0], numBuckets * sizeof(uint32) );
+        if( !names.empty() )
+            stream->write( names.c_str(), names.size() );
+        offset += header.tocSize;
+
+        // The header is 8-byte aligned too
+        writePadding( stream, offset, 8u );
+        stream->write( &header, sizeof(PackArchive::Header) );
+    }
+    //-----------------------------------------------------------------------
+    //-----------------------------------------------------------------------
+    //-----------------------------------------------------------------------
+    const String& PackArchiveFactory::getType(void) const
+    {
+        static String name = "Pack";
+        return name;
+    }
+}
@@ -29,6 +29,7 @@ THE SOFTWARE.
 
 #include "OgreParticleEmitter.h"
 #include "OgreParticleEmitterFactory.h"
+#include "OgreParticleSystem.h"
 
 namespace Ogre
 {
@@ -229,6 +230,20 @@ namespace Ogre
         mEmitted = emitted;
     }
     //-----------------------------------------------------------------------
+    /// Same as Vector3::randomDeviant, but the random spin around dir is supplied by the caller.
+    static Vector3 randomDeviant( const Vector3 &dir, const Radian &angle, const Vector3 &up,
+                                  Real unitRandom )
+    {
+        Vector3 newUp = up == Vector3::ZERO ? dir.perpendicular() : up;
+
+        Quaternion q;
+        q.FromAngleAxis( Radian( unitRandom * Math::TWO_PI ), dir );
+        newUp = q * newUp;
+
+        q.FromAngleAxis( angle, newUp );
+        return q * dir;
+    }
+    //-----------------------------------------------------------------------
     void ParticleEmitter::genEmissionDirection( const Vector3 &particlePos, Vector3& destVector )
     {
         if( mUseDirPositionRef )
@@ -239,10 +254,11 @@ namespace Ogre
             if (mAngle != Radian(0))
             {
                 // Randomise angle
-                Radian angle = Math::UnitRandom() * mAngle;
+                Radian angle = mParent->_getUnitRandom() * mAngle;
 
                 // Randomise direction
-                destVector = particleDir.randomDeviant( angle );
+                destVector = randomDeviant( particleDir, angle, Vector3::ZERO,
+                                            mParent->_getUnitRandom() );
             }
             else
             {
@@ -255,10 +271,10 @@ namespace Ogre
             if (mAngle != Radian(0))
             {
                 // Randomise angle
-                Radian angle = Math::UnitRandom() * mAngle;
+                Radian angle = mParent->_getUnitRandom() * mAngle;
 
                 // Randomise direction
-                destVector = mDirection.randomDeviant(angle, mUp);
+                destVector = randomDeviant( mDirection, angle, mUp, mParent->_getUnitRandom() );
             }
             else
             {
@@ -276,7 +292,7 @@ namespace Ogre
         Real scalar;
         if (mMinSpeed != mMaxSpeed)
         {
-            scalar = mMinSpeed + (Math::UnitRandom() * (mMaxSpeed - mMinSpeed));
+            scalar = mMinSpeed + (mParent->_getUnitRandom() * (mMaxSpeed - mMinSpeed));
         }
         else
         {
@@ -290,7 +306,7 @@ namespace Ogre
     {
         if (mMaxTTL != mMinTTL)
         {
-            return mMinTTL + (Math::UnitRandom() * (mMaxTTL - mMinTTL));
+            return mMinTTL + (mParent->_getUnitRandom() * (mMaxTTL - mMinTTL));
         }
         else
         {
@@ -351,10 +367,10 @@ namespace Ogre
         {
             // Randomise
             //Real t = Math::UnitRandom();
-            destColour.r = mColourRangeStart.r + (Math::UnitRandom() * (mColourRangeEnd.r - mColourRangeStart.r));
-            destColour.g = mColourRangeStart.g + (Math::UnitRandom() * (mColourRangeEnd.g - mColourRangeStart.g));
-            destColour.b = mColourRangeStart.b + (Math::UnitRandom() * (mColourRangeEnd.b - mColourRangeStart.b));
-            destColour.a = mColourRangeStart.a + (Math::UnitRandom() * (mColourRangeEnd.a - mColourRangeStart.a));
+            destColour.r = mColourRangeStart.r + (mParent->_getUnitRandom() * (mColourRangeEnd.r - mColourRangeStart.r));
+            destColour.g = mColourRangeStart.g + (mParent->_getUnitRandom() * (mColourRangeEnd.g - mColourRangeStart.g));
+            destColour.b = mColourRangeStart.b + (mParent->_getUnitRandom() * (mColourRangeEnd.b - mColourRangeStart.b));
+            destColour.a = mColourRangeStart.a + (mParent->_getUnitRandom() * (mColourRangeEnd.a - mColourRangeStart.a));
         }
         else
         {
@@ -598,7 +614,7 @@ namespace Ogre
             }
             else
             {
-                mDurationRemain = Math::RangeRandom(mDurationMin, mDurationMax);
+                mDurationRemain = mParent->_getRangeRandom(mDurationMin, mDurationMax);
             }
         }
         else
@@ -610,7 +626,7 @@ namespace Ogre
             }
             else
             {
-                mRepeatDelayRemain = Math::RangeRandom(mRepeatDelayMax, mRepeatDelayMin);
+                mRepeatDelayRemain = mParent->_getRangeRandom(mRepeatDelayMax, mRepeatDelayMin);
             }
 
         }
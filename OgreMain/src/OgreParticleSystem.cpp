@@ -73,7 +73,7 @@ namespace Ogre {
 
         Real getValue(void) const { return 0; } // N/A
 
-        void setValue(Real value) { mTarget->_update(value); }
+        void setValue(Real value) { mTarget->_scheduleUpdate(value); }
 
     };
     //-----------------------------------------------------------------------
@@ -97,6 +97,10 @@ namespace Ogre {
         mTimeController(0),
         mEmittedEmitterPoolInitialised(false),
         mIsEmitting(true),
+        mUpdatePending(false),
+        mPendingTimeElapsed(0),
+        mParentFullTransform(Matrix4::IDENTITY),
+        mRandomState(0),
         mRenderer(0), 
         mCullIndividual(false),
         mPoolSize(0),
@@ -109,6 +113,12 @@ namespace Ogre {
         setEmittedEmitterQuota( 3 );
         initParameters();
 
+        //Mix in the Id so that systems created in the same frame don't share their sequence
+        mRandomState = (static_cast<uint32>( Math::UnitRandom() * 65535.0f ) << 16u) ^
+                       static_cast<uint32>( id );
+        if( !mRandomState )
+            mRandomState = 1u;
+
         // Default to billboard renderer
         setRenderer("billboard");
 
@@ -120,6 +130,10 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     ParticleSystem::~ParticleSystem()
     {
+        // Don't leave a dangling pointer in the SceneManager's queue
+        if (mUpdatePending && mManager)
+            mManager->_dequeueParticleSystemUpdate(this);
+
         if (mTimeController)
         {
             // Destroy controller
@@ -339,10 +353,55 @@ namespace Ogre {
     }
     //-----------------------------------------------------------------------
     void ParticleSystem::_update(Real timeElapsed)
+    {
+        if (_prepareUpdate(timeElapsed))
+            _updateSimulation(timeElapsed);
+    }
+    //-----------------------------------------------------------------------
+    void ParticleSystem::_scheduleUpdate(Real timeElapsed)
+    {
+        if (!mManager || !mManager->getParallelParticleSystemUpdates())
+        {
+            _update(timeElapsed);
+            return;
+        }
+
+        if (_prepareUpdate(timeElapsed))
+        {
+            if (!mUpdatePending)
+            {
+                mUpdatePending = true;
+                mPendingTimeElapsed = 0;
+                mManager->_queueParticleSystemUpdate(this);
+            }
+            mPendingTimeElapsed += timeElapsed;
+        }
+    }
+    //-----------------------------------------------------------------------
+    void ParticleSystem::_updatePending(void)
+    {
+        if (mUpdatePending)
+        {
+            mUpdatePending = false;
+            _updateSimulation(mPendingTimeElapsed);
+        }
+    }
+    //-----------------------------------------------------------------------
+    Real ParticleSystem::_getUnitRandom(void)
+    {
+        //xorshift32. Never 0 as long as the seed isn't.
+        mRandomState ^= mRandomState << 13u;
+        mRandomState ^= mRandomState >> 17u;
+        mRandomState ^= mRandomState << 5u;
+        //Use the top 24 bits, which float represents exactly
+        return Real( mRandomState >> 8u ) * Real( 1.0 / 16777216.0 );
+    }
+    //-----------------------------------------------------------------------
+    bool ParticleSystem::_prepareUpdate(Real &timeElapsed)
     {
         // Only update if attached to a node
         if (!mParentNode)
-            return;
+            return false;
 
         Real nonvisibleTimeout = mNonvisibleTimeoutSet ?
             mNonvisibleTimeout : msDefaultNonvisibleTimeout;
@@ -358,7 +417,7 @@ namespace Ogre {
                 if (mTimeSinceLastVisible >= nonvisibleTimeout)
                 {
                     // No update
-                    return;
+                    return false;
                 }
             }
         }
@@ -372,6 +431,18 @@ namespace Ogre {
         // Initialise emitted emitters list if not done already
         initialiseEmittedEmitters();
 
+        //TODO: (dark_sylinc) Refactor this. ControllerManager gets executed before us
+        //(because it doesn't know if we'll update a SceneNode)
+        mParentFullTransform = mParentNode->_getFullTransformUpdated();
+
+        return true;
+    }
+    //-----------------------------------------------------------------------
+    void ParticleSystem::_updateSimulation(Real timeElapsed)
+    {
+        // Affectors that support it run on a SoA copy of the particles
+        const bool useArrayParticles = hasArrayAffectors();
+
         Real iterationInterval = mIterationIntervalSet ? 
             mIterationInterval : msDefaultIterationInterval;
         if (iterationInterval > 0)
@@ -382,8 +453,15 @@ namespace Ogre {
             {
                 // Update existing particles
                 _expire(iterationInterval);
-                _triggerAffectors(iterationInterval);
-                _applyMotion(iterationInterval);
+                if (useArrayParticles)
+                {
+                    _triggerArrayAffectorsAndApplyMotion(iterationInterval);
+                }
+                else
+                {
+                    _triggerAffectors(iterationInterval);
+                    _applyMotion(iterationInterval);
+                }
 
                 if(mIsEmitting)
                 {
@@ -398,8 +476,15 @@ namespace Ogre {
         {
             // Update existing particles
             _expire(timeElapsed);
-            _triggerAffectors(timeElapsed);
-            _applyMotion(timeElapsed);
+            if (useArrayParticles)
+            {
+                _triggerArrayAffectorsAndApplyMotion(timeElapsed);
+            }
+            else
+            {
+                _triggerAffectors(timeElapsed);
+                _applyMotion(timeElapsed);
+            }
 
             if(mIsEmitting)
             {
@@ -410,7 +495,7 @@ namespace Ogre {
 
         if (!mBoundsAutoUpdate && mBoundsUpdateTime > 0.0f)
             mBoundsUpdateTime -= timeElapsed; // count down 
-        _updateBounds();
+        _updateBoundsImpl();
 
     }
     //-----------------------------------------------------------------------
@@ -463,8 +548,8 @@ namespace Ogre {
     void ParticleSystem::_triggerEmitters(Real timeElapsed)
     {
         // Add up requests for emission
-        static vector<unsigned>::type requested;
-        static vector<unsigned>::type emittedRequested;
+        vector<unsigned>::type &requested = mRequestedEmissions;
+        vector<unsigned>::type &emittedRequested = mRequestedEmittedEmissions;
 
         if( requested.size() != mEmitters.size() )
             requested.resize( mEmitters.size() );
@@ -545,9 +630,7 @@ namespace Ogre {
 
         Real timeInc = timeElapsed / requested;
 
-        //TODO: (dark_sylinc) Refactor this. ControllerManager gets executed before us
-        //(because it doesn't know if we'll update a SceneNode)
-        const Matrix4 fullTransform = mParentNode->_getFullTransformUpdated();
+        const Matrix4 &fullTransform = mParentFullTransform;
 
         for (unsigned int j = 0; j < requested; ++j)
         {
@@ -636,6 +719,92 @@ namespace Ogre {
 
     }
     //-----------------------------------------------------------------------
+    void ParticleSystem::_triggerArrayAffectorsAndApplyMotion(Real timeElapsed)
+    {
+        mArrayParticles.gather(mActiveParticles, mDefaultWidth, mDefaultHeight);
+
+        // Track which copy is up to date so that consecutive affectors of the
+        // same kind don't need to convert back and forth.
+        bool arrayUpToDate = true;
+        bool particlesUpToDate = true;
+        bool dimensionsChanged = false;
+        bool rotationChanged = false;
+
+        ParticleAffectorList::iterator itor = mAffectors.begin();
+        ParticleAffectorList::iterator end  = mAffectors.end();
+
+        while (itor != end)
+        {
+            if ((*itor)->_supportsArrayParticles())
+            {
+                if (!arrayUpToDate)
+                {
+                    mArrayParticles.gather(mActiveParticles, mDefaultWidth, mDefaultHeight);
+                    arrayUpToDate = true;
+                }
+                (*itor)->_affectArrayParticles(mArrayParticles, timeElapsed);
+                particlesUpToDate = false;
+            }
+            else
+            {
+                if (!particlesUpToDate)
+                {
+                    dimensionsChanged |= mArrayParticles.mDimensionsChanged;
+                    rotationChanged |= mArrayParticles.mRotationChanged;
+                    mArrayParticles.scatter();
+                    particlesUpToDate = true;
+                }
+                (*itor)->_affectParticles(this, timeElapsed);
+                arrayUpToDate = false;
+            }
+            ++itor;
+        }
+
+        if (!arrayUpToDate)
+            mArrayParticles.gather(mActiveParticles, mDefaultWidth, mDefaultHeight);
+
+        mArrayParticles.applyMotion(timeElapsed);
+
+        dimensionsChanged |= mArrayParticles.mDimensionsChanged;
+        rotationChanged |= mArrayParticles.mRotationChanged;
+        mArrayParticles.scatter();
+
+        if (dimensionsChanged)
+            _notifyParticleResized();
+        if (rotationChanged)
+            _notifyParticleRotated();
+
+        // If it is an emitter, the emitter position must also be updated
+        // Note, that position of the emitter becomes a position in worldspace if mLocalSpace is set 
+        // to false (will this become a problem?)
+        ActiveEmittedEmitterList::const_iterator itEmit = mActiveEmittedEmitters.begin();
+        ActiveEmittedEmitterList::const_iterator enEmit = mActiveEmittedEmitters.end();
+        while (itEmit != enEmit)
+        {
+            ParticleEmitter *pParticleEmitter = *itEmit;
+            pParticleEmitter->setPosition(static_cast<Particle*>(pParticleEmitter)->mPosition);
+            ++itEmit;
+        }
+
+        // Notify renderer
+        mRenderer->_notifyParticleMoved(mActiveParticles);
+    }
+    //-----------------------------------------------------------------------
+    bool ParticleSystem::hasArrayAffectors(void) const
+    {
+        ParticleAffectorList::const_iterator itor = mAffectors.begin();
+        ParticleAffectorList::const_iterator end  = mAffectors.end();
+
+        while (itor != end)
+        {
+            if ((*itor)->_supportsArrayParticles())
+                return true;
+            ++itor;
+        }
+
+        return false;
+    }
+    //-----------------------------------------------------------------------
     void ParticleSystem::increasePool(size_t size)
     {
         size_t oldSize = mParticlePool.size();
@@ -795,6 +964,16 @@ namespace Ogre {
     }
     //-----------------------------------------------------------------------
     void ParticleSystem::_updateBounds()
+    {
+        if (mParentNode)
+        {
+            //TODO: (dark_sylinc) refactor the "Updated" part
+            mParentFullTransform = mParentNode->_getFullTransformUpdated();
+            _updateBoundsImpl();
+        }
+    }
+    //-----------------------------------------------------------------------
+    void ParticleSystem::_updateBoundsImpl()
     {
         if (mParentNode && (mBoundsAutoUpdate || mBoundsUpdateTime > 0.0f))
         {
@@ -840,12 +1019,12 @@ namespace Ogre {
                 // We've already put particles in world space to decouple them from the
                 // node transform, so reverse transform back since we're expected to 
                 // provide a local AABB
-                //TODO: (dark_sylinc) refactor the "Updated" part
-                aabb.transformAffine( mParentNode->_getFullTransformUpdated().inverseAffine() );
+                aabb.transformAffine( mParentFullTransform.inverseAffine() );
             }
 
             mObjectData.mLocalAabb->setFromAabb( aabb, mObjectData.mIndex );
             mObjectData.mLocalRadius[mObjectData.mIndex] = aabb.getRadius();
+            _notifyLocalAabbDirty();
         }
     }
     //-----------------------------------------------------------------------
@@ -156,7 +156,12 @@ namespace Ogre {
 #if OGRE_COMPILER == OGRE_COMPILER_MSVC
     #if _MSC_VER >= 1400 
         int CPUInfo[4];
+        #if _MSC_VER >= 1500
+        // Sub-leaf must be 0 for queries like 7 (structured extended features)
+        __cpuidex(CPUInfo, query, 0);
+        #else
         __cpuid(CPUInfo, query);
+        #endif
         result._eax = CPUInfo[0];
         result._ebx = CPUInfo[1];
         result._ecx = CPUInfo[2];
@@ -279,6 +284,31 @@ namespace Ogre {
 #endif
     }
 
+    //---------------------------------------------------------------------
+    // Detect whether or not the OS saves the upper halves of the YMM registers
+    // on context switch (otherwise AVX instructions can't be used even if the CPU
+    // supports them). Caller must have checked CPUID.1:ECX.OSXSAVE first.
+    static bool _checkOperatingSystemSupportAVX(void)
+    {
+#if OGRE_COMPILER == OGRE_COMPILER_MSVC
+    #if _MSC_FULL_VER >= 160040219
+        const uint64 xcr0 = _xgetbv(0);
+        return (xcr0 & 0x6) == 0x6;
+    #else
+        return false;
+    #endif
+#elif (OGRE_COMPILER == OGRE_COMPILER_GNUC || OGRE_COMPILER == OGRE_COMPILER_CLANG) && OGRE_PLATFORM != OGRE_PLATFORM_NACL && OGRE_PLATFORM != OGRE_PLATFORM_EMSCRIPTEN
+        uint32 xcr0Lo, xcr0Hi;
+        // xgetbv opcode, for assemblers that don't know the mnemonic
+        __asm__ __volatile__ (".byte 0x0f, 0x01, 0xd0" : "=a" (xcr0Lo), "=d" (xcr0Hi) : "c" (0));
+        (void)xcr0Hi;
+        return (xcr0Lo & 0x6) == 0x6;
+#else
+        // TODO: Supports other compiler
+        return false;
+#endif
+    }
+
     //---------------------------------------------------------------------
     // Compiler-independent routines
     //---------------------------------------------------------------------
@@ -294,6 +324,10 @@ namespace Ogre {
 #define CPUID_STD_HTT               (1<<28)     // EDX[28] - Bit 28 set indicates  Hyper-Threading Technology is supported in hardware.
 
 #define CPUID_STD_SSE3              (1<<0)      // ECX[0] - Bit 0 of standard function 1 indicate SSE3 supported
+#define CPUID_STD_FMA               (1<<12)     // ECX[12] - FMA3 supported
+#define CPUID_STD_OSXSAVE           (1<<27)     // ECX[27] - OS uses XSAVE/XRSTOR (xgetbv usable)
+#define CPUID_STD_AVX               (1<<28)     // ECX[28] - AVX supported
+#define CPUID_STD7_AVX2             (1<<5)      // EBX[5] of function 7 - AVX2 supported
 
 #define CPUID_FAMILY_ID_MASK        0x0F00      // EAX[11:8] - Bit 11 thru 8 contains family  processor id
 #define CPUID_EXT_FAMILY_ID_MASK    0x0F00000   // EAX[23:20] - Bit 23 thru 20 contains extended family processor id
@@ -311,7 +345,8 @@ namespace Ogre {
             CpuidResult result;
 
             // Has standard feature ?
-            if (_performCpuid(0, result))
+            const uint maxStdQuery = _performCpuid(0, result);
+            if (maxStdQuery)
             {
                 // Check vendor strings
                 if (memcmp(&result._ebx, "GenuineIntel", 12) == 0)
@@ -384,6 +419,23 @@ namespace Ogre {
                             features |= PlatformInformation::CPU_FEATURE_MMXEXT;
                     }
                 }
+
+                // AVX, FMA & AVX2 are checked the same way on every vendor
+                _performCpuid(1, result);
+                if ((result._ecx & CPUID_STD_OSXSAVE) && (result._ecx & CPUID_STD_AVX) &&
+                    _checkOperatingSystemSupportAVX())
+                {
+                    features |= PlatformInformation::CPU_FEATURE_AVX;
+                    if (result._ecx & CPUID_STD_FMA)
+                        features |= PlatformInformation::CPU_FEATURE_FMA;
+
+                    if (maxStdQuery >= 7)
+                    {
+                        _performCpuid(7, result);
+                        if (result._ebx & CPUID_STD7_AVX2)
+                            features |= PlatformInformation::CPU_FEATURE_AVX2;
+                    }
+                }
             }
         }
 
@@ -653,6 +705,15 @@ namespace Ogre {
 #       if defined(__SSE3__)
             features |= PlatformInformation::CPU_FEATURE_SSE3;
 #       endif
+#       if defined(__AVX__)
+            features |= PlatformInformation::CPU_FEATURE_AVX;
+#       endif
+#       if defined(__AVX2__)
+            features |= PlatformInformation::CPU_FEATURE_AVX2;
+#       endif
+#       if defined(__FMA__)
+            features |= PlatformInformation::CPU_FEATURE_FMA;
+#       endif
 #       if defined(__3dNOW__)
             features |= PlatformInformation::CPU_FEATURE_3DNOW;
 #       endif
@@ -757,6 +818,12 @@ namespace Ogre {
                 " *     SSE2: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_SSE2), true));
             pLog->logMessage(
                 " *     SSE3: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_SSE3), true));
+            pLog->logMessage(
+                " *      AVX: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_AVX), true));
+            pLog->logMessage(
+                " *     AVX2: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_AVX2), true));
+            pLog->logMessage(
+                " *      FMA: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_FMA), true));
             pLog->logMessage(
                 " *      MMX: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_MMX), true));
             pLog->logMessage(
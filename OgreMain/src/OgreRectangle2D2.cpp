@@ -53,6 +53,7 @@ namespace Ogre
         mObjectData.mLocalAabb->setFromAabb( aabb, mObjectData.mIndex );
         mObjectData.mWorldAabb->setFromAabb( aabb, mObjectData.mIndex );
         mObjectData.mLocalRadius[mObjectData.mIndex] = std::numeric_limits<Real>::max();
+        _notifyLocalAabbDirty();
         mObjectData.mWorldRadius[mObjectData.mIndex] = std::numeric_limits<Real>::max();
 
         setCastShadows( false );
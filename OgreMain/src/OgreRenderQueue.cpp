@@ -95,8 +95,23 @@ namespace Ogre
         mLastIndexData( 0 ),
         mLastTextureHash( 0 ),
         mCommandBuffer( 0 ),
-        mRenderingStarted( 0u )
+        mRenderingStarted( 0u ),
+        mParallelSortThreshold( 8192u ),
+        mSortingGroup( 0 ),
+        mSortNumRenderables( 0 ),
+        mSortNeedsGather( false ),
+        mSortNumMergeRounds( 0 ),
+        mParallelRecordingThreshold( std::numeric_limits<size_t>::max() ),
+        mRecordingGroup( 0 ),
+        mRecordCasterPass( false ),
+        mRecordPassCache( 0 ),
+        mRecordIndirectBuffer( 0 ),
+        mRecordStartIndirectDraw( 0 ),
+        mParallelRecordTask( this )
     {
+        mSortBuffers[0] = 0;
+        mSortBuffers[1] = 0;
+
         mCommandBuffer = new CommandBuffer();
 
         for( size_t i=0; i<256; ++i )
@@ -115,6 +130,12 @@ namespace Ogre
     {
         delete mCommandBuffer;
 
+        vector<CommandBuffer*>::type::const_iterator itCmdBuf = mRecordCommandBuffers.begin();
+        vector<CommandBuffer*>::type::const_iterator enCmdBuf = mRecordCommandBuffers.end();
+        while( itCmdBuf != enCmdBuf )
+            delete *itCmdBuf++;
+        mRecordCommandBuffers.clear();
+
         assert( mUsedIndirectBuffers.empty() );
 
         IndirectBufferPackedVec::const_iterator itor = mFreeIndirectBuffers.begin();
@@ -376,52 +397,10 @@ namespace Ogre
 
         for( size_t i=firstRq; i<lastRq; ++i )
         {
-            QueuedRenderableArray &queuedRenderables = mRenderQueues[i].mQueuedRenderables;
-            QueuedRenderableArrayPerThread &perThreadQueue = mRenderQueues[i].mQueuedRenderablesPerThread;
-
             if( !mRenderQueues[i].mSorted )
             {
                 OgreProfileGroupAggregate( "Sorting", OGREPROF_RENDERING );
-
-                size_t numRenderables = 0;
-                QueuedRenderableArrayPerThread::const_iterator itor = perThreadQueue.begin();
-                QueuedRenderableArrayPerThread::const_iterator end  = perThreadQueue.end();
-
-                while( itor != end )
-                {
-                    numRenderables += itor->q.size();
-                    ++itor;
-                }
-
-                queuedRenderables.reserve( numRenderables );
-
-                itor = perThreadQueue.begin();
-                while( itor != end )
-                {
-                    queuedRenderables.appendPOD( itor->q.begin(), itor->q.end() );
-                    ++itor;
-                }
-
-                //TODO: Exploit temporal coherence across frames then use insertion sorts.
-                //As explained by L. Spiro in
-                //http://www.gamedev.net/topic/661114-temporal-coherence-and-render-queue-sorting/?view=findpost&p=5181408
-                //Keep a list of sorted indices from the previous frame (one per camera).
-                //If we have the sorted list "5, 1, 4, 3, 2, 0":
-                //  * If it grew from last frame, append: 5, 1, 4, 3, 2, 0, 6, 7 and use insertion sort.
-                //  * If it's the same, leave it as is, and use insertion sort just in case.
-                //  * If it's shorter, reset the indices 0, 1, 2, 3, 4; probably use quicksort or other generic sort
-                //
-                //TODO2: Explore sorting first on multiple threads, then merge sort into one.
-                if( mRenderQueues[i].mSortMode == NormalSort )
-                {
-                    std::sort( queuedRenderables.begin(), queuedRenderables.end() );
-                    mRenderQueues[i].mSorted = true;
-                }
-                else if( mRenderQueues[i].mSortMode == StableSort )
-                {
-                    std::stable_sort( queuedRenderables.begin(), queuedRenderables.end() );
-                    mRenderQueues[i].mSorted = true;
-                }
+                sortRenderQueue( mRenderQueues[i] );
             }
 
             if( mRenderQueues[i].mMode == V1_LEGACY )
@@ -445,8 +424,19 @@ namespace Ogre
             }
             else if( numNeededDraws > 0 /*&& mRenderQueues[i].mMode == FAST*/ )
             {
-                indirectDraw = renderGL3( rs, casterPass, dualParaboloid, mPassCache, mRenderQueues[i],
-                                          indirectBuffer, indirectDraw, startIndirectDraw );
+                if( mRenderQueues[i].mQueuedRenderables.size() >= mParallelRecordingThreshold &&
+                    mSceneManager->getNumWorkerThreads() > 1u )
+                {
+                    indirectDraw = renderGL3Parallel( rs, casterPass, dualParaboloid, mPassCache,
+                                                      mRenderQueues[i], indirectBuffer,
+                                                      indirectDraw, startIndirectDraw );
+                }
+                else
+                {
+                    indirectDraw = renderGL3( rs, casterPass, dualParaboloid, mPassCache,
+                                              mRenderQueues[i], indirectBuffer,
+                                              indirectDraw, startIndirectDraw );
+                }
             }
         }
 
@@ -480,6 +470,321 @@ namespace Ogre
         OgreProfileEndGroup( "Command Execution", OGREPROF_RENDERING );
     }
     //-----------------------------------------------------------------------
+    void RenderQueue::sortRenderQueues( uint8 firstRq, uint8 lastRq )
+    {
+        for( size_t i=firstRq; i<lastRq; ++i )
+        {
+            if( !mRenderQueues[i].mSorted )
+                sortRenderQueue( mRenderQueues[i] );
+        }
+    }
+    //-----------------------------------------------------------------------
+    void RenderQueue::sortRenderQueue( RenderQueueGroup &renderQueueGroup )
+    {
+        QueuedRenderableArray &queuedRenderables = renderQueueGroup.mQueuedRenderables;
+        QueuedRenderableArrayPerThread &perThreadQueue = renderQueueGroup.mQueuedRenderablesPerThread;
+
+        mSortGatherOffsets.resizePOD( perThreadQueue.size() );
+
+        size_t numRenderables = 0;
+        QueuedRenderableArrayPerThread::const_iterator itor = perThreadQueue.begin();
+        QueuedRenderableArrayPerThread::const_iterator end  = perThreadQueue.end();
+
+        while( itor != end )
+        {
+            mSortGatherOffsets[itor - perThreadQueue.begin()] = numRenderables;
+            numRenderables += itor->q.size();
+            ++itor;
+        }
+
+        const bool sortEnabled = renderQueueGroup.mSortMode != DisableSort;
+        const bool parallel = sortEnabled && numRenderables >= mParallelSortThreshold;
+        const bool reuseSort = sortEnabled && renderQueueGroup.mReuseSort;
+
+        bool alreadyGathered = false;
+        if( !parallel || reuseSort )
+        {
+            queuedRenderables.reserve( numRenderables );
+
+            itor = perThreadQueue.begin();
+            while( itor != end )
+            {
+                queuedRenderables.appendPOD( itor->q.begin(), itor->q.end() );
+                ++itor;
+            }
+
+            alreadyGathered = true;
+        }
+
+        if( reuseSort )
+        {
+            QueuedRenderableArray &lastUnsorted = renderQueueGroup.mLastUnsorted;
+            QueuedRenderableArray &lastSorted   = renderQueueGroup.mLastSorted;
+            if( lastUnsorted.size() == numRenderables && numRenderables > 0u &&
+                memcmp( lastUnsorted.begin(), queuedRenderables.begin(),
+                        numRenderables * sizeof(QueuedRenderable) ) == 0 )
+            {
+                //Nothing changed since the last time. Reuse the result.
+                queuedRenderables.clear();
+                queuedRenderables.appendPOD( lastSorted.begin(), lastSorted.end() );
+                renderQueueGroup.mSorted = true;
+                return;
+            }
+
+            lastUnsorted.clear();
+            lastUnsorted.appendPOD( queuedRenderables.begin(), queuedRenderables.end() );
+        }
+
+        //TODO: Exploit temporal coherence across frames then use insertion sorts.
+        //As explained by L. Spiro in
+        //http://www.gamedev.net/topic/661114-temporal-coherence-and-render-queue-sorting/?view=findpost&p=5181408
+        //(setReuseSortWhenUnchanged only covers the case where nothing changed at all)
+        if( parallel )
+        {
+            //Radix sort + merge is stable, thus it is valid for both NormalSort & StableSort.
+            parallelSort( renderQueueGroup, numRenderables, alreadyGathered );
+            renderQueueGroup.mSorted = true;
+        }
+        else if( renderQueueGroup.mSortMode == NormalSort )
+        {
+            std::sort( queuedRenderables.begin(), queuedRenderables.end() );
+            renderQueueGroup.mSorted = true;
+        }
+        else if( renderQueueGroup.mSortMode == StableSort )
+        {
+            std::stable_sort( queuedRenderables.begin(), queuedRenderables.end() );
+            renderQueueGroup.mSorted = true;
+        }
+
+        if( reuseSort )
+        {
+            renderQueueGroup.mLastSorted.clear();
+            renderQueueGroup.mLastSorted.appendPOD( queuedRenderables.begin(),
+                                                    queuedRenderables.end() );
+        }
+    }
+    //-----------------------------------------------------------------------
+    void RenderQueue::buildSortTaskGraph( size_t numSlices )
+    {
+        mSortNumMergeRounds = 0;
+        while( (size_t(1u) << mSortNumMergeRounds) < numSlices )
+            ++mSortNumMergeRounds;
+
+        //Tasks are referenced by pointer from the graph. Don't let the vector reallocate.
+        mParallelSortTasks.clear();
+        mParallelSortTasks.reserve( 2u + mSortNumMergeRounds );
+
+        mParallelSortTasks.push_back( ParallelSortTask( this, ParallelSortTask::Gather, 0 ) );
+        mParallelSortTasks.push_back( ParallelSortTask( this, ParallelSortTask::LocalSort, 0 ) );
+        for( size_t i=0; i<mSortNumMergeRounds; ++i )
+            mParallelSortTasks.push_back( ParallelSortTask( this, ParallelSortTask::Merge, i ) );
+
+        mSortTaskGraph.clear();
+        TaskGraph::TaskId prevTask = TaskGraph::INVALID_TASK_ID;
+        ParallelSortTaskVec::iterator itor = mParallelSortTasks.begin();
+        ParallelSortTaskVec::iterator end  = mParallelSortTasks.end();
+
+        while( itor != end )
+        {
+            TaskGraph::TaskId taskId = mSortTaskGraph.addTask( &(*itor), numSlices );
+            mSortTaskGraph.addDependency( taskId, prevTask );
+            prevTask = taskId;
+            ++itor;
+        }
+    }
+    //-----------------------------------------------------------------------
+    void RenderQueue::parallelSort( RenderQueueGroup &renderQueueGroup, size_t numRenderables,
+                                    bool alreadyGathered )
+    {
+        if( mSortTaskGraph.getNumTasks() == 0 )
+            buildSortTaskGraph( renderQueueGroup.mQueuedRenderablesPerThread.size() );
+
+        QueuedRenderableArray &queuedRenderables = renderQueueGroup.mQueuedRenderables;
+        if( !alreadyGathered )
+            queuedRenderables.resizePOD( numRenderables );
+        if( mSortScratch.size() < numRenderables )
+            mSortScratch.resizePOD( numRenderables );
+
+        mSortingGroup       = &renderQueueGroup;
+        mSortBuffers[0]     = queuedRenderables.begin();
+        mSortBuffers[1]     = mSortScratch.begin();
+        mSortNumRenderables = numRenderables;
+        mSortNeedsGather    = !alreadyGathered;
+
+        mSceneManager->executeTaskGraph( &mSortTaskGraph );
+
+        //Each merge round ping-pongs between both buffers
+        if( mSortNumMergeRounds & 0x01 )
+        {
+            queuedRenderables.swap( mSortScratch );
+            queuedRenderables.resizePOD( numRenderables );
+        }
+
+        mSortingGroup = 0;
+        mSortBuffers[0] = 0;
+        mSortBuffers[1] = 0;
+    }
+    //-----------------------------------------------------------------------
+    void RenderQueue::parallelSortGather( size_t sliceIdx )
+    {
+        if( !mSortNeedsGather )
+            return;
+
+        const QueuedRenderableArray &q = mSortingGroup->mQueuedRenderablesPerThread[sliceIdx].q;
+        if( !q.empty() )
+        {
+            memcpy( mSortBuffers[0] + mSortGatherOffsets[sliceIdx], q.begin(),
+                    q.size() * sizeof(QueuedRenderable) );
+        }
+    }
+    //-----------------------------------------------------------------------
+    /// Stable LSD radix sort on QueuedRenderable::hash, 8 bits per pass. Passes where all
+    /// keys have the same digit (very common, i.e. the sub RQ ID bits) are skipped.
+    static void radixSortQueuedRenderables( QueuedRenderable * RESTRICT_ALIAS data,
+                                            QueuedRenderable * RESTRICT_ALIAS tmp,
+                                            size_t numElements )
+    {
+        if( numElements < 2u )
+            return;
+
+        uint32 histograms[8][256];
+        memset( histograms, 0, sizeof( histograms ) );
+
+        for( size_t i=0; i<numElements; ++i )
+        {
+            const uint64 hash = data[i].hash;
+            for( size_t pass=0; pass<8u; ++pass )
+                ++histograms[pass][(hash >> (pass << 3u)) & 0xFF];
+        }
+
+        QueuedRenderable * RESTRICT_ALIAS src = data;
+        QueuedRenderable * RESTRICT_ALIAS dst = tmp;
+
+        for( size_t pass=0; pass<8u; ++pass )
+        {
+            const size_t shift = pass << 3u;
+            uint32 *histogram = histograms[pass];
+
+            if( histogram[(src[0].hash >> shift) & 0xFF] == numElements )
+                continue;
+
+            uint32 offset = 0;
+            for( size_t i=0; i<256u; ++i )
+            {
+                const uint32 count = histogram[i];
+                histogram[i] = offset;
+                offset += count;
+            }
+
+            for( size_t i=0; i<numElements; ++i )
+                dst[histogram[(src[i].hash >> shift) & 0xFF]++] = src[i];
+
+            std::swap( src, dst );
+        }
+
+        if( src != data )
+            memcpy( data, src, numElements * sizeof(QueuedRenderable) );
+    }
+    //-----------------------------------------------------------------------
+    void RenderQueue::parallelSortLocal( size_t sliceIdx, size_t numSlices )
+    {
+        const size_t chunkStart = (mSortNumRenderables * sliceIdx) / numSlices;
+        const size_t chunkEnd   = (mSortNumRenderables * (sliceIdx + 1u)) / numSlices;
+
+        radixSortQueuedRenderables( mSortBuffers[0] + chunkStart, mSortBuffers[1] + chunkStart,
+                                    chunkEnd - chunkStart );
+    }
+    //-----------------------------------------------------------------------
+    /// Returns how many elements from 'a' are among the first 'diagonal' elements of the
+    /// (stable) merge of a & b. See "Merge Path - Parallel Merging Made Simple" (Odeh et al.)
+    static size_t mergePathSplit( const QueuedRenderable * RESTRICT_ALIAS a, size_t sizeA,
+                                  const QueuedRenderable * RESTRICT_ALIAS b, size_t sizeB,
+                                  size_t diagonal )
+    {
+        size_t lo = diagonal > sizeB ? diagonal - sizeB : 0u;
+        size_t hi = std::min( diagonal, sizeA );
+
+        while( lo < hi )
+        {
+            const size_t mid = (lo + hi + 1u) >> 1u;
+            //On ties 'a' goes first, to keep the merge stable.
+            if( a[mid - 1u].hash <= b[diagonal - mid].hash )
+                lo = mid;
+            else
+                hi = mid - 1u;
+        }
+
+        return lo;
+    }
+    //-----------------------------------------------------------------------
+    void RenderQueue::parallelSortMerge( size_t sliceIdx, size_t numSlices, size_t mergeRound )
+    {
+        const QueuedRenderable * RESTRICT_ALIAS src = mSortBuffers[mergeRound & 0x01];
+        QueuedRenderable * RESTRICT_ALIAS dst = mSortBuffers[(mergeRound + 1u) & 0x01];
+
+        //Runs are made of 'runChunks' of the chunks sorted in parallelSortLocal.
+        //Runs are merged in pairs, each slice taking care of 1/numSlices of every pair.
+        const size_t numChunks = numSlices;
+        const size_t runChunks = size_t(1u) << mergeRound;
+
+        for( size_t chunk=0; chunk<numChunks; chunk += runChunks << 1u )
+        {
+            const size_t startA = (mSortNumRenderables * chunk) / numChunks;
+            const size_t startB = (mSortNumRenderables *
+                                   std::min( chunk + runChunks, numChunks )) / numChunks;
+            const size_t endB   = (mSortNumRenderables *
+                                   std::min( chunk + (runChunks << 1u), numChunks )) / numChunks;
+
+            const QueuedRenderable *a = src + startA;
+            const QueuedRenderable *b = src + startB;
+            const size_t sizeA = startB - startA;
+            const size_t sizeB = endB - startB;
+            const size_t sizeOut = sizeA + sizeB;
+
+            const size_t diagStart  = (sizeOut * sliceIdx) / numSlices;
+            const size_t diagEnd    = (sizeOut * (sliceIdx + 1u)) / numSlices;
+
+            size_t i    = mergePathSplit( a, sizeA, b, sizeB, diagStart );
+            size_t j    = diagStart - i;
+            const size_t iEnd = mergePathSplit( a, sizeA, b, sizeB, diagEnd );
+            const size_t jEnd = diagEnd - iEnd;
+
+            QueuedRenderable * RESTRICT_ALIAS out = dst + startA + diagStart;
+
+            while( i < iEnd && j < jEnd )
+            {
+                if( b[j].hash < a[i].hash )
+                    *out++ = b[j++];
+                else
+                    *out++ = a[i++];
+            }
+
+            if( i < iEnd )
+            {
+                memcpy( out, a + i, (iEnd - i) * sizeof(QueuedRenderable) );
+                out += iEnd - i;
+            }
+            if( j < jEnd )
+                memcpy( out, b + j, (jEnd - j) * sizeof(QueuedRenderable) );
+        }
+    }
+    //-----------------------------------------------------------------------
+    void RenderQueue::ParallelSortTask::execute( size_t threadId, size_t numThreads )
+    {
+        switch( mPhase )
+        {
+        case Gather:
+            mRenderQueue->parallelSortGather( threadId );
+            break;
+        case LocalSort:
+            mRenderQueue->parallelSortLocal( threadId, numThreads );
+            break;
+        case Merge:
+            mRenderQueue->parallelSortMerge( threadId, numThreads, mMergeRound );
+            break;
+        }
+    }
+    //-----------------------------------------------------------------------
     void RenderQueue::renderES2( RenderSystem *rs, bool casterPass, bool dualParaboloid,
                                  HlmsCache passCache[HLMS_MAX],
                                  const RenderQueueGroup &renderQueueGroup )
@@ -550,8 +855,181 @@ namespace Ogre
                                            unsigned char *indirectDraw,
                                            unsigned char *startIndirectDraw )
     {
+        const QueuedRenderableArray &queuedRenderables = renderQueueGroup.mQueuedRenderables;
+
+        RecordState recordState;
+        recordState.commandBuffer   = mCommandBuffer;
+        recordState.indirectDraw    = indirectDraw;
+        recordState.lastVaoName     = mLastVaoName;
+
+        recordGL3( recordState, 0, casterPass, passCache,
+                   queuedRenderables.begin(), queuedRenderables.end(), 0,
+                   indirectBuffer, startIndirectDraw );
+
+        RenderSystem::Metrics stats;
+        stats.mDrawCount    = recordState.drawCount;
+        stats.mInstanceCount= recordState.instanceCount;
+        stats.mFaceCount    = recordState.faceCount;
+        stats.mVertexCount  = recordState.vertexCount;
+        stats.mPsoSwitchCount = recordState.psoSwitchCount;
+        rs->_addMetrics( stats );
+
+        mLastVaoName        = recordState.lastVaoName;
+        mLastVertexData     = 0;
+        mLastIndexData      = 0;
+        mLastTextureHash    = 0;
+
+        return recordState.indirectDraw;
+    }
+    //-----------------------------------------------------------------------
+    unsigned char *RenderQueue::renderGL3Parallel( RenderSystem *rs, bool casterPass,
+                                                   bool dualParaboloid, HlmsCache passCache[],
+                                                   const RenderQueueGroup &renderQueueGroup,
+                                                   IndirectBufferPacked *indirectBuffer,
+                                                   unsigned char *indirectDraw,
+                                                   unsigned char *startIndirectDraw )
+    {
+        const QueuedRenderableArray &queuedRenderables = renderQueueGroup.mQueuedRenderables;
+        const size_t numRenderables = queuedRenderables.size();
+        const size_t numSlices = mSceneManager->getNumWorkerThreads();
+
+        bool parallelHlms[HLMS_MAX];
+        for( size_t i=0; i<HLMS_MAX; ++i )
+        {
+            Hlms *hlms = mHlmsManager->getHlms( static_cast<HlmsTypes>( i ) );
+            parallelHlms[i] = hlms && hlms->supportsParallelFillBuffers();
+        }
+
+        //Retrieving the material may compile shaders and create PSOs,
+        //which can only be done from the main thread.
+        mRecordHlmsCaches.resizePOD( numRenderables );
+        HlmsCache const **hlmsCaches = mRecordHlmsCaches.begin();
+        HlmsCache const *lastHlmsCache = &c_dummyCache;
+
+        QueuedRenderableArray::const_iterator itor = queuedRenderables.begin();
+        QueuedRenderableArray::const_iterator end  = queuedRenderables.end();
+
+        while( itor != end )
+        {
+            const HlmsDatablock *datablock = itor->renderable->getDatablock();
+
+            if( !parallelHlms[datablock->mType] )
+            {
+                return renderGL3( rs, casterPass, dualParaboloid, passCache, renderQueueGroup,
+                                  indirectBuffer, indirectDraw, startIndirectDraw );
+            }
+
+            Hlms *hlms = mHlmsManager->getHlms( static_cast<HlmsTypes>( datablock->mType ) );
+            const HlmsCache *hlmsCache = hlms->getMaterial( lastHlmsCache,
+                                                            passCache[datablock->mType],
+                                                            *itor, casterPass, true );
+            if( hlmsCache )
+                lastHlmsCache = hlmsCache;
+            *hlmsCaches++ = hlmsCache;
+            ++itor;
+        }
+
+        const size_t renderablesPerSlice = ( numRenderables + numSlices - 1u ) / numSlices;
+        for( size_t i=0; i<HLMS_MAX; ++i )
+        {
+            if( parallelHlms[i] )
+            {
+                Hlms *hlms = mHlmsManager->getHlms( static_cast<HlmsTypes>( i ) );
+                hlms->_beginParallelFillBuffers( numSlices, renderablesPerSlice, mCommandBuffer );
+            }
+        }
+
+        while( mRecordCommandBuffers.size() < numSlices )
+            mRecordCommandBuffers.push_back( new CommandBuffer() );
+
+        mRecordStates.resizePOD( numSlices );
+        for( size_t i=0; i<numSlices; ++i )
+        {
+            //A slice can't issue more draws than renderables it has. Give each
+            //slice the region of the indirect buffer that fits its worst case.
+            const size_t sliceStart = ( numRenderables * i ) / numSlices;
+            RecordState &recordState = mRecordStates[i];
+            recordState = RecordState();
+            recordState.commandBuffer   = mRecordCommandBuffers[i];
+            recordState.indirectDraw    = indirectDraw + sliceStart * sizeof( CbDrawIndexed );
+        }
+
+        mRecordingGroup         = &renderQueueGroup;
+        mRecordCasterPass       = casterPass;
+        mRecordPassCache        = passCache;
+        mRecordIndirectBuffer   = indirectBuffer;
+        mRecordStartIndirectDraw= startIndirectDraw;
+
+        mSceneManager->executeUserScalableTask( &mParallelRecordTask, true );
+
+        mRecordingGroup = 0;
+
+        RenderSystem::Metrics stats;
+        for( size_t i=0; i<numSlices; ++i )
+        {
+            RecordState &recordState = mRecordStates[i];
+            mCommandBuffer->append( recordState.commandBuffer );
+
+            if( recordState.lastVaoName )
+                mLastVaoName = recordState.lastVaoName;
+
+            stats.mDrawCount    += recordState.drawCount;
+            stats.mInstanceCount+= recordState.instanceCount;
+            stats.mFaceCount    += recordState.faceCount;
+            stats.mVertexCount  += recordState.vertexCount;
+            stats.mPsoSwitchCount += recordState.psoSwitchCount;
+        }
+
+        rs->_addMetrics( stats );
+
+        mLastVertexData     = 0;
+        mLastIndexData      = 0;
+        mLastTextureHash    = 0;
+
+        //Slices leave gaps in the indirect buffer. Skip the worst case.
+        return indirectDraw + numRenderables * sizeof( CbDrawIndexed );
+    }
+    //-----------------------------------------------------------------------
+    void RenderQueue::parallelRecord( size_t sliceIdx, size_t numSlices )
+    {
+        assert( numSlices == mRecordStates.size() );
+
+        const QueuedRenderableArray &queuedRenderables = mRecordingGroup->mQueuedRenderables;
+        const size_t numRenderables = queuedRenderables.size();
+        const size_t sliceStart = ( numRenderables * sliceIdx ) / numSlices;
+        const size_t sliceEnd   = ( numRenderables * (sliceIdx + 1u) ) / numSlices;
+
+        RecordState &recordState = mRecordStates[sliceIdx];
+        recordGL3( recordState, sliceIdx, mRecordCasterPass, mRecordPassCache,
+                   queuedRenderables.begin() + sliceStart, queuedRenderables.begin() + sliceEnd,
+                   mRecordHlmsCaches.begin() + sliceStart,
+                   mRecordIndirectBuffer, mRecordStartIndirectDraw );
+
+        for( size_t i=0; i<HLMS_MAX; ++i )
+        {
+            Hlms *hlms = mHlmsManager->getHlms( static_cast<HlmsTypes>( i ) );
+            if( hlms && hlms->supportsParallelFillBuffers() )
+                hlms->_endParallelFillBuffers( sliceIdx, recordState.commandBuffer );
+        }
+    }
+    //-----------------------------------------------------------------------
+    void RenderQueue::ParallelRecordTask::execute( size_t threadId, size_t numThreads )
+    {
+        mRenderQueue->parallelRecord( threadId, numThreads );
+    }
+    //-----------------------------------------------------------------------
+    void RenderQueue::recordGL3( RecordState &state, size_t threadIdx, bool casterPass,
+                                 HlmsCache passCache[],
+                                 const QueuedRenderable *begin, const QueuedRenderable *end,
+                                 HlmsCache const * const *hlmsCaches,
+                                 IndirectBufferPacked *indirectBuffer,
+                                 unsigned char *startIndirectDraw )
+    {
+        CommandBuffer *commandBuffer = state.commandBuffer;
+        unsigned char *indirectDraw = state.indirectDraw;
+
         VertexArrayObject *lastVao = 0;
-        uint32 lastVaoName = mLastVaoName;
+        uint32 lastVaoName = state.lastVaoName;
         HlmsCache const *lastHlmsCache = &c_dummyCache;
         uint32 lastHlmsCacheHash = 0;
 
@@ -571,10 +1049,7 @@ namespace Ogre
 
         RenderSystem::Metrics stats;
 
-        const QueuedRenderableArray &queuedRenderables = renderQueueGroup.mQueuedRenderables;
-
-        QueuedRenderableArray::const_iterator itor = queuedRenderables.begin();
-        QueuedRenderableArray::const_iterator end  = queuedRenderables.end();
+        const QueuedRenderable *itor = begin;
 
         while( itor != end )
         {
@@ -589,24 +1064,48 @@ namespace Ogre
             Hlms *hlms = mHlmsManager->getHlms( static_cast<HlmsTypes>( datablock->mType ) );
 
             lastHlmsCacheHash = lastHlmsCache->hash;
-            const HlmsCache *hlmsCache = hlms->getMaterial( lastHlmsCache,
-                                                            passCache[datablock->mType],
-                                                            queuedRenderable,
-                                                            casterPass );
+            const HlmsCache *hlmsCache;
+            if( !hlmsCaches )
+            {
+                hlmsCache = hlms->getMaterial( lastHlmsCache, passCache[datablock->mType],
+                                               queuedRenderable, casterPass, true );
+            }
+            else
+            {
+                hlmsCache = *hlmsCaches++;
+            }
+
+            if( !hlmsCache )
+            {
+                //Shaders are still being generated (async shader compilation)
+                ++itor;
+                continue;
+            }
             if( lastHlmsCacheHash != hlmsCache->hash )
             {
-                CbPipelineStateObject *psoCmd = mCommandBuffer->addCommand<CbPipelineStateObject>();
+                CbPipelineStateObject *psoCmd = commandBuffer->addCommand<CbPipelineStateObject>();
                 *psoCmd = CbPipelineStateObject( &hlmsCache->pso );
                 lastHlmsCache = hlmsCache;
+                ++stats.mPsoSwitchCount;
 
                 //Flush the Vao when changing shaders. Needed by D3D11/12 & possibly Vulkan
                 lastVaoName = 0;
             }
 
-            uint32 baseInstance = hlms->fillBuffersForV2( hlmsCache, queuedRenderable, casterPass,
-                                                          lastHlmsCacheHash, mCommandBuffer );
+            uint32 baseInstance;
+            if( !hlmsCaches )
+            {
+                baseInstance = hlms->fillBuffersForV2( hlmsCache, queuedRenderable, casterPass,
+                                                       lastHlmsCacheHash, commandBuffer );
+            }
+            else
+            {
+                baseInstance = hlms->fillBuffersForV2Mt( threadIdx, hlmsCache, queuedRenderable,
+                                                         casterPass, lastHlmsCacheHash,
+                                                         commandBuffer );
+            }
 
-            if( drawCmd != mCommandBuffer->getLastCommand() ||
+            if( drawCmd != commandBuffer->getLastCommand() ||
                 lastVaoName != vao->getVaoName() )
             {
                 //Different mesh, vertex buffers or layout. Make a new draw call.
@@ -614,8 +1113,8 @@ namespace Ogre
 
                 if( lastVaoName != vao->getVaoName() )
                 {
-                    *mCommandBuffer->addCommand<CbVao>() = CbVao( vao );
-                    *mCommandBuffer->addCommand<CbIndirectBuffer>() =
+                    *commandBuffer->addCommand<CbVao>() = CbVao( vao );
+                    *commandBuffer->addCommand<CbIndirectBuffer>() =
                                                             CbIndirectBuffer( indirectBuffer );
                     lastVaoName = vao->getVaoName();
                 }
@@ -625,13 +1124,13 @@ namespace Ogre
 
                 if( vao->getIndexBuffer() )
                 {
-                    CbDrawCallIndexed *drawCall = mCommandBuffer->addCommand<CbDrawCallIndexed>();
+                    CbDrawCallIndexed *drawCall = commandBuffer->addCommand<CbDrawCallIndexed>();
                     *drawCall = CbDrawCallIndexed( baseInstanceAndIndirectBuffers, vao, offset );
                     drawCmd = drawCall;
                 }
                 else
                 {
-                    CbDrawCallStrip *drawCall = mCommandBuffer->addCommand<CbDrawCallStrip>();
+                    CbDrawCallStrip *drawCall = commandBuffer->addCommand<CbDrawCallStrip>();
                     *drawCall = CbDrawCallStrip( baseInstanceAndIndirectBuffers, vao, offset );
                     drawCmd = drawCall;
                 }
@@ -703,14 +1202,13 @@ namespace Ogre
             ++itor;
         }
 
-        rs->_addMetrics( stats );
-
-        mLastVaoName        = lastVaoName;
-        mLastVertexData     = 0;
-        mLastIndexData      = 0;
-        mLastTextureHash    = 0;
-
-        return indirectDraw;
+        state.indirectDraw  = indirectDraw;
+        state.lastVaoName   = lastVaoName;
+        state.drawCount     += stats.mDrawCount;
+        state.instanceCount += stats.mInstanceCount;
+        state.faceCount     += stats.mFaceCount;
+        state.vertexCount   += stats.mVertexCount;
+        state.psoSwitchCount+= stats.mPsoSwitchCount;
     }
     //-----------------------------------------------------------------------
     void RenderQueue::renderGL3V1( RenderSystem *rs, bool casterPass, bool dualParaboloid,
@@ -752,12 +1250,20 @@ namespace Ogre
             lastHlmsCacheHash = lastHlmsCache->hash;
             const HlmsCache *hlmsCache = hlms->getMaterial( lastHlmsCache,
                                                             passCache[datablock->mType],
-                                                            queuedRenderable, casterPass );
+                                                            queuedRenderable, casterPass, true );
+            if( !hlmsCache )
+            {
+                //Shaders are still being generated (async shader compilation)
+                ++itor;
+                continue;
+            }
+
             if( lastHlmsCache != hlmsCache )
             {
                 CbPipelineStateObject *psoCmd = mCommandBuffer->addCommand<CbPipelineStateObject>();
                 *psoCmd = CbPipelineStateObject( &hlmsCache->pso );
                 lastHlmsCache = hlmsCache;
+                ++stats.mPsoSwitchCount;
 
                 //Flush the RenderOp when changing shaders. Needed by D3D11/12 & possibly Vulkan
                 lastRenderOp.vertexData = 0;
@@ -927,6 +1433,13 @@ namespace Ogre
                                      mUsedIndirectBuffers.begin(),
                                      mUsedIndirectBuffers.end() );
         mUsedIndirectBuffers.clear();
+
+        for( size_t i=0; i<HLMS_MAX; ++i )
+        {
+            Hlms *hlms = mHlmsManager->getHlms( static_cast<HlmsTypes>( i ) );
+            if( hlms )
+                hlms->_compilePendingShaders( mSceneManager );
+        }
     }
     //-----------------------------------------------------------------------
     void RenderQueue::setRenderQueueMode( uint8 rqId, Modes newMode )
@@ -948,5 +1461,30 @@ namespace Ogre
     {
         return mRenderQueues[rqId].mSortMode;
     }
+    //-----------------------------------------------------------------------
+    void RenderQueue::setReuseSortWhenUnchanged( uint8 rqId, bool bReuse )
+    {
+        RenderQueueGroup &renderQueueGroup = mRenderQueues[rqId];
+        renderQueueGroup.mReuseSort = bReuse;
+        if( !bReuse )
+        {
+            renderQueueGroup.mLastUnsorted.destroy();
+            renderQueueGroup.mLastSorted.destroy();
+        }
+    }
+    //-----------------------------------------------------------------------
+    bool RenderQueue::getReuseSortWhenUnchanged( uint8 rqId ) const
+    {
+        return mRenderQueues[rqId].mReuseSort;
+    }
+    //-----------------------------------------------------------------------
+    void RenderQueue::setParallelSortThreshold( size_t numRenderables )
+    {
+        mParallelSortThreshold = std::max<size_t>( numRenderables, 1u );
+    }
+    //-----------------------------------------------------------------------
+    void RenderQueue::setParallelRecordingThreshold( size_t numRenderables )
+    {
+        mParallelRecordingThreshold = std::max<size_t>( numRenderables, 1u );
+    }
 }
-
@@ -827,7 +827,15 @@ namespace Ogre {
             mMetrics.mVertexCount += newMetrics.mVertexCount;
             mMetrics.mDrawCount += newMetrics.mDrawCount;
             mMetrics.mInstanceCount += newMetrics.mInstanceCount;
+            mMetrics.mPsoSwitchCount += newMetrics.mPsoSwitchCount;
         }
+
+        mFrameMetrics.mBatchCount += newMetrics.mBatchCount;
+        mFrameMetrics.mFaceCount += newMetrics.mFaceCount;
+        mFrameMetrics.mVertexCount += newMetrics.mVertexCount;
+        mFrameMetrics.mDrawCount += newMetrics.mDrawCount;
+        mFrameMetrics.mInstanceCount += newMetrics.mInstanceCount;
+        mFrameMetrics.mPsoSwitchCount += newMetrics.mPsoSwitchCount;
     }
     //-----------------------------------------------------------------------
     void RenderSystem::setMetricsRecordingEnabled( bool bEnable )
@@ -840,6 +848,16 @@ namespace Ogre {
         return mMetrics;
     }
     //-----------------------------------------------------------------------
+    void RenderSystem::_resetFrameMetrics()
+    {
+        mFrameMetrics = Metrics();
+    }
+    //-----------------------------------------------------------------------
+    const RenderSystem::Metrics& RenderSystem::getFrameMetrics() const
+    {
+        return mFrameMetrics;
+    }
+    //-----------------------------------------------------------------------
     void RenderSystem::convertColourValue(const ColourValue& colour, uint32* pDest)
     {
         *pDest = v1::VertexElement::convertColourValue(colour, getColourVertexElementType());
@@ -1387,7 +1405,8 @@ namespace Ogre {
         mFaceCount( 0 ),
         mVertexCount( 0 ),
         mDrawCount( 0 ),
-        mInstanceCount( 0 )
+        mInstanceCount( 0 ),
+        mPsoSwitchCount( 0 )
     {
     }
 }
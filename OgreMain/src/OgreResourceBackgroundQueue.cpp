@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include "OgreException.h"
 #include "OgreResourceManager.h"
 #include "OgreRoot.h"
+#include "Threading/OgreAtomicHelpers.h"
 
 namespace Ogre {
 
@@ -71,6 +72,16 @@ namespace Ogre {
         wq->abortRequestsByChannel(mWorkQueueChannel);
         wq->removeRequestHandler(mWorkQueueChannel, this);
         wq->removeResponseHandler(mWorkQueueChannel, this);
+
+        // Responses for these won't come anymore
+        ParallelGroupLoadMap::const_iterator itor = mParallelGroupLoads.begin();
+        ParallelGroupLoadMap::const_iterator end  = mParallelGroupLoads.end();
+        while( itor != end )
+        {
+            OGRE_DELETE_T( itor->second, ParallelGroupLoad, MEMCATEGORY_RESOURCE );
+            ++itor;
+        }
+        mParallelGroupLoads.clear();
     }
     //------------------------------------------------------------------------
     BackgroundProcessTicket ResourceBackgroundQueue::initialiseResourceGroup(
@@ -141,6 +152,77 @@ namespace Ogre {
 #endif
     }
     //------------------------------------------------------------------------
+    BackgroundProcessTicket ResourceBackgroundQueue::loadResourceGroupParallel(
+        const String& name, ResourceBackgroundQueue::Listener* listener)
+    {
+#if OGRE_THREAD_SUPPORT
+        ResourceGroupManager &rgm = ResourceGroupManager::getSingleton();
+
+        vector<ResourcePtr>::type resources;
+        rgm._beginLoadResourceGroup( name, resources );
+
+        if( resources.empty() )
+        {
+            rgm._endLoadResourceGroup( name, true );
+            return 0;
+        }
+
+        ParallelGroupLoad *groupLoad = OGRE_NEW_T( ParallelGroupLoad, MEMCATEGORY_RESOURCE )();
+        groupLoad->resources.swap( resources );
+        groupLoad->groupName = name;
+        groupLoad->prepared.resize( groupLoad->resources.size(), false );
+        groupLoad->nextToLoad = 0;
+        groupLoad->numRequestsPending = groupLoad->resources.size();
+        atomicStore( &groupLoad->aborted, 0 );
+        groupLoad->listener = listener;
+
+        WorkQueue* queue = Root::getSingleton().getWorkQueue();
+
+        ResourceRequest req;
+        req.type = RT_PREPARE_GROUP_RESOURCE;
+        req.groupName = name;
+        req.isManual = false;
+        req.loader = 0;
+        req.loadParams = 0;
+        req.listener = 0;
+        req.groupLoad = groupLoad;
+
+        for( size_t i=0; i<groupLoad->resources.size(); ++i )
+        {
+            const ResourcePtr &resource = groupLoad->resources[i];
+            req.resourceType    = resource->getCreator()->getResourceType();
+            req.resourceHandle  = resource->getHandle();
+            req.groupResourceIdx= i;
+
+            WorkQueue::RequestID requestID =
+                    queue->addRequest( mWorkQueueChannel, (uint16)req.type, Any( req ) );
+            // The first request identifies the whole operation
+            if( i == 0 )
+                groupLoad->ticket = requestID;
+        }
+
+        mParallelGroupLoads[groupLoad->ticket] = groupLoad;
+        mOutstandingRequestSet.insert( groupLoad->ticket );
+
+        return groupLoad->ticket;
+#else
+        // synchronous
+        ResourceGroupManager::getSingleton().loadResourceGroup(name);
+        return 0; 
+#endif
+    }
+    //------------------------------------------------------------------------
+    Real ResourceBackgroundQueue::getProgress( BackgroundProcessTicket ticket ) const
+    {
+        ParallelGroupLoadMap::const_iterator itor = mParallelGroupLoads.find( ticket );
+        if( itor == mParallelGroupLoads.end() )
+            return 1.0f;
+
+        const ParallelGroupLoad *groupLoad = itor->second;
+        return static_cast<Real>( groupLoad->nextToLoad ) /
+                static_cast<Real>( groupLoad->resources.size() );
+    }
+    //------------------------------------------------------------------------
     BackgroundProcessTicket ResourceBackgroundQueue::prepare(
         const String& resType, const String& name, 
         const String& group, bool isManual, 
@@ -267,6 +349,15 @@ namespace Ogre {
     //------------------------------------------------------------------------
     void ResourceBackgroundQueue::abortRequest( BackgroundProcessTicket ticket )
     {
+        ParallelGroupLoadMap::const_iterator itor = mParallelGroupLoads.find( ticket );
+        if( itor != mParallelGroupLoads.end() )
+        {
+            // Aborting each request would mean searching the queues once per resource.
+            // The workers skip them instead, and the group ends in handleGroupResourceResponse
+            atomicStore( &itor->second->aborted, 1 );
+            return;
+        }
+
         WorkQueue* queue = Root::getSingleton().getWorkQueue();
 
         queue->abortRequest( ticket );
@@ -297,6 +388,37 @@ namespace Ogre {
 
         ResourceRequest resreq = any_cast<ResourceRequest>(req->getData());
 
+        if( resreq.type == RT_PREPARE_GROUP_RESOURCE )
+        {
+            // groupLoad outlives its requests, but only 'aborted' may be read from here
+            if( req->getAborted() || atomicLoad( &resreq.groupLoad->aborted ) )
+            {
+                ResourceResponse resresp(ResourcePtr(), resreq);
+                return OGRE_NEW WorkQueue::Response(req, true, Any(resresp));
+            }
+
+            ResourcePtr resource;
+            try
+            {
+                ResourceManager *rm = ResourceGroupManager::getSingleton()._getResourceManager(
+                    resreq.resourceType);
+                resource = rm->getByHandle( resreq.resourceHandle );
+                if( !resource.isNull() )
+                    resource->prepare( true );
+            }
+            catch (Exception& e)
+            {
+                resreq.result.error = true;
+                resreq.result.message = e.getFullDescription();
+                ResourceResponse resresp(resource, resreq);
+                return OGRE_NEW WorkQueue::Response(req, false, Any(resresp), e.getFullDescription());
+            }
+
+            resreq.result.error = false;
+            ResourceResponse resresp(resource, resreq);
+            return OGRE_NEW WorkQueue::Response(req, true, Any(resresp));
+        }
+
         if( req->getAborted() )
         {
             if( resreq.type == RT_PREPARE_RESOURCE || resreq.type == RT_LOAD_RESOURCE )
@@ -365,6 +487,9 @@ namespace Ogre {
                 else
                     rm->unload(resreq.resourceName);
                 break;
+            case RT_PREPARE_GROUP_RESOURCE:
+                // Handled above
+                break;
             };
         }
         catch (Exception& e)
@@ -402,6 +527,12 @@ namespace Ogre {
     //------------------------------------------------------------------------
     void ResourceBackgroundQueue::handleResponse(const WorkQueue::Response* res, const WorkQueue* srcQ)
     {
+        if( res->getRequest()->getType() == RT_PREPARE_GROUP_RESOURCE )
+        {
+            handleGroupResourceResponse( res );
+            return;
+        }
+
         if( res->getRequest()->getAborted() )
         {
             mOutstandingRequestSet.erase(res->getRequest()->getID());
@@ -449,6 +580,74 @@ namespace Ogre {
             req.listener->operationCompleted(res->getRequest()->getID(), req.result);
     }
     //------------------------------------------------------------------------
+    void ResourceBackgroundQueue::handleGroupResourceResponse( const WorkQueue::Response* res )
+    {
+        // The response's data is destroyed when the request gets aborted by the
+        // WorkQueue (i.e. abortRequestsByChannel), but the request's is still there
+        ResourceRequest req = any_cast<ResourceRequest>( res->getRequest()->getData() );
+        ParallelGroupLoad *groupLoad = req.groupLoad;
+
+        --groupLoad->numRequestsPending;
+
+        if( res->getRequest()->getAborted() )
+        {
+            // We can't finish the group without this resource
+            atomicStore( &groupLoad->aborted, 1 );
+        }
+        else
+        {
+            groupLoad->prepared[req.groupResourceIdx] = true;
+        }
+
+        if( !res->succeeded() && !groupLoad->result.error )
+        {
+            // Keep the first error. load() will try again (and log) below
+            groupLoad->result.error = true;
+            groupLoad->result.message = res->getMessages();
+        }
+
+        ResourceGroupManager &rgm = ResourceGroupManager::getSingleton();
+
+        // Load in order everything whose predecessors are loaded, so
+        // dependencies are always loaded first
+        while( !atomicLoad( &groupLoad->aborted ) &&
+               groupLoad->nextToLoad < groupLoad->resources.size() &&
+               groupLoad->prepared[groupLoad->nextToLoad] )
+        {
+            const ResourcePtr &resource = groupLoad->resources[groupLoad->nextToLoad];
+            try
+            {
+                rgm._loadResourceGroupResource( resource );
+            }
+            catch( Exception &e )
+            {
+                if( !groupLoad->result.error )
+                {
+                    groupLoad->result.error = true;
+                    groupLoad->result.message = e.getFullDescription();
+                }
+            }
+            ++groupLoad->nextToLoad;
+        }
+
+        if( groupLoad->numRequestsPending == 0 )
+        {
+            const bool completed = groupLoad->nextToLoad == groupLoad->resources.size();
+            rgm._endLoadResourceGroup( groupLoad->groupName, completed );
+
+            const BackgroundProcessTicket ticket = groupLoad->ticket;
+            Listener *listener = groupLoad->listener;
+            BackgroundProcessResult result = groupLoad->result;
+
+            mParallelGroupLoads.erase( ticket );
+            mOutstandingRequestSet.erase( ticket );
+            OGRE_DELETE_T( groupLoad, ParallelGroupLoad, MEMCATEGORY_RESOURCE );
+
+            if( listener )
+                listener->operationCompleted( ticket, result );
+        }
+    }
+    //------------------------------------------------------------------------
 
 }
 
@@ -389,6 +389,80 @@ namespace Ogre {
         LogManager::getSingleton().logMessage("Finished loading resource group " + name);
     }
     //-----------------------------------------------------------------------
+    void ResourceGroupManager::_beginLoadResourceGroup(const String& name,
+                                                       vector<ResourcePtr>::type &outResources)
+    {
+        OGRE_LOCK_AUTO_MUTEX;
+
+        LogManager::getSingleton().logMessage("Loading resource group '" + name + "' in steps");
+        ResourceGroup* grp = getResourceGroup(name);
+        if (!grp)
+        {
+            OGRE_EXCEPT(Exception::ERR_ITEM_NOT_FOUND, 
+                "Cannot find a group named " + name, 
+                "ResourceGroupManager::_beginLoadResourceGroup");
+        }
+
+        OGRE_LOCK_MUTEX(grp->OGRE_AUTO_MUTEX_NAME); // lock group mutex 
+
+        outResources.clear();
+        ResourceGroup::LoadResourceOrderMap::const_iterator oi;
+        for (oi = grp->loadResourceOrderMap.begin(); oi != grp->loadResourceOrderMap.end(); ++oi)
+            outResources.insert(outResources.end(), oi->second->begin(), oi->second->end());
+
+        size_t resourceCount = outResources.size();
+        if (grp->worldGeometrySceneManager)
+        {
+            resourceCount += 
+                grp->worldGeometrySceneManager->estimateWorldGeometry(
+                    grp->worldGeometry);
+        }
+
+        fireResourceGroupLoadStarted(name, resourceCount);
+    }
+    //-----------------------------------------------------------------------
+    void ResourceGroupManager::_loadResourceGroupResource(const ResourcePtr &resource)
+    {
+        // Fire the events even if already loaded, to match the estimated count (see loadResourceGroup)
+        fireResourceLoadStarted(resource);
+        try
+        {
+            resource->load();
+        }
+        catch( ... )
+        {
+            // Listeners pair every start with an end (i.e. loading screens)
+            fireResourceLoadEnded();
+            throw;
+        }
+        fireResourceLoadEnded();
+    }
+    //-----------------------------------------------------------------------
+    void ResourceGroupManager::_endLoadResourceGroup(const String& name, bool completed)
+    {
+        OGRE_LOCK_AUTO_MUTEX;
+
+        ResourceGroup* grp = getResourceGroup(name);
+        if (grp)
+        {
+            OGRE_LOCK_MUTEX(grp->OGRE_AUTO_MUTEX_NAME); // lock group mutex 
+            if (completed)
+            {
+                if (grp->worldGeometrySceneManager)
+                {
+                    grp->worldGeometrySceneManager->setWorldGeometry(
+                        grp->worldGeometry);
+                }
+                grp->groupStatus = ResourceGroup::LOADED;
+            }
+        }
+        fireResourceGroupLoadEnded(name);
+
+        LogManager::getSingleton().logMessage(completed ?
+            "Finished loading resource group " + name :
+            "Aborted loading resource group " + name);
+    }
+    //-----------------------------------------------------------------------
     void ResourceGroupManager::unloadResourceGroup(const String& name, bool reloadableOnly)
     {
         // Can only bulk-unload one group at a time (reasonable limitation I think)
@@ -48,6 +48,7 @@ THE SOFTWARE.
 #include "OgreArchiveManager.h"
 #include "OgrePlugin.h"
 #include "OgreFileSystem.h"
+#include "OgrePackArchive.h"
 #include "OgreResourceBackgroundQueue.h"
 #include "OgreTextureGpuManager.h"
 #include "OgreDecal.h"
@@ -238,11 +239,14 @@ namespace Ogre {
         // Profiler
         mProfiler = OGRE_NEW Profiler();
         Profiler::getSingleton().setTimer(mTimer);
+        OgreProfileThreadName( "Main" );
 #endif
 
 
         mFileSystemArchiveFactory = OGRE_NEW FileSystemArchiveFactory();
         ArchiveManager::getSingleton().addArchiveFactory( mFileSystemArchiveFactory );
+        mPackArchiveFactory = OGRE_NEW PackArchiveFactory();
+        ArchiveManager::getSingleton().addArchiveFactory( mPackArchiveFactory );
 #   if OGRE_NO_ZIP_ARCHIVE == 0
         mZipArchiveFactory = OGRE_NEW ZipArchiveFactory();
         ArchiveManager::getSingleton().addArchiveFactory( mZipArchiveFactory );
@@ -377,6 +381,7 @@ namespace Ogre {
         OGRE_DELETE mEmbeddedZipArchiveFactory;
 #   endif
         OGRE_DELETE mFileSystemArchiveFactory;
+        OGRE_DELETE mPackArchiveFactory;
 
         OGRE_DELETE mOldSkeletonManager;
         OGRE_DELETE mSkeletonManager;
@@ -787,6 +792,18 @@ namespace Ogre {
 
 
         PlatformInformation::log(LogManager::getSingleton().getDefaultLog());
+#if __OGRE_HAVE_AVX2
+        // The compiler is free to emit AVX instructions anywhere, so we may never get here
+        // on an older CPU. But if we do, better to fail with a meaningful message.
+        if( !PlatformInformation::hasCpuFeature( PlatformInformation::CPU_FEATURE_AVX2 ) ||
+            !PlatformInformation::hasCpuFeature( PlatformInformation::CPU_FEATURE_FMA ) )
+        {
+            OGRE_EXCEPT( Exception::ERR_NOT_IMPLEMENTED,
+                         "Ogre was built with OGRE_SIMD_AVX2 but this CPU (or OS) does not "
+                         "support AVX2 + FMA. Rebuild Ogre with OGRE_SIMD_SSE2 instead.",
+                         "Root::initialise" );
+        }
+#endif
         mAutoWindow = mActiveRenderer->_initialise( autoCreateWindow, windowTitle );
 
 
@@ -1003,7 +1020,12 @@ namespace Ogre {
             OgreProfileGpuEnd( frameNum.c_str() );
             OgreProfileEndGroup( frameNum.c_str(), OGREPROF_GENERAL );
         }
+
+        OgreProfileCounter( "Draw calls", mActiveRenderer->getFrameMetrics().mDrawCount );
+        OgreProfileCounter( "PSO switches", mActiveRenderer->getFrameMetrics().mPsoSwitchCount );
+        OgreProfileFrameMark();
 #endif
+        mActiveRenderer->_resetFrameMetrics();
 
         return ret;
     }
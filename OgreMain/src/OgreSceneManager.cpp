@@ -57,9 +57,11 @@ THE SOFTWARE.
 #include "OgreParticleSystemManager.h"
 #include "OgreParticleSystem.h"
 #include "OgreProfiler.h"
+#include "OgreLwString.h"
 #include "OgreTextureGpuManager.h"
 #include "OgreSceneNode.h"
 #include "OgreRadialDensityMask.h"
+#include "OgreOcclusionCuller.h"
 #include "OgreRectangle2D2.h"
 #include "OgreLodListener.h"
 #include "OgreOldNode.h"
@@ -97,6 +99,8 @@ mNumDecals( 0 ),
 mNumCubemapProbes( 0 ),
 mStaticMinDepthLevelDirty( 0 ),
 mStaticEntitiesDirty( true ),
+mIncrementalBoundsUpdate( false ),
+mCullingHierarchyEnabled( false ),
 mPrePassMode( PrePassNone ),
 mSsrTexture( 0 ),
 mRefractionsTexture( 0 ),
@@ -116,6 +120,8 @@ mShadowNodeIsReused( false ),
 mSkyMethod( SkyCubemap ),
 mSky( 0 ),
 mRadialDensityMask( 0 ),
+mOcclusionCuller( 0 ),
+mAnimationLodCamera( 0 ),
 mFogMode(FOG_NONE),
 mFogColour(),
 mFogStart(0),
@@ -145,10 +151,13 @@ mLightMask(0xFFFFFFFF),
 mFindVisibleObjects(true),
 mNumWorkerThreads( std::max<size_t>( numWorkerThreads, 1u ) ),
 mForceMainThread( numWorkerThreads == 0u ? true : false ),
-mUpdateBoundsRequest( 0 ),
+mRequestTask( this ),
+mCurrentTaskGraph( 0 ),
 mUserTask( 0 ),
 mRequestType( NUM_REQUESTS ),
 mWorkerThreadsBarrier( 0 ),
+mNextPendingParticleSystem( 0 ),
+mParallelParticleSystemUpdates( false ),
 mSuppressRenderStateChanges(false),
 mLastLightHash(0),
 mLastLightLimit(0),
@@ -184,6 +193,9 @@ mGpuParamsDirty((uint16)GPV_ALL)
     mBuildLightListRequestPerThread.resize( mNumWorkerThreads );
     mVisibleObjects.resize( mNumWorkerThreads );
     mTmpVisibleObjects.resize( mNumWorkerThreads );
+    mVisibleBlocksPerThread.resize( mNumWorkerThreads );
+
+    mOcclusionCuller = OGRE_NEW OcclusionCuller();
 
     startWorkerThreads();
 
@@ -246,6 +258,10 @@ SceneManager::~SceneManager()
     clearScene( true, false );
     destroyAllCameras();
 
+    //Must be deleted after clearScene, which destroys the occluders
+    OGRE_DELETE mOcclusionCuller;
+    mOcclusionCuller = 0;
+
     // clear down movable object collection map
     {
             OGRE_LOCK_MUTEX(mMovableObjectCollectionMapMutex);
@@ -357,6 +373,9 @@ void SceneManager::destroyCamera(Camera *cam)
             efficientVectorRemove( mCubeMapCameras, it );
     }
 
+    if( mAnimationLodCamera == cam )
+        mAnimationLodCamera = 0;
+
     IdString camName( cam->getName() );
 
     // Find in list
@@ -763,6 +782,7 @@ void SceneManager::destroyAllParticleSystems(void)
 //-----------------------------------------------------------------------
 void SceneManager::clearScene( bool deleteIndestructibleToo, bool reattachCameras )
 {
+    mOcclusionCuller->destroyAllOccluders();
     destroyAllStaticGeometry();
     destroyAllMovableObjects();
 
@@ -1319,6 +1339,14 @@ void SceneManager::_cullPhase01( Camera *cullCamera, Camera *renderCamera, const
             CullFrustumRequest cullRequest( realFirstRq, realLastRq,
                                             mIlluminationStage == IRS_RENDER_TO_TEXTURE, true, false,
                                             &mEntitiesMemoryManagerCulledList, cullCamera, lodCamera );
+
+            if( mIlluminationStage != IRS_RENDER_TO_TEXTURE && mOcclusionCuller->isActive() )
+            {
+                OgreProfileGroup( "Occluder rasterization", OGREPROF_CULLING );
+                mOcclusionCuller->rasterizeOccluders( cullCamera, this );
+                cullRequest.occlusionCuller = mOcclusionCuller;
+            }
+
             fireCullFrustumThreads( cullRequest );
         }
     } // end lock on scene graph mutex
@@ -1636,6 +1664,38 @@ void SceneManager::updateAllAnimationsThread( size_t threadIdx )
                 ++itor;
             }
 
+            ++itByDef;
+        }
+
+        ++it;
+    }
+}
+//-----------------------------------------------------------------------
+void SceneManager::updateAllAnimationTransformsThread( size_t threadIdx )
+{
+    SkeletonAnimManagerVec::const_iterator it = mSkeletonAnimManagerCulledList.begin();
+    SkeletonAnimManagerVec::const_iterator en = mSkeletonAnimManagerCulledList.end();
+
+    while( it != en )
+    {
+        SkeletonAnimManager::BySkeletonDefList::iterator itByDef = (*it)->bySkeletonDefs.begin();
+        SkeletonAnimManager::BySkeletonDefList::iterator enByDef = (*it)->bySkeletonDefs.end();
+
+        while( itByDef != enByDef )
+        {
+            if( !itByDef->sharedPoseKeys.empty() )
+            {
+                FastArray<SkeletonInstance*>::iterator itor = itByDef->skeletons.begin() +
+                                                                        itByDef->threadStarts[threadIdx];
+                FastArray<SkeletonInstance*>::iterator end  = itByDef->skeletons.begin() +
+                                                                        itByDef->threadStarts[threadIdx+1];
+                while( itor != end )
+                {
+                    (*itor)->_copySharedPose();
+                    ++itor;
+                }
+            }
+
             if( !itByDef->skeletons.empty() )
                 updateAnimationTransforms( *itByDef, threadIdx );
 
@@ -1695,10 +1755,86 @@ void SceneManager::updateAnimationTransforms( BySkeletonDef &bySkeletonDef, size
     }
 }
 //-----------------------------------------------------------------------
+void SceneManager::prepareAllAnimations(void)
+{
+    SkeletonAnimManagerVec::const_iterator it = mSkeletonAnimManagerCulledList.begin();
+    SkeletonAnimManagerVec::const_iterator en = mSkeletonAnimManagerCulledList.end();
+
+    while( it != en )
+    {
+        if( (*it)->lodStrategy )
+            (*it)->_updateAnimationLod( mAnimationLodCamera );
+        (*it)->_updateSharedAnimations();
+        ++it;
+    }
+}
+//-----------------------------------------------------------------------
 void SceneManager::updateAllAnimations()
 {
+    prepareAllAnimations();
+
     mRequestType = UPDATE_ALL_ANIMATIONS;
     fireWorkerThreadsAndWait();
+
+    mRequestType = UPDATE_ALL_ANIMATION_TRANSFORMS;
+    fireWorkerThreadsAndWait();
+}
+//-----------------------------------------------------------------------
+void SceneManager::setAnimationLod( const LodStrategy *lodStrategy,
+                                    const AnimationLodLevelVec &levels )
+{
+    mSkeletonAnimationManager.setAnimationLod( lodStrategy, levels );
+}
+//-----------------------------------------------------------------------
+void SceneManager::updateAllParticleSystemsThread( size_t threadIdx )
+{
+    bool bDone = false;
+    while( !bDone )
+    {
+        mPendingParticleSystemsMutex.lock();
+        const size_t idx = mNextPendingParticleSystem++;
+        mPendingParticleSystemsMutex.unlock();
+
+        if( idx < mPendingParticleSystems.size() )
+            mPendingParticleSystems[idx]->_updatePending();
+        else
+            bDone = true;
+    }
+}
+//-----------------------------------------------------------------------
+void SceneManager::updateAllParticleSystems()
+{
+    if( mPendingParticleSystems.empty() )
+        return;
+
+    OgreProfile( "SceneManager::updateAllParticleSystems" );
+
+    mNextPendingParticleSystem = 0;
+    mRequestType = UPDATE_ALL_PARTICLE_SYSTEMS;
+    fireWorkerThreadsAndWait();
+
+    mPendingParticleSystems.clear();
+}
+//-----------------------------------------------------------------------
+void SceneManager::setParallelParticleSystemUpdates( bool bParallel )
+{
+    //Don't leave anything behind
+    if( !bParallel )
+        updateAllParticleSystems();
+    mParallelParticleSystemUpdates = bParallel;
+}
+//-----------------------------------------------------------------------
+void SceneManager::_queueParticleSystemUpdate( ParticleSystem *particleSystem )
+{
+    mPendingParticleSystems.push_back( particleSystem );
+}
+//-----------------------------------------------------------------------
+void SceneManager::_dequeueParticleSystemUpdate( ParticleSystem *particleSystem )
+{
+    ParticleSystemVec::iterator itor = std::find( mPendingParticleSystems.begin(),
+                                                  mPendingParticleSystems.end(), particleSystem );
+    if( itor != mPendingParticleSystems.end() )
+        efficientVectorRemove( mPendingParticleSystems, itor );
 }
 //-----------------------------------------------------------------------
 void SceneManager::updateAllTransformsThread( const UpdateTransformRequest &request, size_t threadIdx )
@@ -1717,42 +1853,29 @@ void SceneManager::updateAllTransformsThread( const UpdateTransformRequest &requ
 //-----------------------------------------------------------------------
 void SceneManager::updateAllTransforms()
 {
-    mRequestType = UPDATE_ALL_TRANSFORMS;
+    resetSceneGraphTasks( getMaxSceneGraphTasks() );
+
     NodeMemoryManagerVec::const_iterator it = mNodeMemoryManagerUpdateList.begin();
     NodeMemoryManagerVec::const_iterator en = mNodeMemoryManagerUpdateList.end();
 
     while( it != en )
     {
         NodeMemoryManager *nodeMemoryManager = *it;
-        const size_t numDepths = nodeMemoryManager->getNumDepths();
 
         size_t start = nodeMemoryManager->getMemoryManagerType() == SCENE_STATIC ?
                                                     mStaticMinDepthLevelDirty : 0;
 
-        //Start from the zeroth level (root) unless static (start from first dirty)
-        for( size_t i=start; i<numDepths; ++i )
-        {
-            Transform t;
-            const size_t numNodes = nodeMemoryManager->getFirstNode( t, i );
-
-            //nodesPerThread must be multiple of ARRAY_PACKED_REALS
-            size_t nodesPerThread = ( numNodes + (mNumWorkerThreads-1) ) / mNumWorkerThreads;
-            nodesPerThread        = ( (nodesPerThread + ARRAY_PACKED_REALS - 1) / ARRAY_PACKED_REALS ) *
-                                    ARRAY_PACKED_REALS;
-
-            if( numNodes )
-            {
-                //Send them to worker threads. We need to go depth by depth because
-                //we may depend on parents which could be processed by different threads.
-                mUpdateTransformRequest = UpdateTransformRequest( t, nodesPerThread, numNodes );
-                fireWorkerThreadsAndWait();
-                //Node::updateAllTransforms( numNodes, t );
-            }
-        }
+        //Start from the zeroth level (root) unless static (start from first dirty).
+        //Each memory manager is independent from the others, thus only the depth
+        //levels within the same manager need to wait for each other.
+        addTransformTasks( nodeMemoryManager, start, UPDATE_ALL_TRANSFORMS,
+                           TaskGraph::INVALID_TASK_ID );
 
         ++it;
     }
 
+    executeTaskGraph( &mSceneGraphTaskGraph );
+
     //Call all listeners
     SceneNodeList::const_iterator itor = mSceneNodesWithListeners.begin();
     SceneNodeList::const_iterator end  = mSceneNodesWithListeners.end();
@@ -1766,39 +1889,9 @@ void SceneManager::updateAllTransforms()
 //-----------------------------------------------------------------------
 void SceneManager::updateAllTagPoints()
 {
-    NodeMemoryManagerVec::const_iterator it = mTagPointNodeMemoryManagerUpdateList.begin();
-    NodeMemoryManagerVec::const_iterator en = mTagPointNodeMemoryManagerUpdateList.end();
-
-    while( it != en )
-    {
-        NodeMemoryManager *nodeMemoryManager = *it;
-        const size_t numDepths = nodeMemoryManager->getNumDepths();
-
-        //Start from the first level (not root) unless static (start from first dirty)
-        for( size_t i=0; i<numDepths; ++i )
-        {
-            mRequestType = i == 0 ? UPDATE_ALL_BONE_TO_TAG_TRANSFORMS :
-                                    UPDATE_ALL_TAG_ON_TAG_TRANSFORMS;
-
-            Transform t;
-            const size_t numNodes = nodeMemoryManager->getFirstNode( t, i );
-
-            //nodesPerThread must be multiple of ARRAY_PACKED_REALS
-            size_t nodesPerThread = ( numNodes + (mNumWorkerThreads-1) ) / mNumWorkerThreads;
-            nodesPerThread        = ( (nodesPerThread + ARRAY_PACKED_REALS - 1) / ARRAY_PACKED_REALS ) *
-                                    ARRAY_PACKED_REALS;
-
-            if( numNodes )
-            {
-                //Send them to worker threads. We need to go depth by depth because
-                //we may depend on parents which could be processed by different threads.
-                mUpdateTransformRequest = UpdateTransformRequest( t, nodesPerThread, numNodes );
-                fireWorkerThreadsAndWait();
-            }
-        }
-
-        ++it;
-    }
+    resetSceneGraphTasks( getMaxSceneGraphTasks() );
+    addTagPointTasks( TaskGraph::INVALID_TASK_ID );
+    executeTaskGraph( &mSceneGraphTaskGraph );
 }
 //-----------------------------------------------------------------------
 void SceneManager::updateAllTransformsBoneToTagThread( const UpdateTransformRequest &request,
@@ -1831,8 +1924,55 @@ void SceneManager::updateAllTransformsTagOnTagThread( const UpdateTransformReque
     TagPoint::updateAllTransformsTagOnTag( numNodes, t );
 }
 //-----------------------------------------------------------------------
-void SceneManager::updateAllBoundsThread( const ObjectMemoryManagerVec &objectMemManager, size_t threadIdx )
+void SceneManager::updateBoundsSlice( ObjectMemoryManager *memoryManager,
+                                      size_t sliceIdx, size_t numSlices )
 {
+    const size_t numRenderQueues = memoryManager->getNumRenderQueues();
+    const bool incremental = mIncrementalBoundsUpdate &&
+                             memoryManager->getMemoryManagerType() != SCENE_STATIC;
+
+    //The culling hierarchy needs each slice to own whole groups of blocks
+    const size_t granularity = mCullingHierarchyEnabled ?
+                                   ARRAY_PACKED_REALS * CullingHierarchy::BranchingFactor :
+                                   ARRAY_PACKED_REALS;
+
+    for( size_t i=0; i<numRenderQueues; ++i )
+    {
+        ObjectData objData;
+        const size_t totalObjs = memoryManager->getFirstObjectData( objData, i );
+
+        //Distribute the work evenly across all slices (not perfect), taking into
+        //account we need to distribute in multiples of granularity
+        size_t numObjs  = ( totalObjs + (numSlices-1) ) / numSlices;
+        numObjs         = ( (numObjs + granularity - 1) / granularity ) * granularity;
+
+        const size_t toAdvance = std::min( sliceIdx * numObjs, totalObjs );
+
+        //Prevent going out of bounds (usually in the last sliceIdx, or
+        //when there are less entities than ARRAY_PACKED_REALS
+        numObjs = std::min( numObjs, totalObjs - toAdvance );
+        objData.advancePack( toAdvance / ARRAY_PACKED_REALS );
+
+        if( incremental )
+            MovableObject::updateDirtyBounds( numObjs, objData );
+        else
+            MovableObject::updateAllBounds( numObjs, objData );
+
+        if( mCullingHierarchyEnabled && numObjs )
+        {
+            const size_t numBlocks = ( numObjs + ARRAY_PACKED_REALS - 1 ) / ARRAY_PACKED_REALS;
+            memoryManager->_getCullingHierarchy( i )._updateBlocks(
+                        objData, toAdvance / ARRAY_PACKED_REALS, numBlocks,
+                        memoryManager->_getDummyObject() );
+        }
+    }
+}
+//-----------------------------------------------------------------------
+void SceneManager::updateCullingHierarchies( const ObjectMemoryManagerVec &objectMemManager )
+{
+    if( !mCullingHierarchyEnabled )
+        return;
+
     ObjectMemoryManagerVec::const_iterator it = objectMemManager.begin();
     ObjectMemoryManagerVec::const_iterator en = objectMemManager.end();
 
@@ -1840,37 +1980,326 @@ void SceneManager::updateAllBoundsThread( const ObjectMemoryManagerVec &objectMe
     {
         ObjectMemoryManager *memoryManager = *it;
         const size_t numRenderQueues = memoryManager->getNumRenderQueues();
-
         for( size_t i=0; i<numRenderQueues; ++i )
+            memoryManager->_getCullingHierarchy( i )._updateUpperLevels();
+        ++it;
+    }
+}
+//-----------------------------------------------------------------------
+void SceneManager::setCullingHierarchyEnabled( bool bEnabled )
+{
+    if( bEnabled && !mCullingHierarchyEnabled )
+    {
+        //Hierarchies are not maintained while disabled. Rebuild them all, including
+        //static objects (the dynamic ones are rebuilt every frame anyway)
+        ObjectMemoryManager *memoryManagers[] =
         {
-            ObjectData objData;
-            const size_t totalObjs = memoryManager->getFirstObjectData( objData, i );
+            &mEntityMemoryManager[SCENE_DYNAMIC], &mEntityMemoryManager[SCENE_STATIC],
+            &mForwardPlusMemoryManager[SCENE_DYNAMIC], &mForwardPlusMemoryManager[SCENE_STATIC],
+            &mLightMemoryManager
+        };
 
-            //Distribute the work evenly across all threads (not perfect), taking into
-            //account we need to distribute in multiples of ARRAY_PACKED_REALS
-            size_t numObjs  = ( totalObjs + (mNumWorkerThreads-1) ) / mNumWorkerThreads;
-            numObjs         = ( (numObjs + ARRAY_PACKED_REALS - 1) / ARRAY_PACKED_REALS ) *
-                                ARRAY_PACKED_REALS;
+        for( size_t i=0; i<sizeof( memoryManagers ) / sizeof( memoryManagers[0] ); ++i )
+        {
+            const size_t numRenderQueues = memoryManagers[i]->_getTotalRenderQueues();
+            for( size_t j=0; j<numRenderQueues; ++j )
+                memoryManagers[i]->_getCullingHierarchy( j )._invalidate();
+        }
 
-            const size_t toAdvance = std::min( threadIdx * numObjs, totalObjs );
+        mStaticEntitiesDirty = true;
+    }
 
-            //Prevent going out of bounds (usually in the last threadIdx, or
-            //when there are less entities than ARRAY_PACKED_REALS
-            numObjs = std::min( numObjs, totalObjs - toAdvance );
-            objData.advancePack( toAdvance / ARRAY_PACKED_REALS );
+    mCullingHierarchyEnabled = bEnabled;
+}
+//-----------------------------------------------------------------------
+void SceneManager::updateAllBounds( const ObjectMemoryManagerVec &objectMemManager )
+{
+    resetSceneGraphTasks( objectMemManager.size() );
 
-            MovableObject::updateAllBounds( numObjs, objData );
+    ObjectMemoryManagerVec::const_iterator it = objectMemManager.begin();
+    ObjectMemoryManagerVec::const_iterator en = objectMemManager.end();
+
+    while( it != en )
+        addBoundsTask( *it++ );
+
+    executeTaskGraph( &mSceneGraphTaskGraph );
+    updateCullingHierarchies( objectMemManager );
+}
+//-----------------------------------------------------------------------
+void SceneManager::updateAllTransformsAndBounds(void)
+{
+    if( !mSceneNodesWithListeners.empty() )
+    {
+        //Listeners must be called right after updating the
+        //transforms, before anything else gets updated.
+        updateAllTransforms();
+        updateAllAnimations();
+        updateAllTagPoints();
+        updateAllBounds( mEntitiesMemoryManagerUpdateList );
+        updateAllBounds( mLightsMemoryManagerCulledList );
+        clearNodeDirtyFlags();
+        return;
+    }
+
+    resetSceneGraphTasks( getMaxSceneGraphTasks() );
+
+    TaskGraph::TaskId lastTransformTask[NUM_SCENE_MEMORY_MANAGER_TYPES];
+    for( size_t i=0; i<NUM_SCENE_MEMORY_MANAGER_TYPES; ++i )
+        lastTransformTask[i] = TaskGraph::INVALID_TASK_ID;
+
+    {
+        NodeMemoryManagerVec::const_iterator it = mNodeMemoryManagerUpdateList.begin();
+        NodeMemoryManagerVec::const_iterator en = mNodeMemoryManagerUpdateList.end();
+
+        while( it != en )
+        {
+            NodeMemoryManager *nodeMemoryManager = *it;
+            const SceneMemoryMgrTypes memoryManagerType = nodeMemoryManager->getMemoryManagerType();
+
+            size_t start = memoryManagerType == SCENE_STATIC ? mStaticMinDepthLevelDirty : 0;
+            lastTransformTask[memoryManagerType] =
+                    addTransformTasks( nodeMemoryManager, start, UPDATE_ALL_TRANSFORMS,
+                                       lastTransformTask[memoryManagerType] );
+            ++it;
         }
+    }
 
+    //The animation LOD needs the derived transforms of the objects and the LOD camera
+    mSceneGraphTasks.push_back( SceneGraphTask() );
+    SceneGraphTask &prepareAnimationsTask = mSceneGraphTasks.back();
+    prepareAnimationsTask.sceneManager  = this;
+    prepareAnimationsTask.requestType   = PREPARE_ALL_ANIMATIONS;
+    const TaskGraph::TaskId prepareAnimationsTaskId =
+            mSceneGraphTaskGraph.addTask( &prepareAnimationsTask, 1u );
+    for( size_t i=0; i<NUM_SCENE_MEMORY_MANAGER_TYPES; ++i )
+        mSceneGraphTaskGraph.addDependency( prepareAnimationsTaskId, lastTransformTask[i] );
+
+    //Skeletons may belong to both static and dynamic objects. Animations
+    //use one slice per thread because they're split via BySkeletonDef::threadStarts
+    mSceneGraphTasks.push_back( SceneGraphTask() );
+    SceneGraphTask &animationTask = mSceneGraphTasks.back();
+    animationTask.sceneManager  = this;
+    animationTask.requestType   = UPDATE_ALL_ANIMATIONS;
+    const TaskGraph::TaskId animationTaskId =
+            mSceneGraphTaskGraph.addTask( &animationTask, mNumWorkerThreads );
+    mSceneGraphTaskGraph.addDependency( animationTaskId, prepareAnimationsTaskId );
+
+    //Shared poses are copied from instances that may be sampled by any slice
+    mSceneGraphTasks.push_back( SceneGraphTask() );
+    SceneGraphTask &animationTransformsTask = mSceneGraphTasks.back();
+    animationTransformsTask.sceneManager    = this;
+    animationTransformsTask.requestType     = UPDATE_ALL_ANIMATION_TRANSFORMS;
+    const TaskGraph::TaskId animationTransformsTaskId =
+            mSceneGraphTaskGraph.addTask( &animationTransformsTask, mNumWorkerThreads );
+    mSceneGraphTaskGraph.addDependency( animationTransformsTaskId, animationTaskId );
+
+    //Dynamic objects may be attached to bones and TagPoints; thus they depend on everything.
+    const TaskGraph::TaskId lastDynamicTask = addTagPointTasks( animationTransformsTaskId );
+
+    {
+        ObjectMemoryManagerVec::const_iterator it = mEntitiesMemoryManagerUpdateList.begin();
+        ObjectMemoryManagerVec::const_iterator en = mEntitiesMemoryManagerUpdateList.end();
+
+        while( it != en )
+        {
+            ObjectMemoryManager *objectMemoryManager = *it;
+            const TaskGraph::TaskId boundsTaskId = addBoundsTask( objectMemoryManager );
+
+            //Static objects can only be attached to static nodes.
+            if( objectMemoryManager->getMemoryManagerType() == SCENE_STATIC )
+                mSceneGraphTaskGraph.addDependency( boundsTaskId, lastTransformTask[SCENE_STATIC] );
+            else
+                mSceneGraphTaskGraph.addDependency( boundsTaskId, lastDynamicTask );
+            ++it;
+        }
+    }
+
+    {
+        ObjectMemoryManagerVec::const_iterator it = mLightsMemoryManagerCulledList.begin();
+        ObjectMemoryManagerVec::const_iterator en = mLightsMemoryManagerCulledList.end();
+
+        while( it != en )
+        {
+            const TaskGraph::TaskId boundsTaskId = addBoundsTask( *it );
+            mSceneGraphTaskGraph.addDependency( boundsTaskId, lastTransformTask[SCENE_STATIC] );
+            mSceneGraphTaskGraph.addDependency( boundsTaskId, lastDynamicTask );
+            ++it;
+        }
+    }
+
+    executeTaskGraph( &mSceneGraphTaskGraph );
+    updateCullingHierarchies( mEntitiesMemoryManagerUpdateList );
+    updateCullingHierarchies( mLightsMemoryManagerCulledList );
+    clearNodeDirtyFlags();
+}
+//-----------------------------------------------------------------------
+void SceneManager::clearNodeDirtyFlags(void)
+{
+    //Both the transforms and the bounds have seen the flags by now.
+    //Memory managers not in the update list keep their flags until they are.
+    NodeMemoryManagerVec::const_iterator it = mNodeMemoryManagerUpdateList.begin();
+    NodeMemoryManagerVec::const_iterator en = mNodeMemoryManagerUpdateList.end();
+
+    while( it != en )
+    {
+        (*it)->_clearDirtyFlags();
         ++it;
     }
 }
 //-----------------------------------------------------------------------
-void SceneManager::updateAllBounds( const ObjectMemoryManagerVec &objectMemManager )
+size_t SceneManager::calculateNumSlices( size_t numElements ) const
 {
-    mUpdateBoundsRequest    = &objectMemManager;
-    mRequestType            = UPDATE_ALL_BOUNDS;
-    fireWorkerThreadsAndWait();
+    //Split the work in more slices than threads so that idle threads can steal
+    //from busy ones, but don't make the slices so small the overhead dominates.
+    const size_t c_slicesPerThread      = 4u;
+    const size_t c_minElementsPerSlice  = ARRAY_PACKED_REALS * 64u;
+
+    size_t numSlices = ( numElements + c_minElementsPerSlice - 1u ) / c_minElementsPerSlice;
+    numSlices = std::min( numSlices, mNumWorkerThreads * c_slicesPerThread );
+    return std::max<size_t>( numSlices, 1u );
+}
+//-----------------------------------------------------------------------
+TaskGraph::TaskId SceneManager::addTransformTasks( NodeMemoryManager *nodeMemoryManager,
+                                                   size_t firstDepth, RequestType requestType,
+                                                   TaskGraph::TaskId dependsOn )
+{
+    TaskGraph::TaskId lastTaskId = dependsOn;
+
+    const size_t numDepths = nodeMemoryManager->getNumDepths();
+    for( size_t i=firstDepth; i<numDepths; ++i )
+    {
+        Transform t;
+        const size_t numNodes = nodeMemoryManager->getFirstNode( t, i );
+
+        if( numNodes )
+        {
+            //We need to go depth by depth because we may depend on
+            //parents which could be processed by different slices.
+            mSceneGraphTasks.push_back( SceneGraphTask() );
+            SceneGraphTask &task = mSceneGraphTasks.back();
+            task.sceneManager   = this;
+            task.requestType    = requestType;
+            task.t              = t;
+
+            //Only the first level of TagPoints are children of bones
+            if( requestType == UPDATE_ALL_BONE_TO_TAG_TRANSFORMS && i != 0 )
+                task.requestType = UPDATE_ALL_TAG_ON_TAG_TRANSFORMS;
+            task.numNodes       = numNodes;
+
+            const TaskGraph::TaskId taskId =
+                    mSceneGraphTaskGraph.addTask( &task, calculateNumSlices( numNodes ) );
+            mSceneGraphTaskGraph.addDependency( taskId, lastTaskId );
+            lastTaskId = taskId;
+        }
+    }
+
+    return lastTaskId;
+}
+//-----------------------------------------------------------------------
+TaskGraph::TaskId SceneManager::addTagPointTasks( TaskGraph::TaskId dependsOn )
+{
+    TaskGraph::TaskId lastTaskId = dependsOn;
+
+    NodeMemoryManagerVec::const_iterator it = mTagPointNodeMemoryManagerUpdateList.begin();
+    NodeMemoryManagerVec::const_iterator en = mTagPointNodeMemoryManagerUpdateList.end();
+
+    while( it != en )
+    {
+        lastTaskId = addTransformTasks( *it, 0, UPDATE_ALL_BONE_TO_TAG_TRANSFORMS, lastTaskId );
+        ++it;
+    }
+
+    return lastTaskId;
+}
+//-----------------------------------------------------------------------
+TaskGraph::TaskId SceneManager::addBoundsTask( ObjectMemoryManager *objectMemoryManager )
+{
+    size_t totalObjs = 0;
+    const size_t numRenderQueues = objectMemoryManager->getNumRenderQueues();
+    for( size_t i=0; i<numRenderQueues; ++i )
+    {
+        ObjectData objData;
+        const size_t numObjs = objectMemoryManager->getFirstObjectData( objData, i );
+        totalObjs = std::max( totalObjs, numObjs );
+
+        //Must be done before any slice runs, they're all writing to it
+        if( mCullingHierarchyEnabled )
+            objectMemoryManager->_getCullingHierarchy( i )._resize( numObjs );
+    }
+
+    mSceneGraphTasks.push_back( SceneGraphTask() );
+    SceneGraphTask &task = mSceneGraphTasks.back();
+    task.sceneManager           = this;
+    task.requestType            = UPDATE_ALL_BOUNDS;
+    task.objectMemoryManager    = objectMemoryManager;
+
+    return mSceneGraphTaskGraph.addTask( &task, calculateNumSlices( totalObjs ) );
+}
+//-----------------------------------------------------------------------
+size_t SceneManager::getMaxSceneGraphTasks(void) const
+{
+    size_t numTasks = 3u; //Animation preparation, sampling & transforms
+
+    NodeMemoryManagerVec::const_iterator it = mNodeMemoryManagerUpdateList.begin();
+    NodeMemoryManagerVec::const_iterator en = mNodeMemoryManagerUpdateList.end();
+    while( it != en )
+        numTasks += (*it++)->getNumDepths();
+
+    it = mTagPointNodeMemoryManagerUpdateList.begin();
+    en = mTagPointNodeMemoryManagerUpdateList.end();
+    while( it != en )
+        numTasks += (*it++)->getNumDepths();
+
+    numTasks += mEntitiesMemoryManagerUpdateList.size();
+    numTasks += mLightsMemoryManagerCulledList.size();
+
+    return numTasks;
+}
+//-----------------------------------------------------------------------
+void SceneManager::resetSceneGraphTasks( size_t numTasks )
+{
+    mSceneGraphTaskGraph.clear();
+    mSceneGraphTasks.clear();
+    mSceneGraphTasks.reserve( numTasks );
+}
+//-----------------------------------------------------------------------
+void SceneManager::SceneGraphTask::execute( size_t sliceIdx, size_t numSlices )
+{
+    switch( requestType )
+    {
+    case UPDATE_ALL_TRANSFORMS:
+    case UPDATE_ALL_BONE_TO_TAG_TRANSFORMS:
+    case UPDATE_ALL_TAG_ON_TAG_TRANSFORMS:
+    {
+        //nodesPerSlice must be multiple of ARRAY_PACKED_REALS
+        size_t nodesPerSlice = ( numNodes + (numSlices-1) ) / numSlices;
+        nodesPerSlice        = ( (nodesPerSlice + ARRAY_PACKED_REALS - 1) / ARRAY_PACKED_REALS ) *
+                               ARRAY_PACKED_REALS;
+        const UpdateTransformRequest request( t, nodesPerSlice, numNodes );
+
+        if( requestType == UPDATE_ALL_TRANSFORMS )
+            sceneManager->updateAllTransformsThread( request, sliceIdx );
+        else if( requestType == UPDATE_ALL_BONE_TO_TAG_TRANSFORMS )
+            sceneManager->updateAllTransformsBoneToTagThread( request, sliceIdx );
+        else
+            sceneManager->updateAllTransformsTagOnTagThread( request, sliceIdx );
+        break;
+    }
+    case UPDATE_ALL_ANIMATIONS:
+        sceneManager->updateAllAnimationsThread( sliceIdx );
+        break;
+    case PREPARE_ALL_ANIMATIONS:
+        sceneManager->prepareAllAnimations();
+        break;
+    case UPDATE_ALL_ANIMATION_TRANSFORMS:
+        sceneManager->updateAllAnimationTransformsThread( sliceIdx );
+        break;
+    case UPDATE_ALL_BOUNDS:
+        sceneManager->updateBoundsSlice( objectMemoryManager, sliceIdx, numSlices );
+        break;
+    default:
+        break;
+    }
 }
 //-----------------------------------------------------------------------
 void SceneManager::updateAllLodsThread( const UpdateLodRequest &request, size_t threadIdx )
@@ -1950,6 +2379,9 @@ void SceneManager::cullFrustum( const CullFrustumRequest &request, size_t thread
                  (camera->getLastViewport()->getVisibilityMask() &
                                     ~VisibilityFlags::RESERVED_VISIBILITY_FLAGS));
 
+    CullingHierarchy::BlockRangeArray &visibleBlocks = mVisibleBlocksPerThread[threadIdx];
+    const Frustum *cameraFrustum = camera;
+
     ObjectMemoryManagerVec::const_iterator it = request.objectMemManager->begin();
     ObjectMemoryManagerVec::const_iterator en = request.objectMemManager->end();
 
@@ -1981,8 +2413,41 @@ void SceneManager::cullFrustum( const CullFrustumRequest &request, size_t thread
             numObjs = std::min( numObjs, totalObjs - toAdvance );
             objData.advancePack( toAdvance / ARRAY_PACKED_REALS );
 
-            MovableObject::cullFrustum( numObjs, objData, camera, visibilityMask,
-                                        outVisibleObjects, lodCamera );
+            const size_t prevNumVisibleObjs = outVisibleObjects.size();
+
+            const CullingHierarchy &cullingHierarchy = memoryManager->_getCullingHierarchy( i );
+            if( mCullingHierarchyEnabled && cullingHierarchy.isBuilt() )
+            {
+                //Only cull the blocks whose group wasn't rejected as a whole.
+                const size_t firstBlock = toAdvance / ARRAY_PACKED_REALS;
+                visibleBlocks.clear();
+                cullingHierarchy.collectVisibleBlocks(
+                            firstBlock, (numObjs + ARRAY_PACKED_REALS - 1) / ARRAY_PACKED_REALS,
+                            &cameraFrustum, 1u, 0, 0u, visibleBlocks );
+
+                CullingHierarchy::BlockRangeArray::const_iterator itRange = visibleBlocks.begin();
+                CullingHierarchy::BlockRangeArray::const_iterator enRange = visibleBlocks.end();
+
+                while( itRange != enRange )
+                {
+                    const size_t objOffset = (itRange->firstBlock - firstBlock) * ARRAY_PACKED_REALS;
+                    ObjectData rangeObjData = objData;
+                    rangeObjData.advancePack( itRange->firstBlock - firstBlock );
+                    MovableObject::cullFrustum( std::min( itRange->numBlocks * ARRAY_PACKED_REALS,
+                                                          numObjs - objOffset ),
+                                                rangeObjData, camera, visibilityMask,
+                                                outVisibleObjects, lodCamera );
+                    ++itRange;
+                }
+            }
+            else
+            {
+                MovableObject::cullFrustum( numObjs, objData, camera, visibilityMask,
+                                            outVisibleObjects, lodCamera );
+            }
+
+            if( request.occlusionCuller )
+                request.occlusionCuller->cullOccluded( outVisibleObjects, prevNumVisibleObjs );
 
             if( mRenderQueue->getRenderQueueMode(i) == RenderQueue::FAST && request.addToRenderQueue )
             {
@@ -2189,13 +2654,7 @@ void SceneManager::buildLightList()
         }
     }
 
-    if( mForceMainThread )
-        updateWorkerThreadImpl( 0 );
-    else
-    {
-        mWorkerThreadsBarrier->sync(); //Fire threads
-        mWorkerThreadsBarrier->sync(); //Wait them to complete
-    }
+    fireWorkerThreadsAndWait();
 
     //Now merge the results into a single list.
 
@@ -2227,13 +2686,7 @@ void SceneManager::buildLightList()
     {
         //Now fire the threads again, to build the per-MovableObject lists
         mRequestType = BUILD_LIGHT_LIST02;
-        if( mForceMainThread )
-            updateWorkerThreadImpl( 0 );
-        else
-        {
-            mWorkerThreadsBarrier->sync(); //Fire threads
-            mWorkerThreadsBarrier->sync(); //Wait them to complete
-        }
+        fireWorkerThreadsAndWait();
     }
 }
 //-----------------------------------------------------------------------
@@ -2277,8 +2730,39 @@ void SceneManager::buildLightListThread01( const BuildLightListRequest &buildLig
             numObjs = std::min( numObjs, totalObjs - toAdvance );
             objData.advancePack( toAdvance / ARRAY_PACKED_REALS );
 
-            Light::cullLights( numObjs, objData, mLightMask, threadLocalLightList,
-                               mVisibleCameras, mCubeMapCameras );
+            const CullingHierarchy &cullingHierarchy = objMemoryManager->_getCullingHierarchy( i );
+            if( mCullingHierarchyEnabled && cullingHierarchy.isBuilt() && numObjs )
+            {
+                const size_t firstBlock = toAdvance / ARRAY_PACKED_REALS;
+                CullingHierarchy::BlockRangeArray &visibleBlocks = mVisibleBlocksPerThread[threadIdx];
+                visibleBlocks.clear();
+                cullingHierarchy.collectVisibleBlocks(
+                            firstBlock, (numObjs + ARRAY_PACKED_REALS - 1) / ARRAY_PACKED_REALS,
+                            mVisibleCameras.empty() ? 0 : &mVisibleCameras[0],
+                            mVisibleCameras.size(),
+                            mCubeMapCameras.empty() ? 0 : &mCubeMapCameras[0],
+                            mCubeMapCameras.size(), visibleBlocks );
+
+                CullingHierarchy::BlockRangeArray::const_iterator itRange = visibleBlocks.begin();
+                CullingHierarchy::BlockRangeArray::const_iterator enRange = visibleBlocks.end();
+
+                while( itRange != enRange )
+                {
+                    const size_t objOffset = (itRange->firstBlock - firstBlock) * ARRAY_PACKED_REALS;
+                    ObjectData rangeObjData = objData;
+                    rangeObjData.advancePack( itRange->firstBlock - firstBlock );
+                    Light::cullLights( std::min( itRange->numBlocks * ARRAY_PACKED_REALS,
+                                                 numObjs - objOffset ),
+                                       rangeObjData, mLightMask, threadLocalLightList,
+                                       mVisibleCameras, mCubeMapCameras );
+                    ++itRange;
+                }
+            }
+            else
+            {
+                Light::cullLights( numObjs, objData, mLightMask, threadLocalLightList,
+                                   mVisibleCameras, mCubeMapCameras );
+            }
         }
 
         ++it;
@@ -2346,6 +2830,15 @@ void SceneManager::highLevelCull()
     mSkeletonAnimManagerCulledList.push_back( &mSkeletonAnimationManager );
     mTagPointNodeMemoryManagerUpdateList.push_back( &mTagPointNodeMemoryManager );
 
+    if( mCullingHierarchyEnabled && !mStaticEntitiesDirty &&
+        (mEntityMemoryManager[SCENE_STATIC]._isCullingHierarchyDirty() ||
+         mForwardPlusMemoryManager[SCENE_STATIC]._isCullingHierarchyDirty()) )
+    {
+        //Static objects were created or moved in memory. Their bounds are fine,
+        //but the hierarchy must be rebuilt and that happens while updating them.
+        mStaticEntitiesDirty = true;
+    }
+
     if( mStaticEntitiesDirty )
     {
         //Entities have changed
@@ -2380,14 +2873,11 @@ void SceneManager::updateSceneGraph()
 
     // Update controllers 
     ControllerManager::getSingleton().updateAllControllers();
+    updateAllParticleSystems();
 
     highLevelCull();
     _applySceneAnimations();
-    updateAllTransforms();
-    updateAllAnimations();
-    updateAllTagPoints();
-    updateAllBounds( mEntitiesMemoryManagerUpdateList );
-    updateAllBounds( mLightsMemoryManagerCulledList );
+    updateAllTransformsAndBounds();
 
     {
         // Auto-track nodes
@@ -4620,15 +5110,33 @@ void SceneManager::updateGpuProgramParameters(const Pass* pass)
 }
 void SceneManager::fireWorkerThreadsAndWait(void)
 {
+    mRequestTaskGraph.clear();
+    mRequestTaskGraph.addTask( &mRequestTask, mNumWorkerThreads );
+    executeTaskGraph( &mRequestTaskGraph );
+}
+//---------------------------------------------------------------------
+void SceneManager::executeTaskGraph( TaskGraph *taskGraph )
+{
+    mCurrentTaskGraph = taskGraph;
+
     if( mForceMainThread )
-        updateWorkerThreadImpl( 0 );
+    {
+        taskGraph->_prepareExecution( 1u );
+        taskGraph->_executeWorker( 0 );
+    }
     else
     {
+        taskGraph->_prepareExecution( mNumWorkerThreads );
         mWorkerThreadsBarrier->sync(); //Fire threads
         mWorkerThreadsBarrier->sync(); //Wait them to complete
     }
 }
 //---------------------------------------------------------------------
+void SceneManager::RequestTask::execute( size_t threadId, size_t numThreads )
+{
+    mSceneManager->updateWorkerThreadImpl( threadId );
+}
+//---------------------------------------------------------------------
 //---------------------------------------------------------------------
 void SceneManager::fireCullFrustumThreads( const CullFrustumRequest &request )
 {
@@ -4647,13 +5155,15 @@ void SceneManager::executeUserScalableTask( UniformScalableTask *task, bool bBlo
     mRequestType = USER_UNIFORM_SCALABLE_TASK;
     mUserTask = task;
 
-    if( mForceMainThread )
-        updateWorkerThreadImpl( 0 );
+    if( bBlock || mForceMainThread )
+        fireWorkerThreadsAndWait();
     else
     {
+        mRequestTaskGraph.clear();
+        mRequestTaskGraph.addTask( &mRequestTask, mNumWorkerThreads );
+        mRequestTaskGraph._prepareExecution( mNumWorkerThreads );
+        mCurrentTaskGraph = &mRequestTaskGraph;
         mWorkerThreadsBarrier->sync(); //Fire threads
-        if( bBlock )
-            mWorkerThreadsBarrier->sync(); //Wait them to complete
     }
 }
 //---------------------------------------------------------------------
@@ -4692,7 +5202,9 @@ void SceneManager::stopWorkerThreads()
     if( !mForceMainThread )
     {
         mRequestType = STOP_THREADS;
-        fireWorkerThreadsAndWait();
+        mCurrentTaskGraph = 0;
+        mWorkerThreadsBarrier->sync(); //Fire threads
+        mWorkerThreadsBarrier->sync(); //Wait them to complete
 
         Threads::WaitForThreads( mWorkerThreads );
 
@@ -4705,10 +5217,23 @@ unsigned long SceneManager::_updateWorkerThread( ThreadHandle *threadHandle )
 {
     bool exitThread = false;
     size_t threadIdx = threadHandle->getThreadIdx();
+
+#if OGRE_PROFILING
+    {
+        char tmpBuffer[64];
+        LwString threadName( LwString::FromEmptyPointer( tmpBuffer, sizeof(tmpBuffer) ) );
+        threadName.a( "SceneManager Worker ", (uint32)threadIdx );
+        OgreProfileThreadName( threadName.c_str() );
+    }
+#endif
+
     while( !exitThread )
     {
         mWorkerThreadsBarrier->sync();
-        exitThread = updateWorkerThreadImpl( threadIdx );
+        if( mCurrentTaskGraph )
+            mCurrentTaskGraph->_executeWorker( threadIdx );
+        else
+            exitThread = true;
         mWorkerThreadsBarrier->sync();
     }
 
@@ -4727,17 +5252,8 @@ inline bool SceneManager::updateWorkerThreadImpl( size_t threadIdx )
     case UPDATE_ALL_ANIMATIONS:
         updateAllAnimationsThread( threadIdx );
         break;
-    case UPDATE_ALL_TRANSFORMS:
-        updateAllTransformsThread( mUpdateTransformRequest, threadIdx );
-        break;
-    case UPDATE_ALL_BONE_TO_TAG_TRANSFORMS:
-        updateAllTransformsBoneToTagThread( mUpdateTransformRequest, threadIdx );
-        break;
-    case UPDATE_ALL_TAG_ON_TAG_TRANSFORMS:
-        updateAllTransformsTagOnTagThread( mUpdateTransformRequest, threadIdx );
-        break;
-    case UPDATE_ALL_BOUNDS:
-        updateAllBoundsThread( *mUpdateBoundsRequest, threadIdx );
+    case UPDATE_ALL_ANIMATION_TRANSFORMS:
+        updateAllAnimationTransformsThread( threadIdx );
         break;
     case UPDATE_ALL_LODS:
         updateAllLodsThread( mUpdateLodRequest, threadIdx );
@@ -4748,6 +5264,9 @@ inline bool SceneManager::updateWorkerThreadImpl( size_t threadIdx )
     case BUILD_LIGHT_LIST02:
         buildLightListThread02( threadIdx );
         break;
+    case UPDATE_ALL_PARTICLE_SYSTEMS:
+        updateAllParticleSystemsThread( threadIdx );
+        break;
     case USER_UNIFORM_SCALABLE_TASK:
         mUserTask->execute( threadIdx, mNumWorkerThreads );
         break;
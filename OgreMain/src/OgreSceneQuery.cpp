@@ -183,6 +183,7 @@ namespace Ogre {
     RaySceneQuery::RaySceneQuery(SceneManager* mgr) : SceneQuery(mgr)
     {
         mSortByDistance = false;
+        mPrecise = false;
         mMaxResults = 0;
     }
     //-----------------------------------------------------------------------
@@ -216,6 +217,16 @@ namespace Ogre {
         return mMaxResults;
     }
     //-----------------------------------------------------------------------
+    void RaySceneQuery::setPrecise( bool precise )
+    {
+        mPrecise = precise;
+    }
+    //-----------------------------------------------------------------------
+    bool RaySceneQuery::getPrecise(void) const
+    {
+        return mPrecise;
+    }
+    //-----------------------------------------------------------------------
     RaySceneQueryResult& RaySceneQuery::execute(void)
     {
         // Clear without freeing the vector buffer
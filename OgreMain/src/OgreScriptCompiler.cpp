@@ -34,6 +34,16 @@ THE SOFTWARE.
 #include "OgreLogManager.h"
 #include "OgreStringConverter.h"
 #include "OgreString.h"
+#include "OgreDataStream.h"
+#include "OgreIdString.h"
+
+#include "Hash/MurmurHash3.h"
+
+#if OGRE_ARCH_TYPE == OGRE_ARCHITECTURE_32
+        #define OGRE_HASH128_FUNC MurmurHash3_x86_128
+#else
+        #define OGRE_HASH128_FUNC MurmurHash3_x64_128
+#endif
 
 namespace Ogre
 {
@@ -284,9 +294,17 @@ namespace Ogre
 
     bool ScriptCompiler::compile(const String &str, const String &source, const String &group)
     {
-        ScriptLexer lexer;
-        ScriptParser parser;
-        ConcreteNodeListPtr nodes = parser.parse(lexer.tokenize(str), source);
+        ConcreteNodeListPtr nodes;
+        if(ScriptCompilerManager::getSingletonPtr())
+        {
+            nodes = ScriptCompilerManager::getSingleton()._parse(str, source);
+        }
+        else
+        {
+            ScriptLexer lexer;
+            ScriptParser parser;
+            nodes = parser.parse(lexer.tokenize(str), source);
+        }
         return compile(nodes, group);
     }
 
@@ -596,9 +614,16 @@ namespace Ogre
             DataStreamPtr stream = ResourceGroupManager::getSingleton().openResource(name, mGroup);
             if(!stream.isNull())
             {
-                ScriptLexer lexer;
-                ScriptParser parser;
-                nodes = parser.parse(lexer.tokenize(stream->getAsString()), name);
+                if(ScriptCompilerManager::getSingletonPtr())
+                {
+                    nodes = ScriptCompilerManager::getSingleton()._parse(stream->getAsString(), name);
+                }
+                else
+                {
+                    ScriptLexer lexer;
+                    ScriptParser parser;
+                    nodes = parser.parse(lexer.tokenize(stream->getAsString()), name);
+                }
             }
         }
 
@@ -1703,8 +1728,11 @@ namespace Ogre
         assert( msSingleton );  return ( *msSingleton );  
     }
     //-----------------------------------------------------------------------
+    const uint32 ScriptCompilerManager::PARSED_SCRIPT_CACHE_VERSION = 1;
+    //-----------------------------------------------------------------------
     ScriptCompilerManager::ScriptCompilerManager()
-        :mListener(0), OGRE_THREAD_POINTER_INIT(mScriptCompiler)
+        :mListener(0), OGRE_THREAD_POINTER_INIT(mScriptCompiler),
+        mParsedScriptCacheEnabled(false), mParsedScriptCacheDirty(false)
     {
             OGRE_LOCK_AUTO_MUTEX;
         mScriptPatterns.push_back("*.program");
@@ -1818,6 +1846,254 @@ namespace Ogre
         }
         OGRE_THREAD_POINTER_GET(mScriptCompiler)->compile(stream->getAsString(), stream->getName(), groupName);
     }
+    //-----------------------------------------------------------------------
+    ScriptCompilerManager::ParsedScriptHash ScriptCompilerManager::computeParsedScriptHash(
+            const String &str )
+    {
+        ParsedScriptHash retVal;
+        OGRE_HASH128_FUNC( str.c_str(), static_cast<int>( str.size() ), IdString::Seed, &retVal );
+        return retVal;
+    }
+    //-----------------------------------------------------------------------
+    void ScriptCompilerManager::serialiseNodes( const ConcreteNodeList &nodes,
+                                                vector<uint8>::type &outData )
+    {
+        // Layout per node: type (uint8), line (uint32), token length (uint32),
+        // token, number of children (uint32), children. The file isn't stored,
+        // it's always the source being parsed.
+        const uint32 numNodes = static_cast<uint32>( nodes.size() );
+        outData.insert( outData.end(), reinterpret_cast<const uint8*>( &numNodes ),
+                        reinterpret_cast<const uint8*>( &numNodes ) + sizeof(uint32) );
+
+        ConcreteNodeList::const_iterator itor = nodes.begin();
+        ConcreteNodeList::const_iterator end  = nodes.end();
+        while( itor != end )
+        {
+            const ConcreteNode *node = itor->get();
+
+            const uint8 type = static_cast<uint8>( node->type );
+            const uint32 line = static_cast<uint32>( node->line );
+            const uint32 tokenLength = static_cast<uint32>( node->token.size() );
+            outData.push_back( type );
+            outData.insert( outData.end(), reinterpret_cast<const uint8*>( &line ),
+                            reinterpret_cast<const uint8*>( &line ) + sizeof(uint32) );
+            outData.insert( outData.end(), reinterpret_cast<const uint8*>( &tokenLength ),
+                            reinterpret_cast<const uint8*>( &tokenLength ) + sizeof(uint32) );
+            outData.insert( outData.end(), node->token.begin(), node->token.end() );
+
+            serialiseNodes( node->children, outData );
+            ++itor;
+        }
+    }
+    //-----------------------------------------------------------------------
+    bool ScriptCompilerManager::deserialiseNodes( const uint8 *&data, const uint8 *dataEnd,
+                                                  const String &source, ConcreteNode *parent,
+                                                  ConcreteNodeList &outNodes )
+    {
+        uint32 numNodes;
+        if( dataEnd - data < (ptrdiff_t)sizeof(uint32) )
+            return false;
+        memcpy( &numNodes, data, sizeof(uint32) );
+        data += sizeof(uint32);
+
+        for( uint32 i=0; i<numNodes; ++i )
+        {
+            const size_t headerSize = sizeof(uint8) + sizeof(uint32) * 2u;
+            if( dataEnd - data < (ptrdiff_t)headerSize )
+                return false;
+
+            uint32 line, tokenLength;
+            const uint8 type = *data;
+            memcpy( &line, data + sizeof(uint8), sizeof(uint32) );
+            memcpy( &tokenLength, data + sizeof(uint8) + sizeof(uint32), sizeof(uint32) );
+            data += headerSize;
+
+            if( type > CNT_COLON || dataEnd - data < (ptrdiff_t)tokenLength )
+                return false;
+
+            ConcreteNodePtr node( OGRE_NEW ConcreteNode() );
+            node->type  = static_cast<ConcreteNodeType>( type );
+            node->line  = line;
+            node->token.assign( reinterpret_cast<const char*>( data ), tokenLength );
+            node->file  = source;
+            node->parent= parent;
+            data += tokenLength;
+
+            if( !deserialiseNodes( data, dataEnd, source, node.get(), node->children ) )
+                return false;
+
+            outNodes.push_back( node );
+        }
+
+        return true;
+    }
+    //-----------------------------------------------------------------------
+    ConcreteNodeListPtr ScriptCompilerManager::_parse( const String &str, const String &source )
+    {
+        ParsedScriptHash hash;
+        memset( &hash, 0, sizeof(hash) );
+
+        bool useCache;
+        {
+            OGRE_LOCK_MUTEX( mParsedScriptCacheMutex );
+            useCache = mParsedScriptCacheEnabled || !mParsedScriptCache.empty();
+        }
+
+        if( useCache )
+        {
+            hash = computeParsedScriptHash( str );
+
+            MemoryDataStreamPtr data;
+            {
+                OGRE_LOCK_MUTEX( mParsedScriptCacheMutex );
+                ParsedScriptMap::iterator itor = mParsedScriptCache.find( hash );
+                if( itor != mParsedScriptCache.end() )
+                {
+                    itor->second.used = true;
+                    data = itor->second.data;
+                }
+            }
+
+            if( !data.isNull() )
+            {
+                ConcreteNodeListPtr nodes( OGRE_NEW_T( ConcreteNodeList, MEMCATEGORY_GENERAL )(),
+                                           SPFM_DELETE_T );
+                const uint8 *dataStart = data->getPtr();
+                if( deserialiseNodes( dataStart, data->getPtr() + data->size(), source, 0, *nodes ) )
+                    return nodes;
+
+                LogManager::getSingleton().logMessage( "Parsed script cache entry for " + source +
+                                                       " is corrupt. Parsing it again." );
+            }
+        }
+
+        ScriptLexer lexer;
+        ScriptParser parser;
+        ConcreteNodeListPtr nodes = parser.parse( lexer.tokenize( str ), source );
+
+        if( mParsedScriptCacheEnabled && !nodes.isNull() )
+        {
+            vector<uint8>::type serialised;
+            serialiseNodes( *nodes, serialised );
+
+            MemoryDataStreamPtr data( OGRE_NEW MemoryDataStream( serialised.size() ) );
+            if( !serialised.empty() )
+                memcpy( data->getPtr(), &serialised[0], serialised.size() );
+
+            ParsedScript parsedScript;
+            parsedScript.data = data;
+            parsedScript.used = true;
+
+            OGRE_LOCK_MUTEX( mParsedScriptCacheMutex );
+            mParsedScriptCache[hash] = parsedScript;
+            mParsedScriptCacheDirty = true;
+        }
+
+        return nodes;
+    }
+    //-----------------------------------------------------------------------
+    void ScriptCompilerManager::setParsedScriptCacheEnabled( bool enabled )
+    {
+        OGRE_LOCK_MUTEX( mParsedScriptCacheMutex );
+        mParsedScriptCacheEnabled = enabled;
+    }
+    //-----------------------------------------------------------------------
+    void ScriptCompilerManager::saveParsedScriptCache( DataStreamPtr stream )
+    {
+        if( !stream->isWriteable() )
+        {
+            OGRE_EXCEPT( Exception::ERR_CANNOT_WRITE_TO_FILE,
+                         "Unable to write to stream " + stream->getName(),
+                         "ScriptCompilerManager::saveParsedScriptCache" );
+        }
+
+        OGRE_LOCK_MUTEX( mParsedScriptCacheMutex );
+
+        uint32 numEntries = 0;
+        ParsedScriptMap::const_iterator itor = mParsedScriptCache.begin();
+        ParsedScriptMap::const_iterator end  = mParsedScriptCache.end();
+        while( itor != end )
+        {
+            if( itor->second.used )
+                ++numEntries;
+            ++itor;
+        }
+
+        stream->write( &PARSED_SCRIPT_CACHE_VERSION, sizeof(uint32) );
+        stream->write( &numEntries, sizeof(uint32) );
+
+        itor = mParsedScriptCache.begin();
+        while( itor != end )
+        {
+            if( itor->second.used )
+            {
+                const MemoryDataStreamPtr &data = itor->second.data;
+                const uint32 dataLength = static_cast<uint32>( data->size() );
+                stream->write( &itor->first, sizeof(ParsedScriptHash) );
+                stream->write( &dataLength, sizeof(uint32) );
+                stream->write( data->getPtr(), dataLength );
+            }
+            ++itor;
+        }
+
+        mParsedScriptCacheDirty = false;
+    }
+    //-----------------------------------------------------------------------
+    void ScriptCompilerManager::loadParsedScriptCache( DataStreamPtr stream )
+    {
+        // Read everything at once, then split it in memory
+        MemoryDataStream fileData( stream, false, true );
+        const uint8 *data = fileData.getPtr();
+        const uint8 *dataEnd = data + fileData.size();
+
+        OGRE_LOCK_MUTEX( mParsedScriptCacheMutex );
+
+        mParsedScriptCache.clear();
+        mParsedScriptCacheDirty = false;
+
+        uint32 version = 0, numEntries = 0;
+        if( dataEnd - data < (ptrdiff_t)(sizeof(uint32) * 2u) )
+            return;
+        memcpy( &version, data, sizeof(uint32) );
+        memcpy( &numEntries, data + sizeof(uint32), sizeof(uint32) );
+        data += sizeof(uint32) * 2u;
+
+        if( version != PARSED_SCRIPT_CACHE_VERSION )
+        {
+            LogManager::getSingleton().logMessage( "Parsed script cache " + stream->getName() +
+                                                   " was saved by a different version. Ignoring." );
+            return;
+        }
+
+        for( uint32 i=0; i<numEntries; ++i )
+        {
+            ParsedScriptHash hash;
+            uint32 dataLength;
+            if( dataEnd - data < (ptrdiff_t)(sizeof(ParsedScriptHash) + sizeof(uint32)) )
+                break;
+            memcpy( &hash, data, sizeof(ParsedScriptHash) );
+            memcpy( &dataLength, data + sizeof(ParsedScriptHash), sizeof(uint32) );
+            data += sizeof(ParsedScriptHash) + sizeof(uint32);
+
+            if( dataEnd - data < (ptrdiff_t)dataLength )
+                break;
+
+            ParsedScript parsedScript;
+            parsedScript.data = MemoryDataStreamPtr( OGRE_NEW MemoryDataStream( dataLength ) );
+            parsedScript.used = false;
+            memcpy( parsedScript.data->getPtr(), data, dataLength );
+            data += dataLength;
+
+            mParsedScriptCache[hash] = parsedScript;
+        }
+    }
+    //-----------------------------------------------------------------------
+    void ScriptCompilerManager::clearParsedScriptCache(void)
+    {
+        OGRE_LOCK_MUTEX( mParsedScriptCacheMutex );
+        mParsedScriptCache.clear();
+        mParsedScriptCacheDirty = false;
+    }
 
     //-------------------------------------------------------------------------
     String PreApplyTextureAliasesScriptCompilerEvent::eventType = "preApplyTextureAliases";
@@ -744,6 +744,7 @@ namespace v1 {
         regionAabb.merge( localAabb );
         mObjectData.mLocalAabb->setFromAabb( regionAabb, mObjectData.mIndex );
         mObjectData.mLocalRadius[mObjectData.mIndex] = regionAabb.getRadius();
+        _notifyLocalAabbDirty();
     }
     //--------------------------------------------------------------------------
     void StaticGeometry::Region::build( bool parentVisible )
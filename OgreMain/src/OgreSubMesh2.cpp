@@ -35,6 +35,7 @@ THE SOFTWARE.
 #include "OgreHardwareBufferManager.h"
 #include "OgreLogManager.h"
 #include "OgreBitwise.h"
+#include "OgreBvh.h"
 
 #include "Vao/OgreVaoManager.h"
 #include "Vao/OgreAsyncTicket.h"
@@ -52,12 +53,15 @@ namespace Ogre {
         mNumPoses( 0 ),
         mPoseHalfPrecision( false ),
         mPoseNormals( false ),
-        mPoseTexBuffer( 0 )
+        mPoseTexBuffer( 0 ),
+        mTriangleBvh( 0 ),
+        mTriangleBvhBuildFailed( false )
     {
     }
     //-----------------------------------------------------------------------
     SubMesh::~SubMesh()
     {
+        destroyTriangleBvh();
         destroyShadowMappingVaos();
         destroyVaos( mVao[VpNormal], mParent->mVaoManager );
         
@@ -294,6 +298,7 @@ namespace Ogre {
 
             const OperationType opType = mVao[VpNormal][0]->getOperationType();
             IndexBufferPacked *indexBuffer = mVao[VpNormal][0]->getIndexBuffer();
+            destroyTriangleBvh();
             destroyVaos( mVao[VpNormal], mParent->mVaoManager, false );
 
             VertexBufferPackedVec vertexBuffers( 1u, vertexBuffer );
@@ -502,6 +507,8 @@ namespace Ogre {
     void SubMesh::importFromV1( v1::SubMesh *subMesh, bool halfPos, bool halfTexCoords,
                                 bool qTangents, bool halfPose )
     {
+        destroyTriangleBvh();
+
         mMaterialName = subMesh->getMaterialName();
 
         if( subMesh->parent->hasSkeleton() )
@@ -808,6 +815,8 @@ namespace Ogre {
     //---------------------------------------------------------------------
     void SubMesh::arrangeEfficient( bool halfPos, bool halfTexCoords, bool qTangents )
     {
+        destroyTriangleBvh();
+
         uint8 numVaoPasses = mParent->hasIndependentShadowMappingVaos() + 1;
 
         for( uint8 vaoPassIdx=0; vaoPassIdx<numVaoPasses; ++vaoPassIdx )
@@ -1315,6 +1324,8 @@ namespace Ogre {
     //---------------------------------------------------------------------
     void SubMesh::dearrangeToInefficient(void)
     {
+        destroyTriangleBvh();
+
         const uint8 numVaoPasses = mParent->hasIndependentShadowMappingVaos() + 1;
 
         for( uint8 vaoPassIdx=0; vaoPassIdx<numVaoPasses; ++vaoPassIdx )
@@ -1555,6 +1566,30 @@ namespace Ogre {
         mVao[VpShadow].reserve( mVao[VpNormal].size() );
     }
     //---------------------------------------------------------------------
+    const TriangleBvh* SubMesh::getTriangleBvh(void)
+    {
+        if( !mTriangleBvh && !mTriangleBvhBuildFailed && !mVao[VpNormal].empty() )
+        {
+            mTriangleBvh = OGRE_NEW TriangleBvh();
+            if( !mTriangleBvh->build( mVao[VpNormal][0] ) )
+            {
+                //Don't download the buffers again on every call
+                OGRE_DELETE mTriangleBvh;
+                mTriangleBvh = 0;
+                mTriangleBvhBuildFailed = true;
+            }
+        }
+
+        return mTriangleBvh;
+    }
+    //---------------------------------------------------------------------
+    void SubMesh::destroyTriangleBvh(void)
+    {
+        OGRE_DELETE mTriangleBvh;
+        mTriangleBvh = 0;
+        mTriangleBvhBuildFailed = false;
+    }
+    //---------------------------------------------------------------------
     void SubMesh::_prepareForShadowMapping( bool forceSameBuffers )
     {
         destroyShadowMappingVaos();
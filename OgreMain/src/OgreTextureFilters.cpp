@@ -129,6 +129,37 @@ namespace TextureFilter
         inOutFilters.clear();
     }
     //-----------------------------------------------------------------------------------
+    void FilterBase::_executeAhead( uint32 filters, Image2 &image, const TextureGpu *texture )
+    {
+        if( !(filters & TextureFilter::TypeGenerateDefaultMipmaps) ||
+            (filters & (TextureFilter::TypePrepareForNormalMapping |
+                        TextureFilter::TypeLeaveChannelR)) ||
+            image.getNumMipmaps() > 1u )
+        {
+            return;
+        }
+
+        PixelFormatGpu pixelFormat = image.getPixelFormat();
+        if( texture->prefersLoadingFromFileAsSRGB() )
+            pixelFormat = PixelFormatGpuUtils::getEquivalentSRGB( pixelFormat );
+
+        const uint8 mipmapGen = selectMipmapGen( filters, image, pixelFormat,
+                                                 texture->getTextureManager() );
+        if( mipmapGen != DefaultMipmapGen::SwMode )
+            return;
+
+        const Image2::Filter filter =
+                static_cast<Image2::Filter>( GenerateSwMipmaps::getFilter( image ) );
+        if( !Image2::supportsSwMipmaps( pixelFormat, image.getDepthOrSlices(),
+                                        image.getTextureType(), filter ) )
+        {
+            return;
+        }
+
+        OgreProfileExhaustive( "FilterBase::_executeAhead" );
+        image.generateMipmaps( PixelFormatGpuUtils::isSRgb( pixelFormat ), filter );
+    }
+    //-----------------------------------------------------------------------------------
     void FilterBase::simulateFiltersForCacheConsistency( uint32 filters, const Image2 &image,
                                                          const TextureGpuManager *textureGpuManager,
                                                          uint8 &inOutNumMipmaps,
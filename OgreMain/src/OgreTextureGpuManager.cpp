@@ -49,6 +49,7 @@ THE SOFTWARE.
 #include "OgreHlmsDatablock.h"
 
 #include "Threading/OgreThreads.h"
+#include "Threading/OgreBarrier.h"
 
 #include "OgreRenderSystem.h"
 #include "OgreException.h"
@@ -79,6 +80,8 @@ namespace Ogre
 
     unsigned long updateStreamingWorkerThread( ThreadHandle *threadHandle );
     THREAD_DECLARE( updateStreamingWorkerThread );
+    unsigned long updateDecodeWorkerThread( ThreadHandle *threadHandle );
+    THREAD_DECLARE( updateDecodeWorkerThread );
 
     TextureGpuManager::TextureGpuManager( VaoManager *vaoManager, RenderSystem *renderSystem ) :
         mDefaultMipmapGen( DefaultMipmapGen::HwMode ),
@@ -88,6 +91,11 @@ namespace Ogre
         mTryLockMutexFailureLimit( 1200u ),
         mAddedNewLoadRequests( false ),
         mAddedNewLoadRequestsSinceWaitingForStreamingCompletion( false ),
+        mDecodeWorkerBarrier( 0 ),
+        mExitDecodeWorkerThreads( false ),
+        mDecodeLoadRequests( 0 ),
+        mNextDecodeJob( 0 ),
+        mDecodeJobsEnd( 0 ),
         mEntriesToProcessPerIteration( 3u ),
         mMaxPreloadBytes( 256u * 1024u * 1024u ), //A value of 512MB begins to shake driver bugs.
         mTextureGpuManagerListener( &sDefaultTextureGpuManagerListener ),
@@ -188,6 +196,7 @@ namespace Ogre
             mWorkerWaitableEvent.wake();
             Threads::WaitForThreads( 1u, &mWorkerThread );
 #endif
+            stopDecodeWorkerThreads();
         }
     }
     //-----------------------------------------------------------------------------------
@@ -206,6 +215,7 @@ namespace Ogre
     {
         ThreadData &workerData = mThreadData[c_workerThread];
         ThreadData &mainData = mThreadData[c_mainThread];
+        releaseDecodedImages( mStreamingData.decodedImages.size() );
         mLoadRequestsMutex.lock();
         mainData.loadRequests.clear();  // TODO: if( loadRequest.autoDeleteImage ) delete loadRequest.image;
         mainData.objCmdBuffer->clear();
@@ -2489,6 +2499,8 @@ namespace Ogre
     //-----------------------------------------------------------------------------------
     unsigned long TextureGpuManager::_updateStreamingWorkerThread( ThreadHandle *threadHandle )
     {
+        OgreProfileThreadName( "TextureGpuManager Streaming" );
+
         while( !mShuttingDown )
         {
             mWorkerWaitableEvent.wait();
@@ -2499,7 +2511,8 @@ namespace Ogre
     }
     //-----------------------------------------------------------------------------------
     void TextureGpuManager::processLoadRequest( ObjCmdBuffer *commandBuffer, ThreadData &workerData,
-                                                const LoadRequest &loadRequest )
+                                                const LoadRequest &loadRequest,
+                                                DecodedImage *decodedImage )
     {
         OgreProfileExhaustive( "TextureGpuManager::processLoadRequest LoadRequest for first time" );
 
@@ -2537,19 +2550,6 @@ namespace Ogre
                         "Texture: " + loadRequest.name, LML_CRITICAL );
         }
 
-        DataStreamPtr data;
-        if( !loadRequest.archive && !loadRequest.image )
-            data = loadRequest.loadingListener->grouplessResourceLoading( loadRequest.name );
-        else if( !loadRequest.image )
-        {
-            data = loadRequest.archive->open( loadRequest.name );
-            if( loadRequest.loadingListener )
-            {
-                loadRequest.loadingListener->grouplessResourceOpened( loadRequest.name,
-                                                                      loadRequest.archive, data );
-            }
-        }
-
         //Load the image from file into system RAM
         Image2 imgStack;
         Image2 *img = loadRequest.image;
@@ -2559,22 +2559,30 @@ namespace Ogre
             img = &imgStack;
             if( !wasRescheduled )
             {
-                try
+                if( decodedImage && decodedImage->image )
                 {
-                    img->load( data );
+                    //Already loaded by the decode worker threads. Take ownership of its data
+                    //(without copying it). The decoded image will no longer free it.
+                    Image2 *srcImage = decodedImage->image;
+                    imgStack.loadDynamicImage( srcImage->getRawBuffer(),
+                                               srcImage->getAutoDelete(), srcImage );
+                    srcImage->_setAutoDelete( false );
                 }
-                catch( Exception &e )
+                else if( decodedImage && decodedImage->exception )
                 {
-                    //Log the exception
-                    LogManager::getSingleton().logMessage( e.getFullDescription() );
-                    //Tell the main thread this happened
-                    ObjCmdBuffer::ExceptionThrown *exceptionCmd = commandBuffer->addCommand<
-                                                                  ObjCmdBuffer::ExceptionThrown>();
-                    new (exceptionCmd) ObjCmdBuffer::ExceptionThrown( loadRequest.texture, e );
-                    //Continue loading using a fallback
-                    img->loadDynamicImage( mErrorFallbackTexData, 2u, 2u, 1u,
-                                           loadRequest.texture->getTextureType(),
-                                           PFG_RGBA8_UNORM_SRGB, false, 1u );
+                    handleLoadImageException( commandBuffer, loadRequest,
+                                              *decodedImage->exception, *img );
+                }
+                else
+                {
+                    try
+                    {
+                        loadImage( loadRequest, *img );
+                    }
+                    catch( Exception &e )
+                    {
+                        handleLoadImageException( commandBuffer, loadRequest, e, *img );
+                    }
                 }
             }
         }
@@ -2814,6 +2822,201 @@ namespace Ogre
         }
     }
     //-----------------------------------------------------------------------------------
+    void TextureGpuManager::loadImage( const LoadRequest &loadRequest, Image2 &outImage )
+    {
+        DataStreamPtr data;
+        if( !loadRequest.archive )
+            data = loadRequest.loadingListener->grouplessResourceLoading( loadRequest.name );
+        else
+        {
+            data = loadRequest.archive->open( loadRequest.name );
+            if( loadRequest.loadingListener )
+            {
+                loadRequest.loadingListener->grouplessResourceOpened( loadRequest.name,
+                                                                      loadRequest.archive, data );
+            }
+        }
+
+        outImage.load( data );
+    }
+    //-----------------------------------------------------------------------------------
+    void TextureGpuManager::handleLoadImageException( ObjCmdBuffer *commandBuffer,
+                                                      const LoadRequest &loadRequest,
+                                                      const Exception &e, Image2 &outImage )
+    {
+        //Log the exception
+        LogManager::getSingleton().logMessage( e.getFullDescription() );
+        //Tell the main thread this happened
+        ObjCmdBuffer::ExceptionThrown *exceptionCmd = commandBuffer->addCommand<
+                                                      ObjCmdBuffer::ExceptionThrown>();
+        new (exceptionCmd) ObjCmdBuffer::ExceptionThrown( loadRequest.texture, e );
+        //Continue loading using a fallback
+        outImage.loadDynamicImage( mErrorFallbackTexData, 2u, 2u, 1u,
+                                   loadRequest.texture->getTextureType(),
+                                   PFG_RGBA8_UNORM_SRGB, false, 1u );
+    }
+    //-----------------------------------------------------------------------------------
+    void TextureGpuManager::decodeLoadRequest( const LoadRequest &loadRequest,
+                                               DecodedImage &outDecodedImage )
+    {
+        OgreProfileExhaustive( "TextureGpuManager::decodeLoadRequest" );
+
+        if( loadRequest.image || (!loadRequest.archive && !loadRequest.loadingListener) )
+            return; //Nothing to decode, or processLoadRequest will complain about it
+
+        Image2 *img = new Image2();
+        try
+        {
+            loadImage( loadRequest, *img );
+        }
+        catch( Exception &e )
+        {
+            delete img;
+            outDecodedImage.exception = new Exception( e );
+            return;
+        }
+
+        TextureFilter::FilterBase::_executeAhead( loadRequest.filters, *img, loadRequest.texture );
+        outDecodedImage.image = img;
+    }
+    //-----------------------------------------------------------------------------------
+    void TextureGpuManager::decodeWorkerThreadImpl(void)
+    {
+        bool bDone = false;
+        while( !bDone )
+        {
+            size_t jobIdx;
+            {
+                ScopedLock lock( mDecodeJobsMutex );
+                jobIdx = mNextDecodeJob++;
+            }
+
+            if( jobIdx < mDecodeJobsEnd )
+            {
+                decodeLoadRequest( (*mDecodeLoadRequests)[jobIdx],
+                                   mStreamingData.decodedImages[jobIdx] );
+            }
+            else
+            {
+                bDone = true;
+            }
+        }
+    }
+    //-----------------------------------------------------------------------------------
+    void TextureGpuManager::decodeLoadRequests( const ThreadData &workerData, size_t numToDecode )
+    {
+        OgreProfileExhaustive( "TextureGpuManager::decodeLoadRequests" );
+
+        const size_t firstToDecode = mStreamingData.decodedImages.size();
+        if( firstToDecode >= numToDecode )
+            return;
+
+        mStreamingData.decodedImages.resize( numToDecode );
+
+        mDecodeLoadRequests = &workerData.loadRequests;
+        mNextDecodeJob = firstToDecode;
+        mDecodeJobsEnd = numToDecode;
+
+        mDecodeWorkerBarrier->sync(); //Fire threads
+        decodeWorkerThreadImpl();
+        mDecodeWorkerBarrier->sync(); //Wait them to complete
+
+        mDecodeLoadRequests = 0;
+    }
+    //-----------------------------------------------------------------------------------
+    void TextureGpuManager::releaseDecodedImages( size_t numEntries )
+    {
+        DecodedImageVec &decodedImages = mStreamingData.decodedImages;
+        numEntries = std::min( numEntries, decodedImages.size() );
+
+        DecodedImageVec::const_iterator itor = decodedImages.begin();
+        DecodedImageVec::const_iterator end  = decodedImages.begin() + numEntries;
+
+        while( itor != end )
+        {
+            //If processLoadRequest took ownership of the data, the
+            //image is no longer set to autodelete and won't free it
+            delete itor->image;
+            delete itor->exception;
+            ++itor;
+        }
+
+        decodedImages.erase( decodedImages.begin(), decodedImages.begin() + numEntries );
+    }
+    //-----------------------------------------------------------------------------------
+    unsigned long updateDecodeWorkerThread( ThreadHandle *threadHandle )
+    {
+        TextureGpuManager *textureManager =
+                reinterpret_cast<TextureGpuManager*>( threadHandle->getUserParam() );
+        return textureManager->_updateDecodeWorkerThread( threadHandle );
+    }
+    //-----------------------------------------------------------------------------------
+    unsigned long TextureGpuManager::_updateDecodeWorkerThread( ThreadHandle *threadHandle )
+    {
+        OgreProfileThreadName( "TextureGpuManager Decoder" );
+
+        bool exitThread = false;
+        while( !exitThread )
+        {
+            mDecodeWorkerBarrier->sync();
+            if( !mExitDecodeWorkerThreads )
+                decodeWorkerThreadImpl();
+            else
+                exitThread = true;
+            mDecodeWorkerBarrier->sync();
+        }
+
+        return 0;
+    }
+    //-----------------------------------------------------------------------------------
+    void TextureGpuManager::startDecodeWorkerThreads( size_t numThreads )
+    {
+        OGRE_ASSERT_LOW( mDecodeWorkerThreads.empty() );
+
+        if( !numThreads )
+            return;
+
+        mExitDecodeWorkerThreads = false;
+        mDecodeWorkerBarrier = new Barrier( numThreads + 1u );
+        mDecodeWorkerThreads.reserve( numThreads );
+        for( size_t i=0; i<numThreads; ++i )
+        {
+            ThreadHandlePtr th = Threads::CreateThread( THREAD_GET( updateDecodeWorkerThread ),
+                                                        i, this );
+            mDecodeWorkerThreads.push_back( th );
+        }
+    }
+    //-----------------------------------------------------------------------------------
+    void TextureGpuManager::stopDecodeWorkerThreads(void)
+    {
+        if( mDecodeWorkerThreads.empty() )
+            return;
+
+        mExitDecodeWorkerThreads = true;
+        mDecodeWorkerBarrier->sync(); //Fire threads
+        mDecodeWorkerBarrier->sync(); //Wait them to complete
+
+        Threads::WaitForThreads( mDecodeWorkerThreads );
+        mDecodeWorkerThreads.clear();
+
+        delete mDecodeWorkerBarrier;
+        mDecodeWorkerBarrier = 0;
+    }
+    //-----------------------------------------------------------------------------------
+    void TextureGpuManager::setNumDecodeWorkerThreads( size_t numThreads )
+    {
+#if OGRE_PLATFORM != OGRE_PLATFORM_EMSCRIPTEN
+        if( numThreads == mDecodeWorkerThreads.size() || mShuttingDown )
+            return;
+
+        //The worker thread can't be decoding while we change the threads
+        mMutex.lock();
+        stopDecodeWorkerThreads();
+        startDecodeWorkerThreads( numThreads );
+        mMutex.unlock();
+#endif
+    }
+    //-----------------------------------------------------------------------------------
     void TextureGpuManager::_updateStreaming(void)
     {
         OgreProfileExhaustive( "TextureGpuManager::_updateStreaming" );
@@ -2885,7 +3088,25 @@ namespace Ogre
             }
         }
 
-        const size_t entriesToProcessPerIteration = mEntriesToProcessPerIteration;
+        size_t entriesToProcessPerIteration = mEntriesToProcessPerIteration;
+
+        if( !mDecodeWorkerThreads.empty() && !workerData.loadRequests.empty() &&
+            mStreamingData.bytesPreloaded < mMaxPreloadBytes )
+        {
+            //Decode (and generate mipmaps of) the next batch in parallel. The batch is
+            //at least big enough to keep every decode thread (plus us) busy. We'll
+            //process everything that got decoded, unless we run out of staging memory.
+            const size_t numToDecode =
+                    std::min( workerData.loadRequests.size(),
+                              std::max( entriesToProcessPerIteration,
+                                        mDecodeWorkerThreads.size() + 1u ) );
+            decodeLoadRequests( workerData, numToDecode );
+        }
+
+        DecodedImageVec &decodedImages = mStreamingData.decodedImages;
+        entriesToProcessPerIteration = std::max( entriesToProcessPerIteration,
+                                                 decodedImages.size() );
+
         size_t entriesProcessed = 0;
         //Now process new requests from main thread
         LoadRequestVec::const_iterator itor = workerData.loadRequests.begin();
@@ -2895,11 +3116,17 @@ namespace Ogre
                entriesProcessed < entriesToProcessPerIteration &&
                mStreamingData.bytesPreloaded < mMaxPreloadBytes )
         {
-            processLoadRequest( commandBuffer, workerData, *itor );
+            DecodedImage *decodedImage = 0;
+            if( entriesProcessed < decodedImages.size() )
+                decodedImage = &decodedImages[entriesProcessed];
+            processLoadRequest( commandBuffer, workerData, *itor, decodedImage );
             ++entriesProcessed;
             ++itor;
         }
 
+        //Entries that didn't get processed stay decoded for the next iteration
+        releaseDecodedImages( entriesProcessed );
+
         //Two cases:
         //  1. We did something this iteration, and finished 100%.
         //     Main thread could be waiting for us. Let them know.
@@ -2917,6 +3144,9 @@ namespace Ogre
         workerData.loadRequests.erase( workerData.loadRequests.begin(),
                                        workerData.loadRequests.begin() + entriesProcessed );
         mergeUsageStatsIntoPrevStats();
+
+        //Bytes written into StagingTextures that are waiting for the main thread to upload them
+        OgreProfileCounter( "Texture bytes staged", mStreamingData.bytesPreloaded );
         mMutex.unlock();
 
         //Wake up outside mMutex to avoid unnecessary contention.
@@ -0,0 +1,75 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __AtomicHelpers_H__
+#define __AtomicHelpers_H__
+
+#include "OgrePlatform.h"
+
+#if OGRE_COMPILER == OGRE_COMPILER_MSVC
+    #include <intrin.h>
+    #pragma intrinsic( _InterlockedCompareExchange )
+    #pragma intrinsic( _InterlockedExchange )
+    #pragma intrinsic( _InterlockedDecrement )
+#endif
+
+namespace Ogre
+{
+    //Atomic accesses to a long shared with worker threads. Used instead of AtomicScalar
+    //because the latter isn't atomic when OGRE_THREAD_SUPPORT is 0, while the SceneManager's
+    //worker threads exist regardless.
+    //The Interlocked functions are full barriers. MSVC's plain volatile accesses
+    //only get acquire/release semantics with /volatile:ms, so we don't rely on them.
+    static inline long atomicLoad( long *value )
+    {
+#if OGRE_COMPILER == OGRE_COMPILER_MSVC
+        return _InterlockedCompareExchange( value, 0, 0 );
+#else
+        return __atomic_load_n( value, __ATOMIC_ACQUIRE );
+#endif
+    }
+    //-----------------------------------------------------------------------------------
+    static inline void atomicStore( long *value, long newValue )
+    {
+#if OGRE_COMPILER == OGRE_COMPILER_MSVC
+        _InterlockedExchange( value, newValue );
+#else
+        __atomic_store_n( value, newValue, __ATOMIC_RELEASE );
+#endif
+    }
+    //-----------------------------------------------------------------------------------
+    static inline long atomicDecrement( long *value )
+    {
+#if OGRE_COMPILER == OGRE_COMPILER_MSVC
+        return _InterlockedDecrement( value );
+#else
+        return __atomic_sub_fetch( value, 1, __ATOMIC_ACQ_REL );
+#endif
+    }
+}
+
+#endif
@@ -0,0 +1,242 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "OgreStableHeaders.h"
+
+#include "Threading/OgreTaskGraph.h"
+#include "Threading/OgreUniformScalableTask.h"
+#include "Threading/OgreThreads.h"
+#include "OgreProfiler.h"
+#include "OgreAtomicHelpers.h"
+
+namespace Ogre
+{
+    TaskGraph::TaskGraph() :
+        mNumPendingTasks( 0 )
+    {
+    }
+    //-----------------------------------------------------------------------------------
+    TaskGraph::~TaskGraph()
+    {
+        WorkerQueueVec::const_iterator itor = mWorkerQueues.begin();
+        WorkerQueueVec::const_iterator end  = mWorkerQueues.end();
+
+        while( itor != end )
+            delete *itor++;
+
+        mWorkerQueues.clear();
+    }
+    //-----------------------------------------------------------------------------------
+    TaskGraph::TaskId TaskGraph::addTask( UniformScalableTask *task, size_t numSlices )
+    {
+        assert( task && numSlices > 0u );
+
+        Task newTask;
+        newTask.task                    = task;
+        newTask.numSlices               = static_cast<uint32>( numSlices );
+        newTask.numPendingSlices        = 0;
+        newTask.numPendingDependencies  = 0;
+        newTask.numDependencies         = 0;
+        mTasks.push_back( newTask );
+
+        return static_cast<TaskId>( mTasks.size() - 1u );
+    }
+    //-----------------------------------------------------------------------------------
+    void TaskGraph::addDependency( TaskId task, TaskId dependsOn )
+    {
+        if( dependsOn == INVALID_TASK_ID )
+            return;
+
+        assert( task < mTasks.size() && dependsOn < mTasks.size() );
+        assert( task != dependsOn && "A task can't depend on itself!" );
+
+        mTasks[dependsOn].successors.push_back( task );
+        ++mTasks[task].numDependencies;
+    }
+    //-----------------------------------------------------------------------------------
+    void TaskGraph::clear(void)
+    {
+        assert( !atomicLoad( &mNumPendingTasks ) &&
+                "Clearing a TaskGraph while it is being executed!" );
+        mTasks.clear();
+    }
+    //-----------------------------------------------------------------------------------
+    void TaskGraph::_prepareExecution( size_t numWorkers )
+    {
+        assert( numWorkers > 0u );
+
+        while( mWorkerQueues.size() > numWorkers )
+        {
+            delete mWorkerQueues.back();
+            mWorkerQueues.pop_back();
+        }
+        while( mWorkerQueues.size() < numWorkers )
+            mWorkerQueues.push_back( new WorkerQueue() );
+
+        WorkerQueueVec::const_iterator itQueue = mWorkerQueues.begin();
+        WorkerQueueVec::const_iterator enQueue = mWorkerQueues.end();
+        while( itQueue != enQueue )
+            (*itQueue++)->jobs.clear();
+
+        //Spread the tasks that are ready to go evenly across all workers
+        //(round robin) so that they don't have to steal to get started.
+        size_t nextWorker = 0;
+        size_t numRootTasks = 0;
+
+        TaskVec::iterator itor = mTasks.begin();
+        TaskVec::iterator end  = mTasks.end();
+
+        while( itor != end )
+        {
+            itor->numPendingSlices          = itor->numSlices;
+            itor->numPendingDependencies    = itor->numDependencies;
+
+            if( !itor->numDependencies )
+            {
+                const TaskId taskId = static_cast<TaskId>( itor - mTasks.begin() );
+                for( uint32 i=0; i<itor->numSlices; ++i )
+                {
+                    mWorkerQueues[nextWorker]->jobs.push_back( Job( taskId, i ) );
+                    nextWorker = (nextWorker + 1u) % numWorkers;
+                }
+                ++numRootTasks;
+            }
+
+            ++itor;
+        }
+
+        assert( (mTasks.empty() || numRootTasks > 0u) &&
+                "TaskGraph has cyclic dependencies. It would never finish!" );
+
+        atomicStore( &mNumPendingTasks, static_cast<long>( mTasks.size() ) );
+    }
+    //-----------------------------------------------------------------------------------
+    void TaskGraph::pushJobs( size_t workerIdx, TaskId taskId )
+    {
+        const Task &task = mTasks[taskId];
+
+        WorkerQueue *queue = mWorkerQueues[workerIdx];
+        ScopedLock lock( queue->mutex );
+
+        //Push in reverse so that we pop the first slices, and thieves take the last ones.
+        for( uint32 i=task.numSlices; i--; )
+            queue->jobs.push_back( Job( taskId, i ) );
+    }
+    //-----------------------------------------------------------------------------------
+    bool TaskGraph::popJob( size_t workerIdx, Job &outJob )
+    {
+        bool retVal = false;
+
+        WorkerQueue *queue = mWorkerQueues[workerIdx];
+        ScopedLock lock( queue->mutex );
+
+        if( !queue->jobs.empty() )
+        {
+            outJob = queue->jobs.back();
+            queue->jobs.pop_back();
+            retVal = true;
+        }
+
+        return retVal;
+    }
+    //-----------------------------------------------------------------------------------
+    bool TaskGraph::stealJob( size_t workerIdx, Job &outJob )
+    {
+        const size_t numWorkers = mWorkerQueues.size();
+
+        for( size_t i=1u; i<numWorkers; ++i )
+        {
+            WorkerQueue *queue = mWorkerQueues[(workerIdx + i) % numWorkers];
+
+            //Don't fight over a queue someone else is already working with. Try the next one.
+            if( queue->mutex.tryLock() )
+            {
+                bool stolen = false;
+                if( !queue->jobs.empty() )
+                {
+                    outJob = queue->jobs.front();
+                    queue->jobs.pop_front();
+                    stolen = true;
+                }
+                queue->mutex.unlock();
+
+                if( stolen )
+                    return true;
+            }
+        }
+
+        return false;
+    }
+    //-----------------------------------------------------------------------------------
+    void TaskGraph::runJob( size_t workerIdx, const Job &job )
+    {
+        Task &task = mTasks[job.taskId];
+        {
+            OgreProfileExhaustive( "TaskGraph::runJob" );
+            task.task->execute( job.sliceIdx, task.numSlices );
+        }
+
+        ScopedLock lock( mGraphMutex );
+        if( --task.numPendingSlices == 0u )
+        {
+            FastArray<TaskId>::const_iterator itor = task.successors.begin();
+            FastArray<TaskId>::const_iterator end  = task.successors.end();
+
+            while( itor != end )
+            {
+                Task &successor = mTasks[*itor];
+                if( --successor.numPendingDependencies == 0u )
+                    pushJobs( workerIdx, *itor );
+                ++itor;
+            }
+
+            //Must be decremented after pushing the successors, otherwise
+            //other workers may think we're done and leave.
+            atomicDecrement( &mNumPendingTasks );
+        }
+    }
+    //-----------------------------------------------------------------------------------
+    void TaskGraph::_executeWorker( size_t workerIdx )
+    {
+        //Time outside this sample is time spent waiting in the barriers
+        OgreProfile( "TaskGraph::_executeWorker" );
+
+        Job job;
+        while( atomicLoad( &mNumPendingTasks ) )
+        {
+            if( popJob( workerIdx, job ) || stealJob( workerIdx, job ) )
+                runJob( workerIdx, job );
+            else
+            {
+                //Nothing is ready yet; the remaining tasks are waiting on slices other
+                //workers are running. Give up our time slice in case we're oversubscribed
+                Threads::Sleep( 0 );
+            }
+        }
+    }
+}
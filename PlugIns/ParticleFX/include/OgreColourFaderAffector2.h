@@ -123,6 +123,12 @@ namespace Ogre {
         /** See ParticleAffector. */
         void _affectParticles(ParticleSystem* pSystem, Real timeElapsed);
 
+        /** See ParticleAffector. */
+        bool _supportsArrayParticles(void) const { return true; }
+
+        /** See ParticleAffector. */
+        void _affectArrayParticles(ArrayParticleData& particles, Real timeElapsed);
+
         /** Sets the colour adjustment to be made per second to particles. 
         @param red, green, blue, alpha
             Sets the adjustment to be made to each of the colour components per second. These
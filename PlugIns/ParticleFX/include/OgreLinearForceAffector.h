@@ -80,6 +80,12 @@ namespace Ogre {
         /** See ParticleAffector. */
         void _affectParticles(ParticleSystem* pSystem, Real timeElapsed);
 
+        /** See ParticleAffector. */
+        bool _supportsArrayParticles(void) const { return true; }
+
+        /** See ParticleAffector. */
+        void _affectArrayParticles(ArrayParticleData& particles, Real timeElapsed);
+
 
         /** Sets the force vector to apply to the particles in a system. */
         void setForceVector(const Vector3& force);
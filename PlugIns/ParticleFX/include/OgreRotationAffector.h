@@ -85,6 +85,12 @@ namespace Ogre {
         /** See ParticleAffector. */
         void _affectParticles(ParticleSystem* pSystem, Real timeElapsed);
 
+        /** See ParticleAffector. */
+        bool _supportsArrayParticles(void) const { return true; }
+
+        /** See ParticleAffector. */
+        void _affectArrayParticles(ArrayParticleData& particles, Real timeElapsed);
+
 
 
         /** Sets the minimum rotation speed of particles to be emitted. */
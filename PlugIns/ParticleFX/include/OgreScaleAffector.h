@@ -58,6 +58,12 @@ namespace Ogre {
         /** See ParticleAffector. */
         void _affectParticles(ParticleSystem* pSystem, Real timeElapsed);
 
+        /** See ParticleAffector. */
+        bool _supportsArrayParticles(void) const { return true; }
+
+        /** See ParticleAffector. */
+        void _affectArrayParticles(ArrayParticleData& particles, Real timeElapsed);
+
         /** Sets the scale adjustment to be made per second to particles. 
         @param rate
             Sets the adjustment to be made to the x and y scale components per second. These
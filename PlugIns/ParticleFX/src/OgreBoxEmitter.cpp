@@ -26,6 +26,7 @@ THE SOFTWARE.
 -----------------------------------------------------------------------------
 */
 #include "OgreBoxEmitter.h"
+#include "OgreParticleSystem.h"
 #include "OgreParticle.h"
 #include "OgreException.h"
 #include "OgreStringConverter.h"
@@ -49,9 +50,9 @@ namespace Ogre {
         // Call superclass
         ParticleEmitter::_initParticle(pParticle);
 
-        xOff = Math::SymmetricRandom() * mXRange;
-        yOff = Math::SymmetricRandom() * mYRange;
-        zOff = Math::SymmetricRandom() * mZRange;
+        xOff = mParent->_getSymmetricRandom() * mXRange;
+        yOff = mParent->_getSymmetricRandom() * mYRange;
+        zOff = mParent->_getSymmetricRandom() * mZRange;
 
         pParticle->mPosition = mPosition + xOff + yOff + zOff;
         
@@ -29,6 +29,8 @@ THE SOFTWARE.
 #include "OgreParticleSystem.h"
 #include "OgreStringConverter.h"
 #include "OgreParticle.h"
+#include "OgreArrayParticleData.h"
+#include "Math/Array/OgreMathlib.h"
 
 
 namespace Ogre {
@@ -90,6 +92,30 @@ namespace Ogre {
 
     }
     //-----------------------------------------------------------------------
+    /// SIMD version of ColourFaderAffector::applyAdjustWithClamp
+    static inline void arrayAdjustWithClamp(ArrayReal& component, ArrayReal adjust)
+    {
+        component = Mathlib::Min(Mathlib::Max(component + adjust, ARRAY_REAL_ZERO), Mathlib::ONE);
+    }
+    //-----------------------------------------------------------------------
+    void ColourFaderAffector::_affectArrayParticles(ArrayParticleData& particles, Real timeElapsed)
+    {
+        // Scale adjustments by time
+        const ArrayReal dr = Mathlib::SetAll(mRedAdj * timeElapsed);
+        const ArrayReal dg = Mathlib::SetAll(mGreenAdj * timeElapsed);
+        const ArrayReal db = Mathlib::SetAll(mBlueAdj * timeElapsed);
+        const ArrayReal da = Mathlib::SetAll(mAlphaAdj * timeElapsed);
+
+        const size_t numBlocks = particles.getNumBlocks();
+        for (size_t i = 0; i < numBlocks; ++i)
+        {
+            arrayAdjustWithClamp(particles.mColourR[i], dr);
+            arrayAdjustWithClamp(particles.mColourG[i], dg);
+            arrayAdjustWithClamp(particles.mColourB[i], db);
+            arrayAdjustWithClamp(particles.mColourA[i], da);
+        }
+    }
+    //-----------------------------------------------------------------------
     void ColourFaderAffector::setAdjust(float red, float green, float blue, float alpha)
     {
         mRedAdj = red;
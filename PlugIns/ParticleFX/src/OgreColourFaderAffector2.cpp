@@ -29,6 +29,8 @@ THE SOFTWARE.
 #include "OgreParticleSystem.h"
 #include "OgreStringConverter.h"
 #include "OgreParticle.h"
+#include "OgreArrayParticleData.h"
+#include "Math/Array/OgreMathlib.h"
 
 
 namespace Ogre {
@@ -139,6 +141,40 @@ namespace Ogre {
 
     }
     //-----------------------------------------------------------------------
+    /// SIMD version of ColourFaderAffector2::applyAdjustWithClamp
+    static inline void arrayAdjustWithClamp(ArrayReal& component, ArrayReal adjust)
+    {
+        component = Mathlib::Min(Mathlib::Max(component + adjust, ARRAY_REAL_ZERO), Mathlib::ONE);
+    }
+    //-----------------------------------------------------------------------
+    void ColourFaderAffector2::_affectArrayParticles(ArrayParticleData& particles, Real timeElapsed)
+    {
+        // Scale adjustments by time
+        const ArrayReal dr1 = Mathlib::SetAll(mRedAdj1   * timeElapsed);
+        const ArrayReal dg1 = Mathlib::SetAll(mGreenAdj1 * timeElapsed);
+        const ArrayReal db1 = Mathlib::SetAll(mBlueAdj1  * timeElapsed);
+        const ArrayReal da1 = Mathlib::SetAll(mAlphaAdj1 * timeElapsed);
+
+        const ArrayReal dr2 = Mathlib::SetAll(mRedAdj2   * timeElapsed);
+        const ArrayReal dg2 = Mathlib::SetAll(mGreenAdj2 * timeElapsed);
+        const ArrayReal db2 = Mathlib::SetAll(mBlueAdj2  * timeElapsed);
+        const ArrayReal da2 = Mathlib::SetAll(mAlphaAdj2 * timeElapsed);
+
+        const ArrayReal stateChangeVal = Mathlib::SetAll(StateChangeVal);
+
+        const size_t numBlocks = particles.getNumBlocks();
+        for (size_t i = 0; i < numBlocks; ++i)
+        {
+            // Pick the first or second set of adjustments per particle
+            const ArrayMaskR firstState = Mathlib::CompareGreater(particles.mTimeToLive[i],
+                                                                  stateChangeVal);
+            arrayAdjustWithClamp(particles.mColourR[i], Mathlib::Cmov4(dr1, dr2, firstState));
+            arrayAdjustWithClamp(particles.mColourG[i], Mathlib::Cmov4(dg1, dg2, firstState));
+            arrayAdjustWithClamp(particles.mColourB[i], Mathlib::Cmov4(db1, db2, firstState));
+            arrayAdjustWithClamp(particles.mColourA[i], Mathlib::Cmov4(da1, da2, firstState));
+        }
+    }
+    //-----------------------------------------------------------------------
     void ColourFaderAffector2::setAdjust1(float red, float green, float blue, float alpha)
     {
         mRedAdj1 = red;
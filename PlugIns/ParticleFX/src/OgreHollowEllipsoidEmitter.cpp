@@ -27,6 +27,7 @@ THE SOFTWARE.
 */
 // Original author: Tels <http://bloodgate.com>, released as public domain
 #include "OgreHollowEllipsoidEmitter.h"
+#include "OgreParticleSystem.h"
 #include "OgreParticle.h"
 #include "OgreException.h"
 #include "OgreStringConverter.h"
@@ -78,15 +79,15 @@ namespace Ogre {
         // create two random angles alpha and beta
         // with these two angles, we are able to select any point on an
         // ellipsoid's surface
-        Radian alpha ( Math::RangeRandom(0,Math::TWO_PI) );
-        Radian beta  ( Math::RangeRandom(0,Math::PI) );
+        Radian alpha ( mParent->_getRangeRandom(0,Math::TWO_PI) );
+        Radian beta  ( mParent->_getRangeRandom(0,Math::PI) );
 
         // create three random radius values that are bigger than the inner
         // size, but smaller/equal than/to the outer size 1.0 (inner size is
         // between 0 and 1)
-        a = Math::RangeRandom(mInnerSize.x,1.0);
-        b = Math::RangeRandom(mInnerSize.y,1.0);
-        c = Math::RangeRandom(mInnerSize.z,1.0);
+        a = mParent->_getRangeRandom(mInnerSize.x,1.0);
+        b = mParent->_getRangeRandom(mInnerSize.y,1.0);
+        c = mParent->_getRangeRandom(mInnerSize.z,1.0);
 
         // with a,b,c we have defined a random ellipsoid between the inner
         // ellipsoid and the outer sphere (radius 1.0)
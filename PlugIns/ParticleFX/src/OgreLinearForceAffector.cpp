@@ -28,6 +28,8 @@ THE SOFTWARE.
 #include "OgreLinearForceAffector.h"
 #include "OgreParticleSystem.h"
 #include "OgreParticle.h"
+#include "OgreArrayParticleData.h"
+#include "Math/Array/OgreMathlib.h"
 #include "OgreStringConverter.h"
 
 
@@ -95,6 +97,30 @@ namespace Ogre {
         
     }
     //-----------------------------------------------------------------------
+    void LinearForceAffector::_affectArrayParticles(ArrayParticleData& particles, Real timeElapsed)
+    {
+        ArrayVector3 * RESTRICT_ALIAS direction = particles.mDirection;
+        const size_t numBlocks = particles.getNumBlocks();
+
+        if (mForceApplication == FA_ADD)
+        {
+            // Precalc scaled force for optimisation
+            ArrayVector3 scaledVector;
+            scaledVector.setAll(mForceVector * timeElapsed);
+
+            for (size_t i = 0; i < numBlocks; ++i)
+                direction[i] += scaledVector;
+        }
+        else // FA_AVERAGE
+        {
+            ArrayVector3 forceVector;
+            forceVector.setAll(mForceVector);
+
+            for (size_t i = 0; i < numBlocks; ++i)
+                direction[i] = (direction[i] + forceVector) * Mathlib::HALF;
+        }
+    }
+    //-----------------------------------------------------------------------
     void LinearForceAffector::setForceVector(const Vector3& force)
     {
         mForceVector = force;
@@ -27,6 +27,7 @@ THE SOFTWARE.
 */
 // Original author: Tels <http://bloodgate.com>, released as public domain
 #include "OgreRingEmitter.h"
+#include "OgreParticleSystem.h"
 #include "OgreParticle.h"
 #include "OgreException.h"
 #include "OgreStringConverter.h"
@@ -65,11 +66,11 @@ namespace Ogre {
         // Call superclass
         AreaEmitter::_initParticle(pParticle);
         // create a random angle from 0 .. PI*2
-        Radian alpha ( Math::RangeRandom(0,Math::TWO_PI) );
+        Radian alpha ( mParent->_getRangeRandom(0,Math::TWO_PI) );
   
         // create two random radius values that are bigger than the inner size
-        a = Math::RangeRandom(mInnerSizex,1.0);
-        b = Math::RangeRandom(mInnerSizey,1.0);
+        a = mParent->_getRangeRandom(mInnerSizex,1.0);
+        b = mParent->_getRangeRandom(mInnerSizey,1.0);
 
         // with a and b we have defined a random ellipse inside the inner
         // ellipse and the outer circle (radius 1.0)
@@ -78,7 +79,7 @@ namespace Ogre {
         x = a * Math::Sin(alpha);
         y = b * Math::Cos(alpha);
         // the height is simple -1 to 1
-        z = Math::SymmetricRandom();     
+        z = mParent->_getSymmetricRandom();     
 
         // scale the found point to the ring's size and move it
         // relatively to the center of the emitter point
@@ -29,6 +29,8 @@ THE SOFTWARE.
 #include "OgreParticleSystem.h"
 #include "OgreStringConverter.h"
 #include "OgreParticle.h"
+#include "OgreArrayParticleData.h"
+#include "Math/Array/OgreMathlib.h"
 
 
 namespace Ogre {
@@ -77,11 +79,11 @@ namespace Ogre {
     {
         pParticle->setRotation(
             mRotationRangeStart + 
-            (Math::UnitRandom() * 
+            (mParent->_getUnitRandom() * 
                 (mRotationRangeEnd - mRotationRangeStart)));
         pParticle->mRotationSpeed =
             mRotationSpeedRangeStart + 
-            (Math::UnitRandom() * 
+            (mParent->_getUnitRandom() * 
                 (mRotationSpeedRangeEnd - mRotationSpeedRangeStart));
         
     }
@@ -107,6 +109,18 @@ namespace Ogre {
 
     }
     //-----------------------------------------------------------------------
+    void RotationAffector::_affectArrayParticles(ArrayParticleData& particles, Real timeElapsed)
+    {
+        // Rotation adjustments by time
+        const ArrayReal ds = Mathlib::SetAll(timeElapsed);
+
+        const size_t numBlocks = particles.getNumBlocks();
+        for (size_t i = 0; i < numBlocks; ++i)
+            particles.mRotation[i] = particles.mRotation[i] + ds * particles.mRotationSpeed[i];
+
+        particles.mRotationChanged = true;
+    }
+    //-----------------------------------------------------------------------
     const Radian& RotationAffector::getRotationSpeedRangeStart(void) const
     {
         return mRotationSpeedRangeStart;
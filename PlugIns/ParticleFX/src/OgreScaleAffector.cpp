@@ -29,6 +29,8 @@ THE SOFTWARE.
 #include "OgreParticleSystem.h"
 #include "OgreStringConverter.h"
 #include "OgreParticle.h"
+#include "OgreArrayParticleData.h"
+#include "Math/Array/OgreMathlib.h"
 
 
 namespace Ogre {
@@ -85,6 +87,22 @@ namespace Ogre {
 
     }
     //-----------------------------------------------------------------------
+    void ScaleAffector::_affectArrayParticles(ArrayParticleData& particles, Real timeElapsed)
+    {
+        // Scale adjustments by time
+        const ArrayReal ds = Mathlib::SetAll(mScaleAdj * timeElapsed);
+
+        // Particles without their own dimensions already hold the default ones
+        const size_t numBlocks = particles.getNumBlocks();
+        for (size_t i = 0; i < numBlocks; ++i)
+        {
+            particles.mWidth[i]  = particles.mWidth[i] + ds;
+            particles.mHeight[i] = particles.mHeight[i] + ds;
+        }
+
+        particles.mDimensionsChanged = true;
+    }
+    //-----------------------------------------------------------------------
     void ScaleAffector::setAdjust( Real rate )
     {
         mScaleAdj = rate;
@@ -107,6 +107,8 @@ namespace Ogre
                                          const QueuedRenderable &queuedRenderable,
                                          bool casterPass, uint32 lastCacheHash,
                                          CommandBuffer *commandBuffer );
+        /// HlmsPbs::fillBuffersForV2Mt would fill Terra's buffers with Pbs' code.
+        virtual bool supportsParallelFillBuffers(void) const        { return false; }
 
         static void getDefaultPaths( String& outDataFolderPath, StringVector& outLibraryFoldersPaths );
 
@@ -0,0 +1,60 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#ifndef _AnimationBenchmark_H_
+#define _AnimationBenchmark_H_
+
+#include "OgrePrerequisites.h"
+
+namespace Ogre
+{
+    class BenchmarkResults;
+
+    /** Measures SceneManager::updateAllAnimations on skeleton instances playing one looping
+        animation, each with a chain of c_numBones bones (built in code, no media needed).
+    @remarks
+        Named "Animation.updateAllAnimations". The config's 'bones' value is the total
+        number of bones across all instances.
+    */
+    class AnimationBenchmark
+    {
+        SceneManager    *mSceneManager;
+        size_t          mNumInstances;
+        size_t          mNumIterations;
+
+    public:
+        static const size_t c_numBones = 32u;
+
+        AnimationBenchmark( SceneManager *sceneManager, size_t numInstances, size_t numIterations );
+
+        /// Runs the benchmark and adds its timings to results.
+        void run( BenchmarkResults &results );
+    };
+}
+
+#endif
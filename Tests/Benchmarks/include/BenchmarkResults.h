@@ -0,0 +1,96 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#ifndef _BenchmarkResults_H_
+#define _BenchmarkResults_H_
+
+#include "OgrePrerequisites.h"
+#include "ogrestd/vector.h"
+
+namespace Ogre
+{
+    /** Collects the timings of all benchmarks, writes them in a machine readable form and
+        compares them against regression thresholds.
+    @remarks
+        Each entry is identified by its name (i.e. "SceneGraph.updateAllTransforms") and its
+        configuration (i.e. "objects=10000 threads=4"), which together form the key used by
+        the thresholds file.
+    @par
+        The results file is CSV with a header:
+            name,config,iterations,avg_ms,min_ms,max_ms
+    @par
+        The thresholds file has one entry per line, in the form:
+            name,config,max_avg_ms
+        Empty lines and lines starting with '#' are ignored. An entry fails when its avg_ms
+        is above max_avg_ms. Entries without a threshold always pass, and thresholds
+        without a matching entry are reported but don't fail.
+    */
+    class BenchmarkResults
+    {
+    public:
+        struct Entry
+        {
+            String  name;
+            String  config;
+            size_t  iterations;
+            double  avgMs;
+            double  minMs;
+            double  maxMs;
+        };
+        typedef vector<Entry>::type EntryVec;
+
+    protected:
+        EntryVec    mEntries;
+
+    public:
+        /** Adds an entry and logs it.
+        @param samplesUs
+            Duration of each iteration, in microseconds. Warm up iterations must
+            already be excluded. Can't be empty.
+        */
+        void add( const String &name, const String &config, const vector<uint64>::type &samplesUs );
+
+        const EntryVec& getEntries(void) const          { return mEntries; }
+
+        /// Writes all entries as CSV. Returns false if the file couldn't be opened.
+        bool writeCsv( const String &filename ) const;
+
+        /** Compares the entries against the thresholds in the given file, logging every
+            regression.
+        @return
+            Number of entries above their threshold. Returns 1 if the file can't be read,
+            so that a missing file doesn't go unnoticed in CI.
+        */
+        size_t checkThresholds( const String &filename ) const;
+    };
+
+    /// Helper to build the config string of an entry.
+    String benchmarkConfig( const char *key0, size_t value0, const char *key1 = 0, size_t value1 = 0 );
+}
+
+#endif
@@ -0,0 +1,151 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "AnimationBenchmark.h"
+#include "BenchmarkResults.h"
+
+#include "OgreSceneManager.h"
+#include "OgreSceneNode.h"
+#include "OgreOldSkeletonManager.h"
+#include "OgreSkeleton.h"
+#include "OgreOldBone.h"
+#include "OgreAnimation.h"
+#include "OgreAnimationTrack.h"
+#include "OgreKeyFrame.h"
+#include "OgreTimer.h"
+#include "Animation/OgreSkeletonDef.h"
+#include "Animation/OgreSkeletonInstance.h"
+#include "Animation/OgreSkeletonAnimation.h"
+
+namespace Ogre
+{
+    const size_t AnimationBenchmark::c_numBones;
+
+    static const size_t c_numKeyFrames = 16u;
+    static const Real c_animationLength = 2.0f;
+    //-------------------------------------------------------------------------
+    AnimationBenchmark::AnimationBenchmark( SceneManager *sceneManager, size_t numInstances,
+                                            size_t numIterations ) :
+        mSceneManager( sceneManager ),
+        mNumInstances( std::max<size_t>( numInstances, 1u ) ),
+        mNumIterations( std::max<size_t>( numIterations, 1u ) )
+    {
+    }
+    //-------------------------------------------------------------------------
+    void AnimationBenchmark::run( BenchmarkResults &results )
+    {
+        v1::SkeletonPtr skeleton = v1::OldSkeletonManager::getSingleton().create(
+                    "AnimationBenchmark.skeleton",
+                    ResourceGroupManager::INTERNAL_RESOURCE_GROUP_NAME, true );
+
+        v1::OldBone *bone = skeleton->createBone( 0 );
+        for( size_t i=1u; i<c_numBones; ++i )
+            bone = bone->createChild( static_cast<unsigned short>( i ), Vector3( 0, 1, 0 ) );
+        skeleton->setBindingPose();
+
+        v1::Animation *animation = skeleton->createAnimation( "Benchmark", c_animationLength );
+        for( size_t i=0; i<c_numBones; ++i )
+        {
+            const unsigned short handle = static_cast<unsigned short>( i );
+            v1::OldNodeAnimationTrack *track = animation->createOldNodeTrack(
+                        handle, skeleton->getBone( handle ) );
+            for( size_t j=0; j<c_numKeyFrames; ++j )
+            {
+                const Real t = j / Real( c_numKeyFrames - 1u );
+                v1::TransformKeyFrame *keyFrame = track->createNodeKeyFrame( t * c_animationLength );
+                keyFrame->setRotation( Quaternion( Degree( Math::Sin( t * Math::TWO_PI ) * 30.0f ),
+                                                   Vector3::UNIT_Z ) );
+                keyFrame->setTranslate( Vector3( 0, t * 0.1f, 0 ) );
+            }
+        }
+
+        SkeletonDefPtr skeletonDef( new SkeletonDef( skeleton.get(), 1.0f ) );
+        v1::OldSkeletonManager::getSingleton().remove( skeleton->getHandle() );
+        skeleton.setNull();
+
+        SceneNode *rootNode = mSceneManager->getRootSceneNode( SCENE_DYNAMIC );
+
+        vector<SceneNode*>::type nodes;
+        vector<SkeletonInstance*>::type instances;
+        vector<SkeletonAnimation*>::type animations;
+        nodes.reserve( mNumInstances );
+        instances.reserve( mNumInstances );
+        animations.reserve( mNumInstances );
+
+        for( size_t i=0; i<mNumInstances; ++i )
+        {
+            nodes.push_back( rootNode->createChildSceneNode( SCENE_DYNAMIC,
+                                                             Vector3( Real( i % 256u ), 0,
+                                                                      Real( i / 256u ) ) ) );
+            instances.push_back( mSceneManager->createSkeletonInstance( skeletonDef.get() ) );
+            instances.back()->setParentNode( nodes.back() );
+
+            SkeletonAnimation *skelAnim = instances.back()->getAnimation( "Benchmark" );
+            skelAnim->setEnabled( true );
+            skelAnim->setLoop( true );
+            //Spread the instances across the timeline, but deterministically.
+            skelAnim->setTime( (i % c_numKeyFrames) * (c_animationLength / c_numKeyFrames) );
+            animations.push_back( skelAnim );
+        }
+
+        mSceneManager->updateAllTransforms();
+
+        vector<uint64>::type samplesUs;
+        samplesUs.reserve( mNumIterations );
+        Timer timer;
+
+        //First iteration is a warm up
+        for( size_t i=0; i<mNumIterations + 1u; ++i )
+        {
+            vector<SkeletonAnimation*>::type::const_iterator itor = animations.begin();
+            vector<SkeletonAnimation*>::type::const_iterator end  = animations.end();
+            while( itor != end )
+                (*itor++)->addTime( 1.0f / 60.0f );
+
+            const uint64 startUs = timer.getMicroseconds();
+            mSceneManager->updateAllAnimations();
+            const uint64 elapsedUs = timer.getMicroseconds() - startUs;
+
+            if( i != 0u )
+                samplesUs.push_back( elapsedUs );
+        }
+
+        results.add( "Animation.updateAllAnimations",
+                     benchmarkConfig( "bones", mNumInstances * c_numBones,
+                                      "threads", mSceneManager->getNumWorkerThreads() ),
+                     samplesUs );
+
+        for( size_t i=0; i<mNumInstances; ++i )
+        {
+            mSceneManager->destroySkeletonInstance( instances[i] );
+            mSceneManager->destroySceneNode( nodes[i] );
+        }
+
+        mSceneManager->_removeSkeletonDef( skeletonDef.get() );
+    }
+}
@@ -0,0 +1,168 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "BenchmarkResults.h"
+
+#include "OgreLogManager.h"
+#include "OgreStringConverter.h"
+#include "OgreString.h"
+
+#include <fstream>
+
+namespace Ogre
+{
+    void BenchmarkResults::add( const String &name, const String &config,
+                                const vector<uint64>::type &samplesUs )
+    {
+        assert( !samplesUs.empty() );
+
+        uint64 totalUs  = 0;
+        uint64 minUs    = std::numeric_limits<uint64>::max();
+        uint64 maxUs    = 0;
+
+        vector<uint64>::type::const_iterator itor = samplesUs.begin();
+        vector<uint64>::type::const_iterator end  = samplesUs.end();
+        while( itor != end )
+        {
+            totalUs += *itor;
+            minUs = std::min( minUs, *itor );
+            maxUs = std::max( maxUs, *itor );
+            ++itor;
+        }
+
+        Entry entry;
+        entry.name          = name;
+        entry.config        = config;
+        entry.iterations    = samplesUs.size();
+        entry.avgMs         = (double)totalUs / (double)samplesUs.size() / 1000.0;
+        entry.minMs         = minUs / 1000.0;
+        entry.maxMs         = maxUs / 1000.0;
+        mEntries.push_back( entry );
+
+        LogManager::getSingleton().logMessage(
+                    name + " " + config +
+                    " avg_ms=" + StringConverter::toString( entry.avgMs ) +
+                    " min_ms=" + StringConverter::toString( entry.minMs ) +
+                    " max_ms=" + StringConverter::toString( entry.maxMs ) );
+    }
+    //-------------------------------------------------------------------------
+    bool BenchmarkResults::writeCsv( const String &filename ) const
+    {
+        std::ofstream file( filename.c_str(), std::ios::out | std::ios::trunc );
+        if( !file.is_open() )
+        {
+            LogManager::getSingleton().logMessage( "Could not write benchmark results to " +
+                                                   filename, LML_CRITICAL );
+            return false;
+        }
+
+        file << "name,config,iterations,avg_ms,min_ms,max_ms\n";
+
+        EntryVec::const_iterator itor = mEntries.begin();
+        EntryVec::const_iterator end  = mEntries.end();
+        while( itor != end )
+        {
+            file << itor->name << ',' << itor->config << ',' << itor->iterations << ','
+                 << itor->avgMs << ',' << itor->minMs << ',' << itor->maxMs << '\n';
+            ++itor;
+        }
+
+        return true;
+    }
+    //-------------------------------------------------------------------------
+    size_t BenchmarkResults::checkThresholds( const String &filename ) const
+    {
+        std::ifstream file( filename.c_str() );
+        if( !file.is_open() )
+        {
+            LogManager::getSingleton().logMessage( "Could not read benchmark thresholds from " +
+                                                   filename, LML_CRITICAL );
+            return 1u;
+        }
+
+        size_t numFailures = 0;
+
+        String line;
+        while( std::getline( file, line ) )
+        {
+            StringUtil::trim( line );
+            if( line.empty() || line[0] == '#' )
+                continue;
+
+            const StringVector tokens = StringUtil::split( line, "," );
+            if( tokens.size() != 3u )
+            {
+                LogManager::getSingleton().logMessage( "Ignoring malformed threshold: " + line,
+                                                       LML_CRITICAL );
+                continue;
+            }
+
+            String name     = tokens[0];
+            String config   = tokens[1];
+            StringUtil::trim( name );
+            StringUtil::trim( config );
+            const double maxAvgMs = StringConverter::parseReal( tokens[2], 0 );
+
+            bool found = false;
+            EntryVec::const_iterator itor = mEntries.begin();
+            EntryVec::const_iterator end  = mEntries.end();
+            while( itor != end && !found )
+            {
+                if( itor->name == name && itor->config == config )
+                {
+                    found = true;
+                    if( itor->avgMs > maxAvgMs )
+                    {
+                        ++numFailures;
+                        LogManager::getSingleton().logMessage(
+                                    "REGRESSION: " + name + " " + config + " avg_ms=" +
+                                    StringConverter::toString( itor->avgMs ) + " > " +
+                                    StringConverter::toString( maxAvgMs ), LML_CRITICAL );
+                    }
+                }
+                ++itor;
+            }
+
+            if( !found )
+            {
+                LogManager::getSingleton().logMessage( "Threshold without results: " + line,
+                                                       LML_NORMAL );
+            }
+        }
+
+        return numFailures;
+    }
+    //-------------------------------------------------------------------------
+    String benchmarkConfig( const char *key0, size_t value0, const char *key1, size_t value1 )
+    {
+        String retVal = String( key0 ) + "=" + StringConverter::toString( value0 );
+        if( key1 )
+            retVal += String( " " ) + key1 + "=" + StringConverter::toString( value1 );
+        return retVal;
+    }
+}
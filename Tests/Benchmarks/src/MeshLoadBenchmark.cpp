@@ -0,0 +1,171 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "MeshLoadBenchmark.h"
+#include "BenchmarkResults.h"
+
+#include "OgreRoot.h"
+#include "OgreMesh2.h"
+#include "OgreSubMesh2.h"
+#include "OgreMeshManager2.h"
+#include "OgreMesh2Serializer.h"
+#include "OgreDataStream.h"
+#include "OgreTimer.h"
+#include "Vao/OgreVaoManager.h"
+
+#include <fstream>
+#include <cstdio>
+
+namespace Ogre
+{
+    static const char *c_tmpMeshFilename = "MeshLoadBenchmark.tmp.mesh";
+    //-------------------------------------------------------------------------
+    MeshLoadBenchmark::MeshLoadBenchmark( size_t numVertices, size_t numIterations ) :
+        mNumVertices( numVertices ),
+        mNumIterations( std::max<size_t>( numIterations, 1u ) )
+    {
+    }
+    //-------------------------------------------------------------------------
+    MeshPtr MeshLoadBenchmark::createSourceMesh( VaoManager *vaoManager ) const
+    {
+        const size_t side = std::max<size_t>( (size_t)Math::Sqrt( Real( mNumVertices ) ), 2u );
+        const size_t numVertices = side * side;
+        const size_t numIndices = (side - 1u) * (side - 1u) * 6u;
+
+        VertexElement2Vec vertexElements;
+        vertexElements.push_back( VertexElement2( VET_FLOAT3, VES_POSITION ) );
+        vertexElements.push_back( VertexElement2( VET_FLOAT3, VES_NORMAL ) );
+        vertexElements.push_back( VertexElement2( VET_FLOAT2, VES_TEXTURE_COORDINATES ) );
+
+        //Ownership of both buffers goes to the VaoManager (keepAsShadow = true)
+        float *vertexData = reinterpret_cast<float*>(
+                    OGRE_MALLOC_SIMD( numVertices * 8u * sizeof(float), MEMCATEGORY_GEOMETRY ) );
+        uint32 *indexData = reinterpret_cast<uint32*>(
+                    OGRE_MALLOC_SIMD( numIndices * sizeof(uint32), MEMCATEGORY_GEOMETRY ) );
+
+        float *vertex = vertexData;
+        for( size_t y=0; y<side; ++y )
+        {
+            for( size_t x=0; x<side; ++x )
+            {
+                const float u = x / float( side - 1u );
+                const float v = y / float( side - 1u );
+                *vertex++ = u * 2.0f - 1.0f;
+                *vertex++ = Math::Sin( u * Math::TWO_PI ) * 0.1f;
+                *vertex++ = v * 2.0f - 1.0f;
+                *vertex++ = 0.0f;
+                *vertex++ = 1.0f;
+                *vertex++ = 0.0f;
+                *vertex++ = u;
+                *vertex++ = v;
+            }
+        }
+
+        uint32 *index = indexData;
+        for( size_t y=0; y<side - 1u; ++y )
+        {
+            for( size_t x=0; x<side - 1u; ++x )
+            {
+                const uint32 i0 = static_cast<uint32>( y * side + x );
+                const uint32 i1 = static_cast<uint32>( i0 + side );
+                *index++ = i0;
+                *index++ = i1;
+                *index++ = i0 + 1u;
+                *index++ = i0 + 1u;
+                *index++ = i1;
+                *index++ = i1 + 1u;
+            }
+        }
+
+        VertexBufferPackedVec vertexBuffers;
+        vertexBuffers.push_back( vaoManager->createVertexBuffer( vertexElements, numVertices,
+                                                                 BT_IMMUTABLE, vertexData, true ) );
+        IndexBufferPacked *indexBuffer = vaoManager->createIndexBuffer( IndexBufferPacked::IT_32BIT,
+                                                                        numIndices, BT_IMMUTABLE,
+                                                                        indexData, true );
+        VertexArrayObject *vao = vaoManager->createVertexArrayObject( vertexBuffers, indexBuffer,
+                                                                      OT_TRIANGLE_LIST );
+
+        MeshPtr mesh = MeshManager::getSingleton().createManual(
+                    "MeshLoadBenchmark Source", ResourceGroupManager::INTERNAL_RESOURCE_GROUP_NAME );
+        SubMesh *subMesh = mesh->createSubMesh();
+        subMesh->mVao[VpNormal].push_back( vao );
+        subMesh->mVao[VpShadow].push_back( vao );
+        mesh->_setBounds( Aabb( Vector3::ZERO, Vector3( 1.0f, 0.1f, 1.0f ) ), false );
+        mesh->_setBoundingSphereRadius( Math::Sqrt( 2.01f ) );
+
+        return mesh;
+    }
+    //-------------------------------------------------------------------------
+    void MeshLoadBenchmark::run( BenchmarkResults &results )
+    {
+        VaoManager *vaoManager = Root::getSingleton().getRenderSystem()->getVaoManager();
+        MeshSerializer meshSerializer( vaoManager );
+
+        size_t numVertices = 0;
+        {
+            MeshPtr sourceMesh = createSourceMesh( vaoManager );
+            numVertices = sourceMesh->getSubMesh( 0 )->mVao[VpNormal][0]->
+                    getVertexBuffers()[0]->getNumElements();
+            meshSerializer.exportMesh( sourceMesh.get(), c_tmpMeshFilename );
+            MeshManager::getSingleton().remove( sourceMesh->getHandle() );
+        }
+
+        DataStreamPtr memoryStream;
+        {
+            std::ifstream *ifs = OGRE_NEW_T( std::ifstream, MEMCATEGORY_GENERAL )(
+                                     c_tmpMeshFilename, std::ios::in | std::ios::binary );
+            DataStreamPtr fileStream( OGRE_NEW FileStreamDataStream( ifs, true ) );
+            memoryStream = DataStreamPtr( OGRE_NEW MemoryDataStream( fileStream ) );
+        }
+        std::remove( c_tmpMeshFilename );
+
+        vector<uint64>::type samplesUs;
+        samplesUs.reserve( mNumIterations );
+        Timer timer;
+
+        //First iteration is a warm up
+        for( size_t i=0; i<mNumIterations + 1u; ++i )
+        {
+            memoryStream->seek( 0 );
+
+            const uint64 startUs = timer.getMicroseconds();
+            MeshPtr mesh = MeshManager::getSingleton().createManual(
+                        "MeshLoadBenchmark Copy", ResourceGroupManager::INTERNAL_RESOURCE_GROUP_NAME );
+            meshSerializer.importMesh( memoryStream, mesh.get() );
+            const uint64 elapsedUs = timer.getMicroseconds() - startUs;
+
+            MeshManager::getSingleton().remove( mesh->getHandle() );
+
+            if( i != 0u )
+                samplesUs.push_back( elapsedUs );
+        }
+
+        results.add( "Mesh.import", benchmarkConfig( "vertices", numVertices ), samplesUs );
+    }
+}
@@ -0,0 +1,207 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "RenderQueueSortBenchmark.h"
+#include "BenchmarkResults.h"
+
+#include "OgreRenderQueue.h"
+#include "OgreSceneManager.h"
+#include "OgreMovableObject.h"
+#include "OgreRenderable.h"
+#include "OgreRoot.h"
+#include "OgreHlmsManager.h"
+#include "OgreHlms.h"
+#include "OgreTimer.h"
+#include "Threading/OgreUniformScalableTask.h"
+#include "Vao/OgreVaoManager.h"
+
+namespace Ogre
+{
+    static const uint8 c_benchmarkRqId = 10u;
+
+    /// Never rendered. Just enough to be accepted by RenderQueue::addRenderableV2
+    class BenchmarkRenderable : public MovableObject, public Renderable
+    {
+        static const String msMovableType;
+
+    public:
+        BenchmarkRenderable( SceneManager *sceneManager, VertexArrayObject *vao,
+                             HlmsDatablock *datablock, uint32 hlmsHash, Real distance ) :
+            MovableObject( Id::generateNewId<MovableObject>(),
+                           &sceneManager->_getEntityMemoryManager( SCENE_DYNAMIC ),
+                           sceneManager, c_benchmarkRqId )
+        {
+            mVaoPerLod[VpNormal].push_back( vao );
+            mVaoPerLod[VpShadow].push_back( vao );
+            //Bypass setDatablock so that we control the shader bits of the hash.
+            mHlmsDatablock  = datablock;
+            mHlmsHash       = hlmsHash;
+            mHlmsCasterHash = hlmsHash;
+            reinterpret_cast<Real*>( mObjectData.mDistanceToCamera )[mObjectData.mIndex] = distance;
+        }
+
+        virtual ~BenchmarkRenderable()
+        {
+            //We never linked ourselves to the datablock
+            mHlmsDatablock = 0;
+        }
+
+        virtual const String& getMovableType(void) const        { return msMovableType; }
+        virtual void getRenderOperation( v1::RenderOperation &op, bool casterPass ) {}
+        virtual void getWorldTransforms( Matrix4 *xform ) const {}
+        virtual const LightList& getLights(void) const          { return queryLights(); }
+        virtual bool getCastsShadows(void) const                { return false; }
+    };
+
+    const String BenchmarkRenderable::msMovableType = "BenchmarkRenderable";
+
+    typedef vector<BenchmarkRenderable*>::type BenchmarkRenderableVec;
+
+    /// Adds the renderables to the RenderQueue from all worker threads, like culling does.
+    class FillRenderQueueTask : public UniformScalableTask
+    {
+        RenderQueue                     *mRenderQueue;
+        const BenchmarkRenderableVec    &mRenderables;
+
+    public:
+        FillRenderQueueTask( RenderQueue *renderQueue, const BenchmarkRenderableVec &renderables ) :
+            mRenderQueue( renderQueue ), mRenderables( renderables ) {}
+
+        virtual void execute( size_t threadId, size_t numThreads )
+        {
+            const size_t start  = (mRenderables.size() * threadId) / numThreads;
+            const size_t end    = (mRenderables.size() * (threadId + 1u)) / numThreads;
+
+            for( size_t i=start; i<end; ++i )
+            {
+                mRenderQueue->addRenderableV2( threadId, c_benchmarkRqId, false,
+                                               mRenderables[i], mRenderables[i] );
+            }
+        }
+    };
+    //-------------------------------------------------------------------------
+    RenderQueueSortBenchmark::RenderQueueSortBenchmark( SceneManager *sceneManager,
+                                                        size_t numRenderables,
+                                                        size_t numIterations ) :
+        mSceneManager( sceneManager ),
+        mNumRenderables( numRenderables ),
+        mNumIterations( std::max<size_t>( numIterations, 1u ) )
+    {
+    }
+    //-------------------------------------------------------------------------
+    void RenderQueueSortBenchmark::run( BenchmarkResults &results )
+    {
+        const size_t c_numMeshes = 256u;
+        const uint32 c_numShaders = 64u;
+
+        VaoManager *vaoManager = Root::getSingleton().getRenderSystem()->getVaoManager();
+        HlmsManager *hlmsManager = Root::getSingleton().getHlmsManager();
+        HlmsDatablock *datablock = hlmsManager->getHlms( HLMS_LOW_LEVEL )->getDefaultDatablock();
+
+        VertexElement2Vec vertexElements;
+        vertexElements.push_back( VertexElement2( VET_FLOAT3, VES_POSITION ) );
+
+        VertexBufferPackedVec vertexBuffers;
+        vector<VertexArrayObject*>::type vaos;
+        vaos.reserve( c_numMeshes );
+        for( size_t i=0; i<c_numMeshes; ++i )
+        {
+            VertexBufferPackedVec vertexBuffer;
+            vertexBuffer.push_back( vaoManager->createVertexBuffer( vertexElements, 3u,
+                                                                    BT_DEFAULT, 0, false ) );
+            vaos.push_back( vaoManager->createVertexArrayObject( vertexBuffer, 0, OT_TRIANGLE_LIST ) );
+            vertexBuffers.push_back( vertexBuffer.back() );
+        }
+
+        //Deterministic pseudo-random distribution, for reproducible results.
+        uint32 seed = 12345u;
+        BenchmarkRenderableVec renderables;
+        renderables.reserve( mNumRenderables );
+        for( size_t i=0; i<mNumRenderables; ++i )
+        {
+            seed = seed * 1664525u + 1013904223u;
+            const uint32 meshIdx    = (seed >> 8u) % c_numMeshes;
+            const uint32 shaderIdx  = (seed >> 16u) % c_numShaders;
+            const Real distance     = Real( (seed >> 4u) & 0xFFFF ) * 0.01f;
+            renderables.push_back( OGRE_NEW BenchmarkRenderable( mSceneManager, vaos[meshIdx],
+                                                                 datablock, shaderIdx, distance ) );
+        }
+
+        RenderQueue *renderQueue = mSceneManager->getRenderQueue();
+        const size_t oldThreshold = renderQueue->getParallelSortThreshold();
+        const bool oldReuse = renderQueue->getReuseSortWhenUnchanged( c_benchmarkRqId );
+
+        FillRenderQueueTask fillTask( renderQueue, renderables );
+
+        const char *modeNames[3] = { "serial", "parallel", "reuse" };
+        Timer timer;
+
+        for( size_t mode=0; mode<3u; ++mode )
+        {
+            renderQueue->setParallelSortThreshold( mode == 0u ? std::numeric_limits<size_t>::max() : 1u );
+            renderQueue->setReuseSortWhenUnchanged( c_benchmarkRqId, mode == 2u );
+
+            vector<uint64>::type samplesUs;
+            samplesUs.reserve( mNumIterations );
+
+            //First iteration is a warm up (allocates the arrays, fills the reuse cache)
+            for( size_t i=0; i<mNumIterations + 1u; ++i )
+            {
+                renderQueue->clear();
+                mSceneManager->executeUserScalableTask( &fillTask, true );
+
+                const uint64 startUs = timer.getMicroseconds();
+                renderQueue->sortRenderQueues( c_benchmarkRqId, c_benchmarkRqId + 1u );
+                const uint64 elapsedUs = timer.getMicroseconds() - startUs;
+
+                if( i != 0u )
+                    samplesUs.push_back( elapsedUs );
+            }
+
+            results.add( "RenderQueue.sort",
+                         benchmarkConfig( "renderables", mNumRenderables,
+                                          "threads", mSceneManager->getNumWorkerThreads() ) +
+                         " mode=" + modeNames[mode], samplesUs );
+        }
+
+        renderQueue->clear();
+        renderQueue->setParallelSortThreshold( oldThreshold );
+        renderQueue->setReuseSortWhenUnchanged( c_benchmarkRqId, oldReuse );
+
+        BenchmarkRenderableVec::const_iterator itor = renderables.begin();
+        BenchmarkRenderableVec::const_iterator end  = renderables.end();
+        while( itor != end )
+            OGRE_DELETE *itor++;
+
+        for( size_t i=0; i<c_numMeshes; ++i )
+        {
+            vaoManager->destroyVertexArrayObject( vaos[i] );
+            vaoManager->destroyVertexBuffer( vertexBuffers[i] );
+        }
+    }
+}
@@ -0,0 +1,209 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "SceneGraphBenchmark.h"
+#include "BenchmarkResults.h"
+
+#include "OgreSceneManager.h"
+#include "OgreSceneNode.h"
+#include "OgreMovableObject.h"
+#include "OgreCamera.h"
+#include "OgreTimer.h"
+#include "Threading/OgreUniformScalableTask.h"
+
+namespace Ogre
+{
+    static const uint8 c_benchmarkRqId = 10u;
+    static const size_t c_childrenPerParent = 16u;
+
+    /// Never rendered. Only has bounds.
+    class BenchmarkObject : public MovableObject
+    {
+        static const String msMovableType;
+
+    public:
+        BenchmarkObject( SceneManager *sceneManager ) :
+            MovableObject( Id::generateNewId<MovableObject>(),
+                           &sceneManager->_getEntityMemoryManager( SCENE_DYNAMIC ),
+                           sceneManager, c_benchmarkRqId )
+        {
+            setLocalAabb( Aabb( Vector3::ZERO, Vector3( 0.5f ) ) );
+        }
+
+        virtual const String& getMovableType(void) const        { return msMovableType; }
+    };
+
+    const String BenchmarkObject::msMovableType = "BenchmarkObject";
+
+    typedef vector<BenchmarkObject*>::type BenchmarkObjectVec;
+
+    /// Culls the benchmark's render queue from all worker threads, like SceneManager does.
+    class CullFrustumTask : public UniformScalableTask
+    {
+        ObjectMemoryManager *mMemoryManager;
+        const Camera        *mCamera;
+
+    public:
+        vector<MovableObject::MovableObjectArray>::type mVisibleObjects;
+
+        CullFrustumTask( ObjectMemoryManager *memoryManager, const Camera *camera,
+                         size_t numThreads ) :
+            mMemoryManager( memoryManager ), mCamera( camera ), mVisibleObjects( numThreads ) {}
+
+        virtual void execute( size_t threadId, size_t numThreads )
+        {
+            MovableObject::MovableObjectArray &outVisibleObjects = mVisibleObjects[threadId];
+            outVisibleObjects.clear();
+
+            ObjectData objData;
+            const size_t totalObjs = mMemoryManager->getFirstObjectData( objData, c_benchmarkRqId );
+
+            size_t numObjs  = ( totalObjs + (numThreads-1) ) / numThreads;
+            numObjs         = ( (numObjs + ARRAY_PACKED_REALS - 1) / ARRAY_PACKED_REALS ) *
+                                ARRAY_PACKED_REALS;
+
+            const size_t toAdvance = std::min( threadId * numObjs, totalObjs );
+            numObjs = std::min( numObjs, totalObjs - toAdvance );
+            objData.advancePack( toAdvance / ARRAY_PACKED_REALS );
+
+            MovableObject::cullFrustum( numObjs, objData, mCamera, 0xFFFFFFFF,
+                                        outVisibleObjects, mCamera );
+        }
+    };
+    //-------------------------------------------------------------------------
+    SceneGraphBenchmark::SceneGraphBenchmark( SceneManager *sceneManager, size_t numObjects,
+                                              size_t numIterations ) :
+        mSceneManager( sceneManager ),
+        mNumObjects( numObjects ),
+        mNumIterations( std::max<size_t>( numIterations, 1u ) )
+    {
+    }
+    //-------------------------------------------------------------------------
+    void SceneGraphBenchmark::run( BenchmarkResults &results )
+    {
+        SceneNode *rootNode = mSceneManager->getRootSceneNode( SCENE_DYNAMIC );
+
+        //Deterministic pseudo-random distribution, for reproducible results.
+        uint32 seed = 12345u;
+        vector<SceneNode*>::type parentNodes;
+        BenchmarkObjectVec objects;
+        objects.reserve( mNumObjects );
+        for( size_t i=0; i<mNumObjects; ++i )
+        {
+            if( i % c_childrenPerParent == 0u )
+            {
+                seed = seed * 1664525u + 1013904223u;
+                const Vector3 pos( Real( (seed >> 4u) & 0x3FF ) - 512.0f,
+                                   Real( (seed >> 14u) & 0x3F ),
+                                   Real( (seed >> 20u) & 0x3FF ) - 512.0f );
+                parentNodes.push_back( rootNode->createChildSceneNode( SCENE_DYNAMIC, pos ) );
+            }
+
+            seed = seed * 1664525u + 1013904223u;
+            const Vector3 offset( Real( (seed >> 8u) & 0xF ), 0, Real( (seed >> 16u) & 0xF ) );
+            SceneNode *node = parentNodes.back()->createChildSceneNode( SCENE_DYNAMIC, offset );
+
+            objects.push_back( OGRE_NEW BenchmarkObject( mSceneManager ) );
+            node->attachObject( objects.back() );
+        }
+
+        Camera *camera = mSceneManager->createCamera( "SceneGraphBenchmark Camera" );
+        camera->setPosition( 0, 100, 0 );
+        camera->lookAt( 0, 0, -400 );
+        camera->setNearClipDistance( 0.5f );
+        camera->setFarClipDistance( 2000.0f );
+        camera->setAspectRatio( 16.0f / 9.0f );
+
+        vector<ObjectMemoryManager*>::type objectMemoryManagers;
+        objectMemoryManagers.push_back( &mSceneManager->_getEntityMemoryManager( SCENE_DYNAMIC ) );
+
+        CullFrustumTask cullTask( objectMemoryManagers[0], camera,
+                                  mSceneManager->getNumWorkerThreads() );
+
+        const String config = benchmarkConfig( "objects", mNumObjects,
+                                               "threads", mSceneManager->getNumWorkerThreads() );
+
+        vector<uint64>::type transformSamplesUs;
+        vector<uint64>::type boundsSamplesUs;
+        vector<uint64>::type cullSamplesUs;
+
+        Timer timer;
+
+        //First iteration is a warm up
+        for( size_t i=0; i<mNumIterations + 1u; ++i )
+        {
+            const Real offset = (i & 1u) ? 0.25f : -0.25f;
+            vector<SceneNode*>::type::const_iterator itor = parentNodes.begin();
+            vector<SceneNode*>::type::const_iterator end  = parentNodes.end();
+            while( itor != end )
+                (*itor++)->translate( offset, 0, 0 );
+
+            uint64 startUs = timer.getMicroseconds();
+            mSceneManager->updateAllTransforms();
+            const uint64 transformUs = timer.getMicroseconds() - startUs;
+
+            startUs = timer.getMicroseconds();
+            mSceneManager->updateAllBounds( objectMemoryManagers );
+            const uint64 boundsUs = timer.getMicroseconds() - startUs;
+
+            //Same as SceneManager::fireCullFrustumThreads: update the planes before
+            //the worker threads read them.
+            camera->getFrustumPlanes();
+            startUs = timer.getMicroseconds();
+            mSceneManager->executeUserScalableTask( &cullTask, true );
+            const uint64 cullUs = timer.getMicroseconds() - startUs;
+
+            if( i != 0u )
+            {
+                transformSamplesUs.push_back( transformUs );
+                boundsSamplesUs.push_back( boundsUs );
+                cullSamplesUs.push_back( cullUs );
+            }
+        }
+
+        results.add( "SceneGraph.updateAllTransforms", config, transformSamplesUs );
+        results.add( "SceneGraph.updateAllBounds", config, boundsSamplesUs );
+        results.add( "SceneGraph.cullFrustum", config, cullSamplesUs );
+
+        mSceneManager->destroyCamera( camera );
+
+        BenchmarkObjectVec::const_iterator itor = objects.begin();
+        BenchmarkObjectVec::const_iterator end  = objects.end();
+        while( itor != end )
+            OGRE_DELETE *itor++;
+
+        vector<SceneNode*>::type::const_iterator itNode = parentNodes.begin();
+        vector<SceneNode*>::type::const_iterator enNode = parentNodes.end();
+        while( itNode != enNode )
+        {
+            (*itNode)->removeAndDestroyAllChildren();
+            mSceneManager->destroySceneNode( *itNode );
+            ++itNode;
+        }
+    }
+}
@@ -0,0 +1,168 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "OgreRoot.h"
+#include "OgreSceneManager.h"
+#include "OgreStringConverter.h"
+#include "OgreString.h"
+#include "OgreNULLRenderSystem.h"
+
+#include "BenchmarkResults.h"
+#include "SceneGraphBenchmark.h"
+#include "AnimationBenchmark.h"
+#include "RenderQueueSortBenchmark.h"
+#include "MeshLoadBenchmark.h"
+
+#include <iostream>
+
+using namespace Ogre;
+
+static void printUsage(void)
+{
+    std::cout <<
+        "Usage: OgreBenchmarks [options]\n"
+        "  --sizes=N[,N...]      Number of objects per scene. Default: 10000,100000\n"
+        "  --threads=N[,N...]    Worker thread counts to test. Default: 1,4\n"
+        "  --iterations=N        Measured iterations per benchmark. Default: 30\n"
+        "  --csv=file            Where to write the results. Default: OgreBenchmarks.csv\n"
+        "  --thresholds=file     Fails (exit code 2) if any result is above its threshold.\n"
+        "                        Lines are in the form: name,config,max_avg_ms\n"
+        "All benchmarks run on the NULL RenderSystem; no GPU is needed." << std::endl;
+}
+
+static bool parseList( const String &value, vector<size_t>::type &outList )
+{
+    outList.clear();
+    const StringVector tokens = StringUtil::split( value, "," );
+    StringVector::const_iterator itor = tokens.begin();
+    StringVector::const_iterator end  = tokens.end();
+    while( itor != end )
+    {
+        const size_t val = StringConverter::parseUnsignedLong( *itor, 0u );
+        if( val == 0u )
+            return false;
+        outList.push_back( val );
+        ++itor;
+    }
+    return !outList.empty();
+}
+
+int main( int numargs, char** args )
+{
+    vector<size_t>::type sizes;
+    sizes.push_back( 10000u );
+    sizes.push_back( 100000u );
+    vector<size_t>::type threadCounts;
+    threadCounts.push_back( 1u );
+    threadCounts.push_back( 4u );
+    size_t numIterations = 30u;
+    String csvFilename = "OgreBenchmarks.csv";
+    String thresholdsFilename;
+
+    for( int i=1; i<numargs; ++i )
+    {
+        const String arg( args[i] );
+        const String::size_type separator = arg.find( '=' );
+        const String key    = arg.substr( 0, separator );
+        const String value  = separator == String::npos ? BLANKSTRING : arg.substr( separator + 1u );
+
+        bool valid = !value.empty();
+        if( key == "--sizes" )
+            valid = valid && parseList( value, sizes );
+        else if( key == "--threads" )
+            valid = valid && parseList( value, threadCounts );
+        else if( key == "--iterations" )
+            numIterations = StringConverter::parseUnsignedLong( value, 30u );
+        else if( key == "--csv" )
+            csvFilename = value;
+        else if( key == "--thresholds" )
+            thresholdsFilename = value;
+        else
+            valid = false;
+
+        if( !valid )
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    Root *root = OGRE_NEW Root( "", "", "OgreBenchmarks.log" );
+    //Not owned by Root since it wasn't registered by a plugin
+    NULLRenderSystem *renderSystem = OGRE_NEW NULLRenderSystem();
+    root->addRenderSystem( renderSystem );
+    root->setRenderSystem( renderSystem );
+    root->initialise( true );
+
+    BenchmarkResults results;
+
+    for( size_t i=0; i<threadCounts.size(); ++i )
+    {
+        SceneManager *sceneManager = root->createSceneManager( ST_GENERIC, threadCounts[i] );
+
+        for( size_t j=0; j<sizes.size(); ++j )
+        {
+            {
+                SceneGraphBenchmark benchmark( sceneManager, sizes[j], numIterations );
+                benchmark.run( results );
+            }
+            {
+                AnimationBenchmark benchmark( sceneManager,
+                                              sizes[j] / AnimationBenchmark::c_numBones,
+                                              numIterations );
+                benchmark.run( results );
+            }
+            {
+                RenderQueueSortBenchmark benchmark( sceneManager, sizes[j], numIterations );
+                benchmark.run( results );
+            }
+        }
+
+        root->destroySceneManager( sceneManager );
+    }
+
+    //Single threaded. Sizes are used as vertex counts.
+    for( size_t j=0; j<sizes.size(); ++j )
+    {
+        MeshLoadBenchmark benchmark( sizes[j], numIterations );
+        benchmark.run( results );
+    }
+
+    int retVal = 0;
+
+    if( !results.writeCsv( csvFilename ) )
+        retVal = 1;
+
+    if( !thresholdsFilename.empty() && results.checkThresholds( thresholdsFilename ) != 0u )
+        retVal = 2;
+
+    OGRE_DELETE root;
+    OGRE_DELETE renderSystem;
+
+    return retVal;
+}
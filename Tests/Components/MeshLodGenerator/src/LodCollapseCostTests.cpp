@@ -0,0 +1,284 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "LodCollapseCostTests.h"
+
+#include "UnitTestSuite.h"
+
+#include "OgreMeshLodGenerator.h"
+#include "OgreLodData.h"
+#include "OgreLodInputProvider.h"
+#include "OgreLodCollapser.h"
+#include "OgreLodCollapseCostCurvature.h"
+
+using namespace Ogre;
+
+// Register the test suite
+CPPUNIT_TEST_SUITE_REGISTRATION(LodCollapseCostTests);
+
+//--------------------------------------------------------------------------
+/// Fills LodData with a grid of quads on the XZ plane, with pseudo random heights
+/// so that collapse costs don't tie.
+class LodInputProviderGrid : public LodInputProvider
+{
+    size_t mNumSegments;
+
+public:
+    LodInputProviderGrid( size_t numSegments ) : mNumSegments( numSegments ) {}
+
+    virtual void initData( LodData* data )
+    {
+        const size_t verticesPerRow = mNumSegments + 1u;
+        const size_t numVertices = verticesPerRow * verticesPerRow;
+        const size_t numTriangles = mNumSegments * mNumSegments * 2u;
+
+        data->mUniqueVertexSet.rehash( 4u * numVertices );
+        data->mVertexList.reserve( numVertices );
+        data->mTriangleList.reserve( numTriangles );
+        data->mIndexBufferInfoList.resize( 1u );
+        data->mIndexBufferInfoList[0].indexSize = sizeof(unsigned int);
+        data->mIndexBufferInfoList[0].indexCount = numTriangles * 3u;
+        data->mMeshBoundingSphereRadius = Real( verticesPerRow );
+        data->mUseVertexNormals = false;
+
+        uint32 seed = 12345u;
+        for( size_t z=0; z<verticesPerRow; ++z )
+        {
+            for( size_t x=0; x<verticesPerRow; ++x )
+            {
+                seed = seed * 1664525u + 1013904223u;
+                const Real height = Real( seed >> 8u ) / Real( 1u << 24u );
+
+                data->mVertexList.push_back( LodData::Vertex() );
+                LodData::Vertex *v = &data->mVertexList.back();
+                v->position = Vector3( Real( x ), height, Real( z ) );
+                v->normal = Vector3::UNIT_Y;
+                v->collapseTo = 0;
+                v->seam = false;
+                v->costHeapPosition = LodData::CollapseCostHeap::NOT_IN_HEAP;
+                data->mUniqueVertexSet.insert( v );
+            }
+        }
+
+        for( size_t z=0; z<mNumSegments; ++z )
+        {
+            for( size_t x=0; x<mNumSegments; ++x )
+            {
+                const unsigned int i0 = static_cast<unsigned int>( z * verticesPerRow + x );
+                const unsigned int i1 = i0 + 1u;
+                const unsigned int i2 = i0 + static_cast<unsigned int>( verticesPerRow );
+                const unsigned int i3 = i2 + 1u;
+                addTriangle( data, i0, i2, i1 );
+                addTriangle( data, i1, i2, i3 );
+            }
+        }
+    }
+
+    void addTriangle( LodData *data, unsigned int i0, unsigned int i1, unsigned int i2 )
+    {
+        data->mTriangleList.push_back( LodData::Triangle() );
+        LodData::Triangle *tri = &data->mTriangleList.back();
+        tri->isRemoved = false;
+        tri->submeshID = 0;
+        const unsigned int indices[3] = { i0, i1, i2 };
+        for( int i=0; i<3; ++i )
+        {
+            tri->vertexID[i] = indices[i];
+            tri->vertex[i] = &data->mVertexList[indices[i]];
+        }
+        tri->computeNormal();
+        addTriangleToEdges( data, tri );
+    }
+};
+//--------------------------------------------------------------------------
+/// Initializes the costs the way it was done before they were computed in parallel:
+/// one vertex at a time, pushing each into the heap.
+class LodCollapseCostPerVertexInit : public LodCollapseCostCurvature
+{
+public:
+    virtual void initCollapseCosts( LodData* data )
+    {
+        data->mCollapseCostHeap.clear();
+        LodData::VertexList::iterator it = data->mVertexList.begin();
+        LodData::VertexList::iterator itEnd = data->mVertexList.end();
+        for( ; it != itEnd; ++it )
+        {
+            if( !it->edges.empty() )
+                initVertexCollapseCost( data, &*it );
+        }
+    }
+};
+//--------------------------------------------------------------------------
+/// Counts the calls to initVertexCollapseCost.
+class LodCollapseCostCounting : public LodCollapseCostCurvature
+{
+public:
+    size_t numInitCalls;
+
+    LodCollapseCostCounting() : numInitCalls( 0 ) {}
+
+    virtual void initVertexCollapseCost( LodData* data, LodData::Vertex* vertex )
+    {
+        ++numInitCalls;
+        LodCollapseCostCurvature::initVertexCollapseCost( data, vertex );
+    }
+};
+//--------------------------------------------------------------------------
+void LodCollapseCostTests::setUp()
+{
+    UnitTestSuite::getSingletonPtr()->startTestSetup(__FUNCTION__);
+}
+//--------------------------------------------------------------------------
+void LodCollapseCostTests::tearDown()
+{
+}
+//--------------------------------------------------------------------------
+void LodCollapseCostTests::generateGridLods( size_t numSegments, size_t numWorkerThreads,
+                                             const LodCollapseCostPtr &cost, LodConfig &outConfig,
+                                             LodOutputBuffer &outBuffer )
+{
+    outConfig.levels.clear();
+    outConfig.createGeneratedLodLevel( 10, 0.25 );
+    outConfig.createGeneratedLodLevel( 20, 0.5 );
+    outConfig.createGeneratedLodLevel( 30, 0.9 );
+    outConfig.advanced.useCompression = false;
+    outConfig.advanced.useVertexNormals = false;
+    outConfig.advanced.useBackgroundQueue = false;
+    outConfig.advanced.numWorkerThreads = numWorkerThreads;
+
+    LodData data;
+    data.mNumWorkerThreads = numWorkerThreads;
+    LodInputProviderGrid input( numSegments );
+    //The output provider only touches the mesh when injecting, which we don't do.
+    LodOutputProviderBuffer output( (v1::MeshPtr()) );
+    LodCollapser collapser;
+
+    MeshLodGenerator generator;
+    generator._processData( outConfig, cost.get(), &data, &input, &output, &collapser );
+
+    outBuffer = output.getBuffer();
+}
+//--------------------------------------------------------------------------
+void LodCollapseCostTests::checkSameLods( const LodConfig &config0, const LodOutputBuffer &buffer0,
+                                          const LodConfig &config1, const LodOutputBuffer &buffer1 )
+{
+    CPPUNIT_ASSERT_EQUAL( config0.levels.size(), config1.levels.size() );
+    for( size_t i=0; i<config0.levels.size(); ++i )
+    {
+        CPPUNIT_ASSERT_EQUAL( config0.levels[i].outUniqueVertexCount,
+                              config1.levels[i].outUniqueVertexCount );
+        CPPUNIT_ASSERT( config0.levels[i].outSkipped == config1.levels[i].outSkipped );
+    }
+
+    CPPUNIT_ASSERT_EQUAL( (size_t)1u, buffer0.submesh.size() );
+    CPPUNIT_ASSERT_EQUAL( (size_t)1u, buffer1.submesh.size() );
+
+    const vector<LodIndexBuffer>::type &lods0 = buffer0.submesh[0].genIndexBuffers;
+    const vector<LodIndexBuffer>::type &lods1 = buffer1.submesh[0].genIndexBuffers;
+    CPPUNIT_ASSERT_EQUAL( lods0.size(), lods1.size() );
+    for( size_t i=0; i<lods0.size(); ++i )
+    {
+        CPPUNIT_ASSERT_EQUAL( lods0[i].indexSize, lods1[i].indexSize );
+        CPPUNIT_ASSERT_EQUAL( lods0[i].indexCount, lods1[i].indexCount );
+        CPPUNIT_ASSERT( memcmp( lods0[i].indexBuffer.get(), lods1[i].indexBuffer.get(),
+                                lods0[i].indexCount * lods0[i].indexSize ) == 0 );
+    }
+}
+//--------------------------------------------------------------------------
+void LodCollapseCostTests::testParallelMatchesSerial()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    //Big enough to be split across several threads
+    const size_t numSegments = 127u;
+
+    LodConfig serialConfig;
+    LodOutputBuffer serialBuffer;
+    generateGridLods( numSegments, 1u, LodCollapseCostPtr( new LodCollapseCostCurvature() ),
+                      serialConfig, serialBuffer );
+
+    CPPUNIT_ASSERT( !serialBuffer.submesh[0].genIndexBuffers.empty() );
+    CPPUNIT_ASSERT( serialConfig.levels.back().outUniqueVertexCount <
+                    (numSegments + 1u) * (numSegments + 1u) / 2u );
+
+    for( size_t numThreads=2u; numThreads<=8u; numThreads *= 2u )
+    {
+        LodConfig parallelConfig;
+        LodOutputBuffer parallelBuffer;
+        generateGridLods( numSegments, numThreads,
+                          LodCollapseCostPtr( new LodCollapseCostCurvature() ),
+                          parallelConfig, parallelBuffer );
+        checkSameLods( serialConfig, serialBuffer, parallelConfig, parallelBuffer );
+    }
+}
+//--------------------------------------------------------------------------
+void LodCollapseCostTests::testParallelMatchesPerVertexInit()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    const size_t numSegments = 127u;
+
+    LodConfig perVertexConfig;
+    LodOutputBuffer perVertexBuffer;
+    generateGridLods( numSegments, 1u, LodCollapseCostPtr( new LodCollapseCostPerVertexInit() ),
+                      perVertexConfig, perVertexBuffer );
+
+    LodConfig parallelConfig;
+    LodOutputBuffer parallelBuffer;
+    generateGridLods( numSegments, 4u, LodCollapseCostPtr( new LodCollapseCostCurvature() ),
+                      parallelConfig, parallelBuffer );
+
+    checkSameLods( perVertexConfig, perVertexBuffer, parallelConfig, parallelBuffer );
+}
+//--------------------------------------------------------------------------
+void LodCollapseCostTests::testInitVertexCollapseCostOverride()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    const size_t numSegments = 127u;
+
+    for( size_t numThreads=1u; numThreads<=4u; numThreads *= 4u )
+    {
+        LodCollapseCostCounting *countingCost = new LodCollapseCostCounting();
+        LodCollapseCostPtr cost( countingCost );
+
+        LodConfig config;
+        LodOutputBuffer buffer;
+        generateGridLods( numSegments, numThreads, cost, config, buffer );
+
+        //Every vertex of the grid is used
+        CPPUNIT_ASSERT_EQUAL( (numSegments + 1u) * (numSegments + 1u), countingCost->numInitCalls );
+
+        LodConfig referenceConfig;
+        LodOutputBuffer referenceBuffer;
+        generateGridLods( numSegments, numThreads,
+                          LodCollapseCostPtr( new LodCollapseCostCurvature() ),
+                          referenceConfig, referenceBuffer );
+        checkSameLods( referenceConfig, referenceBuffer, config, buffer );
+    }
+}
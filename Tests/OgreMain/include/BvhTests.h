@@ -0,0 +1,74 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#ifndef __BvhTests_H__
+#define __BvhTests_H__
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "OgreBvh.h"
+
+class BvhTests : public CppUnit::TestFixture
+{
+    // CppUnit macros for setting up the test suite
+    CPPUNIT_TEST_SUITE(BvhTests);
+    CPPUNIT_TEST(testRandomRays);
+    CPPUNIT_TEST(testRandomRaysInfiniteDistance);
+    CPPUNIT_TEST(testAxisAlignedRays);
+    CPPUNIT_TEST(testOneSided);
+    CPPUNIT_TEST_SUITE_END();
+
+protected:
+    Ogre::TriangleBvh   *mBvh;
+    Ogre::uint32        mRandomSeed;
+
+    Ogre::Real random( Ogre::Real minVal, Ogre::Real maxVal );
+    Ogre::Vector3 randomVector3( Ogre::Real minVal, Ogre::Real maxVal );
+
+    /// Closest hit by testing every triangle. Returns false if nothing was hit.
+    bool bruteForceRaycast( const Ogre::Ray &ray, Ogre::Real maxDistance,
+                            bool positiveSide, bool negativeSide,
+                            Ogre::Real &outDistance ) const;
+
+    /// Casts the rays with TriangleBvh::raycast (both versions) and checks the
+    /// results against bruteForceRaycast.
+    void checkRays( const Ogre::Ray *rays, size_t numRays, Ogre::Real maxDistance,
+                    bool positiveSide, bool negativeSide );
+
+public:
+    void setUp();
+    void tearDown();
+
+    void testRandomRays();
+    void testRandomRaysInfiniteDistance();
+    void testAxisAlignedRays();
+    void testOneSided();
+};
+
+#endif
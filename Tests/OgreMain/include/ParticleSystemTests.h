@@ -0,0 +1,88 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __ParticleSystemTests_H__
+#define __ParticleSystemTests_H__
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "OgreRoot.h"
+#include "OgreFileSystemLayer.h"
+#include "OgreBuildSettings.h"
+
+using namespace Ogre;
+
+class TestParticleSystem;
+
+/** Checks that running the affectors on ArrayParticleData (SoA) gives the same
+    results as running them on the Particle objects (scalar).
+*/
+class ParticleSystemTests : public CppUnit::TestFixture
+{
+    // CppUnit macros for setting up the test suite
+    CPPUNIT_TEST_SUITE(ParticleSystemTests);
+    CPPUNIT_TEST(testArrayParticleDataRoundTrip);
+    CPPUNIT_TEST(testArrayMotionMatchesScalar);
+    CPPUNIT_TEST(testArrayAffectorsMatchScalar);
+    CPPUNIT_TEST(testMixedAffectorsMatchScalar);
+    CPPUNIT_TEST(testParticleFXAffectorsMatchScalar);
+    CPPUNIT_TEST(testRandomGenerator);
+    CPPUNIT_TEST(testDestroyWhileUpdatePending);
+    CPPUNIT_TEST_SUITE_END();
+
+    Root* mRoot;
+    /// Created by the tests that need a SceneManager. Must outlive mRoot.
+    RenderSystem* mRenderSystem;
+    FileSystemLayer* mFSLayer;
+    ObjectMemoryManager* mObjectMemoryManager;
+    ParticleAffectorFactory* mArrayAffectorFactory;
+    ParticleAffectorFactory* mScalarAffectorFactory;
+
+    TestParticleSystem* createSystem( size_t numParticles );
+    void destroySystem( TestParticleSystem *system );
+
+    /// Runs numIterations of affectors + motion on both systems and compares them after each.
+    void checkSimulationsMatch( TestParticleSystem *scalarSystem, TestParticleSystem *arraySystem,
+                                size_t numIterations );
+
+public:
+    void setUp();
+    void tearDown();
+
+    void testArrayParticleDataRoundTrip();
+    void testArrayMotionMatchesScalar();
+    void testArrayAffectorsMatchScalar();
+    void testMixedAffectorsMatchScalar();
+    void testParticleFXAffectorsMatchScalar();
+    /// Checks the range & independence of each system's random generator.
+    void testRandomGenerator();
+    /// Destroys a system queued for a parallel update before the SceneManager runs it.
+    void testDestroyWhileUpdatePending();
+};
+
+#endif
@@ -0,0 +1,108 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __TransformUpdateTests_H__
+#define __TransformUpdateTests_H__
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "OgrePrerequisites.h"
+#include "OgreCommon.h"
+#include "ogrestd/vector.h"
+
+using namespace Ogre;
+
+class TestMovableObject;
+
+/** Checks that Node::updateAllTransforms and MovableObject::updateDirtyBounds, which skip
+    the blocks where nothing changed, still leave every derived transform & world aabb
+    as if everything had been recomputed.
+@remarks
+    The memory managers are updated the same way SceneManager::updateAllTransformsAndBounds
+    does, since a SceneManager can't be created without a RenderSystem.
+*/
+class TransformUpdateTests : public CppUnit::TestFixture
+{
+    // CppUnit macros for setting up the test suite
+    CPPUNIT_TEST_SUITE(TransformUpdateTests);
+    CPPUNIT_TEST(testMoveParent);
+    CPPUNIT_TEST(testMoveChild);
+    CPPUNIT_TEST(testLocalAabbChanged);
+    CPPUNIT_TEST(testCleanBlocksAreSkipped);
+    CPPUNIT_TEST(testTagPoints);
+    CPPUNIT_TEST(testStaticObjects);
+    CPPUNIT_TEST_SUITE_END();
+
+    typedef vector<Node*>::type NodeVec;
+    typedef vector<TestMovableObject*>::type TestMovableObjectVec;
+
+    NodeMemoryManager* mNodeMemoryManager[NUM_SCENE_MEMORY_MANAGER_TYPES];
+    NodeMemoryManager* mTagPointNodeMemoryManager;
+    ObjectMemoryManager* mObjectMemoryManager[NUM_SCENE_MEMORY_MANAGER_TYPES];
+    SceneNode* mRootNode[NUM_SCENE_MEMORY_MANAGER_TYPES];
+    /// @see SceneManager::setIncrementalBoundsUpdate
+    bool mIncrementalBoundsUpdate;
+
+    /// A parent with enough children to span several blocks (the last one partially
+    /// filled), each child with a grandchild. All of them have an object attached.
+    SceneNode* mParent;
+    NodeVec mChildren;
+    NodeVec mGrandchildren;
+
+    /// Every node & object created, to destroy them in tearDown
+    NodeVec mNodes;
+    TestMovableObjectVec mObjects;
+
+    SceneNode* createSceneNode( SceneMemoryMgrTypes sceneType, Node *parent );
+    TestMovableObject* createObject( SceneMemoryMgrTypes sceneType, SceneNode *parentNode );
+    void createHierarchy( SceneMemoryMgrTypes sceneType );
+
+    /// Updates the dynamic nodes & objects, plus the static ones if
+    /// bStaticDirty (i.e. as if SceneManager::notifyStaticDirty was called)
+    void updateScene( bool bStaticDirty = false );
+
+    /// Asserts the derived transforms of mParent, mChildren & mGrandchildren, and the
+    /// world aabbs of mObjects attached to them, match the ones calculated from scratch.
+    void checkHierarchy(void);
+    static void checkTransform( const Matrix4 &expected, const Node *node );
+    static void checkBounds( const Matrix4 &parentTransform, const Vector3 &parentScale,
+                             TestMovableObject *object );
+
+public:
+    void setUp();
+    void tearDown();
+
+    void testMoveParent();
+    void testMoveChild();
+    void testLocalAabbChanged();
+    void testCleanBlocksAreSkipped();
+    void testTagPoints();
+    void testStaticObjects();
+};
+
+#endif
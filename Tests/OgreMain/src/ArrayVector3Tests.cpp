@@ -0,0 +1,118 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "ArrayVector3Tests.h"
+
+#include "UnitTestSuite.h"
+
+#include "Math/Array/OgreArrayVector3.h"
+
+using namespace Ogre;
+
+// Register the test suite
+CPPUNIT_TEST_SUITE_REGISTRATION(ArrayVector3Tests);
+
+//--------------------------------------------------------------------------
+void ArrayVector3Tests::setUp()
+{
+    UnitTestSuite::getSingletonPtr()->startTestSetup(__FUNCTION__);
+}
+//--------------------------------------------------------------------------
+void ArrayVector3Tests::tearDown()
+{
+}
+//--------------------------------------------------------------------------
+void ArrayVector3Tests::testCollapseMin()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    //Put the smallest value in each lane in turn. Each component gets it in a
+    //different lane, so that they can't hide each other's mistakes.
+    for( size_t lane=0; lane<ARRAY_PACKED_REALS; ++lane )
+    {
+        ArrayVector3 v;
+        for( size_t i=0; i<ARRAY_PACKED_REALS; ++i )
+        {
+            v.setFromVector3( Vector3( Real( i + 10u ), Real( 20u - i ), Real( i ) * -0.5f ),
+                              i );
+        }
+
+        Vector3 laneValue = v.getAsVector3( lane );
+        laneValue.x = -100.0f;
+        v.setFromVector3( laneValue, lane );
+
+        const size_t laneY = (lane + 1u) % ARRAY_PACKED_REALS;
+        laneValue = v.getAsVector3( laneY );
+        laneValue.y = -200.0f;
+        v.setFromVector3( laneValue, laneY );
+
+        const size_t laneZ = (lane + 2u) % ARRAY_PACKED_REALS;
+        laneValue = v.getAsVector3( laneZ );
+        laneValue.z = -300.0f;
+        v.setFromVector3( laneValue, laneZ );
+
+        const Vector3 result = v.collapseMin();
+        CPPUNIT_ASSERT_EQUAL( Real( -100.0f ), result.x );
+        CPPUNIT_ASSERT_EQUAL( Real( -200.0f ), result.y );
+        CPPUNIT_ASSERT_EQUAL( Real( -300.0f ), result.z );
+    }
+}
+//--------------------------------------------------------------------------
+void ArrayVector3Tests::testCollapseMax()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    for( size_t lane=0; lane<ARRAY_PACKED_REALS; ++lane )
+    {
+        ArrayVector3 v;
+        for( size_t i=0; i<ARRAY_PACKED_REALS; ++i )
+        {
+            v.setFromVector3( Vector3( Real( i + 10u ), Real( 20u - i ), Real( i ) * -0.5f ),
+                              i );
+        }
+
+        Vector3 laneValue = v.getAsVector3( lane );
+        laneValue.x = 100.0f;
+        v.setFromVector3( laneValue, lane );
+
+        const size_t laneY = (lane + 1u) % ARRAY_PACKED_REALS;
+        laneValue = v.getAsVector3( laneY );
+        laneValue.y = 200.0f;
+        v.setFromVector3( laneValue, laneY );
+
+        const size_t laneZ = (lane + 2u) % ARRAY_PACKED_REALS;
+        laneValue = v.getAsVector3( laneZ );
+        laneValue.z = 300.0f;
+        v.setFromVector3( laneValue, laneZ );
+
+        const Vector3 result = v.collapseMax();
+        CPPUNIT_ASSERT_EQUAL( Real( 100.0f ), result.x );
+        CPPUNIT_ASSERT_EQUAL( Real( 200.0f ), result.y );
+        CPPUNIT_ASSERT_EQUAL( Real( 300.0f ), result.z );
+    }
+}
@@ -0,0 +1,279 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "BvhTests.h"
+
+#include "UnitTestSuite.h"
+
+using namespace Ogre;
+
+// Register the test suite
+CPPUNIT_TEST_SUITE_REGISTRATION(BvhTests);
+
+//--------------------------------------------------------------------------
+void BvhTests::setUp()
+{
+    UnitTestSuite::getSingletonPtr()->startTestSetup(__FUNCTION__);
+
+    mRandomSeed = 12345u;
+
+    //Random triangle soup, plus an axis aligned grid of quads at z = 0 so that
+    //axis aligned rays graze the boxes' borders.
+    vector<float>::type positions;
+    for( size_t i=0; i<300u; ++i )
+    {
+        const Vector3 center = randomVector3( -50.0f, 50.0f );
+        for( size_t j=0; j<3u; ++j )
+        {
+            const Vector3 v = center + randomVector3( -5.0f, 5.0f );
+            positions.push_back( v.x );
+            positions.push_back( v.y );
+            positions.push_back( v.z );
+        }
+    }
+    for( int y=-5; y<5; ++y )
+    {
+        for( int x=-5; x<5; ++x )
+        {
+            const float quad[6][3] =
+            {
+                { x * 10.0f,        y * 10.0f,          0 },
+                { x * 10.0f + 10.0f,y * 10.0f,          0 },
+                { x * 10.0f + 10.0f,y * 10.0f + 10.0f,  0 },
+                { x * 10.0f + 10.0f,y * 10.0f + 10.0f,  0 },
+                { x * 10.0f,        y * 10.0f + 10.0f,  0 },
+                { x * 10.0f,        y * 10.0f,          0 },
+            };
+            positions.insert( positions.end(), &quad[0][0], &quad[0][0] + 18u );
+        }
+    }
+
+    mBvh = OGRE_NEW TriangleBvh();
+    mBvh->build( &positions[0], 3u, 0, positions.size() / 3u, false );
+}
+//--------------------------------------------------------------------------
+void BvhTests::tearDown()
+{
+    OGRE_DELETE mBvh;
+    mBvh = 0;
+}
+//--------------------------------------------------------------------------
+Real BvhTests::random( Real minVal, Real maxVal )
+{
+    mRandomSeed = mRandomSeed * 1664525u + 1013904223u;
+    return minVal + (maxVal - minVal) * ((mRandomSeed >> 8u) / Real( 1u << 24u ));
+}
+//--------------------------------------------------------------------------
+Vector3 BvhTests::randomVector3( Real minVal, Real maxVal )
+{
+    const Real x = random( minVal, maxVal );
+    const Real y = random( minVal, maxVal );
+    const Real z = random( minVal, maxVal );
+    return Vector3( x, y, z );
+}
+//--------------------------------------------------------------------------
+bool BvhTests::bruteForceRaycast( const Ray &ray, Real maxDistance,
+                                  bool positiveSide, bool negativeSide,
+                                  Real &outDistance ) const
+{
+    bool hit = false;
+    outDistance = maxDistance;
+
+    const Vector3 origin = ray.getOrigin();
+    const Vector3 direction = ray.getDirection();
+
+    for( size_t slot=0; slot<mBvh->getNumTriangles(); ++slot )
+    {
+        Vector3 v0, v1, v2;
+        mBvh->getTriangle( slot, v0, v1, v2 );
+
+        //Plain Möller-Trumbore. Rays that go exactly through an edge must
+        //give the same answer as the BVH, hence not using Math::intersects.
+        const Vector3 edge1 = v1 - v0;
+        const Vector3 edge2 = v2 - v0;
+        const Vector3 pVec = direction.crossProduct( edge2 );
+        const Real det = edge1.dotProduct( pVec );
+
+        if( !(det > std::numeric_limits<Real>::epsilon() && positiveSide) &&
+            !(det < -std::numeric_limits<Real>::epsilon() && negativeSide) )
+        {
+            continue;
+        }
+
+        const Real invDet = 1.0f / det;
+        const Vector3 tVec = origin - v0;
+        const Real u = tVec.dotProduct( pVec ) * invDet;
+        const Vector3 qVec = tVec.crossProduct( edge1 );
+        const Real v = direction.dotProduct( qVec ) * invDet;
+        const Real t = edge2.dotProduct( qVec ) * invDet;
+
+        if( u >= 0 && v >= 0 && u + v <= 1.0f && t >= 0 && t < outDistance )
+        {
+            outDistance = t;
+            hit = true;
+        }
+    }
+
+    return hit;
+}
+//--------------------------------------------------------------------------
+void BvhTests::checkRays( const Ray *rays, size_t numRays, Real maxDistance,
+                          bool positiveSide, bool negativeSide )
+{
+    const Real tolerance = 1e-3f;
+
+    for( size_t i=0; i<numRays; i += ARRAY_PACKED_REALS )
+    {
+        ArrayRay arrayRay;
+        ArrayReal arrayDistance = Mathlib::SetAll( maxDistance );
+        for( size_t j=0; j<ARRAY_PACKED_REALS; ++j )
+        {
+            const Ray &ray = rays[std::min( i + j, numRays - 1u )];
+            arrayRay.mOrigin.setFromVector3( ray.getOrigin(), j );
+            arrayRay.mDirection.setFromVector3( ray.getDirection(), j );
+        }
+
+        uint32 triangleIdx[ARRAY_PACKED_REALS];
+        const uint32 hitMask = mBvh->raycast( arrayRay, arrayDistance, positiveSide,
+                                              negativeSide, triangleIdx );
+
+        OGRE_ALIGNED_DECL( Real, packetDistance[ARRAY_PACKED_REALS], OGRE_SIMD_ALIGNMENT );
+        CastArrayToReal( packetDistance, arrayDistance );
+
+        for( size_t j=0; j<ARRAY_PACKED_REALS && i + j < numRays; ++j )
+        {
+            const Ray &ray = rays[i + j];
+
+            Real expectedDistance;
+            const bool expectedHit = bruteForceRaycast( ray, maxDistance, positiveSide,
+                                                        negativeSide, expectedDistance );
+
+            TriangleBvh::Hit hit;
+            const bool scalarHit = mBvh->raycast( ray, maxDistance, positiveSide,
+                                                  negativeSide, hit );
+
+            CPPUNIT_ASSERT_EQUAL( expectedHit, scalarHit );
+            CPPUNIT_ASSERT_EQUAL( expectedHit, IS_BIT_SET( j, hitMask ) );
+
+            if( expectedHit )
+            {
+                const Real maxError = tolerance * std::max( Real( 1.0f ), expectedDistance );
+                CPPUNIT_ASSERT( Math::Abs( hit.distance - expectedDistance ) <= maxError );
+                CPPUNIT_ASSERT( Math::Abs( packetDistance[j] - expectedDistance ) <= maxError );
+            }
+            else
+            {
+                //Lanes without hits must be left untouched
+                CPPUNIT_ASSERT_EQUAL( maxDistance, packetDistance[j] );
+            }
+        }
+    }
+}
+//--------------------------------------------------------------------------
+void BvhTests::testRandomRays()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    vector<Ray>::type rays;
+    for( size_t i=0; i<512u; ++i )
+    {
+        const Vector3 origin = randomVector3( -80.0f, 80.0f );
+        const Vector3 target = randomVector3( -50.0f, 50.0f );
+        rays.push_back( Ray( origin, (target - origin).normalisedCopy() ) );
+    }
+
+    checkRays( &rays[0], rays.size(), 100.0f, true, true );
+    checkRays( &rays[0], rays.size(), 30.0f, true, true );
+}
+//--------------------------------------------------------------------------
+void BvhTests::testRandomRaysInfiniteDistance()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    //This is what InstantRadiosity uses for directional lights
+    vector<Ray>::type rays;
+    for( size_t i=0; i<512u; ++i )
+    {
+        const Vector3 origin = randomVector3( -80.0f, 80.0f );
+        const Vector3 target = randomVector3( -50.0f, 50.0f );
+        rays.push_back( Ray( origin, (target - origin).normalisedCopy() ) );
+    }
+
+    checkRays( &rays[0], rays.size(), std::numeric_limits<Real>::max(), true, true );
+}
+//--------------------------------------------------------------------------
+void BvhTests::testAxisAlignedRays()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    const Vector3 directions[6] =
+    {
+        Vector3::UNIT_X, Vector3::NEGATIVE_UNIT_X,
+        Vector3::UNIT_Y, Vector3::NEGATIVE_UNIT_Y,
+        Vector3::UNIT_Z, Vector3::NEGATIVE_UNIT_Z
+    };
+
+    vector<Ray>::type rays;
+    for( size_t i=0; i<6u; ++i )
+    {
+        for( int y=-12; y<=12; ++y )
+        {
+            for( int x=-12; x<=12; ++x )
+            {
+                //Half of them exactly on the grid's lines (i.e. on the boxes' borders)
+                const Real offset = (x & 1) ? 0.0f : 2.5f;
+                Vector3 origin;
+                if( i < 2u )
+                    origin = Vector3( -100.0f * directions[i].x, y * 5.0f + offset, x * 5.0f );
+                else if( i < 4u )
+                    origin = Vector3( x * 5.0f + offset, -100.0f * directions[i].y, y * 5.0f );
+                else
+                    origin = Vector3( x * 5.0f + offset, y * 5.0f, -100.0f * directions[i].z );
+                rays.push_back( Ray( origin, directions[i] ) );
+            }
+        }
+    }
+
+    checkRays( &rays[0], rays.size(), std::numeric_limits<Real>::max(), true, true );
+    checkRays( &rays[0], rays.size(), 150.0f, true, true );
+}
+//--------------------------------------------------------------------------
+void BvhTests::testOneSided()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    vector<Ray>::type rays;
+    for( size_t i=0; i<256u; ++i )
+    {
+        const Vector3 origin = randomVector3( -80.0f, 80.0f );
+        const Vector3 target = randomVector3( -50.0f, 50.0f );
+        rays.push_back( Ray( origin, (target - origin).normalisedCopy() ) );
+    }
+
+    checkRays( &rays[0], rays.size(), 200.0f, true, false );
+    checkRays( &rays[0], rays.size(), 200.0f, false, true );
+}
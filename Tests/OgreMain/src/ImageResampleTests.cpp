@@ -0,0 +1,257 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "ImageResampleTests.h"
+#include "OgreImage2.h"
+#include "OgreImageDownsampler.h"
+#include "OgrePixelFormatGpuUtils.h"
+#include "OgreTextureBox.h"
+
+#include "UnitTestSuite.h"
+
+#include <cstdlib>
+
+using namespace Ogre;
+
+// Register the test suite
+CPPUNIT_TEST_SUITE_REGISTRATION(ImageResampleTests);
+
+namespace
+{
+    struct Size
+    {
+        uint32 width;
+        uint32 height;
+    };
+
+    /// Odd, non power of two & degenerate sizes
+    const Size c_srcSizes[] =
+    {
+        { 1u, 1u }, { 2u, 2u }, { 3u, 3u }, { 5u, 7u }, { 9u, 4u }, { 10u, 10u },
+        { 17u, 9u }, { 24u, 6u }, { 31u, 17u }, { 64u, 33u }, { 100u, 7u }, { 1u, 12u }
+    };
+    const size_t c_numSrcSizes = sizeof( c_srcSizes ) / sizeof( c_srcSizes[0] );
+
+    /// Reproducible random data. Floats are in [0; 1], like colours usually are.
+    void fillRandom( std::vector<uint8> &data, bool isFloat )
+    {
+        if( isFloat )
+        {
+            float *dataF32 = reinterpret_cast<float*>( &data[0] );
+            const size_t numFloats = data.size() / sizeof( float );
+            for( size_t i=0; i<numFloats; ++i )
+                dataF32[i] = static_cast<float>( rand() ) / static_cast<float>( RAND_MAX );
+        }
+        else
+        {
+            for( size_t i=0; i<data.size(); ++i )
+                data[i] = static_cast<uint8>( rand() );
+        }
+    }
+
+    /// Same as the scalar loop in LinearResampler_Byte<4>::scale, for tightly packed rows
+    void bilinearByte4Reference( const uint8 *srcdata, uint32 srcWidth, uint32 srcHeight,
+                                 uint8 *pdst, uint32 dstWidth, uint32 dstHeight )
+    {
+        const uint32 channels = 4u;
+        const uint64 stepx = ((uint64)srcWidth << 48) / dstWidth;
+        const uint64 stepy = ((uint64)srcHeight << 48) / dstHeight;
+
+        uint64 sy_48 = (stepy >> 1) - 1;
+        for( uint32 y=0; y<dstHeight; ++y, sy_48 += stepy )
+        {
+            unsigned int temp = static_cast<unsigned int>(sy_48 >> 36);
+            temp = (temp > 0x800) ? temp - 0x800 : 0;
+            const unsigned int syf = temp & 0xFFF;
+            const uint32 sy1 = temp >> 12;
+            const uint32 sy2 = std::min( sy1 + 1u, srcHeight - 1u );
+            const size_t syoff1 = sy1 * srcWidth * channels;
+            const size_t syoff2 = sy2 * srcWidth * channels;
+
+            uint64 sx_48 = (stepx >> 1) - 1;
+            for( uint32 x=0; x<dstWidth; ++x, sx_48 += stepx )
+            {
+                temp = static_cast<unsigned int>(sx_48 >> 36);
+                temp = (temp > 0x800) ? temp - 0x800 : 0;
+                const unsigned int sxf = temp & 0xFFF;
+                const uint32 sx1 = temp >> 12;
+                const uint32 sx2 = std::min( sx1 + 1u, srcWidth - 1u );
+
+                const unsigned int sxfsyf = sxf * syf;
+                for( uint32 k=0; k<channels; ++k )
+                {
+                    const unsigned int accum =
+                        srcdata[syoff1+sx1*channels+k]*(0x1000000-(sxf<<12)-(syf<<12)+sxfsyf) +
+                        srcdata[syoff1+sx2*channels+k]*((sxf<<12)-sxfsyf) +
+                        srcdata[syoff2+sx1*channels+k]*((syf<<12)-sxfsyf) +
+                        srcdata[syoff2+sx2*channels+k]*sxfsyf;
+                    *pdst++ = static_cast<uint8>((accum + 0x800000) >> 24);
+                }
+            }
+        }
+    }
+}
+
+//--------------------------------------------------------------------------
+void ImageResampleTests::setUp()
+{
+    UnitTestSuite::getSingletonPtr()->startTestSetup(__FUNCTION__);
+
+    srand( 0 );
+}
+//--------------------------------------------------------------------------
+void ImageResampleTests::tearDown()
+{
+}
+//--------------------------------------------------------------------------
+void ImageResampleTests::testDownsamplersMatchScalar()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    struct DownsamplerPair
+    {
+        PixelFormatGpu      format;
+        ImageDownsampler2D  *scalarFunc;
+        ImageDownsampler2D  *simdFunc;
+    };
+
+    const DownsamplerPair downsamplers[] =
+    {
+        { PFG_RGBA8_UNORM,      downscale2x_XXXA8888,       downscale2x_XXXA8888_SIMD },
+        { PFG_RGBA8_UNORM_SRGB, downscale2x_sRGB_XXXA8888,  downscale2x_sRGB_XXXA8888_SIMD },
+        { PFG_RGBA32_FLOAT,     downscale2x_Float32_XXXA,   downscale2x_Float32_XXXA_SIMD },
+        { PFG_R32_FLOAT,        downscale2x_Float32_X,      downscale2x_Float32_X_SIMD },
+    };
+    const size_t numDownsamplers = sizeof( downsamplers ) / sizeof( downsamplers[0] );
+
+    for( size_t i=0; i<numDownsamplers; ++i )
+    {
+        const PixelFormatGpu format = downsamplers[i].format;
+        const bool isFloat = PixelFormatGpuUtils::isFloat( format );
+        const uint32 bytesPerPixel = PixelFormatGpuUtils::getBytesPerPixel( format );
+
+        //Make sure we're testing what generateMipmaps uses
+        void *imageDownsampler2D = 0, *imageDownsamplerCube = 0, *imageBlur2D = 0;
+        Image2::getDownsamplerFunctions( format, &imageDownsampler2D, &imageDownsamplerCube,
+                                         &imageBlur2D, false, 1u, TextureTypes::Type2D,
+                                         Image2::FILTER_BILINEAR );
+        CPPUNIT_ASSERT( imageDownsampler2D == reinterpret_cast<void*>( downsamplers[i].simdFunc ) );
+
+        for( size_t j=0; j<c_numSrcSizes; ++j )
+        {
+            const uint32 srcWidth   = c_srcSizes[j].width;
+            const uint32 srcHeight  = c_srcSizes[j].height;
+            const uint32 dstWidth   = std::max( 1u, srcWidth >> 1u );
+            const uint32 dstHeight  = std::max( 1u, srcHeight >> 1u );
+            const uint32 srcBytesPerRow = srcWidth * bytesPerPixel;
+            const uint32 dstBytesPerRow = dstWidth * bytesPerPixel;
+
+            std::vector<uint8> src( srcBytesPerRow * srcHeight );
+            fillRandom( src, isFloat );
+
+            //Nearest, box (the one with a SIMD version) & gaussian
+            for( size_t k=0; k<3u; ++k )
+            {
+                const FilterKernel &kernel = c_filterKernels[k];
+
+                std::vector<uint8> dstScalar( dstBytesPerRow * dstHeight, 0xCD );
+                std::vector<uint8> dstSimd( dstBytesPerRow * dstHeight, 0xAB );
+
+                (*downsamplers[i].scalarFunc)( &dstScalar[0], &src[0], dstWidth, dstHeight,
+                                               dstBytesPerRow, srcWidth, srcBytesPerRow,
+                                               kernel.kernel,
+                                               kernel.kernelStartX, kernel.kernelEndX,
+                                               kernel.kernelStartY, kernel.kernelEndY );
+                (*downsamplers[i].simdFunc)( &dstSimd[0], &src[0], dstWidth, dstHeight,
+                                             dstBytesPerRow, srcWidth, srcBytesPerRow,
+                                             kernel.kernel,
+                                             kernel.kernelStartX, kernel.kernelEndX,
+                                             kernel.kernelStartY, kernel.kernelEndY );
+
+                CPPUNIT_ASSERT( dstScalar == dstSimd );
+            }
+        }
+    }
+}
+//--------------------------------------------------------------------------
+void ImageResampleTests::testBilinearMatchesScalar()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    //Formats that go through LinearResampler_Byte<4>, the one with a SIMD version
+    const PixelFormatGpu formats[] =
+    {
+        PFG_RGBA8_UNORM, PFG_RGBA8_UINT, PFG_BGRA8_UNORM, PFG_BGRX8_UNORM
+    };
+    const size_t numFormats = sizeof( formats ) / sizeof( formats[0] );
+
+    //Upscaling, downscaling & same size
+    const Size dstSizes[] =
+    {
+        { 3u, 2u }, { 13u, 11u }, { 7u, 5u }, { 5u, 3u }, { 37u, 23u }, { 31u, 1u }, { 1u, 9u }
+    };
+    const size_t numDstSizes = sizeof( dstSizes ) / sizeof( dstSizes[0] );
+
+    for( size_t i=0; i<numFormats; ++i )
+    {
+        const PixelFormatGpu format = formats[i];
+        const uint32 bytesPerPixel = PixelFormatGpuUtils::getBytesPerPixel( format );
+        CPPUNIT_ASSERT_EQUAL( 4u, bytesPerPixel );
+
+        for( size_t j=0; j<c_numSrcSizes; ++j )
+        {
+            const uint32 srcWidth   = c_srcSizes[j].width;
+            const uint32 srcHeight  = c_srcSizes[j].height;
+
+            std::vector<uint8> src( srcWidth * srcHeight * bytesPerPixel );
+            fillRandom( src, false );
+
+            TextureBox srcBox( srcWidth, srcHeight, 1u, 1u, bytesPerPixel,
+                               srcWidth * bytesPerPixel, srcWidth * srcHeight * bytesPerPixel );
+            srcBox.data = &src[0];
+
+            for( size_t k=0; k<numDstSizes; ++k )
+            {
+                const uint32 dstWidth   = dstSizes[k].width;
+                const uint32 dstHeight  = dstSizes[k].height;
+
+                std::vector<uint8> dstReference( dstWidth * dstHeight * bytesPerPixel, 0xCD );
+                std::vector<uint8> dst( dstWidth * dstHeight * bytesPerPixel, 0xAB );
+
+                TextureBox dstBox( dstWidth, dstHeight, 1u, 1u, bytesPerPixel,
+                                   dstWidth * bytesPerPixel, dstWidth * dstHeight * bytesPerPixel );
+                dstBox.data = &dst[0];
+
+                Image2::scale( srcBox, format, dstBox, format, Image2::FILTER_BILINEAR );
+                bilinearByte4Reference( &src[0], srcWidth, srcHeight,
+                                        &dstReference[0], dstWidth, dstHeight );
+
+                CPPUNIT_ASSERT( dstReference == dst );
+            }
+        }
+    }
+}
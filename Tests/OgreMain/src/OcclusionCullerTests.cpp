@@ -0,0 +1,154 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OcclusionCullerTests.h"
+#include "OgreOcclusionCuller.h"
+#include "OgreRoot.h"
+#include "OgreSceneManager.h"
+#include "OgreNULLRenderSystem.h"
+
+#include "UnitTestSuite.h"
+
+using namespace Ogre;
+
+// Register the test suite
+CPPUNIT_TEST_SUITE_REGISTRATION(OcclusionCullerTests);
+
+//--------------------------------------------------------------------------
+void OcclusionCullerTests::setUp()
+{
+    UnitTestSuite::getSingletonPtr()->startTestSetup(__FUNCTION__);
+
+    mCuller = OGRE_NEW OcclusionCuller();
+    mCuller->setResolution( 64u, 64u );
+    mCuller->setEnabled( true );
+
+    //A 10x10 quad facing the camera, 10 units away.
+    const Vector3 positions[4] =
+    {
+        Vector3( -5, -5, -10 ),
+        Vector3(  5, -5, -10 ),
+        Vector3(  5,  5, -10 ),
+        Vector3( -5,  5, -10 )
+    };
+    const uint32 indices[6] = { 0, 1, 2, 2, 3, 0 };
+    mCuller->addOccluder( 0, positions, 4u, indices, 6u );
+}
+//--------------------------------------------------------------------------
+void OcclusionCullerTests::tearDown()
+{
+    OGRE_DELETE mCuller;
+    mCuller = 0;
+}
+//--------------------------------------------------------------------------
+void OcclusionCullerTests::rasterize()
+{
+    //90° fov, square aspect ratio, camera at origin looking down -Z
+    const Real nearPlane = 0.1f;
+    const Real farPlane = 1000.0f;
+    const Matrix4 proj( 1, 0, 0, 0,
+                        0, 1, 0, 0,
+                        0, 0, (farPlane + nearPlane) / (nearPlane - farPlane),
+                        2.0f * farPlane * nearPlane / (nearPlane - farPlane),
+                        0, 0, -1, 0 );
+
+    mCuller->rasterizeOccluders( proj, 0 );
+}
+//--------------------------------------------------------------------------
+void OcclusionCullerTests::testOccludedBehindQuad()
+{
+    rasterize();
+    CPPUNIT_ASSERT( mCuller->isOccluded( Aabb( Vector3( 0, 0, -20 ), Vector3( 1.0f ) ) ) );
+    CPPUNIT_ASSERT( mCuller->isOccluded( Aabb( Vector3( 2, -2, -50 ), Vector3( 3.0f ) ) ) );
+}
+//--------------------------------------------------------------------------
+void OcclusionCullerTests::testVisibleInFront()
+{
+    rasterize();
+    CPPUNIT_ASSERT( !mCuller->isOccluded( Aabb( Vector3( 0, 0, -5 ), Vector3( 1.0f ) ) ) );
+    //Intersects the quad
+    CPPUNIT_ASSERT( !mCuller->isOccluded( Aabb( Vector3( 0, 0, -10 ), Vector3( 1.0f ) ) ) );
+}
+//--------------------------------------------------------------------------
+void OcclusionCullerTests::testVisibleBesides()
+{
+    rasterize();
+    CPPUNIT_ASSERT( !mCuller->isOccluded( Aabb( Vector3( 15, 0, -20 ), Vector3( 1.0f ) ) ) );
+    //Partially behind the quad
+    CPPUNIT_ASSERT( !mCuller->isOccluded( Aabb( Vector3( 10, 0, -20 ), Vector3( 1.0f ) ) ) );
+}
+//--------------------------------------------------------------------------
+void OcclusionCullerTests::testVisibleCrossingCamera()
+{
+    rasterize();
+    CPPUNIT_ASSERT( !mCuller->isOccluded( Aabb( Vector3( 0, 0, 0 ), Vector3( 1.0f ) ) ) );
+    CPPUNIT_ASSERT( !mCuller->isOccluded( Aabb::BOX_INFINITE ) );
+}
+//--------------------------------------------------------------------------
+void OcclusionCullerTests::testNoOccluders()
+{
+    mCuller->destroyAllOccluders();
+    CPPUNIT_ASSERT( !mCuller->isActive() );
+    rasterize();
+    CPPUNIT_ASSERT( !mCuller->isOccluded( Aabb( Vector3( 0, 0, -20 ), Vector3( 1.0f ) ) ) );
+}
+//--------------------------------------------------------------------------
+void OcclusionCullerTests::testSceneManagerLifetime()
+{
+    Root *root = OGRE_NEW Root( "", "", "OcclusionCullerTests.log" );
+    //Not owned by Root since it wasn't registered by a plugin
+    NULLRenderSystem *renderSystem = OGRE_NEW NULLRenderSystem();
+    root->addRenderSystem( renderSystem );
+    root->setRenderSystem( renderSystem );
+    root->initialise( true );
+
+    SceneManager *sceneManager = root->createSceneManager( ST_GENERIC, 1u );
+    OcclusionCuller *culler = sceneManager->getOcclusionCuller();
+    CPPUNIT_ASSERT( culler != 0 );
+
+    const Vector3 positions[3] =
+    {
+        Vector3( -5, -5, -10 ),
+        Vector3(  5, -5, -10 ),
+        Vector3(  5,  5, -10 )
+    };
+    SceneNode *sceneNode = sceneManager->getRootSceneNode()->createChildSceneNode();
+    culler->addOccluder( sceneNode, positions, 3u, 0, 0 );
+    culler->addOccluder( 0, positions, 3u, 0, 0 );
+    CPPUNIT_ASSERT_EQUAL( (size_t)2u, culler->getNumOccluders() );
+
+    //clearScene must destroy the occluders (before their nodes) and keep the culler usable
+    sceneManager->clearScene( false );
+    CPPUNIT_ASSERT_EQUAL( (size_t)0u, culler->getNumOccluders() );
+    culler->addOccluder( 0, positions, 3u, 0, 0 );
+
+    //Must not touch the culler after deleting it
+    root->destroySceneManager( sceneManager );
+
+    OGRE_DELETE root;
+    OGRE_DELETE renderSystem;
+}
@@ -0,0 +1,181 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "PackArchiveTests.h"
+#include "OgreStringConverter.h"
+
+#include "UnitTestSuite.h"
+
+#include <fstream>
+
+using namespace Ogre;
+
+// Register the test suite
+CPPUNIT_TEST_SUITE_REGISTRATION(PackArchiveTests);
+
+//--------------------------------------------------------------------------
+static DataStreamPtr createStream( const String &contents )
+{
+    MemoryDataStream *stream = OGRE_NEW MemoryDataStream( contents.size() );
+    if( !contents.empty() )
+        memcpy( stream->getPtr(), contents.c_str(), contents.size() );
+    return DataStreamPtr( stream );
+}
+//--------------------------------------------------------------------------
+void PackArchiveTests::setUp()
+{
+    UnitTestSuite::getSingletonPtr()->startTestSetup(__FUNCTION__);
+
+    mTestPath = "PackArchiveTest.pak";
+
+    mCompressibleText.clear();
+    for( size_t i=0; i<200; ++i )
+        mCompressibleText += "material Test" + StringConverter::toString( i % 10 ) + " { }\n";
+
+    PackArchiveWriter writer;
+    writer.addFile( "rootfile.txt", createStream( "Some text" ), false, 16u, 1000 );
+    writer.addFile( "level1/file.material", createStream( mCompressibleText ), true );
+    writer.addFile( "level1/level2/File2.material", createStream( "material Test { }" ), true, 4096u );
+    writer.addFile( "level1/empty.bin", createStream( "" ) );
+
+    std::fstream *file = OGRE_NEW_T( std::fstream, MEMCATEGORY_GENERAL )();
+    file->open( mTestPath.c_str(), std::ios::out | std::ios::binary );
+    DataStreamPtr stream( OGRE_NEW FileStreamDataStream( file, true ) );
+    writer.write( stream );
+    stream->close();
+
+    mArchive = OGRE_NEW PackArchive( mTestPath, "Pack" );
+    mArchive->load();
+}
+//--------------------------------------------------------------------------
+void PackArchiveTests::tearDown()
+{
+    OGRE_DELETE mArchive;
+    mArchive = 0;
+    remove( mTestPath.c_str() );
+}
+//--------------------------------------------------------------------------
+void PackArchiveTests::testLz4RoundTrip()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    const uint8 *src = reinterpret_cast<const uint8*>( mCompressibleText.c_str() );
+    const size_t srcSize = mCompressibleText.size();
+
+    vector<uint8>::type compressed( PackArchive::getMaxCompressedSize( srcSize ) );
+    const size_t compressedSize = PackArchive::compressLz4( src, srcSize, &compressed[0],
+                                                            compressed.size() );
+    CPPUNIT_ASSERT( compressedSize > 0 && compressedSize < srcSize );
+
+    vector<uint8>::type decompressed( srcSize );
+    CPPUNIT_ASSERT( PackArchive::decompressLz4( &compressed[0], compressedSize,
+                                                &decompressed[0], srcSize ) );
+    CPPUNIT_ASSERT( memcmp( src, &decompressed[0], srcSize ) == 0 );
+
+    // Truncated data must be rejected, not overrun
+    CPPUNIT_ASSERT( !PackArchive::decompressLz4( &compressed[0], compressedSize / 2u,
+                                                 &decompressed[0], srcSize ) );
+}
+//--------------------------------------------------------------------------
+void PackArchiveTests::testList()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    StringVectorPtr vec = mArchive->list( false );
+    CPPUNIT_ASSERT_EQUAL( (size_t)1, vec->size() );
+    CPPUNIT_ASSERT_EQUAL( String( "rootfile.txt" ), vec->at( 0 ) );
+
+    vec = mArchive->list( true );
+    CPPUNIT_ASSERT_EQUAL( (size_t)4, vec->size() );
+
+    vec = mArchive->list( true, true );
+    CPPUNIT_ASSERT_EQUAL( (size_t)2, vec->size() );
+    CPPUNIT_ASSERT_EQUAL( String( "level1" ), vec->at( 0 ) );
+    CPPUNIT_ASSERT_EQUAL( String( "level1/level2" ), vec->at( 1 ) );
+
+    FileInfoListPtr fileInfo = mArchive->listFileInfo( true );
+    CPPUNIT_ASSERT_EQUAL( (size_t)4, fileInfo->size() );
+    const FileInfo &fi = fileInfo->at( 1 );
+    CPPUNIT_ASSERT_EQUAL( String( "level1/file.material" ), fi.filename );
+    CPPUNIT_ASSERT_EQUAL( String( "level1/" ), fi.path );
+    CPPUNIT_ASSERT_EQUAL( String( "file.material" ), fi.basename );
+    CPPUNIT_ASSERT_EQUAL( mCompressibleText.size(), fi.uncompressedSize );
+    CPPUNIT_ASSERT( fi.compressedSize < fi.uncompressedSize );
+}
+//--------------------------------------------------------------------------
+void PackArchiveTests::testFind()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    CPPUNIT_ASSERT( mArchive->exists( "rootfile.txt" ) );
+    CPPUNIT_ASSERT( mArchive->exists( "LEVEL1/level2/file2.MATERIAL" ) );
+    CPPUNIT_ASSERT( !mArchive->exists( "file2.material" ) );
+    CPPUNIT_ASSERT( !mArchive->exists( "level1" ) );
+
+    StringVectorPtr vec = mArchive->find( "*.material" );
+    CPPUNIT_ASSERT_EQUAL( (size_t)2, vec->size() );
+
+    vec = mArchive->find( "file2.material" );
+    CPPUNIT_ASSERT_EQUAL( (size_t)1, vec->size() );
+    CPPUNIT_ASSERT_EQUAL( String( "level1/level2/File2.material" ), vec->at( 0 ) );
+
+    vec = mArchive->find( "level1/level2/file2.material", false );
+    CPPUNIT_ASSERT_EQUAL( (size_t)1, vec->size() );
+
+    CPPUNIT_ASSERT_EQUAL( (time_t)1000, mArchive->getModifiedTime( "rootfile.txt" ) );
+}
+//--------------------------------------------------------------------------
+void PackArchiveTests::testFileRead()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    DataStreamPtr stream = mArchive->open( "rootfile.txt" );
+    CPPUNIT_ASSERT( !stream.isNull() );
+    CPPUNIT_ASSERT_EQUAL( String( "Some text" ), stream->getAsString() );
+
+    stream = mArchive->open( "level1/file.material" );
+    CPPUNIT_ASSERT_EQUAL( mCompressibleText, stream->getAsString() );
+
+    stream = mArchive->open( "level1/level2/file2.material" );
+    CPPUNIT_ASSERT_EQUAL( String( "material Test { }" ), stream->getAsString() );
+
+    stream = mArchive->open( "level1/empty.bin" );
+    CPPUNIT_ASSERT_EQUAL( (size_t)0, stream->size() );
+
+    CPPUNIT_ASSERT( mArchive->open( "missing.txt" ).isNull() );
+}
+//--------------------------------------------------------------------------
+void PackArchiveTests::testReadAfterUnload()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    DataStreamPtr stream = mArchive->openMapped( "rootfile.txt" );
+    mArchive->unload();
+
+    CPPUNIT_ASSERT_EQUAL( String( "Some text" ), stream->getAsString() );
+    CPPUNIT_ASSERT( !mArchive->exists( "rootfile.txt" ) );
+}
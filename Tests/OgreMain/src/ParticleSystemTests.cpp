@@ -0,0 +1,599 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "ParticleSystemTests.h"
+
+#include "OgreParticleSystem.h"
+#include "OgreParticleSystemManager.h"
+#include "OgreSceneManager.h"
+#include "OgreNULLRenderSystem.h"
+#include "OgreParticleAffector.h"
+#include "OgreParticleAffectorFactory.h"
+#include "OgreParticle.h"
+#include "OgreArrayParticleData.h"
+#include "Math/Array/OgreObjectMemoryManager.h"
+#include "OgreResourceGroupManager.h"
+#include "OgreLogManager.h"
+#include "OgreId.h"
+#include "Math/Array/OgreMathlib.h"
+
+#include "UnitTestSuite.h"
+
+// Register the test suite
+CPPUNIT_TEST_SUITE_REGISTRATION(ParticleSystemTests);
+
+/// Exposes the scalar & SoA simulation steps of ParticleSystem, so that they can be compared.
+class TestParticleSystem : public ParticleSystem
+{
+public:
+    TestParticleSystem( ObjectMemoryManager *objectMemoryManager ) :
+        ParticleSystem( Id::generateNewId<MovableObject>(), objectMemoryManager, 0,
+                        ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME )
+    {
+    }
+
+    /// Creates the particles without configuring the renderer (which needs a RenderSystem)
+    void createParticles( size_t numParticles )
+    {
+        setParticleQuota( numParticles );
+        increasePool( numParticles );
+        for( size_t i=0; i<numParticles; ++i )
+            mFreeParticles.push_back( mParticlePool[i] );
+        for( size_t i=0; i<numParticles; ++i )
+            createParticle();
+    }
+
+    const ArrayParticleData::ParticleList& getActiveParticles(void) const
+    {
+        return mActiveParticles;
+    }
+
+    /// Same as _updateSimulation, minus the emitters
+    void stepScalar( Real timeElapsed )
+    {
+        _expire( timeElapsed );
+        _triggerAffectors( timeElapsed );
+        _applyMotion( timeElapsed );
+    }
+
+    /// Same as _updateSimulation when some affectors support ArrayParticleData, minus the emitters
+    void stepArray( Real timeElapsed )
+    {
+        _expire( timeElapsed );
+        _triggerArrayAffectorsAndApplyMotion( timeElapsed );
+    }
+};
+
+/** Adds a force (reversed for particles about to die), fades out red, grows & rotates.
+    Implements both the scalar & SoA paths, which must give the same results.
+*/
+class ArrayTestAffector : public ParticleAffector
+{
+public:
+    ArrayTestAffector( ParticleSystem *psys ) : ParticleAffector( psys )
+    {
+        mType = "ArrayTest";
+    }
+
+    static Vector3 getForce(void)           { return Vector3( 3.0f, -9.8f, 1.5f ); }
+    static Real getStateChange(void)        { return 2.0f; }
+    static Real getRedAdj(void)             { return -0.4f; }
+    static Real getScaleAdj(void)           { return 2.0f; }
+
+    virtual void _affectParticles( ParticleSystem *pSystem, Real timeElapsed )
+    {
+        const Vector3 scaledForce = getForce() * timeElapsed;
+        const Real dr = getRedAdj() * timeElapsed;
+        const Real ds = getScaleAdj() * timeElapsed;
+
+        ParticleIterator pi = pSystem->_getIterator();
+        while( !pi.end() )
+        {
+            Particle *p = pi.getNext();
+
+            if( p->mTimeToLive > getStateChange() )
+                p->mDirection += scaledForce;
+            else
+                p->mDirection += scaledForce * -1.0f;
+
+            p->mColour.r = std::min( std::max( p->mColour.r + dr, Real( 0.0f ) ), Real( 1.0f ) );
+
+            const Real width  = p->hasOwnDimensions() ? p->getOwnWidth() : pSystem->getDefaultWidth();
+            const Real height = p->hasOwnDimensions() ? p->getOwnHeight() : pSystem->getDefaultHeight();
+            p->setDimensions( width + ds, height + ds );
+
+            p->setRotation( p->mRotation + timeElapsed * p->mRotationSpeed );
+        }
+    }
+
+    virtual bool _supportsArrayParticles(void) const    { return true; }
+
+    virtual void _affectArrayParticles( ArrayParticleData &particles, Real timeElapsed )
+    {
+        ArrayVector3 scaledForce;
+        scaledForce.setAll( getForce() * timeElapsed );
+        const ArrayReal stateChange = Mathlib::SetAll( getStateChange() );
+        const ArrayReal dr = Mathlib::SetAll( getRedAdj() * timeElapsed );
+        const ArrayReal ds = Mathlib::SetAll( getScaleAdj() * timeElapsed );
+        const ArrayReal dt = Mathlib::SetAll( timeElapsed );
+
+        const size_t numBlocks = particles.getNumBlocks();
+        for( size_t i=0; i<numBlocks; ++i )
+        {
+            const ArrayMaskR firstState = Mathlib::CompareGreater( particles.mTimeToLive[i],
+                                                                   stateChange );
+            particles.mDirection[i] += scaledForce * Mathlib::Cmov4( Mathlib::ONE, Mathlib::NEG_ONE,
+                                                                     firstState );
+
+            particles.mColourR[i] = Mathlib::Min( Mathlib::Max( particles.mColourR[i] + dr,
+                                                                ARRAY_REAL_ZERO ), Mathlib::ONE );
+
+            particles.mWidth[i]  = particles.mWidth[i] + ds;
+            particles.mHeight[i] = particles.mHeight[i] + ds;
+
+            particles.mRotation[i] = particles.mRotation[i] + dt * particles.mRotationSpeed[i];
+        }
+
+        particles.mDimensionsChanged = true;
+        particles.mRotationChanged = true;
+    }
+};
+
+/** Scalar only affector which depends on the position & dimensions written by others,
+    to check that the SoA data is converted back and forth when mixing both kinds.
+*/
+class ScalarTestAffector : public ParticleAffector
+{
+public:
+    ScalarTestAffector( ParticleSystem *psys ) : ParticleAffector( psys )
+    {
+        mType = "ScalarTest";
+    }
+
+    virtual void _affectParticles( ParticleSystem *pSystem, Real timeElapsed )
+    {
+        ParticleIterator pi = pSystem->_getIterator();
+        while( !pi.end() )
+        {
+            Particle *p = pi.getNext();
+            p->mDirection.y -= p->mPosition.x * timeElapsed;
+            p->mColour.g = p->hasOwnDimensions() ? p->getOwnWidth() * 0.001f : 0.5f;
+            if( p->mColour.b > 0.5f )
+                p->setDimensions( p->getOwnWidth() * 0.5f, p->getOwnHeight() );
+        }
+    }
+};
+
+template <typename T> class TestAffectorFactory : public ParticleAffectorFactory
+{
+    String mName;
+public:
+    TestAffectorFactory( const String &name ) : mName( name ) {}
+
+    virtual String getName() const { return mName; }
+
+    virtual ParticleAffector* createAffector( ParticleSystem *psys )
+    {
+        ParticleAffector *affector = OGRE_NEW T( psys );
+        mAffectors.push_back( affector );
+        return affector;
+    }
+};
+
+/// Deterministic, different values for each particle (and lane).
+static void initParticle( Particle *p, size_t idx )
+{
+    const Real fIdx = Real( idx );
+    p->mPosition        = Vector3( fIdx * 0.5f, -fIdx, 3.0f - fIdx * 0.25f );
+    p->mDirection       = Vector3( Math::Sin( fIdx ), Math::Cos( fIdx * 0.7f ) * 5.0f,
+                                   Real( idx % 3u ) - 1.0f );
+    p->mColour          = ColourValue( Real( idx % 11u ) / 10.0f, Real( idx % 5u ) / 4.0f,
+                                       Real( idx % 2u ), 1.0f - Real( idx % 7u ) / 6.0f );
+    p->mTimeToLive      = 0.25f + Real( idx % 13u ) * 0.25f;
+    p->mTotalTimeToLive = p->mTimeToLive + 1.0f;
+    p->mRotation        = Radian( fIdx * 0.1f );
+    p->mRotationSpeed   = Radian( fIdx * 0.05f - 1.0f );
+    p->mOwnDimensions   = idx % 3u == 0;
+    p->mWidth           = 10.0f + fIdx;
+    p->mHeight          = 20.0f - fIdx * 0.1f;
+}
+
+static void checkRealsMatch( Real expected, Real actual )
+{
+    CPPUNIT_ASSERT( Math::RealEqual( expected, actual,
+                                     std::max( Real( 1.0f ), Math::Abs( expected ) ) * 1e-5f ) );
+}
+
+static void checkParticlesMatch( ParticleSystem *expectedSystem, ParticleSystem *actualSystem )
+{
+    CPPUNIT_ASSERT_EQUAL( expectedSystem->getNumParticles(), actualSystem->getNumParticles() );
+
+    ParticleIterator expectedIt = expectedSystem->_getIterator();
+    ParticleIterator actualIt   = actualSystem->_getIterator();
+
+    while( !expectedIt.end() )
+    {
+        const Particle *expected = expectedIt.getNext();
+        const Particle *actual   = actualIt.getNext();
+
+        for( size_t i=0; i<3; ++i )
+        {
+            checkRealsMatch( expected->mPosition[i], actual->mPosition[i] );
+            checkRealsMatch( expected->mDirection[i], actual->mDirection[i] );
+        }
+        for( size_t i=0; i<4; ++i )
+            checkRealsMatch( expected->mColour[i], actual->mColour[i] );
+
+        checkRealsMatch( expected->mTimeToLive, actual->mTimeToLive );
+        checkRealsMatch( expected->mTotalTimeToLive, actual->mTotalTimeToLive );
+        checkRealsMatch( expected->mRotation.valueRadians(), actual->mRotation.valueRadians() );
+        checkRealsMatch( expected->mRotationSpeed.valueRadians(),
+                         actual->mRotationSpeed.valueRadians() );
+
+        CPPUNIT_ASSERT_EQUAL( expected->hasOwnDimensions(), actual->hasOwnDimensions() );
+        if( expected->hasOwnDimensions() )
+        {
+            checkRealsMatch( expected->getOwnWidth(), actual->getOwnWidth() );
+            checkRealsMatch( expected->getOwnHeight(), actual->getOwnHeight() );
+        }
+    }
+}
+
+static bool hasAffectorFactory( const String &type )
+{
+    ParticleSystemManager::ParticleAffectorFactoryIterator itor =
+            ParticleSystemManager::getSingleton().getAffectorFactoryIterator();
+    while( itor.hasMoreElements() )
+    {
+        if( itor.peekNextKey() == type )
+            return true;
+        itor.moveNext();
+    }
+
+    return false;
+}
+
+//--------------------------------------------------------------------------
+void ParticleSystemTests::setUp()
+{
+    UnitTestSuite::getSingletonPtr()->startTestSetup(__FUNCTION__);
+
+    mFSLayer = OGRE_NEW_T(Ogre::FileSystemLayer, Ogre::MEMCATEGORY_GENERAL)(OGRE_VERSION_NAME);
+
+#ifdef OGRE_STATIC_LIB
+    //ParticleFX isn't installed; testParticleFXAffectorsMatchScalar will skip it
+    mRoot = OGRE_NEW Root(BLANKSTRING);
+#else
+    String pluginsPath = mFSLayer->getConfigFilePath("plugins.cfg");
+    mRoot = OGRE_NEW Root(pluginsPath);
+#endif
+    mRenderSystem = 0;
+
+    //Normally done when the first window gets created; registers the billboard renderer
+    ParticleSystemManager::getSingleton()._initialise();
+
+    mObjectMemoryManager = OGRE_NEW ObjectMemoryManager();
+
+    mArrayAffectorFactory = OGRE_NEW TestAffectorFactory<ArrayTestAffector>( "ArrayTest" );
+    mScalarAffectorFactory = OGRE_NEW TestAffectorFactory<ScalarTestAffector>( "ScalarTest" );
+    ParticleSystemManager::getSingleton().addAffectorFactory( mArrayAffectorFactory );
+    ParticleSystemManager::getSingleton().addAffectorFactory( mScalarAffectorFactory );
+}
+//--------------------------------------------------------------------------
+void ParticleSystemTests::tearDown()
+{
+    OGRE_DELETE mObjectMemoryManager;
+    OGRE_DELETE mRoot;
+    OGRE_DELETE mRenderSystem;
+    OGRE_DELETE mScalarAffectorFactory;
+    OGRE_DELETE mArrayAffectorFactory;
+    OGRE_DELETE_T(mFSLayer, FileSystemLayer, Ogre::MEMCATEGORY_GENERAL);
+}
+//--------------------------------------------------------------------------
+TestParticleSystem* ParticleSystemTests::createSystem( size_t numParticles )
+{
+    TestParticleSystem *system = OGRE_NEW TestParticleSystem( mObjectMemoryManager );
+    system->createParticles( numParticles );
+
+    size_t idx = 0;
+    ParticleIterator pi = system->_getIterator();
+    while( !pi.end() )
+        initParticle( pi.getNext(), idx++ );
+
+    return system;
+}
+//--------------------------------------------------------------------------
+void ParticleSystemTests::destroySystem( TestParticleSystem *system )
+{
+    OGRE_DELETE system;
+}
+//--------------------------------------------------------------------------
+void ParticleSystemTests::checkSimulationsMatch( TestParticleSystem *scalarSystem,
+                                                 TestParticleSystem *arraySystem,
+                                                 size_t numIterations )
+{
+    checkParticlesMatch( scalarSystem, arraySystem );
+
+    for( size_t i=0; i<numIterations; ++i )
+    {
+        const Real timeElapsed = 1.0f / 30.0f + Real( i % 4u ) * 0.01f;
+        scalarSystem->stepScalar( timeElapsed );
+        arraySystem->stepArray( timeElapsed );
+        checkParticlesMatch( scalarSystem, arraySystem );
+    }
+}
+//--------------------------------------------------------------------------
+void ParticleSystemTests::testArrayParticleDataRoundTrip()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    //Cover empty, partial & full blocks
+    for( size_t numParticles=0; numParticles<=ARRAY_PACKED_REALS * 2u + 1u; ++numParticles )
+    {
+        TestParticleSystem *expected = createSystem( numParticles );
+        TestParticleSystem *system = createSystem( numParticles );
+
+        ArrayParticleData arrayParticles;
+        arrayParticles.gather( system->getActiveParticles(), system->getDefaultWidth(),
+                               system->getDefaultHeight() );
+
+        CPPUNIT_ASSERT_EQUAL( numParticles, arrayParticles.getNumParticles() );
+        CPPUNIT_ASSERT_EQUAL( (numParticles + ARRAY_PACKED_REALS - 1u) / ARRAY_PACKED_REALS,
+                              arrayParticles.getNumBlocks() );
+
+        //Lanes must map to the particles in order, and particles without their
+        //own dimensions must get the system's default ones.
+        const Real *width  = reinterpret_cast<const Real*>( arrayParticles.mWidth );
+        const Real *height = reinterpret_cast<const Real*>( arrayParticles.mHeight );
+        size_t idx = 0;
+        ParticleIterator pi = system->_getIterator();
+        while( !pi.end() )
+        {
+            const Particle *p = pi.getNext();
+            CPPUNIT_ASSERT( arrayParticles.getParticle( idx ) == p );
+            CPPUNIT_ASSERT_EQUAL( p->hasOwnDimensions() ? p->getOwnWidth() :
+                                                          system->getDefaultWidth(), width[idx] );
+            CPPUNIT_ASSERT_EQUAL( p->hasOwnDimensions() ? p->getOwnHeight() :
+                                                          system->getDefaultHeight(), height[idx] );
+            ++idx;
+        }
+
+        //Unmodified data must be written back as is, without giving own dimensions
+        arrayParticles.scatter();
+        checkParticlesMatch( expected, system );
+
+        //Once dimensions are flagged as changed, all particles get their own
+        arrayParticles.mDimensionsChanged = true;
+        arrayParticles.scatter();
+        idx = 0;
+        pi = system->_getIterator();
+        while( !pi.end() )
+        {
+            const Particle *p = pi.getNext();
+            CPPUNIT_ASSERT( p->hasOwnDimensions() );
+            CPPUNIT_ASSERT_EQUAL( width[idx], p->getOwnWidth() );
+            CPPUNIT_ASSERT_EQUAL( height[idx], p->getOwnHeight() );
+            ++idx;
+        }
+
+        destroySystem( system );
+        destroySystem( expected );
+    }
+}
+//--------------------------------------------------------------------------
+void ParticleSystemTests::testArrayMotionMatchesScalar()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    const size_t numParticles = ARRAY_PACKED_REALS * 4u + 3u;
+
+    //No affectors; only motion (and expiration)
+    TestParticleSystem *scalarSystem = createSystem( numParticles );
+    TestParticleSystem *arraySystem = createSystem( numParticles );
+
+    const Real timeElapsed = 0.1f;
+    arraySystem->stepArray( timeElapsed );
+
+    size_t idx = 0;
+    ParticleIterator pi = arraySystem->_getIterator();
+    while( !pi.end() )
+    {
+        Particle reference;
+        initParticle( &reference, idx++ );
+        const Particle *p = pi.getNext();
+        const Vector3 expectedPos = reference.mPosition + reference.mDirection * timeElapsed;
+        for( size_t i=0; i<3; ++i )
+            checkRealsMatch( expectedPos[i], p->mPosition[i] );
+    }
+
+    scalarSystem->stepScalar( timeElapsed );
+    checkSimulationsMatch( scalarSystem, arraySystem, 40 );
+
+    destroySystem( arraySystem );
+    destroySystem( scalarSystem );
+}
+//--------------------------------------------------------------------------
+void ParticleSystemTests::testArrayAffectorsMatchScalar()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    const size_t numParticles = ARRAY_PACKED_REALS * 8u + 1u;
+
+    TestParticleSystem *scalarSystem = createSystem( numParticles );
+    TestParticleSystem *arraySystem = createSystem( numParticles );
+    scalarSystem->addAffector( "ArrayTest" );
+    arraySystem->addAffector( "ArrayTest" );
+    CPPUNIT_ASSERT( arraySystem->getAffector( 0 )->_supportsArrayParticles() );
+
+    //Enough iterations for particles to cross the state change, and some to expire
+    checkSimulationsMatch( scalarSystem, arraySystem, 60 );
+    CPPUNIT_ASSERT( arraySystem->getNumParticles() < numParticles );
+    CPPUNIT_ASSERT( arraySystem->getNumParticles() > 0 );
+
+    destroySystem( arraySystem );
+    destroySystem( scalarSystem );
+}
+//--------------------------------------------------------------------------
+void ParticleSystemTests::testMixedAffectorsMatchScalar()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    const size_t numParticles = ARRAY_PACKED_REALS * 8u + 1u;
+
+    //SoA affectors before & after a scalar one, so data must go back and forth
+    const char *affectorTypes[] = { "ArrayTest", "ScalarTest", "ArrayTest" };
+
+    TestParticleSystem *scalarSystem = createSystem( numParticles );
+    TestParticleSystem *arraySystem = createSystem( numParticles );
+    for( size_t i=0; i<sizeof( affectorTypes ) / sizeof( affectorTypes[0] ); ++i )
+    {
+        scalarSystem->addAffector( affectorTypes[i] );
+        arraySystem->addAffector( affectorTypes[i] );
+    }
+
+    checkSimulationsMatch( scalarSystem, arraySystem, 60 );
+
+    destroySystem( arraySystem );
+    destroySystem( scalarSystem );
+}
+//--------------------------------------------------------------------------
+void ParticleSystemTests::testParticleFXAffectorsMatchScalar()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    const size_t numParticles = ARRAY_PACKED_REALS * 8u + 1u;
+
+    const size_t numAffectors = 6u;
+    const char *affectorTypes[numAffectors] =
+    {
+        "LinearForce", "LinearForce", "ColourFader", "ColourFader2", "Scaler", "Rotator"
+    };
+    NameValuePairList params[numAffectors];
+    params[0]["force_vector"]       = "3 -9.8 1.5";
+    params[0]["force_application"]  = "add";
+    params[1]["force_vector"]       = "-2 4 0.5";
+    params[1]["force_application"]  = "average";
+    params[2]["red"]                = "-0.5";
+    params[2]["green"]              = "0.25";
+    params[2]["blue"]               = "-1";
+    params[2]["alpha"]              = "0.75";
+    params[3]["red1"]               = "-0.5";
+    params[3]["green1"]             = "0.25";
+    params[3]["alpha1"]             = "-0.2";
+    params[3]["red2"]               = "0.5";
+    params[3]["blue2"]              = "-0.75";
+    params[3]["alpha2"]             = "-1";
+    params[3]["state_change"]       = "2";
+    params[4]["rate"]               = "5";
+
+    for( size_t i=0; i<numAffectors; ++i )
+    {
+        if( !hasAffectorFactory( affectorTypes[i] ) )
+        {
+            LogManager::getSingleton().logMessage( String( "Affector " ) + affectorTypes[i] +
+                                                   " not available (ParticleFX not loaded)."
+                                                   " Skipping." );
+            continue;
+        }
+
+        TestParticleSystem *scalarSystem = createSystem( numParticles );
+        TestParticleSystem *arraySystem = createSystem( numParticles );
+        scalarSystem->addAffector( affectorTypes[i] )->setParameterList( params[i] );
+        arraySystem->addAffector( affectorTypes[i] )->setParameterList( params[i] );
+        CPPUNIT_ASSERT( arraySystem->getAffector( 0 )->_supportsArrayParticles() );
+
+        checkSimulationsMatch( scalarSystem, arraySystem, 60 );
+
+        destroySystem( arraySystem );
+        destroySystem( scalarSystem );
+    }
+}
+//--------------------------------------------------------------------------
+void ParticleSystemTests::testRandomGenerator()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    TestParticleSystem *systemA = createSystem( 0 );
+    TestParticleSystem *systemB = createSystem( 0 );
+
+    const size_t numSamples = 10000u;
+    Real sum = 0;
+    size_t numEqual = 0;
+    for( size_t i=0; i<numSamples; ++i )
+    {
+        const Real a = systemA->_getUnitRandom();
+        const Real b = systemB->_getUnitRandom();
+        CPPUNIT_ASSERT( a >= 0 && a < 1.0f );
+        CPPUNIT_ASSERT( b >= 0 && b < 1.0f );
+        sum += a;
+        if( a == b )
+            ++numEqual;
+
+        const Real r = systemA->_getRangeRandom( -3.0f, 5.0f );
+        CPPUNIT_ASSERT( r >= -3.0f && r < 5.0f );
+        const Real s = systemA->_getSymmetricRandom();
+        CPPUNIT_ASSERT( s >= -1.0f && s < 1.0f );
+    }
+
+    //Roughly uniform, and each system has its own sequence
+    CPPUNIT_ASSERT( Math::Abs( sum / numSamples - 0.5f ) < 0.02f );
+    CPPUNIT_ASSERT( numEqual < numSamples / 100u );
+
+    destroySystem( systemB );
+    destroySystem( systemA );
+}
+//--------------------------------------------------------------------------
+void ParticleSystemTests::testDestroyWhileUpdatePending()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    //Not owned by Root since it wasn't registered by a plugin. Deleted in tearDown
+    mRenderSystem = OGRE_NEW NULLRenderSystem();
+    mRoot->addRenderSystem( mRenderSystem );
+    mRoot->setRenderSystem( mRenderSystem );
+    mRoot->initialise( true );
+
+    SceneManager *sceneManager = mRoot->createSceneManager( ST_GENERIC, 1u );
+    sceneManager->setParallelParticleSystemUpdates( true );
+
+    SceneNode *sceneNode = sceneManager->getRootSceneNode()->createChildSceneNode();
+    ParticleSystem *systems[2];
+    for( size_t i=0; i<2u; ++i )
+    {
+        systems[i] = sceneManager->createParticleSystem( 10u );
+        sceneNode->attachObject( systems[i] );
+        //What the time controller does every frame
+        systems[i]->_scheduleUpdate( 0.1f );
+    }
+
+    sceneManager->destroyParticleSystem( systems[0] );
+
+    //Runs the pending updates. Must only touch systems[1]
+    sceneManager->setParallelParticleSystemUpdates( false );
+
+    mRoot->destroySceneManager( sceneManager );
+}
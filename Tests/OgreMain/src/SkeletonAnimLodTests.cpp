@@ -0,0 +1,298 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "SkeletonAnimLodTests.h"
+
+#include "Animation/OgreBone.h"
+#include "Animation/OgreSkeletonAnimation.h"
+#include "Animation/OgreSkeletonDef.h"
+#include "Animation/OgreSkeletonInstance.h"
+#include "OgreAnimation.h"
+#include "OgreAnimationTrack.h"
+#include "OgreKeyFrame.h"
+#include "OgreOldBone.h"
+#include "OgreSkeleton.h"
+#include "OgreStringConverter.h"
+
+#include "UnitTestSuite.h"
+
+using namespace Ogre;
+
+// Register the test suite
+CPPUNIT_TEST_SUITE_REGISTRATION(SkeletonAnimLodTests);
+
+static const size_t c_numBones = 4u;
+static const Vector3 c_bindPosition( 0.0f, 1.0f, 0.0f );
+static const Vector3 c_endTranslation( 4.0f, 0.0f, 0.0f );
+
+//--------------------------------------------------------------------------
+void SkeletonAnimLodTests::setUp()
+{
+    UnitTestSuite::getSingletonPtr()->startTestSetup(__FUNCTION__);
+
+    //A chain of bones (one per depth level), all moved by the same animation
+    v1::Skeleton *skeleton = OGRE_NEW v1::Skeleton( 0, "SkeletonAnimLodTests", 0, "General" );
+    //So that its bones and animations get freed when deleted
+    skeleton->setToLoaded();
+    v1::OldBone *parent = 0;
+    for( size_t i=0; i<c_numBones; ++i )
+    {
+        v1::OldBone *bone = skeleton->createBone( "Bone" + StringConverter::toString( i ),
+                                                  static_cast<unsigned short>( i ) );
+        bone->setPosition( c_bindPosition );
+        if( parent )
+            parent->addChild( bone );
+        parent = bone;
+    }
+    skeleton->setBindingPose();
+
+    v1::Animation *animation = skeleton->createAnimation( "Move", 1.0f );
+    for( size_t i=0; i<c_numBones; ++i )
+    {
+        const unsigned short handle = static_cast<unsigned short>( i );
+        v1::OldNodeAnimationTrack *track =
+                animation->createOldNodeTrack( handle, skeleton->getBone( handle ) );
+        track->createNodeKeyFrame( 0.0f )->setTranslate( Vector3::ZERO );
+        track->createNodeKeyFrame( 1.0f )->setTranslate( c_endTranslation );
+    }
+
+    mSkeletonDef = OGRE_NEW SkeletonDef( skeleton, 1.0f );
+    OGRE_DELETE skeleton;
+
+    mAnimManager = new SkeletonAnimManager();
+}
+//--------------------------------------------------------------------------
+void SkeletonAnimLodTests::tearDown()
+{
+    delete mAnimManager;
+    mAnimManager = 0;
+    OGRE_DELETE mSkeletonDef;
+    mSkeletonDef = 0;
+}
+//--------------------------------------------------------------------------
+void SkeletonAnimLodTests::getBonePositions( SkeletonInstance *skeleton, Vector3 *outPositions )
+{
+    for( size_t i=0; i<c_numBones; ++i )
+    {
+        Bone *bone = skeleton->getBone( "Bone" + StringConverter::toString( i ) );
+        CPPUNIT_ASSERT_EQUAL( static_cast<uint16>( i ), bone->getDepthLevel() );
+        outPositions[i] = bone->getPosition();
+    }
+}
+//--------------------------------------------------------------------------
+void SkeletonAnimLodTests::testLodLevels()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    //Already sorted and transformed, like SkeletonAnimManager::lodLevels
+    AnimationLodLevelVec levels;
+    levels.push_back( AnimationLodLevel( 10.0f, 2u, 3u ) );
+    levels.push_back( AnimationLodLevel( 50.0f, 4u, 1u ) );
+
+    const Real lodValues[]            = { 0.0f, 9.9f, 10.0f, 30.0f, 50.0f, 1000.0f };
+    const uint16 expectedIntervals[]  = { 1u, 1u, 2u, 2u, 4u, 4u };
+    const uint16 expectedDepths[]     = { 0xFFFF, 0xFFFF, 3u, 3u, 1u, 1u };
+
+    for( size_t i=0; i<sizeof( lodValues ) / sizeof( lodValues[0] ); ++i )
+    {
+        uint16 updateInterval = 0, maxBoneDepth = 0;
+        BySkeletonDef::_getAnimationLod( levels, lodValues[i], updateInterval, maxBoneDepth );
+        CPPUNIT_ASSERT_EQUAL( expectedIntervals[i], updateInterval );
+        CPPUNIT_ASSERT_EQUAL( expectedDepths[i], maxBoneDepth );
+    }
+
+    //No levels means full animation
+    uint16 updateInterval = 0, maxBoneDepth = 0;
+    BySkeletonDef::_getAnimationLod( AnimationLodLevelVec(), 1000.0f,
+                                     updateInterval, maxBoneDepth );
+    CPPUNIT_ASSERT_EQUAL( uint16( 1u ), updateInterval );
+    CPPUNIT_ASSERT_EQUAL( uint16( 0xFFFF ), maxBoneDepth );
+}
+//--------------------------------------------------------------------------
+void SkeletonAnimLodTests::testUpdateInterval()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    for( uint16 updateInterval=1u; updateInterval<=5u; ++updateInterval )
+    {
+        for( size_t instanceIdx=0; instanceIdx<7u; ++instanceIdx )
+        {
+            //Exactly once every updateInterval frames, whatever the frame we start at
+            uint32 lastFrame = 0;
+            size_t numAnimatedFrames = 0;
+            for( uint32 frame=1000u; frame<1000u + 20u * updateInterval; ++frame )
+            {
+                if( BySkeletonDef::_isAnimationFrame( updateInterval, frame, instanceIdx ) )
+                {
+                    if( numAnimatedFrames )
+                        CPPUNIT_ASSERT_EQUAL( uint32( updateInterval ), frame - lastFrame );
+                    lastFrame = frame;
+                    ++numAnimatedFrames;
+                }
+            }
+
+            CPPUNIT_ASSERT_EQUAL( size_t( 20u ), numAnimatedFrames );
+        }
+    }
+}
+//--------------------------------------------------------------------------
+void SkeletonAnimLodTests::testStaggering()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    //Instances with the same interval must be spread evenly, not all animated on the same frame
+    const size_t numInstances = 12u;
+    for( uint16 updateInterval=2u; updateInterval<=4u; ++updateInterval )
+    {
+        for( uint32 frame=0; frame<16u; ++frame )
+        {
+            size_t numAnimated = 0;
+            for( size_t i=0; i<numInstances; ++i )
+            {
+                const bool animated = BySkeletonDef::_isAnimationFrame( updateInterval, frame, i );
+                numAnimated += animated ? 1u : 0u;
+
+                //Neighbours never share a frame
+                if( i > 0u )
+                {
+                    CPPUNIT_ASSERT( !animated ||
+                                    !BySkeletonDef::_isAnimationFrame( updateInterval, frame, i - 1u ) );
+                }
+            }
+
+            CPPUNIT_ASSERT_EQUAL( numInstances / updateInterval, numAnimated );
+        }
+    }
+}
+//--------------------------------------------------------------------------
+void SkeletonAnimLodTests::testBoneDepthCutoff()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    SkeletonInstance *skeleton = mAnimManager->createSkeletonInstance( mSkeletonDef, 1u );
+    SkeletonAnimation *animation = skeleton->getAnimation( "Move" );
+    animation->setEnabled( true );
+    animation->setTime( 0.5f );
+
+    const Vector3 animatedPosition = c_bindPosition + c_endTranslation * 0.5f;
+
+    for( uint16 maxBoneDepth=0; maxBoneDepth<=c_numBones; ++maxBoneDepth )
+    {
+        skeleton->_setAnimationLod( true, maxBoneDepth );
+        skeleton->update();
+
+        Vector3 positions[c_numBones];
+        getBonePositions( skeleton, positions );
+
+        //Deeper bones are left in the binding pose
+        for( size_t i=0; i<c_numBones; ++i )
+        {
+            const Vector3 expected = i <= maxBoneDepth ? animatedPosition : c_bindPosition;
+            CPPUNIT_ASSERT( positions[i].positionEquals( expected, 1e-4f ) );
+        }
+
+        //Start every iteration from the binding pose
+        skeleton->resetToPose();
+    }
+
+    mAnimManager->destroySkeletonInstance( skeleton );
+}
+//--------------------------------------------------------------------------
+void SkeletonAnimLodTests::testSkippedFramesKeepPose()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    SkeletonInstance *skeleton = mAnimManager->createSkeletonInstance( mSkeletonDef, 1u );
+    SkeletonAnimation *animation = skeleton->getAnimation( "Move" );
+    animation->setEnabled( true );
+
+    animation->setTime( 0.25f );
+    skeleton->_setAnimationLod( true, 0xFFFF );
+    skeleton->update();
+
+    Vector3 sampledPositions[c_numBones];
+    getBonePositions( skeleton, sampledPositions );
+    CPPUNIT_ASSERT( sampledPositions[0].positionEquals( c_bindPosition + c_endTranslation * 0.25f,
+                                                        1e-4f ) );
+
+    //The animation moves on, but this frame is skipped
+    animation->setTime( 0.75f );
+    skeleton->_setAnimationLod( false, 0xFFFF );
+    skeleton->update();
+
+    Vector3 positions[c_numBones];
+    getBonePositions( skeleton, positions );
+    for( size_t i=0; i<c_numBones; ++i )
+        CPPUNIT_ASSERT( positions[i].positionEquals( sampledPositions[i], 1e-6f ) );
+
+    //And catches up on the next one
+    skeleton->_setAnimationLod( true, 0xFFFF );
+    skeleton->update();
+    getBonePositions( skeleton, positions );
+    for( size_t i=0; i<c_numBones; ++i )
+    {
+        CPPUNIT_ASSERT( positions[i].positionEquals( c_bindPosition + c_endTranslation * 0.75f,
+                                                     1e-4f ) );
+    }
+
+    mAnimManager->destroySkeletonInstance( skeleton );
+}
+//--------------------------------------------------------------------------
+void SkeletonAnimLodTests::testNoLodAnimatesEverything()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    SkeletonInstance *skeletons[3];
+    for( size_t i=0; i<3u; ++i )
+    {
+        skeletons[i] = mAnimManager->createSkeletonInstance( mSkeletonDef, 1u );
+        skeletons[i]->_setAnimationLod( false, 0u );
+    }
+
+    AnimationLodLevelVec levels;
+    levels.push_back( AnimationLodLevel( 0.0f, 4u, 0u ) );
+
+    //Without a strategy or a LOD camera (e.g. before the camera's first
+    //render) the levels must be ignored and every instance fully animated.
+    BySkeletonDef &bySkeletonDef = mAnimManager->bySkeletonDefs.front();
+    for( uint32 frame=0; frame<4u; ++frame )
+    {
+        bySkeletonDef._updateAnimationLod( 0, levels, 0, frame );
+        for( size_t i=0; i<3u; ++i )
+        {
+            CPPUNIT_ASSERT( skeletons[i]->_getAnimateThisFrame() );
+            CPPUNIT_ASSERT_EQUAL( uint16( 0xFFFF ), skeletons[i]->_getLodMaxBoneDepth() );
+        }
+    }
+
+    mAnimManager->_updateAnimationLod( 0 );
+    for( size_t i=0; i<3u; ++i )
+    {
+        CPPUNIT_ASSERT( skeletons[i]->_getAnimateThisFrame() );
+        mAnimManager->destroySkeletonInstance( skeletons[i] );
+    }
+}
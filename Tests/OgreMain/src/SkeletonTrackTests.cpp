@@ -0,0 +1,216 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "SkeletonTrackTests.h"
+
+#include "Math/Array/OgreBoneTransform.h"
+#include "Math/Array/OgreKfTransformArrayMemoryManager.h"
+#include "Math/Array/OgreMathlib.h"
+
+#include "UnitTestSuite.h"
+
+using namespace Ogre;
+
+// Register the test suite
+CPPUNIT_TEST_SUITE_REGISTRATION(SkeletonTrackTests);
+
+static const size_t c_maxKeyFrames = 128u;
+
+//--------------------------------------------------------------------------
+static void sampleTrack( const SkeletonTrack &track, Real frame, Vector3 outPos[ARRAY_PACKED_REALS],
+                         Quaternion outRot[ARRAY_PACKED_REALS], Vector3 outScale[ARRAY_PACKED_REALS] )
+{
+    ArrayVector3 position( ArrayVector3::ZERO );
+    ArrayQuaternion orientation( ArrayQuaternion::IDENTITY );
+    ArrayVector3 scale( ArrayVector3::UNIT_SCALE );
+
+    TransformArray transforms;
+    transforms.push_back( BoneTransform() );
+    transforms[0].mPosition     = &position;
+    transforms[0].mOrientation  = &orientation;
+    transforms[0].mScale        = &scale;
+
+    KeyFrameRigVec::const_iterator lastKnownKeyFrame = track.getKeyFrames().begin();
+    const ArrayReal boneWeight = Mathlib::ONE;
+    track.applyKeyFrameRigAt( lastKnownKeyFrame, frame, Mathlib::ONE, &boneWeight, transforms );
+
+    for( size_t i=0; i<ARRAY_PACKED_REALS; ++i )
+    {
+        position.getAsVector3( outPos[i], i );
+        orientation.getAsQuaternion( outRot[i], i );
+        scale.getAsVector3( outScale[i], i );
+    }
+}
+//--------------------------------------------------------------------------
+static void staticKeyFrames( size_t keyFrame, size_t slot, Vector3 &outPos,
+                             Quaternion &outRot, Vector3 &outScale )
+{
+    outPos = Vector3( Real( slot ), 2.0f, 3.0f );
+    outRot = Quaternion( Degree( 30.0f * slot ), Vector3::UNIT_Y );
+    outScale = Vector3::UNIT_SCALE;
+}
+//--------------------------------------------------------------------------
+static void linearKeyFrames( size_t keyFrame, size_t slot, Vector3 &outPos,
+                             Quaternion &outRot, Vector3 &outScale )
+{
+    outPos = Vector3( Real( keyFrame ), Real( slot ), -0.5f * keyFrame );
+    outRot = Quaternion( Degree( 45.0f ), Vector3::UNIT_X );
+    outScale = Vector3( 2.0f );
+}
+//--------------------------------------------------------------------------
+static void curvedKeyFrames( size_t keyFrame, size_t slot, Vector3 &outPos,
+                             Quaternion &outRot, Vector3 &outScale )
+{
+    const Real t = keyFrame * 0.1f + slot;
+    outPos = Vector3( Math::Sin( t ), Math::Cos( t * 0.5f ), t );
+    outRot = Quaternion( Radian( Math::Sin( t ) * 1.5f ), Vector3( 1.0f, 1.0f, 0.0f ).normalisedCopy() );
+    outScale = Vector3( 1.0f + 0.25f * Math::Sin( t * 2.0f ) );
+}
+//--------------------------------------------------------------------------
+void SkeletonTrackTests::setUp()
+{
+    UnitTestSuite::getSingletonPtr()->startTestSetup(__FUNCTION__);
+
+    mMemoryManager = new KfTransformArrayMemoryManager( 0, 2u * c_maxKeyFrames * ARRAY_PACKED_REALS, -1,
+                                                        2u * c_maxKeyFrames * ARRAY_PACKED_REALS );
+    mMemoryManager->initialize();
+}
+//--------------------------------------------------------------------------
+void SkeletonTrackTests::tearDown()
+{
+    mMemoryManager->destroy();
+    delete mMemoryManager;
+    mMemoryManager = 0;
+}
+//--------------------------------------------------------------------------
+void SkeletonTrackTests::buildTrack( SkeletonTrack &track, size_t numKeyFrames,
+                                     KeyFrameGenerator generator )
+{
+    assert( numKeyFrames <= c_maxKeyFrames );
+
+    track.setNumKeyFrame( numKeyFrames );
+    for( size_t i=0; i<numKeyFrames; ++i )
+        track.addKeyFrame( Real( i ), 1.0f );
+
+    KeyFrameRigVec &keyFrames = track._getKeyFrames();
+    for( size_t i=0; i<numKeyFrames; ++i )
+    {
+        for( uint32 j=0; j<ARRAY_PACKED_REALS; ++j )
+        {
+            Vector3 vPos, vScale;
+            Quaternion qRot;
+            generator( i, j, vPos, qRot, vScale );
+
+            keyFrames[i].mBoneTransform->mPosition.setFromVector3( vPos, j );
+            keyFrames[i].mBoneTransform->mOrientation.setFromQuaternion( qRot, j );
+            keyFrames[i].mBoneTransform->mScale.setFromVector3( vScale, j );
+            track._setMaxUsedSlot( j );
+        }
+    }
+}
+//--------------------------------------------------------------------------
+size_t SkeletonTrackTests::compressAndCompare( size_t numKeyFrames, KeyFrameGenerator generator,
+                                               const SkeletonTrackCompression &settings )
+{
+    SkeletonTrack original( 0, mMemoryManager );
+    SkeletonTrack compressed( 0, mMemoryManager );
+    buildTrack( original, numKeyFrames, generator );
+    buildTrack( compressed, numKeyFrames, generator );
+
+    compressed._compress( settings );
+    CPPUNIT_ASSERT( compressed.isCompressed() );
+    CPPUNIT_ASSERT( compressed.getKeyFrames().size() <= numKeyFrames );
+    CPPUNIT_ASSERT( compressed.getKeyFrameMemoryUsage() < original.getKeyFrameMemoryUsage() );
+
+    //Sample in between keyframes too, and out of range
+    const Real cosHalfTolerance = Math::Cos( settings.orientationTolerance * 0.5f );
+    for( Real frame=-1.0f; frame<=Real( numKeyFrames ); frame += 0.25f )
+    {
+        Vector3 originalPos[ARRAY_PACKED_REALS], compressedPos[ARRAY_PACKED_REALS];
+        Quaternion originalRot[ARRAY_PACKED_REALS], compressedRot[ARRAY_PACKED_REALS];
+        Vector3 originalScale[ARRAY_PACKED_REALS], compressedScale[ARRAY_PACKED_REALS];
+
+        sampleTrack( original, frame, originalPos, originalRot, originalScale );
+        sampleTrack( compressed, frame, compressedPos, compressedRot, compressedScale );
+
+        for( size_t i=0; i<ARRAY_PACKED_REALS; ++i )
+        {
+            CPPUNIT_ASSERT( originalPos[i].distance( compressedPos[i] ) <=
+                            settings.positionTolerance + 1e-5f );
+            CPPUNIT_ASSERT( Math::Abs( originalRot[i].Dot( compressedRot[i] ) ) >=
+                            cosHalfTolerance - 1e-5f );
+            CPPUNIT_ASSERT( originalScale[i].positionEquals( compressedScale[i],
+                                                             settings.scaleTolerance + 1e-5f ) );
+        }
+    }
+
+    return compressed.getKeyFrames().size();
+}
+//--------------------------------------------------------------------------
+void SkeletonTrackTests::testStaticTrack()
+{
+    SkeletonTrackCompression settings;
+    CPPUNIT_ASSERT_EQUAL( size_t( 1u ), compressAndCompare( 20u, staticKeyFrames, settings ) );
+
+    SkeletonTrack track( 0, mMemoryManager );
+    buildTrack( track, 20u, staticKeyFrames );
+    track._compress( settings );
+    CPPUNIT_ASSERT_EQUAL( uint8( 0u ), track.getAnimatedChannels() );
+}
+//--------------------------------------------------------------------------
+void SkeletonTrackTests::testLinearKeyFrames()
+{
+    SkeletonTrackCompression settings;
+    CPPUNIT_ASSERT_EQUAL( size_t( 2u ), compressAndCompare( 30u, linearKeyFrames, settings ) );
+
+    SkeletonTrack track( 0, mMemoryManager );
+    buildTrack( track, 30u, linearKeyFrames );
+    track._compress( settings );
+    CPPUNIT_ASSERT_EQUAL( uint8( SkeletonTrack::ChannelPosition ), track.getAnimatedChannels() );
+}
+//--------------------------------------------------------------------------
+void SkeletonTrackTests::testCurvesWithinTolerance()
+{
+    SkeletonTrackCompression settings;
+    settings.positionTolerance      = 0.01f;
+    settings.orientationTolerance   = Degree( 1.0f );
+    settings.scaleTolerance         = 0.01f;
+
+    const size_t numKeyFrames = compressAndCompare( 100u, curvedKeyFrames, settings );
+    CPPUNIT_ASSERT( numKeyFrames > 2u && numKeyFrames < 100u );
+}
+//--------------------------------------------------------------------------
+void SkeletonTrackTests::testUnquantisedOrientations()
+{
+    SkeletonTrackCompression settings;
+    settings.positionTolerance      = 0.01f;
+    settings.orientationTolerance   = Degree( 1.0f );
+    settings.scaleTolerance         = 0.01f;
+    settings.quantiseOrientations   = false;
+
+    compressAndCompare( 100u, curvedKeyFrames, settings );
+}
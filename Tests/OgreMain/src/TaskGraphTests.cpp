@@ -0,0 +1,336 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "TaskGraphTests.h"
+#include "Threading/OgreTaskGraph.h"
+#include "Threading/OgreUniformScalableTask.h"
+#include "Threading/OgreLightweightMutex.h"
+#include "Threading/OgreThreads.h"
+
+#include "UnitTestSuite.h"
+
+using namespace Ogre;
+
+// Register the test suite
+CPPUNIT_TEST_SUITE_REGISTRATION(TaskGraphTests);
+
+//--------------------------------------------------------------------------
+class RecordingTask : public UniformScalableTask
+{
+public:
+    static size_t sNextOrder;
+
+    vector<size_t>::type    slicesExecuted;
+    size_t                  firstExecution;
+
+    RecordingTask() : firstExecution( ~0u ) {}
+
+    void execute( size_t threadId, size_t numThreads )
+    {
+        if( slicesExecuted.empty() )
+            slicesExecuted.resize( numThreads, 0 );
+        if( firstExecution == ~0u )
+            firstExecution = sNextOrder;
+        ++sNextOrder;
+        ++slicesExecuted[threadId];
+    }
+};
+size_t RecordingTask::sNextOrder = 0;
+//--------------------------------------------------------------------------
+/// Thread safe version of RecordingTask. Checks that every task it depends on
+/// had completely finished by the time each of its slices started.
+class ConcurrentRecordingTask : public UniformScalableTask
+{
+public:
+    typedef vector<ConcurrentRecordingTask*>::type ConcurrentRecordingTaskVec;
+
+    LightweightMutex            *mutex;
+    ConcurrentRecordingTaskVec  dependencies;
+    vector<size_t>::type        slicesExecuted;
+    vector<bool>::type          sliceRunning;
+    size_t                      numSlicesFinished;
+    bool                        dependencyViolated;
+    bool                        sameSliceOverlapped;
+
+    ConcurrentRecordingTask() :
+        mutex( 0 ), numSlicesFinished( 0 ),
+        dependencyViolated( false ), sameSliceOverlapped( false ) {}
+
+    void reset( size_t numSlices )
+    {
+        slicesExecuted.clear();
+        slicesExecuted.resize( numSlices, 0 );
+        sliceRunning.clear();
+        sliceRunning.resize( numSlices, false );
+        numSlicesFinished = 0;
+    }
+
+    void execute( size_t threadId, size_t numThreads )
+    {
+        {
+            ScopedLock lock( *mutex );
+            ConcurrentRecordingTaskVec::const_iterator itor = dependencies.begin();
+            ConcurrentRecordingTaskVec::const_iterator end  = dependencies.end();
+            while( itor != end )
+            {
+                if( (*itor)->numSlicesFinished != (*itor)->slicesExecuted.size() )
+                    dependencyViolated = true;
+                ++itor;
+            }
+            if( sliceRunning[threadId] )
+                sameSliceOverlapped = true;
+            sliceRunning[threadId] = true;
+        }
+
+        //Give the other workers a chance to run (or steal) in the meantime
+        Threads::Sleep( 0 );
+
+        {
+            ScopedLock lock( *mutex );
+            sliceRunning[threadId] = false;
+            ++slicesExecuted[threadId];
+            ++numSlicesFinished;
+        }
+    }
+};
+//--------------------------------------------------------------------------
+struct TaskGraphWorkerParams
+{
+    TaskGraph   *taskGraph;
+};
+unsigned long taskGraphWorkerThread( ThreadHandle *threadHandle )
+{
+    TaskGraphWorkerParams *params =
+            reinterpret_cast<TaskGraphWorkerParams*>( threadHandle->getUserParam() );
+    params->taskGraph->_executeWorker( threadHandle->getThreadIdx() );
+    return 0;
+}
+THREAD_DECLARE( taskGraphWorkerThread );
+//--------------------------------------------------------------------------
+static void executeWithWorkers( TaskGraph &taskGraph, size_t numWorkers )
+{
+    TaskGraphWorkerParams params;
+    params.taskGraph = &taskGraph;
+
+    taskGraph._prepareExecution( numWorkers );
+
+    ThreadHandleVec threadHandles;
+    for( size_t i=0; i<numWorkers; ++i )
+    {
+        threadHandles.push_back( Threads::CreateThread( THREAD_GET( taskGraphWorkerThread ),
+                                                        i, &params ) );
+    }
+    Threads::WaitForThreads( threadHandles );
+}
+//--------------------------------------------------------------------------
+void TaskGraphTests::setUp()
+{
+    UnitTestSuite::getSingletonPtr()->startTestSetup(__FUNCTION__);
+    RecordingTask::sNextOrder = 0;
+}
+//--------------------------------------------------------------------------
+void TaskGraphTests::tearDown()
+{
+}
+//--------------------------------------------------------------------------
+void TaskGraphTests::testAllSlicesExecuted()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    RecordingTask tasks[3];
+    TaskGraph taskGraph;
+    taskGraph.addTask( &tasks[0], 1 );
+    taskGraph.addTask( &tasks[1], 4 );
+    taskGraph.addTask( &tasks[2], 7 );
+
+    taskGraph._prepareExecution( 1u );
+    taskGraph._executeWorker( 0 );
+
+    const size_t expectedSlices[3] = { 1, 4, 7 };
+    for( size_t i=0; i<3; ++i )
+    {
+        CPPUNIT_ASSERT_EQUAL( expectedSlices[i], tasks[i].slicesExecuted.size() );
+        for( size_t j=0; j<expectedSlices[i]; ++j )
+            CPPUNIT_ASSERT_EQUAL( (size_t)1u, tasks[i].slicesExecuted[j] );
+    }
+}
+//--------------------------------------------------------------------------
+void TaskGraphTests::testDependencyOrder()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    // 0 -> 1 -> 3
+    //   \-> 2 -/
+    RecordingTask tasks[4];
+    TaskGraph taskGraph;
+    TaskGraph::TaskId ids[4];
+    for( size_t i=0; i<4; ++i )
+        ids[i] = taskGraph.addTask( &tasks[i], 3 );
+
+    taskGraph.addDependency( ids[3], ids[1] );
+    taskGraph.addDependency( ids[3], ids[2] );
+    taskGraph.addDependency( ids[1], ids[0] );
+    taskGraph.addDependency( ids[2], ids[0] );
+    taskGraph.addDependency( ids[2], TaskGraph::INVALID_TASK_ID );
+
+    taskGraph._prepareExecution( 1u );
+    taskGraph._executeWorker( 0 );
+
+    //All 3 slices of a task must be done before a dependent task starts
+    CPPUNIT_ASSERT( tasks[1].firstExecution >= tasks[0].firstExecution + 3u );
+    CPPUNIT_ASSERT( tasks[2].firstExecution >= tasks[0].firstExecution + 3u );
+    CPPUNIT_ASSERT( tasks[3].firstExecution >= tasks[1].firstExecution + 3u );
+    CPPUNIT_ASSERT( tasks[3].firstExecution >= tasks[2].firstExecution + 3u );
+    CPPUNIT_ASSERT_EQUAL( (size_t)12u, RecordingTask::sNextOrder );
+}
+//--------------------------------------------------------------------------
+void TaskGraphTests::testReexecute()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    RecordingTask tasks[2];
+    TaskGraph taskGraph;
+    TaskGraph::TaskId first = taskGraph.addTask( &tasks[0], 2 );
+    TaskGraph::TaskId second = taskGraph.addTask( &tasks[1], 2 );
+    taskGraph.addDependency( second, first );
+
+    for( size_t i=0; i<3; ++i )
+    {
+        taskGraph._prepareExecution( 1u );
+        taskGraph._executeWorker( 0 );
+    }
+
+    CPPUNIT_ASSERT_EQUAL( (size_t)3u, tasks[0].slicesExecuted[0] );
+    CPPUNIT_ASSERT_EQUAL( (size_t)3u, tasks[1].slicesExecuted[1] );
+    CPPUNIT_ASSERT_EQUAL( (size_t)12u, RecordingTask::sNextOrder );
+}
+//--------------------------------------------------------------------------
+void TaskGraphTests::testMultiWorkerAllSlicesExecuted()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    LightweightMutex mutex;
+    const size_t numSlices[5] = { 1, 3, 4, 7, 16 };
+    ConcurrentRecordingTask tasks[5];
+    TaskGraph taskGraph;
+    for( size_t i=0; i<5; ++i )
+    {
+        tasks[i].mutex = &mutex;
+        tasks[i].reset( numSlices[i] );
+        taskGraph.addTask( &tasks[i], numSlices[i] );
+    }
+
+    executeWithWorkers( taskGraph, 4u );
+
+    for( size_t i=0; i<5; ++i )
+    {
+        CPPUNIT_ASSERT_EQUAL( numSlices[i], tasks[i].numSlicesFinished );
+        for( size_t j=0; j<numSlices[i]; ++j )
+            CPPUNIT_ASSERT_EQUAL( (size_t)1u, tasks[i].slicesExecuted[j] );
+        CPPUNIT_ASSERT( !tasks[i].sameSliceOverlapped );
+    }
+}
+//--------------------------------------------------------------------------
+void TaskGraphTests::testMultiWorkerDependencyOrder()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    // 0 -> 1 -> 3 -> 5
+    // 0 -> 2 -------> 5
+    // 1 ------------> 5
+    // 0 -> 4 -> 6          (4 has a single slice)
+    LightweightMutex mutex;
+    const size_t numSlices[7] = { 5, 3, 8, 2, 1, 6, 4 };
+    ConcurrentRecordingTask tasks[7];
+    TaskGraph taskGraph;
+    TaskGraph::TaskId ids[7];
+    for( size_t i=0; i<7; ++i )
+    {
+        tasks[i].mutex = &mutex;
+        ids[i] = taskGraph.addTask( &tasks[i], numSlices[i] );
+    }
+
+    const size_t edges[8][2] = { { 1, 0 }, { 2, 0 }, { 4, 0 }, { 3, 1 },
+                                 { 5, 3 }, { 5, 2 }, { 6, 4 }, { 5, 1 } };
+    for( size_t i=0; i<8; ++i )
+    {
+        taskGraph.addDependency( ids[edges[i][0]], ids[edges[i][1]] );
+        tasks[edges[i][0]].dependencies.push_back( &tasks[edges[i][1]] );
+    }
+
+    for( size_t numWorkers=2u; numWorkers<=8u; numWorkers *= 2u )
+    {
+        for( size_t i=0; i<7; ++i )
+            tasks[i].reset( numSlices[i] );
+
+        executeWithWorkers( taskGraph, numWorkers );
+
+        for( size_t i=0; i<7; ++i )
+        {
+            CPPUNIT_ASSERT_EQUAL( numSlices[i], tasks[i].numSlicesFinished );
+            for( size_t j=0; j<numSlices[i]; ++j )
+                CPPUNIT_ASSERT_EQUAL( (size_t)1u, tasks[i].slicesExecuted[j] );
+            CPPUNIT_ASSERT( !tasks[i].dependencyViolated );
+            CPPUNIT_ASSERT( !tasks[i].sameSliceOverlapped );
+        }
+    }
+}
+//--------------------------------------------------------------------------
+void TaskGraphTests::testMultiWorkerReexecute()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    //A long chain of tasks with fewer slices than workers, so most workers are
+    //idle waiting for the previous link while the graph is still pending.
+    LightweightMutex mutex;
+    ConcurrentRecordingTask tasks[6];
+    TaskGraph taskGraph;
+    TaskGraph::TaskId prevId = TaskGraph::INVALID_TASK_ID;
+    for( size_t i=0; i<6; ++i )
+    {
+        tasks[i].mutex = &mutex;
+        const TaskGraph::TaskId taskId = taskGraph.addTask( &tasks[i], (i % 3u) + 1u );
+        taskGraph.addDependency( taskId, prevId );
+        if( i )
+            tasks[i].dependencies.push_back( &tasks[i-1u] );
+        prevId = taskId;
+    }
+
+    for( size_t run=0; run<20; ++run )
+    {
+        for( size_t i=0; i<6; ++i )
+            tasks[i].reset( (i % 3u) + 1u );
+
+        executeWithWorkers( taskGraph, 4u );
+
+        for( size_t i=0; i<6; ++i )
+        {
+            CPPUNIT_ASSERT_EQUAL( (i % 3u) + 1u, tasks[i].numSlicesFinished );
+            CPPUNIT_ASSERT( !tasks[i].dependencyViolated );
+        }
+    }
+}
@@ -0,0 +1,656 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "TransformUpdateTests.h"
+
+#include "OgreSceneNode.h"
+#include "OgreMovableObject.h"
+#include "Math/Array/OgreNodeMemoryManager.h"
+#include "Math/Array/OgreObjectMemoryManager.h"
+#include "Animation/OgreBone.h"
+#include "Animation/OgreSkeletonAnimManager.h"
+#include "Animation/OgreSkeletonDef.h"
+#include "Animation/OgreSkeletonInstance.h"
+#include "Animation/OgreTagPoint.h"
+#include "OgreOldBone.h"
+#include "OgreSkeleton.h"
+#include "OgreId.h"
+
+#include "UnitTestSuite.h"
+
+// Register the test suite
+CPPUNIT_TEST_SUITE_REGISTRATION(TransformUpdateTests);
+
+static const size_t c_numChildren = 3u * ARRAY_PACKED_REALS + 1u;
+
+/// Anything that isn't a valid result, to tell whether a value was recomputed.
+static const Matrix4 c_sentinelTransform( Matrix4::getTrans( 1000.0f, 1000.0f, 1000.0f ) );
+static const Aabb c_sentinelAabb( Vector3( 1000.0f, 1000.0f, 1000.0f ), Vector3::UNIT_SCALE );
+
+/// A MovableObject with nothing but bounds
+class TestMovableObject : public MovableObject
+{
+    static const String msMovableType;
+
+public:
+    TestMovableObject( ObjectMemoryManager *objectMemoryManager ) :
+        MovableObject( Id::generateNewId<MovableObject>(), objectMemoryManager, 0, 0 )
+    {
+    }
+
+    virtual const String& getMovableType(void) const    { return msMovableType; }
+};
+
+const String TestMovableObject::msMovableType = "TestMovableObject";
+
+/// A TagPoint that can be attached to a Bone without a SceneManager
+class TestTagPoint : public TagPoint
+{
+public:
+    TestTagPoint( NodeMemoryManager *nodeMemoryManager ) :
+        TagPoint( Id::generateNewId<Node>(), 0, nodeMemoryManager, 0 )
+    {
+    }
+
+    /// What Bone::addTagPoint does, minus the SceneManager bookkeeping
+    void setParentBone( Bone *bone )    { mParentBone = bone; }
+};
+
+/// Same as SceneManager::updateAllTransforms
+static void updateTransforms( NodeMemoryManager *nodeMemoryManager )
+{
+    const size_t numDepths = nodeMemoryManager->getNumDepths();
+    for( size_t i=0; i<numDepths; ++i )
+    {
+        Transform t;
+        const size_t numNodes = nodeMemoryManager->getFirstNode( t, i );
+        Node::updateAllTransforms( numNodes, t );
+    }
+}
+
+/// Same as SceneManager::updateAllTagPoints
+static void updateTagPoints( NodeMemoryManager *nodeMemoryManager )
+{
+    const size_t numDepths = nodeMemoryManager->getNumDepths();
+    for( size_t i=0; i<numDepths; ++i )
+    {
+        Transform t;
+        const size_t numNodes = nodeMemoryManager->getFirstNode( t, i );
+        if( i == 0 )
+            TagPoint::updateAllTransformsBoneToTag( numNodes, t );
+        else
+            TagPoint::updateAllTransformsTagOnTag( numNodes, t );
+    }
+}
+
+/// Same as SceneManager::updateAnimationTransforms, for a single skeleton
+static void updateBoneTransforms( SkeletonInstance *skeletonInstance,
+                                  const SkeletonDef *skeletonDef )
+{
+    const SkeletonDef::DepthLevelInfoVec &depthLevelInfo = skeletonDef->getDepthLevelInfo();
+    const TransformArray &transforms = skeletonInstance->_getTransformArray();
+    ArrayMatrixAf4x3 const *reverseBind = skeletonDef->getReverseBindPose().get();
+
+    for( size_t i=0; i<transforms.size(); ++i )
+    {
+        Bone::updateAllTransforms( transforms[i].mIndex + depthLevelInfo[i].numBonesInLevel,
+                                   transforms[i], reverseBind, depthLevelInfo[i].numBonesInLevel );
+        reverseBind += ( depthLevelInfo[i].numBonesInLevel - 1 + ARRAY_PACKED_REALS ) /
+                       ARRAY_PACKED_REALS;
+    }
+}
+
+/// Same as SceneManager::updateAllBounds
+static void updateBounds( ObjectMemoryManager *objectMemoryManager, bool incremental )
+{
+    const size_t numRenderQueues = objectMemoryManager->getNumRenderQueues();
+    for( size_t i=0; i<numRenderQueues; ++i )
+    {
+        ObjectData objData;
+        const size_t numObjs = objectMemoryManager->getFirstObjectData( objData, i );
+        if( incremental )
+            MovableObject::updateDirtyBounds( numObjs, objData );
+        else
+            MovableObject::updateAllBounds( numObjs, objData );
+    }
+}
+
+/// Calculates the derived position, orientation & scale of a Node from scratch.
+/// Like Node does, scale is applied per component (there is no shearing).
+static void getExpectedDerived( const Node *node, Vector3 &outPosition,
+                                Quaternion &outOrientation, Vector3 &outScale )
+{
+    const Node *parent = node->getParent();
+    if( !parent )
+    {
+        outPosition     = node->getPosition();
+        outOrientation  = node->getOrientation();
+        outScale        = node->getScale();
+        return;
+    }
+
+    Vector3 parentPosition, parentScale;
+    Quaternion parentOrientation;
+    getExpectedDerived( parent, parentPosition, parentOrientation, parentScale );
+
+    outPosition     = parentPosition + parentOrientation * ( parentScale * node->getPosition() );
+    outOrientation  = node->getInheritOrientation() ? parentOrientation * node->getOrientation() :
+                                                      node->getOrientation();
+    outScale        = node->getInheritScale() ? parentScale * node->getScale() : node->getScale();
+}
+
+static Matrix4 getExpectedTransform( const Node *node )
+{
+    Vector3 position, scale;
+    Quaternion orientation;
+    getExpectedDerived( node, position, orientation, scale );
+
+    Matrix4 retVal;
+    retVal.makeTransform( position, scale, orientation );
+    return retVal;
+}
+
+static Vector3 getExpectedScale( const Node *node )
+{
+    Vector3 position, scale;
+    Quaternion orientation;
+    getExpectedDerived( node, position, orientation, scale );
+    return scale;
+}
+
+static void checkRealsMatch( Real expected, Real actual )
+{
+    CPPUNIT_ASSERT( Math::RealEqual( expected, actual,
+                                     std::max( Real( 1.0f ), Math::Abs( expected ) ) * 1e-4f ) );
+}
+
+static void checkVectorsMatch( const Vector3 &expected, const Vector3 &actual )
+{
+    for( size_t i=0; i<3; ++i )
+        checkRealsMatch( expected[i], actual[i] );
+}
+
+/// True if both nodes are processed by Node::updateAllTransforms in the same block
+static bool shareBlock( Node *a, Node *b )
+{
+    return a->_getTransform().mDerivedPosition == b->_getTransform().mDerivedPosition;
+}
+
+/// True if both objects are processed by MovableObject::updateDirtyBounds in the same block
+static bool shareBlock( MovableObject *a, MovableObject *b )
+{
+    return a->_getObjectData().mWorldAabb == b->_getObjectData().mWorldAabb;
+}
+
+//--------------------------------------------------------------------------
+void TransformUpdateTests::setUp()
+{
+    UnitTestSuite::getSingletonPtr()->startTestSetup(__FUNCTION__);
+
+    for( size_t i=0; i<NUM_SCENE_MEMORY_MANAGER_TYPES; ++i )
+    {
+        mNodeMemoryManager[i] = OGRE_NEW NodeMemoryManager();
+        mObjectMemoryManager[i] = OGRE_NEW ObjectMemoryManager();
+    }
+    mTagPointNodeMemoryManager = OGRE_NEW NodeMemoryManager();
+
+    //Same as SceneManager
+    mNodeMemoryManager[SCENE_STATIC]->_setTwin( SCENE_STATIC, mNodeMemoryManager[SCENE_DYNAMIC] );
+    mNodeMemoryManager[SCENE_DYNAMIC]->_setTwin( SCENE_DYNAMIC, mNodeMemoryManager[SCENE_STATIC] );
+    mObjectMemoryManager[SCENE_STATIC]->_setTwin( SCENE_STATIC, mObjectMemoryManager[SCENE_DYNAMIC] );
+    mObjectMemoryManager[SCENE_DYNAMIC]->_setTwin( SCENE_DYNAMIC, mObjectMemoryManager[SCENE_STATIC] );
+
+    for( size_t i=0; i<NUM_SCENE_MEMORY_MANAGER_TYPES; ++i )
+        mRootNode[i] = OGRE_NEW SceneNode( Id::generateNewId<Node>(), 0, mNodeMemoryManager[i], 0 );
+
+    mIncrementalBoundsUpdate = true;
+    mParent = 0;
+}
+//--------------------------------------------------------------------------
+void TransformUpdateTests::tearDown()
+{
+    TestMovableObjectVec::const_iterator itor = mObjects.begin();
+    TestMovableObjectVec::const_iterator end  = mObjects.end();
+    while( itor != end )
+        OGRE_DELETE *itor++;
+
+    //Children first
+    NodeVec::const_reverse_iterator ritor = mNodes.rbegin();
+    NodeVec::const_reverse_iterator rend  = mNodes.rend();
+    while( ritor != rend )
+        OGRE_DELETE *ritor++;
+
+    mObjects.clear();
+    mNodes.clear();
+    mChildren.clear();
+    mGrandchildren.clear();
+
+    for( size_t i=0; i<NUM_SCENE_MEMORY_MANAGER_TYPES; ++i )
+    {
+        OGRE_DELETE mRootNode[i];
+        OGRE_DELETE mObjectMemoryManager[i];
+        OGRE_DELETE mNodeMemoryManager[i];
+    }
+    OGRE_DELETE mTagPointNodeMemoryManager;
+}
+//--------------------------------------------------------------------------
+SceneNode* TransformUpdateTests::createSceneNode( SceneMemoryMgrTypes sceneType, Node *parent )
+{
+    SceneNode *sceneNode = OGRE_NEW SceneNode( Id::generateNewId<Node>(), 0,
+                                               mNodeMemoryManager[sceneType], 0 );
+    parent->addChild( sceneNode );
+    mNodes.push_back( sceneNode );
+    return sceneNode;
+}
+//--------------------------------------------------------------------------
+TestMovableObject* TransformUpdateTests::createObject( SceneMemoryMgrTypes sceneType,
+                                                       SceneNode *parentNode )
+{
+    const Real idx = static_cast<Real>( mObjects.size() );
+
+    TestMovableObject *object = OGRE_NEW TestMovableObject( mObjectMemoryManager[sceneType] );
+    object->setLocalAabb( Aabb( Vector3( idx * 0.25f, -0.5f, 1.0f ),
+                                Vector3( 0.5f, 1.0f + idx * 0.125f, 1.5f ) ) );
+    parentNode->attachObject( object );
+
+    mObjects.push_back( object );
+    return object;
+}
+//--------------------------------------------------------------------------
+void TransformUpdateTests::createHierarchy( SceneMemoryMgrTypes sceneType )
+{
+    mParent = createSceneNode( sceneType, mRootNode[sceneType] );
+    mParent->setPosition( 1.0f, 2.0f, 3.0f );
+    mParent->setScale( 2.0f, 2.0f, 2.0f );
+    createObject( sceneType, mParent );
+
+    for( size_t i=0; i<c_numChildren; ++i )
+    {
+        const Real fi = static_cast<Real>( i );
+
+        SceneNode *child = createSceneNode( sceneType, mParent );
+        child->setPosition( fi, -fi * 0.5f, 2.0f );
+        child->setOrientation( Quaternion( Degree( fi * 10.0f ), Vector3::UNIT_Y ) );
+        createObject( sceneType, child );
+
+        SceneNode *grandchild = createSceneNode( sceneType, child );
+        grandchild->setPosition( Vector3::UNIT_Y );
+        grandchild->setScale( 0.5f + fi * 0.1f, 1.0f, 1.5f );
+        createObject( sceneType, grandchild );
+
+        mChildren.push_back( child );
+        mGrandchildren.push_back( grandchild );
+    }
+}
+//--------------------------------------------------------------------------
+void TransformUpdateTests::updateScene( bool bStaticDirty )
+{
+    updateTransforms( mNodeMemoryManager[SCENE_DYNAMIC] );
+    if( bStaticDirty )
+        updateTransforms( mNodeMemoryManager[SCENE_STATIC] );
+
+    //Static objects are always fully updated
+    updateBounds( mObjectMemoryManager[SCENE_DYNAMIC], mIncrementalBoundsUpdate );
+    if( bStaticDirty )
+        updateBounds( mObjectMemoryManager[SCENE_STATIC], false );
+
+    //Same as SceneManager::clearNodeDirtyFlags
+    mNodeMemoryManager[SCENE_DYNAMIC]->_clearDirtyFlags();
+    if( bStaticDirty )
+        mNodeMemoryManager[SCENE_STATIC]->_clearDirtyFlags();
+}
+//--------------------------------------------------------------------------
+void TransformUpdateTests::checkTransform( const Matrix4 &expected, const Node *node )
+{
+    const Matrix4 &actual = node->_getFullTransform();
+    for( size_t i=0; i<3; ++i )
+    {
+        for( size_t j=0; j<4; ++j )
+            checkRealsMatch( expected[i][j], actual[i][j] );
+    }
+}
+//--------------------------------------------------------------------------
+void TransformUpdateTests::checkBounds( const Matrix4 &parentTransform, const Vector3 &parentScale,
+                                        TestMovableObject *object )
+{
+    Aabb expected = object->getLocalAabb();
+    expected.transformAffine( parentTransform );
+
+    const Aabb actual = object->getWorldAabb();
+    checkVectorsMatch( expected.mCenter, actual.mCenter );
+    checkVectorsMatch( expected.mHalfSize, actual.mHalfSize );
+
+    const Real maxScale = std::max( std::max( parentScale.x, parentScale.y ), parentScale.z );
+    checkRealsMatch( object->getLocalAabb().getRadius() * maxScale, object->getWorldRadius() );
+}
+//--------------------------------------------------------------------------
+void TransformUpdateTests::checkHierarchy(void)
+{
+    checkTransform( getExpectedTransform( mParent ), mParent );
+    for( size_t i=0; i<c_numChildren; ++i )
+    {
+        checkTransform( getExpectedTransform( mChildren[i] ), mChildren[i] );
+        checkTransform( getExpectedTransform( mGrandchildren[i] ), mGrandchildren[i] );
+    }
+
+    TestMovableObjectVec::const_iterator itor = mObjects.begin();
+    TestMovableObjectVec::const_iterator end  = mObjects.end();
+    while( itor != end )
+    {
+        const Node *parentNode = (*itor)->getParentNode();
+        checkBounds( getExpectedTransform( parentNode ), getExpectedScale( parentNode ), *itor );
+        ++itor;
+    }
+}
+//--------------------------------------------------------------------------
+void TransformUpdateTests::testMoveParent()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    createHierarchy( SCENE_DYNAMIC );
+    updateScene();
+    checkHierarchy();
+
+    mParent->setPosition( -4.0f, 5.0f, 0.5f );
+    updateScene();
+    checkHierarchy();
+
+    mParent->setOrientation( Quaternion( Degree( 30.0f ),
+                                         Vector3( 1.0f, 1.0f, 0.0f ).normalisedCopy() ) );
+    mParent->setScale( 1.0f, 3.0f, 0.5f );
+    updateScene();
+    checkHierarchy();
+
+    //Nothing moved
+    updateScene();
+    checkHierarchy();
+}
+//--------------------------------------------------------------------------
+void TransformUpdateTests::testMoveChild()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    createHierarchy( SCENE_DYNAMIC );
+    updateScene();
+
+    //One node in the middle of a block, and one in a different block at the next depth level
+    mChildren[ARRAY_PACKED_REALS + 1u]->setPosition( 7.0f, -3.0f, 0.0f );
+    mGrandchildren[2u * ARRAY_PACKED_REALS]->setOrientation(
+                Quaternion( Degree( 45.0f ), Vector3::UNIT_X ) );
+    updateScene();
+    checkHierarchy();
+
+    //The last block is only partially used
+    mChildren.back()->setScale( 3.0f, 1.0f, 1.0f );
+    updateScene();
+    checkHierarchy();
+
+    //Changing what's inherited dirties the node too
+    mChildren[0]->setInheritOrientation( false );
+    mGrandchildren[1]->setInheritScale( false );
+    updateScene();
+    checkHierarchy();
+
+    mChildren[0]->setInheritOrientation( true );
+    updateScene();
+    checkHierarchy();
+}
+//--------------------------------------------------------------------------
+void TransformUpdateTests::testLocalAabbChanged()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    createHierarchy( SCENE_DYNAMIC );
+    updateScene();
+
+    //No node moved, only the bounds changed
+    mObjects[5]->setLocalAabb( Aabb( Vector3( -3.0f, 0.0f, 0.0f ), Vector3( 4.0f, 0.5f, 0.5f ) ) );
+    mObjects.back()->setLocalAabb( Aabb( Vector3::ZERO, Vector3( 0.25f, 0.25f, 0.25f ) ) );
+    updateScene();
+    checkHierarchy();
+
+    //Attached to a different node that didn't move
+    TestMovableObject *object = mObjects[2];
+    object->detachFromParent();
+    static_cast<SceneNode*>( mChildren[2u * ARRAY_PACKED_REALS] )->attachObject( object );
+    updateScene();
+    checkHierarchy();
+}
+//--------------------------------------------------------------------------
+void TransformUpdateTests::testCleanBlocksAreSkipped()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    createHierarchy( SCENE_DYNAMIC );
+    updateScene();
+
+    Node *movedChild = mChildren[ARRAY_PACKED_REALS];
+    Node *movedGrandchild = mGrandchildren[ARRAY_PACKED_REALS];
+
+    //Overwrite the results, so we can tell which ones were recomputed
+    for( size_t i=0; i<c_numChildren; ++i )
+    {
+        Transform &childTransform = mChildren[i]->_getTransform();
+        childTransform.mDerivedTransform[childTransform.mIndex] = c_sentinelTransform;
+        Transform &grandchildTransform = mGrandchildren[i]->_getTransform();
+        grandchildTransform.mDerivedTransform[grandchildTransform.mIndex] = c_sentinelTransform;
+    }
+
+    movedChild->setPosition( 0.0f, 0.0f, -6.0f );
+    updateScene();
+
+    //Only the blocks with the moved node, or with a child of it, are recomputed
+    for( size_t i=0; i<c_numChildren; ++i )
+    {
+        if( shareBlock( mChildren[i], movedChild ) )
+            checkTransform( getExpectedTransform( mChildren[i] ), mChildren[i] );
+        else
+            CPPUNIT_ASSERT( mChildren[i]->_getFullTransform() == c_sentinelTransform );
+
+        if( shareBlock( mGrandchildren[i], movedGrandchild ) )
+            checkTransform( getExpectedTransform( mGrandchildren[i] ), mGrandchildren[i] );
+        else
+            CPPUNIT_ASSERT( mGrandchildren[i]->_getFullTransform() == c_sentinelTransform );
+    }
+
+    //Touching the nodes brings them back
+    for( size_t i=0; i<c_numChildren; ++i )
+        mChildren[i]->setPosition( mChildren[i]->getPosition() );
+    updateScene();
+    checkHierarchy();
+
+    //Same with the bounds. Only the objects sharing a block with one whose
+    //parent node moved (or whose own bounds changed) are recomputed
+    TestMovableObject *dirtyObject = mObjects.back();
+    for( size_t i=0; i<mObjects.size(); ++i )
+    {
+        ObjectData &objData = mObjects[i]->_getObjectData();
+        objData.mWorldAabb->setFromAabb( c_sentinelAabb, objData.mIndex );
+    }
+
+    movedChild->setPosition( 0.0f, 5.0f, 0.0f );
+    dirtyObject->setLocalAabb( Aabb( Vector3::UNIT_X, Vector3::UNIT_SCALE ) );
+    updateScene();
+
+    for( size_t i=0; i<mObjects.size(); ++i )
+    {
+        TestMovableObject *object = mObjects[i];
+
+        bool recomputed = shareBlock( object, dirtyObject );
+        for( size_t j=0; j<mObjects.size(); ++j )
+        {
+            const Node *parentNode = mObjects[j]->getParentNode();
+            if( parentNode == movedChild || parentNode == movedGrandchild )
+                recomputed |= shareBlock( object, mObjects[j] );
+        }
+
+        if( recomputed )
+        {
+            const Node *parentNode = object->getParentNode();
+            checkBounds( getExpectedTransform( parentNode ), getExpectedScale( parentNode ), object );
+        }
+        else
+        {
+            const Aabb actual = object->getWorldAabb();
+            CPPUNIT_ASSERT( actual.mCenter == c_sentinelAabb.mCenter &&
+                            actual.mHalfSize == c_sentinelAabb.mHalfSize );
+        }
+    }
+
+    //The full update recomputes everything
+    mIncrementalBoundsUpdate = false;
+    updateScene();
+    checkHierarchy();
+}
+//--------------------------------------------------------------------------
+void TransformUpdateTests::testTagPoints()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    const Vector3 bonePosition( 0.0f, 2.0f, 0.0f );
+    const Quaternion boneOrientation( Degree( 45.0f ), Vector3::UNIT_Z );
+
+    v1::Skeleton *v1Skeleton = OGRE_NEW v1::Skeleton( 0, "TransformUpdateTests", 0, "General" );
+    //So that its bones get freed when deleted
+    v1Skeleton->setToLoaded();
+    v1::OldBone *oldBone = v1Skeleton->createBone( "Bone", 0 );
+    oldBone->setPosition( bonePosition );
+    oldBone->setOrientation( boneOrientation );
+    v1Skeleton->setBindingPose();
+
+    SkeletonDef *skeletonDef = OGRE_NEW SkeletonDef( v1Skeleton, 1.0f );
+    OGRE_DELETE v1Skeleton;
+
+    //The nodes must be created first, the Bones keep
+    //pointers to the transform of the skeleton's node.
+    createHierarchy( SCENE_DYNAMIC );
+    SceneNode *skeletonNode = createSceneNode( SCENE_DYNAMIC, mRootNode[SCENE_DYNAMIC] );
+    skeletonNode->setPosition( 3.0f, 0.0f, -1.0f );
+
+    SkeletonAnimManager animManager;
+    SkeletonInstance *skeletonInstance = animManager.createSkeletonInstance( skeletonDef, 1u );
+    skeletonInstance->setParentNode( skeletonNode );
+
+    TestTagPoint *tagPoint = OGRE_NEW TestTagPoint( mTagPointNodeMemoryManager );
+    tagPoint->setParentBone( skeletonInstance->getBone( 0 ) );
+    tagPoint->setPosition( 0.0f, 1.0f, 0.0f );
+    TestTagPoint *childTagPoint = OGRE_NEW TestTagPoint( mTagPointNodeMemoryManager );
+    tagPoint->addChild( childTagPoint );
+    childTagPoint->setPosition( Vector3::UNIT_X );
+    childTagPoint->setOrientation( Quaternion( Degree( 90.0f ), Vector3::UNIT_Y ) );
+
+    TestMovableObject *tagPointObject = createObject( SCENE_DYNAMIC, tagPoint );
+    TestMovableObject *childTagPointObject = createObject( SCENE_DYNAMIC, childTagPoint );
+    //checkHierarchy doesn't know about TagPoints
+    mObjects.pop_back();
+    mObjects.pop_back();
+
+    Matrix4 boneTransform;
+    boneTransform.makeTransform( bonePosition, Vector3::UNIT_SCALE, boneOrientation );
+
+    for( size_t i=0; i<4u; ++i )
+    {
+        if( i == 1u )
+        {
+            //Only the skeleton's node moves. The TagPoints must follow.
+            skeletonNode->setPosition( -2.0f, 4.0f, 1.0f );
+            skeletonNode->setScale( 2.0f, 2.0f, 2.0f );
+        }
+        else if( i == 2u )
+        {
+            //Only the TagPoint moves
+            tagPoint->setOrientation( Quaternion( Degree( 30.0f ), Vector3::UNIT_X ) );
+        }
+
+        //Same order as SceneManager::updateAllTransformsAndBounds
+        updateTransforms( mNodeMemoryManager[SCENE_DYNAMIC] );
+        skeletonInstance->update();
+        updateBoneTransforms( skeletonInstance, skeletonDef );
+        updateTagPoints( mTagPointNodeMemoryManager );
+        updateBounds( mObjectMemoryManager[SCENE_DYNAMIC], mIncrementalBoundsUpdate );
+        mNodeMemoryManager[SCENE_DYNAMIC]->_clearDirtyFlags();
+
+        Matrix4 tagPointLocal;
+        tagPointLocal.makeTransform( tagPoint->getPosition(), tagPoint->getScale(),
+                                     tagPoint->getOrientation() );
+        Matrix4 childTagPointLocal;
+        childTagPointLocal.makeTransform( childTagPoint->getPosition(), childTagPoint->getScale(),
+                                          childTagPoint->getOrientation() );
+
+        const Matrix4 expectedTagPoint = getExpectedTransform( skeletonNode ) *
+                                         boneTransform * tagPointLocal;
+        const Matrix4 expectedChildTagPoint = expectedTagPoint * childTagPointLocal;
+        const Vector3 expectedScale = getExpectedScale( skeletonNode );
+
+        checkTransform( expectedTagPoint, tagPoint );
+        checkTransform( expectedChildTagPoint, childTagPoint );
+        checkBounds( expectedTagPoint, expectedScale, tagPointObject );
+        checkBounds( expectedChildTagPoint, expectedScale, childTagPointObject );
+
+        checkHierarchy();
+    }
+
+    OGRE_DELETE childTagPointObject;
+    OGRE_DELETE tagPointObject;
+
+    OGRE_DELETE childTagPoint;
+    tagPoint->setParentBone( 0 );
+    OGRE_DELETE tagPoint;
+
+    animManager.destroySkeletonInstance( skeletonInstance );
+    OGRE_DELETE skeletonDef;
+}
+//--------------------------------------------------------------------------
+void TransformUpdateTests::testStaticObjects()
+{
+    UnitTestSuite::getSingletonPtr()->startTestMethod(__FUNCTION__);
+
+    createHierarchy( SCENE_STATIC );
+    updateScene( true );
+    checkHierarchy();
+
+    //Static nodes aren't updated until told so. Their dirty
+    //flags must survive the frames they weren't updated in.
+    mParent->setPosition( 0.0f, -1.0f, 8.0f );
+    mChildren[ARRAY_PACKED_REALS]->setOrientation( Quaternion( Degree( 60.0f ), Vector3::UNIT_Z ) );
+    updateScene();
+    updateScene( true );
+    checkHierarchy();
+
+    mGrandchildren[1]->setScale( 4.0f, 4.0f, 4.0f );
+    updateScene( true );
+    checkHierarchy();
+
+    //Static objects get their bounds fully updated
+    mObjects[3]->setLocalAabb( Aabb( Vector3( 1.0f, 1.0f, 1.0f ), Vector3( 2.0f, 0.5f, 0.5f ) ) );
+    updateScene( true );
+    checkHierarchy();
+
+    //Nothing changed
+    updateScene( true );
+    checkHierarchy();
+}